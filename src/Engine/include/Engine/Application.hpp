@@ -3,9 +3,26 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <optional>
+#include <stop_token>
 #include <string>
+#include <vector>
 
+#include <glm/vec3.hpp>
+
+#include "Engine/ChunkedMesh.hpp"
+#include "Engine/FileWatcher.hpp"
+#include "Engine/InputLatency.hpp"
+#include "Engine/JobSystem.hpp"
+#include "Engine/Metrics.hpp"
+#include "Engine/ModelBvh.hpp"
+#include "Engine/ModelCamera.hpp"
 #include "Engine/ModelData.hpp"
+#include "Engine/MorphTargets.hpp"
+#include "Engine/PointCloudPreview.hpp"
+#include "Engine/RendererStatistics.hpp"
+#include "Engine/ResolutionGovernor.hpp"
+#include "Engine/Task.hpp"
 
 namespace engine {
 class Renderer;
@@ -20,6 +37,21 @@ public:
     bool IsRunning() const noexcept;
 
 private:
+    // Output of the load/cook pipeline. Built on worker threads.
+    struct ModelImport {
+        bool succeeded;
+        ModelData model;
+        std::vector<std::string> sourceTexturePaths;
+        bool texturesAtlased;
+        // Built only for models with at least kPointCloudPreviewMinimumVertices vertices.
+        std::shared_ptr<const PointCloudPreview> pointCloudPreview;
+        // Rest-pose copy for the picking BVH build, made on the import worker so the build never
+        // reads the model the frame loop draws and morphs.
+        std::shared_ptr<const ModelBvhSource> bvhSource;
+        std::string summary;
+        std::string error;
+    };
+
     bool Initialize();
     void Shutdown() noexcept;
     bool CreateRenderer();
@@ -28,8 +60,42 @@ private:
     void UpdateGui();
     void DrawShortcutOverlay();
     void OpenLoadFbxDialog();
+    [[nodiscard]] static Task<ModelImport> ImportModelAsync(
+        JobSystem& jobs,
+        std::string sourcePath,
+        bool useCookedCache,
+        bool packTextureAtlases,
+        bool mergeSubmeshes,
+        std::stop_token stopToken);
+    Task<void> LoadModelInBackground(std::string sourcePath, bool isReload, std::stop_token stopToken);
+    void StartModelLoad(const std::string& sourcePath, bool isReload);
+    void CancelModelLoad() noexcept;
+    void ApplyImportedModel(ModelImport&& import, bool resetView);
+    void PollModelHotReload();
+    void OpenStreamedMesh(const std::string& path);
+    void SaveChunkedMesh();
+    void UpdateMeshStreaming();
+    void DrawMeshStreamingControls();
     void UpdateAnimationPlayback(float deltaSeconds);
     void StepAnimationSelection(int direction);
+    // Blends the model's morph targets for the active clip and time before the model pass.
+    void UpdateMorphTargets();
+    [[nodiscard]] ModelCamera BuildCamera() const noexcept;
+    // Rotates the camera by the mouse travel since the last applied position.
+    void ApplyCameraDrag(float mouseX, float mouseY) noexcept;
+    // The renderer's camera latch: folds in mouse motion that arrived after the frame started.
+    [[nodiscard]] ModelCamera LatchCamera();
+    void StartModelBvhBuild(std::shared_ptr<const ModelBvhSource> source);
+    void CancelModelBvhBuild() noexcept;
+    void PollModelBvhBuild();
+    void UpdateModelPicking();
+    void DrawHoveredSubmeshHighlight();
+    void DrawRendererStatisticsPanel();
+    void RegisterMetrics();
+    void StartMetricsExport();
+    void RecordFrameMetrics(const RendererFrameStatistics& frame, float deltaSeconds, float renderScale);
+    // Closes the flight recorder's frame and writes a dump in the background if it hitched.
+    void EndFlightRecorderFrame();
 
     bool running_;
     std::uint64_t frameCounter_;
@@ -44,16 +110,89 @@ private:
     float pitchDegrees_;
     float rollDegrees_;
     float cameraDistance_;
+    glm::vec3 orbitPivot_;
     std::size_t currentAnimationIndex_;
     float animationTimeSeconds_;
     float animationSpeed_;
     bool animationPlaying_;
+    MorphTargetBlender morphTargetBlender_;
+    std::vector<float> morphWeights_;
+    float lastMorphBlendMicroseconds_;
     std::uint64_t lastFrameCounterTimestamp_;
+    bool cameraDragActive_;
+    float dragMouseX_;
+    float dragMouseY_;
+    bool lateLatchCameraEnabled_;
+    bool measureInputLatency_;
+    InputLatencyTracker inputLatency_;
+
+    // Filled by the background build job; kept only if `generation` still matches.
+    struct ModelBvhBuild {
+        std::uint64_t generation;
+        std::unique_ptr<ModelBvh> bvh;
+    };
+
+    std::unique_ptr<ModelBvh> modelBvh_;
+    // Bumped whenever the model the BVH would index goes away; older builds are dropped.
+    std::uint64_t modelBvhGeneration_;
+    JobSystem::JobHandle modelBvhJob_;
+    std::shared_ptr<ModelBvhBuild> pendingModelBvh_;
+    std::optional<ModelRayHit> hoveredHit_;
+    float lastPickMicroseconds_;
+
+    FileWatcher modelFileWatcher_;
+    std::stop_source modelLoadStopSource_;
+    bool modelLoadInFlight_;
+    bool loadedModelTexturesAtlased_;
+    bool modelReloadQueued_;
+
+    ChunkedMeshStream meshStream_;
+    std::vector<MeshChunkRequest> meshChunkRequests_;
+    std::vector<std::shared_ptr<const ResidentMeshChunk>> drawnMeshChunks_;
+    int meshStreamBudgetMegabytes_;
+
+    RendererStatisticsHistory rendererStatisticsHistory_;
+    std::vector<float> statisticsPlotValues_;
+    int plottedStatisticIndex_;
+    bool showRendererStatistics_;
+    JobSystemStatistics jobStatisticsTotals_;
+    JobSystemStatistics jobStatisticsFrame_;
+    float jobStatisticsFrameSeconds_;
+    ResolutionGovernor resolutionGovernor_;
+    bool dynamicResolutionEnabled_;
+    // Only the model pass feeds the governor, so stalls elsewhere in the frame do not lower the scale.
+    double lastModelPassSeconds_;
+    bool overdrawVisualizationEnabled_;
+    std::shared_ptr<const PointCloudPreview> pointCloudPreview_;
+    bool pointCloudPreviewEnabled_;
+
+    // Registered once in Initialize; the frame loop updates them without locking.
+    struct MetricHandles {
+        MetricCounter* frames;
+        MetricHistogram* frameSeconds;
+        MetricGauge* drawCalls;
+        MetricGauge* trianglesSubmitted;
+        MetricGauge* textureResidentBytes;
+        MetricGauge* textureDecodesPending;
+        MetricGauge* renderScale;
+        MetricGauge* processResidentBytes;
+        MetricHistogram* modelLoadSeconds;
+        MetricCounter* modelLoadsSucceeded;
+        MetricCounter* modelLoadsFailed;
+    };
+    MetricsRegistry metrics_;
+    MetricHandles metricHandles_;
+    const char* metricsRendererName_;
+    MetricsExporter metricsExporter_;
 
     bool sdlInitialized_;
     bool nfdInitialized_;
     bool imguiInitialized_;
     bool useNativeDx12ImGui_;
     bool wireOverlayEnabled_;
+    bool mergeSubmeshesOnLoad_;
+    bool packTextureAtlasesOnLoad_;
+    bool useCookedModelCache_;
+    bool hotReloadEnabled_;
 };
 }
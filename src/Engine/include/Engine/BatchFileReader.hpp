@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace engine {
+class JobSystem;
+
+struct FileReadResult {
+    bool succeeded;
+    std::vector<std::byte> bytes;
+    std::string error;
+};
+
+enum class FileReadBackend {
+    Automatic,
+    IoUring,
+    ThreadPool
+};
+
+struct FileBatchStatistics {
+    FileReadBackend backend;
+    std::size_t fileCount;
+    std::uint64_t bytesRead;
+    // io_uring_enter calls for the io_uring backend; zero for the thread pool.
+    std::size_t submitCalls;
+    bool registeredBuffers;
+};
+
+// Called once per file as soon as its read finishes, successfully or not, with its index in the
+// batch. With io_uring it runs on the thread that called ReadFileBatch, so it should hand heavy
+// work such as decoding to the job system rather than do it inline.
+using FileReadyCallback = std::function<void(std::size_t fileIndex)>;
+
+// Reads every file in `paths` into `outFiles`, which is sized before any read starts so callbacks
+// may use their own entry. On Linux all reads go to the kernel as one io_uring batch into
+// registered buffers; elsewhere, or when io_uring is unavailable, files are read with pread on the
+// job system workers.
+void ReadFileBatch(
+    JobSystem& jobs,
+    const std::vector<std::filesystem::path>& paths,
+    std::vector<FileReadResult>& outFiles,
+    const FileReadyCallback& onFileReady = {},
+    FileReadBackend backend = FileReadBackend::Automatic,
+    FileBatchStatistics* outStatistics = nullptr);
+
+// Whether this process can create an io_uring instance. Probed once.
+[[nodiscard]] bool IsIoUringAvailable();
+
+[[nodiscard]] const char* GetFileReadBackendName(FileReadBackend backend) noexcept;
+}
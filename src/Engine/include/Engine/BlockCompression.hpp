@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace engine {
+class JobSystem;
+
+// Payload compression for cooked assets. Data is cut into independent blocks that are filtered and
+// LZ-compressed on their own, so blocks decode in parallel and can start as soon as they are read.
+// Blocks that do not shrink are stored raw.
+enum class BlockFilter : std::uint8_t {
+    None,
+    // Splits 32-bit words into byte planes; suits float vertex data.
+    Shuffle32,
+    // Stores each 32-bit word as its difference from the previous one, then splits byte planes;
+    // suits index lists.
+    Delta32,
+};
+
+inline constexpr std::size_t kCompressionBlockSize = 256 * 1024;
+
+// Replaces `outCompressed` with the compressed form of `size` bytes at `data`.
+void CompressBlocks(const std::byte* data, std::size_t size, BlockFilter filter, std::vector<std::byte>& outCompressed);
+
+// Decodes a CompressBlocks payload, spreading its blocks over the job system. Payloads claiming
+// more than `maxRawSize` decoded bytes are rejected before anything is allocated.
+[[nodiscard]] bool DecompressBlocks(
+    JobSystem& jobs,
+    const std::byte* data,
+    std::size_t size,
+    std::uint64_t maxRawSize,
+    std::vector<std::byte>& outData,
+    std::string& outError);
+
+// Reads a `size`-byte CompressBlocks payload from `input`. Each block is scheduled for decoding as
+// soon as it has been read, so decompression overlaps the rest of the read. `maxRawSize` is
+// checked as in DecompressBlocks.
+[[nodiscard]] bool ReadCompressedBlocks(
+    JobSystem& jobs,
+    std::istream& input,
+    std::uint64_t size,
+    std::uint64_t maxRawSize,
+    std::vector<std::byte>& outData,
+    std::string& outError);
+}
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include "Engine/ModelCamera.hpp"
+#include "Engine/ModelData.hpp"
+
+namespace engine {
+inline constexpr std::uint32_t kMaxMeshChunkLods = 4;
+
+struct ChunkedMeshBuildOptions {
+    // Chunks are split until they hold at most this many triangles; clamped so local indices fit in 16 bits.
+    std::uint32_t maxTrianglesPerChunk;
+    // Level 0 is the source geometry; each further level clusters vertices on a grid twice as coarse.
+    std::uint32_t lodCount;
+};
+
+inline constexpr ChunkedMeshBuildOptions kDefaultChunkedMeshBuildOptions{16384, 3};
+
+struct MeshChunkLod {
+    std::uint64_t fileOffset;
+    std::uint64_t byteSize;
+    std::uint32_t vertexCount;
+    std::uint32_t triangleCount;
+    // Largest distance a vertex moved when clustered; 0 for level 0.
+    float geometricError;
+};
+
+struct MeshChunkInfo {
+    glm::vec3 boundsMin;
+    glm::vec3 boundsMax;
+    std::uint32_t materialIndex;
+    std::uint32_t lodCount;
+    std::array<MeshChunkLod, kMaxMeshChunkLods> lods;
+};
+
+// Partitions `model` into spatially coherent chunks with simplified levels of detail and writes them
+// to `path`. Materials and texture paths are kept; animations and morph targets are not.
+[[nodiscard]] bool WriteChunkedMesh(
+    const std::filesystem::path& path,
+    const ModelData& model,
+    const ChunkedMeshBuildOptions& options,
+    std::string& outError);
+
+struct MeshChunkRequest {
+    std::uint32_t chunkIndex;
+    std::uint32_t lod;
+};
+
+struct ResidentMeshChunk {
+    std::uint32_t chunkIndex;
+    std::uint32_t lod;
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec2> texCoords;
+    std::vector<std::uint16_t> indices;
+
+    [[nodiscard]] std::size_t GetByteSize() const noexcept {
+        return positions.size() * sizeof(glm::vec3) + texCoords.size() * sizeof(glm::vec2) +
+            indices.size() * sizeof(std::uint16_t);
+    }
+};
+
+struct ChunkedMeshStreamStats {
+    std::size_t budgetBytes;
+    std::size_t residentBytes;
+    std::size_t residentChunkCount;
+    std::size_t pendingLoadCount;
+    std::uint64_t loadCount;
+    std::uint64_t evictionCount;
+    // Loads dropped because every resident chunk was in use this frame and the budget was full.
+    std::uint64_t rejectedLoadCount;
+    std::uint64_t failedLoadCount;
+};
+
+// Streams a chunked mesh through a resident cache bounded by a byte budget. Only the header and chunk
+// table are kept in memory; chunk payloads are read on a background thread when requested and the
+// least recently used chunks are evicted to stay within the budget.
+class ChunkedMeshStream {
+public:
+    static constexpr std::size_t kDefaultBudgetBytes = 256u * 1024u * 1024u;
+
+    ChunkedMeshStream();
+    ~ChunkedMeshStream();
+
+    ChunkedMeshStream(const ChunkedMeshStream&) = delete;
+    ChunkedMeshStream& operator=(const ChunkedMeshStream&) = delete;
+
+    bool Open(const std::filesystem::path& path, std::size_t budgetBytes, std::string& outError);
+    void Close() noexcept;
+
+    [[nodiscard]] bool IsOpen() const noexcept;
+    [[nodiscard]] const std::filesystem::path& GetPath() const noexcept;
+    [[nodiscard]] const std::vector<MeshChunkInfo>& GetChunks() const noexcept;
+    [[nodiscard]] const std::vector<ModelMaterial>& GetMaterials() const noexcept;
+    [[nodiscard]] const std::vector<std::string>& GetTexturePaths() const noexcept;
+    [[nodiscard]] const std::string& GetPrimaryTexturePath() const noexcept;
+    [[nodiscard]] glm::vec3 GetBoundsMin() const noexcept;
+    [[nodiscard]] glm::vec3 GetBoundsMax() const noexcept;
+
+    void SetBudget(std::size_t budgetBytes);
+    [[nodiscard]] ChunkedMeshStreamStats GetStatistics() const;
+
+    // Chunks whose bounds intersect the view frustum, each with the coarsest level whose geometric
+    // error projects to at most `maxErrorPixels` on a viewport `viewportHeight` pixels tall.
+    void SelectChunks(
+        const ModelCamera& camera,
+        float aspectRatio,
+        float viewportHeight,
+        float maxErrorPixels,
+        std::vector<MeshChunkRequest>& outRequests) const;
+
+    // Marks the requested chunks as in use, queues loads for the missing ones (coarsest level first so
+    // something appears quickly) and returns the resident chunk closest to each requested level.
+    // Requests with nothing resident yet are skipped.
+    void Request(
+        const std::vector<MeshChunkRequest>& requests,
+        std::vector<std::shared_ptr<const ResidentMeshChunk>>& outDrawable);
+
+    // Concatenates `chunks` into a ModelData with one submesh per chunk.
+    void BuildModel(const std::vector<std::shared_ptr<const ResidentMeshChunk>>& chunks, ModelData& outModel) const;
+
+private:
+    [[nodiscard]] static std::uint64_t MakeKey(std::uint32_t chunkIndex, std::uint32_t lod) noexcept;
+    void QueueLoadLocked(std::uint32_t chunkIndex, std::uint32_t lod);
+    // Evicts least recently used chunks last used before `evictBeforeFrame` until `incomingBytes` fit.
+    void EvictToFitLocked(std::size_t incomingBytes, std::uint64_t evictBeforeFrame);
+    void LoaderMain(std::stop_token stopToken);
+
+    struct ResidentEntry {
+        std::shared_ptr<const ResidentMeshChunk> chunk;
+        std::uint64_t lastUsedFrame;
+    };
+
+    std::filesystem::path path_;
+    bool hasTexCoords_;
+    glm::vec3 boundsMin_;
+    glm::vec3 boundsMax_;
+    std::vector<MeshChunkInfo> chunks_;
+    std::vector<ModelMaterial> materials_;
+    std::vector<std::string> texturePaths_;
+    std::string primaryTexturePath_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable_any loadAvailable_;
+    std::unordered_map<std::uint64_t, ResidentEntry> resident_;
+    std::deque<std::uint64_t> loadQueue_;
+    std::unordered_map<std::uint64_t, bool> queuedKeys_;
+    std::uint64_t frameIndex_;
+    ChunkedMeshStreamStats stats_;
+    std::uint64_t inFlightKey_;
+    std::size_t inFlightBytes_;
+    // Decoded size of queued and in-flight loads, counted against the budget before they land.
+    std::size_t queuedBytes_;
+    std::jthread loader_;
+};
+}
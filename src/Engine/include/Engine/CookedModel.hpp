@@ -0,0 +1,132 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include "Engine/ModelData.hpp"
+
+namespace engine {
+enum class ModelSection : std::uint32_t {
+    Positions,
+    Indices,
+    Submeshes,
+    TexCoords,
+    Materials,
+    TexturePaths,
+    Animations,
+    MorphTargets,
+    Count
+};
+
+// Counts and bounds stored in the cooked header, available without decoding any section.
+struct CookedModelSummary {
+    std::uint64_t vertexCount;
+    std::uint64_t triangleCount;
+    std::uint64_t submeshCount;
+    std::uint64_t materialCount;
+    std::uint64_t textureCount;
+    std::uint64_t animationCount;
+    glm::vec3 boundsMin;
+    glm::vec3 boundsMax;
+};
+
+// Identifies the source file revision a cooked model was produced from.
+struct CookedModelSourceStamp {
+    std::uint64_t fileSize;
+    std::int64_t lastWriteTicks;
+};
+
+[[nodiscard]] bool ReadCookedModelSourceStamp(
+    const std::filesystem::path& sourcePath,
+    CookedModelSourceStamp& outStamp,
+    std::string& outError);
+
+// Cache file name for `sourcePath`: the source stem plus a hash of its absolute path.
+[[nodiscard]] std::filesystem::path GetCookedModelPath(
+    const std::filesystem::path& cacheDirectory,
+    const std::filesystem::path& sourcePath);
+
+// Writes every section of `model` to `cookedPath`, replacing any previous file atomically.
+[[nodiscard]] bool WriteCookedModel(
+    const std::filesystem::path& cookedPath,
+    const ModelData& model,
+    const CookedModelSourceStamp& sourceStamp,
+    std::string& outError);
+
+// A cooked model whose sections are read and decoded on first access. Open only reads the header.
+class LazyModel {
+public:
+    LazyModel();
+
+    bool Open(const std::filesystem::path& cookedPath, std::string& outError);
+    void Close() noexcept;
+
+    [[nodiscard]] bool IsOpen() const noexcept;
+    [[nodiscard]] bool IsSectionLoaded(ModelSection section) const noexcept;
+    [[nodiscard]] const CookedModelSummary& GetSummary() const noexcept;
+    [[nodiscard]] const CookedModelSourceStamp& GetSourceStamp() const noexcept;
+    [[nodiscard]] const std::string& GetSourcePath() const noexcept;
+    // Whether the stored texture paths still hold: the resolver rules and search roots are those
+    // it was cooked with, and no directory listed to resolve them has changed since.
+    [[nodiscard]] bool IsTextureResolutionCurrent() const;
+
+    // Section accessors decode on first use. A section that fails to decode is returned empty
+    // and GetLastError describes the failure.
+    const std::vector<glm::vec3>& GetPositions();
+    const std::vector<std::uint32_t>& GetIndices();
+    const std::vector<ModelSubmesh>& GetSubmeshes();
+    const std::vector<glm::vec2>& GetTexCoords();
+    const std::vector<ModelMaterial>& GetMaterials();
+    const std::vector<std::string>& GetTexturePaths();
+    const std::string& GetPrimaryTexturePath();
+    const std::vector<AnimationClip>& GetAnimations();
+    const std::vector<MorphTarget>& GetMorphTargets();
+    [[nodiscard]] const std::string& GetLastError() const noexcept;
+
+    // Copies geometry plus the requested sections into a plain ModelData.
+    bool Materialize(const ModelLoadRequest& request, ModelData& outModel, std::string& outError);
+
+private:
+    struct SectionRange {
+        std::uint64_t offset;
+        std::uint64_t size;
+    };
+
+    bool BeginSection(ModelSection section, std::vector<std::byte>& outBytes);
+
+    std::filesystem::path cookedPath_;
+    std::string sourcePath_;
+    CookedModelSourceStamp sourceStamp_;
+    CookedModelSummary summary_;
+    std::uint64_t textureSearchKey_;
+    std::vector<TextureSearchDirectory> textureSearchDirectories_;
+    std::vector<std::uint32_t> unresolvedTextureIndices_;
+    std::array<SectionRange, static_cast<std::size_t>(ModelSection::Count)> sections_;
+    std::uint32_t loadedSections_;
+    std::vector<glm::vec3> positions_;
+    std::vector<std::uint32_t> indices_;
+    std::vector<ModelSubmesh> submeshes_;
+    std::vector<glm::vec2> texCoords_;
+    std::vector<ModelMaterial> materials_;
+    std::vector<std::string> texturePaths_;
+    std::string primaryTexturePath_;
+    std::vector<AnimationClip> animations_;
+    std::vector<MorphTarget> morphTargets_;
+    std::string lastError_;
+};
+
+// Opens the cooked copy of `sourcePath` from `cacheDirectory`, cooking it with FbxLoader first
+// when it is missing, older than the source, or its texture paths would now resolve differently.
+bool OpenCachedModel(
+    const std::filesystem::path& sourcePath,
+    const std::filesystem::path& cacheDirectory,
+    LazyModel& outModel,
+    std::string& outError);
+}
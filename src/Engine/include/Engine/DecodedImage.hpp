@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace engine {
+// Tightly packed RGBA8 pixels, top row first.
+struct DecodedImage {
+    std::uint32_t width;
+    std::uint32_t height;
+    std::vector<std::uint8_t> pixels;
+};
+}
@@ -9,5 +9,10 @@ namespace engine {
 class FbxLoader {
 public:
     static bool LoadModel(const std::filesystem::path& filePath, ModelData& outModel, std::string& outError);
+    static bool LoadModel(
+        const std::filesystem::path& filePath,
+        const ModelLoadRequest& request,
+        ModelData& outModel,
+        std::string& outError);
 };
 }
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace engine {
+// Reports edits to a set of files. Uses inotify on Linux (watching each file's directory, so
+// editors that save by renaming a temporary file are caught) and falls back to polling file
+// size and timestamp elsewhere, and for files whose directory cannot be watched. Changes are
+// reported once a file has been quiet for the debounce interval, so a tool writing in several
+// chunks triggers one reload.
+class FileWatcher {
+public:
+    static constexpr std::chrono::milliseconds kDefaultDebounce{50};
+    static constexpr std::chrono::milliseconds kPollInterval{250};
+
+    explicit FileWatcher(std::chrono::milliseconds debounce = kDefaultDebounce);
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    // Replaces the watched set. Missing files are watched too and reported once they appear; when
+    // their directory is missing as well, they are polled.
+    void Watch(const std::vector<std::filesystem::path>& files);
+    void Clear() noexcept;
+
+    // Files that changed since the last call and have since been quiet for the debounce interval,
+    // spelled as they were passed to Watch.
+    [[nodiscard]] std::vector<std::filesystem::path> PollChanges();
+
+    [[nodiscard]] bool IsUsingNotifications() const noexcept;
+    [[nodiscard]] std::size_t GetWatchedFileCount() const noexcept;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct WatchedFile {
+        std::filesystem::path requestedPath;
+        std::filesystem::path path;
+        std::uintmax_t fileSize;
+        std::int64_t lastWriteTicks;
+        bool pending;
+        bool polled;
+        Clock::time_point lastEventTime;
+    };
+
+    void ReadNotifications(Clock::time_point now);
+    [[nodiscard]] bool WatchDirectory(const std::filesystem::path& directory);
+    void RewatchDirectory(const std::filesystem::path& directory, Clock::time_point now);
+    void PollTimestamps(Clock::time_point now);
+    void CloseNotifications() noexcept;
+
+    std::chrono::milliseconds debounce_;
+    std::unordered_map<std::string, WatchedFile> files_;
+    std::unordered_map<int, std::filesystem::path> directoryWatches_;
+    Clock::time_point lastPollTime_;
+    int notifyHandle_;
+};
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace engine {
+struct FlightRecorderSettings {
+    // Frames kept in the ring; about ten seconds at 60 Hz by default.
+    std::size_t frameCapacity;
+    // Frames longer than this, not counting excused phases, trigger a dump; zero disables dumps
+    // while recording continues.
+    double hitchBudgetSeconds;
+    // A hitch right after a dump is already in that dump's ring, so it is not dumped again.
+    double minimumSecondsBetweenDumps;
+    std::filesystem::path dumpDirectory;
+};
+
+// ENGINE_HITCH_BUDGET_MS (200 by default, 0 disables dumps) and ENGINE_HITCH_DIRECTORY (an
+// EngineHitches folder in the temp directory by default). Read once.
+[[nodiscard]] const FlightRecorderSettings& GetDefaultFlightRecorderSettings();
+
+struct FlightRecorderPhase {
+    // Must be a string literal; frames keep the pointer.
+    const char* name;
+    std::uint32_t depth;
+    // Excused phases, such as a modal dialog, are recorded but do not count toward the budget.
+    bool excused;
+    // Offsets from the start of the frame.
+    std::uint64_t startNanoseconds;
+    std::uint64_t endNanoseconds;
+};
+
+struct FlightRecorderEvent {
+    std::uint64_t offsetNanoseconds;
+    // Truncated and null-terminated.
+    std::array<char, 96> text;
+};
+
+struct FlightRecorderFrame {
+    static constexpr std::size_t kMaxPhases = 32;
+    static constexpr std::size_t kMaxEvents = 8;
+
+    std::uint64_t frameIndex;
+    std::uint64_t durationNanoseconds;
+    std::uint64_t excusedNanoseconds;
+    std::uint32_t phaseCount;
+    std::uint32_t eventCount;
+    // Phases and events that did not fit.
+    std::uint32_t droppedCount;
+    std::array<FlightRecorderPhase, kMaxPhases> phases;
+    std::array<FlightRecorderEvent, kMaxEvents> events;
+};
+
+struct FlightRecorderDump {
+    // Oldest first; the last frame is the hitch.
+    std::vector<FlightRecorderFrame> frames;
+    double budgetSeconds;
+    // The phase with the most time of its own in the hitch frame, or "(untracked)" when more of
+    // the frame was spent outside any phase.
+    std::string triggerPhase;
+    std::uint64_t triggerNanoseconds;
+};
+
+// Always-on record of the last few seconds of frames: per-phase timings and short event notes in
+// a fixed ring, so recording never allocates. Main thread only.
+class FlightRecorder {
+public:
+    explicit FlightRecorder(const FlightRecorderSettings& settings = GetDefaultFlightRecorderSettings());
+
+    FlightRecorder(const FlightRecorder&) = delete;
+    FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+    // The recorder the application loop feeds and the renderers annotate.
+    [[nodiscard]] static FlightRecorder& Get();
+
+    void BeginFrame(std::uint64_t frameIndex) noexcept;
+    // Closes the frame. Returns true with the ring in `outDump` when the frame went over budget.
+    bool EndFrame(FlightRecorderDump& outDump);
+
+    // Phases and events outside BeginFrame/EndFrame are ignored. Prefer ScopedFramePhase.
+    [[nodiscard]] std::uint32_t BeginPhase(const char* name, bool excused = false) noexcept;
+    void EndPhase(std::uint32_t phaseIndex) noexcept;
+    void RecordEvent(std::string_view text) noexcept;
+
+    void SetHitchBudget(double seconds) noexcept;
+    [[nodiscard]] const FlightRecorderSettings& GetSettings() const noexcept;
+    [[nodiscard]] std::size_t GetRecordedFrameCount() const noexcept;
+
+    // Test hook: replaces the steady clock.
+    using ClockFunction = std::uint64_t (*)();
+    void SetClock(ClockFunction clock) noexcept;
+
+private:
+    [[nodiscard]] FlightRecorderFrame& CurrentFrame() noexcept;
+    void FillDump(FlightRecorderDump& outDump) const;
+
+    FlightRecorderSettings settings_;
+    std::vector<FlightRecorderFrame> frames_;
+    std::size_t nextIndex_;
+    std::size_t size_;
+    bool frameOpen_;
+    std::uint32_t openDepth_;
+    std::uint64_t frameStartNanoseconds_;
+    std::uint64_t lastDumpNanoseconds_;
+    bool dumpedBefore_;
+    ClockFunction clock_;
+};
+
+// Times the enclosing scope as one phase of the current frame.
+class ScopedFramePhase {
+public:
+    ScopedFramePhase(FlightRecorder& recorder, const char* name, bool excused = false) noexcept;
+    explicit ScopedFramePhase(const char* name, bool excused = false) noexcept;
+    ~ScopedFramePhase();
+
+    ScopedFramePhase(const ScopedFramePhase&) = delete;
+    ScopedFramePhase& operator=(const ScopedFramePhase&) = delete;
+
+private:
+    FlightRecorder& recorder_;
+    std::uint32_t phaseIndex_;
+};
+
+// Writes `dump` as text to a hitch-<local time>-frame<N>.txt file in `directory`, creating it.
+[[nodiscard]] bool WriteFlightRecorderDump(
+    const FlightRecorderDump& dump,
+    const std::filesystem::path& directory,
+    std::filesystem::path& outPath,
+    std::string& outError);
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace engine {
+// Latency of the newest camera input one frame reflected, on the SDL_GetTicksNS clock.
+struct InputLatencySample {
+    // Input event to the camera being built for the model pass.
+    std::uint64_t inputToCameraNanoseconds;
+    // Input event to present returning. Scan-out, and any frames the driver still queues, come after this.
+    std::uint64_t inputToPresentNanoseconds;
+};
+
+using InputLatencyMeasure = std::uint64_t InputLatencySample::*;
+
+// Collects one sample per presented frame whose camera took input, in a fixed-capacity ring.
+class InputLatencyTracker {
+public:
+    static constexpr std::size_t kDefaultCapacity = 240;
+
+    explicit InputLatencyTracker(std::size_t capacity = kDefaultCapacity);
+
+    // Timestamp of input applied to the current frame's camera. The newest one of the frame counts.
+    void RecordInput(std::uint64_t eventNanoseconds) noexcept;
+    void RecordCameraBuilt(std::uint64_t nowNanoseconds) noexcept;
+    // Closes the frame. Frames without camera input leave no sample.
+    void RecordPresent(std::uint64_t nowNanoseconds);
+    void Clear() noexcept;
+
+    [[nodiscard]] std::size_t GetSize() const noexcept;
+    [[nodiscard]] std::size_t GetCapacity() const noexcept;
+    [[nodiscard]] const InputLatencySample& GetLatest() const noexcept;
+
+    [[nodiscard]] double ComputeAverage(InputLatencyMeasure measure) const noexcept;
+    [[nodiscard]] std::uint64_t ComputeMaximum(InputLatencyMeasure measure) const noexcept;
+
+private:
+    std::vector<InputLatencySample> samples_;
+    std::size_t nextIndex_;
+    std::size_t size_;
+    std::uint64_t pendingInputNanoseconds_;
+    std::uint64_t pendingCameraNanoseconds_;
+};
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace engine {
+// Totals since the job system started. Subtract two samples to get per-frame figures.
+struct JobSystemStatistics {
+    std::uint32_t workerCount;
+    std::uint64_t jobsExecuted;
+    std::uint64_t mainThreadJobsExecuted;
+    std::uint64_t steals;
+    std::uint64_t failedStealAttempts;
+    std::uint64_t idleNanoseconds;
+};
+
+// Work-stealing task scheduler. Each worker owns a deque: it pushes and pops its own jobs at the
+// back, and idle workers steal the oldest jobs from the front of the others. Jobs may depend on
+// other jobs and start once all of them have finished. Jobs scheduled for the main thread (SDL
+// and GPU calls) run only in RunMainThreadJobs or while the main thread waits.
+class JobSystem {
+    struct Job;
+
+public:
+    using JobHandle = std::shared_ptr<Job>;
+
+    // 0 uses one worker per hardware thread besides the calling thread, which becomes the main thread.
+    explicit JobSystem(unsigned workerCount = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Shared instance. The first call must come from the main thread; Application makes it at startup.
+    [[nodiscard]] static JobSystem& Get();
+
+    JobHandle Schedule(std::function<void()> work, std::initializer_list<JobHandle> dependencies = {});
+
+    // Like Schedule, but only workers run it: threads helping out while they wait never pick it up,
+    // so a long stage such as a model import cannot stall the main thread inside a ParallelFor.
+    JobHandle ScheduleBackground(std::function<void()> work, std::initializer_list<JobHandle> dependencies = {});
+    JobHandle ScheduleOnMainThread(std::function<void()> work, std::initializer_list<JobHandle> dependencies = {});
+
+    // Runs other jobs until `job` has finished.
+    void Wait(const JobHandle& job);
+
+    // Runs other jobs until `isDone` returns true. It is re-checked whenever a job finishes, so the
+    // condition must be made true from inside a job.
+    void WaitUntil(const std::function<bool()>& isDone);
+    [[nodiscard]] static bool IsComplete(const JobHandle& job) noexcept;
+
+    // Calls `body` on disjoint subranges covering [0, count) and returns once all have run. Ranges
+    // are split in half until they reach a grain sized from the worker count, but never below
+    // `minGrain`; the halves left behind are what idle workers steal.
+    void ParallelFor(std::size_t count, std::size_t minGrain, const std::function<void(std::size_t begin, std::size_t end)>& body);
+
+    // Runs every job queued for the main thread. Call once per frame from the main thread.
+    std::size_t RunMainThreadJobs();
+
+    [[nodiscard]] bool IsMainThread() const noexcept;
+    [[nodiscard]] unsigned GetWorkerCount() const noexcept;
+    [[nodiscard]] JobSystemStatistics GetStatistics() const noexcept;
+
+private:
+    enum class JobAffinity : std::uint8_t {
+        Any,
+        WorkersOnly,
+        MainThread
+    };
+
+    struct Job {
+        std::function<void()> work;
+        JobAffinity affinity;
+        std::atomic<std::uint32_t> pendingDependencies;
+        std::atomic<bool> completed;
+        std::mutex continuationMutex;
+        std::vector<JobHandle> continuations;
+    };
+
+    struct Worker {
+        std::mutex mutex;
+        std::deque<JobHandle> jobs;
+        std::deque<JobHandle> backgroundJobs;
+        std::atomic<std::uint64_t> jobsExecuted{0};
+        std::atomic<std::uint64_t> steals{0};
+        std::atomic<std::uint64_t> failedStealAttempts{0};
+        std::atomic<std::uint64_t> idleNanoseconds{0};
+        std::jthread thread;
+    };
+
+    JobHandle Submit(std::function<void()> work, JobAffinity affinity, std::initializer_list<JobHandle> dependencies);
+    void Enqueue(JobHandle job);
+    void Execute(const JobHandle& job);
+    JobHandle TakeJob(bool includeMainThreadJobs, bool includeBackgroundJobs);
+    JobHandle TakeFromDeques(std::deque<JobHandle> Worker::*deque, std::atomic<std::size_t>& queuedCount);
+    bool RunOneJob();
+    void NotifyWaiters();
+    void WorkerLoop(std::size_t workerIndex, std::stop_token stopToken);
+
+    std::thread::id mainThreadId_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::mutex mainThreadMutex_;
+    std::deque<JobHandle> mainThreadJobs_;
+    std::atomic<std::uint64_t> externalJobsExecuted_;
+    std::atomic<std::uint64_t> mainThreadJobsExecuted_;
+    std::atomic<std::uint64_t> externalSteals_;
+    std::atomic<std::size_t> nextExternalWorker_;
+    std::atomic<std::size_t> queuedJobCount_;
+    std::atomic<std::size_t> queuedBackgroundJobCount_;
+    std::atomic<std::size_t> queuedMainThreadJobCount_;
+    std::atomic<std::uint32_t> sleepingThreadCount_;
+    std::mutex wakeMutex_;
+    std::condition_variable_any wakeCondition_;
+};
+}
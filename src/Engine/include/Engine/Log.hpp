@@ -0,0 +1,269 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+
+namespace engine {
+enum class LogLevel : std::uint8_t {
+    Debug,
+    Info,
+    Warning,
+    Error,
+    Off
+};
+
+enum class LogCategory : std::uint8_t {
+    Application,
+    Loader,
+    Renderer,
+    Gpu,
+    Count
+};
+
+[[nodiscard]] const char* LogLevelName(LogLevel level) noexcept;
+[[nodiscard]] const char* LogCategoryName(LogCategory category) noexcept;
+
+// printf-style format string. The consteval constructor only accepts constant expressions, so the
+// pointer stays valid until the writer thread formats the record.
+struct LogFormatString {
+    consteval LogFormatString(const char* formatText) noexcept
+        : text(formatText) {
+    }
+
+    const char* text;
+};
+
+// A formatted message handed to the sink on the writer thread.
+struct LogRecord {
+    LogLevel level;
+    LogCategory category;
+    std::uint64_t timestampNanoseconds;
+    std::string_view message;
+};
+
+using LogSink = std::function<void(const LogRecord&)>;
+
+namespace detail {
+inline constexpr std::size_t kLogPayloadSize = 320;
+
+// Location of a string argument copied into the record payload.
+struct LogStringRef {
+    std::uint16_t offset;
+    std::uint16_t length;
+};
+
+template <typename T>
+inline constexpr bool kIsLogString = std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view> ||
+    std::is_same_v<T, const char*> || std::is_same_v<T, char*>;
+
+template <typename T>
+using LogStoredType = std::conditional_t<
+    kIsLogString<std::decay_t<T>>,
+    LogStringRef,
+    std::conditional_t<std::is_floating_point_v<std::decay_t<T>>, double, std::decay_t<T>>>;
+
+class LogPayloadWriter {
+public:
+    LogPayloadWriter(std::byte* payload, std::size_t argumentBytes) noexcept
+        : payload_(payload),
+          argumentCursor_(0),
+          stringCursor_(argumentBytes) {
+    }
+
+    template <typename T>
+    void Write(const T& value) noexcept {
+        using Stored = LogStoredType<T>;
+        static_assert(
+            kIsLogString<std::decay_t<T>> || std::is_arithmetic_v<Stored> || std::is_pointer_v<Stored>,
+            "Log arguments must be strings, numbers or pointers.");
+        Stored stored{};
+        if constexpr (std::is_pointer_v<std::decay_t<T>> && kIsLogString<std::decay_t<T>>) {
+            const char* text = value;
+            stored = CopyString(text ? std::string_view(text) : std::string_view("(null)"));
+        } else if constexpr (kIsLogString<std::decay_t<T>>) {
+            stored = CopyString(std::string_view(value));
+        } else {
+            stored = static_cast<Stored>(value);
+        }
+        std::memcpy(payload_ + argumentCursor_, &stored, sizeof(Stored));
+        argumentCursor_ += sizeof(Stored);
+    }
+
+private:
+    LogStringRef CopyString(std::string_view text) noexcept;
+
+    std::byte* payload_;
+    std::size_t argumentCursor_;
+    std::size_t stringCursor_;
+};
+
+template <typename T>
+T ReadLogArgument(const std::byte* payload, std::size_t& cursor) noexcept {
+    T value;
+    std::memcpy(&value, payload + cursor, sizeof(T));
+    cursor += sizeof(T);
+    return value;
+}
+
+template <typename T>
+auto ResolveLogArgument(const T& value, const std::byte* payload) noexcept {
+    if constexpr (std::is_same_v<T, LogStringRef>) {
+        return reinterpret_cast<const char*>(payload + value.offset);
+    } else {
+        return value;
+    }
+}
+
+void FormatLogMessage(std::string& outMessage, const char* format, ...);
+
+template <typename... Stored>
+void FormatLogPayload(const char* format, const std::byte* payload, std::string& outMessage) {
+    if constexpr (sizeof...(Stored) == 0) {
+        outMessage.assign(format);
+    } else {
+        std::size_t cursor = 0;
+        const std::tuple<Stored...> arguments{ReadLogArgument<Stored>(payload, cursor)...};
+        std::apply(
+            [&](const Stored&... values) {
+                FormatLogMessage(outMessage, format, ResolveLogArgument(values, payload)...);
+            },
+            arguments);
+    }
+}
+
+using LogPayloadFormatter = void (*)(const char*, const std::byte*, std::string&);
+}
+
+// Bounded multi-producer single-consumer logger. Producers copy the format pointer and raw
+// arguments into a ring slot without locking; a background writer thread formats records and
+// hands them to the sink. Records are dropped (and counted) when the ring is full.
+class Logger {
+public:
+    static constexpr std::size_t kDefaultCapacity = 4096;
+
+    explicit Logger(std::size_t capacity = kDefaultCapacity);
+    ~Logger();
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    // Process-wide logger used by the engine. Starts with the SDL log sink.
+    [[nodiscard]] static Logger& Get();
+
+    // Replaces the sink. Queued records reach the previous sink first.
+    void SetSink(LogSink sink);
+
+    void SetLevel(LogCategory category, LogLevel level) noexcept;
+    [[nodiscard]] LogLevel GetLevel(LogCategory category) const noexcept;
+    [[nodiscard]] bool IsEnabled(LogCategory category, LogLevel level) const noexcept {
+        return level >= categories_[static_cast<std::size_t>(category)].level.load(std::memory_order_relaxed);
+    }
+
+    // Records accepted per category per second; 0 disables the limit.
+    void SetRateLimit(LogCategory category, std::uint32_t recordsPerSecond) noexcept;
+
+    template <typename... Args>
+    void Write(LogCategory category, LogLevel level, LogFormatString format, const Args&... arguments) {
+        if (!IsEnabled(category, level) || !AcquireRateBudget(category)) {
+            return;
+        }
+
+        constexpr std::size_t argumentBytes = (std::size_t{0} + ... + sizeof(detail::LogStoredType<Args>));
+        static_assert(argumentBytes <= detail::kLogPayloadSize / 2, "Too many log arguments for one record.");
+
+        Slot* slot = AcquireSlot();
+        if (!slot) {
+            return;
+        }
+
+        slot->level = level;
+        slot->category = category;
+        slot->timestampNanoseconds = NowNanoseconds();
+        slot->format = format.text;
+        slot->formatter = &detail::FormatLogPayload<detail::LogStoredType<Args>...>;
+        detail::LogPayloadWriter writer(slot->payload.data(), argumentBytes);
+        (writer.Write(arguments), ...);
+        PublishSlot(*slot);
+    }
+
+    // Blocks until every record accepted before the call has reached the sink.
+    void Flush();
+
+    [[nodiscard]] std::uint64_t GetDroppedCount() const noexcept;
+    [[nodiscard]] std::uint64_t GetSuppressedCount(LogCategory category) const noexcept;
+
+private:
+    struct Slot {
+        std::atomic<std::size_t> sequence;
+        LogLevel level;
+        LogCategory category;
+        std::uint64_t timestampNanoseconds;
+        const char* format;
+        detail::LogPayloadFormatter formatter;
+        alignas(std::max_align_t) std::array<std::byte, detail::kLogPayloadSize> payload;
+    };
+
+    struct CategoryState {
+        std::atomic<LogLevel> level;
+        std::atomic<std::uint32_t> rateLimit;
+        std::atomic<std::int64_t> rateWindowSecond;
+        std::atomic<std::uint32_t> rateWindowCount;
+        std::atomic<std::uint64_t> suppressedCount;
+    };
+
+    static std::uint64_t NowNanoseconds() noexcept;
+    bool AcquireRateBudget(LogCategory category) noexcept;
+    Slot* AcquireSlot() noexcept;
+    void PublishSlot(Slot& slot) noexcept;
+    void WriterLoop(std::stop_token stopToken);
+    bool DrainSlots();
+    void ReportLosses();
+    void Emit(LogLevel level, LogCategory category, std::uint64_t timestampNanoseconds, std::string_view message);
+
+    std::unique_ptr<Slot[]> slots_;
+    std::size_t mask_;
+    alignas(64) std::atomic<std::size_t> enqueuePosition_;
+    alignas(64) std::size_t dequeuePosition_;
+    std::atomic<std::uint64_t> writtenCount_;
+    std::atomic<std::uint64_t> droppedCount_;
+    std::array<CategoryState, static_cast<std::size_t>(LogCategory::Count)> categories_;
+    std::array<std::uint64_t, static_cast<std::size_t>(LogCategory::Count)> reportedSuppressedCounts_;
+    std::uint64_t reportedDroppedCount_;
+    std::atomic<std::uint32_t> wakeCounter_;
+    std::mutex sinkMutex_;
+    LogSink sink_;
+    std::string formatBuffer_;
+    std::jthread writerThread_;
+};
+
+template <typename... Args>
+void LogDebug(LogCategory category, LogFormatString format, const Args&... arguments) {
+    Logger::Get().Write(category, LogLevel::Debug, format, arguments...);
+}
+
+template <typename... Args>
+void LogInfo(LogCategory category, LogFormatString format, const Args&... arguments) {
+    Logger::Get().Write(category, LogLevel::Info, format, arguments...);
+}
+
+template <typename... Args>
+void LogWarning(LogCategory category, LogFormatString format, const Args&... arguments) {
+    Logger::Get().Write(category, LogLevel::Warning, format, arguments...);
+}
+
+template <typename... Args>
+void LogError(LogCategory category, LogFormatString format, const Args&... arguments) {
+    Logger::Get().Write(category, LogLevel::Error, format, arguments...);
+}
+}
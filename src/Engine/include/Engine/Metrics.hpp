@@ -0,0 +1,167 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace engine {
+using MetricLabels = std::vector<std::pair<std::string, std::string>>;
+
+// Metric values are relaxed atomics: the frame loop pays an uncontended store per update, and
+// exporters read them from their own threads without taking a lock.
+class MetricCounter {
+public:
+    MetricCounter();
+
+    void Increment(std::uint64_t amount = 1) noexcept;
+    [[nodiscard]] std::uint64_t GetValue() const noexcept;
+
+private:
+    std::atomic<std::uint64_t> value_;
+};
+
+class MetricGauge {
+public:
+    MetricGauge();
+
+    void Set(double value) noexcept;
+    [[nodiscard]] double GetValue() const noexcept;
+
+private:
+    std::atomic<double> value_;
+};
+
+struct MetricHistogramSnapshot {
+    std::vector<double> upperBounds;
+    // Cumulative, one per bound plus +Inf, as Prometheus expects.
+    std::vector<std::uint64_t> cumulativeCounts;
+    double sum;
+};
+
+class MetricHistogram {
+public:
+    // `upperBounds` are sorted and deduplicated; +Inf is implied.
+    explicit MetricHistogram(std::vector<double> upperBounds);
+
+    // Meant for one writer at a time; concurrent observers stay correct but retry the sum.
+    void Observe(double value) noexcept;
+    [[nodiscard]] MetricHistogramSnapshot GetSnapshot() const;
+
+private:
+    std::vector<double> upperBounds_;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> bucketCounts_;
+    std::atomic<double> sum_;
+};
+
+// Named metrics in registration order. Registration takes a lock and returns a reference that
+// stays valid for the registry's lifetime; updates through it never lock. Series that share a
+// name form one family and must share a type.
+class MetricsRegistry {
+public:
+    MetricsRegistry();
+
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    MetricCounter& AddCounter(const std::string& name, const std::string& help, MetricLabels labels = {});
+    MetricGauge& AddGauge(const std::string& name, const std::string& help, MetricLabels labels = {});
+    MetricHistogram& AddHistogram(
+        const std::string& name,
+        const std::string& help,
+        std::vector<double> upperBounds,
+        MetricLabels labels = {});
+
+    // A gauge fixed at 1 whose labels carry the value, such as the renderer backend. Replaces the
+    // labels of an earlier info series with the same name.
+    void SetInfo(const std::string& name, const std::string& help, MetricLabels labels);
+
+    // Prometheus text exposition format, version 0.0.4.
+    void WritePrometheusText(std::string& outText) const;
+
+private:
+    enum class MetricType : std::uint8_t {
+        Counter,
+        Gauge,
+        Histogram,
+        Info
+    };
+
+    struct Series {
+        std::string name;
+        std::string help;
+        MetricType type;
+        MetricLabels labels;
+        std::unique_ptr<MetricCounter> counter;
+        std::unique_ptr<MetricGauge> gauge;
+        std::unique_ptr<MetricHistogram> histogram;
+    };
+
+    // Takes the series with its metric already built, so an exporter never sees it without one.
+    void AddSeries(Series series);
+
+    mutable std::mutex mutex_;
+    std::deque<Series> series_;
+};
+
+struct MetricsExportSettings {
+    // Serves GET /metrics on 127.0.0.1; -1 disables the listener and 0 picks a free port.
+    int httpPort;
+    // Rewritten atomically (write, then rename) for a node_exporter textfile collector; empty disables.
+    std::filesystem::path textFilePath;
+    double textFileIntervalSeconds;
+};
+
+// ENGINE_METRICS_PORT and ENGINE_METRICS_FILE, written every ENGINE_METRICS_INTERVAL seconds
+// (15 by default). Both exports are off unless set. Read once.
+[[nodiscard]] const MetricsExportSettings& GetDefaultMetricsExportSettings();
+
+[[nodiscard]] bool WriteMetricsTextFile(const MetricsRegistry& registry, const std::filesystem::path& path, std::string& outError);
+
+// Runs the configured exports on their own threads, so formatting and socket work never land on
+// the frame loop.
+class MetricsExporter {
+public:
+    MetricsExporter();
+    ~MetricsExporter();
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    // `beforeExport` runs on an export thread before each snapshot, for values too costly to
+    // refresh every frame. `registry` must outlive the exporter or the next Stop.
+    bool Start(
+        const MetricsRegistry& registry,
+        const MetricsExportSettings& settings,
+        std::function<void()> beforeExport,
+        std::string& outError);
+    void Stop() noexcept;
+
+    [[nodiscard]] bool IsRunning() const noexcept;
+    // The port the listener bound, or 0 when it is not running.
+    [[nodiscard]] int GetHttpPort() const noexcept;
+
+private:
+    void Collect(std::string& outText);
+    void ServeHttp(std::stop_token stopToken);
+    void WriteTextFilePeriodically(std::stop_token stopToken);
+
+    const MetricsRegistry* registry_;
+    MetricsExportSettings settings_;
+    std::function<void()> beforeExport_;
+    std::mutex collectMutex_;
+    std::intptr_t listenSocket_;
+    int httpPort_;
+    bool socketsInitialized_;
+    std::jthread httpThread_;
+    std::jthread textFileThread_;
+};
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include <glm/vec3.hpp>
+
+#include "Engine/ModelCamera.hpp"
+#include "Engine/ModelData.hpp"
+
+namespace engine {
+struct ModelRayHit {
+    float distance;
+    std::uint32_t triangleIndex;
+    std::uint32_t submeshIndex;
+    float barycentricU;
+    float barycentricV;
+    glm::vec3 position;
+};
+
+inline constexpr std::size_t kModelRayPacketWidth = 8;
+
+// Eight rays in SoA layout, so every traversal step runs on all of them at once. Lanes with a
+// `maxDistance` of zero or less are inactive.
+struct ModelRayPacket {
+    float originX[kModelRayPacketWidth];
+    float originY[kModelRayPacketWidth];
+    float originZ[kModelRayPacketWidth];
+    float directionX[kModelRayPacketWidth];
+    float directionY[kModelRayPacketWidth];
+    float directionZ[kModelRayPacketWidth];
+    float maxDistance[kModelRayPacketWidth];
+};
+
+// Lanes that hit nothing have `triangleIndex` set to ModelBvh::kNoTriangle.
+struct ModelRayPacketHit {
+    float distance[kModelRayPacketWidth];
+    std::uint32_t triangleIndex[kModelRayPacketWidth];
+    std::uint32_t submeshIndex[kModelRayPacketWidth];
+    float barycentricU[kModelRayPacketWidth];
+    float barycentricV[kModelRayPacketWidth];
+};
+
+// Asked about each candidate hit of a packet query; returning false lets the ray pass through, as
+// for an alpha-cutout texel.
+using ModelHitFilter = bool (*)(const void* context, std::uint32_t triangleIndex, std::uint32_t submeshIndex, float barycentricU, float barycentricV);
+
+struct ModelBounds {
+    glm::vec3 min;
+    glm::vec3 max;
+};
+
+// The geometry a ModelBvh is built from.
+struct ModelBvhSource {
+    std::vector<glm::vec3> positions;
+    std::vector<std::uint32_t> indices;
+    std::vector<ModelSubmesh> submeshes;
+};
+
+// Four-wide bounding volume hierarchy over the triangles of a ModelData, built with a binned SAH.
+// Nodes store child bounds in SoA layout so a ray is tested against all four children at once.
+class ModelBvh {
+public:
+    static constexpr std::size_t kNodeWidth = 4;
+    static constexpr std::uint32_t kMaxLeafTriangles = 4;
+    static constexpr std::uint32_t kEmptyChild = std::numeric_limits<std::uint32_t>::max();
+    static constexpr std::uint32_t kNoSubmesh = std::numeric_limits<std::uint32_t>::max();
+    static constexpr std::uint32_t kNoTriangle = std::numeric_limits<std::uint32_t>::max();
+
+    struct alignas(64) Node {
+        float minX[kNodeWidth];
+        float minY[kNodeWidth];
+        float minZ[kNodeWidth];
+        float maxX[kNodeWidth];
+        float maxY[kNodeWidth];
+        float maxZ[kNodeWidth];
+        std::uint32_t child[kNodeWidth];
+        std::uint32_t triangleCount[kNodeWidth];
+    };
+
+    struct Triangle {
+        glm::vec3 vertex0;
+        glm::vec3 edge1;
+        glm::vec3 edge2;
+        std::uint32_t triangleIndex;
+        std::uint32_t submeshIndex;
+        std::uint32_t padding;
+    };
+
+    static ModelBvh Build(
+        const std::vector<glm::vec3>& positions,
+        const std::vector<std::uint32_t>& indices,
+        const std::vector<ModelSubmesh>& submeshes);
+
+    [[nodiscard]] std::optional<ModelRayHit> Intersect(
+        const ModelRay& ray,
+        float maxDistance = std::numeric_limits<float>::max()) const noexcept;
+
+    // Closest accepted hit of each active lane. A node is entered when any lane hits its box, so
+    // coherent packets share most of their traversal.
+    void IntersectPacket(
+        const ModelRayPacket& packet,
+        ModelRayPacketHit& outHit,
+        ModelHitFilter filter = nullptr,
+        const void* filterContext = nullptr) const noexcept;
+
+    // Bit per lane, set when an accepted hit lies before that lane's `maxDistance`. Stops as soon as
+    // every active lane is blocked.
+    [[nodiscard]] std::uint32_t OccludedPacket(
+        const ModelRayPacket& packet,
+        ModelHitFilter filter = nullptr,
+        const void* filterContext = nullptr) const noexcept;
+
+    [[nodiscard]] bool IsEmpty() const noexcept;
+    [[nodiscard]] std::size_t GetNodeCount() const noexcept;
+    [[nodiscard]] std::size_t GetTriangleCount() const noexcept;
+    [[nodiscard]] const std::vector<ModelBounds>& GetSubmeshBounds() const noexcept;
+
+private:
+    // Single-ray traversal of the subtree in `rootChild` (a node, or a leaf's first triangle when
+    // `rootTriangleCount` is non-zero). Returns the hit triangle's slot, or kNoTriangle, and
+    // shortens `inOutDistance` to the hit. With `kAnyHit` it stops at the first accepted hit.
+    template <bool kAnyHit>
+    std::uint32_t TraverseRay(
+        const ModelRay& ray,
+        std::uint32_t rootChild,
+        std::uint32_t rootTriangleCount,
+        float& inOutDistance,
+        float& outU,
+        float& outV,
+        ModelHitFilter filter,
+        const void* filterContext) const noexcept;
+
+    template <bool kAnyHit>
+    std::uint32_t TraversePacket(
+        const ModelRayPacket& packet,
+        ModelRayPacketHit* outHit,
+        ModelHitFilter filter,
+        const void* filterContext) const noexcept;
+
+    std::vector<Node> nodes_;
+    std::vector<Triangle> triangles_;
+    std::vector<ModelBounds> submeshBounds_;
+};
+}
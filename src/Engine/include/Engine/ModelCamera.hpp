@@ -0,0 +1,31 @@
+#pragma once
+
+#include <functional>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+namespace engine {
+struct ModelCamera {
+    float yawDegrees;
+    float pitchDegrees;
+    float rollDegrees;
+    float cameraDistance;
+    glm::vec3 orbitPivot;
+};
+
+// Returns the camera to draw with. Renderers call it once per model pass, right before the
+// view-projection is built, so input that arrived while the frame was prepared is still drawn.
+using CameraLatch = std::function<ModelCamera()>;
+
+struct ModelRay {
+    glm::vec3 origin;
+    glm::vec3 direction;
+};
+
+[[nodiscard]] glm::mat4 BuildModelMatrix(const ModelCamera& camera);
+[[nodiscard]] glm::mat4 BuildModelViewProjection(const ModelCamera& camera, float aspectRatio);
+
+// Returns a ray in model space passing through the given normalized device coordinate (x right, y up).
+[[nodiscard]] ModelRay BuildModelSpacePickRay(const ModelCamera& camera, float aspectRatio, float ndcX, float ndcY);
+}
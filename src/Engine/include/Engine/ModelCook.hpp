@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Engine/ModelData.hpp"
+
+namespace engine {
+struct SubmeshMergeStats {
+    std::size_t submeshCountBefore;
+    std::size_t submeshCountAfter;
+    std::size_t materialCountBefore;
+    std::size_t materialCountAfter;
+};
+
+// Cook step that collapses identical materials and reorders the index buffer so every material owns
+// one contiguous index range, leaving a single submesh per material. Triangle winding is preserved;
+// indices not covered by any submesh are dropped.
+SubmeshMergeStats MergeSubmeshesByMaterial(ModelData& model);
+
+// Cook step that removes triangles referencing missing vertices, and any trailing partial
+// triangle, shifting submesh ranges to match; submeshes left empty are kept. Sets
+// `indicesValidated`. Returns the triangles removed.
+std::size_t ValidateTriangleIndices(ModelData& model);
+
+// One flag per texture slot: whether any material reaches it through one of `channels`. A model
+// without submeshes is drawn with slot 0, which then counts as its color texture.
+[[nodiscard]] std::vector<bool> FindTexturesForChannels(const ModelData& model, MaterialChannelMask channels);
+}
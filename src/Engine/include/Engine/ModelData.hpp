@@ -8,15 +8,47 @@
 #include <glm/vec3.hpp>
 
 namespace engine {
+struct MorphWeightKey {
+    float timeSeconds;
+    float weight;
+};
+
+// Weight of one morph target over a clip, interpolated linearly between keys sorted by time.
+struct MorphWeightCurve {
+    std::uint32_t targetIndex;
+    std::vector<MorphWeightKey> keys;
+};
+
 struct AnimationClip {
     std::string name;
     float durationSeconds;
     float ticksPerSecond;
+    std::vector<MorphWeightCurve> morphCurves;
 };
 
-struct ModelSubmesh {
-    std::uint32_t indexStart;
-    std::uint32_t indexCount;
+// A blend shape stored as the vertices it moves. vertexIndices is sorted; deltas holds x, y, z per
+// moved vertex, quantized so that delta = deltas * deltaScale.
+struct MorphTarget {
+    std::string name;
+    std::vector<std::uint32_t> vertexIndices;
+    std::vector<std::int16_t> deltas;
+    float deltaScale;
+    // Weight used when the playing clip has no curve for this target.
+    float defaultWeight;
+};
+
+// Bit mask of material texture channels. Renderers declare the channels they sample so textures
+// reached only through other channels are never decoded.
+using MaterialChannelMask = std::uint32_t;
+inline constexpr MaterialChannelMask kMaterialChannelColor = 1u << 0;
+inline constexpr MaterialChannelMask kMaterialChannelOpacity = 1u << 1;
+inline constexpr MaterialChannelMask kMaterialChannelNormal = 1u << 2;
+inline constexpr MaterialChannelMask kMaterialChannelEmissive = 1u << 3;
+inline constexpr MaterialChannelMask kMaterialChannelSpecular = 1u << 4;
+inline constexpr MaterialChannelMask kAllMaterialChannels =
+    kMaterialChannelColor | kMaterialChannelOpacity | kMaterialChannelNormal | kMaterialChannelEmissive | kMaterialChannelSpecular;
+
+struct ModelMaterial {
     std::int32_t textureIndex;
     std::int32_t opacityTextureIndex;
     std::int32_t normalTextureIndex;
@@ -29,18 +61,57 @@ struct ModelSubmesh {
     bool opacityTextureInverted;
 };
 
+struct ModelSubmesh {
+    std::uint32_t indexStart;
+    std::uint32_t indexCount;
+    std::uint32_t materialIndex;
+};
+
+// Sections a load should produce. Geometry (positions, indices, submeshes) is always produced;
+// submeshes carry no material when materials are not requested. Morph targets come with animations.
+struct ModelLoadRequest {
+    bool texCoords;
+    bool materials;
+    bool animations;
+};
+
+inline constexpr ModelLoadRequest kFullModelLoadRequest{true, true, true};
+inline constexpr ModelLoadRequest kGeometryModelLoadRequest{false, false, false};
+
+// A directory listed while resolving texture paths, with its modification time at that point
+// (zero when it could not be read). Adding or removing files changes it.
+struct TextureSearchDirectory {
+    std::string path;
+    std::int64_t lastWriteTicks;
+};
+
 struct ModelData {
     std::vector<glm::vec3> positions;
     std::vector<glm::vec2> texCoords;
     std::vector<std::uint32_t> indices;
     std::string primaryTexturePath;
     std::vector<std::string> texturePaths;
+    std::vector<ModelMaterial> materials;
     std::vector<ModelSubmesh> submeshes;
     std::vector<AnimationClip> animations;
+    std::vector<MorphTarget> morphTargets;
     std::string sourcePath;
+    // Every directory the loader listed to resolve texturePaths, so cached copies can tell when a
+    // texture would now resolve differently.
+    std::vector<TextureSearchDirectory> textureSearchDirectories;
+    // Slots of texturePaths that named no existing file when resolved; their paths are kept as
+    // written so the load can report them.
+    std::vector<std::uint32_t> unresolvedTextureIndices;
+    // Set by ValidateTriangleIndices: every index addresses a vertex, so renderers skip the check.
+    // Code that changes indices or positions afterwards must validate again or clear it.
+    bool indicesValidated = false;
 
     [[nodiscard]] bool IsValid() const noexcept {
         return !positions.empty() && !indices.empty();
     }
+
+    [[nodiscard]] const ModelMaterial* FindMaterial(const ModelSubmesh& submesh) const noexcept {
+        return submesh.materialIndex < materials.size() ? &materials[submesh.materialIndex] : nullptr;
+    }
 };
 }
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <glm/vec3.hpp>
+
+#include "Engine/ModelData.hpp"
+
+namespace engine {
+// Builds a sparse target from one delta per vertex of a mesh whose first vertex is `firstVertex`
+// in the model. Each axis is quantized to 16 bits against the largest component; vertices whose
+// delta rounds to zero on every axis are left out.
+[[nodiscard]] MorphTarget QuantizeMorphTarget(
+    std::string name,
+    const std::vector<glm::vec3>& deltas,
+    std::uint32_t firstVertex,
+    float defaultWeight);
+
+// Weight of every morph target of `model` at `timeSeconds` into `clip`: the clip's curves where it
+// has them, each target's default weight elsewhere. `clip` may be null.
+void SampleMorphWeights(const ModelData& model, const AnimationClip* clip, float timeSeconds, std::vector<float>& outWeights);
+
+// Extends every target to vertices appended as copies of existing ones: vertex
+// `firstDuplicate + i` moves like `duplicateSources[i]`.
+void AppendMorphTargetDuplicates(
+    std::vector<MorphTarget>& targets,
+    const std::vector<std::uint32_t>& duplicateSources,
+    std::uint32_t firstDuplicate);
+
+// Applies morph target weights to a model's positions in place. Only vertices some target moves
+// are stored, and only those of targets weighted now or by the previous Apply are written: they
+// are rebuilt as rest position plus the weighted deltas, in blocks spread across the job system.
+class MorphTargetBlender {
+public:
+    MorphTargetBlender();
+
+    // Call whenever the model's positions or targets are replaced; `model` must be at rest.
+    void Reset(const ModelData& model);
+
+    // Returns the number of vertices written: zero when the weights match the previous call or
+    // `model` no longer has the vertex and target counts Reset saw.
+    std::size_t Apply(const std::vector<float>& weights, ModelData& model);
+
+    // Vertices moved by at least one target.
+    [[nodiscard]] std::size_t GetMovedVertexCount() const noexcept;
+
+private:
+    std::size_t vertexCount_;
+    std::size_t blockCount_;
+    // Sorted union of every target's vertices, with their rest positions in separate axes.
+    std::vector<std::uint32_t> movedVertices_;
+    std::vector<float> restX_;
+    std::vector<float> restY_;
+    std::vector<float> restZ_;
+    // Per target: the movedVertices_ slot of each of its vertices, and where each block of slots
+    // starts in its vertex list (blockCount_ + 1 entries per target).
+    std::vector<std::vector<std::uint32_t>> targetSlots_;
+    std::vector<std::vector<std::uint32_t>> targetBlockStarts_;
+    std::vector<float> appliedWeights_;
+    // Working lists of Apply, sized by Reset so animating a model does not allocate.
+    std::vector<float> sanitizedWeights_;
+    std::vector<std::size_t> activeTargets_;
+    std::vector<std::size_t> rewrittenTargets_;
+    std::vector<std::uint32_t> blockWritten_;
+};
+}
@@ -19,10 +19,16 @@ public:
     void Shutdown() noexcept override;
     void BeginFrame() override;
     void EndFrame() override;
-    void RenderModelWireframe(const ModelData& model, float yawDegrees, float pitchDegrees, float rollDegrees, float cameraDistance, bool wireOverlayEnabled) override;
+    void RenderModelWireframe(const ModelData& model, const CameraLatch& latchCamera, bool wireOverlayEnabled) override;
+    void InvalidateModelTextures(const std::vector<std::string>& texturePaths) override;
+    void SetRenderScale(float scale) override;
+    void SetOverdrawVisualization(bool enabled) override;
+    void SetPointCloudPreview(std::shared_ptr<const PointCloudPreview> preview) override;
 
+    [[nodiscard]] MaterialChannelMask GetSampledMaterialChannels() const noexcept override;
     [[nodiscard]] SDL_Renderer* GetNativeRenderer() const noexcept override;
     [[nodiscard]] const char* GetName() const noexcept override;
+    [[nodiscard]] RendererFrameStatistics GetFrameStatistics() const noexcept override;
 
 #if defined(_WIN32)
     [[nodiscard]] ID3D12Device* GetDevice() const noexcept;
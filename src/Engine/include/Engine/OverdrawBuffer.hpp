@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace engine {
+struct OverdrawStatistics {
+    // Pixel writes summed over every triangle, and pixels written at least once.
+    std::uint64_t shadedPixels;
+    std::uint64_t coveredPixels;
+    std::uint32_t maxOverdraw;
+    // Writes per covered pixel; 1.0 means nothing was drawn twice.
+    double averageOverdraw;
+};
+
+struct OverdrawPoint {
+    float x;
+    float y;
+};
+
+// Counts how many triangles write each pixel of a viewport, the way a rasterizer that draws
+// everything submitted (no depth test) would. Pixels are sampled at their centers with a
+// top-left fill rule, so triangles sharing an edge count each pixel on it once.
+class OverdrawBuffer {
+public:
+    static constexpr std::uint32_t kDefaultSaturationCount = 8;
+
+    OverdrawBuffer();
+
+    // Resizes to `width` x `height` and zeroes every count.
+    void Reset(int width, int height);
+
+    // Only rows in [firstRow, endRow) are touched, so disjoint row bands can be filled from
+    // different threads. Counts saturate rather than wrap.
+    void AddTriangle(const OverdrawPoint& a, const OverdrawPoint& b, const OverdrawPoint& c, int firstRow, int endRow) noexcept;
+    void AddTriangle(const OverdrawPoint& a, const OverdrawPoint& b, const OverdrawPoint& c) noexcept;
+
+    [[nodiscard]] OverdrawStatistics ComputeStatistics() const noexcept;
+
+    // RGBA8 heatmap, one pixel per count: black where nothing was drawn, then blue, green,
+    // yellow and red as the count rises to `saturationCount`, and white beyond it.
+    void WriteHeatmap(std::vector<std::uint8_t>& outRgba, std::uint32_t saturationCount = kDefaultSaturationCount) const;
+
+    [[nodiscard]] int GetWidth() const noexcept;
+    [[nodiscard]] int GetHeight() const noexcept;
+    [[nodiscard]] std::uint16_t GetCount(int x, int y) const noexcept;
+
+private:
+    int width_;
+    int height_;
+    std::vector<std::uint16_t> counts_;
+};
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+#include "Engine/ModelCamera.hpp"
+#include "Engine/ModelData.hpp"
+
+namespace engine {
+// Models with at least this many vertices get a preview built at load.
+inline constexpr std::size_t kPointCloudPreviewMinimumVertices = 1000000;
+inline constexpr std::size_t kPointCloudPreviewTargetPoints = 1u << 19;
+
+struct PointCloudPreviewPoint {
+    glm::vec3 position;
+    // Unit normal as three signed bytes (x in the low byte); zero for vertices with no triangle.
+    std::uint32_t packedNormal;
+};
+
+struct PointCloudPreview {
+    // In Morton order, so neighbouring points splat into neighbouring pixels.
+    std::vector<PointCloudPreviewPoint> points;
+    // Edge of the grid cell each point stands for; splats are sized to its projection.
+    float cellSize;
+    // Vertex count of the model it was built from, so a renderer can tell it still matches.
+    std::size_t sourceVertexCount;
+};
+
+// Stratified subsample of the model's vertices: they are bucketed into the finest octree level
+// whose occupied cells number at most `targetPointCount`, and one vertex is kept per cell. Each
+// kept vertex gets the area-weighted normal of the triangles around it. Runs on the job system.
+[[nodiscard]] PointCloudPreview BuildPointCloudPreview(const ModelData& model, std::size_t targetPointCount);
+
+// Colour and depth target for splats. Each pixel holds depth and colour in one word, so the depth
+// test is a single compare-and-swap and splats may be added from any number of threads.
+class SplatBuffer {
+public:
+    static constexpr int kMaxSplatSize = 8;
+
+    SplatBuffer();
+
+    // Resizes to `width` x `height` and clears every pixel.
+    void Reset(int width, int height);
+
+    // Writes a `size` x `size` square centred on (x, y) wherever `depth` (in [0, 1]) is nearer.
+    void AddSplat(float x, float y, float depth, int size, std::uint32_t rgba) noexcept;
+
+    // RGBA8; pixels no splat reached are transparent.
+    void WriteRgba(std::vector<std::uint8_t>& outRgba) const;
+
+    [[nodiscard]] int GetWidth() const noexcept;
+    [[nodiscard]] int GetHeight() const noexcept;
+    // Packed RGBA (red in the low byte) of a pixel, or 0 where nothing was drawn.
+    [[nodiscard]] std::uint32_t GetColor(int x, int y) const noexcept;
+    [[nodiscard]] std::uint64_t CountCoveredPixels() const noexcept;
+
+private:
+    int width_;
+    int height_;
+    std::vector<std::uint64_t> pixels_;
+};
+
+// Projects and splats every preview point, lit by a light at the eye. Returns the number drawn.
+std::size_t SplatPointCloudPreview(const PointCloudPreview& preview, const glm::mat4& modelViewProjection, SplatBuffer& buffer);
+
+// Tells whether the camera moved within the last `settleSeconds`. A camera seen for the first
+// time counts as still.
+class CameraMotionTracker {
+public:
+    static constexpr double kDefaultSettleSeconds = 0.25;
+
+    explicit CameraMotionTracker(double settleSeconds = kDefaultSettleSeconds);
+
+    [[nodiscard]] bool Update(const ModelCamera& camera, double nowSeconds) noexcept;
+    void Reset() noexcept;
+
+private:
+    double settleSeconds_;
+    ModelCamera lastCamera_;
+    double lastMotionSeconds_;
+    bool hasCamera_;
+    bool hasMoved_;
+};
+}
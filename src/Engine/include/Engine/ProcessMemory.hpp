@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+
+namespace engine {
+struct ProcessMemorySample {
+    // Resident set size (the working set on Windows); zero where the platform has no cheap query.
+    std::uint64_t residentBytes;
+    // The allocator's own view, available with glibc: bytes handed out to the program, and bytes
+    // the heap holds without handing them out. Free bytes that grow while in-use bytes stay flat
+    // are fragmentation.
+    std::uint64_t heapInUseBytes;
+    std::uint64_t heapFreeBytes;
+    bool heapStatisticsAvailable;
+};
+
+// Cheap enough to call every frame; the heap figures walk the allocator's arenas.
+[[nodiscard]] ProcessMemorySample SampleProcessMemory();
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/vec4.hpp>
+
+#include "Engine/DecodedImage.hpp"
+#include "Engine/ModelBvh.hpp"
+#include "Engine/ModelCamera.hpp"
+#include "Engine/ModelData.hpp"
+
+namespace engine {
+struct RayTraceSettings {
+    std::uint32_t width;
+    std::uint32_t height;
+    // Jittered primary rays per pixel.
+    std::uint32_t samplesPerPixel;
+    // Ambient occlusion rays cast from every primary hit; zero leaves every hit unoccluded.
+    std::uint32_t occlusionRaysPerSample;
+    // Length of an occlusion ray as a fraction of the model's bounding-box diagonal.
+    float occlusionRadius;
+};
+
+inline constexpr RayTraceSettings kThumbnailRayTraceSettings{256, 256, 16, 4, 0.2f};
+
+struct RayTraceStatistics {
+    std::uint64_t primaryRays;
+    std::uint64_t occlusionRays;
+    double seconds;
+
+    [[nodiscard]] double GetMegaraysPerSecond() const noexcept {
+        return seconds > 0.0 ? static_cast<double>(primaryRays + occlusionRays) / seconds / 1.0e6 : 0.0;
+    }
+};
+
+// Offline reference renderer for thumbnails. Traces the model through a ModelBvh in packets of
+// 4x2 pixels on every job system worker, lights hits by ambient occlusion and a headlight, and
+// lets rays pass through alpha-cutout texels. Framing and texture orientation match the
+// interactive renderers for the same ModelCamera.
+class RayTracer {
+public:
+    // Copies the model and builds its BVH. `textures` is indexed like model.texturePaths; missing
+    // or empty images sample as white.
+    RayTracer(const ModelData& model, std::vector<DecodedImage> textures);
+
+    // RGBA8, top row first. Alpha is the fraction of samples that hit the model, so the image
+    // composites over any background.
+    [[nodiscard]] DecodedImage Render(const ModelCamera& camera, const RayTraceSettings& settings, RayTraceStatistics& outStatistics) const;
+
+    [[nodiscard]] const ModelBvh& GetBvh() const noexcept;
+
+private:
+    // ModelHitFilter for the BVH: rejects hits on cutout texels.
+    static bool AcceptHit(const void* context, std::uint32_t triangleIndex, std::uint32_t submeshIndex, float barycentricU, float barycentricV);
+
+    // Colour and final opacity of the material at a point on a triangle.
+    [[nodiscard]] glm::vec4 SampleMaterial(std::uint32_t triangleIndex, std::uint32_t submeshIndex, float barycentricU, float barycentricV) const noexcept;
+
+    ModelData model_;
+    std::vector<DecodedImage> textures_;
+    ModelBvh bvh_;
+    // Per submesh, whether its material discards texels below the alpha cutoff.
+    std::vector<std::uint8_t> submeshCutout_;
+    float boundsDiagonal_;
+};
+
+// Reads and decodes the colour and opacity textures the model's materials reference, indexed like
+// model.texturePaths. Textures that cannot be read or decoded are left empty.
+[[nodiscard]] std::vector<DecodedImage> LoadRayTracerTextures(const ModelData& model);
+}
@@ -1,13 +1,19 @@
 #pragma once
 
+#include <memory>
 #include <string>
+#include <vector>
 
+#include "Engine/ModelCamera.hpp"
 #include "Engine/ModelData.hpp"
+#include "Engine/RendererStatistics.hpp"
 
 struct SDL_Renderer;
 struct SDL_Window;
 
 namespace engine {
+struct PointCloudPreview;
+
 class Renderer {
 public:
     virtual ~Renderer() = default;
@@ -18,9 +24,33 @@ public:
     virtual void BeginFrame() = 0;
     virtual void EndFrame() = 0;
 
-    virtual void RenderModelWireframe(const ModelData& model, float yawDegrees, float pitchDegrees, float rollDegrees, float cameraDistance, bool wireOverlayEnabled) = 0;
+    virtual void RenderModelWireframe(const ModelData& model, const CameraLatch& latchCamera, bool wireOverlayEnabled) = 0;
+
+    // Marks cached copies of these texture files stale; they are decoded and uploaded again the
+    // next time a model referencing them is rendered. Other cached textures are kept.
+    virtual void InvalidateModelTextures(const std::vector<std::string>& texturePaths) = 0;
+
+    // Fraction of the output size, in (0, 1], the model pass renders at before it is upscaled
+    // under the overlay. Backends without an offscreen path keep rendering at full size.
+    virtual void SetRenderScale(float scale) = 0;
+
+    // Replaces the model pass image with a heatmap of how many times each pixel was written and
+    // fills the overdraw counters. Backends without a per-pixel counter leave those at zero.
+    virtual void SetOverdrawVisualization(bool enabled) = 0;
+
+    // Drawn as depth-tested splats instead of the model's triangles while the camera moves; null
+    // turns the preview off. It is ignored when its vertex count no longer matches the model, and
+    // backends without a CPU splat path ignore it entirely.
+    virtual void SetPointCloudPreview(std::shared_ptr<const PointCloudPreview> preview) = 0;
+
+    // Material texture channels this backend samples. Textures referenced only through other
+    // channels are not decoded or uploaded until a backend that samples them renders the model.
+    [[nodiscard]] virtual MaterialChannelMask GetSampledMaterialChannels() const noexcept = 0;
 
     [[nodiscard]] virtual SDL_Renderer* GetNativeRenderer() const noexcept = 0;
     [[nodiscard]] virtual const char* GetName() const noexcept = 0;
+
+    // Counters for the most recently rendered frame.
+    [[nodiscard]] virtual RendererFrameStatistics GetFrameStatistics() const noexcept = 0;
 };
 }
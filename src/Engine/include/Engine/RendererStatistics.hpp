@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace engine {
+// Work done by a renderer for one frame. Counters are reset in BeginFrame.
+struct RendererFrameStatistics {
+    std::uint64_t verticesProjected;
+    std::uint64_t trianglesSubmitted;
+    std::uint64_t trianglesCulled;
+    std::uint64_t trianglesClipped;
+    std::uint64_t drawCalls;
+    std::uint64_t textureBinds;
+    std::uint64_t pipelineStateChanges;
+    std::uint64_t bytesUploaded;
+    std::uint64_t composedTextureCacheHits;
+    std::uint64_t composedTextureCacheMisses;
+    std::uint64_t overlayLineCount;
+    // Pixels covered by the model pass target; drops with the dynamic resolution scale.
+    std::uint64_t scenePixels;
+    // Overdraw counters, filled only while the overdraw heatmap is shown: pixel writes by the
+    // model pass, pixels written at least once, and the most writes to a single pixel.
+    std::uint64_t shadedPixels;
+    std::uint64_t coveredPixels;
+    std::uint64_t maxOverdraw;
+    // Texture streaming state at the start of the model pass: bytes of resident mip levels,
+    // decodes in flight and textures still showing their placeholder.
+    std::uint64_t textureBytesResident;
+    std::uint64_t textureDecodesPending;
+    std::uint64_t texturesAtPlaceholder;
+    // Points splatted by the point-cloud preview; zero on frames drawn with triangles.
+    std::uint64_t previewSplats;
+};
+
+using RendererStatisticsCounter = std::uint64_t RendererFrameStatistics::*;
+
+struct RendererStatisticsField {
+    const char* name;
+    RendererStatisticsCounter counter;
+};
+
+// Every counter with a display name, in declaration order.
+[[nodiscard]] const std::vector<RendererStatisticsField>& GetRendererStatisticsFields();
+
+// Fixed-capacity ring of the most recent frames.
+class RendererStatisticsHistory {
+public:
+    static constexpr std::size_t kDefaultCapacity = 240;
+
+    explicit RendererStatisticsHistory(std::size_t capacity = kDefaultCapacity);
+
+    void Push(const RendererFrameStatistics& frame);
+    void Clear() noexcept;
+
+    [[nodiscard]] std::size_t GetSize() const noexcept;
+    [[nodiscard]] std::size_t GetCapacity() const noexcept;
+    [[nodiscard]] const RendererFrameStatistics& GetLatest() const noexcept;
+
+    [[nodiscard]] double ComputeAverage(RendererStatisticsCounter counter) const noexcept;
+    [[nodiscard]] std::uint64_t ComputeMaximum(RendererStatisticsCounter counter) const noexcept;
+
+    // Values of one counter ordered oldest to newest, suitable for ImGui::PlotLines.
+    void CopySeries(RendererStatisticsCounter counter, std::vector<float>& outValues) const;
+
+private:
+    std::vector<RendererFrameStatistics> frames_;
+    std::size_t nextIndex_;
+    std::size_t size_;
+};
+}
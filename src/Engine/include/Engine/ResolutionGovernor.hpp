@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+
+namespace engine {
+struct ResolutionGovernorSettings {
+    double targetFrameSeconds;
+    float minScale;
+    float maxScale;
+    // Scales are snapped to multiples of this so the offscreen target is not resized every frame.
+    float scaleQuantum;
+    // Fraction of the target the smoothed frame time must exceed before dropping resolution, or
+    // fall below before raising it.
+    double dropThreshold;
+    double raiseThreshold;
+    // Consecutive frames beyond a threshold before the scale changes. Raising waits longer than
+    // dropping so a recovered frame rate is not immediately spent again.
+    std::uint32_t framesBeforeDrop;
+    std::uint32_t framesBeforeRaise;
+};
+
+[[nodiscard]] ResolutionGovernorSettings GetDefaultResolutionGovernorSettings();
+
+// Picks the model pass render scale from measured model pass times. Rasterization cost is taken to
+// follow pixel count, so the scale moves by the square root of the frame time ratio.
+class ResolutionGovernor {
+public:
+    explicit ResolutionGovernor(const ResolutionGovernorSettings& settings = GetDefaultResolutionGovernorSettings());
+
+    // Feeds one model pass time and returns the scale to render the next pass at.
+    float Update(double frameSeconds);
+    void Reset() noexcept;
+
+    void SetSettings(const ResolutionGovernorSettings& settings);
+    [[nodiscard]] const ResolutionGovernorSettings& GetSettings() const noexcept;
+    [[nodiscard]] float GetScale() const noexcept;
+    [[nodiscard]] double GetSmoothedFrameSeconds() const noexcept;
+
+private:
+    [[nodiscard]] float Quantize(float scale) const noexcept;
+
+    ResolutionGovernorSettings settings_;
+    float scale_;
+    double smoothedFrameSeconds_;
+    std::uint32_t slowFrameCount_;
+    std::uint32_t fastFrameCount_;
+};
+}
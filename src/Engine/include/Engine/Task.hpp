@@ -0,0 +1,362 @@
+#pragma once
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Engine/BatchFileReader.hpp"
+#include "Engine/JobSystem.hpp"
+
+namespace engine {
+template <typename T>
+class Task;
+
+namespace detail {
+class TaskPromiseBase {
+public:
+    struct FinalAwaiter {
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) const noexcept {
+            TaskPromiseBase& promise = handle.promise();
+            // Whoever sees the completed flag may destroy the frame, so nothing in it is touched afterwards.
+            const std::coroutine_handle<> continuation = promise.continuation_;
+            promise.completed_.store(true, std::memory_order_release);
+            return continuation ? continuation : std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept {
+        }
+    };
+
+    std::suspend_always initial_suspend() const noexcept {
+        return {};
+    }
+
+    FinalAwaiter final_suspend() const noexcept {
+        return {};
+    }
+
+    // Engine code reports errors through return values; an escaping exception is a bug.
+    void unhandled_exception() const noexcept {
+        std::terminate();
+    }
+
+    void SetContinuation(std::coroutine_handle<> continuation) noexcept {
+        continuation_ = continuation;
+    }
+
+    [[nodiscard]] bool IsCompleted() const noexcept {
+        return completed_.load(std::memory_order_acquire);
+    }
+
+private:
+    std::coroutine_handle<> continuation_{};
+    std::atomic<bool> completed_{false};
+};
+
+template <typename T>
+class TaskPromise : public TaskPromiseBase {
+public:
+    Task<T> get_return_object() noexcept;
+
+    template <typename Value>
+    void return_value(Value&& value) {
+        result_.emplace(std::forward<Value>(value));
+    }
+
+    T TakeResult() {
+        return std::move(*result_);
+    }
+
+private:
+    std::optional<T> result_;
+};
+
+template <>
+class TaskPromise<void> : public TaskPromiseBase {
+public:
+    Task<void> get_return_object() noexcept;
+
+    void return_void() const noexcept {
+    }
+
+    void TakeResult() const noexcept {
+    }
+};
+}
+
+// Lazily started coroutine producing a T. Nothing runs until the task is awaited or started;
+// `co_await std::move(task)` runs it and continues the awaiting coroutine on whichever thread
+// finishes it. A task that has started must not be destroyed before it finishes.
+template <typename T = void>
+class Task {
+public:
+    using promise_type = detail::TaskPromise<T>;
+
+    Task() noexcept = default;
+
+    explicit Task(std::coroutine_handle<promise_type> handle) noexcept
+        : handle_(handle) {
+    }
+
+    Task(Task&& other) noexcept
+        : handle_(std::exchange(other.handle_, {})) {
+    }
+
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            Reset();
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task() {
+        Reset();
+    }
+
+    // Runs the task on the calling thread until its first suspension.
+    void Start() {
+        handle_.resume();
+    }
+
+    [[nodiscard]] bool IsValid() const noexcept {
+        return static_cast<bool>(handle_);
+    }
+
+    [[nodiscard]] bool IsReady() const noexcept {
+        return handle_ && handle_.promise().IsCompleted();
+    }
+
+    // Only valid once IsReady returns true.
+    T TakeResult() {
+        return handle_.promise().TakeResult();
+    }
+
+    auto operator co_await() && noexcept {
+        struct Awaiter {
+            std::coroutine_handle<promise_type> handle;
+
+            bool await_ready() const noexcept {
+                return false;
+            }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) const noexcept {
+                handle.promise().SetContinuation(awaiting);
+                return handle;
+            }
+
+            T await_resume() const {
+                return handle.promise().TakeResult();
+            }
+        };
+        return Awaiter{handle_};
+    }
+
+private:
+    void Reset() noexcept {
+        if (handle_) {
+            handle_.destroy();
+            handle_ = {};
+        }
+    }
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+namespace detail {
+template <typename T>
+Task<T> TaskPromise<T>::get_return_object() noexcept {
+    return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+    return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+// Runs eagerly and frees its own frame when it finishes.
+struct DetachedTask {
+    struct promise_type {
+        DetachedTask get_return_object() const noexcept {
+            return {};
+        }
+
+        std::suspend_never initial_suspend() const noexcept {
+            return {};
+        }
+
+        std::suspend_never final_suspend() const noexcept {
+            return {};
+        }
+
+        void return_void() const noexcept {
+        }
+
+        void unhandled_exception() const noexcept {
+            std::terminate();
+        }
+    };
+};
+
+template <typename T>
+DetachedTask RunDetached(Task<T> task) {
+    co_await std::move(task);
+}
+}
+
+// Continues the awaiting coroutine as a background job, which only worker threads run.
+struct ResumeOnWorker {
+    JobSystem& jobs;
+
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) const {
+        jobs.ScheduleBackground([handle]() { handle.resume(); });
+    }
+
+    void await_resume() const noexcept {
+    }
+};
+
+// Continues the awaiting coroutine on the main thread, for SDL and GPU calls. Does not suspend
+// when already there.
+struct ResumeOnMainThread {
+    JobSystem& jobs;
+
+    bool await_ready() const noexcept {
+        return jobs.IsMainThread();
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) const {
+        jobs.ScheduleOnMainThread([handle]() { handle.resume(); });
+    }
+
+    void await_resume() const noexcept {
+    }
+};
+
+// Runs `task` to completion with nobody awaiting it. Its frame is freed when it finishes.
+template <typename T>
+void StartDetached(Task<T> task) {
+    detail::RunDetached(std::move(task));
+}
+
+// Starts `task` and blocks, running other jobs meanwhile, until it finishes. Every awaitable here
+// resumes through the job system, which is what wakes the waiting thread.
+template <typename T>
+T SyncWait(JobSystem& jobs, Task<T> task) {
+    task.Start();
+    jobs.WaitUntil([&task]() { return task.IsReady(); });
+    return task.TakeResult();
+}
+
+// Calls `function` on a worker. The awaiting coroutine continues on that worker.
+template <typename Function>
+Task<std::invoke_result_t<Function&>> RunOnWorker(JobSystem& jobs, Function function) {
+    co_await ResumeOnWorker{jobs};
+    if constexpr (std::is_void_v<std::invoke_result_t<Function&>>) {
+        function();
+    } else {
+        co_return function();
+    }
+}
+
+namespace detail {
+struct WhenAllCounter {
+    std::atomic<std::size_t> remaining;
+    std::coroutine_handle<> parent;
+
+    void Arrive() {
+        if (remaining.fetch_sub(1) == 1) {
+            parent.resume();
+        }
+    }
+};
+
+// Suspends until every child started by `launch` has arrived. The extra count held by
+// await_suspend keeps the parent from resuming while children are still being started.
+struct WhenAllAwaiter {
+    std::size_t count;
+    std::function<void(WhenAllCounter&)> launch;
+    WhenAllCounter counter{};
+
+    bool await_ready() const noexcept {
+        return count == 0;
+    }
+
+    bool await_suspend(std::coroutine_handle<> parent) {
+        counter.parent = parent;
+        counter.remaining.store(count + 1);
+        launch(counter);
+        return counter.remaining.fetch_sub(1) != 1;
+    }
+
+    void await_resume() const noexcept {
+    }
+};
+
+template <typename T>
+DetachedTask RunWhenAllChild(JobSystem& jobs, Task<T> task, std::optional<T>& outResult, WhenAllCounter& counter) {
+    co_await ResumeOnWorker{jobs};
+    outResult.emplace(co_await std::move(task));
+    counter.Arrive();
+}
+
+inline DetachedTask RunWhenAllChild(JobSystem& jobs, Task<void> task, WhenAllCounter& counter) {
+    co_await ResumeOnWorker{jobs};
+    co_await std::move(task);
+    counter.Arrive();
+}
+}
+
+// Runs every task concurrently on the workers and produces their results in order. The awaiting
+// coroutine continues on the worker that finishes last.
+template <typename T>
+Task<std::vector<T>> WhenAll(JobSystem& jobs, std::vector<Task<T>> tasks) {
+    std::vector<std::optional<T>> slots(tasks.size());
+    detail::WhenAllAwaiter allFinished{tasks.size(), [&](detail::WhenAllCounter& counter) {
+        for (std::size_t index = 0; index < tasks.size(); ++index) {
+            detail::RunWhenAllChild(jobs, std::move(tasks[index]), slots[index], counter);
+        }
+    }};
+    co_await allFinished;
+
+    std::vector<T> results;
+    results.reserve(slots.size());
+    for (std::optional<T>& slot : slots) {
+        results.push_back(std::move(*slot));
+    }
+    co_return results;
+}
+
+inline Task<void> WhenAll(JobSystem& jobs, std::vector<Task<void>> tasks) {
+    detail::WhenAllAwaiter allFinished{tasks.size(), [&](detail::WhenAllCounter& counter) {
+        for (Task<void>& task : tasks) {
+            detail::RunWhenAllChild(jobs, std::move(task), counter);
+        }
+    }};
+    co_await allFinished;
+}
+
+// Reads a whole file on a worker. The awaiting coroutine continues on that worker.
+Task<FileReadResult> ReadFileAsync(JobSystem& jobs, std::filesystem::path path);
+
+// Reads every file as one ReadFileBatch from a worker. The awaiting coroutine continues there.
+Task<std::vector<FileReadResult>> ReadFilesAsync(JobSystem& jobs, std::vector<std::filesystem::path> paths);
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+#include "Engine/ModelData.hpp"
+
+namespace engine {
+struct TextureAtlasOptions {
+    std::filesystem::path outputDirectory;
+    std::uint32_t maxAtlasSize;
+    std::uint32_t gutterTexels;
+};
+
+struct TextureAtlasStats {
+    std::size_t atlasCount;
+    std::size_t packedTextureCount;
+    std::size_t packedMaterialCount;
+    std::size_t wrappingMaterialCount;
+    std::size_t unpackableMaterialCount;
+};
+
+// Cook step that packs the color (and matching opacity) textures of materials whose UVs stay inside
+// [0, 1] into a few atlases, written as BMP files to options.outputDirectory, and remaps texCoords.
+// Each atlas rectangle is surrounded by a gutter of clamped edge texels so filtering does not bleed.
+// Materials with wrapping UVs or oversized/undecodable textures keep their original textures.
+// Vertices shared between packed and unpacked materials are duplicated. The model is only modified
+// when every atlas was written successfully.
+bool BuildTextureAtlases(
+    ModelData& model,
+    const TextureAtlasOptions& options,
+    TextureAtlasStats& outStats,
+    std::string& outError);
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Engine/ModelData.hpp"
+
+namespace engine {
+struct TextureSearchOptions {
+    // Searched by file name after the model's own directory, each with `folderNames` below it.
+    std::vector<std::filesystem::path> extraRoots;
+    // Texture folders looked for, in any letter case, beside the model and one level up.
+    std::vector<std::string> folderNames;
+};
+
+// `textures`, `maps` and `images` folders, plus any roots listed in ENGINE_TEXTURE_SEARCH_PATHS
+// (separated like PATH). Read once.
+[[nodiscard]] const TextureSearchOptions& GetDefaultTextureSearchOptions();
+
+[[nodiscard]] std::vector<std::filesystem::path> SplitSearchPathList(std::string_view pathList);
+
+// Bumped whenever the resolution rules change, so paths resolved by an older build are redone.
+inline constexpr std::uint32_t kTexturePathResolverVersion = 1;
+
+// Hash of the resolver version and `options`; equal hashes resolve the same references alike.
+[[nodiscard]] std::uint64_t HashTextureSearchOptions(const TextureSearchOptions& options);
+
+// Modification time of `directory` as stored in TextureSearchDirectory; zero when it is missing.
+[[nodiscard]] std::int64_t ReadDirectoryWriteTicks(const std::filesystem::path& directory);
+
+struct TexturePathResolverStatistics {
+    std::size_t directoriesListed;
+    std::size_t lookups;
+    std::size_t resolvedAsWritten;
+    std::size_t resolvedByFileName;
+    std::size_t unresolved;
+};
+
+// Resolves texture references written by exporters: relative or absolute, Windows separators and
+// drive letters, wrong letter case. Each directory is listed once into a case-insensitive index
+// and every lookup after that is answered from memory, so a scene with thousands of texture slots
+// costs one listing per directory rather than one stat() per slot.
+class TexturePathResolver {
+public:
+    explicit TexturePathResolver(
+        std::filesystem::path modelDirectory,
+        const TextureSearchOptions& options = GetDefaultTextureSearchOptions());
+
+    // The existing file `reference` names, tried as written (relative to the model directory)
+    // and then by file name under each search root. Empty when nothing matches.
+    [[nodiscard]] std::filesystem::path Resolve(std::string_view reference);
+
+    [[nodiscard]] const TexturePathResolverStatistics& GetStatistics() const noexcept;
+
+    // Every directory listed so far, sorted by path, with its modification time before listing.
+    [[nodiscard]] std::vector<TextureSearchDirectory> GetListedDirectories() const;
+
+private:
+    struct DirectoryEntry {
+        std::string name;
+        bool isDirectory;
+    };
+
+    // Entries keyed by lower-case name; an exact-case match wins when names differ only in case.
+    // A directory that cannot be listed gets an empty index.
+    struct DirectoryIndex {
+        std::unordered_multimap<std::string, DirectoryEntry> entries;
+        std::int64_t lastWriteTicks;
+    };
+
+    const DirectoryIndex& GetDirectoryIndex(const std::filesystem::path& directory);
+    const DirectoryEntry* FindEntry(const std::filesystem::path& directory, std::string_view name, bool wantDirectory);
+    // Follows `relative` from `base` one component at a time, matching each in any letter case.
+    [[nodiscard]] std::filesystem::path WalkPath(const std::filesystem::path& base, const std::filesystem::path& relative);
+    // Roots are found lazily so references that resolve as written never list anything extra.
+    void BuildSearchRoots();
+
+    std::filesystem::path modelDirectory_;
+    TextureSearchOptions options_;
+    bool searchRootsBuilt_;
+    std::vector<std::filesystem::path> searchRoots_;
+    std::unordered_map<std::string, DirectoryIndex> directories_;
+    TexturePathResolverStatistics statistics_;
+};
+}
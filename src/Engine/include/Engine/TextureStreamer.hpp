@@ -0,0 +1,198 @@
+#pragma once
+
+#include <cstddef>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Engine/DecodedImage.hpp"
+#include "Engine/JobSystem.hpp"
+
+namespace engine {
+struct TextureStreamingSettings {
+    // Pixel bytes of every resident level, placeholders included, plus the texture files kept for
+    // later level changes.
+    std::size_t budgetBytes;
+    // Largest edge of the placeholder level kept for each texture once it has been decoded.
+    std::uint32_t placeholderSize;
+    std::uint32_t maxDecodesInFlight;
+};
+
+// 512 MiB (or ENGINE_TEXTURE_BUDGET_MB), 16-texel placeholders and four decodes at a time. Read once.
+[[nodiscard]] const TextureStreamingSettings& GetDefaultTextureStreamingSettings();
+
+// Levels in a full mip chain down to 1x1.
+[[nodiscard]] std::uint32_t ComputeMipLevelCount(std::uint32_t width, std::uint32_t height) noexcept;
+
+// Half-size image from a 2x2 box filter; an odd last row or column is averaged into its neighbor.
+[[nodiscard]] DecodedImage DownsampleImage(const DecodedImage& image);
+
+struct TextureStreamerStatistics {
+    std::size_t budgetBytes;
+    std::size_t residentBytes;
+    std::size_t textureCount;
+    // Textures showing their placeholder level, or nothing yet.
+    std::size_t placeholderCount;
+    std::size_t pendingDecodeCount;
+    // Texture files kept in memory so level changes decode without reading them again; counted
+    // against the budget alongside residentBytes.
+    std::size_t fileBytes;
+    std::uint64_t decodeCount;
+    std::uint64_t evictionCount;
+    std::uint64_t failedDecodeCount;
+};
+
+// A level that replaced what `slot` showed before.
+struct TextureStreamUpdate {
+    std::size_t slot;
+    std::uint32_t level;
+    DecodedImage image;
+};
+
+// Decodes a texture file already read into memory; `path` names it in errors.
+using TextureDecodeFunction = std::function<bool(
+    const std::vector<std::byte>& bytes,
+    const std::string& path,
+    DecodedImage& outImage,
+    std::string& outError)>;
+
+// Streams texture mip levels by visibility. Each texture is first decoded to a tiny placeholder
+// level; after that, textures requested during a frame get the level matching their projected size,
+// largest on screen first, within a byte budget. Decodes run on the job system and land only in
+// Update, so a renderer swaps levels between frames. Textures out of view keep their levels until
+// the budget is needed, then drop back to their placeholder, least recently seen first.
+// Files still to be read in one Update go to ReadFileBatch together, and each is kept in memory
+// after it decodes while the budget has room, so a later level change decodes again without
+// another read. Kept files are the first thing dropped when the budget runs short.
+class TextureStreamer {
+public:
+    static constexpr std::uint32_t kNoLevel = std::numeric_limits<std::uint32_t>::max();
+
+    // `decode` defaults to DecodeImageMemory.
+    explicit TextureStreamer(
+        const TextureStreamingSettings& settings = GetDefaultTextureStreamingSettings(),
+        TextureDecodeFunction decode = {});
+    ~TextureStreamer();
+
+    TextureStreamer(const TextureStreamer&) = delete;
+    TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+    // Replaces the tracked textures. A slot whose path was tracked before keeps its levels, and
+    // `outPreviousSlots` holds the slot it came from (npos for new or disabled slots). Disabled
+    // slots are never decoded.
+    void SetTextures(
+        const std::vector<std::string>& paths,
+        const std::vector<bool>& enabled,
+        std::vector<std::size_t>& outPreviousSlots);
+
+    // Decodes these files again; their current levels stay in use until the new ones land.
+    void InvalidateTextures(const std::vector<std::string>& paths);
+
+    void SetBudget(std::size_t budgetBytes);
+
+    // Marks `slot` visible this frame, sampled at `texelsPerUnit` screen pixels per texture
+    // coordinate unit. The largest request of the frame wins.
+    void RequestTexels(std::size_t slot, float texelsPerUnit);
+
+    // Hands over finished decodes and evictions, then schedules the next decodes and starts a new
+    // frame. Call once per frame from the thread that draws.
+    void Update(std::vector<TextureStreamUpdate>& outUpdates);
+
+    [[nodiscard]] std::uint32_t GetResidentLevel(std::size_t slot) const noexcept;
+    [[nodiscard]] bool HasFailed(std::size_t slot) const noexcept;
+    [[nodiscard]] TextureStreamerStatistics GetStatistics() const;
+
+    // Blocks until every scheduled decode has finished; their results arrive in the next Update.
+    void WaitForDecodes();
+
+private:
+    struct Slot {
+        std::string path;
+        bool enabled;
+        // Set by InvalidateTextures until the file has been decoded again.
+        bool stale;
+        bool failed;
+        std::uint32_t fullWidth;
+        std::uint32_t fullHeight;
+        std::uint32_t placeholderLevel;
+        std::uint32_t residentLevel;
+        DecodedImage placeholder;
+        // The file as read, dropped when the texture is invalidated or evicted to its placeholder.
+        std::shared_ptr<const std::vector<std::byte>> file;
+        // Nonzero while a decode is in flight; results with another ticket are dropped.
+        std::uint64_t decodeTicket;
+        std::size_t reservedBytes;
+        float requestedTexels;
+        std::uint64_t lastRequestedFrame;
+    };
+
+    struct DecodeResult {
+        std::uint64_t ticket;
+        bool succeeded;
+        std::string error;
+        std::uint32_t fullWidth;
+        std::uint32_t fullHeight;
+        std::uint32_t placeholderLevel;
+        std::uint32_t level;
+        DecodedImage image;
+        DecodedImage placeholder;
+        std::shared_ptr<const std::vector<std::byte>> file;
+    };
+
+    struct Candidate {
+        std::size_t slot;
+        int tier;
+        float texels;
+    };
+
+    struct DecodeRequest {
+        std::uint64_t ticket;
+        std::string path;
+        // Null when the file has to be read first.
+        std::shared_ptr<const std::vector<std::byte>> file;
+        float texelsPerUnit;
+        std::size_t maxLevelBytes;
+    };
+
+    [[nodiscard]] static std::size_t GetLevelBytes(const Slot& slot, std::uint32_t level) noexcept;
+    [[nodiscard]] std::uint32_t GetTargetLevel(const Slot& slot) const noexcept;
+    [[nodiscard]] bool IsVisible(const Slot& slot) const noexcept;
+    [[nodiscard]] std::size_t GetCommittedBytes() const noexcept;
+    void ReleaseSlot(Slot& slot) noexcept;
+    void DropFile(Slot& slot) noexcept;
+    void RecountBytes() noexcept;
+    // Drops kept files, then slots to their placeholder, until `incomingBytes` fit, never touching
+    // `keepSlot`.
+    void EvictToFit(std::size_t incomingBytes, std::size_t keepSlot, std::vector<TextureStreamUpdate>& outUpdates);
+    void ScheduleDecode(std::size_t slotIndex, float texelsPerUnit, std::size_t maxLevelBytes, std::size_t reservedBytes);
+    // Starts the decodes scheduled this Update, with one file batch for those not yet read.
+    void StartDecodes();
+    // Runs on a worker: decodes the file and keeps the level for `texelsPerUnit` plus the placeholder.
+    void DecodeLevels(DecodeRequest request, std::string readError);
+
+    TextureStreamingSettings settings_;
+    TextureDecodeFunction decode_;
+    std::vector<Slot> slots_;
+    std::uint64_t frameIndex_;
+    std::uint64_t nextTicket_;
+    std::size_t residentBytes_;
+    std::size_t fileBytes_;
+    // Bytes set aside for decodes in flight, counted against the budget before they land.
+    std::size_t reservedBytes_;
+    TextureStreamerStatistics stats_;
+    // Working lists of Update and EvictToFit, kept so a frame does not allocate them.
+    std::vector<Candidate> candidates_;
+    std::vector<std::size_t> evictable_;
+    std::vector<DecodeRequest> scheduledDecodes_;
+    // Decodes scheduled and not yet finished, counted apart from their jobs since a file batch
+    // starts the decodes of its files only as their reads complete.
+    std::atomic<std::uint32_t> decodesInFlight_;
+    std::mutex completedMutex_;
+    std::vector<DecodeResult> completed_;
+};
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace engine {
+// Rectangle a triangle must overlap to be kept, in the space of the projected vertices.
+struct TriangleCullRect {
+    float left;
+    float top;
+    float right;
+    float bottom;
+};
+
+struct TriangleRejectCounts {
+    std::uint64_t culled;
+    std::uint64_t clipped;
+};
+
+// Per-vertex classification against a TriangleCullRect, computed alongside projection. A triangle
+// is outside when its three outcodes share a side bit, and clipped when any has kOutcodeInvalid.
+enum VertexOutcode : std::uint8_t {
+    kOutcodeLeft = 1,
+    kOutcodeTop = 2,
+    kOutcodeRight = 4,
+    kOutcodeBottom = 8,
+    kOutcodeInvalid = 16,
+};
+
+[[nodiscard]] constexpr std::uint8_t ComputeVertexOutcode(float x, float y, bool valid, const TriangleCullRect& rect) noexcept {
+    return static_cast<std::uint8_t>(
+        (x < rect.left ? kOutcodeLeft : 0) |
+        (y < rect.top ? kOutcodeTop : 0) |
+        (x > rect.right ? kOutcodeRight : 0) |
+        (y > rect.bottom ? kOutcodeBottom : 0) |
+        (valid ? 0 : kOutcodeInvalid));
+}
+
+// Triangle assembly for one submesh, specialized when the submesh is set up rather than decided
+// per triangle. `kIndicesValidated` drops the index range check for models that went through
+// ValidateTriangleIndices; `kCull` rejects triangles entirely outside the rectangle the outcodes
+// were computed against (the wire overlay does not cull). Rejection is a few bit operations with
+// no branches. `emit(triangle, i0, i1, i2, keep)` is called for every triangle, with
+// out-of-range indices passed on as 0.
+template <bool kIndicesValidated, bool kCull, typename Emit>
+void AssembleTriangles(
+    std::span<const std::uint32_t> indices,
+    std::span<const std::uint8_t> outcodes,
+    TriangleRejectCounts& counts,
+    Emit&& emit) {
+    if (outcodes.empty()) {
+        return;
+    }
+
+    constexpr unsigned kSideBits = kOutcodeLeft | kOutcodeTop | kOutcodeRight | kOutcodeBottom;
+    const std::size_t triangleCount = indices.size() / 3;
+    const std::size_t vertexCount = outcodes.size();
+    std::uint64_t culled = 0;
+    std::uint64_t clipped = 0;
+    for (std::size_t triangle = 0; triangle < triangleCount; ++triangle) {
+        std::uint32_t i0 = indices[triangle * 3];
+        std::uint32_t i1 = indices[triangle * 3 + 1];
+        std::uint32_t i2 = indices[triangle * 3 + 2];
+        unsigned inRange = 1;
+        if constexpr (!kIndicesValidated) {
+            inRange = static_cast<unsigned>(i0 < vertexCount) & static_cast<unsigned>(i1 < vertexCount) &
+                static_cast<unsigned>(i2 < vertexCount);
+            i0 = inRange ? i0 : 0;
+            i1 = inRange ? i1 : 0;
+            i2 = inRange ? i2 : 0;
+        }
+
+        const unsigned anyCodes = static_cast<unsigned>(outcodes[i0] | outcodes[i1] | outcodes[i2]);
+        const unsigned invalid = (anyCodes & kOutcodeInvalid) != 0 ? 1u : 0u;
+        unsigned keep = inRange & (invalid ^ 1u);
+        if constexpr (kCull) {
+            const unsigned sharedCodes = static_cast<unsigned>(outcodes[i0] & outcodes[i1] & outcodes[i2]);
+            const unsigned outside = (sharedCodes & kSideBits) != 0 ? 1u : 0u;
+            culled += keep & outside;
+            keep &= outside ^ 1u;
+        }
+        clipped += inRange & invalid;
+        emit(triangle, i0, i1, i2, keep != 0);
+    }
+    counts.culled += culled;
+    counts.clipped += clipped;
+}
+}
@@ -1,12 +1,17 @@
 #include "Engine/Application.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cctype>
 #include <cmath>
+#include <cfloat>
 #include <cstdint>
+#include <filesystem>
 #include <memory>
 #include <string>
 #include <string_view>
+#include <system_error>
+#include <utility>
 
 #include <SDL3/SDL.h>
 #include <imgui.h>
@@ -15,29 +20,27 @@
 #include <backends/imgui_impl_dx12.h>
 #endif
 #include <backends/imgui_impl_sdlrenderer3.h>
+#include <glm/vec4.hpp>
 #include <nfd.h>
 
+#include "Engine/CookedModel.hpp"
 #include "Engine/DirectX12Renderer.hpp"
 #include "Engine/FbxLoader.hpp"
+#include "Engine/FlightRecorder.hpp"
+#include "Engine/Log.hpp"
+#include "Engine/Metrics.hpp"
+#include "Engine/ModelCook.hpp"
 #include "Engine/NativeDx12Renderer.hpp"
+#include "Engine/ProcessMemory.hpp"
 #include "Engine/Renderer.hpp"
 #include "Engine/RendererBackendSelection.hpp"
 #include "Engine/SoftwareRenderer.hpp"
+#include "Engine/TextureAtlas.hpp"
 #include "Engine/VulkanRenderer.hpp"
 
 namespace engine {
 namespace {
-void LogInfo(std::string_view message) {
-    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "%s", message.data());
-}
-
-void LogWarning(std::string_view message) {
-    SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "%s", message.data());
-}
-
-void LogError(std::string_view message) {
-    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s", message.data());
-}
+constexpr float kDragDegreesPerPixel = 0.4f;
 }
 
 Application::Application()
@@ -49,16 +52,62 @@ Application::Application()
       pitchDegrees_(0.0f),
       rollDegrees_(0.0f),
       cameraDistance_(4.0f),
+      orbitPivot_(0.0f),
             currentAnimationIndex_(0),
             animationTimeSeconds_(0.0f),
             animationSpeed_(1.0f),
             animationPlaying_(true),
+            morphTargetBlender_(),
+            morphWeights_(),
+            lastMorphBlendMicroseconds_(0.0f),
             lastFrameCounterTimestamp_(0),
+            cameraDragActive_(false),
+            dragMouseX_(0.0f),
+            dragMouseY_(0.0f),
+            lateLatchCameraEnabled_(true),
+            measureInputLatency_(false),
+            inputLatency_(),
+            modelBvh_(),
+            modelBvhGeneration_(0),
+            modelBvhJob_(),
+            pendingModelBvh_(),
+            hoveredHit_(),
+            lastPickMicroseconds_(0.0f),
+            modelFileWatcher_(),
+            modelLoadStopSource_(),
+            modelLoadInFlight_(false),
+            loadedModelTexturesAtlased_(false),
+            modelReloadQueued_(false),
+            meshStream_(),
+            meshChunkRequests_(),
+            drawnMeshChunks_(),
+            meshStreamBudgetMegabytes_(256),
+            rendererStatisticsHistory_(),
+            statisticsPlotValues_(),
+            plottedStatisticIndex_(4),
+            showRendererStatistics_(false),
+            jobStatisticsTotals_(),
+            jobStatisticsFrame_(),
+            jobStatisticsFrameSeconds_(0.0f),
+            resolutionGovernor_(),
+            dynamicResolutionEnabled_(false),
+            lastModelPassSeconds_(0.0),
+            overdrawVisualizationEnabled_(false),
+            pointCloudPreview_(),
+            pointCloudPreviewEnabled_(true),
+            metrics_(),
+            metricHandles_{},
+            metricsRendererName_(nullptr),
+            metricsExporter_(),
       sdlInitialized_(false),
       nfdInitialized_(false),
         imguiInitialized_(false),
         useNativeDx12ImGui_(false),
-                wireOverlayEnabled_(false) {}
+                wireOverlayEnabled_(false),
+                mergeSubmeshesOnLoad_(false),
+                packTextureAtlasesOnLoad_(false),
+                useCookedModelCache_(true),
+                hotReloadEnabled_(true) {}
 
 Application::~Application() {
     Shutdown();
@@ -67,29 +116,32 @@ Application::~Application() {
 bool Application::Initialize() {
     if (!SDL_Init(SDL_INIT_VIDEO)) {
         statusMessage_ = SDL_GetError();
-        LogError("SDL initialization failed: " + statusMessage_);
+        LogError(LogCategory::Application, "SDL initialization failed: %s", statusMessage_);
         return false;
     }
     sdlInitialized_ = true;
-    LogInfo("SDL video subsystem initialized.");
+    LogInfo(LogCategory::Application, "SDL video subsystem initialized.");
+
+    // Created here so the job system binds this thread as its main thread.
+    LogInfo(LogCategory::Application, "Job system started with %u worker thread(s).", JobSystem::Get().GetWorkerCount());
 
     SDL_Window* window = SDL_CreateWindow("EngineTest - FBX Viewer", 1280, 720, SDL_WINDOW_RESIZABLE);
     if (!window) {
         statusMessage_ = SDL_GetError();
-        LogError("Window creation failed: " + statusMessage_);
+        LogError(LogCategory::Application, "Window creation failed: %s", statusMessage_);
         return false;
     }
     window_ = window;
-    LogInfo("Main window created.");
+    LogInfo(LogCategory::Application, "Main window created.");
 
     if (NFD_Init() != NFD_OKAY) {
         const char* errorText = NFD_GetError();
         statusMessage_ = std::string("NativeFileDialog initialization failed") + (errorText ? std::string(": ") + errorText : ".");
-        LogError(statusMessage_);
+        LogError(LogCategory::Application, "%s", statusMessage_);
         return false;
     }
     nfdInitialized_ = true;
-    LogInfo("NativeFileDialog initialized.");
+    LogInfo(LogCategory::Application, "NativeFileDialog initialized.");
 
     if (!CreateRenderer()) {
         return false;
@@ -99,8 +151,11 @@ bool Application::Initialize() {
         return false;
     }
 
+    RegisterMetrics();
+    StartMetricsExport();
+
     statusMessage_ = "Ready. Load an FBX file from the UI.";
-    LogInfo("Application initialized successfully.");
+    LogInfo(LogCategory::Application, "Application initialized successfully.");
     return true;
 }
 
@@ -127,7 +182,7 @@ bool Application::CreateRenderer() {
 
     if (!requestedBackendName.empty() && !requestedBackend.has_value()) {
         statusMessage_ = "Requested renderer backend is invalid. ENGINE_RENDERER=" + requestedBackendName + ". Use dx12, vulkan, or software.";
-        LogError(statusMessage_);
+        LogError(LogCategory::Application, "%s", statusMessage_);
         return false;
     }
 
@@ -139,7 +194,7 @@ bool Application::CreateRenderer() {
                 if (nativeDx12Renderer->Initialize(window, outError)) {
                     renderer_ = std::move(nativeDx12Renderer);
                     useNativeDx12ImGui_ = true;
-                    LogInfo("Initialized renderer: DirectX 12 Native.");
+                    LogInfo(LogCategory::Application, "Initialized renderer: DirectX 12 Native.");
                     return true;
                 }
                 useNativeDx12ImGui_ = false;
@@ -151,7 +206,7 @@ bool Application::CreateRenderer() {
             if (directXRenderer->Initialize(window, outError)) {
                 renderer_ = std::move(directXRenderer);
                 useNativeDx12ImGui_ = false;
-                LogInfo("Initialized renderer: DirectX 12.");
+                LogInfo(LogCategory::Application, "Initialized renderer: DirectX 12.");
                 return true;
             }
             return false;
@@ -162,7 +217,7 @@ bool Application::CreateRenderer() {
             if (vulkanRenderer->Initialize(window, outError)) {
                 renderer_ = std::move(vulkanRenderer);
                 useNativeDx12ImGui_ = false;
-                LogInfo("Initialized renderer: Vulkan.");
+                LogInfo(LogCategory::Application, "Initialized renderer: Vulkan.");
                 return true;
             }
             return false;
@@ -173,7 +228,7 @@ bool Application::CreateRenderer() {
             if (softwareRenderer->Initialize(window, outError)) {
                 renderer_ = std::move(softwareRenderer);
                 useNativeDx12ImGui_ = false;
-                LogInfo("Initialized renderer: Software.");
+                LogInfo(LogCategory::Application, "Initialized renderer: Software.");
                 return true;
             }
             return false;
@@ -193,19 +248,19 @@ bool Application::CreateRenderer() {
         if (tryBackend(backend, requestedError)) {
             if (requestedBackend.has_value()) {
                 statusMessage_ = "Using renderer backend from ENGINE_RENDERER=" + std::string(RendererBackendName(backend)) + ".";
-                LogInfo("Renderer forced by ENGINE_RENDERER=" + std::string(RendererBackendName(backend)) + ".");
+                LogInfo(LogCategory::Application, "Renderer forced by ENGINE_RENDERER=%s.", RendererBackendName(backend));
             } else if (backend == RendererBackend::Vulkan) {
                 statusMessage_ = "DirectX 12 failed, using Vulkan fallback.";
                 if (!dx12Error.empty()) {
-                    LogWarning("DirectX 12 renderer failed: " + dx12Error);
+                    LogWarning(LogCategory::Application, "DirectX 12 renderer failed: %s", dx12Error);
                 }
             } else if (backend == RendererBackend::Software) {
                 statusMessage_ = "Hardware backends unavailable, using software fallback renderer.";
                 if (!dx12Error.empty()) {
-                    LogWarning("DirectX 12 renderer failed: " + dx12Error);
+                    LogWarning(LogCategory::Application, "DirectX 12 renderer failed: %s", dx12Error);
                 }
                 if (!vulkanError.empty()) {
-                    LogWarning("Vulkan renderer failed: " + vulkanError);
+                    LogWarning(LogCategory::Application, "Vulkan renderer failed: %s", vulkanError);
                 }
             }
             return true;
@@ -229,12 +284,12 @@ bool Application::CreateRenderer() {
         } else {
             statusMessage_ += softwareError;
         }
-        LogError(statusMessage_);
+        LogError(LogCategory::Application, "%s", statusMessage_);
         return false;
     }
 
     statusMessage_ = "Failed to create renderer. DX12: " + dx12Error + " | Vulkan: " + vulkanError + " | Software: " + softwareError;
-    LogError(statusMessage_);
+    LogError(LogCategory::Application, "%s", statusMessage_);
     return false;
 }
 
@@ -248,7 +303,7 @@ bool Application::InitializeImGui() {
     SDL_Window* window = static_cast<SDL_Window*>(window_);
     if (!renderer_) {
         statusMessage_ = "ImGui initialization failed: renderer is null.";
-        LogError(statusMessage_);
+        LogError(LogCategory::Application, "%s", statusMessage_);
         return false;
     }
 
@@ -262,18 +317,18 @@ bool Application::InitializeImGui() {
         auto* nativeDx12Renderer = dynamic_cast<NativeDx12Renderer*>(renderer_.get());
         if (!nativeDx12Renderer) {
             statusMessage_ = "ImGui initialization failed: native DX12 renderer cast failed.";
-            LogError(statusMessage_);
+            LogError(LogCategory::Application, "%s", statusMessage_);
             return false;
         }
 
         if (!ImGui_ImplSDL3_InitForD3D(window)) {
             statusMessage_ = std::string("ImGui SDL3 D3D platform backend initialization failed: ") + SDL_GetError();
-            LogError(statusMessage_);
+            LogError(LogCategory::Application, "%s", statusMessage_);
             return false;
         }
 
-        SDL_LogInfo(
-            SDL_LOG_CATEGORY_APPLICATION,
+        LogInfo(
+            LogCategory::Application,
             "Native DX12 ImGui init. Device=0x%p Queue=0x%p Heap=0x%p",
             static_cast<void*>(nativeDx12Renderer->GetDevice()),
             static_cast<void*>(nativeDx12Renderer->GetCommandQueue()),
@@ -296,7 +351,7 @@ bool Application::InitializeImGui() {
             if (!nativeRenderer->AllocateSrvDescriptor(*outCpu, *outGpu)) {
                 outCpu->ptr = 0;
                 outGpu->ptr = 0;
-                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Native DX12 ImGui SRV allocation failed.");
+                LogError(LogCategory::Renderer, "Native DX12 ImGui SRV allocation failed.");
             }
         };
         initInfo.SrvDescriptorFreeFn = [](ImGui_ImplDX12_InitInfo* info, D3D12_CPU_DESCRIPTOR_HANDLE cpuHandle, D3D12_GPU_DESCRIPTOR_HANDLE gpuHandle) {
@@ -308,7 +363,7 @@ bool Application::InitializeImGui() {
 
         if (!ImGui_ImplDX12_Init(&initInfo)) {
             statusMessage_ = "ImGui DX12 renderer backend initialization failed.";
-            LogError(statusMessage_);
+            LogError(LogCategory::Application, "%s", statusMessage_);
             ImGui_ImplSDL3_Shutdown();
             return false;
         }
@@ -316,11 +371,11 @@ bool Application::InitializeImGui() {
         io.BackendFlags &= ~ImGuiBackendFlags_RendererHasTextures;
 
         imguiInitialized_ = true;
-        LogInfo("ImGui initialized successfully (DX12 backend).");
+        LogInfo(LogCategory::Application, "ImGui initialized successfully (DX12 backend).");
         return true;
 #else
         statusMessage_ = "Native DX12 ImGui path is only available on Windows.";
-        LogError(statusMessage_);
+        LogError(LogCategory::Application, "%s", statusMessage_);
         return false;
 #endif
     }
@@ -328,25 +383,25 @@ bool Application::InitializeImGui() {
     SDL_Renderer* nativeRenderer = renderer_->GetNativeRenderer();
     if (!nativeRenderer) {
         statusMessage_ = "ImGui initialization failed: native SDL renderer is null.";
-        LogError(statusMessage_);
+        LogError(LogCategory::Application, "%s", statusMessage_);
         return false;
     }
 
     if (!ImGui_ImplSDL3_InitForSDLRenderer(window, nativeRenderer)) {
         statusMessage_ = std::string("ImGui SDL3 platform backend initialization failed: ") + SDL_GetError();
-        LogError(statusMessage_);
+        LogError(LogCategory::Application, "%s", statusMessage_);
         return false;
     }
 
     if (!ImGui_ImplSDLRenderer3_Init(nativeRenderer)) {
         statusMessage_ = std::string("ImGui SDL renderer backend initialization failed: ") + SDL_GetError();
-        LogError(statusMessage_);
+        LogError(LogCategory::Application, "%s", statusMessage_);
         ImGui_ImplSDL3_Shutdown();
         return false;
     }
 
     imguiInitialized_ = true;
-    LogInfo("ImGui initialized successfully.");
+    LogInfo(LogCategory::Application, "ImGui initialized successfully.");
     return true;
 }
 
@@ -378,7 +433,7 @@ int Application::Run() {
             "EngineTest startup failed",
             startupError.c_str(),
             static_cast<SDL_Window*>(window_));
-        LogError("Application startup failed: " + startupError);
+        LogError(LogCategory::Application, "Application startup failed: %s", startupError);
         Shutdown();
         return 1;
     }
@@ -392,11 +447,19 @@ int Application::Run() {
     const char* requestedBackendRaw = SDL_getenv("ENGINE_RENDERER");
     const bool backendForcedByEnvironment = requestedBackendRaw != nullptr && requestedBackendRaw[0] != '\0';
 
+    FlightRecorder& flightRecorder = FlightRecorder::Get();
     while (running_) {
+        flightRecorder.BeginFrame(frameCounter_);
         SDL_Event event;
+        std::uint64_t newestMouseMotionNanoseconds = 0;
+        std::uint32_t phase = flightRecorder.BeginPhase("PollEvents");
         while (SDL_PollEvent(&event)) {
             ImGui_ImplSDL3_ProcessEvent(&event);
 
+            if (event.type == SDL_EVENT_MOUSE_MOTION) {
+                newestMouseMotionNanoseconds = event.common.timestamp;
+            }
+
             if (event.type == SDL_EVENT_QUIT || event.type == SDL_EVENT_WINDOW_CLOSE_REQUESTED) {
                 RequestExit();
             }
@@ -417,12 +480,14 @@ int Application::Run() {
                 StepAnimationSelection(1);
             }
         }
+        flightRecorder.EndPhase(phase);
 
         const std::uint64_t now = SDL_GetTicks();
         const float deltaSeconds = static_cast<float>(now - lastFrameCounterTimestamp_) / 1000.0f;
         lastFrameCounterTimestamp_ = now;
         UpdateAnimationPlayback(deltaSeconds);
 
+        phase = flightRecorder.BeginPhase("ImGuiNewFrame");
         if (useNativeDx12ImGui_) {
     #if defined(_WIN32)
             ImGui_ImplDX12_NewFrame();
@@ -432,29 +497,83 @@ int Application::Run() {
         }
         ImGui_ImplSDL3_NewFrame();
         ImGui::NewFrame();
+        flightRecorder.EndPhase(phase);
 
         ImGuiIO& io = ImGui::GetIO();
-        if (!io.WantCaptureMouse && ImGui::IsMouseDown(ImGuiMouseButton_Left)) {
-            yawDegrees_ += io.MouseDelta.x * 0.4f;
-            pitchDegrees_ += io.MouseDelta.y * 0.4f;
+        // Drags are tracked against the last position applied rather than ImGui's per-frame delta,
+        // because the late latch may already have applied part of this frame's motion.
+        const bool dragging = !io.WantCaptureMouse && ImGui::IsMouseDown(ImGuiMouseButton_Left) && ImGui::IsMousePosValid();
+        if (dragging && cameraDragActive_) {
+            ApplyCameraDrag(io.MousePos.x, io.MousePos.y);
+            if (measureInputLatency_ && newestMouseMotionNanoseconds != 0) {
+                inputLatency_.RecordInput(newestMouseMotionNanoseconds);
+            }
+        } else if (dragging) {
+            dragMouseX_ = io.MousePos.x;
+            dragMouseY_ = io.MousePos.y;
         }
+        cameraDragActive_ = dragging;
         if (!io.WantCaptureMouse && io.MouseWheel != 0.0f) {
             cameraDistance_ = std::clamp(cameraDistance_ - io.MouseWheel * 0.5f, 1.5f, 12.0f);
         }
 
+        phase = flightRecorder.BeginPhase("MainThreadJobs");
+        JobSystem::Get().RunMainThreadJobs();
+        flightRecorder.EndPhase(phase);
+        phase = flightRecorder.BeginPhase("HotReload");
+        PollModelHotReload();
+        flightRecorder.EndPhase(phase);
+        phase = flightRecorder.BeginPhase("Picking");
+        PollModelBvhBuild();
+        UpdateModelPicking();
+        flightRecorder.EndPhase(phase);
+        phase = flightRecorder.BeginPhase("Gui");
         UpdateGui();
-
+        flightRecorder.EndPhase(phase);
+        phase = flightRecorder.BeginPhase("MeshStreaming");
+        UpdateMeshStreaming();
+        flightRecorder.EndPhase(phase);
+        phase = flightRecorder.BeginPhase("MorphTargets");
+        UpdateMorphTargets();
+        flightRecorder.EndPhase(phase);
+
+        // The model pass just measured decides the scale of the next one.
+        const float renderScale = dynamicResolutionEnabled_ ? resolutionGovernor_.Update(lastModelPassSeconds_) : 1.0f;
+        renderer_->SetRenderScale(renderScale);
+        renderer_->SetOverdrawVisualization(overdrawVisualizationEnabled_);
+        renderer_->SetPointCloudPreview(pointCloudPreviewEnabled_ ? pointCloudPreview_ : nullptr);
+        phase = flightRecorder.BeginPhase("ModelPass");
+        const std::uint64_t modelPassStart = SDL_GetPerformanceCounter();
         renderer_->BeginFrame();
         if (loadedModel_.IsValid()) {
-            renderer_->RenderModelWireframe(loadedModel_, yawDegrees_, pitchDegrees_, rollDegrees_, cameraDistance_, wireOverlayEnabled_);
+            renderer_->RenderModelWireframe(loadedModel_, [this]() { return LatchCamera(); }, wireOverlayEnabled_);
         }
+        lastModelPassSeconds_ =
+            static_cast<double>(SDL_GetPerformanceCounter() - modelPassStart) / static_cast<double>(SDL_GetPerformanceFrequency());
+        flightRecorder.EndPhase(phase);
+        rendererStatisticsHistory_.Push(renderer_->GetFrameStatistics());
+        RecordFrameMetrics(rendererStatisticsHistory_.GetLatest(), deltaSeconds, renderScale);
+        const JobSystemStatistics jobTotals = JobSystem::Get().GetStatistics();
+        jobStatisticsFrame_ = JobSystemStatistics{
+            jobTotals.workerCount,
+            jobTotals.jobsExecuted - jobStatisticsTotals_.jobsExecuted,
+            jobTotals.mainThreadJobsExecuted - jobStatisticsTotals_.mainThreadJobsExecuted,
+            jobTotals.steals - jobStatisticsTotals_.steals,
+            jobTotals.failedStealAttempts - jobStatisticsTotals_.failedStealAttempts,
+            jobTotals.idleNanoseconds - jobStatisticsTotals_.idleNanoseconds};
+        jobStatisticsTotals_ = jobTotals;
+        jobStatisticsFrameSeconds_ = deltaSeconds;
+        phase = flightRecorder.BeginPhase("ImGuiRender");
         ImGui::Render();
         ImDrawData* drawData = ImGui::GetDrawData();
+        flightRecorder.EndPhase(phase);
         if (!loggedFirstImGuiFrame && drawData) {
             LogInfo(
-                "ImGui first frame draw data: cmd_lists=" + std::to_string(drawData->CmdListsCount) +
-                ", total_vertices=" + std::to_string(drawData->TotalVtxCount) +
-                ", total_indices=" + std::to_string(drawData->TotalIdxCount));
+                LogCategory::Application,
+                "ImGui first frame draw data: cmd_lists=%d, total_vertices=%d, total_indices=%d",
+                drawData->CmdListsCount,
+                drawData->TotalVtxCount,
+                drawData->TotalIdxCount);
             loggedFirstImGuiFrame = true;
         }
 
@@ -484,7 +603,9 @@ int Application::Run() {
 
                 if (probableBlankFrameCount >= 45) {
                     autoFallbackAttempted = true;
-                    LogWarning("Detected probable blank output on accelerated backend. Reinitializing renderer with software fallback.");
+                    ScopedFramePhase fallbackPhase(flightRecorder, "RendererFallback");
+                    flightRecorder.RecordEvent("Blank accelerated output; falling back to the software renderer.");
+                    LogWarning(LogCategory::Application, "Detected probable blank output on accelerated backend. Reinitializing renderer with software fallback.");
 
                     ShutdownImGui();
                     if (renderer_) {
@@ -496,29 +617,34 @@ int Application::Run() {
                     auto softwareRenderer = std::make_unique<SoftwareRenderer>();
                     if (!softwareRenderer->Initialize(static_cast<SDL_Window*>(window_), softwareError)) {
                         statusMessage_ = "Automatic software fallback failed: " + softwareError;
-                        LogError(statusMessage_);
+                        LogError(LogCategory::Application, "%s", statusMessage_);
                         RequestExit();
                     } else {
                         renderer_ = std::move(softwareRenderer);
+                        rendererStatisticsHistory_.Clear();
+                        resolutionGovernor_.Reset();
+                        inputLatency_.Clear();
                         useNativeDx12ImGui_ = false;
                         if (!InitializeImGui()) {
                             statusMessage_ = "Automatic software fallback failed during ImGui initialization.";
-                            LogError(statusMessage_);
+                            LogError(LogCategory::Application, "%s", statusMessage_);
                             RequestExit();
                         } else {
                             statusMessage_ = "Detected blank accelerated output. Switched to software renderer.";
-                            LogInfo(statusMessage_);
+                            LogInfo(LogCategory::Application, "%s", statusMessage_);
                         }
                     }
 
                     probableBlankFrameCount = 0;
 
                     ++frameCounter_;
+                    EndFlightRecorderFrame();
                     continue;
                 }
             }
         }
 
+        phase = flightRecorder.BeginPhase("ImGuiDraw");
         if (drawData) {
             SDL_ClearError();
             if (useNativeDx12ImGui_) {
@@ -535,15 +661,24 @@ int Application::Run() {
             }
             const char* renderError = SDL_GetError();
             if (!loggedImGuiRenderError && renderError && renderError[0] != '\0') {
-                LogWarning(std::string("ImGui render reported SDL error on backend '") +
-                    (renderer_ ? renderer_->GetName() : "None") +
-                    "': " + renderError);
+                LogWarning(
+                    LogCategory::Application,
+                    "ImGui render reported SDL error on backend '%s': %s",
+                    renderer_ ? renderer_->GetName() : "None",
+                    renderError);
                 loggedImGuiRenderError = true;
             }
         }
+        flightRecorder.EndPhase(phase);
+        phase = flightRecorder.BeginPhase("Present");
         renderer_->EndFrame();
+        flightRecorder.EndPhase(phase);
+        if (measureInputLatency_) {
+            inputLatency_.RecordPresent(SDL_GetTicksNS());
+        }
 
         ++frameCounter_;
+        EndFlightRecorderFrame();
     }
 
     Shutdown();
@@ -552,15 +687,36 @@ int Application::Run() {
 
 void Application::UpdateGui() {
     DrawShortcutOverlay();
+    DrawHoveredSubmeshHighlight();
+    DrawRendererStatisticsPanel();
 
     ImGui::SetNextWindowPos(ImVec2(20.0f, 20.0f), ImGuiCond_Always);
-    ImGui::SetNextWindowSize(ImVec2(460.0f, 420.0f), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImVec2(460.0f, 480.0f), ImGuiCond_Always);
     ImGui::Begin("Model Viewer");
     ImGui::Text("Renderer: %s", renderer_ ? renderer_->GetName() : "None");
 
     if (ImGui::Button("Load FBX")) {
         OpenLoadFbxDialog();
     }
+    ImGui::SameLine();
+    ImGui::Checkbox("Merge Submeshes By Material", &mergeSubmeshesOnLoad_);
+    ImGui::Checkbox("Pack Texture Atlases", &packTextureAtlasesOnLoad_);
+    ImGui::SameLine();
+    ImGui::Checkbox("Use Cooked Cache", &useCookedModelCache_);
+    ImGui::Checkbox("Hot Reload", &hotReloadEnabled_);
+    ImGui::SameLine();
+    ImGui::TextDisabled(
+        "(%zu files, %s)",
+        modelFileWatcher_.GetWatchedFileCount(),
+        modelFileWatcher_.IsUsingNotifications() ? "inotify" : "polling");
+    ImGui::Checkbox("Renderer Statistics", &showRendererStatistics_);
+    ImGui::SameLine();
+    ImGui::Checkbox("Point Preview While Orbiting", &pointCloudPreviewEnabled_);
+    if (pointCloudPreview_) {
+        ImGui::SameLine();
+        ImGui::TextDisabled("(%zu points)", pointCloudPreview_->points.size());
+    }
+    DrawMeshStreamingControls();
 
     ImGui::Separator();
     ImGui::SliderFloat("Yaw", &yawDegrees_, -180.0f, 180.0f);
@@ -577,20 +733,67 @@ void Application::UpdateGui() {
         pitchDegrees_ = 0.0f;
         rollDegrees_ = 0.0f;
     }
+    ImGui::SameLine();
+    if (ImGui::Button("Reset Pivot")) {
+        orbitPivot_ = glm::vec3(0.0f);
+    }
 
     if (loadedModel_.IsValid()) {
         ImGui::Text("Vertices: %d", static_cast<int>(loadedModel_.positions.size()));
         ImGui::Text("Triangles: %d", static_cast<int>(loadedModel_.indices.size() / 3));
         ImGui::Text("Texture: %s", loadedModel_.primaryTexturePath.empty() ? "None" : "Loaded");
         ImGui::Text("Texture Count: %d", static_cast<int>(loadedModel_.texturePaths.size()));
+        const std::vector<bool> texturesSampled = renderer_
+            ? FindTexturesForChannels(loadedModel_, renderer_->GetSampledMaterialChannels())
+            : std::vector<bool>(loadedModel_.texturePaths.size(), false);
+        ImGui::Text(
+            "Textures Decoded: %d (other channels are not sampled by this renderer)",
+            static_cast<int>(std::count(texturesSampled.begin(), texturesSampled.end(), true)));
+        ImGui::Text("Materials: %d", static_cast<int>(loadedModel_.materials.size()));
         ImGui::Text("Submeshes: %d", static_cast<int>(loadedModel_.submeshes.size()));
+        if (modelBvh_) {
+            ImGui::Text(
+                "Picking BVH: %d nodes, last query %.1f us",
+                static_cast<int>(modelBvh_->GetNodeCount()),
+                lastPickMicroseconds_);
+        } else if (modelBvhJob_) {
+            ImGui::TextUnformatted("Picking BVH: building...");
+        }
+        if (hoveredHit_) {
+            ImGui::Text("Hovered: submesh %u, triangle %u", hoveredHit_->submeshIndex, hoveredHit_->triangleIndex);
+        }
+        ImGui::Text("Orbit Pivot: (%.2f, %.2f, %.2f)", orbitPivot_.x, orbitPivot_.y, orbitPivot_.z);
         if (!loadedModel_.primaryTexturePath.empty()) {
             ImGui::TextWrapped("Texture Path: %s", loadedModel_.primaryTexturePath.c_str());
         }
 
         if (!loadedModel_.texturePaths.empty() && ImGui::TreeNode("Material Texture Paths")) {
             for (std::size_t textureIndex = 0; textureIndex < loadedModel_.texturePaths.size(); ++textureIndex) {
-                ImGui::Text("[%d] %s", static_cast<int>(textureIndex), loadedModel_.texturePaths[textureIndex].c_str());
+                ImGui::Text(
+                    "[%d] %s%s",
+                    static_cast<int>(textureIndex),
+                    loadedModel_.texturePaths[textureIndex].c_str(),
+                    texturesSampled[textureIndex] ? "" : " (deferred)");
+            }
+            ImGui::TreePop();
+        }
+
+        if (!loadedModel_.materials.empty() && ImGui::TreeNode("Materials")) {
+            for (std::size_t materialIndex = 0; materialIndex < loadedModel_.materials.size(); ++materialIndex) {
+                const ModelMaterial& material = loadedModel_.materials[materialIndex];
+                ImGui::Text(
+                    "[%d] tex=%d opacityTex=%d normalTex=%d emissiveTex=%d specularTex=%d opacity=%.2f cutoff=%.2f cutout=%s invert=%s transparent=%s",
+                    static_cast<int>(materialIndex),
+                    material.textureIndex,
+                    material.opacityTextureIndex,
+                    material.normalTextureIndex,
+                    material.emissiveTextureIndex,
+                    material.specularTextureIndex,
+                    material.opacity,
+                    material.alphaCutoff,
+                    material.alphaCutoutEnabled ? "yes" : "no",
+                    material.opacityTextureInverted ? "yes" : "no",
+                    material.isTransparent ? "yes" : "no");
             }
             ImGui::TreePop();
         }
@@ -599,25 +802,23 @@ void Application::UpdateGui() {
             for (std::size_t submeshIndex = 0; submeshIndex < loadedModel_.submeshes.size(); ++submeshIndex) {
                 const ModelSubmesh& submesh = loadedModel_.submeshes[submeshIndex];
                 ImGui::Text(
-                    "[%d] idx=%u count=%u tex=%d opacityTex=%d normalTex=%d emissiveTex=%d specularTex=%d opacity=%.2f cutoff=%.2f cutout=%s invert=%s transparent=%s",
+                    "[%d] idx=%u count=%u material=%u",
                     static_cast<int>(submeshIndex),
                     submesh.indexStart,
                     submesh.indexCount,
-                    submesh.textureIndex,
-                    submesh.opacityTextureIndex,
-                    submesh.normalTextureIndex,
-                    submesh.emissiveTextureIndex,
-                    submesh.specularTextureIndex,
-                    submesh.opacity,
-                    submesh.alphaCutoff,
-                    submesh.alphaCutoutEnabled ? "yes" : "no",
-                    submesh.opacityTextureInverted ? "yes" : "no",
-                    submesh.isTransparent ? "yes" : "no");
+                    submesh.materialIndex);
             }
             ImGui::TreePop();
         }
 
         ImGui::Text("Animations: %d", static_cast<int>(loadedModel_.animations.size()));
+        if (!loadedModel_.morphTargets.empty()) {
+            ImGui::Text(
+                "Morph Targets: %d (%d vertices moved, last blend %.1f us)",
+                static_cast<int>(loadedModel_.morphTargets.size()),
+                static_cast<int>(morphTargetBlender_.GetMovedVertexCount()),
+                lastMorphBlendMicroseconds_);
+        }
 
         if (!loadedModel_.animations.empty()) {
             if (currentAnimationIndex_ >= loadedModel_.animations.size()) {
@@ -650,14 +851,286 @@ void Application::UpdateGui() {
         ImGui::TextUnformatted("No model loaded.");
     }
 
+    if (ImGui::TreeNode("Logging")) {
+        Logger& logger = Logger::Get();
+        for (std::size_t categoryIndex = 0; categoryIndex < static_cast<std::size_t>(LogCategory::Count); ++categoryIndex) {
+            const LogCategory category = static_cast<LogCategory>(categoryIndex);
+            int level = static_cast<int>(logger.GetLevel(category));
+            if (ImGui::Combo(LogCategoryName(category), &level, "Debug\0Info\0Warning\0Error\0Off\0")) {
+                logger.SetLevel(category, static_cast<LogLevel>(level));
+            }
+        }
+        ImGui::Text("Dropped records: %llu", static_cast<unsigned long long>(logger.GetDroppedCount()));
+        ImGui::TreePop();
+    }
+
     ImGui::Separator();
     ImGui::TextWrapped("Status: %s", statusMessage_.c_str());
     ImGui::TextUnformatted("Drag with left mouse button in empty viewport area to rotate.");
+    ImGui::TextUnformatted("Click the model to orbit around the clicked point.");
     ImGui::TextUnformatted("Shortcut: press O to open the FBX file dialog.");
     ImGui::TextUnformatted("Animation shortcuts: [ previous, ] next.");
     ImGui::End();
 }
 
+void Application::DrawRendererStatisticsPanel() {
+    if (!showRendererStatistics_) {
+        return;
+    }
+
+    ImGuiViewport* viewport = ImGui::GetMainViewport();
+    ImGui::SetNextWindowPos(ImVec2(viewport->WorkPos.x + viewport->WorkSize.x - 440.0f, viewport->WorkPos.y + 20.0f), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowSize(ImVec2(420.0f, 420.0f), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("Renderer Statistics", &showRendererStatistics_)) {
+        ImGui::End();
+        return;
+    }
+
+    ImGui::Text("Renderer: %s", renderer_ ? renderer_->GetName() : "None");
+    ImGui::Text(
+        "Window: %d / %d frames",
+        static_cast<int>(rendererStatisticsHistory_.GetSize()),
+        static_cast<int>(rendererStatisticsHistory_.GetCapacity()));
+
+    const std::vector<RendererStatisticsField>& fields = GetRendererStatisticsFields();
+    const RendererFrameStatistics& latest = rendererStatisticsHistory_.GetLatest();
+    if (ImGui::BeginTable("RendererStatisticsTable", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn("Counter");
+        ImGui::TableSetupColumn("Last");
+        ImGui::TableSetupColumn("Average");
+        ImGui::TableSetupColumn("Max");
+        ImGui::TableHeadersRow();
+        for (const RendererStatisticsField& field : fields) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(field.name);
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", static_cast<unsigned long long>(latest.*field.counter));
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", rendererStatisticsHistory_.ComputeAverage(field.counter));
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", static_cast<unsigned long long>(rendererStatisticsHistory_.ComputeMaximum(field.counter)));
+        }
+        ImGui::EndTable();
+    }
+
+    if (ImGui::CollapsingHeader("Job System", ImGuiTreeNodeFlags_DefaultOpen)) {
+        const double workerSeconds = static_cast<double>(jobStatisticsFrameSeconds_) * jobStatisticsFrame_.workerCount;
+        const double idlePercent = workerSeconds > 0.0
+            ? std::min(100.0, static_cast<double>(jobStatisticsFrame_.idleNanoseconds) / (workerSeconds * 1e7))
+            : 0.0;
+        ImGui::Text("Workers: %u", jobStatisticsFrame_.workerCount);
+        ImGui::Text(
+            "Jobs last frame: %llu (%llu on main thread)",
+            static_cast<unsigned long long>(jobStatisticsFrame_.jobsExecuted + jobStatisticsFrame_.mainThreadJobsExecuted),
+            static_cast<unsigned long long>(jobStatisticsFrame_.mainThreadJobsExecuted));
+        ImGui::Text(
+            "Steals: %llu, failed steal attempts: %llu",
+            static_cast<unsigned long long>(jobStatisticsFrame_.steals),
+            static_cast<unsigned long long>(jobStatisticsFrame_.failedStealAttempts));
+        ImGui::Text("Worker idle: %.1f%%", idlePercent);
+    }
+
+    if (ImGui::CollapsingHeader("Dynamic Resolution", ImGuiTreeNodeFlags_DefaultOpen)) {
+        if (ImGui::Checkbox("Scale model pass to hold frame rate", &dynamicResolutionEnabled_) && !dynamicResolutionEnabled_) {
+            resolutionGovernor_.Reset();
+        }
+
+        ResolutionGovernorSettings settings = resolutionGovernor_.GetSettings();
+        int targetFramesPerSecond = static_cast<int>(std::lround(1.0 / settings.targetFrameSeconds));
+        float minScalePercent = settings.minScale * 100.0f;
+        bool settingsChanged = ImGui::SliderInt("Target FPS", &targetFramesPerSecond, 15, 144);
+        settingsChanged = ImGui::SliderFloat("Minimum scale", &minScalePercent, 25.0f, 100.0f, "%.0f%%") || settingsChanged;
+        if (settingsChanged) {
+            settings.targetFrameSeconds = 1.0 / static_cast<double>(std::max(targetFramesPerSecond, 1));
+            settings.minScale = minScalePercent / 100.0f;
+            resolutionGovernor_.SetSettings(settings);
+        }
+
+        ImGui::Text(
+            "Scale: %.0f%%, smoothed model pass: %.2f ms",
+            (dynamicResolutionEnabled_ ? resolutionGovernor_.GetScale() : 1.0f) * 100.0f,
+            resolutionGovernor_.GetSmoothedFrameSeconds() * 1000.0);
+    }
+
+    if (ImGui::CollapsingHeader("Overdraw", ImGuiTreeNodeFlags_DefaultOpen)) {
+        ImGui::Checkbox("Show overdraw heatmap", &overdrawVisualizationEnabled_);
+        if (overdrawVisualizationEnabled_) {
+            // Averaged as totals over the window, so frames covering more pixels weigh more.
+            const double averageCovered = rendererStatisticsHistory_.ComputeAverage(&RendererFrameStatistics::coveredPixels);
+            const double windowOverdraw = averageCovered > 0.0
+                ? rendererStatisticsHistory_.ComputeAverage(&RendererFrameStatistics::shadedPixels) / averageCovered
+                : 0.0;
+            const double latestOverdraw = latest.coveredPixels > 0
+                ? static_cast<double>(latest.shadedPixels) / static_cast<double>(latest.coveredPixels)
+                : 0.0;
+            ImGui::Text("Overdraw: %.2f last frame, %.2f over the window", latestOverdraw, windowOverdraw);
+            ImGui::Text(
+                "Shaded pixels: %llu, max writes to one pixel: %llu",
+                static_cast<unsigned long long>(latest.shadedPixels),
+                static_cast<unsigned long long>(latest.maxOverdraw));
+            ImGui::TextUnformatted("Black: empty, blue: 1, green, yellow, red: 8, white: more.");
+        }
+    }
+
+    if (ImGui::CollapsingHeader("Input Latency", ImGuiTreeNodeFlags_DefaultOpen)) {
+        ImGui::Checkbox("Late-latch camera before the model pass", &lateLatchCameraEnabled_);
+        if (ImGui::Checkbox("Measure while dragging", &measureInputLatency_)) {
+            inputLatency_.Clear();
+        }
+
+        if (measureInputLatency_) {
+            ImGui::Text("Samples: %d", static_cast<int>(inputLatency_.GetSize()));
+            const InputLatencySample& latestLatency = inputLatency_.GetLatest();
+            const struct {
+                const char* name;
+                InputLatencyMeasure measure;
+            } latencyRows[] = {
+                {"Input to camera", &InputLatencySample::inputToCameraNanoseconds},
+                {"Input to present", &InputLatencySample::inputToPresentNanoseconds},
+            };
+            if (ImGui::BeginTable("InputLatencyTable", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+                ImGui::TableSetupColumn("Milliseconds");
+                ImGui::TableSetupColumn("Last");
+                ImGui::TableSetupColumn("Average");
+                ImGui::TableSetupColumn("Max");
+                ImGui::TableHeadersRow();
+                for (const auto& row : latencyRows) {
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(row.name);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.2f", static_cast<double>(latestLatency.*row.measure) / 1e6);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.2f", inputLatency_.ComputeAverage(row.measure) / 1e6);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.2f", static_cast<double>(inputLatency_.ComputeMaximum(row.measure)) / 1e6);
+                }
+                ImGui::EndTable();
+            }
+        }
+    }
+
+    plottedStatisticIndex_ = std::clamp(plottedStatisticIndex_, 0, static_cast<int>(fields.size()) - 1);
+    const RendererStatisticsField& plottedField = fields[static_cast<std::size_t>(plottedStatisticIndex_)];
+    if (ImGui::BeginCombo("Plot", plottedField.name)) {
+        for (std::size_t fieldIndex = 0; fieldIndex < fields.size(); ++fieldIndex) {
+            const bool selected = static_cast<int>(fieldIndex) == plottedStatisticIndex_;
+            if (ImGui::Selectable(fields[fieldIndex].name, selected)) {
+                plottedStatisticIndex_ = static_cast<int>(fieldIndex);
+            }
+        }
+        ImGui::EndCombo();
+    }
+
+    rendererStatisticsHistory_.CopySeries(plottedField.counter, statisticsPlotValues_);
+    if (!statisticsPlotValues_.empty()) {
+        ImGui::PlotLines(
+            "##RendererStatisticsPlot",
+            statisticsPlotValues_.data(),
+            static_cast<int>(statisticsPlotValues_.size()),
+            0,
+            nullptr,
+            0.0f,
+            FLT_MAX,
+            ImVec2(-1.0f, 80.0f));
+    }
+
+    if (ImGui::Button("Reset Window")) {
+        rendererStatisticsHistory_.Clear();
+    }
+    ImGui::End();
+}
+
+void Application::RegisterMetrics() {
+    metricHandles_.frames = &metrics_.AddCounter("engine_frames_total", "Frames presented.");
+    metricHandles_.frameSeconds = &metrics_.AddHistogram(
+        "engine_frame_seconds",
+        "Wall time between frames.",
+        {0.004, 0.008, 0.0167, 0.033, 0.05, 0.1, 0.25, 0.5, 1.0});
+    metricHandles_.drawCalls = &metrics_.AddGauge("engine_draw_calls", "Draw calls in the last frame.");
+    metricHandles_.trianglesSubmitted = &metrics_.AddGauge("engine_triangles_submitted", "Triangles submitted in the last frame.");
+    metricHandles_.textureResidentBytes = &metrics_.AddGauge("engine_texture_resident_bytes", "Bytes of resident texture mip levels.");
+    metricHandles_.textureDecodesPending = &metrics_.AddGauge("engine_texture_decodes_pending", "Texture decodes in flight.");
+    metricHandles_.renderScale = &metrics_.AddGauge("engine_render_scale", "Dynamic resolution scale of the model pass.");
+    metricHandles_.processResidentBytes = &metrics_.AddGauge("engine_process_resident_bytes", "Resident set size of the process.");
+    metricHandles_.modelLoadSeconds = &metrics_.AddHistogram(
+        "engine_model_load_seconds",
+        "Time from requesting a model load to its result on the main thread.",
+        {0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0, 30.0, 60.0});
+    metricHandles_.modelLoadsSucceeded = &metrics_.AddCounter("engine_model_loads_total", "Finished model loads.", {{"result", "succeeded"}});
+    metricHandles_.modelLoadsFailed = &metrics_.AddCounter("engine_model_loads_total", "Finished model loads.", {{"result", "failed"}});
+}
+
+void Application::StartMetricsExport() {
+    const MetricsExportSettings& settings = GetDefaultMetricsExportSettings();
+    if (settings.httpPort < 0 && settings.textFilePath.empty()) {
+        return;
+    }
+
+    // Process memory is sampled at export time; the frame loop never pays for it.
+    MetricGauge* processResidentBytes = metricHandles_.processResidentBytes;
+    std::string error;
+    if (!metricsExporter_.Start(
+            metrics_,
+            settings,
+            [processResidentBytes]() { processResidentBytes->Set(static_cast<double>(SampleProcessMemory().residentBytes)); },
+            error)) {
+        LogWarning(LogCategory::Application, "Metrics export disabled: %s", error);
+        return;
+    }
+
+    if (!settings.textFilePath.empty()) {
+        LogInfo(LogCategory::Application, "Writing metrics to %s every %.0f seconds.", settings.textFilePath.string(), settings.textFileIntervalSeconds);
+    }
+}
+
+void Application::RecordFrameMetrics(const RendererFrameStatistics& frame, float deltaSeconds, float renderScale) {
+    metricHandles_.frames->Increment();
+    metricHandles_.frameSeconds->Observe(deltaSeconds);
+    metricHandles_.drawCalls->Set(static_cast<double>(frame.drawCalls));
+    metricHandles_.trianglesSubmitted->Set(static_cast<double>(frame.trianglesSubmitted));
+    metricHandles_.textureResidentBytes->Set(static_cast<double>(frame.textureBytesResident));
+    metricHandles_.textureDecodesPending->Set(static_cast<double>(frame.textureDecodesPending));
+    metricHandles_.renderScale->Set(renderScale);
+
+    // Renderer names are static strings, so the pointer only changes with the backend.
+    const char* rendererName = renderer_->GetName();
+    if (rendererName != metricsRendererName_) {
+        metricsRendererName_ = rendererName;
+        metrics_.SetInfo("engine_renderer_info", "Active renderer backend.", {{"backend", rendererName}});
+    }
+}
+
+void Application::EndFlightRecorderFrame() {
+    FlightRecorder& flightRecorder = FlightRecorder::Get();
+    FlightRecorderDump dump;
+    if (!flightRecorder.EndFrame(dump)) {
+        return;
+    }
+
+    const FlightRecorderFrame& hitch = dump.frames.back();
+    LogWarning(
+        LogCategory::Application,
+        "Frame %llu took %.1f ms, %.1f ms of it in %s. Writing the flight recorder.",
+        static_cast<unsigned long long>(hitch.frameIndex),
+        static_cast<double>(hitch.durationNanoseconds) / 1.0e6,
+        static_cast<double>(dump.triggerNanoseconds) / 1.0e6,
+        dump.triggerPhase);
+
+    // Writing a few thousand lines would be a hitch of its own, so it happens off the main thread.
+    auto pendingDump = std::make_shared<FlightRecorderDump>(std::move(dump));
+    JobSystem::Get().ScheduleBackground([pendingDump, directory = flightRecorder.GetSettings().dumpDirectory]() {
+        std::filesystem::path dumpPath;
+        std::string error;
+        if (WriteFlightRecorderDump(*pendingDump, directory, dumpPath, error)) {
+            LogInfo(LogCategory::Application, "Hitch dump written to %s.", dumpPath.string());
+        } else {
+            LogWarning(LogCategory::Application, "Hitch dump failed: %s", error);
+        }
+    });
+}
+
 void Application::DrawShortcutOverlay() {
     ImGuiViewport* viewport = ImGui::GetMainViewport();
     ImGui::SetNextWindowPos(ImVec2(viewport->WorkPos.x + 12.0f, viewport->WorkPos.y + 12.0f), ImGuiCond_Always);
@@ -678,59 +1151,23 @@ void Application::DrawShortcutOverlay() {
 void Application::OpenLoadFbxDialog() {
     const nfdu8filteritem_t filters[] = {
         {"FBX Models", "fbx"},
+        {"Chunked Meshes", "emck"},
     };
 
     nfdu8char_t* selectedPath = nullptr;
-    const nfdresult_t dialogResult = NFD_OpenDialogU8(&selectedPath, filters, 1, nullptr);
-
-    if (dialogResult == NFD_OKAY && selectedPath) {
-        std::string errorMessage;
-        ModelData model;
-        if (FbxLoader::LoadModel(selectedPath, model, errorMessage)) {
-            loadedModel_ = std::move(model);
-            statusMessage_ = "Loaded model successfully.";
-            yawDegrees_ = 0.0f;
-            pitchDegrees_ = 0.0f;
-            rollDegrees_ = 0.0f;
-            currentAnimationIndex_ = 0;
-            animationTimeSeconds_ = 0.0f;
-            animationPlaying_ = true;
-
-            SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Loaded model '%s' with %d textures and %d submeshes.",
-                loadedModel_.sourcePath.c_str(),
-                static_cast<int>(loadedModel_.texturePaths.size()),
-                static_cast<int>(loadedModel_.submeshes.size()));
-
-            for (std::size_t textureIndex = 0; textureIndex < loadedModel_.texturePaths.size(); ++textureIndex) {
-                SDL_LogInfo(
-                    SDL_LOG_CATEGORY_APPLICATION,
-                    "Model texture[%d]: %s",
-                    static_cast<int>(textureIndex),
-                    loadedModel_.texturePaths[textureIndex].c_str());
-            }
+    nfdresult_t dialogResult = NFD_ERROR;
+    {
+        // Waiting on the user is not a hitch; what the choice sets off is.
+        ScopedFramePhase dialogPhase("OpenLoadFbxDialog", true);
+        dialogResult = NFD_OpenDialogU8(&selectedPath, filters, 2, nullptr);
+    }
 
-            for (std::size_t submeshIndex = 0; submeshIndex < loadedModel_.submeshes.size(); ++submeshIndex) {
-                const ModelSubmesh& submesh = loadedModel_.submeshes[submeshIndex];
-                SDL_LogInfo(
-                    SDL_LOG_CATEGORY_APPLICATION,
-                    "Submesh[%d]: idxStart=%u idxCount=%u tex=%d opacityTex=%d normalTex=%d emissiveTex=%d specularTex=%d opacity=%.2f cutoff=%.2f cutout=%s invert=%s transparent=%s",
-                    static_cast<int>(submeshIndex),
-                    submesh.indexStart,
-                    submesh.indexCount,
-                    submesh.textureIndex,
-                    submesh.opacityTextureIndex,
-                    submesh.normalTextureIndex,
-                    submesh.emissiveTextureIndex,
-                    submesh.specularTextureIndex,
-                    submesh.opacity,
-                    submesh.alphaCutoff,
-                    submesh.alphaCutoutEnabled ? "true" : "false",
-                    submesh.opacityTextureInverted ? "true" : "false",
-                    submesh.isTransparent ? "true" : "false");
-            }
-        } else {
-            statusMessage_ = "FBX load failed: " + errorMessage;
-        }
+    if (dialogResult == NFD_OKAY && selectedPath && std::filesystem::path(selectedPath).extension() == ".emck") {
+        OpenStreamedMesh(selectedPath);
+        NFD_FreePathU8(selectedPath);
+    } else if (dialogResult == NFD_OKAY && selectedPath) {
+        statusMessage_ = "Loading model...";
+        StartModelLoad(selectedPath, false);
         NFD_FreePathU8(selectedPath);
     } else if (dialogResult == NFD_CANCEL) {
         statusMessage_ = "File open canceled.";
@@ -740,7 +1177,351 @@ void Application::OpenLoadFbxDialog() {
     }
 }
 
+Task<Application::ModelImport> Application::ImportModelAsync(
+    JobSystem& jobs,
+    std::string sourcePath,
+    bool useCookedCache,
+    bool packTextureAtlases,
+    bool mergeSubmeshes,
+    std::stop_token stopToken) {
+    co_await ResumeOnWorker{jobs};
+
+    ModelImport import{false, ModelData{}, {}, false, nullptr, nullptr, {}, {}};
+    std::error_code tempDirectoryError;
+    const std::filesystem::path tempDirectory = std::filesystem::temp_directory_path(tempDirectoryError);
+    const std::filesystem::path workDirectory = tempDirectoryError ? std::filesystem::path(".") : tempDirectory;
+    if (useCookedCache) {
+        LazyModel cachedModel;
+        import.succeeded = OpenCachedModel(sourcePath, workDirectory / "EngineModelCache", cachedModel, import.error) &&
+            cachedModel.Materialize(kFullModelLoadRequest, import.model, import.error);
+    } else {
+        import.succeeded = FbxLoader::LoadModel(sourcePath, import.model, import.error);
+    }
+
+    if (!import.succeeded) {
+        co_return import;
+    }
+
+    // The resolver already knows which references named no file, so missing textures are
+    // reported with the load without another stat() per slot.
+    for (const std::uint32_t textureIndex : import.model.unresolvedTextureIndices) {
+        if (textureIndex < import.model.texturePaths.size()) {
+            LogWarning(LogCategory::Loader, "Texture not found: %s", import.model.texturePaths[textureIndex]);
+        }
+    }
+    if (!import.model.unresolvedTextureIndices.empty()) {
+        import.summary += " " + std::to_string(import.model.unresolvedTextureIndices.size()) + " texture(s) missing.";
+    }
+
+    if (stopToken.stop_requested()) {
+        import.succeeded = false;
+        import.error = "Cancelled.";
+        co_return import;
+    }
+
+    // Atlas packing rewrites texturePaths; the watcher needs the files the artist actually edits.
+    import.sourceTexturePaths = import.model.texturePaths;
+    if (packTextureAtlases) {
+        const TextureAtlasOptions atlasOptions{workDirectory / "EngineTextureAtlases", 4096, 8};
+        TextureAtlasStats atlasStats{};
+        std::string atlasError;
+        if (BuildTextureAtlases(import.model, atlasOptions, atlasStats, atlasError)) {
+            import.texturesAtlased = atlasStats.packedTextureCount > 0;
+            import.summary += " Packed " + std::to_string(atlasStats.packedTextureCount) + " textures into " +
+                std::to_string(atlasStats.atlasCount) + " atlases.";
+            LogInfo(
+                LogCategory::Loader,
+                "Texture atlases: %d atlases, %d textures, %d materials packed, %d wrapping, %d unpackable.",
+                static_cast<int>(atlasStats.atlasCount),
+                static_cast<int>(atlasStats.packedTextureCount),
+                static_cast<int>(atlasStats.packedMaterialCount),
+                static_cast<int>(atlasStats.wrappingMaterialCount),
+                static_cast<int>(atlasStats.unpackableMaterialCount));
+        } else {
+            LogWarning(LogCategory::Loader, "Texture atlas packing skipped: %s", atlasError);
+        }
+    }
+    if (mergeSubmeshes) {
+        const SubmeshMergeStats mergeStats = MergeSubmeshesByMaterial(import.model);
+        import.summary += " Merged " + std::to_string(mergeStats.submeshCountBefore) + " submeshes into " +
+            std::to_string(mergeStats.submeshCountAfter) + ".";
+    }
+    // Last, so no later step can invalidate it; renderers then skip per-triangle index checks.
+    const std::size_t invalidTriangleCount = ValidateTriangleIndices(import.model);
+    if (invalidTriangleCount > 0) {
+        LogWarning(LogCategory::Loader, "Removed %d triangle(s) with out-of-range indices.", static_cast<int>(invalidTriangleCount));
+    }
+    if (import.model.positions.size() >= kPointCloudPreviewMinimumVertices && !stopToken.stop_requested()) {
+        auto preview = std::make_shared<PointCloudPreview>(BuildPointCloudPreview(import.model, kPointCloudPreviewTargetPoints));
+        import.summary += " Built a " + std::to_string(preview->points.size()) + "-point preview.";
+        import.pointCloudPreview = std::move(preview);
+    }
+    import.bvhSource = std::make_shared<const ModelBvhSource>(
+        ModelBvhSource{import.model.positions, import.model.indices, import.model.submeshes});
+    co_return import;
+}
+
+Task<void> Application::LoadModelInBackground(std::string sourcePath, bool isReload, std::stop_token stopToken) {
+    JobSystem& jobs = JobSystem::Get();
+    const std::uint64_t loadStartNanoseconds = SDL_GetTicksNS();
+    ModelImport import = co_await ImportModelAsync(
+        jobs,
+        sourcePath,
+        useCookedModelCache_,
+        packTextureAtlasesOnLoad_,
+        mergeSubmeshesOnLoad_,
+        stopToken);
+
+    co_await ResumeOnMainThread{jobs};
+    // A newer load, a streamed mesh or shutdown took over; leave the application alone.
+    if (stopToken.stop_requested()) {
+        co_return;
+    }
+
+    modelLoadInFlight_ = false;
+    metricHandles_.modelLoadSeconds->Observe(static_cast<double>(SDL_GetTicksNS() - loadStartNanoseconds) / 1.0e9);
+    (import.succeeded ? metricHandles_.modelLoadsSucceeded : metricHandles_.modelLoadsFailed)->Increment();
+    FlightRecorder::Get().RecordEvent(std::string(import.succeeded ? "Model load finished: " : "Model load failed: ") +
+        std::filesystem::path(sourcePath).filename().string());
+    if (!import.succeeded) {
+        statusMessage_ = (isReload ? "Model reload failed: " : "FBX load failed: ") + import.error;
+        LogWarning(LogCategory::Loader, "%s", statusMessage_);
+        co_return;
+    }
+
+    if (isReload) {
+        statusMessage_ = "Reloaded model." + import.summary;
+    } else {
+        meshStream_.Close();
+        drawnMeshChunks_.clear();
+        statusMessage_ = "Loaded model successfully." + import.summary;
+    }
+    ApplyImportedModel(std::move(import), !isReload);
+}
+
+void Application::StartModelLoad(const std::string& sourcePath, bool isReload) {
+    FlightRecorder::Get().RecordEvent(std::string(isReload ? "Model reload started: " : "Model load started: ") +
+        std::filesystem::path(sourcePath).filename().string());
+    CancelModelLoad();
+    modelLoadInFlight_ = true;
+    StartDetached(LoadModelInBackground(sourcePath, isReload, modelLoadStopSource_.get_token()));
+}
+
+void Application::CancelModelLoad() noexcept {
+    // The cancelled load may still be running; it checks its own token before touching anything.
+    modelLoadStopSource_.request_stop();
+    modelLoadStopSource_ = std::stop_source();
+    modelLoadInFlight_ = false;
+}
+
+void Application::ApplyImportedModel(ModelImport&& import, bool resetView) {
+    ScopedFramePhase applyPhase("ApplyImportedModel");
+    loadedModel_ = std::move(import.model);
+    morphTargetBlender_.Reset(loadedModel_);
+    loadedModelTexturesAtlased_ = import.texturesAtlased;
+    pointCloudPreview_ = std::move(import.pointCloudPreview);
+    if (resetView) {
+        yawDegrees_ = 0.0f;
+        pitchDegrees_ = 0.0f;
+        rollDegrees_ = 0.0f;
+        orbitPivot_ = glm::vec3(0.0f);
+        currentAnimationIndex_ = 0;
+        animationTimeSeconds_ = 0.0f;
+        animationPlaying_ = true;
+    } else if (currentAnimationIndex_ >= loadedModel_.animations.size()) {
+        currentAnimationIndex_ = 0;
+        animationTimeSeconds_ = 0.0f;
+    }
+    StartModelBvhBuild(std::move(import.bvhSource));
+
+    std::vector<std::filesystem::path> watchedFiles{loadedModel_.sourcePath};
+    watchedFiles.insert(watchedFiles.end(), import.sourceTexturePaths.begin(), import.sourceTexturePaths.end());
+    modelFileWatcher_.Watch(watchedFiles);
+
+    LogInfo(LogCategory::Loader, "Loaded model '%s' with %d textures and %d submeshes.",
+        loadedModel_.sourcePath.c_str(),
+        static_cast<int>(loadedModel_.texturePaths.size()),
+        static_cast<int>(loadedModel_.submeshes.size()));
+
+    // Per-item dumps are debug records; skip the loops entirely unless someone asked for them.
+    if (Logger::Get().IsEnabled(LogCategory::Loader, LogLevel::Debug)) {
+        for (std::size_t textureIndex = 0; textureIndex < loadedModel_.texturePaths.size(); ++textureIndex) {
+            LogDebug(
+                LogCategory::Loader,
+                "Model texture[%d]: %s",
+                static_cast<int>(textureIndex),
+                loadedModel_.texturePaths[textureIndex].c_str());
+        }
+
+        for (std::size_t materialIndex = 0; materialIndex < loadedModel_.materials.size(); ++materialIndex) {
+            const ModelMaterial& material = loadedModel_.materials[materialIndex];
+            LogDebug(
+                LogCategory::Loader,
+                "Material[%d]: tex=%d opacityTex=%d normalTex=%d emissiveTex=%d specularTex=%d opacity=%.2f cutoff=%.2f cutout=%s invert=%s transparent=%s",
+                static_cast<int>(materialIndex),
+                material.textureIndex,
+                material.opacityTextureIndex,
+                material.normalTextureIndex,
+                material.emissiveTextureIndex,
+                material.specularTextureIndex,
+                material.opacity,
+                material.alphaCutoff,
+                material.alphaCutoutEnabled ? "true" : "false",
+                material.opacityTextureInverted ? "true" : "false",
+                material.isTransparent ? "true" : "false");
+        }
+
+        for (std::size_t submeshIndex = 0; submeshIndex < loadedModel_.submeshes.size(); ++submeshIndex) {
+            const ModelSubmesh& submesh = loadedModel_.submeshes[submeshIndex];
+            LogDebug(
+                LogCategory::Loader,
+                "Submesh[%d]: idxStart=%u idxCount=%u material=%u",
+                static_cast<int>(submeshIndex),
+                submesh.indexStart,
+                submesh.indexCount,
+                submesh.materialIndex);
+        }
+    }
+}
+
+void Application::PollModelHotReload() {
+    if (!hotReloadEnabled_ || !loadedModel_.IsValid()) {
+        return;
+    }
+
+    bool reimportModel = modelReloadQueued_;
+    std::vector<std::string> changedTextures;
+    for (const std::filesystem::path& changedFile : modelFileWatcher_.PollChanges()) {
+        if (changedFile.string() == loadedModel_.sourcePath) {
+            reimportModel = true;
+        } else {
+            changedTextures.push_back(changedFile.string());
+        }
+    }
+
+    // Atlas pages are baked from the sources, so an edited texture means re-cooking; otherwise the
+    // renderer re-decodes only the files that changed and keeps the rest of its cache.
+    if (!changedTextures.empty() && loadedModelTexturesAtlased_) {
+        reimportModel = true;
+    } else if (!changedTextures.empty() && renderer_) {
+        renderer_->InvalidateModelTextures(changedTextures);
+        statusMessage_ = "Reloaded " + std::to_string(changedTextures.size()) + " texture(s).";
+        LogInfo(LogCategory::Loader, "Hot reload: %zu texture(s) changed.", changedTextures.size());
+    }
+
+    if (!reimportModel) {
+        return;
+    }
+
+    if (modelLoadInFlight_) {
+        modelReloadQueued_ = true;
+        return;
+    }
+
+    modelReloadQueued_ = false;
+    LogInfo(LogCategory::Loader, "Hot reload: re-importing '%s'.", loadedModel_.sourcePath);
+    StartModelLoad(loadedModel_.sourcePath, true);
+}
+
+void Application::OpenStreamedMesh(const std::string& path) {
+    CancelModelLoad();
+    std::string errorMessage;
+    drawnMeshChunks_.clear();
+    if (!meshStream_.Open(path, static_cast<std::size_t>(meshStreamBudgetMegabytes_) << 20, errorMessage)) {
+        statusMessage_ = "Chunked mesh load failed: " + errorMessage;
+        LogError(LogCategory::Loader, "%s", statusMessage_);
+        return;
+    }
+
+    // The streamed model is rebuilt from resident chunks every time the drawn set changes, so it is
+    // neither hot reloaded nor indexed for picking.
+    loadedModel_ = ModelData{};
+    morphTargetBlender_.Reset(loadedModel_);
+    loadedModelTexturesAtlased_ = false;
+    pointCloudPreview_.reset();
+    modelFileWatcher_.Clear();
+    CancelModelBvhBuild();
+    yawDegrees_ = 0.0f;
+    pitchDegrees_ = 0.0f;
+    rollDegrees_ = 0.0f;
+    orbitPivot_ = glm::vec3(0.0f);
+    currentAnimationIndex_ = 0;
+    animationTimeSeconds_ = 0.0f;
+
+    statusMessage_ = "Streaming " + std::to_string(meshStream_.GetChunks().size()) + " chunks.";
+    LogInfo(
+        LogCategory::Loader,
+        "Streaming chunked mesh '%s': %zu chunks, %d MB budget.",
+        path,
+        meshStream_.GetChunks().size(),
+        meshStreamBudgetMegabytes_);
+}
+
+void Application::SaveChunkedMesh() {
+    std::filesystem::path outputPath(loadedModel_.sourcePath);
+    outputPath.replace_extension(".emck");
+    std::string errorMessage;
+    if (!WriteChunkedMesh(outputPath, loadedModel_, kDefaultChunkedMeshBuildOptions, errorMessage)) {
+        statusMessage_ = "Chunked mesh export failed: " + errorMessage;
+        LogError(LogCategory::Loader, "%s", statusMessage_);
+        return;
+    }
+
+    statusMessage_ = "Saved chunked mesh to " + outputPath.string() + ".";
+    LogInfo(LogCategory::Loader, "%s", statusMessage_);
+}
+
+void Application::UpdateMeshStreaming() {
+    if (!meshStream_.IsOpen()) {
+        return;
+    }
+
+    const ImGuiIO& io = ImGui::GetIO();
+    const float viewportHeight = std::max(io.DisplaySize.y, 1.0f);
+    const float aspectRatio = std::max(io.DisplaySize.x, 1.0f) / viewportHeight;
+    meshStream_.SelectChunks(BuildCamera(), aspectRatio, viewportHeight, 1.5f, meshChunkRequests_);
+
+    std::vector<std::shared_ptr<const ResidentMeshChunk>> drawable;
+    meshStream_.Request(meshChunkRequests_, drawable);
+    if (drawable != drawnMeshChunks_) {
+        drawnMeshChunks_ = std::move(drawable);
+        meshStream_.BuildModel(drawnMeshChunks_, loadedModel_);
+    }
+}
+
+void Application::DrawMeshStreamingControls() {
+    if (!meshStream_.IsOpen()) {
+        ImGui::BeginDisabled(!loadedModel_.IsValid());
+        if (ImGui::Button("Save Chunked Mesh")) {
+            SaveChunkedMesh();
+        }
+        ImGui::EndDisabled();
+        return;
+    }
+
+    if (ImGui::SliderInt("Stream Budget (MB)", &meshStreamBudgetMegabytes_, 16, 4096)) {
+        meshStream_.SetBudget(static_cast<std::size_t>(meshStreamBudgetMegabytes_) << 20);
+    }
+
+    const ChunkedMeshStreamStats stats = meshStream_.GetStatistics();
+    ImGui::Text(
+        "Resident %.1f / %.1f MB, %zu chunks (%zu drawn of %zu)",
+        static_cast<double>(stats.residentBytes) / (1024.0 * 1024.0),
+        static_cast<double>(stats.budgetBytes) / (1024.0 * 1024.0),
+        stats.residentChunkCount,
+        drawnMeshChunks_.size(),
+        meshStream_.GetChunks().size());
+    ImGui::Text(
+        "Pending %zu, loaded %llu, evicted %llu, over budget %llu",
+        stats.pendingLoadCount,
+        static_cast<unsigned long long>(stats.loadCount),
+        static_cast<unsigned long long>(stats.evictionCount),
+        static_cast<unsigned long long>(stats.rejectedLoadCount));
+}
+
 void Application::Shutdown() noexcept {
+    metricsExporter_.Stop();
+    CancelModelLoad();
     ShutdownImGui();
 
     if (renderer_) {
@@ -758,6 +1539,8 @@ void Application::Shutdown() noexcept {
         nfdInitialized_ = false;
     }
 
+    Logger::Get().Flush();
+
     if (sdlInitialized_) {
         SDL_Quit();
         sdlInitialized_ = false;
@@ -809,4 +1592,194 @@ void Application::StepAnimationSelection(int direction) {
 
     animationTimeSeconds_ = 0.0f;
 }
+
+void Application::UpdateMorphTargets() {
+    if (loadedModel_.morphTargets.empty()) {
+        return;
+    }
+
+    const AnimationClip* activeClip =
+        currentAnimationIndex_ < loadedModel_.animations.size() ? &loadedModel_.animations[currentAnimationIndex_] : nullptr;
+    SampleMorphWeights(loadedModel_, activeClip, animationTimeSeconds_, morphWeights_);
+    const std::uint64_t blendStart = SDL_GetPerformanceCounter();
+    if (morphTargetBlender_.Apply(morphWeights_, loadedModel_) > 0) {
+        const std::uint64_t blendTicks = SDL_GetPerformanceCounter() - blendStart;
+        lastMorphBlendMicroseconds_ =
+            static_cast<float>(static_cast<double>(blendTicks) * 1000000.0 / static_cast<double>(SDL_GetPerformanceFrequency()));
+    }
+}
+
+ModelCamera Application::BuildCamera() const noexcept {
+    return ModelCamera{yawDegrees_, pitchDegrees_, rollDegrees_, cameraDistance_, orbitPivot_};
+}
+
+void Application::ApplyCameraDrag(float mouseX, float mouseY) noexcept {
+    yawDegrees_ += (mouseX - dragMouseX_) * kDragDegreesPerPixel;
+    pitchDegrees_ += (mouseY - dragMouseY_) * kDragDegreesPerPixel;
+    dragMouseX_ = mouseX;
+    dragMouseY_ = mouseY;
+}
+
+ModelCamera Application::LatchCamera() {
+    if (lateLatchCameraEnabled_ && cameraDragActive_) {
+        // Pumping only queues events; ImGui still receives them from next frame's poll, and the
+        // drag position kept here stops that motion from being applied twice.
+        SDL_PumpEvents();
+        float mouseX = 0.0f;
+        float mouseY = 0.0f;
+        if ((SDL_GetMouseState(&mouseX, &mouseY) & SDL_BUTTON_LMASK) != 0) {
+            if (measureInputLatency_) {
+                std::array<SDL_Event, 64> pendingMotion{};
+                const int motionCount = SDL_PeepEvents(
+                    pendingMotion.data(),
+                    static_cast<int>(pendingMotion.size()),
+                    SDL_PEEKEVENT,
+                    SDL_EVENT_MOUSE_MOTION,
+                    SDL_EVENT_MOUSE_MOTION);
+                for (int motionIndex = 0; motionIndex < motionCount; ++motionIndex) {
+                    inputLatency_.RecordInput(pendingMotion[static_cast<std::size_t>(motionIndex)].common.timestamp);
+                }
+            }
+            ApplyCameraDrag(mouseX, mouseY);
+        }
+    }
+
+    if (measureInputLatency_) {
+        inputLatency_.RecordCameraBuilt(SDL_GetTicksNS());
+    }
+    return BuildCamera();
+}
+
+void Application::StartModelBvhBuild(std::shared_ptr<const ModelBvhSource> source) {
+    CancelModelBvhBuild();
+    if (!source) {
+        return;
+    }
+
+    // The job owns its result slot, so a superseded build finishes on its own and is never waited on.
+    auto build = std::make_shared<ModelBvhBuild>(ModelBvhBuild{modelBvhGeneration_, nullptr});
+    pendingModelBvh_ = build;
+    modelBvhJob_ = JobSystem::Get().ScheduleBackground([build, source = std::move(source)]() {
+        build->bvh = std::make_unique<ModelBvh>(ModelBvh::Build(source->positions, source->indices, source->submeshes));
+    });
+}
+
+void Application::CancelModelBvhBuild() noexcept {
+    ++modelBvhGeneration_;
+    modelBvhJob_ = nullptr;
+    pendingModelBvh_ = nullptr;
+    modelBvh_.reset();
+    hoveredHit_.reset();
+}
+
+void Application::PollModelBvhBuild() {
+    if (!modelBvhJob_ || !JobSystem::IsComplete(modelBvhJob_)) {
+        return;
+    }
+
+    std::shared_ptr<ModelBvhBuild> build = std::move(pendingModelBvh_);
+    modelBvhJob_ = nullptr;
+    if (!build || build->generation != modelBvhGeneration_ || !build->bvh) {
+        return;
+    }
+
+    modelBvh_ = std::move(build->bvh);
+    LogInfo(
+        LogCategory::Application,
+        "Picking BVH ready: %zu triangles, %zu nodes.",
+        modelBvh_->GetTriangleCount(),
+        modelBvh_->GetNodeCount());
+}
+
+void Application::UpdateModelPicking() {
+    hoveredHit_.reset();
+    if (!modelBvh_ || modelBvh_->IsEmpty()) {
+        return;
+    }
+
+    const ImGuiIO& io = ImGui::GetIO();
+    if (io.WantCaptureMouse || !ImGui::IsMousePosValid() || io.DisplaySize.x <= 1.0f || io.DisplaySize.y <= 1.0f) {
+        return;
+    }
+
+    const float aspectRatio = io.DisplaySize.x / io.DisplaySize.y;
+    const float ndcX = (io.MousePos.x / io.DisplaySize.x) * 2.0f - 1.0f;
+    const float ndcY = 1.0f - (io.MousePos.y / io.DisplaySize.y) * 2.0f;
+
+    const std::uint64_t pickStart = SDL_GetPerformanceCounter();
+    hoveredHit_ = modelBvh_->Intersect(BuildModelSpacePickRay(BuildCamera(), aspectRatio, ndcX, ndcY));
+    const std::uint64_t pickTicks = SDL_GetPerformanceCounter() - pickStart;
+    lastPickMicroseconds_ = static_cast<float>(static_cast<double>(pickTicks) * 1000000.0 / static_cast<double>(SDL_GetPerformanceFrequency()));
+
+    const float dragThresholdSquared = io.MouseDragThreshold * io.MouseDragThreshold;
+    const bool clickedWithoutDrag =
+        ImGui::IsMouseReleased(ImGuiMouseButton_Left) &&
+        io.MouseDragMaxDistanceSqr[ImGuiMouseButton_Left] < dragThresholdSquared;
+    if (clickedWithoutDrag && hoveredHit_) {
+        orbitPivot_ = hoveredHit_->position;
+    }
+}
+
+void Application::DrawHoveredSubmeshHighlight() {
+    if (!hoveredHit_ || !modelBvh_) {
+        return;
+    }
+
+    const ImGuiIO& io = ImGui::GetIO();
+    const glm::mat4 mvp = BuildModelViewProjection(BuildCamera(), io.DisplaySize.x / io.DisplaySize.y);
+    auto projectToScreen = [&](const glm::vec3& point, ImVec2& outScreen) -> bool {
+        const glm::vec4 clip = mvp * glm::vec4(point, 1.0f);
+        if (clip.w <= 0.0001f) {
+            return false;
+        }
+
+        outScreen = ImVec2(
+            (clip.x / clip.w * 0.5f + 0.5f) * io.DisplaySize.x,
+            (0.5f - clip.y / clip.w * 0.5f) * io.DisplaySize.y);
+        return true;
+    };
+
+    ImDrawList* drawList = ImGui::GetBackgroundDrawList();
+
+    const std::vector<ModelBounds>& submeshBounds = modelBvh_->GetSubmeshBounds();
+    if (hoveredHit_->submeshIndex < submeshBounds.size()) {
+        const ModelBounds& bounds = submeshBounds[hoveredHit_->submeshIndex];
+        std::array<ImVec2, 8> corners;
+        bool allCornersVisible = true;
+        for (std::size_t corner = 0; corner < corners.size(); ++corner) {
+            const glm::vec3 point(
+                (corner & 1) != 0 ? bounds.max.x : bounds.min.x,
+                (corner & 2) != 0 ? bounds.max.y : bounds.min.y,
+                (corner & 4) != 0 ? bounds.max.z : bounds.min.z);
+            allCornersVisible = projectToScreen(point, corners[corner]) && allCornersVisible;
+        }
+
+        if (allCornersVisible) {
+            constexpr std::array<std::pair<int, int>, 12> edges = {{
+                {0, 1}, {2, 3}, {4, 5}, {6, 7},
+                {0, 2}, {1, 3}, {4, 6}, {5, 7},
+                {0, 4}, {1, 5}, {2, 6}, {3, 7},
+            }};
+            for (const auto& [from, to] : edges) {
+                drawList->AddLine(corners[from], corners[to], IM_COL32(255, 196, 64, 200), 1.5f);
+            }
+        }
+    }
+
+    const std::size_t indexBase = static_cast<std::size_t>(hoveredHit_->triangleIndex) * 3;
+    if (indexBase + 2 >= loadedModel_.indices.size()) {
+        return;
+    }
+
+    std::array<ImVec2, 3> triangle;
+    for (std::size_t vertex = 0; vertex < triangle.size(); ++vertex) {
+        const std::uint32_t positionIndex = loadedModel_.indices[indexBase + vertex];
+        if (positionIndex >= loadedModel_.positions.size() || !projectToScreen(loadedModel_.positions[positionIndex], triangle[vertex])) {
+            return;
+        }
+    }
+
+    drawList->AddTriangleFilled(triangle[0], triangle[1], triangle[2], IM_COL32(255, 196, 64, 110));
+    drawList->AddTriangle(triangle[0], triangle[1], triangle[2], IM_COL32(255, 230, 160, 255), 1.5f);
+}
 }
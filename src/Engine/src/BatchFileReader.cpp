@@ -0,0 +1,471 @@
+#include "Engine/BatchFileReader.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <utility>
+
+#include "Engine/JobSystem.hpp"
+
+#if defined(__linux__)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace engine {
+namespace {
+// Keeps single reads within the 32-bit length of a submission and the kernel's 1 GiB limit on a
+// registered buffer.
+constexpr std::uint64_t kMaxReadBytes = 1ull << 30;
+
+std::string OpenError(const std::filesystem::path& path) {
+    return "Failed to open '" + path.string() + "'.";
+}
+
+std::string ReadError(const std::filesystem::path& path) {
+    return "Failed to read '" + path.string() + "'.";
+}
+
+#if !defined(_WIN32)
+// Opens a regular file for reading and reports its size. Returns -1 on failure.
+int OpenForRead(const std::filesystem::path& path, std::uint64_t& outSize) {
+    const int fileDescriptor = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fileDescriptor < 0) {
+        return -1;
+    }
+
+    struct stat status {};
+    if (fstat(fileDescriptor, &status) != 0 || !S_ISREG(status.st_mode)) {
+        close(fileDescriptor);
+        return -1;
+    }
+
+    outSize = static_cast<std::uint64_t>(status.st_size);
+    return fileDescriptor;
+}
+
+// Fills `bytes` from `offset` onwards with pread. Returns false on an error or early end of file.
+bool ReadRemaining(int fileDescriptor, std::vector<std::byte>& bytes, std::uint64_t offset) {
+    while (offset < bytes.size()) {
+        const std::uint64_t length = std::min<std::uint64_t>(bytes.size() - offset, kMaxReadBytes);
+        const ssize_t readBytes = pread(fileDescriptor, bytes.data() + offset, static_cast<std::size_t>(length), static_cast<off_t>(offset));
+        if (readBytes < 0 && errno == EINTR) {
+            continue;
+        }
+        if (readBytes <= 0) {
+            return false;
+        }
+        offset += static_cast<std::uint64_t>(readBytes);
+    }
+    return true;
+}
+#endif
+
+void ReadWholeFile(const std::filesystem::path& path, FileReadResult& outFile) {
+    outFile = FileReadResult{false, {}, {}};
+#if defined(_WIN32)
+    std::error_code sizeError;
+    const std::uintmax_t fileSize = std::filesystem::file_size(path, sizeError);
+    std::ifstream input(path, std::ios::binary);
+    if (sizeError || !input) {
+        outFile.error = OpenError(path);
+        return;
+    }
+
+    outFile.bytes.resize(static_cast<std::size_t>(fileSize));
+    if (!input.read(reinterpret_cast<char*>(outFile.bytes.data()), static_cast<std::streamsize>(outFile.bytes.size()))) {
+        outFile.bytes.clear();
+        outFile.error = ReadError(path);
+        return;
+    }
+#else
+    std::uint64_t fileSize = 0;
+    const int fileDescriptor = OpenForRead(path, fileSize);
+    if (fileDescriptor < 0) {
+        outFile.error = OpenError(path);
+        return;
+    }
+
+    outFile.bytes.resize(static_cast<std::size_t>(fileSize));
+    const bool readAll = ReadRemaining(fileDescriptor, outFile.bytes, 0);
+    close(fileDescriptor);
+    if (!readAll) {
+        outFile.bytes.clear();
+        outFile.error = ReadError(path);
+        return;
+    }
+#endif
+    outFile.succeeded = true;
+}
+
+void ReadBatchWithThreadPool(
+    JobSystem& jobs,
+    const std::vector<std::filesystem::path>& paths,
+    std::vector<FileReadResult>& outFiles,
+    const FileReadyCallback& onFileReady,
+    std::atomic<std::uint64_t>& bytesRead) {
+    jobs.ParallelFor(paths.size(), 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t fileIndex = begin; fileIndex < end; ++fileIndex) {
+            ReadWholeFile(paths[fileIndex], outFiles[fileIndex]);
+            bytesRead.fetch_add(outFiles[fileIndex].bytes.size(), std::memory_order_relaxed);
+            if (onFileReady) {
+                onFileReady(fileIndex);
+            }
+        }
+    });
+}
+
+#if defined(__linux__)
+// Minimal io_uring instance driven through the raw system calls, so no liburing is needed.
+class IoUringQueue {
+public:
+    IoUringQueue() = default;
+
+    ~IoUringQueue() {
+        if (submissionEntries_) {
+            munmap(submissionEntries_, submissionEntriesSize_);
+        }
+        if (completionRing_ != MAP_FAILED) {
+            munmap(completionRing_, completionRingSize_);
+        }
+        if (submissionRing_ != MAP_FAILED) {
+            munmap(submissionRing_, submissionRingSize_);
+        }
+        if (ringDescriptor_ >= 0) {
+            close(ringDescriptor_);
+        }
+    }
+
+    IoUringQueue(const IoUringQueue&) = delete;
+    IoUringQueue& operator=(const IoUringQueue&) = delete;
+
+    bool Initialize(unsigned entryCount) {
+        io_uring_params parameters{};
+        ringDescriptor_ = static_cast<int>(syscall(__NR_io_uring_setup, entryCount, &parameters));
+        if (ringDescriptor_ < 0) {
+            return false;
+        }
+
+        submissionRingSize_ = parameters.sq_off.array + parameters.sq_entries * sizeof(unsigned);
+        completionRingSize_ = parameters.cq_off.cqes + parameters.cq_entries * sizeof(io_uring_cqe);
+        submissionEntriesSize_ = parameters.sq_entries * sizeof(io_uring_sqe);
+        submissionRing_ = mmap(nullptr, submissionRingSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringDescriptor_, IORING_OFF_SQ_RING);
+        completionRing_ = mmap(nullptr, completionRingSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringDescriptor_, IORING_OFF_CQ_RING);
+        void* entries = mmap(nullptr, submissionEntriesSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringDescriptor_, IORING_OFF_SQES);
+        if (submissionRing_ == MAP_FAILED || completionRing_ == MAP_FAILED || entries == MAP_FAILED) {
+            return false;
+        }
+
+        submissionEntries_ = static_cast<io_uring_sqe*>(entries);
+        auto* submissionBase = static_cast<std::byte*>(submissionRing_);
+        submissionHead_ = reinterpret_cast<unsigned*>(submissionBase + parameters.sq_off.head);
+        submissionTail_ = reinterpret_cast<unsigned*>(submissionBase + parameters.sq_off.tail);
+        submissionMask_ = *reinterpret_cast<unsigned*>(submissionBase + parameters.sq_off.ring_mask);
+        submissionArray_ = reinterpret_cast<unsigned*>(submissionBase + parameters.sq_off.array);
+        submissionEntryCount_ = parameters.sq_entries;
+        localSubmissionTail_ = *submissionTail_;
+
+        auto* completionBase = static_cast<std::byte*>(completionRing_);
+        completionHead_ = reinterpret_cast<unsigned*>(completionBase + parameters.cq_off.head);
+        completionTail_ = reinterpret_cast<unsigned*>(completionBase + parameters.cq_off.tail);
+        completionMask_ = *reinterpret_cast<unsigned*>(completionBase + parameters.cq_off.ring_mask);
+        completions_ = reinterpret_cast<io_uring_cqe*>(completionBase + parameters.cq_off.cqes);
+        return true;
+    }
+
+    // Pins `buffers` so reads into them skip the per-request page mapping. Fails when the memory
+    // lock limit is too low, in which case plain reads are used instead.
+    bool RegisterBuffers(const std::vector<iovec>& buffers) {
+        return syscall(__NR_io_uring_register, ringDescriptor_, IORING_REGISTER_BUFFERS, buffers.data(), static_cast<unsigned>(buffers.size())) == 0;
+    }
+
+    // Returns a zeroed submission entry, or null when every slot is queued.
+    io_uring_sqe* AcquireEntry() {
+        const unsigned head = std::atomic_ref<unsigned>(*submissionHead_).load(std::memory_order_acquire);
+        if (localSubmissionTail_ - head >= submissionEntryCount_) {
+            return nullptr;
+        }
+
+        const unsigned slot = localSubmissionTail_ & submissionMask_;
+        submissionArray_[slot] = slot;
+        ++localSubmissionTail_;
+        ++unsubmittedCount_;
+        io_uring_sqe* entry = &submissionEntries_[slot];
+        std::memset(entry, 0, sizeof(*entry));
+        return entry;
+    }
+
+    // Hands every acquired entry to the kernel and blocks until at least `minCompletions` finish.
+    bool SubmitAndWait(unsigned minCompletions) {
+        std::atomic_ref<unsigned>(*submissionTail_).store(localSubmissionTail_, std::memory_order_release);
+        while (true) {
+            const long submitted = syscall(__NR_io_uring_enter, ringDescriptor_, unsubmittedCount_, minCompletions, IORING_ENTER_GETEVENTS, nullptr, 0);
+            if (submitted >= 0) {
+                unsubmittedCount_ -= std::min(unsubmittedCount_, static_cast<unsigned>(submitted));
+                return true;
+            }
+            if (errno != EINTR) {
+                return false;
+            }
+        }
+    }
+
+    // Blocks until at least `minCompletions` finish without submitting anything new.
+    bool WaitForCompletions(unsigned minCompletions) {
+        while (true) {
+            if (syscall(__NR_io_uring_enter, ringDescriptor_, 0, minCompletions, IORING_ENTER_GETEVENTS, nullptr, 0) >= 0) {
+                return true;
+            }
+            if (errno != EINTR) {
+                return false;
+            }
+        }
+    }
+
+    // Entries acquired but not yet taken by the kernel.
+    [[nodiscard]] unsigned GetUnsubmittedCount() const noexcept {
+        return unsubmittedCount_;
+    }
+
+    template <typename Handler>
+    void DrainCompletions(Handler&& handleCompletion) {
+        unsigned head = std::atomic_ref<unsigned>(*completionHead_).load(std::memory_order_relaxed);
+        const unsigned tail = std::atomic_ref<unsigned>(*completionTail_).load(std::memory_order_acquire);
+        for (; head != tail; ++head) {
+            handleCompletion(completions_[head & completionMask_]);
+        }
+        std::atomic_ref<unsigned>(*completionHead_).store(head, std::memory_order_release);
+    }
+
+private:
+    int ringDescriptor_ = -1;
+    void* submissionRing_ = MAP_FAILED;
+    void* completionRing_ = MAP_FAILED;
+    io_uring_sqe* submissionEntries_ = nullptr;
+    std::size_t submissionRingSize_ = 0;
+    std::size_t completionRingSize_ = 0;
+    std::size_t submissionEntriesSize_ = 0;
+    unsigned* submissionHead_ = nullptr;
+    unsigned* submissionTail_ = nullptr;
+    unsigned* submissionArray_ = nullptr;
+    unsigned submissionMask_ = 0;
+    unsigned submissionEntryCount_ = 0;
+    unsigned localSubmissionTail_ = 0;
+    unsigned unsubmittedCount_ = 0;
+    unsigned* completionHead_ = nullptr;
+    unsigned* completionTail_ = nullptr;
+    unsigned completionMask_ = 0;
+    io_uring_cqe* completions_ = nullptr;
+};
+
+constexpr unsigned kMaxQueueDepth = 64;
+constexpr std::size_t kMaxRegisteredBuffers = 1024;
+
+// Returns false only when no ring could be created, before any file was touched.
+bool ReadBatchWithIoUring(
+    JobSystem& jobs,
+    const std::vector<std::filesystem::path>& paths,
+    std::vector<FileReadResult>& outFiles,
+    const FileReadyCallback& onFileReady,
+    FileBatchStatistics& statistics) {
+    IoUringQueue ring;
+    if (!ring.Initialize(std::clamp<unsigned>(static_cast<unsigned>(paths.size()), 1, kMaxQueueDepth))) {
+        return false;
+    }
+
+    // Opens go through the workers too: on network filesystems they cost a round trip each.
+    std::vector<int> descriptors(paths.size(), -1);
+    std::vector<std::uint64_t> readOffsets(paths.size(), 0);
+    jobs.ParallelFor(paths.size(), 4, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t fileIndex = begin; fileIndex < end; ++fileIndex) {
+            std::uint64_t fileSize = 0;
+            descriptors[fileIndex] = OpenForRead(paths[fileIndex], fileSize);
+            if (descriptors[fileIndex] >= 0) {
+                outFiles[fileIndex].bytes.resize(static_cast<std::size_t>(fileSize));
+            }
+        }
+    });
+
+    auto finishFile = [&](std::size_t fileIndex, bool succeeded) {
+        FileReadResult& file = outFiles[fileIndex];
+        if (descriptors[fileIndex] >= 0) {
+            close(descriptors[fileIndex]);
+            descriptors[fileIndex] = -1;
+        }
+        file.succeeded = succeeded;
+        if (!succeeded) {
+            file.bytes.clear();
+            file.error = ReadError(paths[fileIndex]);
+        }
+        statistics.bytesRead += file.bytes.size();
+        if (onFileReady) {
+            onFileReady(fileIndex);
+        }
+    };
+
+    std::deque<std::size_t> queuedFiles;
+    std::size_t readsInFlight = 0;
+    std::vector<iovec> buffers;
+    std::vector<unsigned> bufferIndices(paths.size(), 0);
+    bool buffersFit = true;
+    for (std::size_t fileIndex = 0; fileIndex < paths.size(); ++fileIndex) {
+        FileReadResult& file = outFiles[fileIndex];
+        if (descriptors[fileIndex] < 0) {
+            file.error = OpenError(paths[fileIndex]);
+            if (onFileReady) {
+                onFileReady(fileIndex);
+            }
+        } else if (file.bytes.empty()) {
+            finishFile(fileIndex, true);
+        } else {
+            buffersFit = buffersFit && file.bytes.size() <= kMaxReadBytes;
+            bufferIndices[fileIndex] = static_cast<unsigned>(buffers.size());
+            buffers.push_back(iovec{file.bytes.data(), file.bytes.size()});
+            queuedFiles.push_back(fileIndex);
+        }
+    }
+
+    statistics.registeredBuffers =
+        !buffers.empty() && buffersFit && buffers.size() <= kMaxRegisteredBuffers && ring.RegisterBuffers(buffers);
+
+    std::vector<bool> readQueued(paths.size(), false);
+    auto handleCompletion = [&](const io_uring_cqe& completion) {
+        const std::size_t fileIndex = static_cast<std::size_t>(completion.user_data);
+        readQueued[fileIndex] = false;
+        --readsInFlight;
+        if (completion.res == -EINTR || completion.res == -EAGAIN) {
+            queuedFiles.push_back(fileIndex);
+        } else if (completion.res == -EINVAL || completion.res == -EOPNOTSUPP) {
+            // Kernels older than 5.6 lack IORING_OP_READ.
+            finishFile(fileIndex, ReadRemaining(descriptors[fileIndex], outFiles[fileIndex].bytes, readOffsets[fileIndex]));
+        } else if (completion.res <= 0) {
+            finishFile(fileIndex, false);
+        } else {
+            readOffsets[fileIndex] += static_cast<std::uint64_t>(completion.res);
+            if (readOffsets[fileIndex] < outFiles[fileIndex].bytes.size()) {
+                queuedFiles.push_back(fileIndex);
+            } else {
+                finishFile(fileIndex, true);
+            }
+        }
+    };
+
+    while (!queuedFiles.empty() || readsInFlight > 0) {
+        while (!queuedFiles.empty()) {
+            io_uring_sqe* entry = ring.AcquireEntry();
+            if (!entry) {
+                break;
+            }
+
+            const std::size_t fileIndex = queuedFiles.front();
+            queuedFiles.pop_front();
+            std::vector<std::byte>& bytes = outFiles[fileIndex].bytes;
+            const std::uint64_t offset = readOffsets[fileIndex];
+            entry->opcode = statistics.registeredBuffers ? IORING_OP_READ_FIXED : IORING_OP_READ;
+            entry->fd = descriptors[fileIndex];
+            entry->addr = reinterpret_cast<std::uint64_t>(bytes.data() + offset);
+            entry->len = static_cast<std::uint32_t>(std::min<std::uint64_t>(bytes.size() - offset, kMaxReadBytes));
+            entry->off = offset;
+            entry->buf_index = static_cast<std::uint16_t>(bufferIndices[fileIndex]);
+            entry->user_data = fileIndex;
+            readQueued[fileIndex] = true;
+            ++readsInFlight;
+        }
+
+        ++statistics.submitCalls;
+        if (!ring.SubmitAndWait(1)) {
+            // The ring is unusable. Reads the kernel already took may still be writing into their
+            // buffers, so wait for them before finishing every file still open with pread.
+            std::size_t submittedReads = readsInFlight - ring.GetUnsubmittedCount();
+            while (submittedReads > 0 && ring.WaitForCompletions(1)) {
+                const std::size_t before = readsInFlight;
+                ring.DrainCompletions(handleCompletion);
+                submittedReads -= std::min(submittedReads, before - readsInFlight);
+            }
+            for (std::size_t fileIndex = 0; fileIndex < paths.size(); ++fileIndex) {
+                if (descriptors[fileIndex] < 0) {
+                    continue;
+                }
+                if (readQueued[fileIndex] && submittedReads > 0) {
+                    // Waiting failed too: the kernel may still write into this buffer, so the
+                    // file gets a fresh one and the old one is deliberately never freed.
+                    std::vector<std::byte>& bytes = outFiles[fileIndex].bytes;
+                    new std::vector<std::byte>(std::exchange(bytes, std::vector<std::byte>(bytes.size())));
+                    readOffsets[fileIndex] = 0;
+                }
+                finishFile(fileIndex, ReadRemaining(descriptors[fileIndex], outFiles[fileIndex].bytes, readOffsets[fileIndex]));
+            }
+            break;
+        }
+
+        ring.DrainCompletions(handleCompletion);
+    }
+    return true;
+}
+#endif
+}
+
+void ReadFileBatch(
+    JobSystem& jobs,
+    const std::vector<std::filesystem::path>& paths,
+    std::vector<FileReadResult>& outFiles,
+    const FileReadyCallback& onFileReady,
+    FileReadBackend backend,
+    FileBatchStatistics* outStatistics) {
+    outFiles.assign(paths.size(), FileReadResult{false, {}, {}});
+    FileBatchStatistics statistics{FileReadBackend::ThreadPool, paths.size(), 0, 0, false};
+    if (backend != FileReadBackend::ThreadPool && !paths.empty() && IsIoUringAvailable()) {
+#if defined(__linux__)
+        statistics.backend = FileReadBackend::IoUring;
+        if (!ReadBatchWithIoUring(jobs, paths, outFiles, onFileReady, statistics)) {
+            statistics = FileBatchStatistics{FileReadBackend::ThreadPool, paths.size(), 0, 0, false};
+        }
+#endif
+    }
+
+    if (statistics.backend == FileReadBackend::ThreadPool) {
+        std::atomic<std::uint64_t> bytesRead{0};
+        ReadBatchWithThreadPool(jobs, paths, outFiles, onFileReady, bytesRead);
+        statistics.bytesRead = bytesRead.load();
+    }
+
+    if (outStatistics) {
+        *outStatistics = statistics;
+    }
+}
+
+bool IsIoUringAvailable() {
+#if defined(__linux__)
+    // Containers and seccomp profiles often block io_uring_setup even on new kernels.
+    static const bool available = []() {
+        IoUringQueue probe;
+        return probe.Initialize(1);
+    }();
+    return available;
+#else
+    return false;
+#endif
+}
+
+const char* GetFileReadBackendName(FileReadBackend backend) noexcept {
+    switch (backend) {
+    case FileReadBackend::IoUring:
+        return "io_uring";
+    case FileReadBackend::ThreadPool:
+        return "Thread pool";
+    default:
+        return "Automatic";
+    }
+}
+}
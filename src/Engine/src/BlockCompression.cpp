@@ -0,0 +1,393 @@
+#include "Engine/BlockCompression.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <limits>
+
+#include "Engine/JobSystem.hpp"
+
+namespace engine {
+namespace {
+constexpr std::size_t kPayloadHeaderSize = sizeof(std::uint64_t) + sizeof(std::uint32_t) + 4;
+constexpr std::uint32_t kStoredRawFlag = 0x80000000u;
+constexpr std::size_t kMinMatchLength = 4;
+constexpr std::size_t kMaxMatchOffset = 65535;
+constexpr std::uint32_t kHashBits = 14;
+// No token stream produces more than this many raw bytes per stored byte: a match costs at least
+// three bytes for up to 18 raw ones, and each further length byte adds at most 255.
+constexpr std::uint64_t kMaxLzExpansion = 255;
+
+// Sizes and offsets of every block, parsed from the payload header and block table.
+struct PayloadLayout {
+    std::uint64_t rawSize;
+    BlockFilter filter;
+    std::vector<std::uint32_t> storedWords;
+    std::vector<std::uint64_t> storedOffsets;
+    std::uint64_t storedBytes;
+};
+
+std::uint32_t LoadWord(const std::byte* bytes) {
+    std::uint32_t value;
+    std::memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+void StoreWord(std::byte* bytes, std::uint32_t value) {
+    std::memcpy(bytes, &value, sizeof(value));
+}
+
+std::uint32_t HashWord(std::uint32_t word) {
+    return (word * 2654435761u) >> (32 - kHashBits);
+}
+
+void ApplyFilter(const std::byte* input, std::byte* output, std::size_t size, BlockFilter filter) {
+    const std::size_t wordCount = size / 4;
+    std::uint32_t previous = 0;
+    for (std::size_t word = 0; word < wordCount; ++word) {
+        std::uint32_t value = LoadWord(input + word * 4);
+        if (filter == BlockFilter::Delta32) {
+            const std::uint32_t current = value;
+            value -= previous;
+            previous = current;
+        }
+        for (std::size_t plane = 0; plane < 4; ++plane) {
+            output[plane * wordCount + word] = static_cast<std::byte>(value >> (plane * 8));
+        }
+    }
+    std::memcpy(output + wordCount * 4, input + wordCount * 4, size - wordCount * 4);
+}
+
+void RemoveFilter(const std::byte* input, std::byte* output, std::size_t size, BlockFilter filter) {
+    const std::size_t wordCount = size / 4;
+    std::uint32_t previous = 0;
+    for (std::size_t word = 0; word < wordCount; ++word) {
+        std::uint32_t value = 0;
+        for (std::size_t plane = 0; plane < 4; ++plane) {
+            value |= static_cast<std::uint32_t>(input[plane * wordCount + word]) << (plane * 8);
+        }
+        if (filter == BlockFilter::Delta32) {
+            value += previous;
+            previous = value;
+        }
+        StoreWord(output + word * 4, value);
+    }
+    std::memcpy(output + wordCount * 4, input + wordCount * 4, size - wordCount * 4);
+}
+
+void WriteLength(std::vector<std::byte>& output, std::size_t length) {
+    for (; length >= 255; length -= 255) {
+        output.push_back(std::byte{255});
+    }
+    output.push_back(static_cast<std::byte>(length));
+}
+
+void WriteSequence(
+    std::vector<std::byte>& output,
+    const std::byte* literals,
+    std::size_t literalLength,
+    std::size_t matchOffset,
+    std::size_t matchLength) {
+    const std::size_t matchCode = matchLength == 0 ? 0 : matchLength - kMinMatchLength;
+    output.push_back(static_cast<std::byte>((std::min<std::size_t>(literalLength, 15) << 4) | std::min<std::size_t>(matchCode, 15)));
+    if (literalLength >= 15) {
+        WriteLength(output, literalLength - 15);
+    }
+    output.insert(output.end(), literals, literals + literalLength);
+    if (matchLength == 0) {
+        return;
+    }
+
+    output.push_back(static_cast<std::byte>(matchOffset & 0xff));
+    output.push_back(static_cast<std::byte>(matchOffset >> 8));
+    if (matchCode >= 15) {
+        WriteLength(output, matchCode - 15);
+    }
+}
+
+// LZ77 with an LZ4-style token stream: literal run, 16-bit back offset, match length. The final
+// sequence carries literals only; the decoder stops once it has produced the block's raw size.
+void CompressLz(const std::byte* input, std::size_t size, std::vector<std::uint32_t>& hashTable, std::vector<std::byte>& output) {
+    std::fill(hashTable.begin(), hashTable.end(), 0xffffffffu);
+    std::size_t anchor = 0;
+    std::size_t position = 0;
+    while (position + kMinMatchLength <= size) {
+        const std::uint32_t word = LoadWord(input + position);
+        std::uint32_t& slot = hashTable[HashWord(word)];
+        const std::uint32_t candidate = slot;
+        slot = static_cast<std::uint32_t>(position);
+        if (candidate == 0xffffffffu || position - candidate > kMaxMatchOffset || LoadWord(input + candidate) != word) {
+            // Skip faster through data that does not match.
+            position += 1 + ((position - anchor) >> 6);
+            continue;
+        }
+
+        std::size_t matchLength = kMinMatchLength;
+        while (position + matchLength < size && input[candidate + matchLength] == input[position + matchLength]) {
+            ++matchLength;
+        }
+        WriteSequence(output, input + anchor, position - anchor, position - candidate, matchLength);
+        position += matchLength;
+        anchor = position;
+    }
+
+    if (anchor < size) {
+        WriteSequence(output, input + anchor, size - anchor, 0, 0);
+    }
+}
+
+bool ReadLength(const std::byte* input, std::size_t size, std::size_t& cursor, std::size_t& length) {
+    for (;;) {
+        if (cursor >= size) {
+            return false;
+        }
+        const std::size_t value = static_cast<std::size_t>(input[cursor++]);
+        length += value;
+        if (value != 255) {
+            return true;
+        }
+    }
+}
+
+bool DecompressLz(const std::byte* input, std::size_t size, std::byte* output, std::size_t rawSize) {
+    std::size_t cursor = 0;
+    std::size_t written = 0;
+    while (written < rawSize) {
+        if (cursor >= size) {
+            return false;
+        }
+
+        const std::size_t token = static_cast<std::size_t>(input[cursor++]);
+        std::size_t literalLength = token >> 4;
+        if (literalLength == 15 && !ReadLength(input, size, cursor, literalLength)) {
+            return false;
+        }
+        if (literalLength > size - cursor || literalLength > rawSize - written) {
+            return false;
+        }
+        std::memcpy(output + written, input + cursor, literalLength);
+        cursor += literalLength;
+        written += literalLength;
+        if (written == rawSize) {
+            break;
+        }
+
+        if (size - cursor < 2) {
+            return false;
+        }
+        const std::size_t matchOffset =
+            static_cast<std::size_t>(input[cursor]) | (static_cast<std::size_t>(input[cursor + 1]) << 8);
+        cursor += 2;
+        std::size_t matchLength = (token & 15) + kMinMatchLength;
+        if (matchLength == 15 + kMinMatchLength && !ReadLength(input, size, cursor, matchLength)) {
+            return false;
+        }
+        if (matchOffset == 0 || matchOffset > written || matchLength > rawSize - written) {
+            return false;
+        }
+
+        const std::byte* source = output + written - matchOffset;
+        if (matchOffset >= matchLength) {
+            std::memcpy(output + written, source, matchLength);
+        } else {
+            for (std::size_t index = 0; index < matchLength; ++index) {
+                output[written + index] = source[index];
+            }
+        }
+        written += matchLength;
+    }
+    return cursor == size;
+}
+
+std::size_t GetRawBlockSize(std::uint64_t rawSize, std::size_t blockIndex) {
+    return static_cast<std::size_t>(
+        std::min<std::uint64_t>(kCompressionBlockSize, rawSize - static_cast<std::uint64_t>(blockIndex) * kCompressionBlockSize));
+}
+
+bool ParseHeader(const std::byte* header, std::uint64_t maxRawSize, PayloadLayout& outLayout, std::uint32_t& outBlockCount) {
+    std::memcpy(&outLayout.rawSize, header, sizeof(outLayout.rawSize));
+    std::memcpy(&outBlockCount, header + sizeof(std::uint64_t), sizeof(outBlockCount));
+    const std::uint8_t filter = static_cast<std::uint8_t>(header[sizeof(std::uint64_t) + sizeof(std::uint32_t)]);
+    outLayout.filter = static_cast<BlockFilter>(filter);
+    const std::uint64_t expectedBlocks =
+        outLayout.rawSize / kCompressionBlockSize + (outLayout.rawSize % kCompressionBlockSize != 0 ? 1 : 0);
+    return filter <= static_cast<std::uint8_t>(BlockFilter::Delta32) && outLayout.rawSize <= maxRawSize &&
+        outLayout.rawSize <= std::numeric_limits<std::size_t>::max() && expectedBlocks == outBlockCount;
+}
+
+bool ParseBlockTable(const std::byte* table, std::uint32_t blockCount, PayloadLayout& layout) {
+    layout.storedWords.resize(blockCount);
+    layout.storedOffsets.resize(blockCount);
+    layout.storedBytes = 0;
+    for (std::uint32_t block = 0; block < blockCount; ++block) {
+        layout.storedWords[block] = LoadWord(table + block * sizeof(std::uint32_t));
+        const std::uint32_t storedSize = layout.storedWords[block] & ~kStoredRawFlag;
+        const bool storedRaw = (layout.storedWords[block] & kStoredRawFlag) != 0;
+        const std::size_t rawBlockSize = GetRawBlockSize(layout.rawSize, block);
+        if (storedRaw ? storedSize != rawBlockSize : rawBlockSize > storedSize * kMaxLzExpansion) {
+            return false;
+        }
+        layout.storedOffsets[block] = layout.storedBytes;
+        layout.storedBytes += storedSize;
+    }
+    return true;
+}
+
+bool DecodeBlock(
+    const PayloadLayout& layout,
+    std::size_t blockIndex,
+    const std::byte* storedData,
+    std::byte* output,
+    std::vector<std::byte>& scratch) {
+    const std::uint32_t storedWord = layout.storedWords[blockIndex];
+    const std::size_t storedSize = storedWord & ~kStoredRawFlag;
+    const std::byte* stored = storedData + layout.storedOffsets[blockIndex];
+    std::byte* blockOutput = output + blockIndex * kCompressionBlockSize;
+    const std::size_t rawBlockSize = GetRawBlockSize(layout.rawSize, blockIndex);
+    if ((storedWord & kStoredRawFlag) != 0) {
+        std::memcpy(blockOutput, stored, rawBlockSize);
+        return true;
+    }
+
+    if (layout.filter == BlockFilter::None) {
+        return DecompressLz(stored, storedSize, blockOutput, rawBlockSize);
+    }
+
+    scratch.resize(rawBlockSize);
+    if (!DecompressLz(stored, storedSize, scratch.data(), rawBlockSize)) {
+        return false;
+    }
+    RemoveFilter(scratch.data(), blockOutput, rawBlockSize, layout.filter);
+    return true;
+}
+}
+
+void CompressBlocks(const std::byte* data, std::size_t size, BlockFilter filter, std::vector<std::byte>& outCompressed) {
+    const std::size_t blockCount = (size + kCompressionBlockSize - 1) / kCompressionBlockSize;
+    outCompressed.assign(kPayloadHeaderSize + blockCount * sizeof(std::uint32_t), std::byte{0});
+    const std::uint64_t rawSize = size;
+    const std::uint32_t blockCountWord = static_cast<std::uint32_t>(blockCount);
+    std::memcpy(outCompressed.data(), &rawSize, sizeof(rawSize));
+    std::memcpy(outCompressed.data() + sizeof(rawSize), &blockCountWord, sizeof(blockCountWord));
+    outCompressed[sizeof(rawSize) + sizeof(blockCountWord)] = static_cast<std::byte>(filter);
+
+    std::vector<std::uint32_t> hashTable(std::size_t{1} << kHashBits);
+    std::vector<std::byte> filtered;
+    for (std::size_t block = 0; block < blockCount; ++block) {
+        const std::byte* blockData = data + block * kCompressionBlockSize;
+        const std::size_t rawBlockSize = GetRawBlockSize(size, block);
+        const std::byte* lzInput = blockData;
+        if (filter != BlockFilter::None) {
+            filtered.resize(rawBlockSize);
+            ApplyFilter(blockData, filtered.data(), rawBlockSize, filter);
+            lzInput = filtered.data();
+        }
+
+        const std::size_t blockStart = outCompressed.size();
+        CompressLz(lzInput, rawBlockSize, hashTable, outCompressed);
+        std::uint32_t storedWord = static_cast<std::uint32_t>(outCompressed.size() - blockStart);
+        if (storedWord >= rawBlockSize) {
+            outCompressed.resize(blockStart);
+            outCompressed.insert(outCompressed.end(), blockData, blockData + rawBlockSize);
+            storedWord = static_cast<std::uint32_t>(rawBlockSize) | kStoredRawFlag;
+        }
+        StoreWord(outCompressed.data() + kPayloadHeaderSize + block * sizeof(std::uint32_t), storedWord);
+    }
+}
+
+bool DecompressBlocks(
+    JobSystem& jobs,
+    const std::byte* data,
+    std::size_t size,
+    std::uint64_t maxRawSize,
+    std::vector<std::byte>& outData,
+    std::string& outError) {
+    PayloadLayout layout{};
+    std::uint32_t blockCount = 0;
+    if (size < kPayloadHeaderSize || !ParseHeader(data, maxRawSize, layout, blockCount) ||
+        blockCount > (size - kPayloadHeaderSize) / sizeof(std::uint32_t) ||
+        !ParseBlockTable(data + kPayloadHeaderSize, blockCount, layout) ||
+        layout.storedBytes != size - kPayloadHeaderSize - blockCount * sizeof(std::uint32_t)) {
+        outError = "Compressed payload header is corrupt.";
+        return false;
+    }
+
+    outData.resize(static_cast<std::size_t>(layout.rawSize));
+    const std::byte* storedData = data + kPayloadHeaderSize + blockCount * sizeof(std::uint32_t);
+    std::atomic<bool> failed{false};
+    jobs.ParallelFor(blockCount, 1, [&](std::size_t begin, std::size_t end) {
+        std::vector<std::byte> scratch;
+        for (std::size_t block = begin; block < end; ++block) {
+            if (!DecodeBlock(layout, block, storedData, outData.data(), scratch)) {
+                failed.store(true, std::memory_order_relaxed);
+            }
+        }
+    });
+    if (failed.load(std::memory_order_relaxed)) {
+        outError = "Compressed payload block is corrupt.";
+        return false;
+    }
+    return true;
+}
+
+bool ReadCompressedBlocks(
+    JobSystem& jobs,
+    std::istream& input,
+    std::uint64_t size,
+    std::uint64_t maxRawSize,
+    std::vector<std::byte>& outData,
+    std::string& outError) {
+    std::byte header[kPayloadHeaderSize];
+    PayloadLayout layout{};
+    std::uint32_t blockCount = 0;
+    if (size < kPayloadHeaderSize || !input.read(reinterpret_cast<char*>(header), sizeof(header)) ||
+        !ParseHeader(header, maxRawSize, layout, blockCount) ||
+        blockCount > (size - kPayloadHeaderSize) / sizeof(std::uint32_t)) {
+        outError = "Compressed payload header is corrupt.";
+        return false;
+    }
+
+    std::vector<std::byte> table(blockCount * sizeof(std::uint32_t));
+    if (!input.read(reinterpret_cast<char*>(table.data()), static_cast<std::streamsize>(table.size())) ||
+        !ParseBlockTable(table.data(), blockCount, layout) ||
+        layout.storedBytes != size - kPayloadHeaderSize - table.size()) {
+        outError = "Compressed payload block table is corrupt.";
+        return false;
+    }
+
+    // Each block is handed to the job system as soon as it has been read, so decoding overlaps the
+    // rest of the read. The calling thread helps decode once the read is done.
+    outData.resize(static_cast<std::size_t>(layout.rawSize));
+    std::vector<std::byte> stored(static_cast<std::size_t>(layout.storedBytes));
+    std::atomic<std::size_t> pendingBlocks{0};
+    std::atomic<bool> failed{false};
+    bool readFailed = false;
+    for (std::uint32_t block = 0; block < blockCount && !readFailed; ++block) {
+        const std::size_t storedSize = layout.storedWords[block] & ~kStoredRawFlag;
+        if (!input.read(reinterpret_cast<char*>(stored.data() + layout.storedOffsets[block]), static_cast<std::streamsize>(storedSize))) {
+            readFailed = true;
+            break;
+        }
+
+        pendingBlocks.fetch_add(1, std::memory_order_relaxed);
+        jobs.Schedule([&layout, &stored, &outData, &pendingBlocks, &failed, block]() {
+            thread_local std::vector<std::byte> scratch;
+            if (!DecodeBlock(layout, block, stored.data(), outData.data(), scratch)) {
+                failed.store(true, std::memory_order_relaxed);
+            }
+            pendingBlocks.fetch_sub(1, std::memory_order_acq_rel);
+        });
+    }
+    jobs.WaitUntil([&pendingBlocks]() { return pendingBlocks.load(std::memory_order_acquire) == 0; });
+
+    if (readFailed) {
+        outError = "Compressed payload is truncated.";
+        return false;
+    }
+    if (failed.load(std::memory_order_relaxed)) {
+        outError = "Compressed payload block is corrupt.";
+        return false;
+    }
+    return true;
+}
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "Engine/ModelData.hpp"
+
+namespace engine {
+// Little helpers for the engine's binary cache formats. Values are written in host byte order;
+// the files are caches, not interchange formats.
+class ByteWriter {
+public:
+    explicit ByteWriter(std::vector<std::byte>& bytes)
+        : bytes_(bytes) {
+    }
+
+    template <typename T>
+    void Write(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        WriteBytes(&value, sizeof(T));
+    }
+
+    void WriteBytes(const void* data, std::size_t size) {
+        const auto* first = static_cast<const std::byte*>(data);
+        bytes_.insert(bytes_.end(), first, first + size);
+    }
+
+    void WriteString(const std::string& text) {
+        Write(static_cast<std::uint32_t>(text.size()));
+        WriteBytes(text.data(), text.size());
+    }
+
+private:
+    std::vector<std::byte>& bytes_;
+};
+
+class ByteReader {
+public:
+    ByteReader(const std::byte* data, std::size_t size)
+        : data_(data),
+          size_(size),
+          cursor_(0),
+          failed_(false) {
+    }
+
+    template <typename T>
+    T Read() {
+        static_assert(std::is_trivially_copyable_v<T>);
+        T value{};
+        ReadBytes(&value, sizeof(T));
+        return value;
+    }
+
+    void ReadBytes(void* destination, std::size_t size) {
+        if (failed_ || size > size_ - cursor_) {
+            failed_ = true;
+            return;
+        }
+        if (size > 0) {
+            std::memcpy(destination, data_ + cursor_, size);
+        }
+        cursor_ += size;
+    }
+
+    std::string ReadString() {
+        const std::uint32_t length = Read<std::uint32_t>();
+        if (failed_ || length > size_ - cursor_) {
+            failed_ = true;
+            return {};
+        }
+        std::string text(reinterpret_cast<const char*>(data_ + cursor_), length);
+        cursor_ += length;
+        return text;
+    }
+
+    // Reads a u64 element count and checks that `elementSize` bytes per element remain.
+    std::size_t ReadCount(std::size_t elementSize) {
+        const std::uint64_t count = Read<std::uint64_t>();
+        if (failed_ || (elementSize > 0 && count > (size_ - cursor_) / elementSize)) {
+            failed_ = true;
+            return 0;
+        }
+        return static_cast<std::size_t>(count);
+    }
+
+    [[nodiscard]] bool Failed() const noexcept {
+        return failed_;
+    }
+
+private:
+    const std::byte* data_;
+    std::size_t size_;
+    std::size_t cursor_;
+    bool failed_;
+};
+
+inline void WriteModelMaterials(ByteWriter& writer, const std::vector<ModelMaterial>& materials) {
+    writer.Write(static_cast<std::uint64_t>(materials.size()));
+    for (const ModelMaterial& material : materials) {
+        writer.Write(material.textureIndex);
+        writer.Write(material.opacityTextureIndex);
+        writer.Write(material.normalTextureIndex);
+        writer.Write(material.emissiveTextureIndex);
+        writer.Write(material.specularTextureIndex);
+        writer.Write(material.opacity);
+        writer.Write(material.alphaCutoff);
+        writer.Write(static_cast<std::uint8_t>(material.isTransparent));
+        writer.Write(static_cast<std::uint8_t>(material.alphaCutoutEnabled));
+        writer.Write(static_cast<std::uint8_t>(material.opacityTextureInverted));
+    }
+}
+
+inline bool ReadModelMaterials(ByteReader& reader, std::vector<ModelMaterial>& outMaterials) {
+    constexpr std::size_t kMaterialBytes = 5 * sizeof(std::int32_t) + 2 * sizeof(float) + 3;
+    const std::size_t count = reader.ReadCount(kMaterialBytes);
+    outMaterials.clear();
+    outMaterials.reserve(count);
+    for (std::size_t materialIndex = 0; materialIndex < count; ++materialIndex) {
+        ModelMaterial material{};
+        material.textureIndex = reader.Read<std::int32_t>();
+        material.opacityTextureIndex = reader.Read<std::int32_t>();
+        material.normalTextureIndex = reader.Read<std::int32_t>();
+        material.emissiveTextureIndex = reader.Read<std::int32_t>();
+        material.specularTextureIndex = reader.Read<std::int32_t>();
+        material.opacity = reader.Read<float>();
+        material.alphaCutoff = reader.Read<float>();
+        material.isTransparent = reader.Read<std::uint8_t>() != 0;
+        material.alphaCutoutEnabled = reader.Read<std::uint8_t>() != 0;
+        material.opacityTextureInverted = reader.Read<std::uint8_t>() != 0;
+        outMaterials.push_back(material);
+    }
+    return !reader.Failed();
+}
+}
@@ -0,0 +1,803 @@
+#include "Engine/ChunkedMesh.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <system_error>
+#include <utility>
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
+
+#include "ByteStream.hpp"
+
+namespace engine {
+namespace {
+constexpr char kChunkedMeshMagic[4] = {'E', 'M', 'C', 'K'};
+constexpr std::uint32_t kChunkedMeshVersion = 1;
+constexpr std::size_t kHeaderSizeOffset = sizeof(kChunkedMeshMagic) + sizeof(std::uint32_t);
+constexpr std::uint32_t kMaxHeaderSize = 64u << 20;
+constexpr std::uint32_t kHasTexCoordsFlag = 1u;
+// Triangles per chunk are capped so three unshared vertices per triangle still fit 16-bit indices.
+constexpr std::uint32_t kMaxTrianglesPerChunk = 65535u / 3u;
+constexpr std::uint64_t kNoKey = std::numeric_limits<std::uint64_t>::max();
+
+struct ChunkGeometry {
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec2> texCoords;
+    std::vector<std::uint16_t> indices;
+};
+
+struct BuiltChunk {
+    MeshChunkInfo info;
+    std::vector<ChunkGeometry> lods;
+    std::vector<float> lodErrors;
+};
+
+void ExpandBounds(glm::vec3& boundsMin, glm::vec3& boundsMax, const glm::vec3& point) {
+    boundsMin = glm::min(boundsMin, point);
+    boundsMax = glm::max(boundsMax, point);
+}
+
+// Median split along the longest centroid axis until every leaf fits `maxTriangles`.
+void PartitionTriangles(
+    std::vector<std::uint32_t>::iterator first,
+    std::vector<std::uint32_t>::iterator last,
+    const std::vector<glm::vec3>& centroids,
+    std::uint32_t maxTriangles,
+    std::vector<std::vector<std::uint32_t>>& outLeaves) {
+    const std::size_t count = static_cast<std::size_t>(std::distance(first, last));
+    if (count <= maxTriangles) {
+        outLeaves.emplace_back(first, last);
+        return;
+    }
+
+    glm::vec3 boundsMin(std::numeric_limits<float>::max());
+    glm::vec3 boundsMax(std::numeric_limits<float>::lowest());
+    for (auto it = first; it != last; ++it) {
+        ExpandBounds(boundsMin, boundsMax, centroids[*it]);
+    }
+
+    const glm::vec3 extent = boundsMax - boundsMin;
+    const int axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+    const auto middle = first + static_cast<std::ptrdiff_t>(count / 2);
+    std::nth_element(first, middle, last, [&centroids, axis](std::uint32_t left, std::uint32_t right) {
+        return centroids[left][axis] < centroids[right][axis];
+    });
+    PartitionTriangles(first, middle, centroids, maxTriangles, outLeaves);
+    PartitionTriangles(middle, last, centroids, maxTriangles, outLeaves);
+}
+
+ChunkGeometry ExtractChunk(const ModelData& model, const std::vector<std::uint32_t>& triangles, bool hasTexCoords) {
+    ChunkGeometry geometry;
+    std::unordered_map<std::uint32_t, std::uint16_t> localVertices;
+    localVertices.reserve(triangles.size() * 2);
+    geometry.indices.reserve(triangles.size() * 3);
+    for (const std::uint32_t triangle : triangles) {
+        for (std::uint32_t corner = 0; corner < 3; ++corner) {
+            const std::uint32_t vertex = model.indices[static_cast<std::size_t>(triangle) * 3 + corner];
+            const auto [it, inserted] = localVertices.emplace(vertex, static_cast<std::uint16_t>(geometry.positions.size()));
+            if (inserted) {
+                geometry.positions.push_back(model.positions[vertex]);
+                if (hasTexCoords) {
+                    geometry.texCoords.push_back(model.texCoords[vertex]);
+                }
+            }
+            geometry.indices.push_back(it->second);
+        }
+    }
+    return geometry;
+}
+
+// Vertex clustering: vertices sharing a grid cell collapse to their average and triangles that
+// become degenerate are dropped. Returns the largest distance a vertex moved.
+float SimplifyChunk(
+    const ChunkGeometry& source,
+    const glm::vec3& boundsMin,
+    float cellSize,
+    bool hasTexCoords,
+    ChunkGeometry& outGeometry) {
+    std::unordered_map<std::uint64_t, std::uint16_t> clusters;
+    std::vector<std::uint16_t> remap(source.positions.size());
+    std::vector<std::uint32_t> clusterSizes;
+    outGeometry = ChunkGeometry{};
+    for (std::size_t vertex = 0; vertex < source.positions.size(); ++vertex) {
+        const glm::vec3 cell = glm::floor((source.positions[vertex] - boundsMin) / cellSize);
+        const std::uint64_t key = static_cast<std::uint64_t>(std::max(cell.x, 0.0f)) |
+            (static_cast<std::uint64_t>(std::max(cell.y, 0.0f)) << 21) |
+            (static_cast<std::uint64_t>(std::max(cell.z, 0.0f)) << 42);
+        const auto [it, inserted] = clusters.emplace(key, static_cast<std::uint16_t>(outGeometry.positions.size()));
+        if (inserted) {
+            outGeometry.positions.push_back(glm::vec3(0.0f));
+            if (hasTexCoords) {
+                outGeometry.texCoords.push_back(glm::vec2(0.0f));
+            }
+            clusterSizes.push_back(0);
+        }
+        remap[vertex] = it->second;
+        outGeometry.positions[it->second] += source.positions[vertex];
+        if (hasTexCoords) {
+            outGeometry.texCoords[it->second] += source.texCoords[vertex];
+        }
+        ++clusterSizes[it->second];
+    }
+
+    for (std::size_t cluster = 0; cluster < clusterSizes.size(); ++cluster) {
+        const float scale = 1.0f / static_cast<float>(clusterSizes[cluster]);
+        outGeometry.positions[cluster] *= scale;
+        if (hasTexCoords) {
+            outGeometry.texCoords[cluster] *= scale;
+        }
+    }
+
+    float maxError = 0.0f;
+    for (std::size_t vertex = 0; vertex < source.positions.size(); ++vertex) {
+        maxError = std::max(maxError, glm::length(source.positions[vertex] - outGeometry.positions[remap[vertex]]));
+    }
+
+    for (std::size_t index = 0; index + 2 < source.indices.size(); index += 3) {
+        const std::uint16_t a = remap[source.indices[index]];
+        const std::uint16_t b = remap[source.indices[index + 1]];
+        const std::uint16_t c = remap[source.indices[index + 2]];
+        if (a != b && b != c && a != c) {
+            outGeometry.indices.insert(outGeometry.indices.end(), {a, b, c});
+        }
+    }
+    return maxError;
+}
+
+// Bytes a level occupies once decoded: its file payload minus the two count fields.
+std::size_t GetResidentByteSize(const MeshChunkLod& lod) {
+    return static_cast<std::size_t>(lod.byteSize - 2 * sizeof(std::uint32_t));
+}
+
+std::uint64_t GetLodByteSize(std::uint32_t vertexCount, std::uint32_t triangleCount, bool hasTexCoords) {
+    return 2 * sizeof(std::uint32_t) + static_cast<std::uint64_t>(vertexCount) * sizeof(glm::vec3) +
+        (hasTexCoords ? static_cast<std::uint64_t>(vertexCount) * sizeof(glm::vec2) : 0) +
+        static_cast<std::uint64_t>(triangleCount) * 3 * sizeof(std::uint16_t);
+}
+
+void WriteHeader(
+    ByteWriter& writer,
+    const ModelData& model,
+    bool hasTexCoords,
+    const glm::vec3& boundsMin,
+    const glm::vec3& boundsMax,
+    const std::vector<BuiltChunk>& chunks) {
+    writer.WriteBytes(kChunkedMeshMagic, sizeof(kChunkedMeshMagic));
+    writer.Write(kChunkedMeshVersion);
+    writer.Write(std::uint32_t{0});
+    writer.Write(hasTexCoords ? kHasTexCoordsFlag : 0u);
+    writer.Write(boundsMin);
+    writer.Write(boundsMax);
+    writer.WriteString(model.primaryTexturePath);
+    writer.Write(static_cast<std::uint64_t>(model.texturePaths.size()));
+    for (const std::string& texturePath : model.texturePaths) {
+        writer.WriteString(texturePath);
+    }
+    WriteModelMaterials(writer, model.materials);
+
+    writer.Write(static_cast<std::uint32_t>(chunks.size()));
+    for (const BuiltChunk& chunk : chunks) {
+        writer.Write(chunk.info.boundsMin);
+        writer.Write(chunk.info.boundsMax);
+        writer.Write(chunk.info.materialIndex);
+        writer.Write(chunk.info.lodCount);
+        for (const MeshChunkLod& lod : chunk.info.lods) {
+            writer.Write(lod.fileOffset);
+            writer.Write(lod.byteSize);
+            writer.Write(lod.vertexCount);
+            writer.Write(lod.triangleCount);
+            writer.Write(lod.geometricError);
+        }
+    }
+}
+
+bool DecodeChunk(const std::vector<std::byte>& bytes, bool hasTexCoords, ResidentMeshChunk& outChunk) {
+    ByteReader reader(bytes.data(), bytes.size());
+    const std::uint32_t vertexCount = reader.Read<std::uint32_t>();
+    const std::uint32_t triangleCount = reader.Read<std::uint32_t>();
+    if (reader.Failed() || GetLodByteSize(vertexCount, triangleCount, hasTexCoords) != bytes.size()) {
+        return false;
+    }
+
+    outChunk.positions.resize(vertexCount);
+    reader.ReadBytes(outChunk.positions.data(), vertexCount * sizeof(glm::vec3));
+    if (hasTexCoords) {
+        outChunk.texCoords.resize(vertexCount);
+        reader.ReadBytes(outChunk.texCoords.data(), vertexCount * sizeof(glm::vec2));
+    }
+    outChunk.indices.resize(static_cast<std::size_t>(triangleCount) * 3);
+    reader.ReadBytes(outChunk.indices.data(), outChunk.indices.size() * sizeof(std::uint16_t));
+    if (reader.Failed()) {
+        return false;
+    }
+
+    return std::all_of(outChunk.indices.begin(), outChunk.indices.end(), [vertexCount](std::uint16_t index) {
+        return index < vertexCount;
+    });
+}
+}
+
+bool WriteChunkedMesh(
+    const std::filesystem::path& path,
+    const ModelData& model,
+    const ChunkedMeshBuildOptions& options,
+    std::string& outError) {
+    if (!model.IsValid() || model.indices.size() % 3 != 0) {
+        outError = "Model has no triangle geometry to chunk.";
+        return false;
+    }
+
+    const bool hasTexCoords = model.texCoords.size() == model.positions.size();
+    const std::uint32_t maxTriangles = std::clamp(options.maxTrianglesPerChunk, 1u, kMaxTrianglesPerChunk);
+    const std::uint32_t lodCount = std::clamp(options.lodCount, 1u, kMaxMeshChunkLods);
+
+    std::vector<glm::vec3> centroids(model.indices.size() / 3);
+    for (std::size_t triangle = 0; triangle < centroids.size(); ++triangle) {
+        const std::uint32_t* corners = &model.indices[triangle * 3];
+        if (corners[0] >= model.positions.size() || corners[1] >= model.positions.size() ||
+            corners[2] >= model.positions.size()) {
+            outError = "Model index " + std::to_string(triangle * 3) + " is out of range.";
+            return false;
+        }
+        centroids[triangle] =
+            (model.positions[corners[0]] + model.positions[corners[1]] + model.positions[corners[2]]) / 3.0f;
+    }
+
+    // Chunks never straddle submeshes, so each one draws with a single material.
+    std::vector<ModelSubmesh> submeshes = model.submeshes;
+    if (submeshes.empty()) {
+        submeshes.push_back(ModelSubmesh{0, static_cast<std::uint32_t>(model.indices.size()), std::numeric_limits<std::uint32_t>::max()});
+    }
+
+    std::vector<BuiltChunk> chunks;
+    glm::vec3 boundsMin(std::numeric_limits<float>::max());
+    glm::vec3 boundsMax(std::numeric_limits<float>::lowest());
+    for (const ModelSubmesh& submesh : submeshes) {
+        std::vector<std::uint32_t> triangles(submesh.indexCount / 3);
+        for (std::size_t triangle = 0; triangle < triangles.size(); ++triangle) {
+            triangles[triangle] = submesh.indexStart / 3 + static_cast<std::uint32_t>(triangle);
+        }
+
+        std::vector<std::vector<std::uint32_t>> leaves;
+        PartitionTriangles(triangles.begin(), triangles.end(), centroids, maxTriangles, leaves);
+        for (const std::vector<std::uint32_t>& leaf : leaves) {
+            if (leaf.empty()) {
+                continue;
+            }
+
+            BuiltChunk chunk{};
+            chunk.info.materialIndex = submesh.materialIndex;
+            chunk.info.boundsMin = glm::vec3(std::numeric_limits<float>::max());
+            chunk.info.boundsMax = glm::vec3(std::numeric_limits<float>::lowest());
+            chunk.lods.push_back(ExtractChunk(model, leaf, hasTexCoords));
+            chunk.lodErrors.push_back(0.0f);
+            for (const glm::vec3& position : chunk.lods[0].positions) {
+                ExpandBounds(chunk.info.boundsMin, chunk.info.boundsMax, position);
+            }
+            ExpandBounds(boundsMin, boundsMax, chunk.info.boundsMin);
+            ExpandBounds(boundsMin, boundsMax, chunk.info.boundsMax);
+
+            const glm::vec3 extent = chunk.info.boundsMax - chunk.info.boundsMin;
+            const float longestAxis = std::max({extent.x, extent.y, extent.z, 1e-6f});
+            // A surface patch of n vertices spans about sqrt(n) of them per axis, so level 1 uses half
+            // that many grid cells to keep roughly a quarter of the vertices.
+            float gridCells = std::max(std::floor(std::sqrt(static_cast<float>(chunk.lods[0].positions.size()))) * 0.5f, 2.0f);
+            for (std::uint32_t lod = 1; lod < lodCount; ++lod, gridCells *= 0.5f) {
+                ChunkGeometry simplified;
+                const float error = SimplifyChunk(
+                    chunk.lods[0], chunk.info.boundsMin, longestAxis / gridCells, hasTexCoords, simplified);
+                if (simplified.indices.empty() || simplified.indices.size() >= chunk.lods.back().indices.size()) {
+                    break;
+                }
+                chunk.lods.push_back(std::move(simplified));
+                chunk.lodErrors.push_back(error);
+            }
+            chunk.info.lodCount = static_cast<std::uint32_t>(chunk.lods.size());
+            chunks.push_back(std::move(chunk));
+        }
+    }
+
+    // The header has a fixed size once the chunk count is known, so it is sized with placeholder
+    // offsets first and then rewritten with the real ones.
+    std::vector<std::byte> header;
+    {
+        ByteWriter sizingWriter(header);
+        WriteHeader(sizingWriter, model, hasTexCoords, boundsMin, boundsMax, chunks);
+    }
+    std::uint64_t offset = header.size();
+    for (BuiltChunk& chunk : chunks) {
+        for (std::uint32_t lod = 0; lod < chunk.info.lodCount; ++lod) {
+            const ChunkGeometry& geometry = chunk.lods[lod];
+            MeshChunkLod& lodInfo = chunk.info.lods[lod];
+            lodInfo.vertexCount = static_cast<std::uint32_t>(geometry.positions.size());
+            lodInfo.triangleCount = static_cast<std::uint32_t>(geometry.indices.size() / 3);
+            lodInfo.byteSize = GetLodByteSize(lodInfo.vertexCount, lodInfo.triangleCount, hasTexCoords);
+            lodInfo.fileOffset = offset;
+            lodInfo.geometricError = chunk.lodErrors[lod];
+            offset += lodInfo.byteSize;
+        }
+    }
+    header.clear();
+    ByteWriter headerWriter(header);
+    WriteHeader(headerWriter, model, hasTexCoords, boundsMin, boundsMax, chunks);
+    const std::uint32_t headerSize = static_cast<std::uint32_t>(header.size());
+    std::memcpy(header.data() + kHeaderSizeOffset, &headerSize, sizeof(headerSize));
+
+    std::error_code error;
+    if (path.has_parent_path()) {
+        std::filesystem::create_directories(path.parent_path(), error);
+    }
+
+    std::filesystem::path temporaryPath = path;
+    temporaryPath += ".tmp";
+    {
+        std::ofstream output(temporaryPath, std::ios::binary | std::ios::trunc);
+        if (!output) {
+            outError = "Could not open '" + temporaryPath.string() + "' for writing.";
+            return false;
+        }
+
+        output.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+        std::vector<std::byte> payload;
+        for (const BuiltChunk& chunk : chunks) {
+            for (const ChunkGeometry& geometry : chunk.lods) {
+                payload.clear();
+                ByteWriter payloadWriter(payload);
+                payloadWriter.Write(static_cast<std::uint32_t>(geometry.positions.size()));
+                payloadWriter.Write(static_cast<std::uint32_t>(geometry.indices.size() / 3));
+                payloadWriter.WriteBytes(geometry.positions.data(), geometry.positions.size() * sizeof(glm::vec3));
+                payloadWriter.WriteBytes(geometry.texCoords.data(), geometry.texCoords.size() * sizeof(glm::vec2));
+                payloadWriter.WriteBytes(geometry.indices.data(), geometry.indices.size() * sizeof(std::uint16_t));
+                output.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+            }
+        }
+
+        if (!output) {
+            outError = "Could not write chunked mesh '" + temporaryPath.string() + "'.";
+            return false;
+        }
+    }
+
+    std::filesystem::rename(temporaryPath, path, error);
+    if (error) {
+        std::filesystem::remove(temporaryPath, error);
+        outError = "Could not replace chunked mesh '" + path.string() + "'.";
+        return false;
+    }
+
+    outError.clear();
+    return true;
+}
+
+ChunkedMeshStream::ChunkedMeshStream()
+    : hasTexCoords_(false),
+      boundsMin_(0.0f),
+      boundsMax_(0.0f),
+      frameIndex_(0),
+      stats_{kDefaultBudgetBytes, 0, 0, 0, 0, 0, 0, 0},
+      inFlightKey_(kNoKey),
+      inFlightBytes_(0),
+      queuedBytes_(0) {
+}
+
+ChunkedMeshStream::~ChunkedMeshStream() {
+    Close();
+}
+
+bool ChunkedMeshStream::Open(const std::filesystem::path& path, std::size_t budgetBytes, std::string& outError) {
+    Close();
+
+    std::ifstream input(path, std::ios::binary);
+    if (!input) {
+        outError = "Could not open chunked mesh '" + path.string() + "'.";
+        return false;
+    }
+
+    input.seekg(0, std::ios::end);
+    const std::uint64_t fileSize = static_cast<std::uint64_t>(input.tellg());
+    input.seekg(0, std::ios::beg);
+
+    std::array<std::byte, kHeaderSizeOffset + sizeof(std::uint32_t)> prefix{};
+    input.read(reinterpret_cast<char*>(prefix.data()), static_cast<std::streamsize>(prefix.size()));
+    std::uint32_t version = 0;
+    std::uint32_t headerSize = 0;
+    std::memcpy(&version, prefix.data() + sizeof(kChunkedMeshMagic), sizeof(version));
+    std::memcpy(&headerSize, prefix.data() + kHeaderSizeOffset, sizeof(headerSize));
+    if (!input || std::memcmp(prefix.data(), kChunkedMeshMagic, sizeof(kChunkedMeshMagic)) != 0 ||
+        version != kChunkedMeshVersion) {
+        outError = "'" + path.string() + "' is not a chunked mesh of version " + std::to_string(kChunkedMeshVersion) + ".";
+        return false;
+    }
+
+    if (headerSize < prefix.size() || headerSize > kMaxHeaderSize || headerSize > fileSize) {
+        outError = "Chunked mesh '" + path.string() + "' has a corrupt header.";
+        return false;
+    }
+
+    std::vector<std::byte> header(headerSize - prefix.size());
+    input.read(reinterpret_cast<char*>(header.data()), static_cast<std::streamsize>(header.size()));
+    if (!input) {
+        outError = "Chunked mesh '" + path.string() + "' is truncated.";
+        return false;
+    }
+
+    ByteReader reader(header.data(), header.size());
+    const bool hasTexCoords = (reader.Read<std::uint32_t>() & kHasTexCoordsFlag) != 0;
+    const glm::vec3 boundsMin = reader.Read<glm::vec3>();
+    const glm::vec3 boundsMax = reader.Read<glm::vec3>();
+    std::string primaryTexturePath = reader.ReadString();
+    const std::size_t textureCount = reader.ReadCount(sizeof(std::uint32_t));
+    std::vector<std::string> texturePaths;
+    for (std::size_t textureIndex = 0; textureIndex < textureCount && !reader.Failed(); ++textureIndex) {
+        texturePaths.push_back(reader.ReadString());
+    }
+    std::vector<ModelMaterial> materials;
+    ReadModelMaterials(reader, materials);
+
+    const std::uint32_t chunkCount = reader.Read<std::uint32_t>();
+    std::vector<MeshChunkInfo> chunks;
+    bool chunksValid = !reader.Failed();
+    for (std::uint32_t chunkIndex = 0; chunkIndex < chunkCount && chunksValid; ++chunkIndex) {
+        MeshChunkInfo chunk{};
+        chunk.boundsMin = reader.Read<glm::vec3>();
+        chunk.boundsMax = reader.Read<glm::vec3>();
+        chunk.materialIndex = reader.Read<std::uint32_t>();
+        chunk.lodCount = reader.Read<std::uint32_t>();
+        for (MeshChunkLod& lod : chunk.lods) {
+            lod.fileOffset = reader.Read<std::uint64_t>();
+            lod.byteSize = reader.Read<std::uint64_t>();
+            lod.vertexCount = reader.Read<std::uint32_t>();
+            lod.triangleCount = reader.Read<std::uint32_t>();
+            lod.geometricError = reader.Read<float>();
+        }
+
+        chunksValid = !reader.Failed() && chunk.lodCount >= 1 && chunk.lodCount <= kMaxMeshChunkLods;
+        for (std::uint32_t lod = 0; lod < chunk.lodCount && chunksValid; ++lod) {
+            const MeshChunkLod& lodInfo = chunk.lods[lod];
+            chunksValid = lodInfo.vertexCount <= 65536u &&
+                lodInfo.byteSize == GetLodByteSize(lodInfo.vertexCount, lodInfo.triangleCount, hasTexCoords) &&
+                lodInfo.fileOffset >= headerSize && lodInfo.fileOffset <= fileSize &&
+                lodInfo.byteSize <= fileSize - lodInfo.fileOffset;
+        }
+        chunks.push_back(chunk);
+    }
+
+    if (!chunksValid) {
+        outError = "Chunked mesh '" + path.string() + "' has a corrupt chunk table.";
+        return false;
+    }
+
+    path_ = path;
+    hasTexCoords_ = hasTexCoords;
+    boundsMin_ = boundsMin;
+    boundsMax_ = boundsMax;
+    chunks_ = std::move(chunks);
+    materials_ = std::move(materials);
+    texturePaths_ = std::move(texturePaths);
+    primaryTexturePath_ = std::move(primaryTexturePath);
+    stats_ = ChunkedMeshStreamStats{budgetBytes, 0, 0, 0, 0, 0, 0, 0};
+    loader_ = std::jthread([this](std::stop_token stopToken) { LoaderMain(stopToken); });
+    outError.clear();
+    return true;
+}
+
+void ChunkedMeshStream::Close() noexcept {
+    if (loader_.joinable()) {
+        loader_.request_stop();
+        loader_.join();
+    }
+
+    path_.clear();
+    hasTexCoords_ = false;
+    chunks_.clear();
+    materials_.clear();
+    texturePaths_.clear();
+    primaryTexturePath_.clear();
+    resident_.clear();
+    loadQueue_.clear();
+    queuedKeys_.clear();
+    inFlightKey_ = kNoKey;
+    inFlightBytes_ = 0;
+    queuedBytes_ = 0;
+    frameIndex_ = 0;
+    stats_ = ChunkedMeshStreamStats{stats_.budgetBytes, 0, 0, 0, 0, 0, 0, 0};
+}
+
+bool ChunkedMeshStream::IsOpen() const noexcept {
+    return !path_.empty();
+}
+
+const std::filesystem::path& ChunkedMeshStream::GetPath() const noexcept {
+    return path_;
+}
+
+const std::vector<MeshChunkInfo>& ChunkedMeshStream::GetChunks() const noexcept {
+    return chunks_;
+}
+
+const std::vector<ModelMaterial>& ChunkedMeshStream::GetMaterials() const noexcept {
+    return materials_;
+}
+
+const std::vector<std::string>& ChunkedMeshStream::GetTexturePaths() const noexcept {
+    return texturePaths_;
+}
+
+const std::string& ChunkedMeshStream::GetPrimaryTexturePath() const noexcept {
+    return primaryTexturePath_;
+}
+
+glm::vec3 ChunkedMeshStream::GetBoundsMin() const noexcept {
+    return boundsMin_;
+}
+
+glm::vec3 ChunkedMeshStream::GetBoundsMax() const noexcept {
+    return boundsMax_;
+}
+
+void ChunkedMeshStream::SetBudget(std::size_t budgetBytes) {
+    std::lock_guard lock(mutex_);
+    stats_.budgetBytes = budgetBytes;
+    // Shrinking the budget may evict chunks drawn this frame; the next Request reloads what still fits.
+    EvictToFitLocked(0, std::numeric_limits<std::uint64_t>::max());
+}
+
+ChunkedMeshStreamStats ChunkedMeshStream::GetStatistics() const {
+    std::lock_guard lock(mutex_);
+    ChunkedMeshStreamStats stats = stats_;
+    stats.residentChunkCount = resident_.size();
+    stats.pendingLoadCount = loadQueue_.size() + (inFlightKey_ != kNoKey ? 1 : 0);
+    return stats;
+}
+
+void ChunkedMeshStream::SelectChunks(
+    const ModelCamera& camera,
+    float aspectRatio,
+    float viewportHeight,
+    float maxErrorPixels,
+    std::vector<MeshChunkRequest>& outRequests) const {
+    outRequests.clear();
+    const glm::mat4 modelViewProjection = BuildModelViewProjection(camera, aspectRatio);
+    // Clip-space y scale per model-space unit: the projection's focal term, since the model and view
+    // matrices are rigid.
+    const float focalScale = glm::length(
+        glm::vec3(modelViewProjection[0][1], modelViewProjection[1][1], modelViewProjection[2][1]));
+    const float pixelsPerUnitAtUnitDepth = 0.5f * viewportHeight * focalScale;
+
+    for (std::uint32_t chunkIndex = 0; chunkIndex < chunks_.size(); ++chunkIndex) {
+        const MeshChunkInfo& chunk = chunks_[chunkIndex];
+        std::uint32_t outsideMask = 0x3f;
+        for (std::uint32_t corner = 0; corner < 8; ++corner) {
+            const glm::vec3 point(
+                (corner & 1) ? chunk.boundsMax.x : chunk.boundsMin.x,
+                (corner & 2) ? chunk.boundsMax.y : chunk.boundsMin.y,
+                (corner & 4) ? chunk.boundsMax.z : chunk.boundsMin.z);
+            const glm::vec4 clip = modelViewProjection * glm::vec4(point, 1.0f);
+            std::uint32_t cornerMask = 0;
+            cornerMask |= clip.x < -clip.w ? 0x01u : 0u;
+            cornerMask |= clip.x > clip.w ? 0x02u : 0u;
+            cornerMask |= clip.y < -clip.w ? 0x04u : 0u;
+            cornerMask |= clip.y > clip.w ? 0x08u : 0u;
+            cornerMask |= clip.w < 0.1f ? 0x10u : 0u;
+            cornerMask |= clip.z > clip.w ? 0x20u : 0u;
+            outsideMask &= cornerMask;
+        }
+        if (outsideMask != 0) {
+            continue;
+        }
+
+        const glm::vec3 center = (chunk.boundsMin + chunk.boundsMax) * 0.5f;
+        const float radius = glm::length(chunk.boundsMax - center);
+        const float depth = (modelViewProjection * glm::vec4(center, 1.0f)).w;
+        const float nearestDepth = std::max(depth - radius, 0.1f);
+        std::uint32_t lod = 0;
+        for (std::uint32_t candidate = chunk.lodCount; candidate-- > 1;) {
+            if (chunk.lods[candidate].geometricError * pixelsPerUnitAtUnitDepth / nearestDepth <= maxErrorPixels) {
+                lod = candidate;
+                break;
+            }
+        }
+        outRequests.push_back(MeshChunkRequest{chunkIndex, lod});
+    }
+}
+
+void ChunkedMeshStream::Request(
+    const std::vector<MeshChunkRequest>& requests,
+    std::vector<std::shared_ptr<const ResidentMeshChunk>>& outDrawable) {
+    outDrawable.clear();
+    std::lock_guard lock(mutex_);
+    ++frameIndex_;
+
+    // Loads that were queued for an earlier view and have not started are dropped; this frame's view
+    // decides what is worth reading.
+    loadQueue_.clear();
+    queuedKeys_.clear();
+    queuedBytes_ = inFlightBytes_;
+
+    std::vector<bool> hasExactLevel(requests.size(), false);
+    std::vector<bool> hasAnyLevel(requests.size(), false);
+    for (std::size_t requestIndex = 0; requestIndex < requests.size(); ++requestIndex) {
+        const MeshChunkRequest& request = requests[requestIndex];
+        if (request.chunkIndex >= chunks_.size()) {
+            continue;
+        }
+
+        // Prefer the requested level, then coarser levels, then finer ones.
+        const std::uint32_t lodCount = chunks_[request.chunkIndex].lodCount;
+        const std::uint32_t requestedLod = std::min(request.lod, lodCount - 1);
+        for (std::uint32_t step = 0; step < lodCount; ++step) {
+            const std::uint32_t lod = requestedLod + step < lodCount ? requestedLod + step : lodCount - 1 - step;
+            const auto resident = resident_.find(MakeKey(request.chunkIndex, lod));
+            if (resident == resident_.end()) {
+                continue;
+            }
+
+            resident->second.lastUsedFrame = frameIndex_;
+            outDrawable.push_back(resident->second.chunk);
+            hasExactLevel[requestIndex] = lod == requestedLod;
+            hasAnyLevel[requestIndex] = true;
+            break;
+        }
+    }
+
+    // Placeholders first: the coarsest level of every chunk with nothing to draw, then refinements.
+    for (std::size_t requestIndex = 0; requestIndex < requests.size(); ++requestIndex) {
+        const MeshChunkRequest& request = requests[requestIndex];
+        if (request.chunkIndex < chunks_.size() && !hasAnyLevel[requestIndex]) {
+            QueueLoadLocked(request.chunkIndex, chunks_[request.chunkIndex].lodCount - 1);
+        }
+    }
+    for (std::size_t requestIndex = 0; requestIndex < requests.size(); ++requestIndex) {
+        const MeshChunkRequest& request = requests[requestIndex];
+        if (request.chunkIndex < chunks_.size() && !hasExactLevel[requestIndex]) {
+            QueueLoadLocked(request.chunkIndex, std::min(request.lod, chunks_[request.chunkIndex].lodCount - 1));
+        }
+    }
+
+    if (!loadQueue_.empty()) {
+        loadAvailable_.notify_one();
+    }
+}
+
+void ChunkedMeshStream::BuildModel(
+    const std::vector<std::shared_ptr<const ResidentMeshChunk>>& chunks,
+    ModelData& outModel) const {
+    outModel = ModelData{};
+    std::size_t vertexCount = 0;
+    std::size_t indexCount = 0;
+    for (const std::shared_ptr<const ResidentMeshChunk>& chunk : chunks) {
+        vertexCount += chunk->positions.size();
+        indexCount += chunk->indices.size();
+    }
+
+    outModel.positions.reserve(vertexCount);
+    outModel.texCoords.reserve(hasTexCoords_ ? vertexCount : 0);
+    outModel.indices.reserve(indexCount);
+    outModel.submeshes.reserve(chunks.size());
+    for (const std::shared_ptr<const ResidentMeshChunk>& chunk : chunks) {
+        const std::uint32_t baseVertex = static_cast<std::uint32_t>(outModel.positions.size());
+        const std::uint32_t indexStart = static_cast<std::uint32_t>(outModel.indices.size());
+        outModel.positions.insert(outModel.positions.end(), chunk->positions.begin(), chunk->positions.end());
+        outModel.texCoords.insert(outModel.texCoords.end(), chunk->texCoords.begin(), chunk->texCoords.end());
+        for (const std::uint16_t index : chunk->indices) {
+            outModel.indices.push_back(baseVertex + index);
+        }
+        outModel.submeshes.push_back(ModelSubmesh{
+            indexStart,
+            static_cast<std::uint32_t>(chunk->indices.size()),
+            chunks_[chunk->chunkIndex].materialIndex});
+    }
+
+    outModel.materials = materials_;
+    outModel.texturePaths = texturePaths_;
+    outModel.primaryTexturePath = primaryTexturePath_;
+    outModel.sourcePath = path_.string();
+}
+
+std::uint64_t ChunkedMeshStream::MakeKey(std::uint32_t chunkIndex, std::uint32_t lod) noexcept {
+    return (static_cast<std::uint64_t>(chunkIndex) << 32) | lod;
+}
+
+void ChunkedMeshStream::QueueLoadLocked(std::uint32_t chunkIndex, std::uint32_t lod) {
+    const std::uint64_t key = MakeKey(chunkIndex, lod);
+    if (key == inFlightKey_ || resident_.count(key) != 0 || !queuedKeys_.emplace(key, true).second) {
+        return;
+    }
+
+    // Only queue what can be made resident: chunks drawn this frame are never evicted, so the budget
+    // left after them bounds how much can still be loaded.
+    std::size_t inUseBytes = 0;
+    for (const auto& [residentKey, entry] : resident_) {
+        inUseBytes += entry.lastUsedFrame == frameIndex_ ? entry.chunk->GetByteSize() : 0;
+    }
+    const std::size_t loadBytes = GetResidentByteSize(chunks_[chunkIndex].lods[lod]);
+    if (inUseBytes + queuedBytes_ + loadBytes > stats_.budgetBytes) {
+        queuedKeys_.erase(key);
+        ++stats_.rejectedLoadCount;
+        return;
+    }
+
+    queuedBytes_ += loadBytes;
+    loadQueue_.push_back(key);
+}
+
+void ChunkedMeshStream::EvictToFitLocked(std::size_t incomingBytes, std::uint64_t evictBeforeFrame) {
+    if (stats_.residentBytes + incomingBytes <= stats_.budgetBytes) {
+        return;
+    }
+
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> candidates;
+    for (const auto& [key, entry] : resident_) {
+        if (entry.lastUsedFrame < evictBeforeFrame) {
+            candidates.emplace_back(entry.lastUsedFrame, key);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end());
+
+    for (const auto& [lastUsedFrame, key] : candidates) {
+        if (stats_.residentBytes + incomingBytes <= stats_.budgetBytes) {
+            break;
+        }
+        const auto entry = resident_.find(key);
+        stats_.residentBytes -= entry->second.chunk->GetByteSize();
+        resident_.erase(entry);
+        ++stats_.evictionCount;
+    }
+}
+
+void ChunkedMeshStream::LoaderMain(std::stop_token stopToken) {
+    std::ifstream input(path_, std::ios::binary);
+    std::vector<std::byte> bytes;
+    while (!stopToken.stop_requested()) {
+        std::uint64_t key = kNoKey;
+        {
+            std::unique_lock lock(mutex_);
+            if (!loadAvailable_.wait(lock, stopToken, [this] { return !loadQueue_.empty(); })) {
+                return;
+            }
+            key = loadQueue_.front();
+            loadQueue_.pop_front();
+            queuedKeys_.erase(key);
+            inFlightKey_ = key;
+            inFlightBytes_ = GetResidentByteSize(chunks_[key >> 32].lods[key & 0xffffffffu]);
+        }
+
+        const std::uint32_t chunkIndex = static_cast<std::uint32_t>(key >> 32);
+        const std::uint32_t lod = static_cast<std::uint32_t>(key & 0xffffffffu);
+        const MeshChunkLod& lodInfo = chunks_[chunkIndex].lods[lod];
+        auto chunk = std::make_shared<ResidentMeshChunk>();
+        chunk->chunkIndex = chunkIndex;
+        chunk->lod = lod;
+        bytes.resize(static_cast<std::size_t>(lodInfo.byteSize));
+        input.clear();
+        input.seekg(static_cast<std::streamoff>(lodInfo.fileOffset));
+        input.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        const bool decoded = input && DecodeChunk(bytes, hasTexCoords_, *chunk);
+
+        std::lock_guard lock(mutex_);
+        const std::size_t chunkBytes = chunk->GetByteSize();
+        inFlightKey_ = kNoKey;
+        queuedBytes_ -= std::min(queuedBytes_, inFlightBytes_);
+        inFlightBytes_ = 0;
+        if (!decoded) {
+            ++stats_.failedLoadCount;
+            continue;
+        }
+
+        EvictToFitLocked(chunkBytes, frameIndex_);
+        if (stats_.residentBytes + chunkBytes > stats_.budgetBytes) {
+            ++stats_.rejectedLoadCount;
+            continue;
+        }
+
+        resident_[key] = ResidentEntry{std::move(chunk), frameIndex_};
+        stats_.residentBytes += chunkBytes;
+        ++stats_.loadCount;
+    }
+}
+}
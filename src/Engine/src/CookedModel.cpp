@@ -0,0 +1,721 @@
+#include "Engine/CookedModel.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <system_error>
+#include <type_traits>
+
+#include "Engine/BlockCompression.hpp"
+#include "Engine/FbxLoader.hpp"
+#include "Engine/JobSystem.hpp"
+#include "Engine/TexturePathResolver.hpp"
+
+#include "ByteStream.hpp"
+
+namespace engine {
+namespace {
+constexpr char kCookedModelMagic[4] = {'E', 'M', 'D', 'C'};
+constexpr std::uint32_t kCookedModelVersion = 5;
+constexpr std::size_t kSectionCount = static_cast<std::size_t>(ModelSection::Count);
+constexpr std::size_t kHeaderSizeOffset = sizeof(kCookedModelMagic) + sizeof(std::uint32_t);
+constexpr std::uint32_t kMaxHeaderSize = 1u << 20;
+
+std::uint32_t SectionBit(ModelSection section) noexcept {
+    return 1u << static_cast<std::uint32_t>(section);
+}
+
+template <typename T>
+void WriteArray(ByteWriter& writer, const std::vector<T>& values) {
+    writer.Write(static_cast<std::uint64_t>(values.size()));
+    writer.WriteBytes(values.data(), values.size() * sizeof(T));
+}
+
+template <typename T>
+void ReadArray(ByteReader& reader, std::vector<T>& outValues) {
+    const std::size_t count = reader.ReadCount(sizeof(T));
+    outValues.resize(count);
+    reader.ReadBytes(outValues.data(), count * sizeof(T));
+}
+
+template <typename T>
+void WriteArraySection(std::vector<std::byte>& bytes, const std::vector<T>& values) {
+    ByteWriter writer(bytes);
+    WriteArray(writer, values);
+}
+
+template <typename T>
+bool ReadArraySection(const std::vector<std::byte>& bytes, std::vector<T>& outValues) {
+    ByteReader reader(bytes.data(), bytes.size());
+    ReadArray(reader, outValues);
+    return !reader.Failed();
+}
+
+void WriteMaterialSection(std::vector<std::byte>& bytes, const std::vector<ModelMaterial>& materials) {
+    ByteWriter writer(bytes);
+    WriteModelMaterials(writer, materials);
+}
+
+bool ReadMaterialSection(const std::vector<std::byte>& bytes, std::vector<ModelMaterial>& outMaterials) {
+    ByteReader reader(bytes.data(), bytes.size());
+    return ReadModelMaterials(reader, outMaterials);
+}
+
+void WriteTexturePathSection(std::vector<std::byte>& bytes, const ModelData& model) {
+    ByteWriter writer(bytes);
+    writer.WriteString(model.primaryTexturePath);
+    writer.Write(static_cast<std::uint64_t>(model.texturePaths.size()));
+    for (const std::string& texturePath : model.texturePaths) {
+        writer.WriteString(texturePath);
+    }
+}
+
+bool ReadTexturePathSection(
+    const std::vector<std::byte>& bytes,
+    std::string& outPrimaryTexturePath,
+    std::vector<std::string>& outTexturePaths) {
+    ByteReader reader(bytes.data(), bytes.size());
+    outPrimaryTexturePath = reader.ReadString();
+    const std::size_t count = reader.ReadCount(sizeof(std::uint32_t));
+    outTexturePaths.clear();
+    outTexturePaths.reserve(count);
+    for (std::size_t textureIndex = 0; textureIndex < count && !reader.Failed(); ++textureIndex) {
+        outTexturePaths.push_back(reader.ReadString());
+    }
+    return !reader.Failed();
+}
+
+void WriteAnimationSection(std::vector<std::byte>& bytes, const std::vector<AnimationClip>& animations) {
+    ByteWriter writer(bytes);
+    writer.Write(static_cast<std::uint64_t>(animations.size()));
+    for (const AnimationClip& clip : animations) {
+        writer.WriteString(clip.name);
+        writer.Write(clip.durationSeconds);
+        writer.Write(clip.ticksPerSecond);
+        writer.Write(static_cast<std::uint64_t>(clip.morphCurves.size()));
+        for (const MorphWeightCurve& curve : clip.morphCurves) {
+            writer.Write(curve.targetIndex);
+            WriteArray(writer, curve.keys);
+        }
+    }
+}
+
+bool ReadAnimationSection(const std::vector<std::byte>& bytes, std::vector<AnimationClip>& outAnimations) {
+    ByteReader reader(bytes.data(), bytes.size());
+    const std::size_t count = reader.ReadCount(sizeof(std::uint32_t) + 2 * sizeof(float) + sizeof(std::uint64_t));
+    outAnimations.clear();
+    outAnimations.reserve(count);
+    for (std::size_t clipIndex = 0; clipIndex < count && !reader.Failed(); ++clipIndex) {
+        AnimationClip clip;
+        clip.name = reader.ReadString();
+        clip.durationSeconds = reader.Read<float>();
+        clip.ticksPerSecond = reader.Read<float>();
+        const std::size_t curveCount = reader.ReadCount(sizeof(std::uint32_t) + sizeof(std::uint64_t));
+        clip.morphCurves.resize(curveCount);
+        for (MorphWeightCurve& curve : clip.morphCurves) {
+            curve.targetIndex = reader.Read<std::uint32_t>();
+            ReadArray(reader, curve.keys);
+        }
+        outAnimations.push_back(std::move(clip));
+    }
+    return !reader.Failed();
+}
+
+void WriteMorphTargetSection(std::vector<std::byte>& bytes, const std::vector<MorphTarget>& targets) {
+    ByteWriter writer(bytes);
+    writer.Write(static_cast<std::uint64_t>(targets.size()));
+    for (const MorphTarget& target : targets) {
+        writer.WriteString(target.name);
+        writer.Write(target.deltaScale);
+        writer.Write(target.defaultWeight);
+        WriteArray(writer, target.vertexIndices);
+        WriteArray(writer, target.deltas);
+    }
+}
+
+bool ReadMorphTargetSection(const std::vector<std::byte>& bytes, std::vector<MorphTarget>& outTargets) {
+    ByteReader reader(bytes.data(), bytes.size());
+    const std::size_t count = reader.ReadCount(sizeof(std::uint32_t) + 2 * sizeof(float) + 2 * sizeof(std::uint64_t));
+    outTargets.clear();
+    outTargets.reserve(count);
+    for (std::size_t targetIndex = 0; targetIndex < count && !reader.Failed(); ++targetIndex) {
+        MorphTarget target{};
+        target.name = reader.ReadString();
+        target.deltaScale = reader.Read<float>();
+        target.defaultWeight = reader.Read<float>();
+        ReadArray(reader, target.vertexIndices);
+        ReadArray(reader, target.deltas);
+        if (target.deltas.size() != target.vertexIndices.size() * 3) {
+            return false;
+        }
+        outTargets.push_back(std::move(target));
+    }
+    return !reader.Failed();
+}
+
+CookedModelSummary BuildSummary(const ModelData& model) {
+    CookedModelSummary summary{};
+    summary.vertexCount = model.positions.size();
+    summary.triangleCount = model.indices.size() / 3;
+    summary.submeshCount = model.submeshes.size();
+    summary.materialCount = model.materials.size();
+    summary.textureCount = model.texturePaths.size();
+    summary.animationCount = model.animations.size();
+    summary.boundsMin = glm::vec3(0.0f);
+    summary.boundsMax = glm::vec3(0.0f);
+    if (!model.positions.empty()) {
+        summary.boundsMin = glm::vec3(std::numeric_limits<float>::max());
+        summary.boundsMax = glm::vec3(std::numeric_limits<float>::lowest());
+        for (const glm::vec3& position : model.positions) {
+            summary.boundsMin = glm::vec3(
+                std::min(summary.boundsMin.x, position.x),
+                std::min(summary.boundsMin.y, position.y),
+                std::min(summary.boundsMin.z, position.z));
+            summary.boundsMax = glm::vec3(
+                std::max(summary.boundsMax.x, position.x),
+                std::max(summary.boundsMax.y, position.y),
+                std::max(summary.boundsMax.z, position.z));
+        }
+    }
+    return summary;
+}
+
+void WriteSummary(ByteWriter& writer, const CookedModelSummary& summary) {
+    writer.Write(summary.vertexCount);
+    writer.Write(summary.triangleCount);
+    writer.Write(summary.submeshCount);
+    writer.Write(summary.materialCount);
+    writer.Write(summary.textureCount);
+    writer.Write(summary.animationCount);
+    const float bounds[6] = {
+        summary.boundsMin.x, summary.boundsMin.y, summary.boundsMin.z,
+        summary.boundsMax.x, summary.boundsMax.y, summary.boundsMax.z};
+    writer.WriteBytes(bounds, sizeof(bounds));
+}
+
+CookedModelSummary ReadSummary(ByteReader& reader) {
+    CookedModelSummary summary{};
+    summary.vertexCount = reader.Read<std::uint64_t>();
+    summary.triangleCount = reader.Read<std::uint64_t>();
+    summary.submeshCount = reader.Read<std::uint64_t>();
+    summary.materialCount = reader.Read<std::uint64_t>();
+    summary.textureCount = reader.Read<std::uint64_t>();
+    summary.animationCount = reader.Read<std::uint64_t>();
+    float bounds[6] = {};
+    reader.ReadBytes(bounds, sizeof(bounds));
+    summary.boundsMin = glm::vec3(bounds[0], bounds[1], bounds[2]);
+    summary.boundsMax = glm::vec3(bounds[3], bounds[4], bounds[5]);
+    return summary;
+}
+
+// Bulk vertex and index sections get a filter matched to their layout; the rest are small.
+BlockFilter GetSectionFilter(ModelSection section) {
+    switch (section) {
+    case ModelSection::Positions:
+    case ModelSection::TexCoords:
+    case ModelSection::Submeshes:
+        return BlockFilter::Shuffle32;
+    case ModelSection::Indices:
+        return BlockFilter::Delta32;
+    default:
+        return BlockFilter::None;
+    }
+}
+
+std::uint64_t GetArraySectionSize(std::uint64_t count, std::size_t elementSize) {
+    const std::uint64_t maxCount = (std::numeric_limits<std::uint64_t>::max() - sizeof(std::uint64_t)) / elementSize;
+    return count > maxCount ? std::numeric_limits<std::uint64_t>::max() : sizeof(std::uint64_t) + count * elementSize;
+}
+
+// Largest decoded size the summary allows for a section. Sections without a fixed layout are only
+// bounded by how far the codec can expand their stored bytes.
+std::uint64_t GetMaxSectionSize(ModelSection section, const CookedModelSummary& summary) {
+    switch (section) {
+    case ModelSection::Positions:
+        return GetArraySectionSize(summary.vertexCount, sizeof(glm::vec3));
+    case ModelSection::Indices:
+        // The triangle count rounds down, so up to two trailing indices are allowed for.
+        return GetArraySectionSize(std::min(summary.triangleCount, std::numeric_limits<std::uint64_t>::max() / 4) * 3 + 2, sizeof(std::uint32_t));
+    case ModelSection::Submeshes:
+        return GetArraySectionSize(summary.submeshCount, sizeof(ModelSubmesh));
+    case ModelSection::TexCoords:
+        return GetArraySectionSize(summary.vertexCount, sizeof(glm::vec2));
+    default:
+        return std::numeric_limits<std::uint64_t>::max();
+    }
+}
+
+// Reads and decompresses one section; blocks decode on worker threads while later blocks are read.
+bool ReadSection(
+    const std::filesystem::path& path,
+    std::uint64_t offset,
+    std::uint64_t size,
+    std::uint64_t maxRawSize,
+    std::vector<std::byte>& outBytes,
+    std::string& outError) {
+    std::ifstream input(path, std::ios::binary);
+    if (!input) {
+        outError = "Could not open cooked model '" + path.string() + "'.";
+        return false;
+    }
+
+    input.seekg(static_cast<std::streamoff>(offset));
+    std::string decodeError;
+    if (!ReadCompressedBlocks(JobSystem::Get(), input, size, maxRawSize, outBytes, decodeError)) {
+        outError = "Cooked model '" + path.string() + "': " + decodeError;
+        return false;
+    }
+    return true;
+}
+}
+
+bool ReadCookedModelSourceStamp(
+    const std::filesystem::path& sourcePath,
+    CookedModelSourceStamp& outStamp,
+    std::string& outError) {
+    std::error_code error;
+    const std::uintmax_t fileSize = std::filesystem::file_size(sourcePath, error);
+    if (error) {
+        outError = "Could not stat '" + sourcePath.string() + "': " + error.message();
+        return false;
+    }
+
+    const std::filesystem::file_time_type lastWrite = std::filesystem::last_write_time(sourcePath, error);
+    if (error) {
+        outError = "Could not stat '" + sourcePath.string() + "': " + error.message();
+        return false;
+    }
+
+    outStamp = CookedModelSourceStamp{
+        static_cast<std::uint64_t>(fileSize),
+        static_cast<std::int64_t>(lastWrite.time_since_epoch().count())};
+    return true;
+}
+
+std::filesystem::path GetCookedModelPath(
+    const std::filesystem::path& cacheDirectory,
+    const std::filesystem::path& sourcePath) {
+    std::error_code error;
+    std::filesystem::path absolutePath = std::filesystem::absolute(sourcePath, error);
+    if (error) {
+        absolutePath = sourcePath;
+    }
+
+    const std::string key = absolutePath.lexically_normal().generic_string();
+    std::uint64_t hash = 14695981039346656037ull;
+    for (const char character : key) {
+        hash ^= static_cast<unsigned char>(character);
+        hash *= 1099511628211ull;
+    }
+
+    char hashText[17];
+    std::snprintf(hashText, sizeof(hashText), "%016llx", static_cast<unsigned long long>(hash));
+    return cacheDirectory / (sourcePath.stem().string() + "_" + hashText + ".emdc");
+}
+
+bool WriteCookedModel(
+    const std::filesystem::path& cookedPath,
+    const ModelData& model,
+    const CookedModelSourceStamp& sourceStamp,
+    std::string& outError) {
+    std::array<std::vector<std::byte>, kSectionCount> sections;
+    WriteArraySection(sections[static_cast<std::size_t>(ModelSection::Positions)], model.positions);
+    WriteArraySection(sections[static_cast<std::size_t>(ModelSection::Indices)], model.indices);
+    WriteArraySection(sections[static_cast<std::size_t>(ModelSection::Submeshes)], model.submeshes);
+    WriteArraySection(sections[static_cast<std::size_t>(ModelSection::TexCoords)], model.texCoords);
+    WriteMaterialSection(sections[static_cast<std::size_t>(ModelSection::Materials)], model.materials);
+    WriteTexturePathSection(sections[static_cast<std::size_t>(ModelSection::TexturePaths)], model);
+    WriteAnimationSection(sections[static_cast<std::size_t>(ModelSection::Animations)], model.animations);
+    WriteMorphTargetSection(sections[static_cast<std::size_t>(ModelSection::MorphTargets)], model.morphTargets);
+
+    std::vector<std::byte> compressed;
+    for (std::size_t section = 0; section < kSectionCount; ++section) {
+        CompressBlocks(
+            sections[section].data(),
+            sections[section].size(),
+            GetSectionFilter(static_cast<ModelSection>(section)),
+            compressed);
+        sections[section].swap(compressed);
+    }
+
+    std::vector<std::byte> header;
+    ByteWriter headerWriter(header);
+    headerWriter.WriteBytes(kCookedModelMagic, sizeof(kCookedModelMagic));
+    headerWriter.Write(kCookedModelVersion);
+    headerWriter.Write(std::uint32_t{0});
+    headerWriter.Write(sourceStamp.fileSize);
+    headerWriter.Write(sourceStamp.lastWriteTicks);
+    headerWriter.WriteString(model.sourcePath);
+    WriteSummary(headerWriter, BuildSummary(model));
+    headerWriter.Write(HashTextureSearchOptions(GetDefaultTextureSearchOptions()));
+    headerWriter.Write(static_cast<std::uint64_t>(model.textureSearchDirectories.size()));
+    for (const TextureSearchDirectory& directory : model.textureSearchDirectories) {
+        headerWriter.WriteString(directory.path);
+        headerWriter.Write(directory.lastWriteTicks);
+    }
+    WriteArray(headerWriter, model.unresolvedTextureIndices);
+    headerWriter.Write(static_cast<std::uint32_t>(kSectionCount));
+
+    const std::size_t sectionTableBytes = kSectionCount * 2 * sizeof(std::uint64_t);
+    std::uint64_t offset = header.size() + sectionTableBytes;
+    for (const std::vector<std::byte>& section : sections) {
+        headerWriter.Write(offset);
+        headerWriter.Write(static_cast<std::uint64_t>(section.size()));
+        offset += section.size();
+    }
+
+    const std::uint32_t headerSize = static_cast<std::uint32_t>(header.size());
+    std::memcpy(header.data() + kHeaderSizeOffset, &headerSize, sizeof(headerSize));
+
+    std::error_code error;
+    std::filesystem::create_directories(cookedPath.parent_path(), error);
+    if (error) {
+        outError = "Could not create cache directory '" + cookedPath.parent_path().string() + "': " + error.message();
+        return false;
+    }
+
+    std::filesystem::path temporaryPath = cookedPath;
+    temporaryPath += ".tmp";
+    {
+        std::ofstream output(temporaryPath, std::ios::binary | std::ios::trunc);
+        if (!output) {
+            outError = "Could not open '" + temporaryPath.string() + "' for writing.";
+            return false;
+        }
+
+        output.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+        for (const std::vector<std::byte>& section : sections) {
+            output.write(reinterpret_cast<const char*>(section.data()), static_cast<std::streamsize>(section.size()));
+        }
+
+        if (!output) {
+            outError = "Could not write cooked model '" + temporaryPath.string() + "'.";
+            return false;
+        }
+    }
+
+    std::filesystem::rename(temporaryPath, cookedPath, error);
+    if (error) {
+        std::filesystem::remove(temporaryPath, error);
+        outError = "Could not replace cooked model '" + cookedPath.string() + "'.";
+        return false;
+    }
+
+    outError.clear();
+    return true;
+}
+
+LazyModel::LazyModel()
+    : sourceStamp_{},
+      summary_{},
+      textureSearchKey_(0),
+      textureSearchDirectories_(),
+      unresolvedTextureIndices_(),
+      sections_{},
+      loadedSections_(0) {
+}
+
+bool LazyModel::Open(const std::filesystem::path& cookedPath, std::string& outError) {
+    Close();
+
+    std::ifstream input(cookedPath, std::ios::binary);
+    if (!input) {
+        outError = "Could not open cooked model '" + cookedPath.string() + "'.";
+        return false;
+    }
+
+    input.seekg(0, std::ios::end);
+    const std::uint64_t fileSize = static_cast<std::uint64_t>(input.tellg());
+    input.seekg(0, std::ios::beg);
+
+    std::array<std::byte, kHeaderSizeOffset + sizeof(std::uint32_t)> prefix{};
+    input.read(reinterpret_cast<char*>(prefix.data()), static_cast<std::streamsize>(prefix.size()));
+    std::uint32_t version = 0;
+    std::uint32_t headerSize = 0;
+    std::memcpy(&version, prefix.data() + sizeof(kCookedModelMagic), sizeof(version));
+    std::memcpy(&headerSize, prefix.data() + kHeaderSizeOffset, sizeof(headerSize));
+    if (!input || std::memcmp(prefix.data(), kCookedModelMagic, sizeof(kCookedModelMagic)) != 0 ||
+        version != kCookedModelVersion) {
+        outError = "'" + cookedPath.string() + "' is not a cooked model of version " + std::to_string(kCookedModelVersion) + ".";
+        return false;
+    }
+
+    if (headerSize < prefix.size() || headerSize > kMaxHeaderSize || headerSize > fileSize) {
+        outError = "Cooked model '" + cookedPath.string() + "' has a corrupt header.";
+        return false;
+    }
+
+    std::vector<std::byte> header(headerSize - prefix.size());
+    input.read(reinterpret_cast<char*>(header.data()), static_cast<std::streamsize>(header.size()));
+    if (!input) {
+        outError = "Cooked model '" + cookedPath.string() + "' is truncated.";
+        return false;
+    }
+
+    ByteReader reader(header.data(), header.size());
+    CookedModelSourceStamp sourceStamp{};
+    sourceStamp.fileSize = reader.Read<std::uint64_t>();
+    sourceStamp.lastWriteTicks = reader.Read<std::int64_t>();
+    std::string sourcePath = reader.ReadString();
+    const CookedModelSummary summary = ReadSummary(reader);
+    const std::uint64_t textureSearchKey = reader.Read<std::uint64_t>();
+    const std::size_t textureSearchDirectoryCount = reader.ReadCount(sizeof(std::uint32_t) + sizeof(std::int64_t));
+    std::vector<TextureSearchDirectory> textureSearchDirectories;
+    textureSearchDirectories.reserve(textureSearchDirectoryCount);
+    for (std::size_t directoryIndex = 0; directoryIndex < textureSearchDirectoryCount && !reader.Failed(); ++directoryIndex) {
+        std::string path = reader.ReadString();
+        textureSearchDirectories.push_back(TextureSearchDirectory{std::move(path), reader.Read<std::int64_t>()});
+    }
+    std::vector<std::uint32_t> unresolvedTextureIndices;
+    ReadArray(reader, unresolvedTextureIndices);
+    const std::uint32_t sectionCount = reader.Read<std::uint32_t>();
+    std::array<SectionRange, kSectionCount> sections{};
+    for (std::uint32_t sectionIndex = 0; sectionIndex < sectionCount && !reader.Failed(); ++sectionIndex) {
+        const SectionRange range{reader.Read<std::uint64_t>(), reader.Read<std::uint64_t>()};
+        if (sectionIndex < kSectionCount) {
+            sections[sectionIndex] = range;
+        }
+    }
+
+    bool rangesValid = sectionCount >= kSectionCount;
+    for (const SectionRange& range : sections) {
+        rangesValid = rangesValid && range.offset <= fileSize && range.size <= fileSize - range.offset;
+    }
+    if (reader.Failed() || !rangesValid) {
+        outError = "Cooked model '" + cookedPath.string() + "' has a corrupt header.";
+        return false;
+    }
+
+    cookedPath_ = cookedPath;
+    sourcePath_ = std::move(sourcePath);
+    sourceStamp_ = sourceStamp;
+    summary_ = summary;
+    textureSearchKey_ = textureSearchKey;
+    textureSearchDirectories_ = std::move(textureSearchDirectories);
+    unresolvedTextureIndices_ = std::move(unresolvedTextureIndices);
+    sections_ = sections;
+    outError.clear();
+    return true;
+}
+
+void LazyModel::Close() noexcept {
+    cookedPath_.clear();
+    sourcePath_.clear();
+    sourceStamp_ = CookedModelSourceStamp{};
+    summary_ = CookedModelSummary{};
+    textureSearchKey_ = 0;
+    textureSearchDirectories_.clear();
+    unresolvedTextureIndices_.clear();
+    sections_ = {};
+    loadedSections_ = 0;
+    positions_.clear();
+    indices_.clear();
+    submeshes_.clear();
+    texCoords_.clear();
+    materials_.clear();
+    texturePaths_.clear();
+    primaryTexturePath_.clear();
+    animations_.clear();
+    morphTargets_.clear();
+    lastError_.clear();
+}
+
+bool LazyModel::IsOpen() const noexcept {
+    return !cookedPath_.empty();
+}
+
+bool LazyModel::IsSectionLoaded(ModelSection section) const noexcept {
+    return (loadedSections_ & SectionBit(section)) != 0;
+}
+
+const CookedModelSummary& LazyModel::GetSummary() const noexcept {
+    return summary_;
+}
+
+const CookedModelSourceStamp& LazyModel::GetSourceStamp() const noexcept {
+    return sourceStamp_;
+}
+
+const std::string& LazyModel::GetSourcePath() const noexcept {
+    return sourcePath_;
+}
+
+bool LazyModel::IsTextureResolutionCurrent() const {
+    if (textureSearchKey_ != HashTextureSearchOptions(GetDefaultTextureSearchOptions())) {
+        return false;
+    }
+    for (const TextureSearchDirectory& directory : textureSearchDirectories_) {
+        if (ReadDirectoryWriteTicks(directory.path) != directory.lastWriteTicks) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const std::string& LazyModel::GetLastError() const noexcept {
+    return lastError_;
+}
+
+bool LazyModel::BeginSection(ModelSection section, std::vector<std::byte>& outBytes) {
+    if (IsSectionLoaded(section) || !IsOpen()) {
+        return false;
+    }
+
+    // Mark the section loaded even on failure so a corrupt file is not re-read on every access.
+    loadedSections_ |= SectionBit(section);
+    const SectionRange& range = sections_[static_cast<std::size_t>(section)];
+    return ReadSection(cookedPath_, range.offset, range.size, GetMaxSectionSize(section, summary_), outBytes, lastError_);
+}
+
+const std::vector<glm::vec3>& LazyModel::GetPositions() {
+    std::vector<std::byte> bytes;
+    if (BeginSection(ModelSection::Positions, bytes) && !ReadArraySection(bytes, positions_)) {
+        positions_.clear();
+        lastError_ = "Cooked model positions are corrupt.";
+    }
+    return positions_;
+}
+
+const std::vector<std::uint32_t>& LazyModel::GetIndices() {
+    std::vector<std::byte> bytes;
+    if (BeginSection(ModelSection::Indices, bytes) && !ReadArraySection(bytes, indices_)) {
+        indices_.clear();
+        lastError_ = "Cooked model indices are corrupt.";
+    }
+    return indices_;
+}
+
+const std::vector<ModelSubmesh>& LazyModel::GetSubmeshes() {
+    std::vector<std::byte> bytes;
+    if (BeginSection(ModelSection::Submeshes, bytes) && !ReadArraySection(bytes, submeshes_)) {
+        submeshes_.clear();
+        lastError_ = "Cooked model submeshes are corrupt.";
+    }
+    return submeshes_;
+}
+
+const std::vector<glm::vec2>& LazyModel::GetTexCoords() {
+    std::vector<std::byte> bytes;
+    if (BeginSection(ModelSection::TexCoords, bytes) && !ReadArraySection(bytes, texCoords_)) {
+        texCoords_.clear();
+        lastError_ = "Cooked model texture coordinates are corrupt.";
+    }
+    return texCoords_;
+}
+
+const std::vector<ModelMaterial>& LazyModel::GetMaterials() {
+    std::vector<std::byte> bytes;
+    if (BeginSection(ModelSection::Materials, bytes) && !ReadMaterialSection(bytes, materials_)) {
+        materials_.clear();
+        lastError_ = "Cooked model materials are corrupt.";
+    }
+    return materials_;
+}
+
+const std::vector<std::string>& LazyModel::GetTexturePaths() {
+    std::vector<std::byte> bytes;
+    if (BeginSection(ModelSection::TexturePaths, bytes) &&
+        !ReadTexturePathSection(bytes, primaryTexturePath_, texturePaths_)) {
+        texturePaths_.clear();
+        primaryTexturePath_.clear();
+        lastError_ = "Cooked model texture paths are corrupt.";
+    }
+    return texturePaths_;
+}
+
+const std::string& LazyModel::GetPrimaryTexturePath() {
+    GetTexturePaths();
+    return primaryTexturePath_;
+}
+
+const std::vector<AnimationClip>& LazyModel::GetAnimations() {
+    std::vector<std::byte> bytes;
+    if (BeginSection(ModelSection::Animations, bytes) && !ReadAnimationSection(bytes, animations_)) {
+        animations_.clear();
+        lastError_ = "Cooked model animations are corrupt.";
+    }
+    return animations_;
+}
+
+const std::vector<MorphTarget>& LazyModel::GetMorphTargets() {
+    std::vector<std::byte> bytes;
+    if (BeginSection(ModelSection::MorphTargets, bytes) && !ReadMorphTargetSection(bytes, morphTargets_)) {
+        morphTargets_.clear();
+        lastError_ = "Cooked model morph targets are corrupt.";
+    }
+    return morphTargets_;
+}
+
+bool LazyModel::Materialize(const ModelLoadRequest& request, ModelData& outModel, std::string& outError) {
+    if (!IsOpen()) {
+        outError = "No cooked model is open.";
+        return false;
+    }
+
+    lastError_.clear();
+    outModel = ModelData{};
+    outModel.sourcePath = sourcePath_;
+    outModel.positions = GetPositions();
+    outModel.indices = GetIndices();
+    outModel.submeshes = GetSubmeshes();
+    if (request.texCoords) {
+        outModel.texCoords = GetTexCoords();
+    }
+    if (request.materials) {
+        outModel.materials = GetMaterials();
+        outModel.texturePaths = GetTexturePaths();
+        outModel.unresolvedTextureIndices = unresolvedTextureIndices_;
+        outModel.primaryTexturePath = GetPrimaryTexturePath();
+    } else {
+        for (ModelSubmesh& submesh : outModel.submeshes) {
+            submesh.materialIndex = std::numeric_limits<std::uint32_t>::max();
+        }
+    }
+    if (request.animations) {
+        outModel.animations = GetAnimations();
+        outModel.morphTargets = GetMorphTargets();
+    }
+
+    if (!lastError_.empty()) {
+        outError = lastError_;
+        return false;
+    }
+
+    outError.clear();
+    return true;
+}
+
+bool OpenCachedModel(
+    const std::filesystem::path& sourcePath,
+    const std::filesystem::path& cacheDirectory,
+    LazyModel& outModel,
+    std::string& outError) {
+    CookedModelSourceStamp sourceStamp{};
+    if (!ReadCookedModelSourceStamp(sourcePath, sourceStamp, outError)) {
+        return false;
+    }
+
+    const std::filesystem::path cookedPath = GetCookedModelPath(cacheDirectory, sourcePath);
+    std::string openError;
+    if (outModel.Open(cookedPath, openError) && outModel.GetSourceStamp().fileSize == sourceStamp.fileSize &&
+        outModel.GetSourceStamp().lastWriteTicks == sourceStamp.lastWriteTicks && outModel.IsTextureResolutionCurrent()) {
+        outError.clear();
+        return true;
+    }
+
+    ModelData model;
+    if (!FbxLoader::LoadModel(sourcePath, model, outError)) {
+        outModel.Close();
+        return false;
+    }
+
+    if (!WriteCookedModel(cookedPath, model, sourceStamp, outError)) {
+        outModel.Close();
+        return false;
+    }
+
+    return outModel.Open(cookedPath, outError);
+}
+}
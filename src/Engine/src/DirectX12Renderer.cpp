@@ -1,5 +1,7 @@
 #include "Engine/DirectX12Renderer.hpp"
 
+#include <utility>
+
 #include "SdlRendererBase.hpp"
 
 namespace engine {
@@ -24,8 +26,28 @@ void DirectX12Renderer::EndFrame() {
     impl_->EndFrame();
 }
 
-void DirectX12Renderer::RenderModelWireframe(const ModelData& model, float yawDegrees, float pitchDegrees, float rollDegrees, float cameraDistance, bool wireOverlayEnabled) {
-    impl_->RenderModelWireframe(model, yawDegrees, pitchDegrees, rollDegrees, cameraDistance, wireOverlayEnabled);
+void DirectX12Renderer::RenderModelWireframe(const ModelData& model, const CameraLatch& latchCamera, bool wireOverlayEnabled) {
+    impl_->RenderModelWireframe(model, latchCamera, wireOverlayEnabled);
+}
+
+void DirectX12Renderer::InvalidateModelTextures(const std::vector<std::string>& texturePaths) {
+    impl_->InvalidateModelTextures(texturePaths);
+}
+
+void DirectX12Renderer::SetRenderScale(float scale) {
+    impl_->SetRenderScale(scale);
+}
+
+void DirectX12Renderer::SetOverdrawVisualization(bool enabled) {
+    impl_->SetOverdrawVisualization(enabled);
+}
+
+void DirectX12Renderer::SetPointCloudPreview(std::shared_ptr<const PointCloudPreview> preview) {
+    impl_->SetPointCloudPreview(std::move(preview));
+}
+
+MaterialChannelMask DirectX12Renderer::GetSampledMaterialChannels() const noexcept {
+    return impl_->GetSampledMaterialChannels();
 }
 
 SDL_Renderer* DirectX12Renderer::GetNativeRenderer() const noexcept {
@@ -35,4 +57,8 @@ SDL_Renderer* DirectX12Renderer::GetNativeRenderer() const noexcept {
 const char* DirectX12Renderer::GetName() const noexcept {
     return impl_->GetName();
 }
+
+RendererFrameStatistics DirectX12Renderer::GetFrameStatistics() const noexcept {
+    return impl_->GetFrameStatistics();
+}
 }
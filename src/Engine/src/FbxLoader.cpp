@@ -3,58 +3,325 @@
 #include <algorithm>
 #include <filesystem>
 #include <limits>
+#include <map>
+#include <mutex>
+#include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
+#include <assimp/config.h>
 #include <assimp/material.h>
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 #include <glm/common.hpp>
 
+#include "Engine/JobSystem.hpp"
+#include "Engine/MorphTargets.hpp"
+#include "Engine/TexturePathResolver.hpp"
+
 namespace engine {
 namespace {
 void NormalizeModel(ModelData& model) {
+    constexpr std::size_t kPointsPerRange = 16384;
     glm::vec3 minBounds(std::numeric_limits<float>::max());
     glm::vec3 maxBounds(std::numeric_limits<float>::lowest());
+    std::mutex boundsMutex;
+
+    JobSystem& jobs = JobSystem::Get();
+    jobs.ParallelFor(model.positions.size(), kPointsPerRange, [&](std::size_t begin, std::size_t end) {
+        glm::vec3 rangeMin(std::numeric_limits<float>::max());
+        glm::vec3 rangeMax(std::numeric_limits<float>::lowest());
+        for (std::size_t index = begin; index < end; ++index) {
+            rangeMin = glm::min(rangeMin, model.positions[index]);
+            rangeMax = glm::max(rangeMax, model.positions[index]);
+        }
 
-    for (const glm::vec3& point : model.positions) {
-        minBounds = glm::min(minBounds, point);
-        maxBounds = glm::max(maxBounds, point);
-    }
+        std::lock_guard lock(boundsMutex);
+        minBounds = glm::min(minBounds, rangeMin);
+        maxBounds = glm::max(maxBounds, rangeMax);
+    });
 
     const glm::vec3 center = (minBounds + maxBounds) * 0.5f;
     const glm::vec3 dimensions = maxBounds - minBounds;
     const float maxDimension = std::max({dimensions.x, dimensions.y, dimensions.z});
     const float scale = maxDimension > 0.0001f ? (2.0f / maxDimension) : 1.0f;
 
-    for (glm::vec3& point : model.positions) {
-        point = (point - center) * scale;
+    jobs.ParallelFor(model.positions.size(), kPointsPerRange, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t index = begin; index < end; ++index) {
+            model.positions[index] = (model.positions[index] - center) * scale;
+        }
+    });
+    for (MorphTarget& target : model.morphTargets) {
+        target.deltaScale *= scale;
+    }
+}
+
+// Where one mesh's vertices and triangles land in the merged model. Meshes are only transformed
+// here when the importer did not pre-transform them; `node` is set in that case.
+struct MeshRange {
+    const aiMesh* mesh;
+    const aiNode* node;
+    aiMatrix4x4 transform;
+    std::uint32_t baseVertex;
+    std::uint32_t indexStart;
+    std::uint32_t indexCount;
+    std::uint32_t firstMorphTarget;
+};
+
+// One placement of a mesh in the node graph, with the node's absolute transform.
+struct MeshInstance {
+    const aiNode* node;
+    unsigned int meshIndex;
+    aiMatrix4x4 transform;
+};
+
+bool HasMorphTargets(const aiScene& scene) {
+    for (unsigned int meshIndex = 0; meshIndex < scene.mNumMeshes; ++meshIndex) {
+        if (scene.mMeshes[meshIndex] && scene.mMeshes[meshIndex]->mNumAnimMeshes > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void CollectMeshInstances(const aiNode& node, const aiMatrix4x4& parentTransform, std::vector<MeshInstance>& outInstances) {
+    const aiMatrix4x4 transform = parentTransform * node.mTransformation;
+    for (unsigned int meshSlot = 0; meshSlot < node.mNumMeshes; ++meshSlot) {
+        outInstances.push_back(MeshInstance{&node, node.mMeshes[meshSlot], transform});
+    }
+    for (unsigned int childIndex = 0; childIndex < node.mNumChildren; ++childIndex) {
+        if (node.mChildren[childIndex]) {
+            CollectMeshInstances(*node.mChildren[childIndex], transform, outInstances);
+        }
     }
 }
+
+bool IsUsableAnimMesh(const aiMesh& mesh, const aiAnimMesh* animMesh) {
+    return animMesh && animMesh->HasPositions() && animMesh->mNumVertices == mesh.mNumVertices;
+}
+
+std::uint32_t CountTriangles(const aiMesh& mesh) {
+    if (mesh.mPrimitiveTypes == aiPrimitiveType_TRIANGLE) {
+        return mesh.mNumFaces;
+    }
+
+    std::uint32_t triangleCount = 0;
+    for (unsigned int faceIndex = 0; faceIndex < mesh.mNumFaces; ++faceIndex) {
+        triangleCount += mesh.mFaces[faceIndex].mNumIndices == 3 ? 1 : 0;
+    }
+    return triangleCount;
+}
+
+void CopyMeshGeometry(const MeshRange& range, bool copyTexCoords, ModelData& model) {
+    constexpr std::size_t kVerticesPerRange = 8192;
+    constexpr std::size_t kFacesPerRange = 8192;
+    const aiMesh& mesh = *range.mesh;
+    const bool transformed = range.node && !range.transform.IsIdentity();
+    JobSystem& jobs = JobSystem::Get();
+
+    jobs.ParallelFor(mesh.mNumVertices, kVerticesPerRange, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t vertexIndex = begin; vertexIndex < end; ++vertexIndex) {
+            const aiVector3D vertex = transformed ? range.transform * mesh.mVertices[vertexIndex] : mesh.mVertices[vertexIndex];
+            model.positions[range.baseVertex + vertexIndex] = glm::vec3(vertex.x, vertex.y, vertex.z);
+            if (!copyTexCoords) {
+                continue;
+            }
+
+            glm::vec2 texCoord(0.0f, 0.0f);
+            if (mesh.HasTextureCoords(0)) {
+                const aiVector3D& uv = mesh.mTextureCoords[0][vertexIndex];
+                texCoord = glm::vec2(uv.x, uv.y);
+            }
+            model.texCoords[range.baseVertex + vertexIndex] = texCoord;
+        }
+    });
+
+    auto copyFace = [&](const aiFace& face, std::size_t outputIndex) {
+        model.indices[outputIndex] = range.baseVertex + face.mIndices[0];
+        model.indices[outputIndex + 1] = range.baseVertex + face.mIndices[1];
+        model.indices[outputIndex + 2] = range.baseVertex + face.mIndices[2];
+    };
+
+    // Only a triangle-only mesh maps face N to output slot N; anything else is compacted in order.
+    if (range.indexCount == mesh.mNumFaces * 3u) {
+        jobs.ParallelFor(mesh.mNumFaces, kFacesPerRange, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t faceIndex = begin; faceIndex < end; ++faceIndex) {
+                copyFace(mesh.mFaces[faceIndex], range.indexStart + faceIndex * 3);
+            }
+        });
+        return;
+    }
+
+    std::size_t outputIndex = range.indexStart;
+    for (unsigned int faceIndex = 0; faceIndex < mesh.mNumFaces; ++faceIndex) {
+        if (mesh.mFaces[faceIndex].mNumIndices == 3) {
+            copyFace(mesh.mFaces[faceIndex], outputIndex);
+            outputIndex += 3;
+        }
+    }
+}
+
+// Turns every anim mesh of the ranges into a sparse target, numbered range by range in the order
+// firstMorphTarget was assigned. Anim mesh positions replace the mesh's; the difference is moved
+// into model space with the range's transform.
+void ImportMorphTargets(const std::vector<MeshRange>& meshRanges, ModelData& model) {
+    struct TargetSource {
+        const MeshRange* range;
+        const aiAnimMesh* animMesh;
+    };
+    std::vector<TargetSource> sources;
+    for (const MeshRange& range : meshRanges) {
+        for (unsigned int animMeshIndex = 0; animMeshIndex < range.mesh->mNumAnimMeshes; ++animMeshIndex) {
+            sources.push_back(TargetSource{&range, range.mesh->mAnimMeshes[animMeshIndex]});
+        }
+    }
+
+    model.morphTargets.resize(sources.size());
+    JobSystem::Get().ParallelFor(sources.size(), 1, [&](std::size_t begin, std::size_t end) {
+        std::vector<glm::vec3> deltas;
+        for (std::size_t targetIndex = begin; targetIndex < end; ++targetIndex) {
+            const MeshRange& range = *sources[targetIndex].range;
+            const aiMesh& mesh = *range.mesh;
+            const aiAnimMesh* animMesh = sources[targetIndex].animMesh;
+            std::string name = animMesh && animMesh->mName.length > 0 ? animMesh->mName.C_Str() : ("Morph " + std::to_string(targetIndex + 1));
+            if (!IsUsableAnimMesh(mesh, animMesh)) {
+                model.morphTargets[targetIndex] = MorphTarget{std::move(name), {}, {}, 0.0f, 0.0f};
+                continue;
+            }
+
+            const aiMatrix3x3 linear(range.transform);
+            deltas.resize(mesh.mNumVertices);
+            for (unsigned int vertexIndex = 0; vertexIndex < mesh.mNumVertices; ++vertexIndex) {
+                const aiVector3D delta = linear * (animMesh->mVertices[vertexIndex] - mesh.mVertices[vertexIndex]);
+                deltas[vertexIndex] = glm::vec3(delta.x, delta.y, delta.z);
+            }
+            model.morphTargets[targetIndex] = QuantizeMorphTarget(std::move(name), deltas, range.baseVertex, animMesh->mWeight);
+        }
+    });
+}
+
+// Weight curves of one animation. A channel is matched to mesh instances by mesh or node name; its
+// key values index the matched mesh's anim meshes.
+std::vector<MorphWeightCurve> ImportMorphCurves(
+    const aiAnimation& animation,
+    double ticksPerSecond,
+    const std::vector<MeshRange>& meshRanges) {
+    std::vector<const MeshRange*> morphedRanges;
+    for (const MeshRange& range : meshRanges) {
+        if (range.mesh->mNumAnimMeshes > 0) {
+            morphedRanges.push_back(&range);
+        }
+    }
+
+    std::map<std::uint32_t, std::vector<MorphWeightKey>> keysByTarget;
+    for (unsigned int channelIndex = 0; channelIndex < animation.mNumMorphMeshChannels; ++channelIndex) {
+        const aiMeshMorphAnim* channel = animation.mMorphMeshChannels[channelIndex];
+        if (!channel) {
+            continue;
+        }
+
+        const std::string channelName = channel->mName.C_Str();
+        std::vector<const MeshRange*> matchedRanges;
+        for (const MeshRange* range : morphedRanges) {
+            if (channelName == range->mesh->mName.C_Str() || (range->node && channelName == range->node->mName.C_Str())) {
+                matchedRanges.push_back(range);
+            }
+        }
+        // Exporters disagree on what the channel is named after; with one morphed mesh there is no doubt.
+        if (matchedRanges.empty() && morphedRanges.size() == 1) {
+            matchedRanges.push_back(morphedRanges.front());
+        }
+
+        for (const MeshRange* range : matchedRanges) {
+            for (unsigned int keyIndex = 0; keyIndex < channel->mNumKeys; ++keyIndex) {
+                const aiMeshMorphKey& key = channel->mKeys[keyIndex];
+                const float timeSeconds = static_cast<float>(key.mTime / ticksPerSecond);
+                for (unsigned int valueIndex = 0; valueIndex < key.mNumValuesAndWeights; ++valueIndex) {
+                    if (key.mValues[valueIndex] < range->mesh->mNumAnimMeshes) {
+                        keysByTarget[range->firstMorphTarget + key.mValues[valueIndex]].push_back(
+                            MorphWeightKey{timeSeconds, static_cast<float>(key.mWeights[valueIndex])});
+                    }
+                }
+            }
+        }
+    }
+
+    std::vector<MorphWeightCurve> curves;
+    for (auto& [targetIndex, keys] : keysByTarget) {
+        std::stable_sort(keys.begin(), keys.end(), [](const MorphWeightKey& left, const MorphWeightKey& right) {
+            return left.timeSeconds < right.timeSeconds;
+        });
+        curves.push_back(MorphWeightCurve{targetIndex, std::move(keys)});
+    }
+    return curves;
+}
 }
 
 bool FbxLoader::LoadModel(const std::filesystem::path& filePath, ModelData& outModel, std::string& outError) {
-    Assimp::Importer importer;
-    const aiScene* scene = importer.ReadFile(
-        filePath.string(),
-        aiProcess_Triangulate |
-            aiProcess_JoinIdenticalVertices |
-            aiProcess_PreTransformVertices |
-            aiProcess_SortByPType |
-            aiProcess_ImproveCacheLocality);
+    return LoadModel(filePath, kFullModelLoadRequest, outModel, outError);
+}
 
+bool FbxLoader::LoadModel(
+    const std::filesystem::path& filePath,
+    const ModelLoadRequest& request,
+    ModelData& outModel,
+    std::string& outError) {
+    Assimp::Importer importer;
+    // Let the FBX parser skip sections nobody asked for instead of discarding them afterwards.
+    importer.SetPropertyBool(AI_CONFIG_IMPORT_FBX_READ_MATERIALS, request.materials);
+    importer.SetPropertyBool(AI_CONFIG_IMPORT_FBX_READ_TEXTURES, request.materials);
+    importer.SetPropertyBool(AI_CONFIG_IMPORT_FBX_READ_ANIMATIONS, request.animations);
+    const aiScene* scene = importer.ReadFile(filePath.string(), 0);
     if (!scene || (scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE) != 0 || !scene->mRootNode) {
         outError = importer.GetErrorString();
         return false;
     }
 
+    // aiProcess_PreTransformVertices merges meshes, dropping their anim meshes, and removes every
+    // animation. Clips are therefore read first, and files with blend shapes skip that step and
+    // have their node transforms applied below instead.
+    const bool keepMorphTargets = request.animations && HasMorphTargets(*scene);
+    constexpr unsigned int kMeshSteps =
+        aiProcess_Triangulate | aiProcess_JoinIdenticalVertices | aiProcess_SortByPType | aiProcess_ImproveCacheLocality;
+    const unsigned int animationCount = request.animations ? scene->mNumAnimations : 0;
+    std::vector<AnimationClip> animations;
+    std::vector<double> animationTicksPerSecond;
+    for (unsigned int animationIndex = 0; animationIndex < animationCount; ++animationIndex) {
+        const aiAnimation* animation = scene->mAnimations[animationIndex];
+        const double ticksPerSecond = animation && animation->mTicksPerSecond > 0.0 ? animation->mTicksPerSecond : 25.0;
+        animationTicksPerSecond.push_back(ticksPerSecond);
+        if (!animation) {
+            continue;
+        }
+
+        const double durationSeconds = animation->mDuration > 0.0 ? (animation->mDuration / ticksPerSecond) : 0.0;
+
+        AnimationClip clip;
+        clip.name = animation->mName.length > 0 ? animation->mName.C_Str() : ("Animation " + std::to_string(animationIndex + 1));
+        clip.durationSeconds = static_cast<float>(durationSeconds);
+        clip.ticksPerSecond = static_cast<float>(ticksPerSecond);
+        animations.push_back(std::move(clip));
+    }
+
+    scene = importer.ApplyPostProcessing(keepMorphTargets ? kMeshSteps : kMeshSteps | aiProcess_PreTransformVertices);
+    if (!scene) {
+        outError = importer.GetErrorString();
+        return false;
+    }
+
     outModel.positions.clear();
     outModel.texCoords.clear();
     outModel.indices.clear();
     outModel.primaryTexturePath.clear();
     outModel.texturePaths.clear();
+    outModel.materials.clear();
     outModel.submeshes.clear();
     outModel.animations.clear();
+    outModel.morphTargets.clear();
+    outModel.textureSearchDirectories.clear();
+    outModel.unresolvedTextureIndices.clear();
     outModel.sourcePath = filePath.string();
 
     std::unordered_map<std::string, std::int32_t> textureLookup;
@@ -74,6 +341,8 @@ bool FbxLoader::LoadModel(const std::filesystem::path& filePath, ModelData& outM
         return textureIndex;
     };
 
+    TexturePathResolver texturePathResolver(filePath.parent_path());
+    std::unordered_set<std::string> unresolvedTexturePaths;
     auto resolveMaterialTexturePath = [&](unsigned int materialIndex, aiTextureType textureType) -> std::string {
         if (materialIndex >= scene->mNumMaterials) {
             return {};
@@ -91,88 +360,65 @@ bool FbxLoader::LoadModel(const std::filesystem::path& filePath, ModelData& outM
                 continue;
             }
 
-            std::filesystem::path candidate(texturePath.C_Str());
-            if (candidate.is_relative()) {
-                candidate = filePath.parent_path() / candidate;
-            }
-
-            const std::filesystem::path normalized = candidate.lexically_normal();
-            if (std::filesystem::exists(normalized)) {
-                return normalized.string();
+            const std::filesystem::path resolved = texturePathResolver.Resolve(texturePath.C_Str());
+            if (!resolved.empty()) {
+                return resolved.string();
             }
 
+            // Keep the first reference even when it is missing so the load can report it.
             if (textureIndex == 0) {
-                return normalized.string();
+                std::filesystem::path candidate(texturePath.C_Str());
+                if (candidate.is_relative()) {
+                    candidate = filePath.parent_path() / candidate;
+                }
+                std::string unresolvedPath = candidate.lexically_normal().string();
+                unresolvedTexturePaths.insert(unresolvedPath);
+                return unresolvedPath;
             }
         }
 
         return {};
     };
 
-    for (unsigned int meshIndex = 0; meshIndex < scene->mNumMeshes; ++meshIndex) {
-        const aiMesh* mesh = scene->mMeshes[meshIndex];
-        if (!mesh || mesh->mNumVertices == 0 || mesh->mNumFaces == 0) {
-            continue;
-        }
-
-        const std::uint32_t baseVertex = static_cast<std::uint32_t>(outModel.positions.size());
-
-        for (unsigned int vertexIndex = 0; vertexIndex < mesh->mNumVertices; ++vertexIndex) {
-            const aiVector3D& vertex = mesh->mVertices[vertexIndex];
-            outModel.positions.emplace_back(vertex.x, vertex.y, vertex.z);
-
-            if (mesh->HasTextureCoords(0)) {
-                const aiVector3D& uv = mesh->mTextureCoords[0][vertexIndex];
-                outModel.texCoords.emplace_back(uv.x, uv.y);
-            } else {
-                outModel.texCoords.emplace_back(0.0f, 0.0f);
+    auto resolveFirstMaterialTexturePath = [&](unsigned int materialIndex, std::initializer_list<aiTextureType> textureTypes) -> std::string {
+        for (const aiTextureType textureType : textureTypes) {
+            std::string texturePath = resolveMaterialTexturePath(materialIndex, textureType);
+            if (!texturePath.empty()) {
+                return texturePath;
             }
         }
+        return {};
+    };
 
-        const std::uint32_t indexStart = static_cast<std::uint32_t>(outModel.indices.size());
-        for (unsigned int faceIndex = 0; faceIndex < mesh->mNumFaces; ++faceIndex) {
-            const aiFace& face = mesh->mFaces[faceIndex];
-            if (face.mNumIndices != 3) {
-                continue;
-            }
-
-            outModel.indices.push_back(baseVertex + face.mIndices[0]);
-            outModel.indices.push_back(baseVertex + face.mIndices[1]);
-            outModel.indices.push_back(baseVertex + face.mIndices[2]);
+    std::vector<std::int32_t> materialLookup(scene->mNumMaterials, -1);
+    std::int32_t missingMaterialIndex = -1;
+    auto resolveMaterial = [&](unsigned int materialIndex) -> std::uint32_t {
+        if (!request.materials) {
+            return std::numeric_limits<std::uint32_t>::max();
         }
 
-        const std::uint32_t indexCount = static_cast<std::uint32_t>(outModel.indices.size()) - indexStart;
-        if (indexCount == 0) {
-            continue;
+        std::int32_t& cachedIndex = materialIndex < materialLookup.size() ? materialLookup[materialIndex] : missingMaterialIndex;
+        if (cachedIndex >= 0) {
+            return static_cast<std::uint32_t>(cachedIndex);
         }
 
-        auto resolveFirstMaterialTexturePath = [&](unsigned int materialIndex, std::initializer_list<aiTextureType> textureTypes) -> std::string {
-            for (const aiTextureType textureType : textureTypes) {
-                std::string texturePath = resolveMaterialTexturePath(materialIndex, textureType);
-                if (!texturePath.empty()) {
-                    return texturePath;
-                }
-            }
-            return {};
-        };
-
         const std::string texturePath = resolveFirstMaterialTexturePath(
-            mesh->mMaterialIndex,
+            materialIndex,
             {aiTextureType_DIFFUSE, aiTextureType_BASE_COLOR});
-        const std::string opacityTexturePath = resolveMaterialTexturePath(mesh->mMaterialIndex, aiTextureType_OPACITY);
+        const std::string opacityTexturePath = resolveMaterialTexturePath(materialIndex, aiTextureType_OPACITY);
         const std::string normalTexturePath = resolveFirstMaterialTexturePath(
-            mesh->mMaterialIndex,
+            materialIndex,
             {aiTextureType_NORMAL_CAMERA, aiTextureType_NORMALS, aiTextureType_HEIGHT});
-        const std::string emissiveTexturePath = resolveMaterialTexturePath(mesh->mMaterialIndex, aiTextureType_EMISSIVE);
-        const std::string specularTexturePath = resolveMaterialTexturePath(mesh->mMaterialIndex, aiTextureType_SPECULAR);
+        const std::string emissiveTexturePath = resolveMaterialTexturePath(materialIndex, aiTextureType_EMISSIVE);
+        const std::string specularTexturePath = resolveMaterialTexturePath(materialIndex, aiTextureType_SPECULAR);
         if (outModel.primaryTexturePath.empty() && !texturePath.empty()) {
             outModel.primaryTexturePath = texturePath;
         }
 
         float materialOpacity = 1.0f;
         const bool materialHasOpacityTexture = !opacityTexturePath.empty();
-        if (mesh->mMaterialIndex < scene->mNumMaterials) {
-            const aiMaterial* material = scene->mMaterials[mesh->mMaterialIndex];
+        if (materialIndex < scene->mNumMaterials) {
+            const aiMaterial* material = scene->mMaterials[materialIndex];
             if (material) {
                 const bool hasOpacityProperty = material->Get(AI_MATKEY_OPACITY, materialOpacity) == aiReturn_SUCCESS;
 
@@ -217,9 +463,8 @@ bool FbxLoader::LoadModel(const std::filesystem::path& filePath, ModelData& outM
         const std::int32_t normalTextureIndex = registerTexturePath(normalTexturePath);
         const std::int32_t emissiveTextureIndex = registerTexturePath(emissiveTexturePath);
         const std::int32_t specularTextureIndex = registerTexturePath(specularTexturePath);
-        outModel.submeshes.push_back(ModelSubmesh{
-            indexStart,
-            indexCount,
+        cachedIndex = static_cast<std::int32_t>(outModel.materials.size());
+        outModel.materials.push_back(ModelMaterial{
             textureIndex,
             opacityTextureIndex,
             normalTextureIndex,
@@ -230,13 +475,63 @@ bool FbxLoader::LoadModel(const std::filesystem::path& filePath, ModelData& outM
             isTransparent,
             alphaCutoutEnabled,
             opacityTextureInverted});
+        return static_cast<std::uint32_t>(cachedIndex);
+    };
+
+    // Materials are resolved serially in mesh order so texture and material indices stay stable;
+    // the geometry is then copied into its precomputed ranges in parallel.
+    // Without pre-transformation, every placement of a mesh in the node graph gets its own copy.
+    std::vector<MeshInstance> meshInstances;
+    if (keepMorphTargets) {
+        CollectMeshInstances(*scene->mRootNode, aiMatrix4x4(), meshInstances);
+    } else {
+        for (unsigned int meshIndex = 0; meshIndex < scene->mNumMeshes; ++meshIndex) {
+            meshInstances.push_back(MeshInstance{nullptr, meshIndex, aiMatrix4x4()});
+        }
     }
 
-    if (outModel.submeshes.empty() && !outModel.indices.empty()) {
-        const std::int32_t fallbackTextureIndex = registerTexturePath(outModel.primaryTexturePath);
+    std::vector<MeshRange> meshRanges;
+    std::uint32_t vertexCount = 0;
+    std::uint32_t indexCount = 0;
+    std::uint32_t morphTargetCount = 0;
+    for (const MeshInstance& instance : meshInstances) {
+        const aiMesh* mesh = instance.meshIndex < scene->mNumMeshes ? scene->mMeshes[instance.meshIndex] : nullptr;
+        if (!mesh || mesh->mNumVertices == 0 || mesh->mNumFaces == 0) {
+            continue;
+        }
+
+        const std::uint32_t meshIndexCount = CountTriangles(*mesh) * 3;
+        meshRanges.push_back(MeshRange{mesh, instance.node, instance.transform, vertexCount, indexCount, meshIndexCount, morphTargetCount});
+        if (meshIndexCount > 0) {
+            outModel.submeshes.push_back(ModelSubmesh{indexCount, meshIndexCount, resolveMaterial(mesh->mMaterialIndex)});
+        }
+        vertexCount += mesh->mNumVertices;
+        indexCount += meshIndexCount;
+        morphTargetCount += keepMorphTargets ? mesh->mNumAnimMeshes : 0;
+    }
+
+    outModel.positions.resize(vertexCount);
+    if (request.texCoords) {
+        outModel.texCoords.resize(vertexCount);
+    }
+    outModel.indices.resize(indexCount);
+    JobSystem::Get().ParallelFor(meshRanges.size(), 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t rangeIndex = begin; rangeIndex < end; ++rangeIndex) {
+            CopyMeshGeometry(meshRanges[rangeIndex], request.texCoords, outModel);
+        }
+    });
+    if (keepMorphTargets) {
+        ImportMorphTargets(meshRanges, outModel);
+    }
+
+    if (outModel.submeshes.empty() && !outModel.indices.empty() && !request.materials) {
         outModel.submeshes.push_back(ModelSubmesh{
             0,
             static_cast<std::uint32_t>(outModel.indices.size()),
+            std::numeric_limits<std::uint32_t>::max()});
+    } else if (outModel.submeshes.empty() && !outModel.indices.empty()) {
+        const std::int32_t fallbackTextureIndex = registerTexturePath(outModel.primaryTexturePath);
+        outModel.materials.push_back(ModelMaterial{
             fallbackTextureIndex,
             -1,
             -1,
@@ -247,23 +542,29 @@ bool FbxLoader::LoadModel(const std::filesystem::path& filePath, ModelData& outM
             false,
             false,
             false});
+        outModel.submeshes.push_back(ModelSubmesh{
+            0,
+            static_cast<std::uint32_t>(outModel.indices.size()),
+            static_cast<std::uint32_t>(outModel.materials.size() - 1)});
     }
-
-    for (unsigned int animationIndex = 0; animationIndex < scene->mNumAnimations; ++animationIndex) {
-        const aiAnimation* animation = scene->mAnimations[animationIndex];
-        if (!animation) {
-            continue;
+    outModel.textureSearchDirectories = texturePathResolver.GetListedDirectories();
+    for (std::size_t textureIndex = 0; textureIndex < outModel.texturePaths.size(); ++textureIndex) {
+        if (unresolvedTexturePaths.contains(outModel.texturePaths[textureIndex])) {
+            outModel.unresolvedTextureIndices.push_back(static_cast<std::uint32_t>(textureIndex));
         }
+    }
 
-        const double ticksPerSecond = animation->mTicksPerSecond > 0.0 ? animation->mTicksPerSecond : 25.0;
-        const double durationSeconds = animation->mDuration > 0.0 ? (animation->mDuration / ticksPerSecond) : 0.0;
-
-        AnimationClip clip;
-        clip.name = animation->mName.length > 0 ? animation->mName.C_Str() : ("Animation " + std::to_string(animationIndex + 1));
-        clip.durationSeconds = static_cast<float>(durationSeconds);
-        clip.ticksPerSecond = static_cast<float>(ticksPerSecond);
-        outModel.animations.push_back(std::move(clip));
+    // Animations are still in the scene when the meshes were not pre-transformed.
+    if (keepMorphTargets) {
+        std::size_t clipIndex = 0;
+        for (unsigned int animationIndex = 0; animationIndex < animationCount; ++animationIndex) {
+            const aiAnimation* animation = scene->mAnimations[animationIndex];
+            if (animation) {
+                animations[clipIndex++].morphCurves = ImportMorphCurves(*animation, animationTicksPerSecond[animationIndex], meshRanges);
+            }
+        }
     }
+    outModel.animations = std::move(animations);
 
     if (!outModel.IsValid()) {
         outError = "FBX load succeeded but no triangle geometry was found.";
@@ -0,0 +1,227 @@
+#include "Engine/FileWatcher.hpp"
+
+#include <array>
+#include <cstring>
+#include <system_error>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace engine {
+namespace {
+#if defined(__linux__)
+// Only finished writes and renames into the directory; creating a file and writing it is reported
+// by the close that follows.
+constexpr std::uint32_t kDirectoryWatchMask = IN_CLOSE_WRITE | IN_MOVED_TO;
+#endif
+
+std::filesystem::path NormalizeWatchPath(const std::filesystem::path& path) {
+    std::error_code error;
+    const std::filesystem::path absolutePath = std::filesystem::absolute(path, error);
+    return (error ? path : absolutePath).lexically_normal();
+}
+
+void ReadFileStamp(const std::filesystem::path& path, std::uintmax_t& outFileSize, std::int64_t& outLastWriteTicks) {
+    std::error_code error;
+    outFileSize = std::filesystem::file_size(path, error);
+    if (error) {
+        outFileSize = 0;
+    }
+
+    const std::filesystem::file_time_type lastWrite = std::filesystem::last_write_time(path, error);
+    outLastWriteTicks = error ? 0 : static_cast<std::int64_t>(lastWrite.time_since_epoch().count());
+}
+}
+
+FileWatcher::FileWatcher(std::chrono::milliseconds debounce)
+    : debounce_(debounce),
+      lastPollTime_(),
+      notifyHandle_(-1) {
+#if defined(__linux__)
+    notifyHandle_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif
+}
+
+FileWatcher::~FileWatcher() {
+    CloseNotifications();
+}
+
+void FileWatcher::Watch(const std::vector<std::filesystem::path>& files) {
+    Clear();
+
+    for (const std::filesystem::path& file : files) {
+        if (file.empty()) {
+            continue;
+        }
+
+        const std::filesystem::path normalized = NormalizeWatchPath(file);
+        WatchedFile watched{file, normalized, 0, 0, false, true, Clock::time_point()};
+        ReadFileStamp(normalized, watched.fileSize, watched.lastWriteTicks);
+        files_.emplace(normalized.generic_string(), std::move(watched));
+    }
+
+#if defined(__linux__)
+    if (notifyHandle_ >= 0) {
+        // Files in a directory inotify cannot watch (missing, or out of watches) stay polled.
+        std::unordered_map<std::string, bool> watchedDirectories;
+        for (auto& [key, watched] : files_) {
+            const std::filesystem::path directory = watched.path.parent_path();
+            const auto [entry, inserted] = watchedDirectories.emplace(directory.generic_string(), false);
+            if (inserted) {
+                entry->second = WatchDirectory(directory);
+            }
+            watched.polled = !entry->second;
+        }
+    }
+#endif
+}
+
+void FileWatcher::Clear() noexcept {
+#if defined(__linux__)
+    for (const auto& [watchDescriptor, directory] : directoryWatches_) {
+        inotify_rm_watch(notifyHandle_, watchDescriptor);
+    }
+#endif
+    directoryWatches_.clear();
+    files_.clear();
+}
+
+std::vector<std::filesystem::path> FileWatcher::PollChanges() {
+    const Clock::time_point now = Clock::now();
+    if (IsUsingNotifications()) {
+        ReadNotifications(now);
+    }
+    if (now - lastPollTime_ >= kPollInterval) {
+        lastPollTime_ = now;
+        PollTimestamps(now);
+    }
+
+    std::vector<std::filesystem::path> changes;
+    for (auto& [key, watched] : files_) {
+        if (watched.pending && now - watched.lastEventTime >= debounce_) {
+            watched.pending = false;
+            ReadFileStamp(watched.path, watched.fileSize, watched.lastWriteTicks);
+            changes.push_back(watched.requestedPath);
+        }
+    }
+    return changes;
+}
+
+bool FileWatcher::IsUsingNotifications() const noexcept {
+    return notifyHandle_ >= 0;
+}
+
+std::size_t FileWatcher::GetWatchedFileCount() const noexcept {
+    return files_.size();
+}
+
+void FileWatcher::ReadNotifications(Clock::time_point now) {
+#if defined(__linux__)
+    alignas(inotify_event) std::array<char, 4096> buffer;
+    for (;;) {
+        const ssize_t bytesRead = read(notifyHandle_, buffer.data(), buffer.size());
+        if (bytesRead <= 0) {
+            break;
+        }
+
+        for (ssize_t offset = 0; offset < bytesRead;) {
+            inotify_event event;
+            std::memcpy(&event, buffer.data() + offset, sizeof(event));
+            const char* name = buffer.data() + offset + sizeof(inotify_event);
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event.len);
+
+            // Events were dropped, so any watched file may have changed.
+            if ((event.mask & IN_Q_OVERFLOW) != 0) {
+                for (auto& [key, watched] : files_) {
+                    watched.pending = true;
+                    watched.lastEventTime = now;
+                }
+                continue;
+            }
+
+            const auto directory = directoryWatches_.find(event.wd);
+            if (directory == directoryWatches_.end()) {
+                continue;
+            }
+            if ((event.mask & IN_IGNORED) != 0) {
+                const std::filesystem::path ignoredDirectory = directory->second;
+                directoryWatches_.erase(directory);
+                RewatchDirectory(ignoredDirectory, now);
+                continue;
+            }
+            if (event.len == 0) {
+                continue;
+            }
+
+            const auto watched = files_.find((directory->second / name).generic_string());
+            if (watched != files_.end()) {
+                watched->second.pending = true;
+                watched->second.lastEventTime = now;
+            }
+        }
+    }
+#else
+    static_cast<void>(now);
+#endif
+}
+
+bool FileWatcher::WatchDirectory(const std::filesystem::path& directory) {
+#if defined(__linux__)
+    const int watchDescriptor = inotify_add_watch(notifyHandle_, directory.c_str(), kDirectoryWatchMask);
+    if (watchDescriptor >= 0) {
+        directoryWatches_[watchDescriptor] = directory;
+        return true;
+    }
+#else
+    static_cast<void>(directory);
+#endif
+    return false;
+}
+
+void FileWatcher::RewatchDirectory(const std::filesystem::path& directory, Clock::time_point now) {
+    // The kernel dropped the watch because the directory was deleted, moved or unmounted. If it is
+    // back already its files may have been replaced, so they are reported; otherwise they are polled.
+    const bool watching = WatchDirectory(directory);
+    for (auto& [key, watched] : files_) {
+        if (watched.path.parent_path() != directory) {
+            continue;
+        }
+
+        watched.polled = !watching;
+        if (watching) {
+            watched.pending = true;
+            watched.lastEventTime = now;
+        }
+    }
+}
+
+void FileWatcher::PollTimestamps(Clock::time_point now) {
+    for (auto& [key, watched] : files_) {
+        if (!watched.polled) {
+            continue;
+        }
+
+        std::uintmax_t fileSize = 0;
+        std::int64_t lastWriteTicks = 0;
+        ReadFileStamp(watched.path, fileSize, lastWriteTicks);
+        if (fileSize != watched.fileSize || lastWriteTicks != watched.lastWriteTicks) {
+            watched.fileSize = fileSize;
+            watched.lastWriteTicks = lastWriteTicks;
+            watched.pending = true;
+            watched.lastEventTime = now;
+        }
+    }
+}
+
+void FileWatcher::CloseNotifications() noexcept {
+    Clear();
+#if defined(__linux__)
+    if (notifyHandle_ >= 0) {
+        close(notifyHandle_);
+        notifyHandle_ = -1;
+    }
+#endif
+}
+}
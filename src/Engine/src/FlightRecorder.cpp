@@ -0,0 +1,345 @@
+#include "Engine/FlightRecorder.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <limits>
+#include <system_error>
+#include <SDL3/SDL.h>
+
+namespace engine {
+namespace {
+constexpr std::uint32_t kNoPhase = std::numeric_limits<std::uint32_t>::max();
+constexpr std::uint64_t kPhaseOpen = std::numeric_limits<std::uint64_t>::max();
+constexpr const char* kUntrackedPhase = "(untracked)";
+
+std::uint64_t SteadyClockNanoseconds() {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+double ToMilliseconds(std::uint64_t nanoseconds) {
+    return static_cast<double>(nanoseconds) / 1.0e6;
+}
+
+std::uint64_t PhaseDuration(const FlightRecorderPhase& phase) {
+    return phase.endNanoseconds - phase.startNanoseconds;
+}
+}
+
+const FlightRecorderSettings& GetDefaultFlightRecorderSettings() {
+    static const FlightRecorderSettings settings = []() {
+        std::error_code tempDirectoryError;
+        const std::filesystem::path tempDirectory = std::filesystem::temp_directory_path(tempDirectoryError);
+        FlightRecorderSettings defaults{
+            600,
+            0.2,
+            5.0,
+            (tempDirectoryError ? std::filesystem::path(".") : tempDirectory) / "EngineHitches"};
+        if (const char* budget = SDL_getenv("ENGINE_HITCH_BUDGET_MS")) {
+            const double parsed = std::atof(budget);
+            if (parsed >= 0.0) {
+                defaults.hitchBudgetSeconds = parsed / 1000.0;
+            }
+        }
+        if (const char* directory = SDL_getenv("ENGINE_HITCH_DIRECTORY")) {
+            if (directory[0] != '\0') {
+                defaults.dumpDirectory = directory;
+            }
+        }
+        return defaults;
+    }();
+    return settings;
+}
+
+FlightRecorder::FlightRecorder(const FlightRecorderSettings& settings)
+    : settings_(settings),
+      frames_(std::max<std::size_t>(settings.frameCapacity, 1)),
+      nextIndex_(0),
+      size_(0),
+      frameOpen_(false),
+      openDepth_(0),
+      frameStartNanoseconds_(0),
+      lastDumpNanoseconds_(0),
+      dumpedBefore_(false),
+      clock_(&SteadyClockNanoseconds) {}
+
+FlightRecorder& FlightRecorder::Get() {
+    static FlightRecorder recorder;
+    return recorder;
+}
+
+void FlightRecorder::BeginFrame(std::uint64_t frameIndex) noexcept {
+    FlightRecorderFrame& frame = frames_[nextIndex_];
+    frame.frameIndex = frameIndex;
+    frame.durationNanoseconds = 0;
+    frame.excusedNanoseconds = 0;
+    frame.phaseCount = 0;
+    frame.eventCount = 0;
+    frame.droppedCount = 0;
+    frameOpen_ = true;
+    openDepth_ = 0;
+    frameStartNanoseconds_ = clock_();
+}
+
+bool FlightRecorder::EndFrame(FlightRecorderDump& outDump) {
+    if (!frameOpen_) {
+        return false;
+    }
+
+    const std::uint64_t now = clock_();
+    FlightRecorderFrame& frame = CurrentFrame();
+    frame.durationNanoseconds = now - frameStartNanoseconds_;
+    for (std::uint32_t phaseIndex = 0; phaseIndex < frame.phaseCount; ++phaseIndex) {
+        if (frame.phases[phaseIndex].endNanoseconds == kPhaseOpen) {
+            frame.phases[phaseIndex].endNanoseconds = frame.durationNanoseconds;
+        }
+    }
+    frameOpen_ = false;
+    openDepth_ = 0;
+    nextIndex_ = (nextIndex_ + 1) % frames_.size();
+    size_ = std::min(size_ + 1, frames_.size());
+
+    const std::uint64_t countedNanoseconds = frame.durationNanoseconds - std::min(frame.excusedNanoseconds, frame.durationNanoseconds);
+    if (settings_.hitchBudgetSeconds <= 0.0 || static_cast<double>(countedNanoseconds) <= settings_.hitchBudgetSeconds * 1.0e9) {
+        return false;
+    }
+    if (dumpedBefore_ && static_cast<double>(now - lastDumpNanoseconds_) < settings_.minimumSecondsBetweenDumps * 1.0e9) {
+        return false;
+    }
+
+    dumpedBefore_ = true;
+    lastDumpNanoseconds_ = now;
+    FillDump(outDump);
+    return true;
+}
+
+std::uint32_t FlightRecorder::BeginPhase(const char* name, bool excused) noexcept {
+    if (!frameOpen_) {
+        return kNoPhase;
+    }
+
+    FlightRecorderFrame& frame = CurrentFrame();
+    if (frame.phaseCount >= FlightRecorderFrame::kMaxPhases) {
+        ++frame.droppedCount;
+        return kNoPhase;
+    }
+
+    const std::uint32_t phaseIndex = frame.phaseCount++;
+    frame.phases[phaseIndex] = FlightRecorderPhase{name, openDepth_++, excused, clock_() - frameStartNanoseconds_, kPhaseOpen};
+    return phaseIndex;
+}
+
+void FlightRecorder::EndPhase(std::uint32_t phaseIndex) noexcept {
+    if (!frameOpen_ || phaseIndex >= CurrentFrame().phaseCount) {
+        return;
+    }
+
+    FlightRecorderFrame& frame = CurrentFrame();
+    FlightRecorderPhase& phase = frame.phases[phaseIndex];
+    if (phase.endNanoseconds != kPhaseOpen) {
+        return;
+    }
+
+    phase.endNanoseconds = clock_() - frameStartNanoseconds_;
+    openDepth_ = phase.depth;
+    // Only the outermost excused phase counts, so nested ones are not subtracted twice.
+    bool insideExcusedPhase = false;
+    for (std::uint32_t index = 0; index < phaseIndex; ++index) {
+        const FlightRecorderPhase& enclosing = frame.phases[index];
+        insideExcusedPhase = insideExcusedPhase ||
+            (enclosing.excused && enclosing.endNanoseconds == kPhaseOpen && enclosing.depth < phase.depth);
+    }
+    if (phase.excused && !insideExcusedPhase) {
+        frame.excusedNanoseconds += PhaseDuration(phase);
+    }
+}
+
+void FlightRecorder::RecordEvent(std::string_view text) noexcept {
+    if (!frameOpen_) {
+        return;
+    }
+
+    FlightRecorderFrame& frame = CurrentFrame();
+    if (frame.eventCount >= FlightRecorderFrame::kMaxEvents) {
+        ++frame.droppedCount;
+        return;
+    }
+
+    FlightRecorderEvent& event = frame.events[frame.eventCount++];
+    event.offsetNanoseconds = clock_() - frameStartNanoseconds_;
+    const std::size_t length = std::min(text.size(), event.text.size() - 1);
+    std::copy_n(text.data(), length, event.text.data());
+    event.text[length] = '\0';
+}
+
+void FlightRecorder::SetHitchBudget(double seconds) noexcept {
+    settings_.hitchBudgetSeconds = seconds;
+}
+
+const FlightRecorderSettings& FlightRecorder::GetSettings() const noexcept {
+    return settings_;
+}
+
+std::size_t FlightRecorder::GetRecordedFrameCount() const noexcept {
+    return size_;
+}
+
+void FlightRecorder::SetClock(ClockFunction clock) noexcept {
+    clock_ = clock ? clock : &SteadyClockNanoseconds;
+}
+
+FlightRecorderFrame& FlightRecorder::CurrentFrame() noexcept {
+    return frames_[nextIndex_];
+}
+
+void FlightRecorder::FillDump(FlightRecorderDump& outDump) const {
+    outDump.frames.clear();
+    outDump.frames.reserve(size_);
+    const std::size_t oldest = (nextIndex_ + frames_.size() - size_) % frames_.size();
+    for (std::size_t offset = 0; offset < size_; ++offset) {
+        outDump.frames.push_back(frames_[(oldest + offset) % frames_.size()]);
+    }
+    outDump.budgetSeconds = settings_.hitchBudgetSeconds;
+
+    // Blame the phase with the most time of its own: its duration less that of its direct
+    // children. Phases are stored in start order, so children follow their parent.
+    const FlightRecorderFrame& hitch = outDump.frames.back();
+    std::uint64_t trackedNanoseconds = 0;
+    outDump.triggerPhase = kUntrackedPhase;
+    outDump.triggerNanoseconds = 0;
+    for (std::uint32_t phaseIndex = 0; phaseIndex < hitch.phaseCount; ++phaseIndex) {
+        const FlightRecorderPhase& phase = hitch.phases[phaseIndex];
+        if (phase.depth == 0) {
+            trackedNanoseconds += PhaseDuration(phase);
+        }
+
+        std::uint64_t childNanoseconds = 0;
+        for (std::uint32_t childIndex = phaseIndex + 1; childIndex < hitch.phaseCount && hitch.phases[childIndex].depth > phase.depth; ++childIndex) {
+            if (hitch.phases[childIndex].depth == phase.depth + 1) {
+                childNanoseconds += PhaseDuration(hitch.phases[childIndex]);
+            }
+        }
+        const std::uint64_t selfNanoseconds = PhaseDuration(phase) - std::min(childNanoseconds, PhaseDuration(phase));
+        if (!phase.excused && selfNanoseconds > outDump.triggerNanoseconds) {
+            outDump.triggerPhase = phase.name;
+            outDump.triggerNanoseconds = selfNanoseconds;
+        }
+    }
+
+    const std::uint64_t untrackedNanoseconds = hitch.durationNanoseconds - std::min(trackedNanoseconds, hitch.durationNanoseconds);
+    if (untrackedNanoseconds > outDump.triggerNanoseconds) {
+        outDump.triggerPhase = kUntrackedPhase;
+        outDump.triggerNanoseconds = untrackedNanoseconds;
+    }
+}
+
+ScopedFramePhase::ScopedFramePhase(FlightRecorder& recorder, const char* name, bool excused) noexcept
+    : recorder_(recorder),
+      phaseIndex_(recorder.BeginPhase(name, excused)) {}
+
+ScopedFramePhase::ScopedFramePhase(const char* name, bool excused) noexcept
+    : ScopedFramePhase(FlightRecorder::Get(), name, excused) {}
+
+ScopedFramePhase::~ScopedFramePhase() {
+    recorder_.EndPhase(phaseIndex_);
+}
+
+bool WriteFlightRecorderDump(
+    const FlightRecorderDump& dump,
+    const std::filesystem::path& directory,
+    std::filesystem::path& outPath,
+    std::string& outError) {
+    if (dump.frames.empty()) {
+        outError = "The dump holds no frames.";
+        return false;
+    }
+
+    std::error_code directoryError;
+    std::filesystem::create_directories(directory, directoryError);
+    if (directoryError) {
+        outError = "Failed to create " + directory.string() + ": " + directoryError.message();
+        return false;
+    }
+
+    const FlightRecorderFrame& hitch = dump.frames.back();
+    const std::time_t now = std::time(nullptr);
+    std::tm localTime{};
+#if defined(_WIN32)
+    localtime_s(&localTime, &now);
+#else
+    localtime_r(&now, &localTime);
+#endif
+    char fileName[96];
+    const std::size_t timeLength = std::strftime(fileName, sizeof(fileName), "hitch-%Y%m%d-%H%M%S", &localTime);
+    std::snprintf(
+        fileName + timeLength,
+        sizeof(fileName) - timeLength,
+        "-frame%llu.txt",
+        static_cast<unsigned long long>(hitch.frameIndex));
+    outPath = directory / fileName;
+
+    std::ofstream file(outPath, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        outError = "Failed to open " + outPath.string() + " for writing.";
+        return false;
+    }
+
+    char line[256];
+    std::snprintf(
+        line,
+        sizeof(line),
+        "Hitch: frame %llu took %.3f ms against a %.3f ms budget (%.3f ms excused).\nTrigger: %s, %.3f ms of its own.\n",
+        static_cast<unsigned long long>(hitch.frameIndex),
+        ToMilliseconds(hitch.durationNanoseconds),
+        dump.budgetSeconds * 1000.0,
+        ToMilliseconds(hitch.excusedNanoseconds),
+        dump.triggerPhase.c_str(),
+        ToMilliseconds(dump.triggerNanoseconds));
+    file << line;
+
+    for (const FlightRecorderFrame& frame : dump.frames) {
+        std::snprintf(
+            line,
+            sizeof(line),
+            "\nFrame %llu: %.3f ms\n",
+            static_cast<unsigned long long>(frame.frameIndex),
+            ToMilliseconds(frame.durationNanoseconds));
+        file << line;
+        for (std::uint32_t phaseIndex = 0; phaseIndex < frame.phaseCount; ++phaseIndex) {
+            const FlightRecorderPhase& phase = frame.phases[phaseIndex];
+            std::snprintf(
+                line,
+                sizeof(line),
+                "  %*s%-*s at %9.3f ms  %9.3f ms%s\n",
+                static_cast<int>(phase.depth * 2),
+                "",
+                std::max(1, 32 - static_cast<int>(phase.depth * 2)),
+                phase.name,
+                ToMilliseconds(phase.startNanoseconds),
+                ToMilliseconds(PhaseDuration(phase)),
+                phase.excused ? "  (excused)" : "");
+            file << line;
+        }
+        for (std::uint32_t eventIndex = 0; eventIndex < frame.eventCount; ++eventIndex) {
+            const FlightRecorderEvent& event = frame.events[eventIndex];
+            std::snprintf(line, sizeof(line), "  Event at %.3f ms: %s\n", ToMilliseconds(event.offsetNanoseconds), event.text.data());
+            file << line;
+        }
+        if (frame.droppedCount > 0) {
+            std::snprintf(line, sizeof(line), "  %u phase(s) or event(s) did not fit.\n", static_cast<unsigned>(frame.droppedCount));
+            file << line;
+        }
+    }
+
+    file.flush();
+    if (!file) {
+        outError = "Failed to write " + outPath.string() + ".";
+        return false;
+    }
+    return true;
+}
+}
@@ -0,0 +1,258 @@
+#include "ImageCodec.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+
+#include <SDL3/SDL.h>
+
+#if defined(_WIN32)
+#include <objbase.h>
+#include <wincodec.h>
+#include <windows.h>
+#endif
+
+namespace engine {
+namespace {
+#if defined(_WIN32)
+std::wstring Utf8ToWide(const std::string& input) {
+    if (input.empty()) {
+        return {};
+    }
+
+    const int requiredSize = MultiByteToWideChar(CP_UTF8, 0, input.c_str(), -1, nullptr, 0);
+    if (requiredSize <= 1) {
+        return {};
+    }
+
+    std::wstring output(static_cast<std::size_t>(requiredSize - 1), L'\0');
+    MultiByteToWideChar(CP_UTF8, 0, input.c_str(), -1, output.data(), requiredSize);
+    return output;
+}
+
+// Decodes the file at `widePath`, or the in-memory file at `data` when `widePath` is empty.
+bool DecodeImageWithWic(const std::wstring& widePath, const std::byte* data, std::size_t size, DecodedImage& outImage) {
+    if (widePath.empty() && (!data || size == 0 || size > MAXDWORD)) {
+        return false;
+    }
+
+    // Decoding may run on threads that never initialized COM; balance any successful initialization here.
+    const HRESULT comResult = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+    const bool comInitialized = SUCCEEDED(comResult);
+
+    bool decoded = false;
+    IWICImagingFactory* factory = nullptr;
+    IWICStream* stream = nullptr;
+    IWICBitmapDecoder* decoder = nullptr;
+    IWICBitmapFrameDecode* frame = nullptr;
+    IWICFormatConverter* converter = nullptr;
+    UINT width = 0;
+    UINT height = 0;
+
+    HRESULT result = CoCreateInstance(
+        CLSID_WICImagingFactory,
+        nullptr,
+        CLSCTX_INPROC_SERVER,
+        IID_PPV_ARGS(&factory));
+    if (SUCCEEDED(result) && factory && !widePath.empty()) {
+        result = factory->CreateDecoderFromFilename(
+            widePath.c_str(),
+            nullptr,
+            GENERIC_READ,
+            WICDecodeMetadataCacheOnLoad,
+            &decoder);
+    } else if (SUCCEEDED(result) && factory) {
+        result = factory->CreateStream(&stream);
+        if (SUCCEEDED(result) && stream) {
+            result = stream->InitializeFromMemory(reinterpret_cast<BYTE*>(const_cast<std::byte*>(data)), static_cast<DWORD>(size));
+        }
+        if (SUCCEEDED(result) && stream) {
+            result = factory->CreateDecoderFromStream(stream, nullptr, WICDecodeMetadataCacheOnLoad, &decoder);
+        }
+    }
+    if (SUCCEEDED(result) && decoder) {
+        result = decoder->GetFrame(0, &frame);
+    }
+    if (SUCCEEDED(result) && frame) {
+        result = factory->CreateFormatConverter(&converter);
+    }
+    if (SUCCEEDED(result) && converter) {
+        result = converter->Initialize(
+            frame,
+            GUID_WICPixelFormat32bppRGBA,
+            WICBitmapDitherTypeNone,
+            nullptr,
+            0.0f,
+            WICBitmapPaletteTypeCustom);
+    }
+    if (SUCCEEDED(result) && converter) {
+        result = converter->GetSize(&width, &height);
+    }
+    if (SUCCEEDED(result) && converter && width > 0 && height > 0) {
+        const UINT stride = width * 4;
+        outImage.pixels.resize(static_cast<std::size_t>(stride) * static_cast<std::size_t>(height));
+        result = converter->CopyPixels(nullptr, stride, static_cast<UINT>(outImage.pixels.size()), outImage.pixels.data());
+        if (SUCCEEDED(result)) {
+            outImage.width = width;
+            outImage.height = height;
+            decoded = true;
+        }
+    }
+
+    if (converter) {
+        converter->Release();
+    }
+    if (frame) {
+        frame->Release();
+    }
+    if (decoder) {
+        decoder->Release();
+    }
+    if (stream) {
+        stream->Release();
+    }
+    if (factory) {
+        factory->Release();
+    }
+    if (comInitialized) {
+        CoUninitialize();
+    }
+    return decoded;
+}
+#endif
+
+// Converts and releases `surface`, which was loaded from `path`.
+bool CopySurfaceToImage(SDL_Surface* surface, const std::string& path, DecodedImage& outImage, std::string& outError) {
+    if (!surface) {
+        outError = "Failed to decode image '" + path + "': " + SDL_GetError();
+        return false;
+    }
+
+    SDL_Surface* rgbaSurface = SDL_ConvertSurface(surface, SDL_PIXELFORMAT_RGBA32);
+    SDL_DestroySurface(surface);
+    if (!rgbaSurface || !rgbaSurface->pixels || rgbaSurface->w <= 0 || rgbaSurface->h <= 0) {
+        if (rgbaSurface) {
+            SDL_DestroySurface(rgbaSurface);
+        }
+        outError = "Failed to convert image '" + path + "' to RGBA.";
+        return false;
+    }
+
+    const std::size_t rowBytes = static_cast<std::size_t>(rgbaSurface->w) * 4;
+    outImage.width = static_cast<std::uint32_t>(rgbaSurface->w);
+    outImage.height = static_cast<std::uint32_t>(rgbaSurface->h);
+    outImage.pixels.resize(rowBytes * static_cast<std::size_t>(rgbaSurface->h));
+    for (int row = 0; row < rgbaSurface->h; ++row) {
+        std::memcpy(
+            outImage.pixels.data() + static_cast<std::size_t>(row) * rowBytes,
+            static_cast<const std::uint8_t*>(rgbaSurface->pixels) + static_cast<std::size_t>(row) * static_cast<std::size_t>(rgbaSurface->pitch),
+            rowBytes);
+    }
+
+    SDL_DestroySurface(rgbaSurface);
+    return true;
+}
+
+bool DecodeImageWithSdl(const std::string& path, DecodedImage& outImage, std::string& outError) {
+    return CopySurfaceToImage(SDL_LoadBMP(path.c_str()), path, outImage, outError);
+}
+
+template <std::size_t Size>
+void WriteLittleEndian(std::array<std::uint8_t, Size>& buffer, std::size_t offset, std::uint32_t value, std::size_t byteCount) {
+    for (std::size_t byteIndex = 0; byteIndex < byteCount; ++byteIndex) {
+        buffer[offset + byteIndex] = static_cast<std::uint8_t>((value >> (8 * byteIndex)) & 0xFFu);
+    }
+}
+}
+
+bool DecodeImageFile(const std::string& path, DecodedImage& outImage, std::string& outError) {
+    outImage = {};
+    if (path.empty()) {
+        outError = "Image path is empty.";
+        return false;
+    }
+
+#if defined(_WIN32)
+    if (DecodeImageWithWic(Utf8ToWide(path), nullptr, 0, outImage)) {
+        return true;
+    }
+    outImage = {};
+#endif
+
+    return DecodeImageWithSdl(path, outImage, outError);
+}
+
+bool DecodeImageMemory(const std::vector<std::byte>& bytes, const std::string& path, DecodedImage& outImage, std::string& outError) {
+    outImage = {};
+    if (bytes.empty()) {
+        outError = "Image '" + path + "' is empty.";
+        return false;
+    }
+
+#if defined(_WIN32)
+    if (DecodeImageWithWic({}, bytes.data(), bytes.size(), outImage)) {
+        return true;
+    }
+    outImage = {};
+#endif
+
+    return CopySurfaceToImage(SDL_LoadBMP_IO(SDL_IOFromConstMem(bytes.data(), bytes.size()), true), path, outImage, outError);
+}
+
+bool WriteBmpImage(const std::filesystem::path& path, const DecodedImage& image, std::string& outError) {
+    if (image.width == 0 || image.height == 0 ||
+        image.pixels.size() != static_cast<std::size_t>(image.width) * static_cast<std::size_t>(image.height) * 4) {
+        outError = "Cannot write an empty or malformed image to '" + path.string() + "'.";
+        return false;
+    }
+
+    constexpr std::size_t kFileHeaderSize = 14;
+    constexpr std::size_t kInfoHeaderSize = 108;
+    const std::uint32_t pixelBytes = image.width * image.height * 4;
+
+    std::array<std::uint8_t, kFileHeaderSize + kInfoHeaderSize> header{};
+    header[0] = 'B';
+    header[1] = 'M';
+    WriteLittleEndian(header, 2, static_cast<std::uint32_t>(header.size()) + pixelBytes, 4);
+    WriteLittleEndian(header, 10, static_cast<std::uint32_t>(header.size()), 4);
+    WriteLittleEndian(header, 14, static_cast<std::uint32_t>(kInfoHeaderSize), 4);
+    WriteLittleEndian(header, 18, image.width, 4);
+    // Negative height marks a top-down bitmap so rows can be written in memory order.
+    WriteLittleEndian(header, 22, static_cast<std::uint32_t>(-static_cast<std::int32_t>(image.height)), 4);
+    WriteLittleEndian(header, 26, 1, 2);
+    WriteLittleEndian(header, 28, 32, 2);
+    WriteLittleEndian(header, 30, 3, 4);
+    WriteLittleEndian(header, 34, pixelBytes, 4);
+    WriteLittleEndian(header, 38, 2835, 4);
+    WriteLittleEndian(header, 42, 2835, 4);
+    WriteLittleEndian(header, 54, 0x00FF0000u, 4);
+    WriteLittleEndian(header, 58, 0x0000FF00u, 4);
+    WriteLittleEndian(header, 62, 0x000000FFu, 4);
+    WriteLittleEndian(header, 66, 0xFF000000u, 4);
+    WriteLittleEndian(header, 70, 0x73524742u, 4);
+
+    std::vector<std::uint8_t> bgraPixels(image.pixels.size());
+    for (std::size_t offset = 0; offset < image.pixels.size(); offset += 4) {
+        bgraPixels[offset] = image.pixels[offset + 2];
+        bgraPixels[offset + 1] = image.pixels[offset + 1];
+        bgraPixels[offset + 2] = image.pixels[offset];
+        bgraPixels[offset + 3] = image.pixels[offset + 3];
+    }
+
+    std::ofstream output(path, std::ios::binary | std::ios::trunc);
+    if (!output) {
+        outError = "Failed to open '" + path.string() + "' for writing.";
+        return false;
+    }
+
+    output.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+    output.write(reinterpret_cast<const char*>(bgraPixels.data()), static_cast<std::streamsize>(bgraPixels.size()));
+    if (!output) {
+        outError = "Failed to write image data to '" + path.string() + "'.";
+        return false;
+    }
+
+    return true;
+}
+}
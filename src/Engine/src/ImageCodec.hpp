@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "Engine/DecodedImage.hpp"
+
+namespace engine {
+// Decodes with WIC on Windows and falls back to SDL_LoadBMP elsewhere or when WIC fails.
+bool DecodeImageFile(const std::string& path, DecodedImage& outImage, std::string& outError);
+
+// Decodes a file already read into memory, such as one returned by ReadFileBatch. `path` only
+// names the image in errors.
+bool DecodeImageMemory(const std::vector<std::byte>& bytes, const std::string& path, DecodedImage& outImage, std::string& outError);
+
+// Writes a 32-bit BMP (BITMAPV4HEADER with alpha mask) readable by both WIC and SDL_LoadBMP.
+bool WriteBmpImage(const std::filesystem::path& path, const DecodedImage& image, std::string& outError);
+}
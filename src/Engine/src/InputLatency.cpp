@@ -0,0 +1,83 @@
+#include "Engine/InputLatency.hpp"
+
+#include <algorithm>
+
+namespace engine {
+namespace {
+// Event timestamps may come from the OS and land slightly after a clock read taken on our side.
+std::uint64_t Elapsed(std::uint64_t from, std::uint64_t to) noexcept {
+    return to > from ? to - from : 0;
+}
+}
+
+InputLatencyTracker::InputLatencyTracker(std::size_t capacity)
+    : samples_(std::max<std::size_t>(capacity, 1), InputLatencySample{}),
+      nextIndex_(0),
+      size_(0),
+      pendingInputNanoseconds_(0),
+      pendingCameraNanoseconds_(0) {}
+
+void InputLatencyTracker::RecordInput(std::uint64_t eventNanoseconds) noexcept {
+    pendingInputNanoseconds_ = std::max(pendingInputNanoseconds_, eventNanoseconds);
+}
+
+void InputLatencyTracker::RecordCameraBuilt(std::uint64_t nowNanoseconds) noexcept {
+    pendingCameraNanoseconds_ = nowNanoseconds;
+}
+
+void InputLatencyTracker::RecordPresent(std::uint64_t nowNanoseconds) {
+    if (pendingInputNanoseconds_ != 0) {
+        const std::uint64_t cameraNanoseconds = pendingCameraNanoseconds_ != 0 ? pendingCameraNanoseconds_ : nowNanoseconds;
+        samples_[nextIndex_] = InputLatencySample{
+            Elapsed(pendingInputNanoseconds_, cameraNanoseconds),
+            Elapsed(pendingInputNanoseconds_, nowNanoseconds)};
+        nextIndex_ = (nextIndex_ + 1) % samples_.size();
+        size_ = std::min(size_ + 1, samples_.size());
+    }
+    pendingInputNanoseconds_ = 0;
+    pendingCameraNanoseconds_ = 0;
+}
+
+void InputLatencyTracker::Clear() noexcept {
+    nextIndex_ = 0;
+    size_ = 0;
+    pendingInputNanoseconds_ = 0;
+    pendingCameraNanoseconds_ = 0;
+}
+
+std::size_t InputLatencyTracker::GetSize() const noexcept {
+    return size_;
+}
+
+std::size_t InputLatencyTracker::GetCapacity() const noexcept {
+    return samples_.size();
+}
+
+const InputLatencySample& InputLatencyTracker::GetLatest() const noexcept {
+    static const InputLatencySample kEmpty{};
+    if (size_ == 0) {
+        return kEmpty;
+    }
+    return samples_[(nextIndex_ + samples_.size() - 1) % samples_.size()];
+}
+
+double InputLatencyTracker::ComputeAverage(InputLatencyMeasure measure) const noexcept {
+    if (size_ == 0) {
+        return 0.0;
+    }
+
+    double total = 0.0;
+    for (std::size_t offset = 0; offset < size_; ++offset) {
+        total += static_cast<double>(samples_[(nextIndex_ + samples_.size() - 1 - offset) % samples_.size()].*measure);
+    }
+    return total / static_cast<double>(size_);
+}
+
+std::uint64_t InputLatencyTracker::ComputeMaximum(InputLatencyMeasure measure) const noexcept {
+    std::uint64_t maximum = 0;
+    for (std::size_t offset = 0; offset < size_; ++offset) {
+        maximum = std::max(maximum, samples_[(nextIndex_ + samples_.size() - 1 - offset) % samples_.size()].*measure);
+    }
+    return maximum;
+}
+}
@@ -0,0 +1,388 @@
+#include "Engine/JobSystem.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <utility>
+
+namespace engine {
+namespace {
+// Enough ranges per thread that a worker finishing early finds something left to steal.
+constexpr std::size_t kRangesPerThread = 8;
+constexpr std::size_t kNoWorker = std::numeric_limits<std::size_t>::max();
+
+thread_local const JobSystem* tWorkerOwner = nullptr;
+thread_local std::size_t tWorkerIndex = kNoWorker;
+
+std::uint64_t NanosecondsSince(std::chrono::steady_clock::time_point start) noexcept {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+}
+}
+
+JobSystem::JobSystem(unsigned workerCount)
+    : mainThreadId_(std::this_thread::get_id()),
+      workers_(),
+      mainThreadMutex_(),
+      mainThreadJobs_(),
+      externalJobsExecuted_(0),
+      mainThreadJobsExecuted_(0),
+      externalSteals_(0),
+      nextExternalWorker_(0),
+      queuedJobCount_(0),
+      queuedBackgroundJobCount_(0),
+      queuedMainThreadJobCount_(0),
+      sleepingThreadCount_(0),
+      wakeMutex_(),
+      wakeCondition_() {
+    if (workerCount == 0) {
+        const unsigned hardwareThreads = std::thread::hardware_concurrency();
+        workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+
+    // Every deque exists before any worker starts looking for something to steal.
+    workers_.reserve(workerCount);
+    for (unsigned workerIndex = 0; workerIndex < workerCount; ++workerIndex) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+    for (std::size_t workerIndex = 0; workerIndex < workers_.size(); ++workerIndex) {
+        workers_[workerIndex]->thread = std::jthread([this, workerIndex](std::stop_token stopToken) {
+            WorkerLoop(workerIndex, stopToken);
+        });
+    }
+}
+
+JobSystem::~JobSystem() {
+    for (const std::unique_ptr<Worker>& worker : workers_) {
+        worker->thread.request_stop();
+    }
+    for (const std::unique_ptr<Worker>& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+}
+
+JobSystem& JobSystem::Get() {
+    static JobSystem jobSystem;
+    return jobSystem;
+}
+
+JobSystem::JobHandle JobSystem::Schedule(std::function<void()> work, std::initializer_list<JobHandle> dependencies) {
+    return Submit(std::move(work), JobAffinity::Any, dependencies);
+}
+
+JobSystem::JobHandle JobSystem::ScheduleBackground(std::function<void()> work, std::initializer_list<JobHandle> dependencies) {
+    return Submit(std::move(work), JobAffinity::WorkersOnly, dependencies);
+}
+
+JobSystem::JobHandle JobSystem::ScheduleOnMainThread(std::function<void()> work, std::initializer_list<JobHandle> dependencies) {
+    return Submit(std::move(work), JobAffinity::MainThread, dependencies);
+}
+
+void JobSystem::Wait(const JobHandle& job) {
+    if (!job) {
+        return;
+    }
+
+    WaitUntil([&job]() { return job->completed.load(); });
+}
+
+bool JobSystem::IsComplete(const JobHandle& job) noexcept {
+    return !job || job->completed.load();
+}
+
+void JobSystem::ParallelFor(std::size_t count, std::size_t minGrain, const std::function<void(std::size_t begin, std::size_t end)>& body) {
+    if (count == 0) {
+        return;
+    }
+
+    const std::size_t threadCount = workers_.size() + 1;
+    const std::size_t grain = std::max({minGrain, std::size_t{1}, count / (threadCount * kRangesPerThread)});
+    if (count <= grain) {
+        body(0, count);
+        return;
+    }
+
+    std::atomic<std::size_t> remaining{count};
+    std::function<void(std::size_t, std::size_t)> runRange;
+    runRange = [&](std::size_t begin, std::size_t end) {
+        while (end - begin > grain) {
+            const std::size_t middle = begin + (end - begin) / 2;
+            Schedule([&runRange, middle, end]() { runRange(middle, end); });
+            end = middle;
+        }
+
+        body(begin, end);
+
+        // The caller may return as soon as the count reaches zero, destroying this closure, so
+        // nothing captured may be touched after the subtraction.
+        JobSystem& system = *this;
+        const std::size_t finished = end - begin;
+        if (remaining.fetch_sub(finished) == finished) {
+            system.NotifyWaiters();
+        }
+    };
+
+    runRange(0, count);
+    WaitUntil([&remaining]() { return remaining.load() == 0; });
+}
+
+std::size_t JobSystem::RunMainThreadJobs() {
+    if (!IsMainThread()) {
+        return 0;
+    }
+
+    std::size_t executed = 0;
+    while (queuedMainThreadJobCount_.load() > 0) {
+        JobHandle job;
+        {
+            std::lock_guard lock(mainThreadMutex_);
+            if (mainThreadJobs_.empty()) {
+                break;
+            }
+            job = std::move(mainThreadJobs_.front());
+            mainThreadJobs_.pop_front();
+        }
+        queuedMainThreadJobCount_.fetch_sub(1);
+        Execute(job);
+        ++executed;
+    }
+    return executed;
+}
+
+bool JobSystem::IsMainThread() const noexcept {
+    return std::this_thread::get_id() == mainThreadId_;
+}
+
+unsigned JobSystem::GetWorkerCount() const noexcept {
+    return static_cast<unsigned>(workers_.size());
+}
+
+JobSystemStatistics JobSystem::GetStatistics() const noexcept {
+    JobSystemStatistics statistics{};
+    statistics.workerCount = static_cast<std::uint32_t>(workers_.size());
+    statistics.jobsExecuted = externalJobsExecuted_.load(std::memory_order_relaxed);
+    statistics.mainThreadJobsExecuted = mainThreadJobsExecuted_.load(std::memory_order_relaxed);
+    statistics.steals = externalSteals_.load(std::memory_order_relaxed);
+    for (const std::unique_ptr<Worker>& worker : workers_) {
+        statistics.jobsExecuted += worker->jobsExecuted.load(std::memory_order_relaxed);
+        statistics.steals += worker->steals.load(std::memory_order_relaxed);
+        statistics.failedStealAttempts += worker->failedStealAttempts.load(std::memory_order_relaxed);
+        statistics.idleNanoseconds += worker->idleNanoseconds.load(std::memory_order_relaxed);
+    }
+    return statistics;
+}
+
+JobSystem::JobHandle JobSystem::Submit(std::function<void()> work, JobAffinity affinity, std::initializer_list<JobHandle> dependencies) {
+    JobHandle job = std::make_shared<Job>();
+    job->work = std::move(work);
+    job->affinity = affinity;
+
+    // The extra count keeps the job from starting while dependencies are still being attached.
+    job->pendingDependencies.store(1);
+    for (const JobHandle& dependency : dependencies) {
+        if (!dependency) {
+            continue;
+        }
+
+        std::lock_guard lock(dependency->continuationMutex);
+        if (!dependency->completed.load()) {
+            job->pendingDependencies.fetch_add(1);
+            dependency->continuations.push_back(job);
+        }
+    }
+
+    if (job->pendingDependencies.fetch_sub(1) == 1) {
+        Enqueue(job);
+    }
+    return job;
+}
+
+void JobSystem::Enqueue(JobHandle job) {
+    if (job->affinity == JobAffinity::MainThread) {
+        {
+            std::lock_guard lock(mainThreadMutex_);
+            mainThreadJobs_.push_back(std::move(job));
+        }
+        queuedMainThreadJobCount_.fetch_add(1);
+    } else {
+        // Jobs spawned by a worker stay on its own deque, where it will pop them first while they
+        // are still warm in its cache; anything else is spread round-robin.
+        const std::size_t target = tWorkerOwner == this
+            ? tWorkerIndex
+            : nextExternalWorker_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+        Worker& worker = *workers_[target];
+        const bool background = job->affinity == JobAffinity::WorkersOnly;
+        {
+            std::lock_guard lock(worker.mutex);
+            (background ? worker.backgroundJobs : worker.jobs).push_back(std::move(job));
+        }
+        (background ? queuedBackgroundJobCount_ : queuedJobCount_).fetch_add(1);
+    }
+
+    NotifyWaiters();
+}
+
+void JobSystem::Execute(const JobHandle& job) {
+    job->work();
+    job->work = nullptr;
+
+    if (job->affinity == JobAffinity::MainThread) {
+        mainThreadJobsExecuted_.fetch_add(1, std::memory_order_relaxed);
+    } else if (tWorkerOwner == this) {
+        workers_[tWorkerIndex]->jobsExecuted.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        externalJobsExecuted_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::vector<JobHandle> continuations;
+    {
+        std::lock_guard lock(job->continuationMutex);
+        job->completed.store(true);
+        continuations.swap(job->continuations);
+    }
+    for (JobHandle& continuation : continuations) {
+        if (continuation->pendingDependencies.fetch_sub(1) == 1) {
+            Enqueue(std::move(continuation));
+        }
+    }
+
+    NotifyWaiters();
+}
+
+JobSystem::JobHandle JobSystem::TakeJob(bool includeMainThreadJobs, bool includeBackgroundJobs) {
+    if (includeMainThreadJobs && queuedMainThreadJobCount_.load() > 0) {
+        std::lock_guard lock(mainThreadMutex_);
+        if (!mainThreadJobs_.empty()) {
+            JobHandle job = std::move(mainThreadJobs_.front());
+            mainThreadJobs_.pop_front();
+            queuedMainThreadJobCount_.fetch_sub(1);
+            return job;
+        }
+    }
+
+    if (JobHandle job = TakeFromDeques(&Worker::jobs, queuedJobCount_)) {
+        return job;
+    }
+    if (includeBackgroundJobs) {
+        if (JobHandle job = TakeFromDeques(&Worker::backgroundJobs, queuedBackgroundJobCount_)) {
+            return job;
+        }
+    }
+
+    if (tWorkerOwner == this) {
+        workers_[tWorkerIndex]->failedStealAttempts.fetch_add(1, std::memory_order_relaxed);
+    }
+    return nullptr;
+}
+
+JobSystem::JobHandle JobSystem::TakeFromDeques(std::deque<JobHandle> Worker::*deque, std::atomic<std::size_t>& queuedCount) {
+    if (queuedCount.load() == 0) {
+        return nullptr;
+    }
+
+    const std::size_t self = tWorkerOwner == this ? tWorkerIndex : kNoWorker;
+    if (self != kNoWorker) {
+        Worker& worker = *workers_[self];
+        std::lock_guard lock(worker.mutex);
+        std::deque<JobHandle>& ownJobs = worker.*deque;
+        if (!ownJobs.empty()) {
+            JobHandle job = std::move(ownJobs.back());
+            ownJobs.pop_back();
+            queuedCount.fetch_sub(1);
+            return job;
+        }
+    }
+
+    const std::size_t workerCount = workers_.size();
+    const std::size_t start = self != kNoWorker ? self + 1 : nextExternalWorker_.load(std::memory_order_relaxed);
+    for (std::size_t offset = 0; offset < workerCount; ++offset) {
+        const std::size_t victim = (start + offset) % workerCount;
+        if (victim == self) {
+            continue;
+        }
+
+        Worker& worker = *workers_[victim];
+        std::lock_guard lock(worker.mutex);
+        std::deque<JobHandle>& victimJobs = worker.*deque;
+        if (victimJobs.empty()) {
+            continue;
+        }
+
+        JobHandle job = std::move(victimJobs.front());
+        victimJobs.pop_front();
+        queuedCount.fetch_sub(1);
+        if (self != kNoWorker) {
+            workers_[self]->steals.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            externalSteals_.fetch_add(1, std::memory_order_relaxed);
+        }
+        return job;
+    }
+    return nullptr;
+}
+
+bool JobSystem::RunOneJob() {
+    JobHandle job = TakeJob(IsMainThread(), false);
+    if (!job) {
+        return false;
+    }
+
+    Execute(job);
+    return true;
+}
+
+void JobSystem::WaitUntil(const std::function<bool()>& isDone) {
+    const bool mainThread = IsMainThread();
+    while (!isDone()) {
+        if (RunOneJob()) {
+            continue;
+        }
+
+        // Registering as a sleeper before re-checking pairs with NotifyWaiters reading the count
+        // after publishing work, so a wake-up cannot slip between the check and the wait.
+        std::unique_lock lock(wakeMutex_);
+        sleepingThreadCount_.fetch_add(1);
+        wakeCondition_.wait(lock, [&]() {
+            return isDone() || queuedJobCount_.load() > 0 || (mainThread && queuedMainThreadJobCount_.load() > 0);
+        });
+        sleepingThreadCount_.fetch_sub(1);
+    }
+}
+
+void JobSystem::NotifyWaiters() {
+    if (sleepingThreadCount_.load() == 0) {
+        return;
+    }
+
+    {
+        std::lock_guard lock(wakeMutex_);
+    }
+    wakeCondition_.notify_all();
+}
+
+void JobSystem::WorkerLoop(std::size_t workerIndex, std::stop_token stopToken) {
+    tWorkerOwner = this;
+    tWorkerIndex = workerIndex;
+    Worker& worker = *workers_[workerIndex];
+
+    while (!stopToken.stop_requested()) {
+        if (JobHandle job = TakeJob(false, true)) {
+            Execute(job);
+            continue;
+        }
+
+        const auto idleStart = std::chrono::steady_clock::now();
+        {
+            std::unique_lock lock(wakeMutex_);
+            sleepingThreadCount_.fetch_add(1);
+            wakeCondition_.wait(lock, stopToken, [this]() {
+                return queuedJobCount_.load() > 0 || queuedBackgroundJobCount_.load() > 0;
+            });
+            sleepingThreadCount_.fetch_sub(1);
+        }
+        worker.idleNanoseconds.fetch_add(NanosecondsSince(idleStart), std::memory_order_relaxed);
+    }
+}
+}
@@ -0,0 +1,323 @@
+#include "Engine/Log.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+
+#include <SDL3/SDL.h>
+
+namespace engine {
+namespace {
+constexpr std::uint32_t kGpuRecordsPerSecond = 20;
+
+std::size_t CategoryIndex(LogCategory category) noexcept {
+    return static_cast<std::size_t>(category);
+}
+
+void WriteToSdlLog(const LogRecord& record) {
+    const int sdlCategory = record.category == LogCategory::Renderer || record.category == LogCategory::Gpu
+        ? SDL_LOG_CATEGORY_RENDER
+        : SDL_LOG_CATEGORY_APPLICATION;
+
+    // Debug records already passed the logger's own level filter, so SDL's default priority
+    // threshold must not hide them again.
+    SDL_LogPriority priority = SDL_LOG_PRIORITY_INFO;
+    if (record.level == LogLevel::Warning) {
+        priority = SDL_LOG_PRIORITY_WARN;
+    } else if (record.level == LogLevel::Error) {
+        priority = SDL_LOG_PRIORITY_ERROR;
+    }
+
+    SDL_LogMessage(
+        sdlCategory,
+        priority,
+        "[%s] %.*s",
+        LogCategoryName(record.category),
+        static_cast<int>(record.message.size()),
+        record.message.data());
+}
+}
+
+const char* LogLevelName(LogLevel level) noexcept {
+    switch (level) {
+    case LogLevel::Debug:
+        return "Debug";
+    case LogLevel::Info:
+        return "Info";
+    case LogLevel::Warning:
+        return "Warning";
+    case LogLevel::Error:
+        return "Error";
+    case LogLevel::Off:
+        return "Off";
+    }
+    return "Unknown";
+}
+
+const char* LogCategoryName(LogCategory category) noexcept {
+    switch (category) {
+    case LogCategory::Application:
+        return "Application";
+    case LogCategory::Loader:
+        return "Loader";
+    case LogCategory::Renderer:
+        return "Renderer";
+    case LogCategory::Gpu:
+        return "Gpu";
+    case LogCategory::Count:
+        break;
+    }
+    return "Unknown";
+}
+
+namespace detail {
+LogStringRef LogPayloadWriter::CopyString(std::string_view text) noexcept {
+    if (stringCursor_ >= kLogPayloadSize - 1) {
+        payload_[kLogPayloadSize - 1] = std::byte{0};
+        return LogStringRef{static_cast<std::uint16_t>(kLogPayloadSize - 1), 0};
+    }
+
+    const std::size_t available = kLogPayloadSize - 1 - stringCursor_;
+    const std::size_t length = std::min(text.size(), available);
+    char* destination = reinterpret_cast<char*>(payload_ + stringCursor_);
+    std::memcpy(destination, text.data(), length);
+    if (length < text.size() && length >= 3) {
+        std::memcpy(destination + length - 3, "...", 3);
+    }
+    destination[length] = '\0';
+
+    const LogStringRef reference{static_cast<std::uint16_t>(stringCursor_), static_cast<std::uint16_t>(length)};
+    stringCursor_ += length + 1;
+    return reference;
+}
+
+void FormatLogMessage(std::string& outMessage, const char* format, ...) {
+    std::va_list arguments;
+    va_start(arguments, format);
+    std::va_list measureArguments;
+    va_copy(measureArguments, arguments);
+    const int length = std::vsnprintf(nullptr, 0, format, measureArguments);
+    va_end(measureArguments);
+
+    if (length < 0) {
+        outMessage.assign(format);
+    } else {
+        outMessage.resize(static_cast<std::size_t>(length));
+        std::vsnprintf(outMessage.data(), outMessage.size() + 1, format, arguments);
+    }
+    va_end(arguments);
+}
+}
+
+Logger::Logger(std::size_t capacity)
+    : mask_(std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1),
+      enqueuePosition_(0),
+      dequeuePosition_(0),
+      writtenCount_(0),
+      droppedCount_(0),
+      reportedSuppressedCounts_{},
+      reportedDroppedCount_(0),
+      wakeCounter_(0) {
+    slots_ = std::make_unique<Slot[]>(mask_ + 1);
+    for (std::size_t slotIndex = 0; slotIndex <= mask_; ++slotIndex) {
+        slots_[slotIndex].sequence.store(slotIndex, std::memory_order_relaxed);
+    }
+
+    for (CategoryState& state : categories_) {
+        state.level.store(LogLevel::Info, std::memory_order_relaxed);
+        state.rateLimit.store(0, std::memory_order_relaxed);
+        state.rateWindowSecond.store(-1, std::memory_order_relaxed);
+        state.rateWindowCount.store(0, std::memory_order_relaxed);
+        state.suppressedCount.store(0, std::memory_order_relaxed);
+    }
+
+    writerThread_ = std::jthread([this](std::stop_token stopToken) { WriterLoop(stopToken); });
+}
+
+Logger::~Logger() {
+    writerThread_.request_stop();
+    wakeCounter_.fetch_add(1, std::memory_order_release);
+    wakeCounter_.notify_one();
+    if (writerThread_.joinable()) {
+        writerThread_.join();
+    }
+}
+
+Logger& Logger::Get() {
+    static Logger logger;
+    static const bool configured = [] {
+        logger.SetSink(&WriteToSdlLog);
+        logger.SetRateLimit(LogCategory::Gpu, kGpuRecordsPerSecond);
+        return true;
+    }();
+    static_cast<void>(configured);
+    return logger;
+}
+
+void Logger::SetSink(LogSink sink) {
+    Flush();
+    const std::lock_guard<std::mutex> lock(sinkMutex_);
+    sink_ = std::move(sink);
+}
+
+void Logger::SetLevel(LogCategory category, LogLevel level) noexcept {
+    categories_[CategoryIndex(category)].level.store(level, std::memory_order_relaxed);
+}
+
+LogLevel Logger::GetLevel(LogCategory category) const noexcept {
+    return categories_[CategoryIndex(category)].level.load(std::memory_order_relaxed);
+}
+
+void Logger::SetRateLimit(LogCategory category, std::uint32_t recordsPerSecond) noexcept {
+    categories_[CategoryIndex(category)].rateLimit.store(recordsPerSecond, std::memory_order_relaxed);
+}
+
+void Logger::Flush() {
+    const std::uint64_t target = enqueuePosition_.load(std::memory_order_acquire);
+    wakeCounter_.fetch_add(1, std::memory_order_release);
+    wakeCounter_.notify_one();
+
+    std::uint64_t written = writtenCount_.load(std::memory_order_acquire);
+    while (written < target) {
+        writtenCount_.wait(written, std::memory_order_acquire);
+        written = writtenCount_.load(std::memory_order_acquire);
+    }
+}
+
+std::uint64_t Logger::GetDroppedCount() const noexcept {
+    return droppedCount_.load(std::memory_order_relaxed);
+}
+
+std::uint64_t Logger::GetSuppressedCount(LogCategory category) const noexcept {
+    return categories_[CategoryIndex(category)].suppressedCount.load(std::memory_order_relaxed);
+}
+
+std::uint64_t Logger::NowNanoseconds() noexcept {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+}
+
+bool Logger::AcquireRateBudget(LogCategory category) noexcept {
+    CategoryState& state = categories_[CategoryIndex(category)];
+    const std::uint32_t limit = state.rateLimit.load(std::memory_order_relaxed);
+    if (limit == 0) {
+        return true;
+    }
+
+    // Fixed one-second windows. A producer racing the window reset may let a few extra
+    // records through, which is acceptable for a log.
+    const std::int64_t second = static_cast<std::int64_t>(NowNanoseconds() / 1000000000ull);
+    std::int64_t window = state.rateWindowSecond.load(std::memory_order_relaxed);
+    if (window != second && state.rateWindowSecond.compare_exchange_strong(window, second, std::memory_order_relaxed)) {
+        state.rateWindowCount.store(0, std::memory_order_relaxed);
+    }
+
+    if (state.rateWindowCount.fetch_add(1, std::memory_order_relaxed) < limit) {
+        return true;
+    }
+
+    state.suppressedCount.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+Logger::Slot* Logger::AcquireSlot() noexcept {
+    std::size_t position = enqueuePosition_.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = slots_[position & mask_];
+        const std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+        if (difference == 0) {
+            if (enqueuePosition_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                return &slot;
+            }
+        } else if (difference < 0) {
+            droppedCount_.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        } else {
+            position = enqueuePosition_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void Logger::PublishSlot(Slot& slot) noexcept {
+    slot.sequence.store(slot.sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    wakeCounter_.fetch_add(1, std::memory_order_release);
+    wakeCounter_.notify_one();
+}
+
+void Logger::WriterLoop(std::stop_token stopToken) {
+    for (;;) {
+        const std::uint32_t observedWake = wakeCounter_.load(std::memory_order_acquire);
+        const bool drainedAny = DrainSlots();
+        ReportLosses();
+        if (stopToken.stop_requested()) {
+            DrainSlots();
+            ReportLosses();
+            return;
+        }
+        if (!drainedAny) {
+            wakeCounter_.wait(observedWake, std::memory_order_acquire);
+        }
+    }
+}
+
+bool Logger::DrainSlots() {
+    bool drainedAny = false;
+    for (;;) {
+        Slot& slot = slots_[dequeuePosition_ & mask_];
+        if (slot.sequence.load(std::memory_order_acquire) != dequeuePosition_ + 1) {
+            break;
+        }
+
+        slot.formatter(slot.format, slot.payload.data(), formatBuffer_);
+        const LogLevel level = slot.level;
+        const LogCategory category = slot.category;
+        const std::uint64_t timestampNanoseconds = slot.timestampNanoseconds;
+        slot.sequence.store(dequeuePosition_ + mask_ + 1, std::memory_order_release);
+        ++dequeuePosition_;
+
+        Emit(level, category, timestampNanoseconds, formatBuffer_);
+        writtenCount_.store(dequeuePosition_, std::memory_order_release);
+        drainedAny = true;
+    }
+
+    if (drainedAny) {
+        writtenCount_.notify_all();
+    }
+    return drainedAny;
+}
+
+void Logger::ReportLosses() {
+    for (std::size_t categoryIndex = 0; categoryIndex < categories_.size(); ++categoryIndex) {
+        const std::uint64_t suppressed = categories_[categoryIndex].suppressedCount.load(std::memory_order_relaxed);
+        if (suppressed > reportedSuppressedCounts_[categoryIndex]) {
+            detail::FormatLogMessage(
+                formatBuffer_,
+                "Rate limit suppressed %llu records.",
+                static_cast<unsigned long long>(suppressed - reportedSuppressedCounts_[categoryIndex]));
+            reportedSuppressedCounts_[categoryIndex] = suppressed;
+            Emit(LogLevel::Warning, static_cast<LogCategory>(categoryIndex), NowNanoseconds(), formatBuffer_);
+        }
+    }
+
+    const std::uint64_t dropped = droppedCount_.load(std::memory_order_relaxed);
+    if (dropped > reportedDroppedCount_) {
+        detail::FormatLogMessage(
+            formatBuffer_,
+            "Log queue full; dropped %llu records.",
+            static_cast<unsigned long long>(dropped - reportedDroppedCount_));
+        reportedDroppedCount_ = dropped;
+        Emit(LogLevel::Warning, LogCategory::Application, NowNanoseconds(), formatBuffer_);
+    }
+}
+
+void Logger::Emit(LogLevel level, LogCategory category, std::uint64_t timestampNanoseconds, std::string_view message) {
+    const std::lock_guard<std::mutex> lock(sinkMutex_);
+    if (sink_) {
+        sink_(LogRecord{level, category, timestampNanoseconds, message});
+    }
+}
+}
@@ -0,0 +1,589 @@
+#include "Engine/Metrics.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <system_error>
+
+#include <SDL3/SDL.h>
+
+#include "Engine/Log.hpp"
+
+#if defined(_WIN32)
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace engine {
+namespace {
+#if defined(_WIN32)
+using SocketHandle = SOCKET;
+const SocketHandle kInvalidSocket = INVALID_SOCKET;
+
+void CloseSocket(SocketHandle handle) noexcept {
+    closesocket(handle);
+}
+
+bool WaitReadable(SocketHandle handle, int timeoutMilliseconds) noexcept {
+    WSAPOLLFD descriptor{handle, POLLRDNORM, 0};
+    return WSAPoll(&descriptor, 1, timeoutMilliseconds) > 0;
+}
+#else
+using SocketHandle = int;
+constexpr SocketHandle kInvalidSocket = -1;
+
+void CloseSocket(SocketHandle handle) noexcept {
+    close(handle);
+}
+
+bool WaitReadable(SocketHandle handle, int timeoutMilliseconds) noexcept {
+    pollfd descriptor{handle, POLLIN, 0};
+    return poll(&descriptor, 1, timeoutMilliseconds) > 0;
+}
+#endif
+
+// Exporters poll for shutdown this often while idle.
+constexpr int kStopPollMilliseconds = 100;
+// A client gets this long to finish sending its request.
+constexpr int kRequestTimeoutMilliseconds = 1000;
+constexpr std::size_t kMaxRequestBytes = 8192;
+
+void AppendNumber(std::string& text, double value) {
+    if (std::isnan(value)) {
+        text += "NaN";
+        return;
+    }
+    if (std::isinf(value)) {
+        text += value > 0.0 ? "+Inf" : "-Inf";
+        return;
+    }
+
+    char buffer[32];
+    const std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    text.append(buffer, result.ptr);
+}
+
+void AppendNumber(std::string& text, std::uint64_t value) {
+    char buffer[24];
+    const std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    text.append(buffer, result.ptr);
+}
+
+// Metric and label names may only hold [a-zA-Z0-9_:] and may not start with a digit.
+std::string SanitizeName(const std::string& name, bool allowColon) {
+    std::string sanitized = name.empty() ? std::string("_") : name;
+    for (char& character : sanitized) {
+        const bool valid = (character >= 'a' && character <= 'z') || (character >= 'A' && character <= 'Z') ||
+            (character >= '0' && character <= '9') || character == '_' || (allowColon && character == ':');
+        character = valid ? character : '_';
+    }
+    if (sanitized[0] >= '0' && sanitized[0] <= '9') {
+        sanitized.insert(sanitized.begin(), '_');
+    }
+    return sanitized;
+}
+
+void AppendEscaped(std::string& text, const std::string& value, bool escapeQuotes) {
+    for (const char character : value) {
+        if (character == '\\') {
+            text += "\\\\";
+        } else if (character == '\n') {
+            text += "\\n";
+        } else if (escapeQuotes && character == '"') {
+            text += "\\\"";
+        } else {
+            text += character;
+        }
+    }
+}
+
+// `name{labels,extraName="extraValue"} `; the extra label is how histogram buckets carry `le`.
+void AppendSeriesName(
+    std::string& text,
+    const std::string& name,
+    const MetricLabels& labels,
+    const char* extraName = nullptr,
+    const std::string& extraValue = {}) {
+    text += name;
+    if (!labels.empty() || extraName) {
+        text += '{';
+        bool first = true;
+        for (const auto& [labelName, labelValue] : labels) {
+            text += first ? "" : ",";
+            text += labelName;
+            text += "=\"";
+            AppendEscaped(text, labelValue, true);
+            text += '"';
+            first = false;
+        }
+        if (extraName) {
+            text += first ? "" : ",";
+            text += extraName;
+            text += "=\"";
+            text += extraValue;
+            text += '"';
+        }
+        text += '}';
+    }
+    text += ' ';
+}
+
+bool SendAll(SocketHandle handle, const std::string& data) noexcept {
+#if defined(MSG_NOSIGNAL)
+    constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+    constexpr int kSendFlags = 0;
+#endif
+    std::size_t sent = 0;
+    while (sent < data.size()) {
+        const int chunk = static_cast<int>(std::min<std::size_t>(data.size() - sent, 1 << 20));
+        const auto written = send(handle, data.data() + sent, chunk, kSendFlags);
+        if (written <= 0) {
+            return false;
+        }
+        sent += static_cast<std::size_t>(written);
+    }
+    return true;
+}
+
+std::string BuildHttpResponse(const char* status, const char* contentType, const std::string& body) {
+    std::string response = "HTTP/1.1 ";
+    response += status;
+    response += "\r\nContent-Type: ";
+    response += contentType;
+    response += "\r\nContent-Length: ";
+    AppendNumber(response, static_cast<std::uint64_t>(body.size()));
+    response += "\r\nConnection: close\r\n\r\n";
+    response += body;
+    return response;
+}
+}
+
+MetricCounter::MetricCounter()
+    : value_(0) {}
+
+void MetricCounter::Increment(std::uint64_t amount) noexcept {
+    value_.fetch_add(amount, std::memory_order_relaxed);
+}
+
+std::uint64_t MetricCounter::GetValue() const noexcept {
+    return value_.load(std::memory_order_relaxed);
+}
+
+MetricGauge::MetricGauge()
+    : value_(0.0) {}
+
+void MetricGauge::Set(double value) noexcept {
+    value_.store(value, std::memory_order_relaxed);
+}
+
+double MetricGauge::GetValue() const noexcept {
+    return value_.load(std::memory_order_relaxed);
+}
+
+MetricHistogram::MetricHistogram(std::vector<double> upperBounds)
+    : upperBounds_(std::move(upperBounds)),
+      bucketCounts_(),
+      sum_(0.0) {
+    upperBounds_.erase(
+        std::remove_if(upperBounds_.begin(), upperBounds_.end(), [](double bound) { return !std::isfinite(bound); }),
+        upperBounds_.end());
+    std::sort(upperBounds_.begin(), upperBounds_.end());
+    upperBounds_.erase(std::unique(upperBounds_.begin(), upperBounds_.end()), upperBounds_.end());
+    bucketCounts_ = std::make_unique<std::atomic<std::uint64_t>[]>(upperBounds_.size() + 1);
+    for (std::size_t bucket = 0; bucket <= upperBounds_.size(); ++bucket) {
+        bucketCounts_[bucket].store(0, std::memory_order_relaxed);
+    }
+}
+
+void MetricHistogram::Observe(double value) noexcept {
+    if (std::isnan(value)) {
+        return;
+    }
+
+    const std::size_t bucket = static_cast<std::size_t>(
+        std::lower_bound(upperBounds_.begin(), upperBounds_.end(), value) - upperBounds_.begin());
+    bucketCounts_[bucket].fetch_add(1, std::memory_order_relaxed);
+    double sum = sum_.load(std::memory_order_relaxed);
+    while (!sum_.compare_exchange_weak(sum, sum + value, std::memory_order_relaxed)) {
+    }
+}
+
+MetricHistogramSnapshot MetricHistogram::GetSnapshot() const {
+    MetricHistogramSnapshot snapshot{upperBounds_, std::vector<std::uint64_t>(upperBounds_.size() + 1, 0), 0.0};
+    std::uint64_t cumulative = 0;
+    for (std::size_t bucket = 0; bucket <= upperBounds_.size(); ++bucket) {
+        cumulative += bucketCounts_[bucket].load(std::memory_order_relaxed);
+        snapshot.cumulativeCounts[bucket] = cumulative;
+    }
+    snapshot.sum = sum_.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+MetricsRegistry::MetricsRegistry()
+    : mutex_(),
+      series_() {}
+
+MetricCounter& MetricsRegistry::AddCounter(const std::string& name, const std::string& help, MetricLabels labels) {
+    auto counter = std::make_unique<MetricCounter>();
+    MetricCounter& metric = *counter;
+    AddSeries(Series{name, help, MetricType::Counter, std::move(labels), std::move(counter), nullptr, nullptr});
+    return metric;
+}
+
+MetricGauge& MetricsRegistry::AddGauge(const std::string& name, const std::string& help, MetricLabels labels) {
+    auto gauge = std::make_unique<MetricGauge>();
+    MetricGauge& metric = *gauge;
+    AddSeries(Series{name, help, MetricType::Gauge, std::move(labels), nullptr, std::move(gauge), nullptr});
+    return metric;
+}
+
+MetricHistogram& MetricsRegistry::AddHistogram(
+    const std::string& name,
+    const std::string& help,
+    std::vector<double> upperBounds,
+    MetricLabels labels) {
+    auto histogram = std::make_unique<MetricHistogram>(std::move(upperBounds));
+    MetricHistogram& metric = *histogram;
+    AddSeries(Series{name, help, MetricType::Histogram, std::move(labels), nullptr, nullptr, std::move(histogram)});
+    return metric;
+}
+
+void MetricsRegistry::SetInfo(const std::string& name, const std::string& help, MetricLabels labels) {
+    const std::string sanitizedName = SanitizeName(name, true);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (Series& series : series_) {
+            if (series.name == sanitizedName && series.type == MetricType::Info) {
+                for (auto& label : labels) {
+                    label.first = SanitizeName(label.first, false);
+                }
+                series.labels = std::move(labels);
+                return;
+            }
+        }
+    }
+    AddSeries(Series{name, help, MetricType::Info, std::move(labels), nullptr, nullptr, nullptr});
+}
+
+void MetricsRegistry::AddSeries(Series series) {
+    series.name = SanitizeName(series.name, true);
+    for (auto& label : series.labels) {
+        label.first = SanitizeName(label.first, false);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    series_.push_back(std::move(series));
+}
+
+void MetricsRegistry::WritePrometheusText(std::string& outText) const {
+    outText.clear();
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<bool> written(series_.size(), false);
+    for (std::size_t first = 0; first < series_.size(); ++first) {
+        if (written[first]) {
+            continue;
+        }
+
+        // Every series of a family is listed under one HELP and TYPE, in registration order.
+        const Series& family = series_[first];
+        outText += "# HELP ";
+        outText += family.name;
+        outText += ' ';
+        AppendEscaped(outText, family.help, false);
+        outText += "\n# TYPE ";
+        outText += family.name;
+        switch (family.type) {
+        case MetricType::Counter:
+            outText += " counter\n";
+            break;
+        case MetricType::Histogram:
+            outText += " histogram\n";
+            break;
+        case MetricType::Gauge:
+        case MetricType::Info:
+            outText += " gauge\n";
+            break;
+        }
+
+        for (std::size_t index = first; index < series_.size(); ++index) {
+            const Series& series = series_[index];
+            if (written[index] || series.name != family.name || series.type != family.type) {
+                continue;
+            }
+
+            written[index] = true;
+            switch (series.type) {
+            case MetricType::Counter:
+                AppendSeriesName(outText, series.name, series.labels);
+                AppendNumber(outText, series.counter->GetValue());
+                break;
+            case MetricType::Gauge:
+                AppendSeriesName(outText, series.name, series.labels);
+                AppendNumber(outText, series.gauge->GetValue());
+                break;
+            case MetricType::Info:
+                AppendSeriesName(outText, series.name, series.labels);
+                outText += '1';
+                break;
+            case MetricType::Histogram: {
+                const MetricHistogramSnapshot snapshot = series.histogram->GetSnapshot();
+                for (std::size_t bucket = 0; bucket < snapshot.cumulativeCounts.size(); ++bucket) {
+                    std::string bound;
+                    AppendNumber(bound, bucket < snapshot.upperBounds.size() ? snapshot.upperBounds[bucket] : std::numeric_limits<double>::infinity());
+                    AppendSeriesName(outText, series.name + "_bucket", series.labels, "le", bound);
+                    AppendNumber(outText, snapshot.cumulativeCounts[bucket]);
+                    outText += '\n';
+                }
+                AppendSeriesName(outText, series.name + "_sum", series.labels);
+                AppendNumber(outText, snapshot.sum);
+                outText += '\n';
+                AppendSeriesName(outText, series.name + "_count", series.labels);
+                AppendNumber(outText, snapshot.cumulativeCounts.back());
+                break;
+            }
+            }
+            outText += '\n';
+        }
+    }
+}
+
+const MetricsExportSettings& GetDefaultMetricsExportSettings() {
+    static const MetricsExportSettings settings = []() {
+        MetricsExportSettings defaults{-1, {}, 15.0};
+        if (const char* port = SDL_getenv("ENGINE_METRICS_PORT")) {
+            const int parsed = std::atoi(port);
+            if (parsed >= 0 && parsed <= 65535 && port[0] != '\0') {
+                defaults.httpPort = parsed;
+            }
+        }
+        if (const char* path = SDL_getenv("ENGINE_METRICS_FILE")) {
+            defaults.textFilePath = path;
+        }
+        if (const char* interval = SDL_getenv("ENGINE_METRICS_INTERVAL")) {
+            const double parsed = std::atof(interval);
+            if (parsed > 0.0) {
+                defaults.textFileIntervalSeconds = parsed;
+            }
+        }
+        return defaults;
+    }();
+    return settings;
+}
+
+bool WriteMetricsTextFile(const MetricsRegistry& registry, const std::filesystem::path& path, std::string& outError) {
+    std::string text;
+    registry.WritePrometheusText(text);
+
+    // Collectors must never read a half-written file, so the text goes to a sibling first and is
+    // renamed over the target.
+    std::filesystem::path temporaryPath = path;
+    temporaryPath += ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            outError = "Could not open metrics file '" + temporaryPath.string() + "' for writing.";
+            return false;
+        }
+        file.write(text.data(), static_cast<std::streamsize>(text.size()));
+        if (!file) {
+            outError = "Could not write metrics file '" + temporaryPath.string() + "'.";
+            return false;
+        }
+    }
+
+    std::error_code renameError;
+    std::filesystem::rename(temporaryPath, path, renameError);
+    if (renameError) {
+        outError = "Could not replace metrics file '" + path.string() + "': " + renameError.message();
+        std::filesystem::remove(temporaryPath, renameError);
+        return false;
+    }
+    return true;
+}
+
+MetricsExporter::MetricsExporter()
+    : registry_(nullptr),
+      settings_{-1, {}, 15.0},
+      beforeExport_(),
+      collectMutex_(),
+      listenSocket_(-1),
+      httpPort_(0),
+      socketsInitialized_(false),
+      httpThread_(),
+      textFileThread_() {}
+
+MetricsExporter::~MetricsExporter() {
+    Stop();
+}
+
+bool MetricsExporter::Start(
+    const MetricsRegistry& registry,
+    const MetricsExportSettings& settings,
+    std::function<void()> beforeExport,
+    std::string& outError) {
+    Stop();
+    registry_ = &registry;
+    settings_ = settings;
+    beforeExport_ = std::move(beforeExport);
+
+    if (settings_.httpPort >= 0) {
+#if defined(_WIN32)
+        WSADATA socketData{};
+        if (WSAStartup(MAKEWORD(2, 2), &socketData) != 0) {
+            outError = "Could not initialize Winsock for the metrics listener.";
+            return false;
+        }
+        socketsInitialized_ = true;
+#endif
+
+        const SocketHandle listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        if (listener == kInvalidSocket) {
+            outError = "Could not create the metrics listener socket.";
+            Stop();
+            return false;
+        }
+
+        const int reuse = 1;
+        setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons(static_cast<std::uint16_t>(settings_.httpPort));
+        socklen_t addressLength = sizeof(address);
+        if (bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 || listen(listener, 8) != 0 ||
+            getsockname(listener, reinterpret_cast<sockaddr*>(&address), &addressLength) != 0) {
+            outError = "Could not listen for metrics on 127.0.0.1:" + std::to_string(settings_.httpPort) + ".";
+            CloseSocket(listener);
+            Stop();
+            return false;
+        }
+
+        listenSocket_ = static_cast<std::intptr_t>(listener);
+        httpPort_ = ntohs(address.sin_port);
+        httpThread_ = std::jthread([this](std::stop_token stopToken) { ServeHttp(stopToken); });
+        LogInfo(LogCategory::Application, "Serving metrics on http://127.0.0.1:%d/metrics", httpPort_);
+    }
+
+    if (!settings_.textFilePath.empty()) {
+        textFileThread_ = std::jthread([this](std::stop_token stopToken) { WriteTextFilePeriodically(stopToken); });
+    }
+    return true;
+}
+
+void MetricsExporter::Stop() noexcept {
+    if (httpThread_.joinable()) {
+        httpThread_.request_stop();
+        httpThread_.join();
+    }
+    if (textFileThread_.joinable()) {
+        textFileThread_.request_stop();
+        textFileThread_.join();
+    }
+    if (listenSocket_ != -1) {
+        CloseSocket(static_cast<SocketHandle>(listenSocket_));
+        listenSocket_ = -1;
+    }
+#if defined(_WIN32)
+    if (socketsInitialized_) {
+        WSACleanup();
+    }
+#endif
+    socketsInitialized_ = false;
+    httpPort_ = 0;
+}
+
+bool MetricsExporter::IsRunning() const noexcept {
+    return httpThread_.joinable() || textFileThread_.joinable();
+}
+
+int MetricsExporter::GetHttpPort() const noexcept {
+    return httpPort_;
+}
+
+void MetricsExporter::Collect(std::string& outText) {
+    std::lock_guard<std::mutex> lock(collectMutex_);
+    if (beforeExport_) {
+        beforeExport_();
+    }
+    registry_->WritePrometheusText(outText);
+}
+
+void MetricsExporter::ServeHttp(std::stop_token stopToken) {
+    const SocketHandle listener = static_cast<SocketHandle>(listenSocket_);
+    std::string body;
+    while (!stopToken.stop_requested()) {
+        if (!WaitReadable(listener, kStopPollMilliseconds)) {
+            continue;
+        }
+
+        const SocketHandle client = accept(listener, nullptr, nullptr);
+        if (client == kInvalidSocket) {
+            continue;
+        }
+
+        // One scrape at a time: the request line is all that matters, and scrapers wait their turn.
+        std::string request;
+        char buffer[1024];
+        while (request.find("\r\n\r\n") == std::string::npos && request.size() < kMaxRequestBytes &&
+            WaitReadable(client, kRequestTimeoutMilliseconds)) {
+            const auto received = recv(client, buffer, sizeof(buffer), 0);
+            if (received <= 0) {
+                break;
+            }
+            request.append(buffer, static_cast<std::size_t>(received));
+        }
+
+        std::string response;
+        if (request.starts_with("GET /metrics ") || request.starts_with("GET /metrics?") || request.starts_with("GET / ")) {
+            Collect(body);
+            response = BuildHttpResponse("200 OK", "text/plain; version=0.0.4; charset=utf-8", body);
+        } else if (request.starts_with("GET ")) {
+            response = BuildHttpResponse("404 Not Found", "text/plain; charset=utf-8", "Metrics are served at /metrics.\n");
+        } else {
+            response = BuildHttpResponse("405 Method Not Allowed", "text/plain; charset=utf-8", "Only GET is supported.\n");
+        }
+        SendAll(client, response);
+        CloseSocket(client);
+    }
+}
+
+void MetricsExporter::WriteTextFilePeriodically(std::stop_token stopToken) {
+    std::mutex waitMutex;
+    std::condition_variable_any waitCondition;
+    const auto interval = std::chrono::duration<double>(std::max(settings_.textFileIntervalSeconds, 0.1));
+    bool loggedError = false;
+    // Written at once, then every interval, and a last time on Stop so the file ends with the final values.
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(collectMutex_);
+            if (beforeExport_) {
+                beforeExport_();
+            }
+        }
+
+        std::string writeError;
+        if (!WriteMetricsTextFile(*registry_, settings_.textFilePath, writeError) && !loggedError) {
+            LogWarning(LogCategory::Application, "%s", writeError);
+            loggedError = true;
+        }
+        if (stopToken.stop_requested()) {
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(waitMutex);
+        waitCondition.wait_for(lock, stopToken, interval, []() { return false; });
+    }
+}
+}
@@ -0,0 +1,744 @@
+#include "Engine/ModelBvh.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+
+namespace engine {
+namespace {
+constexpr std::uint32_t kSahBinCount = 16;
+constexpr std::uint32_t kMaxBuildDepth = 48;
+constexpr std::size_t kTraversalStackSize = 256;
+// Packet stack entries reached by at most this many lanes are finished one ray at a time.
+constexpr int kSingleRayLanes = 3;
+constexpr float kTraversalCost = 1.0f;
+constexpr float kIntersectionCost = 1.0f;
+
+ModelBounds EmptyBounds() {
+    return {glm::vec3(std::numeric_limits<float>::max()), glm::vec3(std::numeric_limits<float>::lowest())};
+}
+
+void GrowBounds(ModelBounds& bounds, const glm::vec3& point) {
+    bounds.min = glm::min(bounds.min, point);
+    bounds.max = glm::max(bounds.max, point);
+}
+
+void GrowBounds(ModelBounds& bounds, const ModelBounds& other) {
+    bounds.min = glm::min(bounds.min, other.min);
+    bounds.max = glm::max(bounds.max, other.max);
+}
+
+float SurfaceArea(const ModelBounds& bounds) {
+    const glm::vec3 extent = glm::max(bounds.max - bounds.min, glm::vec3(0.0f));
+    return 2.0f * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+}
+
+struct TriangleReference {
+    ModelBounds bounds;
+    glm::vec3 centroid;
+    std::uint32_t triangleIndex;
+};
+
+struct BinaryNode {
+    ModelBounds bounds;
+    std::uint32_t left;
+    std::uint32_t right;
+    std::uint32_t first;
+    std::uint32_t count;
+};
+
+struct SplitCandidate {
+    int axis = -1;
+    std::uint32_t bin = 0;
+    float cost = std::numeric_limits<float>::max();
+};
+
+SplitCandidate FindSahSplit(const std::vector<TriangleReference>& references, std::uint32_t first, std::uint32_t count, const ModelBounds& centroidBounds, float parentArea) {
+    SplitCandidate best;
+    if (parentArea <= 0.0f) {
+        return best;
+    }
+
+    for (int axis = 0; axis < 3; ++axis) {
+        const float axisMin = centroidBounds.min[axis];
+        const float axisExtent = centroidBounds.max[axis] - axisMin;
+        if (axisExtent <= 0.0f) {
+            continue;
+        }
+
+        std::array<ModelBounds, kSahBinCount> binBounds;
+        std::array<std::uint32_t, kSahBinCount> binCounts{};
+        binBounds.fill(EmptyBounds());
+
+        const float binScale = static_cast<float>(kSahBinCount) / axisExtent;
+        for (std::uint32_t offset = 0; offset < count; ++offset) {
+            const TriangleReference& reference = references[first + offset];
+            const std::uint32_t bin = std::min(
+                static_cast<std::uint32_t>((reference.centroid[axis] - axisMin) * binScale),
+                kSahBinCount - 1);
+            GrowBounds(binBounds[bin], reference.bounds);
+            ++binCounts[bin];
+        }
+
+        std::array<float, kSahBinCount - 1> rightCosts{};
+        ModelBounds rightBounds = EmptyBounds();
+        std::uint32_t rightCount = 0;
+        for (std::uint32_t bin = kSahBinCount - 1; bin > 0; --bin) {
+            GrowBounds(rightBounds, binBounds[bin]);
+            rightCount += binCounts[bin];
+            rightCosts[bin - 1] = rightCount > 0 ? SurfaceArea(rightBounds) * static_cast<float>(rightCount) : 0.0f;
+        }
+
+        ModelBounds leftBounds = EmptyBounds();
+        std::uint32_t leftCount = 0;
+        for (std::uint32_t bin = 0; bin + 1 < kSahBinCount; ++bin) {
+            GrowBounds(leftBounds, binBounds[bin]);
+            leftCount += binCounts[bin];
+            if (leftCount == 0 || leftCount == count) {
+                continue;
+            }
+
+            const float cost = kTraversalCost +
+                kIntersectionCost * (SurfaceArea(leftBounds) * static_cast<float>(leftCount) + rightCosts[bin]) / parentArea;
+            if (cost < best.cost) {
+                best.axis = axis;
+                best.bin = bin;
+                best.cost = cost;
+            }
+        }
+    }
+
+    return best;
+}
+
+std::vector<BinaryNode> BuildBinaryTree(std::vector<TriangleReference>& references) {
+    std::vector<BinaryNode> nodes;
+    nodes.reserve(references.size() * 2);
+
+    struct PendingRange {
+        std::uint32_t nodeIndex;
+        std::uint32_t depth;
+    };
+
+    nodes.push_back(BinaryNode{EmptyBounds(), 0, 0, 0, static_cast<std::uint32_t>(references.size())});
+    std::vector<PendingRange> pending{{0, 0}};
+
+    while (!pending.empty()) {
+        const PendingRange range = pending.back();
+        pending.pop_back();
+
+        const std::uint32_t first = nodes[range.nodeIndex].first;
+        const std::uint32_t count = nodes[range.nodeIndex].count;
+
+        ModelBounds bounds = EmptyBounds();
+        ModelBounds centroidBounds = EmptyBounds();
+        for (std::uint32_t offset = 0; offset < count; ++offset) {
+            GrowBounds(bounds, references[first + offset].bounds);
+            GrowBounds(centroidBounds, references[first + offset].centroid);
+        }
+        nodes[range.nodeIndex].bounds = bounds;
+
+        if (count <= 1 || range.depth >= kMaxBuildDepth) {
+            continue;
+        }
+
+        const SplitCandidate split = FindSahSplit(references, first, count, centroidBounds, SurfaceArea(bounds));
+        const float leafCost = kIntersectionCost * static_cast<float>(count);
+        if (count <= ModelBvh::kMaxLeafTriangles && (split.axis < 0 || split.cost >= leafCost)) {
+            continue;
+        }
+
+        std::uint32_t splitOffset = 0;
+        if (split.axis >= 0) {
+            const int axis = split.axis;
+            const float axisMin = centroidBounds.min[axis];
+            const float binScale = static_cast<float>(kSahBinCount) / (centroidBounds.max[axis] - axisMin);
+            const auto middle = std::partition(
+                references.begin() + first,
+                references.begin() + first + count,
+                [&](const TriangleReference& reference) {
+                    const std::uint32_t bin = std::min(
+                        static_cast<std::uint32_t>((reference.centroid[axis] - axisMin) * binScale),
+                        kSahBinCount - 1);
+                    return bin <= split.bin;
+                });
+            splitOffset = static_cast<std::uint32_t>(middle - (references.begin() + first));
+        }
+
+        if (splitOffset == 0 || splitOffset == count) {
+            splitOffset = count / 2;
+            const glm::vec3 extent = centroidBounds.max - centroidBounds.min;
+            const int axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+            std::nth_element(
+                references.begin() + first,
+                references.begin() + first + splitOffset,
+                references.begin() + first + count,
+                [axis](const TriangleReference& left, const TriangleReference& right) {
+                    return left.centroid[axis] < right.centroid[axis];
+                });
+        }
+
+        const std::uint32_t leftIndex = static_cast<std::uint32_t>(nodes.size());
+        nodes.push_back(BinaryNode{EmptyBounds(), 0, 0, first, splitOffset});
+        nodes.push_back(BinaryNode{EmptyBounds(), 0, 0, first + splitOffset, count - splitOffset});
+
+        BinaryNode& parent = nodes[range.nodeIndex];
+        parent.left = leftIndex;
+        parent.right = leftIndex + 1;
+        parent.count = 0;
+
+        pending.push_back({leftIndex, range.depth + 1});
+        pending.push_back({leftIndex + 1, range.depth + 1});
+    }
+
+    return nodes;
+}
+
+bool IsBinaryLeaf(const BinaryNode& node) {
+    return node.count > 0;
+}
+
+void SetNodeLane(ModelBvh::Node& node, std::size_t lane, const ModelBounds& bounds, std::uint32_t child, std::uint32_t triangleCount) {
+    node.minX[lane] = bounds.min.x;
+    node.minY[lane] = bounds.min.y;
+    node.minZ[lane] = bounds.min.z;
+    node.maxX[lane] = bounds.max.x;
+    node.maxY[lane] = bounds.max.y;
+    node.maxZ[lane] = bounds.max.z;
+    node.child[lane] = child;
+    node.triangleCount[lane] = triangleCount;
+}
+
+ModelBvh::Node MakeEmptyNode() {
+    ModelBvh::Node node{};
+    for (std::size_t lane = 0; lane < ModelBvh::kNodeWidth; ++lane) {
+        SetNodeLane(node, lane, EmptyBounds(), ModelBvh::kEmptyChild, 0);
+    }
+    return node;
+}
+
+std::vector<ModelBvh::Node> CollapseToWideNodes(const std::vector<BinaryNode>& binaryNodes) {
+    std::vector<ModelBvh::Node> wideNodes;
+    wideNodes.reserve(binaryNodes.size() / 2 + 1);
+    wideNodes.push_back(MakeEmptyNode());
+
+    const BinaryNode& root = binaryNodes.front();
+    if (IsBinaryLeaf(root)) {
+        SetNodeLane(wideNodes.front(), 0, root.bounds, root.first, root.count);
+        return wideNodes;
+    }
+
+    struct PendingCollapse {
+        std::uint32_t wideIndex;
+        std::uint32_t binaryIndex;
+    };
+    std::vector<PendingCollapse> pending{{0, 0}};
+
+    while (!pending.empty()) {
+        const PendingCollapse current = pending.back();
+        pending.pop_back();
+
+        std::array<std::uint32_t, ModelBvh::kNodeWidth> lanes{};
+        std::size_t laneCount = 0;
+        lanes[laneCount++] = binaryNodes[current.binaryIndex].left;
+        lanes[laneCount++] = binaryNodes[current.binaryIndex].right;
+
+        while (laneCount < ModelBvh::kNodeWidth) {
+            std::size_t expandLane = ModelBvh::kNodeWidth;
+            float largestArea = -1.0f;
+            for (std::size_t lane = 0; lane < laneCount; ++lane) {
+                const BinaryNode& candidate = binaryNodes[lanes[lane]];
+                const float area = SurfaceArea(candidate.bounds);
+                if (!IsBinaryLeaf(candidate) && area > largestArea) {
+                    largestArea = area;
+                    expandLane = lane;
+                }
+            }
+
+            if (expandLane == ModelBvh::kNodeWidth) {
+                break;
+            }
+
+            const BinaryNode& expanded = binaryNodes[lanes[expandLane]];
+            lanes[expandLane] = expanded.left;
+            lanes[laneCount++] = expanded.right;
+        }
+
+        for (std::size_t lane = 0; lane < laneCount; ++lane) {
+            const BinaryNode& child = binaryNodes[lanes[lane]];
+            if (IsBinaryLeaf(child)) {
+                SetNodeLane(wideNodes[current.wideIndex], lane, child.bounds, child.first, child.count);
+                continue;
+            }
+
+            const std::uint32_t childWideIndex = static_cast<std::uint32_t>(wideNodes.size());
+            wideNodes.push_back(MakeEmptyNode());
+            SetNodeLane(wideNodes[current.wideIndex], lane, child.bounds, childWideIndex, 0);
+            pending.push_back({childWideIndex, lanes[lane]});
+        }
+    }
+
+    return wideNodes;
+}
+
+float SafeInverse(float value) {
+    constexpr float kMinimumMagnitude = 1.0e-30f;
+    if (std::fabs(value) < kMinimumMagnitude) {
+        return 1.0f / std::copysign(kMinimumMagnitude, value);
+    }
+    return 1.0f / value;
+}
+}
+
+ModelBvh ModelBvh::Build(
+    const std::vector<glm::vec3>& positions,
+    const std::vector<std::uint32_t>& indices,
+    const std::vector<ModelSubmesh>& submeshes) {
+    ModelBvh bvh;
+
+    const std::size_t triangleCount = indices.size() / 3;
+    std::vector<std::uint32_t> triangleSubmesh(triangleCount, kNoSubmesh);
+    for (std::size_t submeshIndex = 0; submeshIndex < submeshes.size(); ++submeshIndex) {
+        const ModelSubmesh& submesh = submeshes[submeshIndex];
+        const std::size_t firstTriangle = submesh.indexStart / 3;
+        const std::size_t endTriangle = std::min<std::size_t>((static_cast<std::size_t>(submesh.indexStart) + submesh.indexCount) / 3, triangleCount);
+        for (std::size_t triangle = firstTriangle; triangle < endTriangle; ++triangle) {
+            triangleSubmesh[triangle] = static_cast<std::uint32_t>(submeshIndex);
+        }
+    }
+
+    bvh.submeshBounds_.assign(submeshes.size(), EmptyBounds());
+
+    std::vector<TriangleReference> references;
+    references.reserve(triangleCount);
+    for (std::size_t triangle = 0; triangle < triangleCount; ++triangle) {
+        const std::uint32_t i0 = indices[triangle * 3];
+        const std::uint32_t i1 = indices[triangle * 3 + 1];
+        const std::uint32_t i2 = indices[triangle * 3 + 2];
+        if (i0 >= positions.size() || i1 >= positions.size() || i2 >= positions.size()) {
+            continue;
+        }
+
+        ModelBounds bounds = EmptyBounds();
+        GrowBounds(bounds, positions[i0]);
+        GrowBounds(bounds, positions[i1]);
+        GrowBounds(bounds, positions[i2]);
+        references.push_back({bounds, (bounds.min + bounds.max) * 0.5f, static_cast<std::uint32_t>(triangle)});
+
+        if (triangleSubmesh[triangle] != kNoSubmesh) {
+            GrowBounds(bvh.submeshBounds_[triangleSubmesh[triangle]], bounds);
+        }
+    }
+
+    if (references.empty()) {
+        bvh.submeshBounds_.clear();
+        return bvh;
+    }
+
+    const std::vector<BinaryNode> binaryNodes = BuildBinaryTree(references);
+    bvh.nodes_ = CollapseToWideNodes(binaryNodes);
+
+    bvh.triangles_.reserve(references.size());
+    for (const TriangleReference& reference : references) {
+        const std::size_t base = static_cast<std::size_t>(reference.triangleIndex) * 3;
+        const glm::vec3& p0 = positions[indices[base]];
+        const glm::vec3& p1 = positions[indices[base + 1]];
+        const glm::vec3& p2 = positions[indices[base + 2]];
+        bvh.triangles_.push_back(Triangle{p0, p1 - p0, p2 - p0, reference.triangleIndex, triangleSubmesh[reference.triangleIndex], 0});
+    }
+
+    return bvh;
+}
+
+template <bool kAnyHit>
+std::uint32_t ModelBvh::TraverseRay(
+    const ModelRay& ray,
+    std::uint32_t rootChild,
+    std::uint32_t rootTriangleCount,
+    float& inOutDistance,
+    float& outU,
+    float& outV,
+    ModelHitFilter filter,
+    const void* filterContext) const noexcept {
+    const float inverseX = SafeInverse(ray.direction.x);
+    const float inverseY = SafeInverse(ray.direction.y);
+    const float inverseZ = SafeInverse(ray.direction.z);
+    const float offsetX = -ray.origin.x * inverseX;
+    const float offsetY = -ray.origin.y * inverseY;
+    const float offsetZ = -ray.origin.z * inverseZ;
+
+    struct StackEntry {
+        std::uint32_t child;
+        std::uint32_t triangleCount;
+        float entryDistance;
+    };
+
+    std::array<StackEntry, kTraversalStackSize> stack;
+    std::size_t stackSize = 0;
+    stack[stackSize++] = {rootChild, rootTriangleCount, 0.0f};
+
+    float closestDistance = inOutDistance;
+    std::uint32_t closestTriangle = kNoTriangle;
+
+    while (stackSize > 0) {
+        const StackEntry entry = stack[--stackSize];
+        if (entry.entryDistance > closestDistance) {
+            continue;
+        }
+
+        if (entry.triangleCount > 0) {
+            for (std::uint32_t offset = 0; offset < entry.triangleCount; ++offset) {
+                const std::uint32_t triangleSlot = entry.child + offset;
+                const Triangle& triangle = triangles_[triangleSlot];
+                const glm::vec3 pvec = glm::cross(ray.direction, triangle.edge2);
+                const float determinant = glm::dot(triangle.edge1, pvec);
+                if (std::fabs(determinant) < 1.0e-12f) {
+                    continue;
+                }
+
+                const float inverseDeterminant = 1.0f / determinant;
+                const glm::vec3 tvec = ray.origin - triangle.vertex0;
+                const float u = glm::dot(tvec, pvec) * inverseDeterminant;
+                if (u < 0.0f || u > 1.0f) {
+                    continue;
+                }
+
+                const glm::vec3 qvec = glm::cross(tvec, triangle.edge1);
+                const float v = glm::dot(ray.direction, qvec) * inverseDeterminant;
+                if (v < 0.0f || u + v > 1.0f) {
+                    continue;
+                }
+
+                const float distance = glm::dot(triangle.edge2, qvec) * inverseDeterminant;
+                if (distance <= 1.0e-6f || distance >= closestDistance ||
+                    (filter && !filter(filterContext, triangle.triangleIndex, triangle.submeshIndex, u, v))) {
+                    continue;
+                }
+
+                closestDistance = distance;
+                closestTriangle = triangleSlot;
+                outU = u;
+                outV = v;
+                if constexpr (kAnyHit) {
+                    inOutDistance = closestDistance;
+                    return closestTriangle;
+                }
+            }
+            continue;
+        }
+
+        const Node& node = nodes_[entry.child];
+        std::array<float, kNodeWidth> laneNear{};
+        std::array<float, kNodeWidth> laneFar{};
+        for (std::size_t lane = 0; lane < kNodeWidth; ++lane) {
+            const float x0 = node.minX[lane] * inverseX + offsetX;
+            const float x1 = node.maxX[lane] * inverseX + offsetX;
+            const float y0 = node.minY[lane] * inverseY + offsetY;
+            const float y1 = node.maxY[lane] * inverseY + offsetY;
+            const float z0 = node.minZ[lane] * inverseZ + offsetZ;
+            const float z1 = node.maxZ[lane] * inverseZ + offsetZ;
+            laneNear[lane] = std::max(std::max(std::min(x0, x1), std::min(y0, y1)), std::max(std::min(z0, z1), 0.0f));
+            laneFar[lane] = std::min(std::min(std::max(x0, x1), std::max(y0, y1)), std::min(std::max(z0, z1), closestDistance));
+        }
+
+        std::array<StackEntry, kNodeWidth> hits;
+        std::size_t hitCount = 0;
+        for (std::size_t lane = 0; lane < kNodeWidth; ++lane) {
+            if (node.child[lane] == kEmptyChild || laneNear[lane] > laneFar[lane]) {
+                continue;
+            }
+
+            StackEntry hit{node.child[lane], node.triangleCount[lane], laneNear[lane]};
+            std::size_t insertAt = hitCount++;
+            while (insertAt > 0 && hits[insertAt - 1].entryDistance < hit.entryDistance) {
+                hits[insertAt] = hits[insertAt - 1];
+                --insertAt;
+            }
+            hits[insertAt] = hit;
+        }
+
+        for (std::size_t hitIndex = 0; hitIndex < hitCount && stackSize < kTraversalStackSize; ++hitIndex) {
+            stack[stackSize++] = hits[hitIndex];
+        }
+    }
+
+    inOutDistance = closestDistance;
+    return closestTriangle;
+}
+
+std::optional<ModelRayHit> ModelBvh::Intersect(const ModelRay& ray, float maxDistance) const noexcept {
+    if (nodes_.empty()) {
+        return std::nullopt;
+    }
+
+    float distance = maxDistance;
+    float u = 0.0f;
+    float v = 0.0f;
+    const std::uint32_t triangleSlot = TraverseRay<false>(ray, 0, 0, distance, u, v, nullptr, nullptr);
+    if (triangleSlot == kNoTriangle) {
+        return std::nullopt;
+    }
+
+    return ModelRayHit{
+        distance,
+        triangles_[triangleSlot].triangleIndex,
+        triangles_[triangleSlot].submeshIndex,
+        u,
+        v,
+        ray.origin + ray.direction * distance};
+}
+
+template <bool kAnyHit>
+std::uint32_t ModelBvh::TraversePacket(
+    const ModelRayPacket& packet,
+    ModelRayPacketHit* outHit,
+    ModelHitFilter filter,
+    const void* filterContext) const noexcept {
+    constexpr std::size_t kLanes = kModelRayPacketWidth;
+
+    // Inactive and finished lanes get a negative limit, which no box or triangle can beat.
+    std::array<float, kLanes> closestDistance{};
+    std::array<float, kLanes> inverseX{};
+    std::array<float, kLanes> inverseY{};
+    std::array<float, kLanes> inverseZ{};
+    std::array<float, kLanes> offsetX{};
+    std::array<float, kLanes> offsetY{};
+    std::array<float, kLanes> offsetZ{};
+    std::uint32_t activeMask = 0;
+    for (std::size_t lane = 0; lane < kLanes; ++lane) {
+        const bool active = packet.maxDistance[lane] > 0.0f;
+        activeMask |= static_cast<std::uint32_t>(active) << lane;
+        closestDistance[lane] = active ? packet.maxDistance[lane] : -1.0f;
+        inverseX[lane] = SafeInverse(packet.directionX[lane]);
+        inverseY[lane] = SafeInverse(packet.directionY[lane]);
+        inverseZ[lane] = SafeInverse(packet.directionZ[lane]);
+        offsetX[lane] = -packet.originX[lane] * inverseX[lane];
+        offsetY[lane] = -packet.originY[lane] * inverseY[lane];
+        offsetZ[lane] = -packet.originZ[lane] * inverseZ[lane];
+    }
+
+    std::array<std::uint32_t, kLanes> closestTriangle;
+    std::array<float, kLanes> closestU{};
+    std::array<float, kLanes> closestV{};
+    closestTriangle.fill(kNoTriangle);
+    std::uint32_t occludedMask = 0;
+
+    // Möller-Trumbore for one lane; inlined into the lane loop below, where it vectorizes.
+    const auto intersectLane = [&](std::size_t lane, const Triangle& triangle, float& outDistance, float& outU, float& outV) {
+        const float directionX = packet.directionX[lane];
+        const float directionY = packet.directionY[lane];
+        const float directionZ = packet.directionZ[lane];
+        const float pX = directionY * triangle.edge2.z - directionZ * triangle.edge2.y;
+        const float pY = directionZ * triangle.edge2.x - directionX * triangle.edge2.z;
+        const float pZ = directionX * triangle.edge2.y - directionY * triangle.edge2.x;
+        const float determinant = triangle.edge1.x * pX + triangle.edge1.y * pY + triangle.edge1.z * pZ;
+        const float inverseDeterminant = 1.0f / determinant;
+        const float tX = packet.originX[lane] - triangle.vertex0.x;
+        const float tY = packet.originY[lane] - triangle.vertex0.y;
+        const float tZ = packet.originZ[lane] - triangle.vertex0.z;
+        const float qX = tY * triangle.edge1.z - tZ * triangle.edge1.y;
+        const float qY = tZ * triangle.edge1.x - tX * triangle.edge1.z;
+        const float qZ = tX * triangle.edge1.y - tY * triangle.edge1.x;
+        outU = (tX * pX + tY * pY + tZ * pZ) * inverseDeterminant;
+        outV = (directionX * qX + directionY * qY + directionZ * qZ) * inverseDeterminant;
+        outDistance = (triangle.edge2.x * qX + triangle.edge2.y * qY + triangle.edge2.z * qZ) * inverseDeterminant;
+        // Non-short-circuit ands keep the lane loop branch-free.
+        return static_cast<std::uint32_t>(
+            (std::fabs(determinant) >= 1.0e-12f) & (outU >= 0.0f) & (outV >= 0.0f) & (outU + outV <= 1.0f) &
+            (outDistance > 1.0e-6f) & (outDistance < closestDistance[lane]));
+    };
+
+    // `laneMask` holds the lanes whose rays reached the entry's box.
+    struct StackEntry {
+        std::uint32_t child;
+        std::uint32_t triangleCount;
+        std::uint32_t laneMask;
+        float entryDistance;
+    };
+
+    std::array<StackEntry, kTraversalStackSize> stack;
+    std::size_t stackSize = 0;
+    if (!nodes_.empty() && activeMask != 0) {
+        stack[stackSize++] = {0, 0, activeMask, 0.0f};
+    }
+
+    while (stackSize > 0) {
+        const StackEntry entry = stack[--stackSize];
+        float farthestDistance = -1.0f;
+        for (std::size_t lane = 0; lane < kLanes; ++lane) {
+            farthestDistance = std::max(farthestDistance, closestDistance[lane]);
+        }
+        if (entry.entryDistance > farthestDistance) {
+            continue;
+        }
+
+        // Once the rays have parted ways, as they do near the leaves of a dense mesh, testing a
+        // node's four children at once for one ray beats testing one child for a few live lanes.
+        if (std::popcount(entry.laneMask) <= kSingleRayLanes) {
+            for (std::uint32_t lanes = entry.laneMask; lanes != 0; lanes &= lanes - 1) {
+                const std::size_t lane = static_cast<std::size_t>(std::countr_zero(lanes));
+                if (closestDistance[lane] <= 0.0f) {
+                    continue;
+                }
+
+                const ModelRay ray{
+                    glm::vec3(packet.originX[lane], packet.originY[lane], packet.originZ[lane]),
+                    glm::vec3(packet.directionX[lane], packet.directionY[lane], packet.directionZ[lane])};
+                float u = 0.0f;
+                float v = 0.0f;
+                const std::uint32_t triangleSlot =
+                    TraverseRay<kAnyHit>(ray, entry.child, entry.triangleCount, closestDistance[lane], u, v, filter, filterContext);
+                if (triangleSlot == kNoTriangle) {
+                    continue;
+                }
+
+                if constexpr (kAnyHit) {
+                    occludedMask |= 1u << lane;
+                    closestDistance[lane] = -1.0f;
+                } else {
+                    closestTriangle[lane] = triangleSlot;
+                    closestU[lane] = u;
+                    closestV[lane] = v;
+                }
+            }
+
+            if (kAnyHit && occludedMask == activeMask) {
+                return occludedMask;
+            }
+            continue;
+        }
+
+        if (entry.triangleCount > 0) {
+            for (std::uint32_t offset = 0; offset < entry.triangleCount; ++offset) {
+                const std::uint32_t triangleSlot = entry.child + offset;
+                const Triangle& triangle = triangles_[triangleSlot];
+                std::array<float, kLanes> distance;
+                std::array<float, kLanes> u;
+                std::array<float, kLanes> v;
+                std::array<std::uint32_t, kLanes> candidate;
+                for (std::size_t lane = 0; lane < kLanes; ++lane) {
+                    candidate[lane] = intersectLane(lane, triangle, distance[lane], u[lane], v[lane]);
+                }
+                std::uint32_t candidateMask = 0;
+                for (std::size_t lane = 0; lane < kLanes; ++lane) {
+                    candidateMask |= candidate[lane] << lane;
+                }
+                candidateMask &= entry.laneMask;
+                while (candidateMask != 0) {
+                    const std::size_t lane = static_cast<std::size_t>(std::countr_zero(candidateMask));
+                    candidateMask &= candidateMask - 1;
+                    if (filter && !filter(filterContext, triangle.triangleIndex, triangle.submeshIndex, u[lane], v[lane])) {
+                        continue;
+                    }
+
+                    if constexpr (kAnyHit) {
+                        occludedMask |= 1u << lane;
+                        closestDistance[lane] = -1.0f;
+                    } else {
+                        closestDistance[lane] = distance[lane];
+                        closestTriangle[lane] = triangleSlot;
+                        closestU[lane] = u[lane];
+                        closestV[lane] = v[lane];
+                    }
+                }
+            }
+
+            if (kAnyHit && occludedMask == activeMask) {
+                return occludedMask;
+            }
+            continue;
+        }
+
+        const Node& node = nodes_[entry.child];
+        std::array<StackEntry, kNodeWidth> hits;
+        std::size_t hitCount = 0;
+        for (std::size_t child = 0; child < kNodeWidth; ++child) {
+            if (node.child[child] == kEmptyChild) {
+                continue;
+            }
+
+            std::array<float, kLanes> laneNear;
+            std::array<std::uint32_t, kLanes> laneHit;
+            for (std::size_t lane = 0; lane < kLanes; ++lane) {
+                const float x0 = node.minX[child] * inverseX[lane] + offsetX[lane];
+                const float x1 = node.maxX[child] * inverseX[lane] + offsetX[lane];
+                const float y0 = node.minY[child] * inverseY[lane] + offsetY[lane];
+                const float y1 = node.maxY[child] * inverseY[lane] + offsetY[lane];
+                const float z0 = node.minZ[child] * inverseZ[lane] + offsetZ[lane];
+                const float z1 = node.maxZ[child] * inverseZ[lane] + offsetZ[lane];
+                const float near = std::max(std::max(std::min(x0, x1), std::min(y0, y1)), std::max(std::min(z0, z1), 0.0f));
+                const float far = std::min(std::min(std::max(x0, x1), std::max(y0, y1)), std::min(std::max(z0, z1), closestDistance[lane]));
+                laneHit[lane] = static_cast<std::uint32_t>(near <= far);
+                laneNear[lane] = near <= far ? near : std::numeric_limits<float>::max();
+            }
+
+            float entryDistance = std::numeric_limits<float>::max();
+            std::uint32_t laneMask = 0;
+            for (std::size_t lane = 0; lane < kLanes; ++lane) {
+                entryDistance = std::min(entryDistance, laneNear[lane]);
+                laneMask |= laneHit[lane] << lane;
+            }
+            laneMask &= entry.laneMask;
+            if (laneMask == 0) {
+                continue;
+            }
+
+            StackEntry hit{node.child[child], node.triangleCount[child], laneMask, entryDistance};
+            std::size_t insertAt = hitCount++;
+            while (insertAt > 0 && hits[insertAt - 1].entryDistance < hit.entryDistance) {
+                hits[insertAt] = hits[insertAt - 1];
+                --insertAt;
+            }
+            hits[insertAt] = hit;
+        }
+
+        for (std::size_t hitIndex = 0; hitIndex < hitCount && stackSize < kTraversalStackSize; ++hitIndex) {
+            stack[stackSize++] = hits[hitIndex];
+        }
+    }
+
+    if (outHit) {
+        for (std::size_t lane = 0; lane < kLanes; ++lane) {
+            const bool hit = closestTriangle[lane] != kNoTriangle;
+            outHit->distance[lane] = hit ? closestDistance[lane] : 0.0f;
+            outHit->triangleIndex[lane] = hit ? triangles_[closestTriangle[lane]].triangleIndex : kNoTriangle;
+            outHit->submeshIndex[lane] = hit ? triangles_[closestTriangle[lane]].submeshIndex : kNoSubmesh;
+            outHit->barycentricU[lane] = closestU[lane];
+            outHit->barycentricV[lane] = closestV[lane];
+        }
+    }
+    return occludedMask;
+}
+
+void ModelBvh::IntersectPacket(
+    const ModelRayPacket& packet,
+    ModelRayPacketHit& outHit,
+    ModelHitFilter filter,
+    const void* filterContext) const noexcept {
+    TraversePacket<false>(packet, &outHit, filter, filterContext);
+}
+
+std::uint32_t ModelBvh::OccludedPacket(const ModelRayPacket& packet, ModelHitFilter filter, const void* filterContext) const noexcept {
+    return TraversePacket<true>(packet, nullptr, filter, filterContext);
+}
+
+bool ModelBvh::IsEmpty() const noexcept {
+    return triangles_.empty();
+}
+
+std::size_t ModelBvh::GetNodeCount() const noexcept {
+    return nodes_.size();
+}
+
+std::size_t ModelBvh::GetTriangleCount() const noexcept {
+    return triangles_.size();
+}
+
+const std::vector<ModelBounds>& ModelBvh::GetSubmeshBounds() const noexcept {
+    return submeshBounds_;
+}
+}
@@ -0,0 +1,50 @@
+#include "Engine/ModelCamera.hpp"
+
+#include <algorithm>
+
+#include <glm/ext/matrix_clip_space.hpp>
+#include <glm/ext/matrix_transform.hpp>
+#include <glm/geometric.hpp>
+#include <glm/matrix.hpp>
+#include <glm/vec4.hpp>
+
+namespace engine {
+namespace {
+glm::mat4 BuildViewMatrix(const ModelCamera& camera) {
+    const float clampedDistance = std::clamp(camera.cameraDistance, 1.0f, 20.0f);
+    return glm::lookAt(
+        glm::vec3(0.0f, 0.0f, clampedDistance),
+        glm::vec3(0.0f, 0.0f, 0.0f),
+        glm::vec3(0.0f, 1.0f, 0.0f));
+}
+
+glm::mat4 BuildProjectionMatrix(float aspectRatio) {
+    return glm::perspective(glm::radians(60.0f), aspectRatio, 0.1f, 100.0f);
+}
+}
+
+glm::mat4 BuildModelMatrix(const ModelCamera& camera) {
+    glm::mat4 modelMatrix(1.0f);
+    modelMatrix = glm::rotate(modelMatrix, glm::radians(camera.yawDegrees), glm::vec3(0.0f, 1.0f, 0.0f));
+    modelMatrix = glm::rotate(modelMatrix, glm::radians(camera.pitchDegrees), glm::vec3(1.0f, 0.0f, 0.0f));
+    modelMatrix = glm::rotate(modelMatrix, glm::radians(camera.rollDegrees), glm::vec3(0.0f, 0.0f, 1.0f));
+    modelMatrix = glm::translate(modelMatrix, -camera.orbitPivot);
+    return modelMatrix;
+}
+
+glm::mat4 BuildModelViewProjection(const ModelCamera& camera, float aspectRatio) {
+    return BuildProjectionMatrix(aspectRatio) * BuildViewMatrix(camera) * BuildModelMatrix(camera);
+}
+
+ModelRay BuildModelSpacePickRay(const ModelCamera& camera, float aspectRatio, float ndcX, float ndcY) {
+    const glm::mat4 inverseMvp = glm::inverse(BuildModelViewProjection(camera, aspectRatio));
+
+    glm::vec4 nearPoint = inverseMvp * glm::vec4(ndcX, ndcY, -1.0f, 1.0f);
+    glm::vec4 farPoint = inverseMvp * glm::vec4(ndcX, ndcY, 1.0f, 1.0f);
+    nearPoint /= nearPoint.w;
+    farPoint /= farPoint.w;
+
+    const glm::vec3 origin(nearPoint);
+    return {origin, glm::normalize(glm::vec3(farPoint) - origin)};
+}
+}
@@ -0,0 +1,184 @@
+#include "Engine/ModelCook.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace engine {
+namespace {
+constexpr std::uint32_t kUnusedMaterial = std::numeric_limits<std::uint32_t>::max();
+
+bool MaterialsEqual(const ModelMaterial& left, const ModelMaterial& right) noexcept {
+    return left.textureIndex == right.textureIndex &&
+        left.opacityTextureIndex == right.opacityTextureIndex &&
+        left.normalTextureIndex == right.normalTextureIndex &&
+        left.emissiveTextureIndex == right.emissiveTextureIndex &&
+        left.specularTextureIndex == right.specularTextureIndex &&
+        left.opacity == right.opacity &&
+        left.alphaCutoff == right.alphaCutoff &&
+        left.isTransparent == right.isTransparent &&
+        left.alphaCutoutEnabled == right.alphaCutoutEnabled &&
+        left.opacityTextureInverted == right.opacityTextureInverted;
+}
+}
+
+SubmeshMergeStats MergeSubmeshesByMaterial(ModelData& model) {
+    SubmeshMergeStats stats{model.submeshes.size(), model.submeshes.size(), model.materials.size(), model.materials.size()};
+    if (model.submeshes.empty()) {
+        return stats;
+    }
+
+    // Map every referenced material onto the first value-identical entry, in first-use order.
+    std::vector<std::uint32_t> remappedMaterial(model.materials.size(), kUnusedMaterial);
+    std::vector<ModelMaterial> mergedMaterials;
+    mergedMaterials.reserve(model.materials.size());
+    for (const ModelSubmesh& submesh : model.submeshes) {
+        if (submesh.materialIndex >= model.materials.size() || remappedMaterial[submesh.materialIndex] != kUnusedMaterial) {
+            continue;
+        }
+
+        const ModelMaterial& material = model.materials[submesh.materialIndex];
+        const auto existing = std::find_if(
+            mergedMaterials.begin(),
+            mergedMaterials.end(),
+            [&](const ModelMaterial& candidate) { return MaterialsEqual(candidate, material); });
+        if (existing != mergedMaterials.end()) {
+            remappedMaterial[submesh.materialIndex] = static_cast<std::uint32_t>(existing - mergedMaterials.begin());
+            continue;
+        }
+
+        remappedMaterial[submesh.materialIndex] = static_cast<std::uint32_t>(mergedMaterials.size());
+        mergedMaterials.push_back(material);
+    }
+
+    // Submeshes without a valid material keep sorting after all real materials.
+    std::vector<std::uint32_t> submeshMaterial(model.submeshes.size());
+    for (std::size_t submeshIndex = 0; submeshIndex < model.submeshes.size(); ++submeshIndex) {
+        const std::uint32_t materialIndex = model.submeshes[submeshIndex].materialIndex;
+        submeshMaterial[submeshIndex] = materialIndex < remappedMaterial.size() ? remappedMaterial[materialIndex] : kUnusedMaterial;
+    }
+
+    std::vector<std::size_t> order(model.submeshes.size());
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t left, std::size_t right) {
+        return submeshMaterial[left] < submeshMaterial[right];
+    });
+
+    std::vector<std::uint32_t> mergedIndices;
+    mergedIndices.reserve(model.indices.size());
+    std::vector<ModelSubmesh> mergedSubmeshes;
+    mergedSubmeshes.reserve(mergedMaterials.size() + 1);
+    for (const std::size_t submeshIndex : order) {
+        const ModelSubmesh& submesh = model.submeshes[submeshIndex];
+        const std::size_t indexStart = std::min<std::size_t>(submesh.indexStart, model.indices.size());
+        const std::size_t indexEnd = std::min<std::size_t>(indexStart + submesh.indexCount, model.indices.size());
+        const std::size_t triangleIndexEnd = indexStart + (indexEnd - indexStart) / 3 * 3;
+        if (triangleIndexEnd == indexStart) {
+            continue;
+        }
+
+        const std::uint32_t materialIndex = submeshMaterial[submeshIndex];
+        const std::uint32_t mergedStart = static_cast<std::uint32_t>(mergedIndices.size());
+        mergedIndices.insert(
+            mergedIndices.end(),
+            model.indices.begin() + static_cast<std::ptrdiff_t>(indexStart),
+            model.indices.begin() + static_cast<std::ptrdiff_t>(triangleIndexEnd));
+
+        const std::uint32_t addedCount = static_cast<std::uint32_t>(mergedIndices.size()) - mergedStart;
+        if (!mergedSubmeshes.empty() && mergedSubmeshes.back().materialIndex == materialIndex) {
+            mergedSubmeshes.back().indexCount += addedCount;
+        } else {
+            mergedSubmeshes.push_back(ModelSubmesh{mergedStart, addedCount, materialIndex});
+        }
+    }
+
+    model.indices = std::move(mergedIndices);
+    model.materials = std::move(mergedMaterials);
+    model.submeshes = std::move(mergedSubmeshes);
+
+    stats.submeshCountAfter = model.submeshes.size();
+    stats.materialCountAfter = model.materials.size();
+    return stats;
+}
+
+std::size_t ValidateTriangleIndices(ModelData& model) {
+    const std::size_t vertexCount = model.positions.size();
+    const std::size_t triangleIndexCount = model.indices.size() / 3 * 3;
+    auto triangleIsValid = [&](std::size_t index) {
+        return model.indices[index] < vertexCount && model.indices[index + 1] < vertexCount && model.indices[index + 2] < vertexCount;
+    };
+
+    std::size_t removedTriangles = 0;
+    for (std::size_t index = 0; index < triangleIndexCount; index += 3) {
+        removedTriangles += triangleIsValid(index) ? 0 : 1;
+    }
+    if (removedTriangles == 0) {
+        model.indices.resize(triangleIndexCount);
+        model.indicesValidated = true;
+        return 0;
+    }
+
+    // keptBefore[i] is where index slot i lands once rejected triangles are removed; submesh
+    // bounds are remapped through it.
+    std::vector<std::uint32_t> keptBefore(model.indices.size() + 1, 0);
+    std::size_t writeIndex = 0;
+    for (std::size_t index = 0; index < triangleIndexCount; index += 3) {
+        const bool keep = triangleIsValid(index);
+        for (std::size_t corner = 0; corner < 3; ++corner) {
+            keptBefore[index + corner] = static_cast<std::uint32_t>(writeIndex);
+            if (keep) {
+                model.indices[writeIndex++] = model.indices[index + corner];
+            }
+        }
+    }
+    std::fill(keptBefore.begin() + static_cast<std::ptrdiff_t>(triangleIndexCount), keptBefore.end(), static_cast<std::uint32_t>(writeIndex));
+    model.indices.resize(writeIndex);
+
+    for (ModelSubmesh& submesh : model.submeshes) {
+        const std::size_t indexStart = std::min<std::size_t>(submesh.indexStart, keptBefore.size() - 1);
+        const std::size_t indexEnd = std::min<std::size_t>(indexStart + submesh.indexCount, keptBefore.size() - 1);
+        submesh.indexStart = keptBefore[indexStart];
+        submesh.indexCount = keptBefore[indexEnd] - keptBefore[indexStart];
+    }
+    model.indicesValidated = true;
+    return removedTriangles;
+}
+
+std::vector<bool> FindTexturesForChannels(const ModelData& model, MaterialChannelMask channels) {
+    std::vector<bool> texturesNeeded(model.texturePaths.size(), false);
+    auto markTexture = [&](MaterialChannelMask channel, std::int32_t textureIndex) {
+        if ((channels & channel) != 0 && textureIndex >= 0 && static_cast<std::size_t>(textureIndex) < texturesNeeded.size()) {
+            texturesNeeded[static_cast<std::size_t>(textureIndex)] = true;
+        }
+    };
+
+    if (model.submeshes.empty()) {
+        markTexture(kMaterialChannelColor, 0);
+        return texturesNeeded;
+    }
+
+    // Materials no submesh draws with are never sampled, whatever they reference.
+    std::vector<bool> materialUsed(model.materials.size(), false);
+    for (const ModelSubmesh& submesh : model.submeshes) {
+        if (submesh.materialIndex < materialUsed.size()) {
+            materialUsed[submesh.materialIndex] = true;
+        }
+    }
+    for (std::size_t materialIndex = 0; materialIndex < model.materials.size(); ++materialIndex) {
+        if (!materialUsed[materialIndex]) {
+            continue;
+        }
+        const ModelMaterial& material = model.materials[materialIndex];
+        markTexture(kMaterialChannelColor, material.textureIndex);
+        markTexture(kMaterialChannelOpacity, material.opacityTextureIndex);
+        markTexture(kMaterialChannelNormal, material.normalTextureIndex);
+        markTexture(kMaterialChannelEmissive, material.emissiveTextureIndex);
+        markTexture(kMaterialChannelSpecular, material.specularTextureIndex);
+    }
+    return texturesNeeded;
+}
+}
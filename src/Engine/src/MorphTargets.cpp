@@ -0,0 +1,311 @@
+#include "Engine/MorphTargets.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "Engine/JobSystem.hpp"
+
+namespace engine {
+namespace {
+constexpr float kMaxQuantizedDelta = 32767.0f;
+// Moved vertices per blend job; the block's accumulators live on the worker's stack, and slots
+// within a block fit in 16 bits.
+constexpr std::size_t kBlockVertices = 1024;
+
+float SampleCurve(const std::vector<MorphWeightKey>& keys, float timeSeconds) noexcept {
+    const auto next = std::upper_bound(keys.begin(), keys.end(), timeSeconds, [](float time, const MorphWeightKey& key) {
+        return time < key.timeSeconds;
+    });
+    if (next == keys.begin()) {
+        return keys.front().weight;
+    }
+    if (next == keys.end()) {
+        return keys.back().weight;
+    }
+
+    const MorphWeightKey& previous = *(next - 1);
+    const float span = next->timeSeconds - previous.timeSeconds;
+    const float t = span > 0.0f ? (timeSeconds - previous.timeSeconds) / span : 1.0f;
+    return previous.weight + (next->weight - previous.weight) * t;
+}
+
+// A target the blender can index without further checks: deltas match the vertex list, which is
+// strictly increasing and inside the model.
+bool IsWellFormed(const MorphTarget& target, std::size_t vertexCount) noexcept {
+    if (target.deltas.size() != target.vertexIndices.size() * 3) {
+        return false;
+    }
+    for (std::size_t entry = 0; entry < target.vertexIndices.size(); ++entry) {
+        if (target.vertexIndices[entry] >= vertexCount || (entry > 0 && target.vertexIndices[entry] <= target.vertexIndices[entry - 1])) {
+            return false;
+        }
+    }
+    return true;
+}
+}
+
+MorphTarget QuantizeMorphTarget(
+    std::string name,
+    const std::vector<glm::vec3>& deltas,
+    std::uint32_t firstVertex,
+    float defaultWeight) {
+    MorphTarget target{std::move(name), {}, {}, 0.0f, defaultWeight};
+    float largest = 0.0f;
+    for (const glm::vec3& delta : deltas) {
+        if (std::isfinite(delta.x) && std::isfinite(delta.y) && std::isfinite(delta.z)) {
+            largest = std::max({largest, std::abs(delta.x), std::abs(delta.y), std::abs(delta.z)});
+        }
+    }
+    if (largest <= 0.0f) {
+        return target;
+    }
+
+    target.deltaScale = largest / kMaxQuantizedDelta;
+    const float stepsPerUnit = kMaxQuantizedDelta / largest;
+    const auto quantize = [stepsPerUnit](float value) {
+        return static_cast<std::int16_t>(std::clamp(std::round(value * stepsPerUnit), -kMaxQuantizedDelta, kMaxQuantizedDelta));
+    };
+    for (std::size_t vertex = 0; vertex < deltas.size(); ++vertex) {
+        const glm::vec3& delta = deltas[vertex];
+        if (!std::isfinite(delta.x) || !std::isfinite(delta.y) || !std::isfinite(delta.z)) {
+            continue;
+        }
+
+        const std::int16_t x = quantize(delta.x);
+        const std::int16_t y = quantize(delta.y);
+        const std::int16_t z = quantize(delta.z);
+        if (x == 0 && y == 0 && z == 0) {
+            continue;
+        }
+        target.vertexIndices.push_back(firstVertex + static_cast<std::uint32_t>(vertex));
+        target.deltas.insert(target.deltas.end(), {x, y, z});
+    }
+    return target;
+}
+
+void SampleMorphWeights(const ModelData& model, const AnimationClip* clip, float timeSeconds, std::vector<float>& outWeights) {
+    outWeights.resize(model.morphTargets.size());
+    for (std::size_t targetIndex = 0; targetIndex < model.morphTargets.size(); ++targetIndex) {
+        outWeights[targetIndex] = model.morphTargets[targetIndex].defaultWeight;
+    }
+    if (!clip) {
+        return;
+    }
+
+    for (const MorphWeightCurve& curve : clip->morphCurves) {
+        if (curve.targetIndex < outWeights.size() && !curve.keys.empty()) {
+            outWeights[curve.targetIndex] = SampleCurve(curve.keys, timeSeconds);
+        }
+    }
+}
+
+void AppendMorphTargetDuplicates(
+    std::vector<MorphTarget>& targets,
+    const std::vector<std::uint32_t>& duplicateSources,
+    std::uint32_t firstDuplicate) {
+    for (MorphTarget& target : targets) {
+        const std::size_t sourceEntryCount = target.vertexIndices.size();
+        for (std::size_t duplicate = 0; duplicate < duplicateSources.size(); ++duplicate) {
+            const auto sourceEnd = target.vertexIndices.begin() + static_cast<std::ptrdiff_t>(sourceEntryCount);
+            const auto source = std::lower_bound(target.vertexIndices.begin(), sourceEnd, duplicateSources[duplicate]);
+            if (source == sourceEnd || *source != duplicateSources[duplicate]) {
+                continue;
+            }
+
+            const std::size_t delta = static_cast<std::size_t>(source - target.vertexIndices.begin()) * 3;
+            target.vertexIndices.push_back(firstDuplicate + static_cast<std::uint32_t>(duplicate));
+            target.deltas.insert(target.deltas.end(), {target.deltas[delta], target.deltas[delta + 1], target.deltas[delta + 2]});
+        }
+    }
+}
+
+MorphTargetBlender::MorphTargetBlender()
+    : vertexCount_(0),
+      blockCount_(0),
+      movedVertices_(),
+      restX_(),
+      restY_(),
+      restZ_(),
+      targetSlots_(),
+      targetBlockStarts_(),
+      appliedWeights_(),
+      sanitizedWeights_(),
+      activeTargets_(),
+      rewrittenTargets_(),
+      blockWritten_() {
+}
+
+void MorphTargetBlender::Reset(const ModelData& model) {
+    vertexCount_ = model.positions.size();
+    movedVertices_.clear();
+    targetSlots_.assign(model.morphTargets.size(), {});
+    targetBlockStarts_.assign(model.morphTargets.size(), {});
+    appliedWeights_.assign(model.morphTargets.size(), 0.0f);
+    sanitizedWeights_.assign(model.morphTargets.size(), 0.0f);
+    activeTargets_.clear();
+    activeTargets_.reserve(model.morphTargets.size());
+    rewrittenTargets_.clear();
+    rewrittenTargets_.reserve(model.morphTargets.size());
+
+    // Malformed targets keep empty slot lists and never move anything.
+    std::vector<bool> targetUsable(model.morphTargets.size(), false);
+    for (std::size_t targetIndex = 0; targetIndex < model.morphTargets.size(); ++targetIndex) {
+        const MorphTarget& target = model.morphTargets[targetIndex];
+        targetUsable[targetIndex] = IsWellFormed(target, vertexCount_);
+        if (targetUsable[targetIndex]) {
+            movedVertices_.insert(movedVertices_.end(), target.vertexIndices.begin(), target.vertexIndices.end());
+        }
+    }
+    std::sort(movedVertices_.begin(), movedVertices_.end());
+    movedVertices_.erase(std::unique(movedVertices_.begin(), movedVertices_.end()), movedVertices_.end());
+
+    restX_.resize(movedVertices_.size());
+    restY_.resize(movedVertices_.size());
+    restZ_.resize(movedVertices_.size());
+    for (std::size_t slot = 0; slot < movedVertices_.size(); ++slot) {
+        const glm::vec3& position = model.positions[movedVertices_[slot]];
+        restX_[slot] = position.x;
+        restY_[slot] = position.y;
+        restZ_[slot] = position.z;
+    }
+
+    blockCount_ = (movedVertices_.size() + kBlockVertices - 1) / kBlockVertices;
+    blockWritten_.assign(blockCount_, 0);
+    for (std::size_t targetIndex = 0; targetIndex < model.morphTargets.size(); ++targetIndex) {
+        std::vector<std::uint32_t>& blockStarts = targetBlockStarts_[targetIndex];
+        blockStarts.assign(blockCount_ + 1, 0);
+        if (!targetUsable[targetIndex]) {
+            continue;
+        }
+
+        // Both lists are sorted, so one walk finds every slot and block boundary.
+        const std::vector<std::uint32_t>& vertexIndices = model.morphTargets[targetIndex].vertexIndices;
+        std::vector<std::uint32_t>& slots = targetSlots_[targetIndex];
+        slots.resize(vertexIndices.size());
+        std::size_t slot = 0;
+        std::size_t block = 0;
+        for (std::size_t entry = 0; entry < vertexIndices.size(); ++entry) {
+            while (movedVertices_[slot] != vertexIndices[entry]) {
+                ++slot;
+            }
+            slots[entry] = static_cast<std::uint32_t>(slot);
+            while (block < slot / kBlockVertices) {
+                blockStarts[++block] = static_cast<std::uint32_t>(entry);
+            }
+        }
+        while (block < blockCount_) {
+            blockStarts[++block] = static_cast<std::uint32_t>(vertexIndices.size());
+        }
+    }
+}
+
+std::size_t MorphTargetBlender::Apply(const std::vector<float>& weights, ModelData& model) {
+    const std::size_t targetCount = targetSlots_.size();
+    if (model.positions.size() != vertexCount_ || model.morphTargets.size() != targetCount || weights.size() != targetCount) {
+        return 0;
+    }
+
+    // Vertices of targets that were weighted last time go back to rest even if nothing moves them now.
+    std::vector<float>& sanitizedWeights = sanitizedWeights_;
+    std::vector<std::size_t>& activeTargets = activeTargets_;
+    std::vector<std::size_t>& rewrittenTargets = rewrittenTargets_;
+    activeTargets.clear();
+    rewrittenTargets.clear();
+    for (std::size_t targetIndex = 0; targetIndex < targetCount; ++targetIndex) {
+        sanitizedWeights[targetIndex] = std::isfinite(weights[targetIndex]) ? weights[targetIndex] : 0.0f;
+        if (targetSlots_[targetIndex].empty()) {
+            continue;
+        }
+        if (sanitizedWeights[targetIndex] != 0.0f) {
+            activeTargets.push_back(targetIndex);
+        }
+        if (sanitizedWeights[targetIndex] != 0.0f || appliedWeights_[targetIndex] != 0.0f) {
+            rewrittenTargets.push_back(targetIndex);
+        }
+    }
+    if (sanitizedWeights == appliedWeights_) {
+        return 0;
+    }
+
+    std::vector<std::uint32_t>& blockWritten = blockWritten_;
+    std::fill(blockWritten.begin(), blockWritten.end(), 0u);
+    JobSystem::Get().ParallelFor(blockCount_, 1, [&](std::size_t blockBegin, std::size_t blockEnd) {
+        float accumulatedX[kBlockVertices];
+        float accumulatedY[kBlockVertices];
+        float accumulatedZ[kBlockVertices];
+        std::uint8_t touched[kBlockVertices];
+        std::uint16_t touchedSlots[kBlockVertices];
+        for (std::size_t block = blockBegin; block < blockEnd; ++block) {
+            const std::size_t slotBegin = block * kBlockVertices;
+            const std::size_t slotCount = std::min(kBlockVertices, movedVertices_.size() - slotBegin);
+            std::fill_n(touched, slotCount, std::uint8_t{0});
+
+            // Start every vertex a rewritten target reaches in this block from rest.
+            std::size_t touchedCount = 0;
+            for (const std::size_t targetIndex : rewrittenTargets) {
+                const std::vector<std::uint32_t>& blockStarts = targetBlockStarts_[targetIndex];
+                const std::uint32_t* slots = targetSlots_[targetIndex].data();
+                for (std::size_t entry = blockStarts[block]; entry < blockStarts[block + 1]; ++entry) {
+                    const std::size_t slot = slots[entry] - slotBegin;
+                    if (touched[slot] == 0) {
+                        touched[slot] = 1;
+                        touchedSlots[touchedCount++] = static_cast<std::uint16_t>(slot);
+                        accumulatedX[slot] = restX_[slotBegin + slot];
+                        accumulatedY[slot] = restY_[slotBegin + slot];
+                        accumulatedZ[slot] = restZ_[slotBegin + slot];
+                    }
+                }
+            }
+            if (touchedCount == 0) {
+                continue;
+            }
+
+            for (const std::size_t targetIndex : activeTargets) {
+                const std::vector<std::uint32_t>& blockStarts = targetBlockStarts_[targetIndex];
+                const std::size_t entryBegin = blockStarts[block];
+                const std::size_t entryEnd = blockStarts[block + 1];
+                const MorphTarget& target = model.morphTargets[targetIndex];
+                const float scale = sanitizedWeights[targetIndex] * target.deltaScale;
+                const std::int16_t* deltas = target.deltas.data() + entryBegin * 3;
+                if (entryEnd - entryBegin == slotCount) {
+                    // The target moves every vertex of the block, so its entries line up with the slots.
+                    for (std::size_t entry = 0; entry < slotCount; ++entry) {
+                        accumulatedX[entry] += static_cast<float>(deltas[entry * 3]) * scale;
+                        accumulatedY[entry] += static_cast<float>(deltas[entry * 3 + 1]) * scale;
+                        accumulatedZ[entry] += static_cast<float>(deltas[entry * 3 + 2]) * scale;
+                    }
+                    continue;
+                }
+
+                const std::uint32_t* slots = targetSlots_[targetIndex].data() + entryBegin;
+                for (std::size_t entry = 0; entry < entryEnd - entryBegin; ++entry) {
+                    const std::size_t slot = slots[entry] - slotBegin;
+                    accumulatedX[slot] += static_cast<float>(deltas[entry * 3]) * scale;
+                    accumulatedY[slot] += static_cast<float>(deltas[entry * 3 + 1]) * scale;
+                    accumulatedZ[slot] += static_cast<float>(deltas[entry * 3 + 2]) * scale;
+                }
+            }
+
+            const std::uint32_t* vertices = movedVertices_.data() + slotBegin;
+            for (std::size_t touchedIndex = 0; touchedIndex < touchedCount; ++touchedIndex) {
+                const std::size_t slot = touchedSlots[touchedIndex];
+                model.positions[vertices[slot]] = glm::vec3(accumulatedX[slot], accumulatedY[slot], accumulatedZ[slot]);
+            }
+            blockWritten[block] = static_cast<std::uint32_t>(touchedCount);
+        }
+    });
+
+    appliedWeights_.swap(sanitizedWeights);
+    std::size_t written = 0;
+    for (const std::uint32_t blockCount : blockWritten) {
+        written += blockCount;
+    }
+    return written;
+}
+
+std::size_t MorphTargetBlender::GetMovedVertexCount() const noexcept {
+    return movedVertices_.size();
+}
+}
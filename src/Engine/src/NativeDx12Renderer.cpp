@@ -1,20 +1,23 @@
 #include "Engine/NativeDx12Renderer.hpp"
+#include "Engine/FlightRecorder.hpp"
+#include "Engine/Log.hpp"
+#include "Engine/ModelCook.hpp"
 #include "Engine/ShaderLoader.hpp"
 #include "Engine/ShaderProfiles.hpp"
+#include "Engine/TriangleAssembly.hpp"
 
 #include <algorithm>
 #include <array>
 #include <cstdlib>
 #include <cstring>
 #include <cstdio>
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 #include <SDL3/SDL.h>
-#include <glm/ext/matrix_clip_space.hpp>
-#include <glm/ext/matrix_transform.hpp>
-#include <glm/gtc/constants.hpp>
+#include <glm/vec4.hpp>
 
 #if defined(_WIN32)
 #include <d3dcompiler.h>
@@ -26,12 +29,18 @@
 #endif
 
 namespace engine {
+namespace {
+// The textured pipeline samples color and opacity; normal, emissive and specular maps are unused.
+constexpr MaterialChannelMask kSampledMaterialChannels = kMaterialChannelColor | kMaterialChannelOpacity;
+}
+
 #if defined(_WIN32)
 namespace {
 constexpr UINT kFrameCount = 2;
 constexpr DXGI_FORMAT kBackbufferFormat = DXGI_FORMAT_R8G8B8A8_UNORM;
 constexpr DXGI_FORMAT kDepthFormat = DXGI_FORMAT_D32_FLOAT;
 constexpr UINT kSrvDescriptorCount = 64;
+constexpr TriangleCullRect kNdcCullRect{-1.0f, -1.0f, 1.0f, 1.0f};
 
 struct WireVertex {
     float position[4];
@@ -272,8 +281,11 @@ public:
     UINT srvNextFreeIndex = 1;
     std::vector<UINT> srvFreeList;
     std::vector<std::string> modelTexturePaths;
+    std::vector<bool> modelTexturesNeeded;
+    std::vector<std::string> staleTexturePaths;
     std::vector<CachedModelTexture> modelTextures;
     std::unordered_map<UINT64, std::string> debugObjectNames;
+    RendererFrameStatistics frameStatistics{};
     bool comInitialized = false;
 
     D3D12_CPU_DESCRIPTOR_HANDLE fontSrvCpuDescriptor{};
@@ -813,6 +825,7 @@ public:
         }
         modelTextures.clear();
         modelTexturePaths.clear();
+        modelTexturesNeeded.clear();
     }
 
     bool EnsureModelTexturesUploaded(const ModelData& model, std::string& outError) {
@@ -826,154 +839,201 @@ public:
             return false;
         }
 
-        if (modelTexturePaths == model.texturePaths && modelTextures.size() == model.texturePaths.size()) {
+        std::vector<bool> texturesNeeded = FindTexturesForChannels(model, kSampledMaterialChannels);
+        if (modelTexturePaths == model.texturePaths && modelTextures.size() == model.texturePaths.size() &&
+            modelTexturesNeeded == texturesNeeded && staleTexturePaths.empty()) {
             return true;
         }
 
+        ScopedFramePhase phase("EnsureModelTexturesUploaded");
         WaitForGpuIdle();
-        ReleaseModelTextures();
-
-        modelTextures.reserve(model.texturePaths.size());
-        modelTexturePaths.reserve(model.texturePaths.size());
 
-        for (const std::string& texturePath : model.texturePaths) {
-            DecodedImageData decodedImage;
-            if (!DecodeImageWithWic(texturePath, decodedImage, outError)) {
-                return false;
+        // Reuse every uploaded texture whose file is still referenced and unchanged; only new or
+        // invalidated paths are decoded and uploaded again. Slots only reached through channels
+        // the pipeline does not sample get no texture and no descriptor.
+        std::vector<CachedModelTexture> textures;
+        std::vector<std::string> texturePaths;
+        textures.reserve(model.texturePaths.size());
+        texturePaths.reserve(model.texturePaths.size());
+        bool uploadFailed = false;
+        for (std::size_t slot = 0; slot < model.texturePaths.size(); ++slot) {
+            const std::string& texturePath = model.texturePaths[slot];
+            texturePaths.push_back(texturePath);
+            textures.emplace_back();
+            if (!texturesNeeded[slot]) {
+                continue;
             }
 
-            modelTexturePaths.push_back(texturePath);
-            modelTextures.emplace_back();
-            CachedModelTexture& cachedTexture = modelTextures.back();
-            cachedTexture.path = texturePath;
-            cachedTexture.hasTransparency = false;
-            for (std::size_t pixelOffset = 3; pixelOffset < decodedImage.pixels.size(); pixelOffset += 4) {
-                if (decodedImage.pixels[pixelOffset] < 250) {
-                    cachedTexture.hasTransparency = true;
-                    break;
-                }
+            const bool isStale =
+                std::find(staleTexturePaths.begin(), staleTexturePaths.end(), texturePath) != staleTexturePaths.end();
+            const auto cached = std::find(modelTexturePaths.begin(), modelTexturePaths.end(), texturePath);
+            const std::size_t cachedIndex = static_cast<std::size_t>(std::distance(modelTexturePaths.begin(), cached));
+            if (!isStale && cached != modelTexturePaths.end() && modelTextures[cachedIndex].resource) {
+                textures.back() = std::move(modelTextures[cachedIndex]);
+                modelTextures[cachedIndex] = CachedModelTexture{};
+                cached->clear();
+                continue;
             }
 
-            D3D12_RESOURCE_DESC textureDesc{};
-            textureDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
-            textureDesc.Alignment = 0;
-            textureDesc.Width = decodedImage.width;
-            textureDesc.Height = decodedImage.height;
-            textureDesc.DepthOrArraySize = 1;
-            textureDesc.MipLevels = 1;
-            textureDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-            textureDesc.SampleDesc.Count = 1;
-            textureDesc.SampleDesc.Quality = 0;
-            textureDesc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
-            textureDesc.Flags = D3D12_RESOURCE_FLAG_NONE;
-
-            D3D12_HEAP_PROPERTIES textureHeapProps{};
-            textureHeapProps.Type = D3D12_HEAP_TYPE_DEFAULT;
-
-            HRESULT result = device->CreateCommittedResource(
-                &textureHeapProps,
-                D3D12_HEAP_FLAG_NONE,
-                &textureDesc,
-                D3D12_RESOURCE_STATE_COPY_DEST,
-                nullptr,
-                IID_PPV_ARGS(&cachedTexture.resource));
-            if (FAILED(result)) {
-                outError = ToErrorMessage("CreateCommittedResource for model texture failed", result);
-                return false;
-            }
-            TrackDebugObject(cachedTexture.resource.Get(), "ModelTextureResource:" + texturePath);
-
-            D3D12_PLACED_SUBRESOURCE_FOOTPRINT footprint{};
-            UINT numRows = 0;
-            UINT64 rowSizeInBytes = 0;
-            UINT64 uploadBufferSize = 0;
-            device->GetCopyableFootprints(&textureDesc, 0, 1, 0, &footprint, &numRows, &rowSizeInBytes, &uploadBufferSize);
-
-            D3D12_HEAP_PROPERTIES uploadHeapProps{};
-            uploadHeapProps.Type = D3D12_HEAP_TYPE_UPLOAD;
-
-            D3D12_RESOURCE_DESC uploadBufferDesc{};
-            uploadBufferDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
-            uploadBufferDesc.Alignment = 0;
-            uploadBufferDesc.Width = uploadBufferSize;
-            uploadBufferDesc.Height = 1;
-            uploadBufferDesc.DepthOrArraySize = 1;
-            uploadBufferDesc.MipLevels = 1;
-            uploadBufferDesc.Format = DXGI_FORMAT_UNKNOWN;
-            uploadBufferDesc.SampleDesc.Count = 1;
-            uploadBufferDesc.SampleDesc.Quality = 0;
-            uploadBufferDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
-            uploadBufferDesc.Flags = D3D12_RESOURCE_FLAG_NONE;
-
-            result = device->CreateCommittedResource(
-                &uploadHeapProps,
-                D3D12_HEAP_FLAG_NONE,
-                &uploadBufferDesc,
-                D3D12_RESOURCE_STATE_GENERIC_READ,
-                nullptr,
-                IID_PPV_ARGS(&cachedTexture.uploadResource));
-            if (FAILED(result)) {
-                outError = ToErrorMessage("CreateCommittedResource for model texture upload buffer failed", result);
-                return false;
+            if (!UploadModelTexture(texturePath, textures.back(), outError)) {
+                uploadFailed = true;
+                break;
             }
-            TrackDebugObject(cachedTexture.uploadResource.Get(), "ModelTextureUploadResource:" + texturePath);
+        }
 
-            std::uint8_t* mappedData = nullptr;
-            D3D12_RANGE readRange{0, 0};
-            result = cachedTexture.uploadResource->Map(0, &readRange, reinterpret_cast<void**>(&mappedData));
-            if (FAILED(result) || !mappedData) {
-                outError = ToErrorMessage("Map for model texture upload buffer failed", result);
-                return false;
-            }
+        ReleaseModelTextures();
+        modelTextures = std::move(textures);
+        modelTexturePaths = std::move(texturePaths);
+        modelTexturesNeeded = std::move(texturesNeeded);
+        staleTexturePaths.clear();
+        if (uploadFailed) {
+            // Leave the path list mismatched so the next frame retries the failed texture.
+            modelTexturePaths.pop_back();
+            return false;
+        }
+
+        return !modelTextures.empty();
+    }
 
-            const std::size_t sourceRowPitch = static_cast<std::size_t>(decodedImage.width) * 4;
-            for (UINT row = 0; row < numRows; ++row) {
-                std::memcpy(
-                    mappedData + static_cast<std::size_t>(row) * footprint.Footprint.RowPitch,
-                    decodedImage.pixels.data() + static_cast<std::size_t>(row) * sourceRowPitch,
-                    sourceRowPitch);
+    void InvalidateModelTextures(const std::vector<std::string>& texturePaths) {
+        staleTexturePaths.insert(staleTexturePaths.end(), texturePaths.begin(), texturePaths.end());
+    }
+
+    bool UploadModelTexture(const std::string& texturePath, CachedModelTexture& cachedTexture, std::string& outError) {
+        DecodedImageData decodedImage;
+        if (!DecodeImageWithWic(texturePath, decodedImage, outError)) {
+            return false;
+        }
+
+        cachedTexture.path = texturePath;
+        cachedTexture.hasTransparency = false;
+        for (std::size_t pixelOffset = 3; pixelOffset < decodedImage.pixels.size(); pixelOffset += 4) {
+            if (decodedImage.pixels[pixelOffset] < 250) {
+                cachedTexture.hasTransparency = true;
+                break;
             }
+        }
 
-            D3D12_RANGE writtenRange{0, static_cast<SIZE_T>(uploadBufferSize)};
-            cachedTexture.uploadResource->Unmap(0, &writtenRange);
+        D3D12_RESOURCE_DESC textureDesc{};
+        textureDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
+        textureDesc.Alignment = 0;
+        textureDesc.Width = decodedImage.width;
+        textureDesc.Height = decodedImage.height;
+        textureDesc.DepthOrArraySize = 1;
+        textureDesc.MipLevels = 1;
+        textureDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+        textureDesc.SampleDesc.Count = 1;
+        textureDesc.SampleDesc.Quality = 0;
+        textureDesc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
+        textureDesc.Flags = D3D12_RESOURCE_FLAG_NONE;
 
-            D3D12_TEXTURE_COPY_LOCATION srcLocation{};
-            srcLocation.pResource = cachedTexture.uploadResource.Get();
-            srcLocation.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
-            srcLocation.PlacedFootprint = footprint;
+        D3D12_HEAP_PROPERTIES textureHeapProps{};
+        textureHeapProps.Type = D3D12_HEAP_TYPE_DEFAULT;
 
-            D3D12_TEXTURE_COPY_LOCATION dstLocation{};
-            dstLocation.pResource = cachedTexture.resource.Get();
-            dstLocation.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
-            dstLocation.SubresourceIndex = 0;
+        HRESULT result = device->CreateCommittedResource(
+            &textureHeapProps,
+            D3D12_HEAP_FLAG_NONE,
+            &textureDesc,
+            D3D12_RESOURCE_STATE_COPY_DEST,
+            nullptr,
+            IID_PPV_ARGS(&cachedTexture.resource));
+        if (FAILED(result)) {
+            outError = ToErrorMessage("CreateCommittedResource for model texture failed", result);
+            return false;
+        }
+        TrackDebugObject(cachedTexture.resource.Get(), "ModelTextureResource:" + texturePath);
+
+        D3D12_PLACED_SUBRESOURCE_FOOTPRINT footprint{};
+        UINT numRows = 0;
+        UINT64 rowSizeInBytes = 0;
+        UINT64 uploadBufferSize = 0;
+        device->GetCopyableFootprints(&textureDesc, 0, 1, 0, &footprint, &numRows, &rowSizeInBytes, &uploadBufferSize);
+
+        D3D12_HEAP_PROPERTIES uploadHeapProps{};
+        uploadHeapProps.Type = D3D12_HEAP_TYPE_UPLOAD;
+
+        D3D12_RESOURCE_DESC uploadBufferDesc{};
+        uploadBufferDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+        uploadBufferDesc.Alignment = 0;
+        uploadBufferDesc.Width = uploadBufferSize;
+        uploadBufferDesc.Height = 1;
+        uploadBufferDesc.DepthOrArraySize = 1;
+        uploadBufferDesc.MipLevels = 1;
+        uploadBufferDesc.Format = DXGI_FORMAT_UNKNOWN;
+        uploadBufferDesc.SampleDesc.Count = 1;
+        uploadBufferDesc.SampleDesc.Quality = 0;
+        uploadBufferDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+        uploadBufferDesc.Flags = D3D12_RESOURCE_FLAG_NONE;
+
+        result = device->CreateCommittedResource(
+            &uploadHeapProps,
+            D3D12_HEAP_FLAG_NONE,
+            &uploadBufferDesc,
+            D3D12_RESOURCE_STATE_GENERIC_READ,
+            nullptr,
+            IID_PPV_ARGS(&cachedTexture.uploadResource));
+        if (FAILED(result)) {
+            outError = ToErrorMessage("CreateCommittedResource for model texture upload buffer failed", result);
+            return false;
+        }
+        TrackDebugObject(cachedTexture.uploadResource.Get(), "ModelTextureUploadResource:" + texturePath);
 
-            commandList->CopyTextureRegion(&dstLocation, 0, 0, 0, &srcLocation, nullptr);
+        std::uint8_t* mappedData = nullptr;
+        D3D12_RANGE readRange{0, 0};
+        result = cachedTexture.uploadResource->Map(0, &readRange, reinterpret_cast<void**>(&mappedData));
+        if (FAILED(result) || !mappedData) {
+            outError = ToErrorMessage("Map for model texture upload buffer failed", result);
+            return false;
+        }
 
-            D3D12_RESOURCE_BARRIER textureBarrier{};
-            textureBarrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-            textureBarrier.Transition.pResource = cachedTexture.resource.Get();
-            textureBarrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-            textureBarrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_DEST;
-            textureBarrier.Transition.StateAfter = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-            commandList->ResourceBarrier(1, &textureBarrier);
+        const std::size_t sourceRowPitch = static_cast<std::size_t>(decodedImage.width) * 4;
+        for (UINT row = 0; row < numRows; ++row) {
+            std::memcpy(
+                mappedData + static_cast<std::size_t>(row) * footprint.Footprint.RowPitch,
+                decodedImage.pixels.data() + static_cast<std::size_t>(row) * sourceRowPitch,
+                sourceRowPitch);
+        }
 
-            if (!AllocateSrvDescriptor(cachedTexture.srvCpuDescriptor, cachedTexture.srvGpuDescriptor)) {
-                outError = "Failed to allocate SRV descriptor for model texture.";
-                return false;
-            }
+        D3D12_RANGE writtenRange{0, static_cast<SIZE_T>(uploadBufferSize)};
+        cachedTexture.uploadResource->Unmap(0, &writtenRange);
+        frameStatistics.bytesUploaded += uploadBufferSize;
 
-            D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc{};
-            srvDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-            srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
-            srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-            srvDesc.Texture2D.MostDetailedMip = 0;
-            srvDesc.Texture2D.MipLevels = 1;
-            srvDesc.Texture2D.PlaneSlice = 0;
-            srvDesc.Texture2D.ResourceMinLODClamp = 0.0f;
-            device->CreateShaderResourceView(cachedTexture.resource.Get(), &srvDesc, cachedTexture.srvCpuDescriptor);
+        D3D12_TEXTURE_COPY_LOCATION srcLocation{};
+        srcLocation.pResource = cachedTexture.uploadResource.Get();
+        srcLocation.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+        srcLocation.PlacedFootprint = footprint;
+
+        D3D12_TEXTURE_COPY_LOCATION dstLocation{};
+        dstLocation.pResource = cachedTexture.resource.Get();
+        dstLocation.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+        dstLocation.SubresourceIndex = 0;
+
+        commandList->CopyTextureRegion(&dstLocation, 0, 0, 0, &srcLocation, nullptr);
+
+        D3D12_RESOURCE_BARRIER textureBarrier{};
+        textureBarrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+        textureBarrier.Transition.pResource = cachedTexture.resource.Get();
+        textureBarrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+        textureBarrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_DEST;
+        textureBarrier.Transition.StateAfter = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+        commandList->ResourceBarrier(1, &textureBarrier);
+
+        if (!AllocateSrvDescriptor(cachedTexture.srvCpuDescriptor, cachedTexture.srvGpuDescriptor)) {
+            outError = "Failed to allocate SRV descriptor for model texture.";
+            return false;
         }
 
-        return !modelTextures.empty();
+        D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc{};
+        srvDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+        srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+        srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+        srvDesc.Texture2D.MostDetailedMip = 0;
+        srvDesc.Texture2D.MipLevels = 1;
+        srvDesc.Texture2D.PlaneSlice = 0;
+        srvDesc.Texture2D.ResourceMinLODClamp = 0.0f;
+        device->CreateShaderResourceView(cachedTexture.resource.Get(), &srvDesc, cachedTexture.srvCpuDescriptor);
+
+        return true;
     }
 
     bool CreateDepthStencilBuffer(UINT width, UINT height, std::string& outError) {
@@ -1046,7 +1106,7 @@ public:
             if (SUCCEEDED(D3D12GetDebugInterface(IID_PPV_ARGS(&debugController)))) {
             debugController->EnableDebugLayer();
             debugLayerEnabled = true;
-            SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "D3D12 debug layer enabled for native renderer.");
+            LogInfo(LogCategory::Gpu, "D3D12 debug layer enabled for native renderer.");
             }
         }
     #endif
@@ -1226,24 +1286,30 @@ public:
             return;
         }
 
+        if (!Logger::Get().IsEnabled(LogCategory::Gpu, LogLevel::Error)) {
+            infoQueue->ClearStoredMessages();
+            return;
+        }
+
+        std::vector<char> messageBytes;
         for (UINT64 index = 0; index < messageCount; ++index) {
             SIZE_T messageLength = 0;
             if (FAILED(infoQueue->GetMessage(index, nullptr, &messageLength))) {
                 continue;
             }
 
-            std::vector<char> messageBytes(messageLength);
+            messageBytes.resize(messageLength);
             auto* message = reinterpret_cast<D3D12_MESSAGE*>(messageBytes.data());
             if (FAILED(infoQueue->GetMessage(index, message, &messageLength))) {
                 continue;
             }
 
-            SDL_LogError(
-                SDL_LOG_CATEGORY_APPLICATION,
+            LogError(
+                LogCategory::Gpu,
                 "[D3D12 %s] %s%s",
                 stage,
                 message->pDescription ? message->pDescription : "(no description)",
-                DescribeTrackedObjectFromMessage(message->pDescription).c_str());
+                DescribeTrackedObjectFromMessage(message->pDescription));
         }
 
         infoQueue->ClearStoredMessages();
@@ -1315,6 +1381,7 @@ public:
         const UINT64 fenceToWait = nextFenceValue++;
         commandQueue->Signal(fence.Get(), fenceToWait);
         if (fence->GetCompletedValue() < fenceToWait) {
+            ScopedFramePhase phase("WaitForGpuIdle");
             fence->SetEventOnCompletion(fenceToWait, fenceEvent);
             WaitForSingleObject(fenceEvent, INFINITE);
         }
@@ -1363,6 +1430,7 @@ public:
         }
     }
     void BeginFrame() {
+        frameStatistics = {};
         frameIndex = swapChain->GetCurrentBackBufferIndex();
         FrameContext& frame = frames[frameIndex];
 
@@ -1434,7 +1502,7 @@ public:
         frame.fenceValue = fenceValue;
     }
 
-    void RenderModelWireframe(const ModelData& model, float yawDegrees, float pitchDegrees, float rollDegrees, float cameraDistance, bool wireOverlayEnabled) {
+    void RenderModelWireframe(const ModelData& model, const CameraLatch& latchCamera, bool wireOverlayEnabled) {
         if (!commandList || !wirePipelineState || !wireRootSignature || !texturedOpaquePipelineState || !texturedTransparentPipelineState || !texturedRootSignature || !model.IsValid()) {
             return;
         }
@@ -1447,26 +1515,17 @@ public:
         }
 
         const float aspectRatio = static_cast<float>(viewportWidth) / static_cast<float>(viewportHeight);
-        const float clampedDistance = std::clamp(cameraDistance, 1.0f, 20.0f);
-
-        glm::mat4 modelMatrix(1.0f);
-        modelMatrix = glm::rotate(modelMatrix, glm::radians(yawDegrees), glm::vec3(0.0f, 1.0f, 0.0f));
-        modelMatrix = glm::rotate(modelMatrix, glm::radians(pitchDegrees), glm::vec3(1.0f, 0.0f, 0.0f));
-        modelMatrix = glm::rotate(modelMatrix, glm::radians(rollDegrees), glm::vec3(0.0f, 0.0f, 1.0f));
-
-        const glm::mat4 viewMatrix = glm::lookAt(
-            glm::vec3(0.0f, 0.0f, clampedDistance),
-            glm::vec3(0.0f, 0.0f, 0.0f),
-            glm::vec3(0.0f, 1.0f, 0.0f));
-
-        const glm::mat4 projectionMatrix = glm::perspective(glm::radians(60.0f), aspectRatio, 0.1f, 100.0f);
-        const glm::mat4 mvp = projectionMatrix * viewMatrix * modelMatrix;
+        const glm::mat4 mvp = BuildModelViewProjection(latchCamera(), aspectRatio);
 
         std::vector<ClipVertex> projected;
+        std::vector<std::uint8_t> outcodes;
         projected.reserve(model.positions.size());
+        outcodes.reserve(model.positions.size());
         for (const glm::vec3& point : model.positions) {
             projected.push_back(ProjectToNdc(point, mvp));
+            outcodes.push_back(ComputeVertexOutcode(projected.back().x, projected.back().y, projected.back().valid, kNdcCullRect));
         }
+        frameStatistics.verticesProjected += projected.size();
 
         std::vector<WireVertex> lineVertices;
         lineVertices.reserve(model.indices.size() * 2);
@@ -1476,19 +1535,18 @@ public:
             !model.texturePaths.empty() &&
             !model.submeshes.empty();
 
-        const std::size_t indexCount = model.indices.size();
-        for (std::size_t index = 0; index + 2 < indexCount; index += 3) {
-            const std::uint32_t i0 = model.indices[index];
-            const std::uint32_t i1 = model.indices[index + 1];
-            const std::uint32_t i2 = model.indices[index + 2];
-            if (i0 >= projected.size() || i1 >= projected.size() || i2 >= projected.size()) {
-                continue;
+        auto addTriangleLines = [&](std::size_t, std::uint32_t i0, std::uint32_t i1, std::uint32_t i2, bool keep) {
+            if (keep) {
+                AddLine(lineVertices, projected[i0], projected[i1]);
+                AddLine(lineVertices, projected[i1], projected[i2]);
+                AddLine(lineVertices, projected[i2], projected[i0]);
             }
-
-            AddLine(lineVertices, projected[i0], projected[i1]);
-            AddLine(lineVertices, projected[i1], projected[i2]);
-            AddLine(lineVertices, projected[i2], projected[i0]);
-
+        };
+        TriangleRejectCounts wireRejected{};
+        if (model.indicesValidated) {
+            AssembleTriangles<true, false>(std::span<const std::uint32_t>(model.indices), std::span<const std::uint8_t>(outcodes), wireRejected, addTriangleLines);
+        } else {
+            AssembleTriangles<false, false>(std::span<const std::uint32_t>(model.indices), std::span<const std::uint8_t>(outcodes), wireRejected, addTriangleLines);
         }
 
         if (lineVertices.empty() && !canRenderTextured) {
@@ -1511,30 +1569,31 @@ public:
                 texturedTriangles.reserve(model.indices.size() / 3);
 
                 for (const ModelSubmesh& submesh : model.submeshes) {
-                    if (submesh.textureIndex < 0 || static_cast<std::size_t>(submesh.textureIndex) >= modelTextures.size()) {
+                    const ModelMaterial* material = model.FindMaterial(submesh);
+                    if (!material || material->textureIndex < 0 || static_cast<std::size_t>(material->textureIndex) >= modelTextures.size()) {
                         continue;
                     }
 
-                    const CachedModelTexture& texture = modelTextures[static_cast<std::size_t>(submesh.textureIndex)];
+                    const CachedModelTexture& texture = modelTextures[static_cast<std::size_t>(material->textureIndex)];
                     if (texture.srvGpuDescriptor.ptr == 0 || submesh.indexCount < 3) {
                         continue;
                     }
 
                     const CachedModelTexture* opacityTexture = nullptr;
-                    if (submesh.opacityTextureIndex >= 0 && static_cast<std::size_t>(submesh.opacityTextureIndex) < modelTextures.size()) {
-                        const CachedModelTexture& opacityTextureCandidate = modelTextures[static_cast<std::size_t>(submesh.opacityTextureIndex)];
+                    if (material->opacityTextureIndex >= 0 && static_cast<std::size_t>(material->opacityTextureIndex) < modelTextures.size()) {
+                        const CachedModelTexture& opacityTextureCandidate = modelTextures[static_cast<std::size_t>(material->opacityTextureIndex)];
                         if (opacityTextureCandidate.srvGpuDescriptor.ptr != 0) {
                             opacityTexture = &opacityTextureCandidate;
                         }
                     }
 
-                    const float submeshOpacity = std::clamp(submesh.opacity, 0.0f, 1.0f);
-                    const bool submeshIsCutout = submesh.alphaCutoutEnabled;
-                    const float submeshCutoff = std::clamp(submesh.alphaCutoff, 0.0f, 1.0f);
-                    const float encodedCutoff = submesh.opacityTextureInverted ? -submeshCutoff : submeshCutoff;
+                    const float submeshOpacity = std::clamp(material->opacity, 0.0f, 1.0f);
+                    const bool submeshIsCutout = material->alphaCutoutEnabled;
+                    const float submeshCutoff = std::clamp(material->alphaCutoff, 0.0f, 1.0f);
+                    const float encodedCutoff = material->opacityTextureInverted ? -submeshCutoff : submeshCutoff;
                     const bool submeshIsTransparent =
                         submeshIsCutout ||
-                        submesh.isTransparent ||
+                        material->isTransparent ||
                         texture.hasTransparency ||
                         (opacityTexture && opacityTexture->hasTransparency) ||
                         submeshOpacity < 0.999f;
@@ -1547,24 +1606,15 @@ public:
                         continue;
                     }
 
-                    for (std::size_t index = indexStart; index + 2 < indexEnd; index += 3) {
-                        const std::uint32_t i0 = model.indices[index];
-                        const std::uint32_t i1 = model.indices[index + 1];
-                        const std::uint32_t i2 = model.indices[index + 2];
-                        if (i0 >= projected.size() || i1 >= projected.size() || i2 >= projected.size()) {
-                            continue;
-                        }
-                        if (i0 >= model.texCoords.size() || i1 >= model.texCoords.size() || i2 >= model.texCoords.size()) {
-                            continue;
+                    // Material state above is fixed for the submesh; the kernel only rejects and emits.
+                    auto emitTriangle = [&](std::size_t, std::uint32_t i0, std::uint32_t i1, std::uint32_t i2, bool keep) {
+                        if (!keep) {
+                            return;
                         }
 
                         const ClipVertex& p0 = projected[i0];
                         const ClipVertex& p1 = projected[i1];
                         const ClipVertex& p2 = projected[i2];
-                        if (!p0.valid || !p1.valid || !p2.valid) {
-                            continue;
-                        }
-
                         const glm::vec2& uv0 = model.texCoords[i0];
                         const glm::vec2& uv1 = model.texCoords[i1];
                         const glm::vec2& uv2 = model.texCoords[i2];
@@ -1578,7 +1628,18 @@ public:
                         triangle.depthKey = (p0.z + p1.z + p2.z) / 3.0f;
                         triangle.isTransparent = submeshIsTransparent;
                         texturedTriangles.push_back(triangle);
+                    };
+
+                    // canRenderTextured guarantees texCoords match positions, so one range check covers both.
+                    const std::span<const std::uint32_t> submeshIndices(model.indices.data() + indexStart, indexEnd - indexStart);
+                    TriangleRejectCounts rejected{};
+                    if (model.indicesValidated) {
+                        AssembleTriangles<true, true>(submeshIndices, std::span<const std::uint8_t>(outcodes), rejected, emitTriangle);
+                    } else {
+                        AssembleTriangles<false, true>(submeshIndices, std::span<const std::uint8_t>(outcodes), rejected, emitTriangle);
                     }
+                    frameStatistics.trianglesCulled += rejected.culled;
+                    frameStatistics.trianglesClipped += rejected.clipped;
                 }
 
                 std::sort(texturedTriangles.begin(), texturedTriangles.end(), [](const TexturedTriangle& left, const TexturedTriangle& right) {
@@ -1590,6 +1651,15 @@ public:
                         return left.depthKey > right.depthKey;
                     }
 
+                    // Opaque triangles are depth tested, so group them by texture to keep one batch per texture/atlas.
+                    if (left.colorTextureHandle.ptr != right.colorTextureHandle.ptr) {
+                        return left.colorTextureHandle.ptr < right.colorTextureHandle.ptr;
+                    }
+
+                    if (left.opacityTextureHandle.ptr != right.opacityTextureHandle.ptr) {
+                        return left.opacityTextureHandle.ptr < right.opacityTextureHandle.ptr;
+                    }
+
                     return left.depthKey < right.depthKey;
                 });
 
@@ -1597,7 +1667,7 @@ public:
                 if (texturedVertexCount > 0) {
                     std::string allocationError;
                     if (!EnsureTexturedVertexBuffer(texturedVertexCount, allocationError)) {
-                        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s", allocationError.c_str());
+                        LogError(LogCategory::Renderer, "%s", allocationError);
                         texturedTriangles.clear();
                     }
                 }
@@ -1620,6 +1690,8 @@ public:
                         const std::size_t uploadBytes = static_cast<std::size_t>(texturedVertexCount) * sizeof(TexturedVertex);
                         D3D12_RANGE writtenRange{0, uploadBytes};
                         texturedVertexBuffer->Unmap(0, &writtenRange);
+                        frameStatistics.bytesUploaded += uploadBytes;
+                        frameStatistics.trianglesSubmitted += texturedTriangles.size();
 
                         D3D12_VERTEX_BUFFER_VIEW vbView = texturedVertexBufferView;
                         vbView.SizeInBytes = static_cast<UINT>(uploadBytes);
@@ -1644,6 +1716,7 @@ public:
                                 commandList->SetPipelineState(batchIsTransparent ? texturedTransparentPipelineState.Get() : texturedOpaquePipelineState.Get());
                                 currentTransparencyState = batchIsTransparent;
                                 hasCurrentTransparencyState = true;
+                                ++frameStatistics.pipelineStateChanges;
                             }
 
                             const UINT startVertex = static_cast<UINT>(firstTriangleInBatch * 3);
@@ -1652,6 +1725,8 @@ public:
                             commandList->SetGraphicsRootDescriptorTable(0, currentColorTexture);
                             commandList->SetGraphicsRootDescriptorTable(1, currentOpacityTexture);
                             commandList->DrawInstanced(vertexCount, 1, startVertex, 0);
+                            frameStatistics.textureBinds += 2;
+                            ++frameStatistics.drawCalls;
 
                             firstTriangleInBatch = endTriangleInBatch;
                         }
@@ -1660,7 +1735,7 @@ public:
                     }
                 }
             } else if (!textureError.empty()) {
-                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Native DX12 model texture disabled: %s", textureError.c_str());
+                LogWarning(LogCategory::Renderer, "Native DX12 model texture disabled: %s", textureError);
             }
         }
 
@@ -1671,7 +1746,7 @@ public:
 
         std::string allocationError;
         if (!EnsureWireVertexBuffer(static_cast<UINT>(lineVertices.size()), allocationError)) {
-            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s", allocationError.c_str());
+            LogError(LogCategory::Renderer, "%s", allocationError);
             return;
         }
 
@@ -1694,6 +1769,10 @@ public:
         commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_LINELIST);
         commandList->IASetVertexBuffers(0, 1, &vbView);
         commandList->DrawInstanced(static_cast<UINT>(lineVertices.size()), 1, 0, 0);
+        frameStatistics.bytesUploaded += uploadBytes;
+        frameStatistics.overlayLineCount += lineVertices.size() / 2;
+        ++frameStatistics.pipelineStateChanges;
+        ++frameStatistics.drawCalls;
     }
 };
 #endif
@@ -1743,21 +1822,46 @@ void NativeDx12Renderer::EndFrame() {
 #endif
 }
 
-void NativeDx12Renderer::RenderModelWireframe(const ModelData& model, float yawDegrees, float pitchDegrees, float rollDegrees, float cameraDistance, bool wireOverlayEnabled) {
+void NativeDx12Renderer::RenderModelWireframe(const ModelData& model, const CameraLatch& latchCamera, bool wireOverlayEnabled) {
 #if defined(_WIN32)
     if (impl_) {
-        impl_->RenderModelWireframe(model, yawDegrees, pitchDegrees, rollDegrees, cameraDistance, wireOverlayEnabled);
+        impl_->RenderModelWireframe(model, latchCamera, wireOverlayEnabled);
     }
 #else
     (void)model;
-    (void)yawDegrees;
-    (void)pitchDegrees;
-    (void)rollDegrees;
-    (void)cameraDistance;
+    (void)latchCamera;
     (void)wireOverlayEnabled;
 #endif
 }
 
+void NativeDx12Renderer::InvalidateModelTextures(const std::vector<std::string>& texturePaths) {
+#if defined(_WIN32)
+    if (impl_) {
+        impl_->InvalidateModelTextures(texturePaths);
+    }
+#else
+    (void)texturePaths;
+#endif
+}
+
+// The native path has no offscreen scene pass yet, so it always renders at full resolution.
+void NativeDx12Renderer::SetRenderScale(float scale) {
+    (void)scale;
+}
+
+// Overdraw is only counted by the SDL backends; here the overdraw counters stay at zero.
+void NativeDx12Renderer::SetOverdrawVisualization(bool enabled) {
+    (void)enabled;
+}
+
+void NativeDx12Renderer::SetPointCloudPreview(std::shared_ptr<const PointCloudPreview> preview) {
+    (void)preview;
+}
+
+MaterialChannelMask NativeDx12Renderer::GetSampledMaterialChannels() const noexcept {
+    return kSampledMaterialChannels;
+}
+
 SDL_Renderer* NativeDx12Renderer::GetNativeRenderer() const noexcept {
     return nullptr;
 }
@@ -1766,6 +1870,15 @@ const char* NativeDx12Renderer::GetName() const noexcept {
     return "DirectX 12 Native";
 }
 
+RendererFrameStatistics NativeDx12Renderer::GetFrameStatistics() const noexcept {
+#if defined(_WIN32)
+    if (impl_) {
+        return impl_->frameStatistics;
+    }
+#endif
+    return {};
+}
+
 #if defined(_WIN32)
 ID3D12Device* NativeDx12Renderer::GetDevice() const noexcept {
     return impl_ ? impl_->device.Get() : nullptr;
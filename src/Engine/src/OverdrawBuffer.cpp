@@ -0,0 +1,198 @@
+#include "Engine/OverdrawBuffer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace engine {
+namespace {
+// Vertices are snapped to 1/16 pixel so every edge test is exact integer arithmetic and two
+// triangles sharing an edge always agree on which side a pixel center falls.
+constexpr int kSubpixelBits = 4;
+constexpr std::int64_t kSubpixelScale = std::int64_t{1} << kSubpixelBits;
+// Keeps the edge products well inside 64 bits for vertices far outside the viewport.
+constexpr float kMaxCoordinate = 1 << 20;
+
+struct FixedPoint {
+    std::int64_t x;
+    std::int64_t y;
+};
+
+FixedPoint ToFixed(const OverdrawPoint& point) {
+    auto snap = [](float value) {
+        const float clamped = std::isfinite(value) ? std::clamp(value, -kMaxCoordinate, kMaxCoordinate) : 0.0f;
+        return static_cast<std::int64_t>(std::lround(clamped * static_cast<float>(kSubpixelScale)));
+    };
+    return {snap(point.x), snap(point.y)};
+}
+
+// Positive on the inside of the edge from `from` to `to` once the triangle is wound positively.
+std::int64_t EdgeValue(const FixedPoint& from, const FixedPoint& to, std::int64_t x, std::int64_t y) {
+    return (to.x - from.x) * (y - from.y) - (to.y - from.y) * (x - from.x);
+}
+
+// Pixel centers exactly on an edge belong to the triangle only for top and left edges. Two
+// triangles sharing an edge walk it in opposite directions, so exactly one of them takes it.
+bool IsTopLeftEdge(const FixedPoint& from, const FixedPoint& to) {
+    const std::int64_t dx = to.x - from.x;
+    const std::int64_t dy = to.y - from.y;
+    return dy > 0 || (dy == 0 && dx < 0);
+}
+
+struct HeatColor {
+    float r;
+    float g;
+    float b;
+};
+
+constexpr std::array<HeatColor, 4> kHeatStops = {{
+    {32.0f, 64.0f, 255.0f},
+    {32.0f, 200.0f, 64.0f},
+    {255.0f, 230.0f, 32.0f},
+    {255.0f, 32.0f, 32.0f},
+}};
+}
+
+OverdrawBuffer::OverdrawBuffer()
+    : width_(0),
+      height_(0),
+      counts_() {}
+
+void OverdrawBuffer::Reset(int width, int height) {
+    width_ = std::max(width, 0);
+    height_ = std::max(height, 0);
+    counts_.assign(static_cast<std::size_t>(width_) * static_cast<std::size_t>(height_), 0);
+}
+
+void OverdrawBuffer::AddTriangle(const OverdrawPoint& a, const OverdrawPoint& b, const OverdrawPoint& c, int firstRow, int endRow) noexcept {
+    FixedPoint v0 = ToFixed(a);
+    FixedPoint v1 = ToFixed(b);
+    FixedPoint v2 = ToFixed(c);
+    const std::int64_t area = EdgeValue(v0, v1, v2.x, v2.y);
+    if (area == 0) {
+        return;
+    }
+    // Both windings are drawn, as SDL_RenderGeometry does not cull back faces.
+    if (area < 0) {
+        std::swap(v1, v2);
+    }
+
+    // Pixel p is sampled at p + 0.5, so it is covered when its center lies in the bounds.
+    const std::int64_t half = kSubpixelScale / 2;
+    const std::int64_t minX = std::min({v0.x, v1.x, v2.x});
+    const std::int64_t maxX = std::max({v0.x, v1.x, v2.x});
+    const std::int64_t minY = std::min({v0.y, v1.y, v2.y});
+    const std::int64_t maxY = std::max({v0.y, v1.y, v2.y});
+    auto firstPixel = [&](std::int64_t value) {
+        const std::int64_t shifted = value - half;
+        return shifted >= 0 ? (shifted + kSubpixelScale - 1) / kSubpixelScale : -((-shifted) / kSubpixelScale);
+    };
+    auto lastPixel = [&](std::int64_t value) {
+        const std::int64_t shifted = value - half;
+        return shifted >= 0 ? shifted / kSubpixelScale : -((-shifted + kSubpixelScale - 1) / kSubpixelScale);
+    };
+    const int columnBegin = static_cast<int>(std::max<std::int64_t>(firstPixel(minX), 0));
+    const int columnEnd = static_cast<int>(std::min<std::int64_t>(lastPixel(maxX) + 1, width_));
+    const int rowBegin = static_cast<int>(std::max<std::int64_t>(firstPixel(minY), std::max(firstRow, 0)));
+    const int rowEnd = static_cast<int>(std::min<std::int64_t>(lastPixel(maxY) + 1, std::min(endRow, height_)));
+    if (columnBegin >= columnEnd || rowBegin >= rowEnd) {
+        return;
+    }
+
+    // Biased so a pixel is inside exactly when all three values are non-negative.
+    const FixedPoint edges[3][2] = {{v0, v1}, {v1, v2}, {v2, v0}};
+    std::int64_t rowValues[3];
+    std::int64_t stepX[3];
+    std::int64_t stepY[3];
+    const std::int64_t startX = static_cast<std::int64_t>(columnBegin) * kSubpixelScale + half;
+    const std::int64_t startY = static_cast<std::int64_t>(rowBegin) * kSubpixelScale + half;
+    for (int edge = 0; edge < 3; ++edge) {
+        const FixedPoint& from = edges[edge][0];
+        const FixedPoint& to = edges[edge][1];
+        rowValues[edge] = EdgeValue(from, to, startX, startY) - (IsTopLeftEdge(from, to) ? 0 : 1);
+        stepX[edge] = -(to.y - from.y) * kSubpixelScale;
+        stepY[edge] = (to.x - from.x) * kSubpixelScale;
+    }
+
+    for (int row = rowBegin; row < rowEnd; ++row) {
+        std::uint16_t* counts = counts_.data() + static_cast<std::size_t>(row) * static_cast<std::size_t>(width_);
+        std::int64_t e0 = rowValues[0];
+        std::int64_t e1 = rowValues[1];
+        std::int64_t e2 = rowValues[2];
+        for (int column = columnBegin; column < columnEnd; ++column) {
+            if ((e0 | e1 | e2) >= 0) {
+                counts[column] += counts[column] != std::numeric_limits<std::uint16_t>::max();
+            }
+            e0 += stepX[0];
+            e1 += stepX[1];
+            e2 += stepX[2];
+        }
+        rowValues[0] += stepY[0];
+        rowValues[1] += stepY[1];
+        rowValues[2] += stepY[2];
+    }
+}
+
+void OverdrawBuffer::AddTriangle(const OverdrawPoint& a, const OverdrawPoint& b, const OverdrawPoint& c) noexcept {
+    AddTriangle(a, b, c, 0, height_);
+}
+
+OverdrawStatistics OverdrawBuffer::ComputeStatistics() const noexcept {
+    OverdrawStatistics statistics{};
+    for (const std::uint16_t count : counts_) {
+        statistics.shadedPixels += count;
+        statistics.coveredPixels += count != 0;
+        statistics.maxOverdraw = std::max<std::uint32_t>(statistics.maxOverdraw, count);
+    }
+    statistics.averageOverdraw = statistics.coveredPixels > 0
+        ? static_cast<double>(statistics.shadedPixels) / static_cast<double>(statistics.coveredPixels)
+        : 0.0;
+    return statistics;
+}
+
+void OverdrawBuffer::WriteHeatmap(std::vector<std::uint8_t>& outRgba, std::uint32_t saturationCount) const {
+    saturationCount = std::clamp<std::uint32_t>(saturationCount, 1, std::numeric_limits<std::uint16_t>::max() - 1);
+
+    // One color per count up to the saturation point; everything past it shares the last entry.
+    std::vector<std::array<std::uint8_t, 4>> palette(saturationCount + 2);
+    palette[0] = {0, 0, 0, 255};
+    for (std::uint32_t count = 1; count <= saturationCount; ++count) {
+        const float t = saturationCount > 1
+            ? static_cast<float>(count - 1) / static_cast<float>(saturationCount - 1) * static_cast<float>(kHeatStops.size() - 1)
+            : static_cast<float>(kHeatStops.size() - 1);
+        const std::size_t stop = std::min(static_cast<std::size_t>(t), kHeatStops.size() - 2);
+        const float blend = t - static_cast<float>(stop);
+        const HeatColor& from = kHeatStops[stop];
+        const HeatColor& to = kHeatStops[stop + 1];
+        palette[count] = {
+            static_cast<std::uint8_t>(std::lround(from.r + (to.r - from.r) * blend)),
+            static_cast<std::uint8_t>(std::lround(from.g + (to.g - from.g) * blend)),
+            static_cast<std::uint8_t>(std::lround(from.b + (to.b - from.b) * blend)),
+            255};
+    }
+    palette[saturationCount + 1] = {255, 255, 255, 255};
+
+    outRgba.resize(counts_.size() * 4);
+    for (std::size_t pixel = 0; pixel < counts_.size(); ++pixel) {
+        const std::array<std::uint8_t, 4>& color = palette[std::min<std::uint32_t>(counts_[pixel], saturationCount + 1)];
+        std::copy(color.begin(), color.end(), outRgba.begin() + static_cast<std::ptrdiff_t>(pixel * 4));
+    }
+}
+
+int OverdrawBuffer::GetWidth() const noexcept {
+    return width_;
+}
+
+int OverdrawBuffer::GetHeight() const noexcept {
+    return height_;
+}
+
+std::uint16_t OverdrawBuffer::GetCount(int x, int y) const noexcept {
+    if (x < 0 || y < 0 || x >= width_ || y >= height_) {
+        return 0;
+    }
+    return counts_[static_cast<std::size_t>(y) * static_cast<std::size_t>(width_) + static_cast<std::size_t>(x)];
+}
+}
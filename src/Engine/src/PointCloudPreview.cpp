@@ -0,0 +1,369 @@
+#include "Engine/PointCloudPreview.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <utility>
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/matrix.hpp>
+#include <glm/vec4.hpp>
+
+#include "Engine/JobSystem.hpp"
+
+namespace engine {
+namespace {
+constexpr std::size_t kPointsPerRange = 16384;
+constexpr std::size_t kTrianglesPerRange = 16384;
+constexpr std::uint32_t kMortonLevels = 21;
+constexpr std::uint32_t kMortonCellsPerAxis = 1u << kMortonLevels;
+constexpr std::uint32_t kNoPoint = std::numeric_limits<std::uint32_t>::max();
+constexpr std::uint64_t kEmptyPixel = std::numeric_limits<std::uint64_t>::max();
+// A warm clay tint; the preview has no textures, so shape comes from the lighting alone.
+constexpr std::array<float, 3> kSplatTint{224.0f, 214.0f, 198.0f};
+
+struct MortonEntry {
+    std::uint64_t key;
+    std::uint32_t vertex;
+};
+
+std::uint64_t SpreadBits(std::uint32_t value) {
+    std::uint64_t spread = value & 0x1fffff;
+    spread = (spread | spread << 32) & 0x1f00000000ffffull;
+    spread = (spread | spread << 16) & 0x1f0000ff0000ffull;
+    spread = (spread | spread << 8) & 0x100f00f00f00f00full;
+    spread = (spread | spread << 4) & 0x10c30c30c30c30c3ull;
+    spread = (spread | spread << 2) & 0x1249249249249249ull;
+    return spread;
+}
+
+// NaN and anything below the bounds land in cell 0.
+std::uint32_t QuantizeAxis(float offset, float scale) {
+    const float cell = offset * scale;
+    return cell > 0.0f ? static_cast<std::uint32_t>(std::min(cell, static_cast<float>(kMortonCellsPerAxis - 1))) : 0u;
+}
+
+// Sorts ranges in parallel, then merges neighbouring ranges pairwise until one is left.
+void ParallelSortByKey(JobSystem& jobs, std::vector<MortonEntry>& entries) {
+    const auto byKey = [](const MortonEntry& left, const MortonEntry& right) { return left.key < right.key; };
+    const std::size_t count = entries.size();
+    const std::size_t chunkCount = std::bit_ceil(static_cast<std::size_t>(jobs.GetWorkerCount()) + 1);
+    const std::size_t chunkSize = std::max<std::size_t>((count + chunkCount - 1) / chunkCount, 1);
+    jobs.ParallelFor(chunkCount, 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t chunk = begin; chunk < end; ++chunk) {
+            const std::size_t first = std::min(chunk * chunkSize, count);
+            std::sort(entries.begin() + static_cast<std::ptrdiff_t>(first), entries.begin() + static_cast<std::ptrdiff_t>(std::min(first + chunkSize, count)), byKey);
+        }
+    });
+
+    for (std::size_t width = chunkSize; width < count; width *= 2) {
+        const std::size_t mergeCount = (count + 2 * width - 1) / (2 * width);
+        jobs.ParallelFor(mergeCount, 1, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t merge = begin; merge < end; ++merge) {
+                const std::size_t first = merge * 2 * width;
+                const std::size_t middle = std::min(first + width, count);
+                const std::size_t last = std::min(first + 2 * width, count);
+                std::inplace_merge(
+                    entries.begin() + static_cast<std::ptrdiff_t>(first),
+                    entries.begin() + static_cast<std::ptrdiff_t>(middle),
+                    entries.begin() + static_cast<std::ptrdiff_t>(last),
+                    byKey);
+            }
+        });
+    }
+}
+
+std::uint32_t PackNormal(const glm::vec3& normal) {
+    const float length = glm::length(normal);
+    if (!(length > 1.0e-20f)) {
+        return 0;
+    }
+
+    const glm::vec3 unit = normal / length;
+    const auto packAxis = [](float value) {
+        return static_cast<std::uint32_t>(static_cast<std::uint8_t>(static_cast<std::int8_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 127.0f))));
+    };
+    return packAxis(unit.x) | packAxis(unit.y) << 8 | packAxis(unit.z) << 16;
+}
+
+glm::vec3 UnpackNormal(std::uint32_t packed) {
+    const auto unpackAxis = [packed](int shift) {
+        return static_cast<float>(static_cast<std::int8_t>(static_cast<std::uint8_t>(packed >> shift))) / 127.0f;
+    };
+    return glm::vec3(unpackAxis(0), unpackAxis(8), unpackAxis(16));
+}
+}
+
+PointCloudPreview BuildPointCloudPreview(const ModelData& model, std::size_t targetPointCount) {
+    PointCloudPreview preview{{}, 0.0f, model.positions.size()};
+    const std::size_t vertexCount = model.positions.size();
+    if (vertexCount == 0 || targetPointCount == 0 || vertexCount > kNoPoint) {
+        return preview;
+    }
+
+    JobSystem& jobs = JobSystem::Get();
+    glm::vec3 minBounds(std::numeric_limits<float>::max());
+    glm::vec3 maxBounds(std::numeric_limits<float>::lowest());
+    std::mutex boundsMutex;
+    jobs.ParallelFor(vertexCount, kPointsPerRange, [&](std::size_t begin, std::size_t end) {
+        glm::vec3 rangeMin(std::numeric_limits<float>::max());
+        glm::vec3 rangeMax(std::numeric_limits<float>::lowest());
+        for (std::size_t index = begin; index < end; ++index) {
+            rangeMin = glm::min(rangeMin, model.positions[index]);
+            rangeMax = glm::max(rangeMax, model.positions[index]);
+        }
+
+        std::lock_guard lock(boundsMutex);
+        minBounds = glm::min(minBounds, rangeMin);
+        maxBounds = glm::max(maxBounds, rangeMax);
+    });
+
+    // The grid is a cube over the bounds, so cells stay cubes whatever the model's proportions.
+    const glm::vec3 dimensions = maxBounds - minBounds;
+    const float extent = std::max({dimensions.x, dimensions.y, dimensions.z, 1.0e-6f});
+    const float scale = static_cast<float>(kMortonCellsPerAxis) / extent;
+    std::vector<MortonEntry> entries(vertexCount);
+    jobs.ParallelFor(vertexCount, kPointsPerRange, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t index = begin; index < end; ++index) {
+            const glm::vec3 offset = model.positions[index] - minBounds;
+            entries[index] = MortonEntry{
+                SpreadBits(QuantizeAxis(offset.x, scale)) | SpreadBits(QuantizeAxis(offset.y, scale)) << 1 |
+                    SpreadBits(QuantizeAxis(offset.z, scale)) << 2,
+                static_cast<std::uint32_t>(index)};
+        }
+    });
+    ParallelSortByKey(jobs, entries);
+
+    // Neighbours in Morton order first fall into different cells at the level where their keys
+    // first differ, so one pass counts the occupied cells of every level at once.
+    std::array<std::size_t, kMortonLevels + 2> splitsAtLevel{};
+    std::mutex splitsMutex;
+    jobs.ParallelFor(vertexCount - 1, kPointsPerRange, [&](std::size_t begin, std::size_t end) {
+        std::array<std::size_t, kMortonLevels + 2> rangeSplits{};
+        for (std::size_t index = begin; index < end; ++index) {
+            const std::uint64_t difference = entries[index].key ^ entries[index + 1].key;
+            const std::uint32_t sharedBits = difference == 0 ? 3 * kMortonLevels : static_cast<std::uint32_t>(std::countl_zero(difference) - 1);
+            ++rangeSplits[sharedBits / 3 + 1];
+        }
+
+        std::lock_guard lock(splitsMutex);
+        for (std::size_t level = 0; level < rangeSplits.size(); ++level) {
+            splitsAtLevel[level] += rangeSplits[level];
+        }
+    });
+
+    std::uint32_t level = 0;
+    for (std::size_t cellCount = 1; level < kMortonLevels && cellCount + splitsAtLevel[level + 1] <= targetPointCount; ++level) {
+        cellCount += splitsAtLevel[level + 1];
+    }
+    preview.cellSize = extent / static_cast<float>(1u << level);
+
+    // The middle vertex of each cell's run stands for the cell.
+    const std::uint32_t shift = 3 * (kMortonLevels - level);
+    std::vector<std::uint32_t> pointOfVertex(vertexCount, kNoPoint);
+    for (std::size_t runStart = 0; runStart < vertexCount;) {
+        const std::uint64_t cell = entries[runStart].key >> shift;
+        std::size_t runEnd = runStart + 1;
+        while (runEnd < vertexCount && entries[runEnd].key >> shift == cell) {
+            ++runEnd;
+        }
+
+        const std::uint32_t vertex = entries[runStart + (runEnd - runStart) / 2].vertex;
+        pointOfVertex[vertex] = static_cast<std::uint32_t>(preview.points.size());
+        preview.points.push_back(PointCloudPreviewPoint{model.positions[vertex], 0});
+        runStart = runEnd;
+    }
+    entries = {};
+
+    // Face normals are gathered per range, then summed in one place so no two threads add to
+    // the same point.
+    std::vector<glm::vec3> normals(preview.points.size(), glm::vec3(0.0f));
+    std::vector<std::pair<std::uint32_t, glm::vec3>> contributions;
+    std::mutex contributionsMutex;
+    const std::size_t triangleCount = model.indices.size() / 3;
+    jobs.ParallelFor(triangleCount, kTrianglesPerRange, [&](std::size_t begin, std::size_t end) {
+        std::vector<std::pair<std::uint32_t, glm::vec3>> rangeContributions;
+        for (std::size_t triangle = begin; triangle < end; ++triangle) {
+            const std::uint32_t* corners = model.indices.data() + triangle * 3;
+            if (!model.indicesValidated && (corners[0] >= vertexCount || corners[1] >= vertexCount || corners[2] >= vertexCount)) {
+                continue;
+            }
+            if (pointOfVertex[corners[0]] == kNoPoint && pointOfVertex[corners[1]] == kNoPoint && pointOfVertex[corners[2]] == kNoPoint) {
+                continue;
+            }
+
+            const glm::vec3& a = model.positions[corners[0]];
+            const glm::vec3 faceNormal = glm::cross(model.positions[corners[1]] - a, model.positions[corners[2]] - a);
+            for (int corner = 0; corner < 3; ++corner) {
+                if (pointOfVertex[corners[corner]] != kNoPoint) {
+                    rangeContributions.emplace_back(pointOfVertex[corners[corner]], faceNormal);
+                }
+            }
+        }
+
+        std::lock_guard lock(contributionsMutex);
+        contributions.insert(contributions.end(), rangeContributions.begin(), rangeContributions.end());
+    });
+    for (const auto& [point, faceNormal] : contributions) {
+        normals[point] += faceNormal;
+    }
+    for (std::size_t point = 0; point < preview.points.size(); ++point) {
+        preview.points[point].packedNormal = PackNormal(normals[point]);
+    }
+    return preview;
+}
+
+SplatBuffer::SplatBuffer()
+    : width_(0),
+      height_(0),
+      pixels_() {}
+
+void SplatBuffer::Reset(int width, int height) {
+    width_ = std::max(width, 0);
+    height_ = std::max(height, 0);
+    pixels_.assign(static_cast<std::size_t>(width_) * static_cast<std::size_t>(height_), kEmptyPixel);
+}
+
+void SplatBuffer::AddSplat(float x, float y, float depth, int size, std::uint32_t rgba) noexcept {
+    if (!(depth >= 0.0f && depth <= 1.0f) || !(x > -kMaxSplatSize && x < static_cast<float>(width_ + kMaxSplatSize)) ||
+        !(y > -kMaxSplatSize && y < static_cast<float>(height_ + kMaxSplatSize))) {
+        return;
+    }
+
+    // Non-negative floats order like their bit patterns, so depth in the high word makes the
+    // nearer splat the smaller value.
+    const std::uint64_t packed = static_cast<std::uint64_t>(std::bit_cast<std::uint32_t>(depth)) << 32 | rgba;
+    const int clampedSize = std::clamp(size, 1, kMaxSplatSize);
+    const float halfExtent = static_cast<float>(clampedSize) * 0.5f;
+    const int left = static_cast<int>(std::floor(x - halfExtent + 0.5f));
+    const int top = static_cast<int>(std::floor(y - halfExtent + 0.5f));
+    const int right = std::min(left + clampedSize, width_);
+    const int bottom = std::min(top + clampedSize, height_);
+    for (int row = std::max(top, 0); row < bottom; ++row) {
+        std::uint64_t* rowPixels = pixels_.data() + static_cast<std::size_t>(row) * static_cast<std::size_t>(width_);
+        for (int column = std::max(left, 0); column < right; ++column) {
+            std::atomic_ref<std::uint64_t> pixel(rowPixels[column]);
+            std::uint64_t current = pixel.load(std::memory_order_relaxed);
+            while (packed < current && !pixel.compare_exchange_weak(current, packed, std::memory_order_relaxed)) {
+            }
+        }
+    }
+}
+
+void SplatBuffer::WriteRgba(std::vector<std::uint8_t>& outRgba) const {
+    outRgba.resize(pixels_.size() * 4);
+    for (std::size_t index = 0; index < pixels_.size(); ++index) {
+        const std::uint32_t color = pixels_[index] == kEmptyPixel ? 0u : static_cast<std::uint32_t>(pixels_[index]);
+        outRgba[index * 4 + 0] = static_cast<std::uint8_t>(color);
+        outRgba[index * 4 + 1] = static_cast<std::uint8_t>(color >> 8);
+        outRgba[index * 4 + 2] = static_cast<std::uint8_t>(color >> 16);
+        outRgba[index * 4 + 3] = static_cast<std::uint8_t>(color >> 24);
+    }
+}
+
+int SplatBuffer::GetWidth() const noexcept {
+    return width_;
+}
+
+int SplatBuffer::GetHeight() const noexcept {
+    return height_;
+}
+
+std::uint32_t SplatBuffer::GetColor(int x, int y) const noexcept {
+    if (x < 0 || y < 0 || x >= width_ || y >= height_) {
+        return 0;
+    }
+
+    const std::uint64_t pixel = pixels_[static_cast<std::size_t>(y) * static_cast<std::size_t>(width_) + static_cast<std::size_t>(x)];
+    return pixel == kEmptyPixel ? 0u : static_cast<std::uint32_t>(pixel);
+}
+
+std::uint64_t SplatBuffer::CountCoveredPixels() const noexcept {
+    return static_cast<std::uint64_t>(std::count_if(pixels_.begin(), pixels_.end(), [](std::uint64_t pixel) { return pixel != kEmptyPixel; }));
+}
+
+std::size_t SplatPointCloudPreview(const PointCloudPreview& preview, const glm::mat4& modelViewProjection, SplatBuffer& buffer) {
+    const float width = static_cast<float>(buffer.GetWidth());
+    const float height = static_cast<float>(buffer.GetHeight());
+    if (preview.points.empty() || width <= 0.0f || height <= 0.0f) {
+        return 0;
+    }
+
+    // The eye is the point the projection sends to w = 0; for an orthographic projection it is at
+    // infinity and the light direction is the same for every point.
+    const glm::vec4 eye = glm::inverse(modelViewProjection) * glm::vec4(0.0f, 0.0f, 1.0f, 0.0f);
+    const bool eyeAtInfinity = std::abs(eye.w) < 1.0e-12f;
+    const glm::vec3 eyePosition = eyeAtInfinity ? glm::vec3(0.0f) : glm::vec3(eye) / eye.w;
+    const glm::vec3 eyeDirection = eyeAtInfinity ? glm::normalize(glm::vec3(eye)) : glm::vec3(0.0f);
+    // View and model transforms are rigid, so the length of the projection's y row is the focal scale.
+    const float pixelsPerUnit =
+        0.5f * height * glm::length(glm::vec3(modelViewProjection[0][1], modelViewProjection[1][1], modelViewProjection[2][1]));
+
+    std::atomic<std::size_t> drawnCount{0};
+    JobSystem::Get().ParallelFor(preview.points.size(), kPointsPerRange, [&](std::size_t begin, std::size_t end) {
+        std::size_t rangeDrawn = 0;
+        for (std::size_t index = begin; index < end; ++index) {
+            const PointCloudPreviewPoint& point = preview.points[index];
+            const glm::vec4 clip = modelViewProjection * glm::vec4(point.position, 1.0f);
+            if (clip.w <= 0.0001f) {
+                continue;
+            }
+
+            const glm::vec3 ndc = glm::vec3(clip) / clip.w;
+            if (ndc.z < -1.0f || ndc.z > 1.0f) {
+                continue;
+            }
+
+            float lighting = 0.75f;
+            if (point.packedNormal != 0) {
+                const glm::vec3 toEye = eyeAtInfinity ? eyeDirection : glm::normalize(eyePosition - point.position);
+                lighting = 0.3f + 0.7f * std::abs(glm::dot(UnpackNormal(point.packedNormal), toEye));
+            }
+            const std::uint32_t rgba = static_cast<std::uint32_t>(kSplatTint[0] * lighting) |
+                static_cast<std::uint32_t>(kSplatTint[1] * lighting) << 8 |
+                static_cast<std::uint32_t>(kSplatTint[2] * lighting) << 16 | 0xff000000u;
+            const int size = static_cast<int>(std::ceil(preview.cellSize * pixelsPerUnit / clip.w));
+            buffer.AddSplat(
+                (ndc.x * 0.5f + 0.5f) * width,
+                (1.0f - (ndc.y * 0.5f + 0.5f)) * height,
+                ndc.z * 0.5f + 0.5f,
+                size,
+                rgba);
+            ++rangeDrawn;
+        }
+        drawnCount.fetch_add(rangeDrawn, std::memory_order_relaxed);
+    });
+    return drawnCount.load();
+}
+
+CameraMotionTracker::CameraMotionTracker(double settleSeconds)
+    : settleSeconds_(settleSeconds),
+      lastCamera_{},
+      lastMotionSeconds_(0.0),
+      hasCamera_(false),
+      hasMoved_(false) {}
+
+bool CameraMotionTracker::Update(const ModelCamera& camera, double nowSeconds) noexcept {
+    const bool changed = hasCamera_ &&
+        (camera.yawDegrees != lastCamera_.yawDegrees || camera.pitchDegrees != lastCamera_.pitchDegrees ||
+         camera.rollDegrees != lastCamera_.rollDegrees || camera.cameraDistance != lastCamera_.cameraDistance ||
+         camera.orbitPivot != lastCamera_.orbitPivot);
+    if (changed) {
+        lastMotionSeconds_ = nowSeconds;
+        hasMoved_ = true;
+    }
+    lastCamera_ = camera;
+    hasCamera_ = true;
+    return hasMoved_ && nowSeconds - lastMotionSeconds_ < settleSeconds_;
+}
+
+void CameraMotionTracker::Reset() noexcept {
+    hasCamera_ = false;
+    hasMoved_ = false;
+}
+}
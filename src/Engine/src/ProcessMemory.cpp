@@ -0,0 +1,55 @@
+#include "Engine/ProcessMemory.hpp"
+
+#include <cstdio>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__linux__)
+#include <unistd.h>
+#endif
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+// Sanitizers replace malloc, leaving glibc's counters describing an allocator nobody uses.
+#if defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+#define ENGINE_MALLOC_REPLACED 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer) || __has_feature(thread_sanitizer) || __has_feature(memory_sanitizer)
+#define ENGINE_MALLOC_REPLACED 1
+#endif
+#endif
+
+namespace engine {
+ProcessMemorySample SampleProcessMemory() {
+    ProcessMemorySample sample{};
+
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        sample.residentBytes = counters.WorkingSetSize;
+    }
+#elif defined(__linux__)
+    if (std::FILE* statm = std::fopen("/proc/self/statm", "r")) {
+        unsigned long long totalPages = 0;
+        unsigned long long residentPages = 0;
+        if (std::fscanf(statm, "%llu %llu", &totalPages, &residentPages) == 2) {
+            sample.residentBytes = residentPages * static_cast<unsigned long long>(sysconf(_SC_PAGESIZE));
+        }
+        std::fclose(statm);
+    }
+#endif
+
+#if defined(__GLIBC__) && !defined(ENGINE_MALLOC_REPLACED) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    const struct mallinfo2 info = mallinfo2();
+    // Blocks served straight from mmap are in use but never part of the free lists.
+    sample.heapInUseBytes = info.uordblks + info.hblkhd;
+    sample.heapFreeBytes = info.fordblks;
+    sample.heapStatisticsAvailable = true;
+#endif
+
+    return sample;
+}
+}
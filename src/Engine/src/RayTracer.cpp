@@ -0,0 +1,388 @@
+#include "Engine/RayTracer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <limits>
+#include <string>
+#include <utility>
+
+#include <glm/geometric.hpp>
+#include <glm/matrix.hpp>
+
+#include "Engine/BatchFileReader.hpp"
+#include "Engine/JobSystem.hpp"
+#include "Engine/Log.hpp"
+#include "ImageCodec.hpp"
+
+namespace engine {
+namespace {
+constexpr std::uint32_t kPacketColumns = 4;
+constexpr std::uint32_t kPacketRows = 2;
+static_assert(kPacketColumns * kPacketRows == kModelRayPacketWidth);
+// Tiles are the unit of work handed to the job system.
+constexpr std::uint32_t kTileSize = 16;
+// Like the interactive renderers, untextured surfaces are white.
+const glm::vec4 kUntexturedColor(1.0f, 1.0f, 1.0f, 1.0f);
+// Occlusion rays start this far off the surface, as a fraction of the bounding-box diagonal.
+constexpr float kSurfaceOffset = 1.0e-4f;
+constexpr float kTwoPi = 6.28318530718f;
+
+std::uint32_t HashBits(std::uint32_t value) {
+    value ^= value >> 16;
+    value *= 0x7feb352du;
+    value ^= value >> 15;
+    value *= 0x846ca68bu;
+    value ^= value >> 16;
+    return value;
+}
+
+// Uniform in [0, 1); advances `state`. Seeded per pixel and sample, so images are reproducible
+// whichever worker traces a tile.
+float NextRandom(std::uint32_t& state) {
+    state = HashBits(state + 0x9e3779b9u);
+    return static_cast<float>(state >> 8) * (1.0f / 16777216.0f);
+}
+
+// Nearest texel, repeating outside [0, 1] like SDL_RenderGeometry.
+glm::vec4 SampleTexel(const DecodedImage& image, const glm::vec2& coordinate) {
+    const float wrappedX = coordinate.x - std::floor(coordinate.x);
+    const float wrappedY = coordinate.y - std::floor(coordinate.y);
+    const std::uint32_t column = std::min(static_cast<std::uint32_t>(wrappedX * static_cast<float>(image.width)), image.width - 1);
+    const std::uint32_t row = std::min(static_cast<std::uint32_t>(wrappedY * static_cast<float>(image.height)), image.height - 1);
+    const std::uint8_t* texel = image.pixels.data() + (static_cast<std::size_t>(row) * image.width + column) * 4;
+    return glm::vec4(texel[0], texel[1], texel[2], texel[3]) * (1.0f / 255.0f);
+}
+
+// Near and far planes of the view in model space, as a corner and two edges each. Both planes are
+// flat, so every pixel's ray is a linear blend of them.
+struct ViewFrustum {
+    glm::vec3 nearCorner;
+    glm::vec3 nearRight;
+    glm::vec3 nearUp;
+    glm::vec3 farCorner;
+    glm::vec3 farRight;
+    glm::vec3 farUp;
+};
+
+ViewFrustum BuildViewFrustum(const ModelCamera& camera, float aspectRatio) {
+    const glm::mat4 inverseMvp = glm::inverse(BuildModelViewProjection(camera, aspectRatio));
+    const auto unproject = [&inverseMvp](float ndcX, float ndcY, float ndcZ) {
+        const glm::vec4 point = inverseMvp * glm::vec4(ndcX, ndcY, ndcZ, 1.0f);
+        return glm::vec3(point) / point.w;
+    };
+
+    const glm::vec3 nearCorner = unproject(-1.0f, -1.0f, -1.0f);
+    const glm::vec3 farCorner = unproject(-1.0f, -1.0f, 1.0f);
+    return {
+        nearCorner,
+        unproject(1.0f, -1.0f, -1.0f) - nearCorner,
+        unproject(-1.0f, 1.0f, -1.0f) - nearCorner,
+        farCorner,
+        unproject(1.0f, -1.0f, 1.0f) - farCorner,
+        unproject(-1.0f, 1.0f, 1.0f) - farCorner};
+}
+
+// Cosine-weighted direction in the hemisphere around unit `normal` (Duff et al. basis).
+glm::vec3 SampleHemisphere(const glm::vec3& normal, std::uint32_t& state) {
+    const float sign = std::copysign(1.0f, normal.z);
+    const float a = -1.0f / (sign + normal.z);
+    const float b = normal.x * normal.y * a;
+    const glm::vec3 tangent(1.0f + sign * normal.x * normal.x * a, sign * b, -sign * normal.x);
+    const glm::vec3 bitangent(b, sign + normal.y * normal.y * a, -normal.y);
+
+    const float angle = kTwoPi * NextRandom(state);
+    const float radiusSquared = NextRandom(state);
+    const float radius = std::sqrt(radiusSquared);
+    return tangent * (radius * std::cos(angle)) + bitangent * (radius * std::sin(angle)) +
+        normal * std::sqrt(std::max(0.0f, 1.0f - radiusSquared));
+}
+
+void SetPacketLane(ModelRayPacket& packet, std::size_t lane, const glm::vec3& origin, const glm::vec3& direction, float maxDistance) {
+    packet.originX[lane] = origin.x;
+    packet.originY[lane] = origin.y;
+    packet.originZ[lane] = origin.z;
+    packet.directionX[lane] = direction.x;
+    packet.directionY[lane] = direction.y;
+    packet.directionZ[lane] = direction.z;
+    packet.maxDistance[lane] = maxDistance;
+}
+}
+
+RayTracer::RayTracer(const ModelData& model, std::vector<DecodedImage> textures)
+    : model_(model),
+      textures_(std::move(textures)),
+      bvh_(ModelBvh::Build(model.positions, model.indices, model.submeshes)),
+      submeshCutout_(model.submeshes.size(), 0),
+      boundsDiagonal_(0.0f) {
+    for (std::size_t submeshIndex = 0; submeshIndex < model_.submeshes.size(); ++submeshIndex) {
+        const ModelMaterial* material = model_.FindMaterial(model_.submeshes[submeshIndex]);
+        submeshCutout_[submeshIndex] = material && material->alphaCutoutEnabled ? 1 : 0;
+    }
+
+    if (!model_.positions.empty()) {
+        glm::vec3 minimum(std::numeric_limits<float>::max());
+        glm::vec3 maximum(std::numeric_limits<float>::lowest());
+        for (const glm::vec3& position : model_.positions) {
+            minimum = glm::min(minimum, position);
+            maximum = glm::max(maximum, position);
+        }
+        boundsDiagonal_ = glm::length(maximum - minimum);
+    }
+}
+
+DecodedImage RayTracer::Render(const ModelCamera& camera, const RayTraceSettings& settings, RayTraceStatistics& outStatistics) const {
+    outStatistics = {};
+    DecodedImage image{settings.width, settings.height, {}};
+    image.pixels.assign(static_cast<std::size_t>(settings.width) * settings.height * 4, 0);
+    if (bvh_.IsEmpty() || settings.width == 0 || settings.height == 0 || settings.samplesPerPixel == 0) {
+        return image;
+    }
+
+    const auto startTime = std::chrono::steady_clock::now();
+    const float width = static_cast<float>(settings.width);
+    const float height = static_cast<float>(settings.height);
+    const ViewFrustum frustum = BuildViewFrustum(camera, width / height);
+    const float occlusionDistance = std::max(settings.occlusionRadius, 0.0f) * boundsDiagonal_;
+    const float surfaceOffset = kSurfaceOffset * boundsDiagonal_;
+    const std::uint32_t occlusionRays = occlusionDistance > 0.0f ? settings.occlusionRaysPerSample : 0;
+
+    const std::uint32_t tileColumns = (settings.width + kTileSize - 1) / kTileSize;
+    const std::uint32_t tileRows = (settings.height + kTileSize - 1) / kTileSize;
+    std::atomic<std::uint64_t> primaryRayCount{0};
+    std::atomic<std::uint64_t> occlusionRayCount{0};
+    JobSystem::Get().ParallelFor(static_cast<std::size_t>(tileColumns) * tileRows, 1, [&](std::size_t begin, std::size_t end) {
+        std::uint64_t rangePrimaryRays = 0;
+        std::uint64_t rangeOcclusionRays = 0;
+        for (std::size_t tile = begin; tile < end; ++tile) {
+            const std::uint32_t tileX = static_cast<std::uint32_t>(tile % tileColumns) * kTileSize;
+            const std::uint32_t tileY = static_cast<std::uint32_t>(tile / tileColumns) * kTileSize;
+            const std::uint32_t tileEndX = std::min(tileX + kTileSize, settings.width);
+            const std::uint32_t tileEndY = std::min(tileY + kTileSize, settings.height);
+            for (std::uint32_t packetY = tileY; packetY < tileEndY; packetY += kPacketRows) {
+                for (std::uint32_t packetX = tileX; packetX < tileEndX; packetX += kPacketColumns) {
+                    std::array<glm::vec3, kModelRayPacketWidth> colorSum{};
+                    std::array<std::uint32_t, kModelRayPacketWidth> hitSamples{};
+                    for (std::uint32_t sample = 0; sample < settings.samplesPerPixel; ++sample) {
+                        ModelRayPacket primary;
+                        std::array<std::uint32_t, kModelRayPacketWidth> randomState;
+                        for (std::size_t lane = 0; lane < kModelRayPacketWidth; ++lane) {
+                            const std::uint32_t pixelX = packetX + static_cast<std::uint32_t>(lane) % kPacketColumns;
+                            const std::uint32_t pixelY = packetY + static_cast<std::uint32_t>(lane) / kPacketColumns;
+                            randomState[lane] = HashBits(pixelX ^ HashBits(pixelY ^ HashBits(sample)));
+                            const bool single = settings.samplesPerPixel == 1;
+                            const float jitterX = single ? 0.5f : NextRandom(randomState[lane]);
+                            const float jitterY = single ? 0.5f : NextRandom(randomState[lane]);
+                            const float right = (static_cast<float>(pixelX) + jitterX) / width;
+                            const float up = 1.0f - (static_cast<float>(pixelY) + jitterY) / height;
+                            const glm::vec3 origin = frustum.nearCorner + frustum.nearRight * right + frustum.nearUp * up;
+                            const glm::vec3 target = frustum.farCorner + frustum.farRight * right + frustum.farUp * up;
+                            const float length = glm::length(target - origin);
+                            const bool inImage = pixelX < tileEndX && pixelY < tileEndY;
+                            SetPacketLane(primary, lane, origin, (target - origin) / length, inImage ? length : 0.0f);
+                            rangePrimaryRays += inImage ? 1 : 0;
+                        }
+
+                        ModelRayPacketHit hit;
+                        bvh_.IntersectPacket(primary, hit, &AcceptHit, this);
+
+                        std::array<glm::vec3, kModelRayPacketWidth> hitNormal;
+                        std::array<glm::vec3, kModelRayPacketWidth> hitPosition;
+                        std::array<glm::vec4, kModelRayPacketWidth> hitColor;
+                        std::array<float, kModelRayPacketWidth> facing;
+                        std::array<std::uint32_t, kModelRayPacketWidth> visibleRays{};
+                        std::uint32_t hitMask = 0;
+                        for (std::size_t lane = 0; lane < kModelRayPacketWidth; ++lane) {
+                            if (hit.triangleIndex[lane] == ModelBvh::kNoTriangle) {
+                                continue;
+                            }
+
+                            hitMask |= 1u << lane;
+                            const std::size_t base = static_cast<std::size_t>(hit.triangleIndex[lane]) * 3;
+                            const glm::vec3& p0 = model_.positions[model_.indices[base]];
+                            const glm::vec3 direction(primary.directionX[lane], primary.directionY[lane], primary.directionZ[lane]);
+                            const glm::vec3 faceNormal = glm::cross(
+                                model_.positions[model_.indices[base + 1]] - p0,
+                                model_.positions[model_.indices[base + 2]] - p0);
+                            const float normalLength = glm::length(faceNormal);
+                            glm::vec3 normal = normalLength > 0.0f ? faceNormal / normalLength : -direction;
+                            if (glm::dot(normal, direction) > 0.0f) {
+                                normal = -normal;
+                            }
+
+                            hitNormal[lane] = normal;
+                            hitPosition[lane] = glm::vec3(primary.originX[lane], primary.originY[lane], primary.originZ[lane]) +
+                                direction * hit.distance[lane];
+                            hitColor[lane] = SampleMaterial(hit.triangleIndex[lane], hit.submeshIndex[lane], hit.barycentricU[lane], hit.barycentricV[lane]);
+                            facing[lane] = -glm::dot(normal, direction);
+                            visibleRays[lane] = occlusionRays;
+                        }
+
+                        // Occlusion rays from neighbouring pixels share a packet, so they stay
+                        // fairly coherent near the surface.
+                        for (std::uint32_t occlusionRay = 0; occlusionRay < occlusionRays && hitMask != 0; ++occlusionRay) {
+                            ModelRayPacket occlusion;
+                            for (std::size_t lane = 0; lane < kModelRayPacketWidth; ++lane) {
+                                if ((hitMask & (1u << lane)) == 0) {
+                                    SetPacketLane(occlusion, lane, glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f), 0.0f);
+                                    continue;
+                                }
+
+                                SetPacketLane(
+                                    occlusion,
+                                    lane,
+                                    hitPosition[lane] + hitNormal[lane] * surfaceOffset,
+                                    SampleHemisphere(hitNormal[lane], randomState[lane]),
+                                    occlusionDistance);
+                            }
+
+                            const std::uint32_t occludedMask = bvh_.OccludedPacket(occlusion, &AcceptHit, this);
+                            for (std::size_t lane = 0; lane < kModelRayPacketWidth; ++lane) {
+                                visibleRays[lane] -= (occludedMask >> lane) & 1u;
+                            }
+                            rangeOcclusionRays += static_cast<std::uint64_t>(std::popcount(hitMask));
+                        }
+
+                        for (std::size_t lane = 0; lane < kModelRayPacketWidth; ++lane) {
+                            if ((hitMask & (1u << lane)) == 0) {
+                                continue;
+                            }
+
+                            const float ambient = occlusionRays > 0 ?
+                                static_cast<float>(visibleRays[lane]) / static_cast<float>(occlusionRays) :
+                                1.0f;
+                            colorSum[lane] += glm::vec3(hitColor[lane]) * (ambient * (0.45f + 0.55f * facing[lane]));
+                            ++hitSamples[lane];
+                        }
+                    }
+
+                    for (std::size_t lane = 0; lane < kModelRayPacketWidth; ++lane) {
+                        const std::uint32_t pixelX = packetX + static_cast<std::uint32_t>(lane) % kPacketColumns;
+                        const std::uint32_t pixelY = packetY + static_cast<std::uint32_t>(lane) / kPacketColumns;
+                        if (pixelX >= tileEndX || pixelY >= tileEndY || hitSamples[lane] == 0) {
+                            continue;
+                        }
+
+                        const glm::vec3 color = glm::clamp(colorSum[lane] / static_cast<float>(hitSamples[lane]), glm::vec3(0.0f), glm::vec3(1.0f));
+                        const float coverage = static_cast<float>(hitSamples[lane]) / static_cast<float>(settings.samplesPerPixel);
+                        std::uint8_t* pixel = image.pixels.data() + (static_cast<std::size_t>(pixelY) * settings.width + pixelX) * 4;
+                        pixel[0] = static_cast<std::uint8_t>(color.x * 255.0f + 0.5f);
+                        pixel[1] = static_cast<std::uint8_t>(color.y * 255.0f + 0.5f);
+                        pixel[2] = static_cast<std::uint8_t>(color.z * 255.0f + 0.5f);
+                        pixel[3] = static_cast<std::uint8_t>(coverage * 255.0f + 0.5f);
+                    }
+                }
+            }
+        }
+        primaryRayCount.fetch_add(rangePrimaryRays, std::memory_order_relaxed);
+        occlusionRayCount.fetch_add(rangeOcclusionRays, std::memory_order_relaxed);
+    });
+
+    outStatistics.primaryRays = primaryRayCount.load();
+    outStatistics.occlusionRays = occlusionRayCount.load();
+    outStatistics.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    return image;
+}
+
+const ModelBvh& RayTracer::GetBvh() const noexcept {
+    return bvh_;
+}
+
+bool RayTracer::AcceptHit(const void* context, std::uint32_t triangleIndex, std::uint32_t submeshIndex, float barycentricU, float barycentricV) {
+    const RayTracer& tracer = *static_cast<const RayTracer*>(context);
+    if (submeshIndex >= tracer.submeshCutout_.size() || tracer.submeshCutout_[submeshIndex] == 0) {
+        return true;
+    }
+
+    // Matches CreateComposedTexture: texels below the cutoff are discarded, fully clear ones always.
+    const ModelMaterial& material = *tracer.model_.FindMaterial(tracer.model_.submeshes[submeshIndex]);
+    const float alpha = tracer.SampleMaterial(triangleIndex, submeshIndex, barycentricU, barycentricV).w;
+    return alpha > 0.0f && alpha >= std::clamp(material.alphaCutoff, 0.0f, 1.0f);
+}
+
+glm::vec4 RayTracer::SampleMaterial(std::uint32_t triangleIndex, std::uint32_t submeshIndex, float barycentricU, float barycentricV) const noexcept {
+    const ModelMaterial* material = submeshIndex < model_.submeshes.size() ? model_.FindMaterial(model_.submeshes[submeshIndex]) : nullptr;
+    if (!material) {
+        return kUntexturedColor;
+    }
+
+    const auto findTexture = [this](std::int32_t textureIndex) -> const DecodedImage* {
+        if (textureIndex < 0 || static_cast<std::size_t>(textureIndex) >= textures_.size()) {
+            return nullptr;
+        }
+
+        const DecodedImage& image = textures_[static_cast<std::size_t>(textureIndex)];
+        return image.width > 0 && image.height > 0 ? &image : nullptr;
+    };
+
+    glm::vec2 coordinate(0.0f);
+    if (model_.texCoords.size() == model_.positions.size()) {
+        const std::size_t base = static_cast<std::size_t>(triangleIndex) * 3;
+        const glm::vec2 texCoord = model_.texCoords[model_.indices[base]] * (1.0f - barycentricU - barycentricV) +
+            model_.texCoords[model_.indices[base + 1]] * barycentricU + model_.texCoords[model_.indices[base + 2]] * barycentricV;
+        // The interactive renderers flip both axes when they hand texture coordinates to SDL.
+        coordinate = glm::vec2(1.0f) - texCoord;
+    }
+
+    const DecodedImage* colorTexture = findTexture(material->textureIndex);
+    glm::vec4 color = colorTexture ? SampleTexel(*colorTexture, coordinate) : kUntexturedColor;
+    float opacitySample = 1.0f;
+    if (const DecodedImage* opacityTexture = findTexture(material->opacityTextureIndex)) {
+        opacitySample = SampleTexel(*opacityTexture, coordinate).x;
+        if (material->opacityTextureInverted) {
+            opacitySample = 1.0f - opacitySample;
+        }
+    }
+
+    color.w = std::clamp(color.w * std::clamp(material->opacity, 0.0f, 1.0f) * std::clamp(opacitySample, 0.0f, 1.0f), 0.0f, 1.0f);
+    return color;
+}
+
+std::vector<DecodedImage> LoadRayTracerTextures(const ModelData& model) {
+    std::vector<DecodedImage> textures(model.texturePaths.size());
+    std::vector<bool> textureNeeded(model.texturePaths.size(), false);
+    const auto markTexture = [&](std::int32_t textureIndex) {
+        if (textureIndex >= 0 && static_cast<std::size_t>(textureIndex) < textureNeeded.size() &&
+            !model.texturePaths[static_cast<std::size_t>(textureIndex)].empty()) {
+            textureNeeded[static_cast<std::size_t>(textureIndex)] = true;
+        }
+    };
+    for (const ModelMaterial& material : model.materials) {
+        markTexture(material.textureIndex);
+        markTexture(material.opacityTextureIndex);
+    }
+
+    std::vector<std::size_t> neededTextures;
+    std::vector<std::filesystem::path> neededPaths;
+    for (std::size_t textureIndex = 0; textureIndex < textureNeeded.size(); ++textureIndex) {
+        if (textureNeeded[textureIndex]) {
+            neededTextures.push_back(textureIndex);
+            neededPaths.emplace_back(model.texturePaths[textureIndex]);
+        }
+    }
+
+    JobSystem& jobs = JobSystem::Get();
+    std::vector<FileReadResult> files;
+    std::vector<JobSystem::JobHandle> decodeJobs(neededTextures.size());
+    ReadFileBatch(jobs, neededPaths, files, [&](std::size_t fileIndex) {
+        decodeJobs[fileIndex] = jobs.Schedule([&, fileIndex]() {
+            const std::size_t textureIndex = neededTextures[fileIndex];
+            std::string decodeError = files[fileIndex].error;
+            if (!files[fileIndex].succeeded ||
+                !DecodeImageMemory(files[fileIndex].bytes, model.texturePaths[textureIndex], textures[textureIndex], decodeError)) {
+                textures[textureIndex] = {};
+                LogWarning(LogCategory::Renderer, "Ray tracer texture '%s' not loaded: %s", model.texturePaths[textureIndex], decodeError);
+            }
+            files[fileIndex].bytes = {};
+        });
+    });
+    for (const JobSystem::JobHandle& decodeJob : decodeJobs) {
+        jobs.Wait(decodeJob);
+    }
+    return textures;
+}
+}
@@ -0,0 +1,90 @@
+#include "Engine/RendererStatistics.hpp"
+
+#include <algorithm>
+
+namespace engine {
+const std::vector<RendererStatisticsField>& GetRendererStatisticsFields() {
+    static const std::vector<RendererStatisticsField> fields = {
+        {"Vertices projected", &RendererFrameStatistics::verticesProjected},
+        {"Triangles submitted", &RendererFrameStatistics::trianglesSubmitted},
+        {"Triangles culled", &RendererFrameStatistics::trianglesCulled},
+        {"Triangles clipped", &RendererFrameStatistics::trianglesClipped},
+        {"Draw calls", &RendererFrameStatistics::drawCalls},
+        {"Texture binds", &RendererFrameStatistics::textureBinds},
+        {"Pipeline state changes", &RendererFrameStatistics::pipelineStateChanges},
+        {"Bytes uploaded", &RendererFrameStatistics::bytesUploaded},
+        {"Composed texture hits", &RendererFrameStatistics::composedTextureCacheHits},
+        {"Composed texture misses", &RendererFrameStatistics::composedTextureCacheMisses},
+        {"Overlay lines", &RendererFrameStatistics::overlayLineCount},
+        {"Scene pixels", &RendererFrameStatistics::scenePixels},
+        {"Shaded pixels", &RendererFrameStatistics::shadedPixels},
+        {"Covered pixels", &RendererFrameStatistics::coveredPixels},
+        {"Max overdraw", &RendererFrameStatistics::maxOverdraw},
+        {"Texture bytes resident", &RendererFrameStatistics::textureBytesResident},
+        {"Texture decodes pending", &RendererFrameStatistics::textureDecodesPending},
+        {"Textures at placeholder", &RendererFrameStatistics::texturesAtPlaceholder},
+        {"Preview splats", &RendererFrameStatistics::previewSplats},
+    };
+    return fields;
+}
+
+RendererStatisticsHistory::RendererStatisticsHistory(std::size_t capacity)
+    : frames_(std::max<std::size_t>(capacity, 1), RendererFrameStatistics{}),
+      nextIndex_(0),
+      size_(0) {}
+
+void RendererStatisticsHistory::Push(const RendererFrameStatistics& frame) {
+    frames_[nextIndex_] = frame;
+    nextIndex_ = (nextIndex_ + 1) % frames_.size();
+    size_ = std::min(size_ + 1, frames_.size());
+}
+
+void RendererStatisticsHistory::Clear() noexcept {
+    nextIndex_ = 0;
+    size_ = 0;
+}
+
+std::size_t RendererStatisticsHistory::GetSize() const noexcept {
+    return size_;
+}
+
+std::size_t RendererStatisticsHistory::GetCapacity() const noexcept {
+    return frames_.size();
+}
+
+const RendererFrameStatistics& RendererStatisticsHistory::GetLatest() const noexcept {
+    static const RendererFrameStatistics kEmpty{};
+    if (size_ == 0) {
+        return kEmpty;
+    }
+    return frames_[(nextIndex_ + frames_.size() - 1) % frames_.size()];
+}
+
+double RendererStatisticsHistory::ComputeAverage(RendererStatisticsCounter counter) const noexcept {
+    if (size_ == 0) {
+        return 0.0;
+    }
+
+    double total = 0.0;
+    for (std::size_t offset = 0; offset < size_; ++offset) {
+        total += static_cast<double>(frames_[(nextIndex_ + frames_.size() - 1 - offset) % frames_.size()].*counter);
+    }
+    return total / static_cast<double>(size_);
+}
+
+std::uint64_t RendererStatisticsHistory::ComputeMaximum(RendererStatisticsCounter counter) const noexcept {
+    std::uint64_t maximum = 0;
+    for (std::size_t offset = 0; offset < size_; ++offset) {
+        maximum = std::max(maximum, frames_[(nextIndex_ + frames_.size() - 1 - offset) % frames_.size()].*counter);
+    }
+    return maximum;
+}
+
+void RendererStatisticsHistory::CopySeries(RendererStatisticsCounter counter, std::vector<float>& outValues) const {
+    outValues.resize(size_);
+    const std::size_t oldestIndex = (nextIndex_ + frames_.size() - size_) % frames_.size();
+    for (std::size_t offset = 0; offset < size_; ++offset) {
+        outValues[offset] = static_cast<float>(frames_[(oldestIndex + offset) % frames_.size()].*counter);
+    }
+}
+}
@@ -0,0 +1,108 @@
+#include "Engine/ResolutionGovernor.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace engine {
+namespace {
+// Weight of the newest frame in the smoothed frame time.
+constexpr double kSmoothingFactor = 0.2;
+// Raising is capped at this many quanta per step; dropping may jump as far as the ratio asks.
+constexpr float kMaxRaiseSteps = 2.0f;
+}
+
+ResolutionGovernorSettings GetDefaultResolutionGovernorSettings() {
+    return ResolutionGovernorSettings{1.0 / 60.0, 0.5f, 1.0f, 0.05f, 1.1, 0.8, 6, 45};
+}
+
+ResolutionGovernor::ResolutionGovernor(const ResolutionGovernorSettings& settings)
+    : settings_(settings),
+      scale_(settings.maxScale),
+      smoothedFrameSeconds_(0.0),
+      slowFrameCount_(0),
+      fastFrameCount_(0) {
+    SetSettings(settings);
+    scale_ = settings_.maxScale;
+}
+
+float ResolutionGovernor::Update(double frameSeconds) {
+    if (!std::isfinite(frameSeconds) || frameSeconds <= 0.0 || settings_.targetFrameSeconds <= 0.0) {
+        return scale_;
+    }
+
+    smoothedFrameSeconds_ = smoothedFrameSeconds_ <= 0.0
+        ? frameSeconds
+        : smoothedFrameSeconds_ + kSmoothingFactor * (frameSeconds - smoothedFrameSeconds_);
+    const double ratio = smoothedFrameSeconds_ / settings_.targetFrameSeconds;
+    if (ratio > settings_.dropThreshold) {
+        ++slowFrameCount_;
+        fastFrameCount_ = 0;
+    } else if (ratio < settings_.raiseThreshold) {
+        ++fastFrameCount_;
+        slowFrameCount_ = 0;
+    } else {
+        slowFrameCount_ = 0;
+        fastFrameCount_ = 0;
+    }
+
+    const float desiredScale = scale_ * static_cast<float>(std::sqrt(1.0 / ratio));
+    float nextScale = scale_;
+    if (slowFrameCount_ >= settings_.framesBeforeDrop) {
+        nextScale = std::min(Quantize(desiredScale), scale_ - settings_.scaleQuantum);
+    } else if (fastFrameCount_ >= settings_.framesBeforeRaise) {
+        nextScale = std::clamp(
+            Quantize(desiredScale),
+            scale_ + settings_.scaleQuantum,
+            scale_ + settings_.scaleQuantum * kMaxRaiseSteps);
+    }
+
+    nextScale = std::clamp(nextScale, settings_.minScale, settings_.maxScale);
+    if (nextScale != scale_) {
+        // The history was measured at the old scale; carry it over so one slow spell does not
+        // cause a second drop before the new scale has been measured.
+        const double pixelRatio = static_cast<double>(nextScale) / static_cast<double>(scale_);
+        smoothedFrameSeconds_ *= pixelRatio * pixelRatio;
+        scale_ = nextScale;
+        slowFrameCount_ = 0;
+        fastFrameCount_ = 0;
+    }
+    return scale_;
+}
+
+void ResolutionGovernor::Reset() noexcept {
+    scale_ = settings_.maxScale;
+    smoothedFrameSeconds_ = 0.0;
+    slowFrameCount_ = 0;
+    fastFrameCount_ = 0;
+}
+
+void ResolutionGovernor::SetSettings(const ResolutionGovernorSettings& settings) {
+    settings_ = settings;
+    settings_.minScale = std::clamp(settings_.minScale, 0.05f, 1.0f);
+    settings_.maxScale = std::clamp(settings_.maxScale, settings_.minScale, 1.0f);
+    scale_ = std::clamp(scale_, settings_.minScale, settings_.maxScale);
+    slowFrameCount_ = 0;
+    fastFrameCount_ = 0;
+}
+
+const ResolutionGovernorSettings& ResolutionGovernor::GetSettings() const noexcept {
+    return settings_;
+}
+
+float ResolutionGovernor::GetScale() const noexcept {
+    return scale_;
+}
+
+double ResolutionGovernor::GetSmoothedFrameSeconds() const noexcept {
+    return smoothedFrameSeconds_;
+}
+
+float ResolutionGovernor::Quantize(float scale) const noexcept {
+    if (settings_.scaleQuantum <= 0.0f) {
+        return scale;
+    }
+
+    // The small bias keeps exact multiples from rounding down a whole quantum.
+    return std::floor(scale / settings_.scaleQuantum + 1e-3f) * settings_.scaleQuantum;
+}
+}
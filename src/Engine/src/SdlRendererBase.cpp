@@ -1,19 +1,28 @@
 #include "SdlRendererBase.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <bit>
+#include <cmath>
 #include <cstdint>
 #include <cstring>
+#include <iterator>
+#include <mutex>
+#include <span>
+#include <utility>
 #include <vector>
 
 #include <SDL3/SDL.h>
-#include <glm/ext/matrix_clip_space.hpp>
-#include <glm/ext/matrix_transform.hpp>
-#include <glm/gtc/constants.hpp>
+#include <glm/vec4.hpp>
+
+#include "Engine/FlightRecorder.hpp"
+#include "Engine/JobSystem.hpp"
+#include "Engine/Log.hpp"
+#include "Engine/ModelCook.hpp"
+#include "Engine/TriangleAssembly.hpp"
 
 #if defined(_WIN32)
 #include <objbase.h>
-#include <wincodec.h>
 #include <windows.h>
 #endif
 
@@ -39,6 +48,14 @@ ProjectedVertex ProjectVertex(const glm::vec3& point, const glm::mat4& mvp, int
     return {screenX, screenY, ndc.z, depthValid};
 }
 
+// The model pass draws color modulated by opacity; normal, emissive and specular maps are unused.
+constexpr MaterialChannelMask kSampledMaterialChannels = kMaterialChannelColor | kMaterialChannelOpacity;
+
+constexpr std::size_t kVerticesPerRange = 16384;
+constexpr std::size_t kTrianglesPerRange = 8192;
+// Each row band walks every triangle, so bands are kept tall enough to amortize the bounds tests.
+constexpr std::size_t kOverdrawRowsPerRange = 32;
+
 struct TexturedTriangle {
     SDL_Vertex vertices[3];
     SDL_Texture* texture;
@@ -46,143 +63,150 @@ struct TexturedTriangle {
     bool isTransparent;
 };
 
-std::uint8_t SampleSurfaceChannelNearest(const SDL_Surface* surface, int x, int y, int channelIndex) {
-    if (!surface || !surface->pixels || surface->w <= 0 || surface->h <= 0 || channelIndex < 0 || channelIndex > 3) {
-        return 255;
-    }
+struct TriangleBatch;
+
+// Assembles `triangleCount` triangles of a batch, starting `batchOffset` triangles in, into
+// consecutive slots of `output`. Slots of rejected triangles are left untouched.
+using TexturedBatchKernel = void (*)(
+    const TriangleBatch& batch,
+    const ModelData& model,
+    std::span<const ProjectedVertex> projected,
+    std::span<const std::uint8_t> outcodes,
+    std::size_t batchOffset,
+    std::size_t triangleCount,
+    TexturedTriangle* output,
+    TriangleRejectCounts& rejected);
+
+// A run of index-buffer triangles drawn with one texture. `firstTriangle` is the run's first slot
+// in the frame's triangle list; the slots name the streamed textures the run samples.
+struct TriangleBatch {
+    std::size_t indexStart;
+    std::size_t firstTriangle;
+    std::size_t triangleCount;
+    SDL_Texture* texture;
+    float opacity;
+    TexturedBatchKernel kernel;
+    std::int32_t colorTextureSlot;
+    std::int32_t opacityTextureSlot;
+};
 
-    const int sampleX = std::clamp(x, 0, surface->w - 1);
-    const int sampleY = std::clamp(y, 0, surface->h - 1);
-    const std::uint8_t* pixelBase = static_cast<const std::uint8_t*>(surface->pixels) +
-        (sampleY * surface->pitch) + (sampleX * 4);
-    return pixelBase[channelIndex];
-}
+// Twice the screen and texture-coordinate areas of a batch's kept triangles; their ratio gives
+// the texels per unit the batch's textures are sampled at.
+struct BatchCoverage {
+    double screenArea;
+    double texCoordArea;
+};
 
-#if defined(_WIN32)
-std::wstring Utf8ToWide(const std::string& input) {
-    if (input.empty()) {
-        return {};
-    }
+void AccumulateCoverage(const TexturedTriangle* triangles, std::size_t count, BatchCoverage& coverage) noexcept {
+    for (std::size_t index = 0; index < count; ++index) {
+        const TexturedTriangle& triangle = triangles[index];
+        if (!triangle.texture) {
+            continue;
+        }
 
-    const int requiredSize = MultiByteToWideChar(CP_UTF8, 0, input.c_str(), -1, nullptr, 0);
-    if (requiredSize <= 1) {
-        return {};
+        const SDL_Vertex& a = triangle.vertices[0];
+        const SDL_Vertex& b = triangle.vertices[1];
+        const SDL_Vertex& c = triangle.vertices[2];
+        coverage.screenArea += std::fabs(
+            (b.position.x - a.position.x) * (c.position.y - a.position.y) - (c.position.x - a.position.x) * (b.position.y - a.position.y));
+        coverage.texCoordArea += std::fabs(
+            (b.tex_coord.x - a.tex_coord.x) * (c.tex_coord.y - a.tex_coord.y) - (c.tex_coord.x - a.tex_coord.x) * (b.tex_coord.y - a.tex_coord.y));
     }
-
-    std::wstring output(static_cast<std::size_t>(requiredSize - 1), L'\0');
-    MultiByteToWideChar(CP_UTF8, 0, input.c_str(), -1, output.data(), requiredSize);
-    return output;
 }
 
-SDL_Surface* LoadSurfaceWithWic(const std::string& path) {
-    if (path.empty()) {
-        return nullptr;
-    }
-
-    const std::wstring widePath = Utf8ToWide(path);
-    if (widePath.empty()) {
-        return nullptr;
-    }
-
-    IWICImagingFactory* factory = nullptr;
-    HRESULT result = CoCreateInstance(
-        CLSID_WICImagingFactory,
-        nullptr,
-        CLSCTX_INPROC_SERVER,
-        IID_PPV_ARGS(&factory));
-    if (FAILED(result) || !factory) {
-        return nullptr;
-    }
-
-    IWICBitmapDecoder* decoder = nullptr;
-    result = factory->CreateDecoderFromFilename(
-        widePath.c_str(),
-        nullptr,
-        GENERIC_READ,
-        WICDecodeMetadataCacheOnLoad,
-        &decoder);
-    if (FAILED(result) || !decoder) {
-        factory->Release();
-        return nullptr;
-    }
-
-    IWICBitmapFrameDecode* frame = nullptr;
-    result = decoder->GetFrame(0, &frame);
-    if (FAILED(result) || !frame) {
-        decoder->Release();
-        factory->Release();
-        return nullptr;
-    }
-
-    IWICFormatConverter* converter = nullptr;
-    result = factory->CreateFormatConverter(&converter);
-    if (FAILED(result) || !converter) {
-        frame->Release();
-        decoder->Release();
-        factory->Release();
-        return nullptr;
-    }
+template <bool kIndicesValidated, bool kTransparent>
+void AssembleTexturedBatch(
+    const TriangleBatch& batch,
+    const ModelData& model,
+    std::span<const ProjectedVertex> projected,
+    std::span<const std::uint8_t> outcodes,
+    std::size_t batchOffset,
+    std::size_t triangleCount,
+    TexturedTriangle* output,
+    TriangleRejectCounts& rejected) {
+    const std::span<const std::uint32_t> indices(model.indices.data() + batch.indexStart + batchOffset * 3, triangleCount * 3);
+    const SDL_FColor color{1.0f, 1.0f, 1.0f, batch.opacity};
+    AssembleTriangles<kIndicesValidated, true>(
+        indices,
+        outcodes,
+        rejected,
+        [&](std::size_t triangleIndex, std::uint32_t i0, std::uint32_t i1, std::uint32_t i2, bool keep) {
+            // Rejected slots keep their null texture; skipping them saves the stores, which cost
+            // more than the branch.
+            if (!keep) {
+                return;
+            }
 
-    result = converter->Initialize(
-        frame,
-        GUID_WICPixelFormat32bppRGBA,
-        WICBitmapDitherTypeNone,
-        nullptr,
-        0.0f,
-        WICBitmapPaletteTypeCustom);
-    if (FAILED(result)) {
-        converter->Release();
-        frame->Release();
-        decoder->Release();
-        factory->Release();
-        return nullptr;
-    }
+            const ProjectedVertex& p0 = projected[i0];
+            const ProjectedVertex& p1 = projected[i1];
+            const ProjectedVertex& p2 = projected[i2];
+            const glm::vec2& uv0 = model.texCoords[i0];
+            const glm::vec2& uv1 = model.texCoords[i1];
+            const glm::vec2& uv2 = model.texCoords[i2];
+
+            TexturedTriangle& triangle = output[triangleIndex];
+            triangle.vertices[0] = SDL_Vertex{SDL_FPoint{p0.x, p0.y}, color, SDL_FPoint{1.0f - uv0.x, 1.0f - uv0.y}};
+            triangle.vertices[1] = SDL_Vertex{SDL_FPoint{p1.x, p1.y}, color, SDL_FPoint{1.0f - uv1.x, 1.0f - uv1.y}};
+            triangle.vertices[2] = SDL_Vertex{SDL_FPoint{p2.x, p2.y}, color, SDL_FPoint{1.0f - uv2.x, 1.0f - uv2.y}};
+            triangle.texture = batch.texture;
+            triangle.depth = (p0.depth + p1.depth + p2.depth) / 3.0f;
+            triangle.isTransparent = kTransparent;
+        });
+}
 
-    UINT width = 0;
-    UINT height = 0;
-    result = converter->GetSize(&width, &height);
-    if (FAILED(result) || width == 0 || height == 0) {
-        converter->Release();
-        frame->Release();
-        decoder->Release();
-        factory->Release();
-        return nullptr;
+TexturedBatchKernel SelectTexturedBatchKernel(bool indicesValidated, bool isTransparent) {
+    if (indicesValidated) {
+        return isTransparent ? &AssembleTexturedBatch<true, true> : &AssembleTexturedBatch<true, false>;
     }
+    return isTransparent ? &AssembleTexturedBatch<false, true> : &AssembleTexturedBatch<false, false>;
+}
 
-    const UINT stride = width * 4;
-    std::vector<std::uint8_t> pixels(static_cast<std::size_t>(stride) * static_cast<std::size_t>(height));
-    result = converter->CopyPixels(nullptr, stride, static_cast<UINT>(pixels.size()), pixels.data());
-    if (FAILED(result)) {
-        converter->Release();
-        frame->Release();
-        decoder->Release();
-        factory->Release();
-        return nullptr;
-    }
+template <bool kIndicesValidated>
+void AssembleOverlayLines(
+    const ModelData& model,
+    std::span<const ProjectedVertex> projected,
+    std::span<const std::uint8_t> outcodes,
+    std::vector<SDL_FPoint>& outLinePoints) {
+    TriangleRejectCounts rejected{};
+    AssembleTriangles<kIndicesValidated, false>(
+        std::span<const std::uint32_t>(model.indices),
+        outcodes,
+        rejected,
+        [&](std::size_t, std::uint32_t i0, std::uint32_t i1, std::uint32_t i2, bool keep) {
+            if (keep) {
+                const SDL_FPoint a{projected[i0].x, projected[i0].y};
+                const SDL_FPoint b{projected[i1].x, projected[i1].y};
+                const SDL_FPoint c{projected[i2].x, projected[i2].y};
+                outLinePoints.insert(outLinePoints.end(), {a, b, b, c, c, a});
+            }
+        });
+}
 
-    SDL_Surface* surface = SDL_CreateSurface(static_cast<int>(width), static_cast<int>(height), SDL_PIXELFORMAT_RGBA32);
-    if (surface && static_cast<UINT>(surface->pitch) == stride) {
-        std::memcpy(surface->pixels, pixels.data(), pixels.size());
-    } else if (surface) {
-        for (UINT row = 0; row < height; ++row) {
-            const std::size_t sourceOffset = static_cast<std::size_t>(row) * static_cast<std::size_t>(stride);
-            const std::size_t destinationOffset = static_cast<std::size_t>(row) * static_cast<std::size_t>(surface->pitch);
-            std::memcpy(
-                static_cast<std::uint8_t*>(surface->pixels) + destinationOffset,
-                pixels.data() + sourceOffset,
-                static_cast<std::size_t>(stride));
-        }
+std::uint8_t SampleSurfaceChannelNearest(const SDL_Surface* surface, int x, int y, int channelIndex) {
+    if (!surface || !surface->pixels || surface->w <= 0 || surface->h <= 0 || channelIndex < 0 || channelIndex > 3) {
+        return 255;
     }
 
-    converter->Release();
-    frame->Release();
-    decoder->Release();
-    factory->Release();
-    return surface;
+    const int sampleX = std::clamp(x, 0, surface->w - 1);
+    const int sampleY = std::clamp(y, 0, surface->h - 1);
+    const std::uint8_t* pixelBase = static_cast<const std::uint8_t*>(surface->pixels) +
+        (sampleY * surface->pitch) + (sampleX * 4);
+    return pixelBase[channelIndex];
 }
-#endif
 }
 
+// Per-frame working storage of the model pass, kept between frames so drawing a model allocates
+// only when it grows.
+struct SdlRendererBase::ModelPassBuffers {
+    std::vector<ProjectedVertex> projected;
+    std::vector<std::uint8_t> outcodes;
+    std::vector<TriangleBatch> batches;
+    std::vector<BatchCoverage> coverage;
+    std::vector<TexturedTriangle> texturedTriangles;
+    std::vector<SDL_Vertex> batchVertices;
+    std::vector<SDL_FPoint> linePoints;
+};
+
 SdlRendererBase::SdlRendererBase(const char* rendererHint, const char* displayName)
     : rendererHint_(rendererHint),
     displayName_(displayName),
@@ -190,7 +214,32 @@ SdlRendererBase::SdlRendererBase(const char* rendererHint, const char* displayNa
     modelTextures_(),
     modelTextureSurfaces_(),
     modelTexturePaths_(),
-    composedTextures_()
+    modelTexturesNeeded_(),
+    modelTexturesNeededSource_(),
+    staleTexturePaths_(),
+    textureStreamer_(),
+    textureStreamUpdates_(),
+    placeholderTexture_(nullptr),
+    composedTextures_(),
+    modelPassBuffers_(std::make_unique<ModelPassBuffers>()),
+    frameStatistics_(),
+    renderScale_(1.0f),
+    sceneTarget_(nullptr),
+    sceneTargetWidth_(0),
+    sceneTargetHeight_(0),
+    overdrawVisualizationEnabled_(false),
+    overdrawBuffer_(),
+    overdrawPixels_(),
+    overdrawTexture_(nullptr),
+    overdrawTextureWidth_(0),
+    overdrawTextureHeight_(0),
+    pointCloudPreview_(),
+    cameraMotion_(),
+    splatBuffer_(),
+    splatPixels_(),
+    splatTexture_(nullptr),
+    splatTextureWidth_(0),
+    splatTextureHeight_(0)
 #if defined(_WIN32)
     , comInitialized_(false)
 #endif
@@ -235,7 +284,8 @@ bool SdlRendererBase::Initialize(SDL_Window* window, std::string& outError) {
 
     SDL_SetRenderDrawColor(renderer_, 18, 20, 24, 255);
     SDL_RenderClear(renderer_);
-    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION,
+    LogInfo(
+        LogCategory::Renderer,
         "SDL renderer created. Requested='%s', actual='%s'.",
         rendererHint_,
         actualRendererName ? actualRendererName : "unknown");
@@ -251,6 +301,13 @@ bool SdlRendererBase::Initialize(SDL_Window* window, std::string& outError) {
 void SdlRendererBase::Shutdown() noexcept {
     ReleaseComposedTextures();
     ReleaseModelTextures();
+    if (placeholderTexture_) {
+        SDL_DestroyTexture(placeholderTexture_);
+        placeholderTexture_ = nullptr;
+    }
+    ReleaseSceneTarget();
+    ReleaseOverdrawTexture();
+    ReleaseSplatTexture();
 
     if (renderer_) {
         SDL_DestroyRenderer(renderer_);
@@ -265,6 +322,13 @@ void SdlRendererBase::Shutdown() noexcept {
 #endif
 }
 
+bool SdlRendererBase::SourcesEqual(const TextureNeedsSource& left, const TextureNeedsSource& right) noexcept {
+    return left.materials == right.materials &&
+        left.materialCount == right.materialCount &&
+        left.submeshes == right.submeshes &&
+        left.submeshCount == right.submeshCount;
+}
+
 bool SdlRendererBase::KeysEqual(const ComposedTextureKey& left, const ComposedTextureKey& right) noexcept {
     return left.colorTextureIndex == right.colorTextureIndex &&
         left.opacityTextureIndex == right.opacityTextureIndex &&
@@ -275,6 +339,7 @@ bool SdlRendererBase::KeysEqual(const ComposedTextureKey& left, const ComposedTe
 }
 
 void SdlRendererBase::BeginFrame() {
+    frameStatistics_ = {};
     SDL_SetRenderDrawColor(renderer_, 18, 20, 24, 255);
     SDL_RenderClear(renderer_);
 }
@@ -283,40 +348,79 @@ void SdlRendererBase::EndFrame() {
     SDL_RenderPresent(renderer_);
 }
 
-void SdlRendererBase::RenderModelWireframe(const ModelData& model, float yawDegrees, float pitchDegrees, float rollDegrees, float cameraDistance, bool wireOverlayEnabled) {
+void SdlRendererBase::RenderModelWireframe(const ModelData& model, const CameraLatch& latchCamera, bool wireOverlayEnabled) {
     if (!renderer_ || !model.IsValid()) {
         return;
     }
 
-    int viewportWidth = 0;
-    int viewportHeight = 0;
-    SDL_GetRenderOutputSize(renderer_, &viewportWidth, &viewportHeight);
-    if (viewportWidth <= 1 || viewportHeight <= 1) {
+    int outputWidth = 0;
+    int outputHeight = 0;
+    SDL_GetRenderOutputSize(renderer_, &outputWidth, &outputHeight);
+    if (outputWidth <= 1 || outputHeight <= 1) {
         return;
     }
 
-    const float aspectRatio = static_cast<float>(viewportWidth) / static_cast<float>(viewportHeight);
-    const float clampedDistance = std::clamp(cameraDistance, 1.0f, 20.0f);
-
-    glm::mat4 modelMatrix(1.0f);
-    modelMatrix = glm::rotate(modelMatrix, glm::radians(yawDegrees), glm::vec3(0.0f, 1.0f, 0.0f));
-    modelMatrix = glm::rotate(modelMatrix, glm::radians(pitchDegrees), glm::vec3(1.0f, 0.0f, 0.0f));
-    modelMatrix = glm::rotate(modelMatrix, glm::radians(rollDegrees), glm::vec3(0.0f, 0.0f, 1.0f));
-
-    const glm::mat4 viewMatrix = glm::lookAt(
-        glm::vec3(0.0f, 0.0f, clampedDistance),
-        glm::vec3(0.0f, 0.0f, 0.0f),
-        glm::vec3(0.0f, 1.0f, 0.0f));
+    // Below full scale the model pass is drawn into the top-left corner of an offscreen target and
+    // stretched over the window afterwards, so the ImGui overlay drawn later stays sharp. The
+    // target keeps the full output size; only window resizes reallocate it.
+    const int sceneWidth = std::max(2, static_cast<int>(std::lround(static_cast<float>(outputWidth) * renderScale_)));
+    const int sceneHeight = std::max(2, static_cast<int>(std::lround(static_cast<float>(outputHeight) * renderScale_)));
+    if ((sceneWidth >= outputWidth && sceneHeight >= outputHeight) || !EnsureSceneTarget(outputWidth, outputHeight)) {
+        frameStatistics_.scenePixels += static_cast<std::uint64_t>(outputWidth) * static_cast<std::uint64_t>(outputHeight);
+        RenderModelPass(model, latchCamera, wireOverlayEnabled, outputWidth, outputHeight);
+        return;
+    }
 
-    const glm::mat4 projectionMatrix = glm::perspective(glm::radians(60.0f), aspectRatio, 0.1f, 100.0f);
-    const glm::mat4 mvp = projectionMatrix * viewMatrix * modelMatrix;
+    const SDL_Rect sceneRect{0, 0, sceneWidth, sceneHeight};
+    SDL_SetRenderTarget(renderer_, sceneTarget_);
+    SDL_SetRenderViewport(renderer_, &sceneRect);
+    SDL_SetRenderDrawColor(renderer_, 18, 20, 24, 255);
+    SDL_RenderClear(renderer_);
+    frameStatistics_.scenePixels += static_cast<std::uint64_t>(sceneWidth) * static_cast<std::uint64_t>(sceneHeight);
+    RenderModelPass(model, latchCamera, wireOverlayEnabled, sceneWidth, sceneHeight);
+
+    SDL_SetRenderTarget(renderer_, nullptr);
+    SDL_SetRenderViewport(renderer_, nullptr);
+    const SDL_FRect sourceRect{0.0f, 0.0f, static_cast<float>(sceneWidth), static_cast<float>(sceneHeight)};
+    SDL_RenderTexture(renderer_, sceneTarget_, &sourceRect, nullptr);
+    ++frameStatistics_.drawCalls;
+    ++frameStatistics_.textureBinds;
+}
 
-    std::vector<ProjectedVertex> projected;
-    projected.reserve(model.positions.size());
-    for (const glm::vec3& point : model.positions) {
-        projected.push_back(ProjectVertex(point, mvp, viewportWidth, viewportHeight));
+void SdlRendererBase::RenderModelPass(
+    const ModelData& model,
+    const CameraLatch& latchCamera,
+    bool wireOverlayEnabled,
+    int viewportWidth,
+    int viewportHeight) {
+    const float aspectRatio = static_cast<float>(viewportWidth) / static_cast<float>(viewportHeight);
+    const ModelCamera camera = latchCamera();
+    const glm::mat4 mvp = BuildModelViewProjection(camera, aspectRatio);
+
+    // While the camera moves, the preview stands in for the triangles; they come back once it has
+    // been still for a moment. Texture streaming holds its state until then.
+    const bool cameraMoving = cameraMotion_.Update(camera, static_cast<double>(SDL_GetTicksNS()) / 1.0e9);
+    if (cameraMoving && pointCloudPreview_ && !pointCloudPreview_->points.empty() &&
+        pointCloudPreview_->sourceVertexCount == model.positions.size()) {
+        DrawPointCloudPreview(mvp, viewportWidth, viewportHeight);
+        return;
     }
 
+    JobSystem& jobs = JobSystem::Get();
+    const TriangleCullRect cullRect{0.0f, 0.0f, static_cast<float>(viewportWidth), static_cast<float>(viewportHeight)};
+    std::vector<ProjectedVertex>& projected = modelPassBuffers_->projected;
+    std::vector<std::uint8_t>& outcodes = modelPassBuffers_->outcodes;
+    projected.resize(model.positions.size());
+    outcodes.resize(model.positions.size());
+    jobs.ParallelFor(model.positions.size(), kVerticesPerRange, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t index = begin; index < end; ++index) {
+            const ProjectedVertex vertex = ProjectVertex(model.positions[index], mvp, viewportWidth, viewportHeight);
+            projected[index] = vertex;
+            outcodes[index] = ComputeVertexOutcode(vertex.x, vertex.y, vertex.valid, cullRect);
+        }
+    });
+    frameStatistics_.verticesProjected += projected.size();
+
     UpdateModelTextures(model);
 
     const bool canRenderTextured =
@@ -327,76 +431,143 @@ void SdlRendererBase::RenderModelWireframe(const ModelData& model, float yawDegr
     bool renderedAnyTexturedGeometry = false;
 
     if (canRenderTextured) {
-        std::vector<TexturedTriangle> texturedTriangles;
-
-        auto appendTriangles = [&](std::size_t indexStart, std::size_t indexEnd, SDL_Texture* texture, float opacity, bool isTransparent) {
+        // Textures are resolved up front because composing one creates SDL objects; the
+        // per-triangle work for every batch then runs on the job system.
+        std::vector<TriangleBatch>& batches = modelPassBuffers_->batches;
+        batches.clear();
+        std::size_t triangleCount = 0;
+        auto addBatch = [&](
+                            std::size_t indexStart,
+                            std::size_t indexEnd,
+                            SDL_Texture* texture,
+                            float opacity,
+                            bool isTransparent,
+                            std::int32_t colorTextureSlot,
+                            std::int32_t opacityTextureSlot) {
             if (!texture || indexEnd > model.indices.size() || indexStart >= indexEnd) {
                 return;
             }
 
-            const float clampedOpacity = std::clamp(opacity, 0.0f, 1.0f);
+            const std::size_t batchTriangleCount = (indexEnd - indexStart) / 3;
+            if (batchTriangleCount == 0) {
+                return;
+            }
 
-            for (std::size_t index = indexStart; index + 2 < indexEnd; index += 3) {
-                const std::uint32_t i0 = model.indices[index];
-                const std::uint32_t i1 = model.indices[index + 1];
-                const std::uint32_t i2 = model.indices[index + 2];
+            // The kernel is picked here, once per submesh, so the per-triangle loop has no
+            // decisions left beyond rejection.
+            const float clampedOpacity = std::clamp(opacity, 0.0f, 1.0f);
+            batches.push_back(TriangleBatch{
+                indexStart,
+                triangleCount,
+                batchTriangleCount,
+                texture,
+                clampedOpacity,
+                SelectTexturedBatchKernel(model.indicesValidated, isTransparent || clampedOpacity < 0.999f),
+                colorTextureSlot,
+                opacityTextureSlot});
+            triangleCount += batchTriangleCount;
+        };
 
-                if (i0 >= projected.size() || i1 >= projected.size() || i2 >= projected.size()) {
+        if (!model.submeshes.empty()) {
+            for (const ModelSubmesh& submesh : model.submeshes) {
+                const ModelMaterial* material = model.FindMaterial(submesh);
+                if (!material || submesh.indexCount < 3) {
                     continue;
                 }
 
-                const ProjectedVertex& p0 = projected[i0];
-                const ProjectedVertex& p1 = projected[i1];
-                const ProjectedVertex& p2 = projected[i2];
-                if (!p0.valid || !p1.valid || !p2.valid) {
+                SDL_Texture* texture = ResolveMaterialTexture(*material);
+                if (!texture) {
                     continue;
                 }
 
-                TexturedTriangle triangle{};
-                triangle.texture = texture;
-                triangle.depth = (p0.depth + p1.depth + p2.depth) / 3.0f;
-                triangle.isTransparent = isTransparent || clampedOpacity < 0.999f;
-
-                const glm::vec2& uv0 = model.texCoords[i0];
-                const glm::vec2& uv1 = model.texCoords[i1];
-                const glm::vec2& uv2 = model.texCoords[i2];
-
-                triangle.vertices[0].position = SDL_FPoint{p0.x, p0.y};
-                triangle.vertices[1].position = SDL_FPoint{p1.x, p1.y};
-                triangle.vertices[2].position = SDL_FPoint{p2.x, p2.y};
-
-                triangle.vertices[0].color = SDL_FColor{1.0f, 1.0f, 1.0f, clampedOpacity};
-                triangle.vertices[1].color = SDL_FColor{1.0f, 1.0f, 1.0f, clampedOpacity};
-                triangle.vertices[2].color = SDL_FColor{1.0f, 1.0f, 1.0f, clampedOpacity};
-
-                triangle.vertices[0].tex_coord = SDL_FPoint{1.0f - uv0.x, 1.0f - uv0.y};
-                triangle.vertices[1].tex_coord = SDL_FPoint{1.0f - uv1.x, 1.0f - uv1.y};
-                triangle.vertices[2].tex_coord = SDL_FPoint{1.0f - uv2.x, 1.0f - uv2.y};
-
-                texturedTriangles.push_back(triangle);
+                const std::size_t indexStart = static_cast<std::size_t>(submesh.indexStart);
+                const std::size_t indexEnd = indexStart + static_cast<std::size_t>(submesh.indexCount);
+                const bool materialUsesOpacityTexture = material->opacityTextureIndex >= 0;
+                const bool materialIsTransparent =
+                    material->isTransparent ||
+                    material->alphaCutoutEnabled ||
+                    materialUsesOpacityTexture ||
+                    material->opacity < 0.999f;
+                addBatch(
+                    indexStart,
+                    indexEnd,
+                    texture,
+                    material->opacity,
+                    materialIsTransparent,
+                    material->textureIndex,
+                    material->opacityTextureIndex);
             }
-        };
+        } else if (SDL_Texture* texture = GetSlotTexture(0)) {
+            addBatch(0, model.indices.size(), texture, 1.0f, false, 0, -1);
+        }
 
-        if (!model.submeshes.empty()) {
-            for (const ModelSubmesh& submesh : model.submeshes) {
-                SDL_Texture* texture = ResolveSubmeshTexture(model, submesh);
-                if (!texture || submesh.indexCount < 3) {
-                    continue;
+        // Every batch triangle gets a slot; rejected ones keep a null texture and are dropped below.
+        std::vector<TexturedTriangle>& texturedTriangles = modelPassBuffers_->texturedTriangles;
+        texturedTriangles.assign(triangleCount, TexturedTriangle{});
+        std::atomic<std::uint64_t> trianglesCulled{0};
+        std::atomic<std::uint64_t> trianglesClipped{0};
+        std::vector<BatchCoverage>& coverage = modelPassBuffers_->coverage;
+        coverage.assign(batches.size(), BatchCoverage{0.0, 0.0});
+        std::mutex coverageMutex;
+        jobs.ParallelFor(triangleCount, kTrianglesPerRange, [&](std::size_t begin, std::size_t end) {
+            TriangleRejectCounts rejected{};
+            auto batch = std::prev(std::upper_bound(
+                batches.begin(),
+                batches.end(),
+                begin,
+                [](std::size_t triangleIndex, const TriangleBatch& candidate) { return triangleIndex < candidate.firstTriangle; }));
+            for (std::size_t rangeBegin = begin; rangeBegin < end; ++batch) {
+                const std::size_t rangeEnd = std::min(end, batch->firstTriangle + batch->triangleCount);
+                batch->kernel(
+                    *batch,
+                    model,
+                    projected,
+                    outcodes,
+                    rangeBegin - batch->firstTriangle,
+                    rangeEnd - rangeBegin,
+                    texturedTriangles.data() + rangeBegin,
+                    rejected);
+
+                BatchCoverage rangeCoverage{0.0, 0.0};
+                AccumulateCoverage(texturedTriangles.data() + rangeBegin, rangeEnd - rangeBegin, rangeCoverage);
+                {
+                    std::lock_guard<std::mutex> lock(coverageMutex);
+                    BatchCoverage& batchCoverage = coverage[static_cast<std::size_t>(batch - batches.begin())];
+                    batchCoverage.screenArea += rangeCoverage.screenArea;
+                    batchCoverage.texCoordArea += rangeCoverage.texCoordArea;
                 }
+                rangeBegin = rangeEnd;
+            }
 
-                const std::size_t indexStart = static_cast<std::size_t>(submesh.indexStart);
-                const std::size_t indexEnd = indexStart + static_cast<std::size_t>(submesh.indexCount);
-                const bool submeshUsesOpacityTexture = submesh.opacityTextureIndex >= 0;
-                const bool submeshIsTransparent =
-                    submesh.isTransparent ||
-                    submesh.alphaCutoutEnabled ||
-                    submeshUsesOpacityTexture ||
-                    submesh.opacity < 0.999f;
-                appendTriangles(indexStart, indexEnd, texture, submesh.opacity, submeshIsTransparent);
+            trianglesCulled.fetch_add(rejected.culled, std::memory_order_relaxed);
+            trianglesClipped.fetch_add(rejected.clipped, std::memory_order_relaxed);
+        });
+        frameStatistics_.trianglesCulled += trianglesCulled.load();
+        frameStatistics_.trianglesClipped += trianglesClipped.load();
+
+        // What is on screen this frame decides which levels stream in for the next ones. A batch
+        // with degenerate texture coordinates asks for one texel per pixel of its extent.
+        for (std::size_t batchIndex = 0; batchIndex < batches.size(); ++batchIndex) {
+            const BatchCoverage& batchCoverage = coverage[batchIndex];
+            if (batchCoverage.screenArea <= 0.0) {
+                continue;
+            }
+
+            const double texelsPerUnit = batchCoverage.texCoordArea > 1.0e-12 ?
+                std::sqrt(batchCoverage.screenArea / batchCoverage.texCoordArea) :
+                std::sqrt(batchCoverage.screenArea);
+            const TriangleBatch& batch = batches[batchIndex];
+            textureStreamer_.RequestTexels(static_cast<std::size_t>(batch.colorTextureSlot), static_cast<float>(texelsPerUnit));
+            if (batch.opacityTextureSlot >= 0) {
+                textureStreamer_.RequestTexels(static_cast<std::size_t>(batch.opacityTextureSlot), static_cast<float>(texelsPerUnit));
             }
-        } else if (!modelTextures_.empty() && modelTextures_[0]) {
-            appendTriangles(0, model.indices.size(), modelTextures_[0], 1.0f, false);
         }
+        texturedTriangles.erase(
+            std::remove_if(
+                texturedTriangles.begin(),
+                texturedTriangles.end(),
+                [](const TexturedTriangle& triangle) { return triangle.texture == nullptr; }),
+            texturedTriangles.end());
 
         std::sort(
             texturedTriangles.begin(),
@@ -408,8 +579,48 @@ void SdlRendererBase::RenderModelWireframe(const ModelData& model, float yawDegr
                 return a.depth > b.depth;
             });
 
+        // Consecutive triangles sharing a texture after the depth sort are submitted as one batch.
+        std::vector<SDL_Vertex>& batchVertices = modelPassBuffers_->batchVertices;
+        batchVertices.clear();
+        batchVertices.reserve(std::min<std::size_t>(texturedTriangles.size(), 4096) * 3);
+        SDL_Texture* batchTexture = nullptr;
+        auto submitBatch = [&]() {
+            SDL_RenderGeometry(renderer_, batchTexture, batchVertices.data(), static_cast<int>(batchVertices.size()), nullptr, 0);
+            ++frameStatistics_.drawCalls;
+            ++frameStatistics_.textureBinds;
+            frameStatistics_.bytesUploaded += batchVertices.size() * sizeof(SDL_Vertex);
+            batchVertices.clear();
+        };
+
         for (const TexturedTriangle& triangle : texturedTriangles) {
-            SDL_RenderGeometry(renderer_, triangle.texture, triangle.vertices, 3, nullptr, 0);
+            if (triangle.texture != batchTexture && !batchVertices.empty()) {
+                submitBatch();
+            }
+
+            batchTexture = triangle.texture;
+            batchVertices.insert(batchVertices.end(), std::begin(triangle.vertices), std::end(triangle.vertices));
+        }
+
+        if (!batchVertices.empty()) {
+            submitBatch();
+        }
+        frameStatistics_.trianglesSubmitted += texturedTriangles.size();
+
+        if (overdrawVisualizationEnabled_) {
+            // Every submitted triangle is drawn without a depth test, so each one writes all of
+            // the pixels it covers, transparent texels included.
+            overdrawBuffer_.Reset(viewportWidth, viewportHeight);
+            jobs.ParallelFor(static_cast<std::size_t>(viewportHeight), kOverdrawRowsPerRange, [&](std::size_t begin, std::size_t end) {
+                for (const TexturedTriangle& triangle : texturedTriangles) {
+                    overdrawBuffer_.AddTriangle(
+                        OverdrawPoint{triangle.vertices[0].position.x, triangle.vertices[0].position.y},
+                        OverdrawPoint{triangle.vertices[1].position.x, triangle.vertices[1].position.y},
+                        OverdrawPoint{triangle.vertices[2].position.x, triangle.vertices[2].position.y},
+                        static_cast<int>(begin),
+                        static_cast<int>(end));
+                }
+            });
+            DrawOverdrawHeatmap();
         }
 
         renderedAnyTexturedGeometry = !texturedTriangles.empty();
@@ -421,134 +632,347 @@ void SdlRendererBase::RenderModelWireframe(const ModelData& model, float yawDegr
     }
 
     SDL_SetRenderDrawColor(renderer_, 176, 210, 255, 255);
-
-    const std::size_t indexCount = model.indices.size();
-    for (std::size_t index = 0; index + 2 < indexCount; index += 3) {
-        const std::uint32_t i0 = model.indices[index];
-        const std::uint32_t i1 = model.indices[index + 1];
-        const std::uint32_t i2 = model.indices[index + 2];
-
-        if (i0 >= projected.size() || i1 >= projected.size() || i2 >= projected.size()) {
-            continue;
-        }
-
-        const ProjectedVertex& p0 = projected[i0];
-        const ProjectedVertex& p1 = projected[i1];
-        const ProjectedVertex& p2 = projected[i2];
-
-        if (!p0.valid || !p1.valid || !p2.valid) {
-            continue;
-        }
-
-        SDL_RenderLine(renderer_, p0.x, p0.y, p1.x, p1.y);
-        SDL_RenderLine(renderer_, p1.x, p1.y, p2.x, p2.y);
-        SDL_RenderLine(renderer_, p2.x, p2.y, p0.x, p0.y);
+    ++frameStatistics_.pipelineStateChanges;
+
+    std::vector<SDL_FPoint>& linePoints = modelPassBuffers_->linePoints;
+    linePoints.clear();
+    linePoints.reserve(model.indices.size() * 2);
+    if (model.indicesValidated) {
+        AssembleOverlayLines<true>(model, projected, outcodes, linePoints);
+    } else {
+        AssembleOverlayLines<false>(model, projected, outcodes, linePoints);
+    }
+    for (std::size_t point = 0; point + 1 < linePoints.size(); point += 2) {
+        SDL_RenderLine(renderer_, linePoints[point].x, linePoints[point].y, linePoints[point + 1].x, linePoints[point + 1].y);
     }
+    frameStatistics_.overlayLineCount += linePoints.size() / 2;
+    frameStatistics_.drawCalls += linePoints.size() / 2;
 }
 
 void SdlRendererBase::UpdateModelTextures(const ModelData& model) {
+    ScopedFramePhase phase("UpdateModelTextures");
     if (!renderer_) {
         return;
     }
 
+    std::vector<std::size_t> previousSlots;
     if (model.texturePaths.empty()) {
         ReleaseComposedTextures();
         ReleaseModelTextures();
+        textureStreamer_.SetTextures({}, {}, previousSlots);
+        staleTexturePaths_.clear();
         return;
     }
 
-    if (modelTexturePaths_ == model.texturePaths && modelTextures_.size() == model.texturePaths.size()) {
-        return;
+    if (!placeholderTexture_) {
+        // Drawn until a texture's first level lands, so the first textured frame waits on no decode.
+        placeholderTexture_ = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, 1, 1);
+        if (placeholderTexture_) {
+            const std::uint8_t neutralGray[4] = {160, 160, 160, 255};
+            SDL_UpdateTexture(placeholderTexture_, nullptr, neutralGray, 4);
+            SDL_SetTextureBlendMode(placeholderTexture_, SDL_BLENDMODE_BLEND);
+        }
     }
 
-    ReleaseComposedTextures();
-    ReleaseModelTextures();
+    // Which slots are sampled depends only on the materials and submeshes, so it is found again
+    // only when they or the texture list change.
+    const TextureNeedsSource needsSource{model.materials.data(), model.materials.size(), model.submeshes.data(), model.submeshes.size()};
+    const bool pathsChanged = modelTexturePaths_ != model.texturePaths || modelTextures_.size() != model.texturePaths.size();
+    if (pathsChanged || !SourcesEqual(modelTexturesNeededSource_, needsSource)) {
+        std::vector<bool> texturesNeeded = FindTexturesForChannels(model, kSampledMaterialChannels);
+        if (pathsChanged || modelTexturesNeeded_ != texturesNeeded) {
+            // Keep every texture the streamer carries over; slots only reached through channels
+            // this backend does not sample stay empty. Composed textures are keyed by index, so
+            // they are rebuilt.
+            ReleaseComposedTextures();
+            textureStreamer_.SetTextures(model.texturePaths, texturesNeeded, previousSlots);
+
+            std::vector<SDL_Texture*> textures(model.texturePaths.size(), nullptr);
+            std::vector<SDL_Surface*> surfaces(model.texturePaths.size(), nullptr);
+            std::vector<std::string> lostTexturePaths;
+            for (std::size_t slot = 0; slot < model.texturePaths.size(); ++slot) {
+                const std::size_t previous = previousSlots[slot];
+                if (previous >= modelTextures_.size()) {
+                    if (textureStreamer_.GetResidentLevel(slot) != TextureStreamer::kNoLevel) {
+                        lostTexturePaths.push_back(model.texturePaths[slot]);
+                    }
+                    continue;
+                }
 
-    modelTextures_.reserve(model.texturePaths.size());
-    modelTextureSurfaces_.reserve(model.texturePaths.size());
-    modelTexturePaths_.reserve(model.texturePaths.size());
+                textures[slot] = std::exchange(modelTextures_[previous], nullptr);
+                surfaces[slot] = std::exchange(modelTextureSurfaces_[previous], nullptr);
+            }
 
-    for (const std::string& texturePath : model.texturePaths) {
-        SDL_Surface* surface = nullptr;
-#if defined(_WIN32)
-        surface = LoadSurfaceWithWic(texturePath);
-#endif
+            ReleaseModelTextures();
+            modelTextures_ = std::move(textures);
+            modelTextureSurfaces_ = std::move(surfaces);
+            modelTexturePaths_ = model.texturePaths;
+            modelTexturesNeeded_ = std::move(texturesNeeded);
+            staleTexturePaths_.insert(staleTexturePaths_.end(), lostTexturePaths.begin(), lostTexturePaths.end());
+        }
+        modelTexturesNeededSource_ = needsSource;
+    }
+
+    if (!staleTexturePaths_.empty()) {
+        textureStreamer_.InvalidateTextures(staleTexturePaths_);
+        staleTexturePaths_.clear();
+    }
 
-        if (!surface) {
-            surface = SDL_LoadBMP(texturePath.c_str());
+    // Decodes finished since the last frame are swapped in here, before anything is drawn, so a
+    // frame never mixes two levels of one texture.
+    textureStreamer_.Update(textureStreamUpdates_);
+    for (const TextureStreamUpdate& update : textureStreamUpdates_) {
+        if (update.slot >= modelTextures_.size()) {
+            continue;
         }
 
-        SDL_Texture* texture = nullptr;
-        if (surface) {
-            SDL_Surface* rgbaSurface = SDL_ConvertSurface(surface, SDL_PIXELFORMAT_RGBA32);
-            if (rgbaSurface) {
-                SDL_DestroySurface(surface);
-                surface = rgbaSurface;
-            }
+        if (modelTextures_[update.slot]) {
+            SDL_DestroyTexture(modelTextures_[update.slot]);
+        }
+        if (modelTextureSurfaces_[update.slot]) {
+            SDL_DestroySurface(modelTextureSurfaces_[update.slot]);
+        }
+        CreateModelTexture(update.image, modelTextures_[update.slot], modelTextureSurfaces_[update.slot]);
+        ReleaseComposedTexturesUsing(update.slot);
+    }
+    textureStreamUpdates_.clear();
 
-            texture = SDL_CreateTextureFromSurface(renderer_, surface);
+    const TextureStreamerStatistics streaming = textureStreamer_.GetStatistics();
+    frameStatistics_.textureBytesResident = streaming.residentBytes;
+    frameStatistics_.textureDecodesPending = streaming.pendingDecodeCount;
+    frameStatistics_.texturesAtPlaceholder = streaming.placeholderCount;
+}
+
+void SdlRendererBase::CreateModelTexture(const DecodedImage& decodedImage, SDL_Texture*& outTexture, SDL_Surface*& outSurface) {
+    outTexture = nullptr;
+    outSurface = nullptr;
+
+    if (decodedImage.width > 0 && decodedImage.height > 0) {
+        outSurface = SDL_CreateSurface(
+            static_cast<int>(decodedImage.width),
+            static_cast<int>(decodedImage.height),
+            SDL_PIXELFORMAT_RGBA32);
+    }
+
+    if (outSurface && outSurface->pixels) {
+        const std::size_t rowBytes = static_cast<std::size_t>(decodedImage.width) * 4;
+        for (std::uint32_t row = 0; row < decodedImage.height; ++row) {
+            std::memcpy(
+                static_cast<std::uint8_t*>(outSurface->pixels) + static_cast<std::size_t>(row) * static_cast<std::size_t>(outSurface->pitch),
+                decodedImage.pixels.data() + static_cast<std::size_t>(row) * rowBytes,
+                rowBytes);
         }
 
-        if (texture) {
-            SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+        outTexture = SDL_CreateTextureFromSurface(renderer_, outSurface);
+        frameStatistics_.bytesUploaded += decodedImage.pixels.size();
+    }
+
+    if (outTexture) {
+        SDL_SetTextureBlendMode(outTexture, SDL_BLENDMODE_BLEND);
+    }
+}
+
+void SdlRendererBase::InvalidateModelTextures(const std::vector<std::string>& texturePaths) {
+    staleTexturePaths_.insert(staleTexturePaths_.end(), texturePaths.begin(), texturePaths.end());
+}
+
+void SdlRendererBase::SetRenderScale(float scale) noexcept {
+    renderScale_ = std::isfinite(scale) ? std::clamp(scale, 0.05f, 1.0f) : 1.0f;
+}
+
+void SdlRendererBase::SetOverdrawVisualization(bool enabled) noexcept {
+    overdrawVisualizationEnabled_ = enabled;
+    if (!enabled) {
+        ReleaseOverdrawTexture();
+        overdrawBuffer_.Reset(0, 0);
+        overdrawPixels_ = {};
+    }
+}
+
+void SdlRendererBase::DrawOverdrawHeatmap() {
+    const OverdrawStatistics overdraw = overdrawBuffer_.ComputeStatistics();
+    frameStatistics_.shadedPixels += overdraw.shadedPixels;
+    frameStatistics_.coveredPixels += overdraw.coveredPixels;
+    frameStatistics_.maxOverdraw = std::max<std::uint64_t>(frameStatistics_.maxOverdraw, overdraw.maxOverdraw);
+
+    const int width = overdrawBuffer_.GetWidth();
+    const int height = overdrawBuffer_.GetHeight();
+    if (!overdrawTexture_ || overdrawTextureWidth_ != width || overdrawTextureHeight_ != height) {
+        ReleaseOverdrawTexture();
+        overdrawTexture_ = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STREAMING, width, height);
+        if (!overdrawTexture_) {
+            LogWarning(LogCategory::Renderer, "Could not create a %dx%d overdraw heatmap: %s", width, height, SDL_GetError());
+            return;
+        }
+
+        SDL_SetTextureBlendMode(overdrawTexture_, SDL_BLENDMODE_NONE);
+        SDL_SetTextureScaleMode(overdrawTexture_, SDL_SCALEMODE_NEAREST);
+        overdrawTextureWidth_ = width;
+        overdrawTextureHeight_ = height;
+    }
+
+    overdrawBuffer_.WriteHeatmap(overdrawPixels_);
+    SDL_UpdateTexture(overdrawTexture_, nullptr, overdrawPixels_.data(), width * 4);
+    const SDL_FRect destinationRect{0.0f, 0.0f, static_cast<float>(width), static_cast<float>(height)};
+    SDL_RenderTexture(renderer_, overdrawTexture_, nullptr, &destinationRect);
+    frameStatistics_.bytesUploaded += overdrawPixels_.size();
+    ++frameStatistics_.drawCalls;
+    ++frameStatistics_.textureBinds;
+}
+
+void SdlRendererBase::SetPointCloudPreview(std::shared_ptr<const PointCloudPreview> preview) {
+    pointCloudPreview_ = std::move(preview);
+    if (!pointCloudPreview_) {
+        ReleaseSplatTexture();
+        splatBuffer_.Reset(0, 0);
+        splatPixels_ = {};
+    }
+}
+
+void SdlRendererBase::DrawPointCloudPreview(const glm::mat4& modelViewProjection, int viewportWidth, int viewportHeight) {
+    splatBuffer_.Reset(viewportWidth, viewportHeight);
+    frameStatistics_.previewSplats += SplatPointCloudPreview(*pointCloudPreview_, modelViewProjection, splatBuffer_);
+    frameStatistics_.verticesProjected += pointCloudPreview_->points.size();
+
+    if (!splatTexture_ || splatTextureWidth_ != viewportWidth || splatTextureHeight_ != viewportHeight) {
+        ReleaseSplatTexture();
+        splatTexture_ = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STREAMING, viewportWidth, viewportHeight);
+        if (!splatTexture_) {
+            LogWarning(LogCategory::Renderer, "Could not create a %dx%d splat target: %s", viewportWidth, viewportHeight, SDL_GetError());
+            return;
         }
 
-        modelTextures_.push_back(texture);
-        modelTextureSurfaces_.push_back(surface);
-        modelTexturePaths_.push_back(texturePath);
+        SDL_SetTextureBlendMode(splatTexture_, SDL_BLENDMODE_BLEND);
+        SDL_SetTextureScaleMode(splatTexture_, SDL_SCALEMODE_NEAREST);
+        splatTextureWidth_ = viewportWidth;
+        splatTextureHeight_ = viewportHeight;
     }
+
+    splatBuffer_.WriteRgba(splatPixels_);
+    SDL_UpdateTexture(splatTexture_, nullptr, splatPixels_.data(), viewportWidth * 4);
+    const SDL_FRect destinationRect{0.0f, 0.0f, static_cast<float>(viewportWidth), static_cast<float>(viewportHeight)};
+    SDL_RenderTexture(renderer_, splatTexture_, nullptr, &destinationRect);
+    frameStatistics_.bytesUploaded += splatPixels_.size();
+    ++frameStatistics_.drawCalls;
+    ++frameStatistics_.textureBinds;
 }
 
-SDL_Texture* SdlRendererBase::ResolveSubmeshTexture(const ModelData&, const ModelSubmesh& submesh) {
-    if (submesh.textureIndex < 0 || static_cast<std::size_t>(submesh.textureIndex) >= modelTextures_.size()) {
+void SdlRendererBase::ReleaseSplatTexture() noexcept {
+    if (splatTexture_) {
+        SDL_DestroyTexture(splatTexture_);
+        splatTexture_ = nullptr;
+    }
+    splatTextureWidth_ = 0;
+    splatTextureHeight_ = 0;
+}
+
+void SdlRendererBase::ReleaseOverdrawTexture() noexcept {
+    if (overdrawTexture_) {
+        SDL_DestroyTexture(overdrawTexture_);
+        overdrawTexture_ = nullptr;
+    }
+    overdrawTextureWidth_ = 0;
+    overdrawTextureHeight_ = 0;
+}
+
+bool SdlRendererBase::EnsureSceneTarget(int width, int height) {
+    if (sceneTarget_ && sceneTargetWidth_ == width && sceneTargetHeight_ == height) {
+        return true;
+    }
+
+    ReleaseSceneTarget();
+    sceneTarget_ = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET, width, height);
+    if (!sceneTarget_) {
+        LogWarning(LogCategory::Renderer, "Could not create a %dx%d scene target; rendering at full resolution: %s", width, height, SDL_GetError());
+        renderScale_ = 1.0f;
+        return false;
+    }
+
+    SDL_SetTextureScaleMode(sceneTarget_, SDL_SCALEMODE_LINEAR);
+    sceneTargetWidth_ = width;
+    sceneTargetHeight_ = height;
+    return true;
+}
+
+void SdlRendererBase::ReleaseSceneTarget() noexcept {
+    if (sceneTarget_) {
+        SDL_DestroyTexture(sceneTarget_);
+        sceneTarget_ = nullptr;
+    }
+    sceneTargetWidth_ = 0;
+    sceneTargetHeight_ = 0;
+}
+
+SDL_Texture* SdlRendererBase::GetSlotTexture(std::int32_t slot) const noexcept {
+    if (slot < 0 || static_cast<std::size_t>(slot) >= modelTextures_.size()) {
+        return nullptr;
+    }
+
+    const std::size_t index = static_cast<std::size_t>(slot);
+    if (modelTextures_[index]) {
+        return modelTextures_[index];
+    }
+    const bool awaitingFirstLevel = index < modelTexturesNeeded_.size() && modelTexturesNeeded_[index] &&
+        !textureStreamer_.HasFailed(index);
+    return awaitingFirstLevel ? placeholderTexture_ : nullptr;
+}
+
+SDL_Texture* SdlRendererBase::ResolveMaterialTexture(const ModelMaterial& material) {
+    SDL_Texture* colorTexture = GetSlotTexture(material.textureIndex);
+    if (!colorTexture) {
         return nullptr;
     }
 
     const bool needsComposedTexture =
-        submesh.opacityTextureIndex >= 0 ||
-        submesh.alphaCutoutEnabled ||
-        submesh.opacityTextureInverted ||
-        submesh.opacity < 0.999f;
-    if (!needsComposedTexture) {
-        return modelTextures_[static_cast<std::size_t>(submesh.textureIndex)];
+        material.opacityTextureIndex >= 0 ||
+        material.alphaCutoutEnabled ||
+        material.opacityTextureInverted ||
+        material.opacity < 0.999f;
+    // Composing waits for the color texture's first level; the opacity texture joins when it lands.
+    if (!needsComposedTexture || !modelTextureSurfaces_[static_cast<std::size_t>(material.textureIndex)]) {
+        return colorTexture;
     }
 
     const ComposedTextureKey key{
-        submesh.textureIndex,
-        submesh.opacityTextureIndex,
-        std::bit_cast<std::uint32_t>(std::clamp(submesh.opacity, 0.0f, 1.0f)),
-        std::bit_cast<std::uint32_t>(std::clamp(submesh.alphaCutoff, 0.0f, 1.0f)),
-        submesh.alphaCutoutEnabled,
-        submesh.opacityTextureInverted};
+        material.textureIndex,
+        material.opacityTextureIndex,
+        std::bit_cast<std::uint32_t>(std::clamp(material.opacity, 0.0f, 1.0f)),
+        std::bit_cast<std::uint32_t>(std::clamp(material.alphaCutoff, 0.0f, 1.0f)),
+        material.alphaCutoutEnabled,
+        material.opacityTextureInverted};
 
     for (const ComposedTextureEntry& entry : composedTextures_) {
         if (entry.texture && KeysEqual(entry.key, key)) {
+            ++frameStatistics_.composedTextureCacheHits;
             return entry.texture;
         }
     }
 
-    SDL_Texture* composedTexture = CreateComposedTexture(submesh);
+    ++frameStatistics_.composedTextureCacheMisses;
+
+    SDL_Texture* composedTexture = CreateComposedTexture(material);
     if (!composedTexture) {
-        return modelTextures_[static_cast<std::size_t>(submesh.textureIndex)];
+        return colorTexture;
     }
 
     composedTextures_.push_back(ComposedTextureEntry{key, composedTexture});
     return composedTexture;
 }
 
-SDL_Texture* SdlRendererBase::CreateComposedTexture(const ModelSubmesh& submesh) {
-    if (!renderer_ || submesh.textureIndex < 0 || static_cast<std::size_t>(submesh.textureIndex) >= modelTextureSurfaces_.size()) {
+SDL_Texture* SdlRendererBase::CreateComposedTexture(const ModelMaterial& material) {
+    ScopedFramePhase phase("CreateComposedTexture");
+    if (!renderer_ || material.textureIndex < 0 || static_cast<std::size_t>(material.textureIndex) >= modelTextureSurfaces_.size()) {
         return nullptr;
     }
 
-    SDL_Surface* colorSurface = modelTextureSurfaces_[static_cast<std::size_t>(submesh.textureIndex)];
+    SDL_Surface* colorSurface = modelTextureSurfaces_[static_cast<std::size_t>(material.textureIndex)];
     if (!colorSurface || !colorSurface->pixels || colorSurface->w <= 0 || colorSurface->h <= 0) {
         return nullptr;
     }
 
     const SDL_Surface* opacitySurface = nullptr;
-    if (submesh.opacityTextureIndex >= 0 && static_cast<std::size_t>(submesh.opacityTextureIndex) < modelTextureSurfaces_.size()) {
-        opacitySurface = modelTextureSurfaces_[static_cast<std::size_t>(submesh.opacityTextureIndex)];
+    if (material.opacityTextureIndex >= 0 && static_cast<std::size_t>(material.opacityTextureIndex) < modelTextureSurfaces_.size()) {
+        opacitySurface = modelTextureSurfaces_[static_cast<std::size_t>(material.opacityTextureIndex)];
     }
 
     SDL_Surface* composedSurface = SDL_CreateSurface(colorSurface->w, colorSurface->h, SDL_PIXELFORMAT_RGBA32);
@@ -559,8 +983,8 @@ SDL_Texture* SdlRendererBase::CreateComposedTexture(const ModelSubmesh& submesh)
         return nullptr;
     }
 
-    const float clampedOpacity = std::clamp(submesh.opacity, 0.0f, 1.0f);
-    const float clampedCutoff = std::clamp(submesh.alphaCutoff, 0.0f, 1.0f);
+    const float clampedOpacity = std::clamp(material.opacity, 0.0f, 1.0f);
+    const float clampedCutoff = std::clamp(material.alphaCutoff, 0.0f, 1.0f);
 
     for (int y = 0; y < colorSurface->h; ++y) {
         std::uint8_t* dstRow = static_cast<std::uint8_t*>(composedSurface->pixels) + (y * composedSurface->pitch);
@@ -573,13 +997,13 @@ SDL_Texture* SdlRendererBase::CreateComposedTexture(const ModelSubmesh& submesh)
             float opacitySample = opacitySurface ?
                 static_cast<float>(SampleSurfaceChannelNearest(opacitySurface, opacityX, opacityY, 0)) / 255.0f :
                 1.0f;
-            if (submesh.opacityTextureInverted) {
+            if (material.opacityTextureInverted) {
                 opacitySample = 1.0f - opacitySample;
             }
 
             const float colorAlpha = static_cast<float>(srcPixel[3]) / 255.0f;
             float finalAlpha = std::clamp(colorAlpha * clampedOpacity * std::clamp(opacitySample, 0.0f, 1.0f), 0.0f, 1.0f);
-            if (submesh.alphaCutoutEnabled && finalAlpha < clampedCutoff) {
+            if (material.alphaCutoutEnabled && finalAlpha < clampedCutoff) {
                 finalAlpha = 0.0f;
             }
 
@@ -592,6 +1016,7 @@ SDL_Texture* SdlRendererBase::CreateComposedTexture(const ModelSubmesh& submesh)
     }
 
     SDL_Texture* composedTexture = SDL_CreateTextureFromSurface(renderer_, composedSurface);
+    frameStatistics_.bytesUploaded += static_cast<std::uint64_t>(composedSurface->w) * static_cast<std::uint64_t>(composedSurface->h) * 4;
     SDL_DestroySurface(composedSurface);
     if (!composedTexture) {
         return nullptr;
@@ -611,6 +1036,22 @@ void SdlRendererBase::ReleaseComposedTextures() noexcept {
     composedTextures_.clear();
 }
 
+void SdlRendererBase::ReleaseComposedTexturesUsing(std::size_t slot) noexcept {
+    const auto usesSlot = [slot](const ComposedTextureEntry& entry) {
+        return static_cast<std::size_t>(entry.key.colorTextureIndex) == slot ||
+            (entry.key.opacityTextureIndex >= 0 && static_cast<std::size_t>(entry.key.opacityTextureIndex) == slot);
+    };
+    for (ComposedTextureEntry& entry : composedTextures_) {
+        if (entry.texture && usesSlot(entry)) {
+            SDL_DestroyTexture(entry.texture);
+            entry.texture = nullptr;
+        }
+    }
+    composedTextures_.erase(
+        std::remove_if(composedTextures_.begin(), composedTextures_.end(), [](const ComposedTextureEntry& entry) { return !entry.texture; }),
+        composedTextures_.end());
+}
+
 void SdlRendererBase::ReleaseModelTextures() noexcept {
     for (SDL_Texture* texture : modelTextures_) {
         if (texture) {
@@ -626,6 +1067,12 @@ void SdlRendererBase::ReleaseModelTextures() noexcept {
     }
     modelTextureSurfaces_.clear();
     modelTexturePaths_.clear();
+    modelTexturesNeeded_.clear();
+    modelTexturesNeededSource_ = TextureNeedsSource{};
+}
+
+MaterialChannelMask SdlRendererBase::GetSampledMaterialChannels() const noexcept {
+    return kSampledMaterialChannels;
 }
 
 SDL_Renderer* SdlRendererBase::GetNativeRenderer() const noexcept {
@@ -635,4 +1082,8 @@ SDL_Renderer* SdlRendererBase::GetNativeRenderer() const noexcept {
 const char* SdlRendererBase::GetName() const noexcept {
     return displayName_;
 }
+
+RendererFrameStatistics SdlRendererBase::GetFrameStatistics() const noexcept {
+    return frameStatistics_;
+}
 }
@@ -1,10 +1,17 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "Engine/ModelCamera.hpp"
 #include "Engine/ModelData.hpp"
+#include "Engine/OverdrawBuffer.hpp"
+#include "Engine/PointCloudPreview.hpp"
+#include "Engine/RendererStatistics.hpp"
+#include "Engine/TextureStreamer.hpp"
 
 struct SDL_Renderer;
 struct SDL_Surface;
@@ -23,10 +30,16 @@ public:
     void BeginFrame();
     void EndFrame();
 
-    void RenderModelWireframe(const ModelData& model, float yawDegrees, float pitchDegrees, float rollDegrees, float cameraDistance, bool wireOverlayEnabled);
+    void RenderModelWireframe(const ModelData& model, const CameraLatch& latchCamera, bool wireOverlayEnabled);
+    void InvalidateModelTextures(const std::vector<std::string>& texturePaths);
+    void SetRenderScale(float scale) noexcept;
+    void SetOverdrawVisualization(bool enabled) noexcept;
+    void SetPointCloudPreview(std::shared_ptr<const PointCloudPreview> preview);
 
+    [[nodiscard]] MaterialChannelMask GetSampledMaterialChannels() const noexcept;
     [[nodiscard]] SDL_Renderer* GetNativeRenderer() const noexcept;
     [[nodiscard]] const char* GetName() const noexcept;
+    [[nodiscard]] RendererFrameStatistics GetFrameStatistics() const noexcept;
 
 private:
     struct ComposedTextureKey {
@@ -43,11 +56,37 @@ private:
         SDL_Texture* texture;
     };
 
+    // The arrays modelTexturesNeeded_ was computed from. Loading or reloading a model replaces
+    // them, so a change of address or size means the sampled slots must be found again.
+    struct TextureNeedsSource {
+        const ModelMaterial* materials;
+        std::size_t materialCount;
+        const ModelSubmesh* submeshes;
+        std::size_t submeshCount;
+    };
+
+    struct ModelPassBuffers;
+
+    static bool SourcesEqual(const TextureNeedsSource& left, const TextureNeedsSource& right) noexcept;
     static bool KeysEqual(const ComposedTextureKey& left, const ComposedTextureKey& right) noexcept;
+    void RenderModelPass(const ModelData& model, const CameraLatch& latchCamera, bool wireOverlayEnabled, int viewportWidth, int viewportHeight);
+    bool EnsureSceneTarget(int width, int height);
+    void ReleaseSceneTarget() noexcept;
+    // Records the counters from overdrawBuffer_ and draws its heatmap over the model pass viewport.
+    void DrawOverdrawHeatmap();
+    void ReleaseOverdrawTexture() noexcept;
+    // Splats the point-cloud preview into splatBuffer_ and draws it over the model pass viewport.
+    void DrawPointCloudPreview(const glm::mat4& modelViewProjection, int viewportWidth, int viewportHeight);
+    void ReleaseSplatTexture() noexcept;
     void UpdateModelTextures(const ModelData& model);
-    SDL_Texture* ResolveSubmeshTexture(const ModelData& model, const ModelSubmesh& submesh);
-    SDL_Texture* CreateComposedTexture(const ModelSubmesh& submesh);
+    void CreateModelTexture(const DecodedImage& decodedImage, SDL_Texture*& outTexture, SDL_Surface*& outSurface);
+    // The streamed texture in `slot`, the shared placeholder until its first level lands, or null
+    // when the slot is unused or failed to decode.
+    [[nodiscard]] SDL_Texture* GetSlotTexture(std::int32_t slot) const noexcept;
+    SDL_Texture* ResolveMaterialTexture(const ModelMaterial& material);
+    SDL_Texture* CreateComposedTexture(const ModelMaterial& material);
     void ReleaseComposedTextures() noexcept;
+    void ReleaseComposedTexturesUsing(std::size_t slot) noexcept;
     void ReleaseModelTextures() noexcept;
 
     const char* rendererHint_;
@@ -56,7 +95,33 @@ private:
     std::vector<SDL_Texture*> modelTextures_;
     std::vector<SDL_Surface*> modelTextureSurfaces_;
     std::vector<std::string> modelTexturePaths_;
+    // Slots decoded for the current model; the rest are deferred until a sampled channel reaches them.
+    std::vector<bool> modelTexturesNeeded_;
+    TextureNeedsSource modelTexturesNeededSource_;
+    std::vector<std::string> staleTexturePaths_;
+    TextureStreamer textureStreamer_;
+    std::vector<TextureStreamUpdate> textureStreamUpdates_;
+    SDL_Texture* placeholderTexture_;
     std::vector<ComposedTextureEntry> composedTextures_;
+    std::unique_ptr<ModelPassBuffers> modelPassBuffers_;
+    RendererFrameStatistics frameStatistics_;
+    float renderScale_;
+    SDL_Texture* sceneTarget_;
+    int sceneTargetWidth_;
+    int sceneTargetHeight_;
+    bool overdrawVisualizationEnabled_;
+    OverdrawBuffer overdrawBuffer_;
+    std::vector<std::uint8_t> overdrawPixels_;
+    SDL_Texture* overdrawTexture_;
+    int overdrawTextureWidth_;
+    int overdrawTextureHeight_;
+    std::shared_ptr<const PointCloudPreview> pointCloudPreview_;
+    CameraMotionTracker cameraMotion_;
+    SplatBuffer splatBuffer_;
+    std::vector<std::uint8_t> splatPixels_;
+    SDL_Texture* splatTexture_;
+    int splatTextureWidth_;
+    int splatTextureHeight_;
 #if defined(_WIN32)
     bool comInitialized_;
 #endif
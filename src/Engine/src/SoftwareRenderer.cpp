@@ -1,5 +1,7 @@
 #include "Engine/SoftwareRenderer.hpp"
 
+#include <utility>
+
 #include "SdlRendererBase.hpp"
 
 namespace engine {
@@ -24,8 +26,28 @@ void SoftwareRenderer::EndFrame() {
     impl_->EndFrame();
 }
 
-void SoftwareRenderer::RenderModelWireframe(const ModelData& model, float yawDegrees, float pitchDegrees, float rollDegrees, float cameraDistance, bool wireOverlayEnabled) {
-    impl_->RenderModelWireframe(model, yawDegrees, pitchDegrees, rollDegrees, cameraDistance, wireOverlayEnabled);
+void SoftwareRenderer::RenderModelWireframe(const ModelData& model, const CameraLatch& latchCamera, bool wireOverlayEnabled) {
+    impl_->RenderModelWireframe(model, latchCamera, wireOverlayEnabled);
+}
+
+void SoftwareRenderer::InvalidateModelTextures(const std::vector<std::string>& texturePaths) {
+    impl_->InvalidateModelTextures(texturePaths);
+}
+
+void SoftwareRenderer::SetRenderScale(float scale) {
+    impl_->SetRenderScale(scale);
+}
+
+void SoftwareRenderer::SetOverdrawVisualization(bool enabled) {
+    impl_->SetOverdrawVisualization(enabled);
+}
+
+void SoftwareRenderer::SetPointCloudPreview(std::shared_ptr<const PointCloudPreview> preview) {
+    impl_->SetPointCloudPreview(std::move(preview));
+}
+
+MaterialChannelMask SoftwareRenderer::GetSampledMaterialChannels() const noexcept {
+    return impl_->GetSampledMaterialChannels();
 }
 
 SDL_Renderer* SoftwareRenderer::GetNativeRenderer() const noexcept {
@@ -35,4 +57,8 @@ SDL_Renderer* SoftwareRenderer::GetNativeRenderer() const noexcept {
 const char* SoftwareRenderer::GetName() const noexcept {
     return impl_->GetName();
 }
+
+RendererFrameStatistics SoftwareRenderer::GetFrameStatistics() const noexcept {
+    return impl_->GetFrameStatistics();
+}
 }
@@ -0,0 +1,18 @@
+#include "Engine/Task.hpp"
+
+namespace engine {
+Task<FileReadResult> ReadFileAsync(JobSystem& jobs, std::filesystem::path path) {
+    std::vector<std::filesystem::path> paths;
+    paths.push_back(std::move(path));
+    std::vector<FileReadResult> files = co_await ReadFilesAsync(jobs, std::move(paths));
+    co_return std::move(files.front());
+}
+
+Task<std::vector<FileReadResult>> ReadFilesAsync(JobSystem& jobs, std::vector<std::filesystem::path> paths) {
+    co_await ResumeOnWorker{jobs};
+
+    std::vector<FileReadResult> files;
+    ReadFileBatch(jobs, paths, files);
+    co_return files;
+}
+}
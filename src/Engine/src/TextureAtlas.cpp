@@ -0,0 +1,500 @@
+#include "Engine/TextureAtlas.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <limits>
+#include <map>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Engine/BatchFileReader.hpp"
+#include "Engine/JobSystem.hpp"
+#include "Engine/MorphTargets.hpp"
+#include "ImageCodec.hpp"
+
+namespace engine {
+namespace {
+constexpr float kUvTolerance = 1.0e-4f;
+constexpr std::uint32_t kRectAlignment = 4;
+constexpr std::size_t kNoEntry = std::numeric_limits<std::size_t>::max();
+constexpr std::uint32_t kUnassignedVertex = std::numeric_limits<std::uint32_t>::max();
+constexpr std::uint32_t kOriginalVertex = std::numeric_limits<std::uint32_t>::max() - 1;
+
+// Atlases are split by category so that opaque textures never share a page with translucent ones
+// (which would force the whole page onto the transparent path) and so opacity pages stay paired.
+constexpr std::uint32_t kCategoryHasOpacityTexture = 1u;
+constexpr std::uint32_t kCategoryTranslucentColor = 2u;
+
+struct AtlasEntry {
+    std::int32_t colorTextureIndex;
+    std::int32_t opacityTextureIndex;
+    const DecodedImage* colorImage;
+    const DecodedImage* opacityImage;
+    std::uint32_t category;
+    std::size_t page;
+    std::uint32_t x;
+    std::uint32_t y;
+};
+
+struct AtlasPage {
+    std::uint32_t category;
+    std::uint32_t width;
+    std::uint32_t height;
+    std::uint32_t shelfY;
+    std::uint32_t shelfHeight;
+    std::uint32_t cursorX;
+};
+
+std::uint32_t AlignUp(std::uint32_t value, std::uint32_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+bool HasTranslucentTexels(const DecodedImage& image) {
+    for (std::size_t offset = 3; offset < image.pixels.size(); offset += 4) {
+        if (image.pixels[offset] < 250) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Copies source scaled to targetWidth x targetHeight (nearest) into page at (x, y), extending edge
+// texels into the surrounding gutter.
+void BlitWithGutter(
+    const DecodedImage& source,
+    std::uint32_t targetWidth,
+    std::uint32_t targetHeight,
+    std::uint32_t gutter,
+    std::uint32_t x,
+    std::uint32_t y,
+    DecodedImage& page) {
+    const std::int64_t gutterSize = static_cast<std::int64_t>(gutter);
+    for (std::int64_t row = -gutterSize; row < static_cast<std::int64_t>(targetHeight) + gutterSize; ++row) {
+        const std::uint32_t clampedRow = static_cast<std::uint32_t>(std::clamp<std::int64_t>(row, 0, targetHeight - 1));
+        const std::uint32_t sourceRow = static_cast<std::uint32_t>(
+            static_cast<std::uint64_t>(clampedRow) * source.height / targetHeight);
+        const std::size_t pageRow = static_cast<std::size_t>(static_cast<std::int64_t>(y) + row);
+        for (std::int64_t column = -gutterSize; column < static_cast<std::int64_t>(targetWidth) + gutterSize; ++column) {
+            const std::uint32_t clampedColumn = static_cast<std::uint32_t>(std::clamp<std::int64_t>(column, 0, targetWidth - 1));
+            const std::uint32_t sourceColumn = static_cast<std::uint32_t>(
+                static_cast<std::uint64_t>(clampedColumn) * source.width / targetWidth);
+            const std::size_t pageColumn = static_cast<std::size_t>(static_cast<std::int64_t>(x) + column);
+
+            const std::size_t sourceOffset = (static_cast<std::size_t>(sourceRow) * source.width + sourceColumn) * 4;
+            const std::size_t pageOffset = (pageRow * page.width + pageColumn) * 4;
+            std::copy_n(source.pixels.begin() + static_cast<std::ptrdiff_t>(sourceOffset), 4, page.pixels.begin() + static_cast<std::ptrdiff_t>(pageOffset));
+        }
+    }
+}
+
+std::string HashPixels(const DecodedImage& image) {
+    std::uint64_t hash = 14695981039346656037ull;
+    for (const std::uint8_t value : image.pixels) {
+        hash ^= value;
+        hash *= 1099511628211ull;
+    }
+    hash ^= (static_cast<std::uint64_t>(image.width) << 32) | image.height;
+
+    char buffer[17] = {};
+    std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(hash));
+    return buffer;
+}
+
+// Renderers sample at (1 - u, 1 - v), so the remap works on flipped coordinates.
+glm::vec2 RemapTexCoord(const glm::vec2& uv, const AtlasEntry& entry, const AtlasPage& page) {
+    const float flippedU = 1.0f - std::clamp(uv.x, 0.0f, 1.0f);
+    const float flippedV = 1.0f - std::clamp(uv.y, 0.0f, 1.0f);
+    const float atlasX = static_cast<float>(entry.x) + flippedU * static_cast<float>(entry.colorImage->width);
+    const float atlasY = static_cast<float>(entry.y) + flippedV * static_cast<float>(entry.colorImage->height);
+    return {1.0f - atlasX / static_cast<float>(page.width), 1.0f - atlasY / static_cast<float>(page.height)};
+}
+}
+
+bool BuildTextureAtlases(
+    ModelData& model,
+    const TextureAtlasOptions& options,
+    TextureAtlasStats& outStats,
+    std::string& outError) {
+    outStats = {};
+    if (model.materials.empty() || model.submeshes.empty() || model.texCoords.size() != model.positions.size()) {
+        return true;
+    }
+
+    if (options.outputDirectory.empty() || options.maxAtlasSize <= 2 * options.gutterTexels) {
+        outError = "Texture atlas options require an output directory and a maximum size larger than the gutters.";
+        return false;
+    }
+
+    const std::uint32_t gutter = options.gutterTexels;
+    const std::uint32_t maxAtlasSize = options.maxAtlasSize;
+
+    std::vector<bool> materialUsed(model.materials.size(), false);
+    std::vector<bool> materialWraps(model.materials.size(), false);
+    for (const ModelSubmesh& submesh : model.submeshes) {
+        if (submesh.materialIndex >= model.materials.size()) {
+            continue;
+        }
+
+        materialUsed[submesh.materialIndex] = true;
+        const std::size_t indexStart = std::min<std::size_t>(submesh.indexStart, model.indices.size());
+        const std::size_t indexEnd = std::min<std::size_t>(indexStart + submesh.indexCount, model.indices.size());
+        for (std::size_t index = indexStart; index < indexEnd && !materialWraps[submesh.materialIndex]; ++index) {
+            const std::uint32_t vertex = model.indices[index];
+            if (vertex >= model.texCoords.size()) {
+                continue;
+            }
+
+            const glm::vec2& uv = model.texCoords[vertex];
+            if (uv.x < -kUvTolerance || uv.x > 1.0f + kUvTolerance || uv.y < -kUvTolerance || uv.y > 1.0f + kUvTolerance) {
+                materialWraps[submesh.materialIndex] = true;
+            }
+        }
+    }
+
+    // Every texture a packable material needs is decoded up front, in parallel on the job system.
+    std::vector<bool> textureNeeded(model.texturePaths.size(), false);
+    auto markTexture = [&](std::int32_t textureIndex) {
+        if (textureIndex >= 0 && static_cast<std::size_t>(textureIndex) < textureNeeded.size()) {
+            textureNeeded[static_cast<std::size_t>(textureIndex)] = true;
+        }
+    };
+    for (std::size_t materialIndex = 0; materialIndex < model.materials.size(); ++materialIndex) {
+        if (materialUsed[materialIndex] && !materialWraps[materialIndex] && model.materials[materialIndex].textureIndex >= 0) {
+            markTexture(model.materials[materialIndex].textureIndex);
+            markTexture(model.materials[materialIndex].opacityTextureIndex);
+        }
+    }
+
+    // The needed files are read as one batch and each is decoded as soon as its read completes.
+    JobSystem& jobs = JobSystem::Get();
+    std::vector<std::size_t> neededTextures;
+    std::vector<std::filesystem::path> neededPaths;
+    for (std::size_t textureIndex = 0; textureIndex < textureNeeded.size(); ++textureIndex) {
+        if (textureNeeded[textureIndex]) {
+            neededTextures.push_back(textureIndex);
+            neededPaths.emplace_back(model.texturePaths[textureIndex]);
+        }
+    }
+
+    std::vector<FileReadResult> files;
+    std::vector<DecodedImage> decodedImages(model.texturePaths.size());
+    std::vector<JobSystem::JobHandle> decodeJobs(neededTextures.size());
+    ReadFileBatch(jobs, neededPaths, files, [&](std::size_t fileIndex) {
+        decodeJobs[fileIndex] = jobs.Schedule([&, fileIndex]() {
+            const std::size_t textureIndex = neededTextures[fileIndex];
+            std::string decodeError;
+            if (!files[fileIndex].succeeded ||
+                !DecodeImageMemory(files[fileIndex].bytes, model.texturePaths[textureIndex], decodedImages[textureIndex], decodeError)) {
+                decodedImages[textureIndex] = {};
+            }
+            files[fileIndex].bytes = {};
+        });
+    });
+    for (const JobSystem::JobHandle& decodeJob : decodeJobs) {
+        jobs.Wait(decodeJob);
+    }
+    auto decodeTexture = [&](std::int32_t textureIndex) -> const DecodedImage* {
+        if (textureIndex < 0 || static_cast<std::size_t>(textureIndex) >= decodedImages.size()) {
+            return nullptr;
+        }
+
+        const DecodedImage& image = decodedImages[static_cast<std::size_t>(textureIndex)];
+        return image.width > 0 ? &image : nullptr;
+    };
+
+    std::vector<AtlasEntry> entries;
+    std::map<std::pair<std::int32_t, std::int32_t>, std::size_t> entryLookup;
+    std::vector<std::size_t> materialEntry(model.materials.size(), kNoEntry);
+    for (std::size_t materialIndex = 0; materialIndex < model.materials.size(); ++materialIndex) {
+        const ModelMaterial& material = model.materials[materialIndex];
+        if (!materialUsed[materialIndex] || material.textureIndex < 0) {
+            continue;
+        }
+
+        if (materialWraps[materialIndex]) {
+            ++outStats.wrappingMaterialCount;
+            continue;
+        }
+
+        const DecodedImage* colorImage = decodeTexture(material.textureIndex);
+        const DecodedImage* opacityImage = material.opacityTextureIndex >= 0 ? decodeTexture(material.opacityTextureIndex) : nullptr;
+        const bool opacityMissing = material.opacityTextureIndex >= 0 && !opacityImage;
+        if (!colorImage || opacityMissing ||
+            colorImage->width + 2 * gutter > maxAtlasSize || colorImage->height + 2 * gutter > maxAtlasSize) {
+            ++outStats.unpackableMaterialCount;
+            continue;
+        }
+
+        const std::pair<std::int32_t, std::int32_t> key{material.textureIndex, material.opacityTextureIndex};
+        auto existing = entryLookup.find(key);
+        if (existing == entryLookup.end()) {
+            std::uint32_t category = 0;
+            if (opacityImage) {
+                category |= kCategoryHasOpacityTexture;
+            }
+            if (HasTranslucentTexels(*colorImage)) {
+                category |= kCategoryTranslucentColor;
+            }
+
+            existing = entryLookup.emplace(key, entries.size()).first;
+            entries.push_back(AtlasEntry{key.first, key.second, colorImage, opacityImage, category, 0, 0, 0});
+        }
+
+        materialEntry[materialIndex] = existing->second;
+        ++outStats.packedMaterialCount;
+    }
+
+    if (entries.empty()) {
+        outStats.packedMaterialCount = 0;
+        return true;
+    }
+
+    // Next-fit shelf packing per category, tallest rectangles first.
+    std::vector<std::size_t> packingOrder(entries.size());
+    for (std::size_t entryIndex = 0; entryIndex < entries.size(); ++entryIndex) {
+        packingOrder[entryIndex] = entryIndex;
+    }
+    std::stable_sort(packingOrder.begin(), packingOrder.end(), [&](std::size_t left, std::size_t right) {
+        const AtlasEntry& a = entries[left];
+        const AtlasEntry& b = entries[right];
+        if (a.category != b.category) {
+            return a.category < b.category;
+        }
+        if (a.colorImage->height != b.colorImage->height) {
+            return a.colorImage->height > b.colorImage->height;
+        }
+        return a.colorImage->width > b.colorImage->width;
+    });
+
+    std::vector<AtlasPage> pages;
+    std::size_t openPage = kNoEntry;
+    for (const std::size_t entryIndex : packingOrder) {
+        AtlasEntry& entry = entries[entryIndex];
+        const std::uint32_t cellWidth = std::min(AlignUp(entry.colorImage->width + 2 * gutter, kRectAlignment), maxAtlasSize);
+        const std::uint32_t cellHeight = std::min(AlignUp(entry.colorImage->height + 2 * gutter, kRectAlignment), maxAtlasSize);
+
+        if (openPage != kNoEntry && pages[openPage].category != entry.category) {
+            openPage = kNoEntry;
+        }
+
+        if (openPage != kNoEntry) {
+            AtlasPage& page = pages[openPage];
+            if (page.cursorX + cellWidth > maxAtlasSize) {
+                page.shelfY += page.shelfHeight;
+                page.shelfHeight = 0;
+                page.cursorX = 0;
+            }
+            if (page.shelfY + cellHeight > maxAtlasSize) {
+                openPage = kNoEntry;
+            }
+        }
+
+        if (openPage == kNoEntry) {
+            openPage = pages.size();
+            pages.push_back(AtlasPage{entry.category, 0, 0, 0, 0, 0});
+        }
+
+        AtlasPage& page = pages[openPage];
+        entry.page = openPage;
+        entry.x = page.cursorX + gutter;
+        entry.y = page.shelfY + gutter;
+        page.cursorX += cellWidth;
+        page.shelfHeight = std::max(page.shelfHeight, cellHeight);
+        page.width = std::max(page.width, page.cursorX);
+        page.height = std::max(page.height, page.shelfY + page.shelfHeight);
+    }
+
+    std::vector<DecodedImage> colorPages(pages.size());
+    std::vector<DecodedImage> opacityPages(pages.size());
+    for (std::size_t pageIndex = 0; pageIndex < pages.size(); ++pageIndex) {
+        const AtlasPage& page = pages[pageIndex];
+        const std::size_t pixelBytes = static_cast<std::size_t>(page.width) * page.height * 4;
+        colorPages[pageIndex] = DecodedImage{page.width, page.height, std::vector<std::uint8_t>(pixelBytes, 0)};
+        if ((page.category & kCategoryHasOpacityTexture) != 0) {
+            opacityPages[pageIndex] = DecodedImage{page.width, page.height, std::vector<std::uint8_t>(pixelBytes, 255)};
+        }
+    }
+
+    for (const AtlasEntry& entry : entries) {
+        const std::uint32_t width = entry.colorImage->width;
+        const std::uint32_t height = entry.colorImage->height;
+        BlitWithGutter(*entry.colorImage, width, height, gutter, entry.x, entry.y, colorPages[entry.page]);
+        if (entry.opacityImage) {
+            // Opacity is resampled onto the color rectangle, matching how renderers pair the two textures.
+            BlitWithGutter(*entry.opacityImage, width, height, gutter, entry.x, entry.y, opacityPages[entry.page]);
+        }
+    }
+
+    std::error_code directoryError;
+    std::filesystem::create_directories(options.outputDirectory, directoryError);
+    if (directoryError) {
+        outError = "Failed to create texture atlas directory '" + options.outputDirectory.string() + "': " + directoryError.message();
+        return false;
+    }
+
+    // File names carry a content hash so renderers that cache textures by path never reuse a stale atlas.
+    const std::string stem = model.sourcePath.empty() ? std::string("model") : std::filesystem::path(model.sourcePath).stem().string();
+    std::vector<std::string> colorPagePaths(pages.size());
+    std::vector<std::string> opacityPagePaths(pages.size());
+    for (std::size_t pageIndex = 0; pageIndex < pages.size(); ++pageIndex) {
+        const std::string pagePrefix = stem + "_atlas" + std::to_string(pageIndex);
+        const std::filesystem::path colorPath =
+            options.outputDirectory / (pagePrefix + "_" + HashPixels(colorPages[pageIndex]) + ".bmp");
+        if (!WriteBmpImage(colorPath, colorPages[pageIndex], outError)) {
+            return false;
+        }
+        colorPagePaths[pageIndex] = colorPath.string();
+
+        if (!opacityPages[pageIndex].pixels.empty()) {
+            const std::filesystem::path opacityPath =
+                options.outputDirectory / (pagePrefix + "_opacity_" + HashPixels(opacityPages[pageIndex]) + ".bmp");
+            if (!WriteBmpImage(opacityPath, opacityPages[pageIndex], outError)) {
+                return false;
+            }
+            opacityPagePaths[pageIndex] = opacityPath.string();
+        }
+    }
+
+    // Every atlas is on disk; from here on the model is rewritten.
+    std::vector<std::int32_t> colorPageTextureIndex(pages.size(), -1);
+    std::vector<std::int32_t> opacityPageTextureIndex(pages.size(), -1);
+    for (std::size_t pageIndex = 0; pageIndex < pages.size(); ++pageIndex) {
+        colorPageTextureIndex[pageIndex] = static_cast<std::int32_t>(model.texturePaths.size());
+        model.texturePaths.push_back(colorPagePaths[pageIndex]);
+        if (!opacityPagePaths[pageIndex].empty()) {
+            opacityPageTextureIndex[pageIndex] = static_cast<std::int32_t>(model.texturePaths.size());
+            model.texturePaths.push_back(opacityPagePaths[pageIndex]);
+        }
+    }
+
+    const std::vector<glm::vec2> originalTexCoords = model.texCoords;
+    std::vector<std::uint32_t> vertexOwner(model.positions.size(), kUnassignedVertex);
+    for (const ModelSubmesh& submesh : model.submeshes) {
+        if (submesh.materialIndex < materialEntry.size() && materialEntry[submesh.materialIndex] != kNoEntry) {
+            continue;
+        }
+
+        const std::size_t indexStart = std::min<std::size_t>(submesh.indexStart, model.indices.size());
+        const std::size_t indexEnd = std::min<std::size_t>(indexStart + submesh.indexCount, model.indices.size());
+        for (std::size_t index = indexStart; index < indexEnd; ++index) {
+            if (model.indices[index] < vertexOwner.size()) {
+                vertexOwner[model.indices[index]] = kOriginalVertex;
+            }
+        }
+    }
+
+    std::unordered_map<std::uint64_t, std::uint32_t> duplicatedVertices;
+    const std::uint32_t firstDuplicateVertex = static_cast<std::uint32_t>(model.positions.size());
+    std::vector<std::uint32_t> duplicateSources;
+    for (const ModelSubmesh& submesh : model.submeshes) {
+        if (submesh.materialIndex >= materialEntry.size() || materialEntry[submesh.materialIndex] == kNoEntry) {
+            continue;
+        }
+
+        const std::size_t entryIndex = materialEntry[submesh.materialIndex];
+        const AtlasEntry& entry = entries[entryIndex];
+        const AtlasPage& page = pages[entry.page];
+        const std::uint32_t owner = static_cast<std::uint32_t>(entryIndex);
+        const std::size_t indexStart = std::min<std::size_t>(submesh.indexStart, model.indices.size());
+        const std::size_t indexEnd = std::min<std::size_t>(indexStart + submesh.indexCount, model.indices.size());
+        for (std::size_t index = indexStart; index < indexEnd; ++index) {
+            const std::uint32_t vertex = model.indices[index];
+            if (vertex >= originalTexCoords.size()) {
+                continue;
+            }
+
+            if (vertexOwner[vertex] == kUnassignedVertex) {
+                vertexOwner[vertex] = owner;
+                model.texCoords[vertex] = RemapTexCoord(originalTexCoords[vertex], entry, page);
+                continue;
+            }
+
+            if (vertexOwner[vertex] == owner) {
+                continue;
+            }
+
+            const std::uint64_t duplicateKey = (static_cast<std::uint64_t>(vertex) << 32) | owner;
+            auto duplicate = duplicatedVertices.find(duplicateKey);
+            if (duplicate == duplicatedVertices.end()) {
+                const glm::vec3 position = model.positions[vertex];
+                const std::uint32_t duplicateVertex = static_cast<std::uint32_t>(model.positions.size());
+                model.positions.push_back(position);
+                model.texCoords.push_back(RemapTexCoord(originalTexCoords[vertex], entry, page));
+                duplicateSources.push_back(vertex);
+                vertexOwner.push_back(owner);
+                duplicate = duplicatedVertices.emplace(duplicateKey, duplicateVertex).first;
+            }
+            model.indices[index] = duplicate->second;
+        }
+    }
+    // Copies made for other atlas pages must keep moving with the vertex they were copied from.
+    AppendMorphTargetDuplicates(model.morphTargets, duplicateSources, firstDuplicateVertex);
+
+    for (std::size_t materialIndex = 0; materialIndex < model.materials.size(); ++materialIndex) {
+        if (materialEntry[materialIndex] == kNoEntry) {
+            continue;
+        }
+
+        const AtlasEntry& entry = entries[materialEntry[materialIndex]];
+        ModelMaterial& material = model.materials[materialIndex];
+        material.textureIndex = colorPageTextureIndex[entry.page];
+        material.opacityTextureIndex = entry.opacityTextureIndex >= 0 ? opacityPageTextureIndex[entry.page] : -1;
+    }
+
+    // Drop source textures that no material references any more.
+    std::vector<std::int32_t> compactedIndex(model.texturePaths.size(), -1);
+    std::vector<bool> textureReferenced(model.texturePaths.size(), false);
+    auto markReferenced = [&](std::int32_t textureIndex) {
+        if (textureIndex >= 0 && static_cast<std::size_t>(textureIndex) < textureReferenced.size()) {
+            textureReferenced[static_cast<std::size_t>(textureIndex)] = true;
+        }
+    };
+    for (const ModelMaterial& material : model.materials) {
+        markReferenced(material.textureIndex);
+        markReferenced(material.opacityTextureIndex);
+        markReferenced(material.normalTextureIndex);
+        markReferenced(material.emissiveTextureIndex);
+        markReferenced(material.specularTextureIndex);
+    }
+
+    std::vector<std::string> compactedPaths;
+    for (std::size_t textureIndex = 0; textureIndex < model.texturePaths.size(); ++textureIndex) {
+        if (textureReferenced[textureIndex]) {
+            compactedIndex[textureIndex] = static_cast<std::int32_t>(compactedPaths.size());
+            compactedPaths.push_back(std::move(model.texturePaths[textureIndex]));
+        }
+    }
+
+    auto remapTextureIndex = [&](std::int32_t& textureIndex) {
+        if (textureIndex >= 0 && static_cast<std::size_t>(textureIndex) < compactedIndex.size()) {
+            textureIndex = compactedIndex[static_cast<std::size_t>(textureIndex)];
+        }
+    };
+    for (ModelMaterial& material : model.materials) {
+        remapTextureIndex(material.textureIndex);
+        remapTextureIndex(material.opacityTextureIndex);
+        remapTextureIndex(material.normalTextureIndex);
+        remapTextureIndex(material.emissiveTextureIndex);
+        remapTextureIndex(material.specularTextureIndex);
+    }
+    std::vector<std::uint32_t> unresolvedTextureIndices;
+    for (const std::uint32_t textureIndex : model.unresolvedTextureIndices) {
+        if (textureIndex < compactedIndex.size() && compactedIndex[textureIndex] >= 0) {
+            unresolvedTextureIndices.push_back(static_cast<std::uint32_t>(compactedIndex[textureIndex]));
+        }
+    }
+    model.unresolvedTextureIndices = std::move(unresolvedTextureIndices);
+    model.texturePaths = std::move(compactedPaths);
+
+    if (std::find(model.texturePaths.begin(), model.texturePaths.end(), model.primaryTexturePath) == model.texturePaths.end()) {
+        model.primaryTexturePath = colorPagePaths.front();
+    }
+
+    outStats.atlasCount = pages.size();
+    outStats.packedTextureCount = entries.size();
+    return true;
+}
+}
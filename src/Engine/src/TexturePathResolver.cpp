@@ -0,0 +1,271 @@
+#include "Engine/TexturePathResolver.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <SDL3/SDL.h>
+
+namespace engine {
+namespace {
+std::string ToLower(std::string_view text) {
+    std::string lowered(text);
+    std::transform(lowered.begin(), lowered.end(), lowered.begin(), [](unsigned char character) {
+        return static_cast<char>(std::tolower(character));
+    });
+    return lowered;
+}
+
+std::string DirectoryKey(const std::filesystem::path& directory) {
+    std::string key = directory.lexically_normal().generic_string();
+    if (key.size() > 1 && key.back() == '/') {
+        key.pop_back();
+    }
+    return key;
+}
+
+#if !defined(_WIN32)
+// "C:/..." and "//server/share/..." only name files on Windows.
+bool IsWindowsAbsolute(std::string_view text) {
+    const bool hasDriveLetter = text.size() >= 2 && std::isalpha(static_cast<unsigned char>(text[0])) && text[1] == ':';
+    return hasDriveLetter || text.starts_with("//");
+}
+#endif
+}
+
+const TextureSearchOptions& GetDefaultTextureSearchOptions() {
+    static const TextureSearchOptions options = []() {
+        TextureSearchOptions defaults{{}, {"textures", "maps", "images"}};
+        if (const char* searchPaths = SDL_getenv("ENGINE_TEXTURE_SEARCH_PATHS")) {
+            defaults.extraRoots = SplitSearchPathList(searchPaths);
+        }
+        return defaults;
+    }();
+    return options;
+}
+
+std::vector<std::filesystem::path> SplitSearchPathList(std::string_view pathList) {
+#if defined(_WIN32)
+    constexpr char kSeparator = ';';
+#else
+    constexpr char kSeparator = ':';
+#endif
+    std::vector<std::filesystem::path> paths;
+    while (!pathList.empty()) {
+        const std::size_t separator = pathList.find(kSeparator);
+        const std::string_view entry = pathList.substr(0, separator);
+        if (!entry.empty()) {
+            paths.emplace_back(entry);
+        }
+        pathList = separator == std::string_view::npos ? std::string_view() : pathList.substr(separator + 1);
+    }
+    return paths;
+}
+
+std::uint64_t HashTextureSearchOptions(const TextureSearchOptions& options) {
+    std::uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](std::string_view text) {
+        for (const char character : text) {
+            hash ^= static_cast<unsigned char>(character);
+            hash *= 1099511628211ull;
+        }
+        // Separates entries so {"ab"} and {"a", "b"} differ.
+        hash ^= 0xffu;
+        hash *= 1099511628211ull;
+    };
+
+    mix(std::to_string(kTexturePathResolverVersion));
+    for (const std::filesystem::path& root : options.extraRoots) {
+        mix(DirectoryKey(root));
+    }
+    mix("|");
+    for (const std::string& folderName : options.folderNames) {
+        mix(folderName);
+    }
+    return hash;
+}
+
+std::int64_t ReadDirectoryWriteTicks(const std::filesystem::path& directory) {
+    std::error_code error;
+    const std::filesystem::file_time_type lastWrite = std::filesystem::last_write_time(directory, error);
+    return error ? 0 : static_cast<std::int64_t>(lastWrite.time_since_epoch().count());
+}
+
+TexturePathResolver::TexturePathResolver(std::filesystem::path modelDirectory, const TextureSearchOptions& options)
+    : modelDirectory_(std::move(modelDirectory)),
+      options_(options),
+      searchRootsBuilt_(false),
+      searchRoots_(),
+      directories_(),
+      statistics_{} {
+    if (modelDirectory_.empty()) {
+        modelDirectory_ = ".";
+    }
+}
+
+std::filesystem::path TexturePathResolver::Resolve(std::string_view reference) {
+    ++statistics_.lookups;
+    std::string text(reference);
+    std::replace(text.begin(), text.end(), '\\', '/');
+    const std::filesystem::path written(text);
+    const std::string fileName = written.filename().string();
+    if (fileName.empty()) {
+        ++statistics_.unresolved;
+        return {};
+    }
+
+#if defined(_WIN32)
+    const bool usableAsWritten = true;
+#else
+    const bool usableAsWritten = !IsWindowsAbsolute(text);
+#endif
+    if (usableAsWritten) {
+        std::filesystem::path resolved;
+        if (written.is_absolute()) {
+            // Only the file name is matched loosely; listing every ancestor of an absolute path
+            // would cost more than the stat() it replaces.
+            const std::filesystem::path directory = written.parent_path();
+            if (const DirectoryEntry* entry = FindEntry(directory, fileName, false)) {
+                resolved = directory / entry->name;
+            }
+        } else {
+            resolved = WalkPath(modelDirectory_, written.lexically_normal());
+        }
+
+        if (!resolved.empty()) {
+            ++statistics_.resolvedAsWritten;
+            return resolved.lexically_normal();
+        }
+    }
+
+    if (!searchRootsBuilt_) {
+        BuildSearchRoots();
+    }
+    for (const std::filesystem::path& root : searchRoots_) {
+        if (const DirectoryEntry* entry = FindEntry(root, fileName, false)) {
+            ++statistics_.resolvedByFileName;
+            return (root / entry->name).lexically_normal();
+        }
+    }
+
+    ++statistics_.unresolved;
+    return {};
+}
+
+const TexturePathResolverStatistics& TexturePathResolver::GetStatistics() const noexcept {
+    return statistics_;
+}
+
+std::vector<TextureSearchDirectory> TexturePathResolver::GetListedDirectories() const {
+    std::vector<TextureSearchDirectory> listed;
+    listed.reserve(directories_.size());
+    for (const auto& [key, index] : directories_) {
+        listed.push_back(TextureSearchDirectory{key, index.lastWriteTicks});
+    }
+    std::sort(listed.begin(), listed.end(), [](const TextureSearchDirectory& left, const TextureSearchDirectory& right) {
+        return left.path < right.path;
+    });
+    return listed;
+}
+
+const TexturePathResolver::DirectoryIndex& TexturePathResolver::GetDirectoryIndex(const std::filesystem::path& directory) {
+    const std::string key = DirectoryKey(directory);
+    const auto cached = directories_.find(key);
+    if (cached != directories_.end()) {
+        return cached->second;
+    }
+
+    ++statistics_.directoriesListed;
+    // Taken before listing, so a file added meanwhile still leaves the recorded time stale.
+    DirectoryIndex index{{}, ReadDirectoryWriteTicks(directory)};
+    std::error_code listError;
+    std::filesystem::directory_iterator iterator(directory, std::filesystem::directory_options::skip_permission_denied, listError);
+    if (!listError) {
+        for (const std::filesystem::directory_entry& entry : iterator) {
+            // The entry type usually comes from the listing itself, without a stat() per file.
+            std::error_code typeError;
+            const std::string name = entry.path().filename().string();
+            index.entries.emplace(ToLower(name), DirectoryEntry{name, entry.is_directory(typeError)});
+        }
+    }
+    return directories_.emplace(key, std::move(index)).first->second;
+}
+
+const TexturePathResolver::DirectoryEntry* TexturePathResolver::FindEntry(
+    const std::filesystem::path& directory,
+    std::string_view name,
+    bool wantDirectory) {
+    const DirectoryIndex& index = GetDirectoryIndex(directory.empty() ? std::filesystem::path(".") : directory);
+    const auto [begin, end] = index.entries.equal_range(ToLower(name));
+    const DirectoryEntry* match = nullptr;
+    for (auto entry = begin; entry != end; ++entry) {
+        if (entry->second.isDirectory != wantDirectory) {
+            continue;
+        }
+        if (entry->second.name == name) {
+            return &entry->second;
+        }
+        match = match ? match : &entry->second;
+    }
+    return match;
+}
+
+std::filesystem::path TexturePathResolver::WalkPath(const std::filesystem::path& base, const std::filesystem::path& relative) {
+    std::filesystem::path current = base;
+    std::vector<std::filesystem::path> components(relative.begin(), relative.end());
+    for (std::size_t componentIndex = 0; componentIndex < components.size(); ++componentIndex) {
+        const std::string component = components[componentIndex].string();
+        if (component.empty() || component == ".") {
+            continue;
+        }
+        if (component == "..") {
+            current /= "..";
+            continue;
+        }
+
+        const bool isLast = componentIndex + 1 == components.size();
+        const DirectoryEntry* entry = FindEntry(current, component, !isLast);
+        if (!entry) {
+            return {};
+        }
+        current /= entry->name;
+    }
+    return current;
+}
+
+void TexturePathResolver::BuildSearchRoots() {
+    searchRootsBuilt_ = true;
+    std::vector<std::string> seen;
+    auto addRoot = [&](const std::filesystem::path& root) {
+        const std::string key = DirectoryKey(root);
+        if (std::find(seen.begin(), seen.end(), key) == seen.end()) {
+            seen.push_back(key);
+            searchRoots_.push_back(root);
+        }
+    };
+    auto addRootWithFolders = [&](const std::filesystem::path& root) {
+        addRoot(root);
+        for (const std::string& folderName : options_.folderNames) {
+            if (const DirectoryEntry* folder = FindEntry(root, folderName, true)) {
+                addRoot(root / folder->name);
+            }
+        }
+    };
+
+    addRootWithFolders(modelDirectory_);
+    // Sibling texture folders, as in Models/Wolf/Fbx/Wolf.fbx with Models/Wolf/textures.
+    const std::filesystem::path parentDirectory = modelDirectory_.lexically_normal().parent_path();
+    if (!parentDirectory.empty()) {
+        for (const std::string& folderName : options_.folderNames) {
+            if (const DirectoryEntry* folder = FindEntry(parentDirectory, folderName, true)) {
+                addRoot(parentDirectory / folder->name);
+            }
+        }
+    }
+    for (const std::filesystem::path& extraRoot : options_.extraRoots) {
+        addRootWithFolders(extraRoot);
+    }
+}
+}
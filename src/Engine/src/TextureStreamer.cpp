@@ -0,0 +1,538 @@
+#include "Engine/TextureStreamer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <utility>
+
+#include <SDL3/SDL.h>
+
+#include "Engine/BatchFileReader.hpp"
+#include "Engine/Log.hpp"
+#include "ImageCodec.hpp"
+
+namespace engine {
+namespace {
+std::uint32_t GetLevelEdge(std::uint32_t edge, std::uint32_t level) noexcept {
+    return level >= 32 ? 1u : std::max(edge >> level, 1u);
+}
+
+// Finest level no larger than needed: the one whose longest edge is at least `texelsPerUnit` but
+// less than twice it.
+std::uint32_t ChooseLevel(std::uint32_t width, std::uint32_t height, float texelsPerUnit, std::uint32_t coarsestLevel) noexcept {
+    if (!(texelsPerUnit > 0.0f)) {
+        return coarsestLevel;
+    }
+
+    const double ratio = static_cast<double>(std::max(width, height)) / static_cast<double>(texelsPerUnit);
+    if (ratio <= 1.0) {
+        return 0;
+    }
+    const double level = std::floor(std::log2(ratio));
+    return level >= static_cast<double>(coarsestLevel) ? coarsestLevel : static_cast<std::uint32_t>(level);
+}
+
+std::uint32_t FindPlaceholderLevel(std::uint32_t width, std::uint32_t height, std::uint32_t placeholderSize) noexcept {
+    const std::uint32_t lastLevel = ComputeMipLevelCount(width, height) - 1;
+    std::uint32_t level = 0;
+    while (level < lastLevel && std::max(GetLevelEdge(width, level), GetLevelEdge(height, level)) > placeholderSize) {
+        ++level;
+    }
+    return level;
+}
+}
+
+const TextureStreamingSettings& GetDefaultTextureStreamingSettings() {
+    static const TextureStreamingSettings settings = []() {
+        TextureStreamingSettings defaults{512u * 1024u * 1024u, 16, 4};
+        if (const char* budgetMegabytes = SDL_getenv("ENGINE_TEXTURE_BUDGET_MB")) {
+            const long long parsed = std::atoll(budgetMegabytes);
+            if (parsed > 0) {
+                defaults.budgetBytes = static_cast<std::size_t>(parsed) * 1024u * 1024u;
+            }
+        }
+        return defaults;
+    }();
+    return settings;
+}
+
+std::uint32_t ComputeMipLevelCount(std::uint32_t width, std::uint32_t height) noexcept {
+    std::uint32_t edge = std::max({width, height, 1u});
+    std::uint32_t levelCount = 1;
+    while (edge > 1) {
+        edge >>= 1;
+        ++levelCount;
+    }
+    return levelCount;
+}
+
+DecodedImage DownsampleImage(const DecodedImage& image) {
+    DecodedImage half{std::max(image.width / 2, 1u), std::max(image.height / 2, 1u), {}};
+    if (image.width == 0 || image.height == 0) {
+        return DecodedImage{0, 0, {}};
+    }
+
+    half.pixels.resize(static_cast<std::size_t>(half.width) * half.height * 4);
+    for (std::uint32_t y = 0; y < half.height; ++y) {
+        // Each destination texel covers a 2x2 block, widened to 3 texels at an odd last edge.
+        const std::uint32_t rowBegin = std::min(y * 2, image.height - 1);
+        const std::uint32_t rowEnd = y + 1 == half.height ? image.height : std::min(rowBegin + 2, image.height);
+        for (std::uint32_t x = 0; x < half.width; ++x) {
+            const std::uint32_t columnBegin = std::min(x * 2, image.width - 1);
+            const std::uint32_t columnEnd = x + 1 == half.width ? image.width : std::min(columnBegin + 2, image.width);
+            std::uint32_t sums[4] = {};
+            for (std::uint32_t row = rowBegin; row < rowEnd; ++row) {
+                const std::uint8_t* source = image.pixels.data() + (static_cast<std::size_t>(row) * image.width + columnBegin) * 4;
+                for (std::uint32_t column = columnBegin; column < columnEnd; ++column, source += 4) {
+                    sums[0] += source[0];
+                    sums[1] += source[1];
+                    sums[2] += source[2];
+                    sums[3] += source[3];
+                }
+            }
+
+            const std::uint32_t count = (rowEnd - rowBegin) * (columnEnd - columnBegin);
+            std::uint8_t* destination = half.pixels.data() + (static_cast<std::size_t>(y) * half.width + x) * 4;
+            for (int channel = 0; channel < 4; ++channel) {
+                destination[channel] = static_cast<std::uint8_t>((sums[channel] + count / 2) / count);
+            }
+        }
+    }
+    return half;
+}
+
+TextureStreamer::TextureStreamer(const TextureStreamingSettings& settings, TextureDecodeFunction decode)
+    : settings_(settings),
+      decode_(decode ? std::move(decode) : TextureDecodeFunction(&DecodeImageMemory)),
+      slots_(),
+      frameIndex_(1),
+      nextTicket_(1),
+      residentBytes_(0),
+      fileBytes_(0),
+      reservedBytes_(0),
+      stats_{},
+      candidates_(),
+      evictable_(),
+      scheduledDecodes_(),
+      decodesInFlight_(0),
+      completedMutex_(),
+      completed_() {
+    settings_.placeholderSize = std::max(settings_.placeholderSize, 1u);
+    settings_.maxDecodesInFlight = std::max(settings_.maxDecodesInFlight, 1u);
+    stats_.budgetBytes = settings_.budgetBytes;
+}
+
+TextureStreamer::~TextureStreamer() {
+    WaitForDecodes();
+}
+
+void TextureStreamer::SetTextures(
+    const std::vector<std::string>& paths,
+    const std::vector<bool>& enabled,
+    std::vector<std::size_t>& outPreviousSlots) {
+    std::vector<Slot> slots(paths.size());
+    std::vector<bool> carried(slots_.size(), false);
+    outPreviousSlots.assign(paths.size(), static_cast<std::size_t>(-1));
+    for (std::size_t slotIndex = 0; slotIndex < paths.size(); ++slotIndex) {
+        Slot& slot = slots[slotIndex];
+        slot = Slot{paths[slotIndex], slotIndex < enabled.size() && enabled[slotIndex], false, false, 0, 0, 0, kNoLevel, {}, nullptr, 0, 0, 0.0f, 0};
+        if (!slot.enabled) {
+            continue;
+        }
+
+        for (std::size_t previous = 0; previous < slots_.size(); ++previous) {
+            if (!carried[previous] && slots_[previous].enabled && slots_[previous].path == paths[slotIndex]) {
+                slot = std::move(slots_[previous]);
+                carried[previous] = true;
+                outPreviousSlots[slotIndex] = previous;
+                break;
+            }
+        }
+    }
+
+    slots_ = std::move(slots);
+    RecountBytes();
+}
+
+void TextureStreamer::InvalidateTextures(const std::vector<std::string>& paths) {
+    for (Slot& slot : slots_) {
+        if (std::find(paths.begin(), paths.end(), slot.path) == paths.end()) {
+            continue;
+        }
+
+        // A decode already running may have read the old file, so its result is dropped.
+        slot.stale = true;
+        DropFile(slot);
+        slot.failed = false;
+        slot.decodeTicket = 0;
+        slot.reservedBytes = 0;
+    }
+    RecountBytes();
+}
+
+void TextureStreamer::SetBudget(std::size_t budgetBytes) {
+    settings_.budgetBytes = budgetBytes;
+    stats_.budgetBytes = budgetBytes;
+}
+
+void TextureStreamer::RequestTexels(std::size_t slot, float texelsPerUnit) {
+    if (slot >= slots_.size() || !std::isfinite(texelsPerUnit)) {
+        return;
+    }
+
+    Slot& requested = slots_[slot];
+    if (requested.lastRequestedFrame != frameIndex_) {
+        requested.lastRequestedFrame = frameIndex_;
+        requested.requestedTexels = 0.0f;
+    }
+    requested.requestedTexels = std::max(requested.requestedTexels, texelsPerUnit);
+}
+
+void TextureStreamer::Update(std::vector<TextureStreamUpdate>& outUpdates) {
+    outUpdates.clear();
+
+    std::vector<DecodeResult> completed;
+    {
+        std::lock_guard<std::mutex> lock(completedMutex_);
+        completed.swap(completed_);
+    }
+
+    for (DecodeResult& result : completed) {
+        const auto owner = std::find_if(slots_.begin(), slots_.end(), [&](const Slot& slot) { return slot.decodeTicket == result.ticket; });
+        if (owner == slots_.end()) {
+            continue;
+        }
+
+        Slot& slot = *owner;
+        slot.decodeTicket = 0;
+        reservedBytes_ -= std::min(reservedBytes_, slot.reservedBytes);
+        slot.reservedBytes = 0;
+        slot.stale = false;
+        if (!result.succeeded) {
+            // Not retried until the file changes; the renderer treats the slot as missing.
+            LogWarning(LogCategory::Renderer, "%s", result.error);
+            ReleaseSlot(slot);
+            slot.failed = true;
+            ++stats_.failedDecodeCount;
+            outUpdates.push_back(TextureStreamUpdate{static_cast<std::size_t>(owner - slots_.begin()), kNoLevel, {}});
+            continue;
+        }
+
+        ReleaseSlot(slot);
+        slot.fullWidth = result.fullWidth;
+        slot.fullHeight = result.fullHeight;
+        slot.placeholderLevel = result.placeholderLevel;
+        slot.placeholder = std::move(result.placeholder);
+        slot.residentLevel = result.level;
+        residentBytes_ += slot.placeholder.pixels.size() + GetLevelBytes(slot, slot.residentLevel);
+        // The file stays only if it fits in what the levels leave; otherwise the next level change
+        // reads it again.
+        if (result.file && GetCommittedBytes() + result.file->size() <= settings_.budgetBytes) {
+            fileBytes_ += result.file->size();
+            slot.file = std::move(result.file);
+        }
+        ++stats_.decodeCount;
+        outUpdates.push_back(TextureStreamUpdate{static_cast<std::size_t>(owner - slots_.begin()), result.level, std::move(result.image)});
+    }
+
+    // Visible textures that have never been decoded come first, then visible ones that are short
+    // of their projected size, larger on screen first, and finally placeholders for the rest.
+    std::vector<Candidate>& candidates = candidates_;
+    candidates.clear();
+    for (std::size_t slotIndex = 0; slotIndex < slots_.size(); ++slotIndex) {
+        const Slot& slot = slots_[slotIndex];
+        if (!slot.enabled || slot.failed || slot.decodeTicket != 0) {
+            continue;
+        }
+
+        const bool visible = IsVisible(slot);
+        const float texels = visible ? slot.requestedTexels : 0.0f;
+        if (slot.fullWidth == 0) {
+            candidates.push_back(Candidate{slotIndex, visible ? 0 : 2, texels});
+        } else if (slot.stale || GetTargetLevel(slot) < slot.residentLevel) {
+            candidates.push_back(Candidate{slotIndex, visible ? 1 : 2, texels});
+        }
+    }
+    std::stable_sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+        return a.tier != b.tier ? a.tier < b.tier : a.texels > b.texels;
+    });
+
+    for (const Candidate& candidate : candidates) {
+        if (decodesInFlight_.load() >= settings_.maxDecodesInFlight) {
+            break;
+        }
+
+        Slot& slot = slots_[candidate.slot];
+        const std::size_t committed = GetCommittedBytes();
+        if (slot.fullWidth == 0) {
+            // The size is unknown until the file is decoded, so the level is capped by a share of
+            // what is left and that share is set aside until the result lands.
+            const std::size_t available = settings_.budgetBytes > committed ? settings_.budgetBytes - committed : 0;
+            const std::size_t share = available / settings_.maxDecodesInFlight;
+            ScheduleDecode(candidate.slot, candidate.texels, share, share);
+            continue;
+        }
+
+        // Invalidated textures come back at least as sharp as they were.
+        std::uint32_t level = std::min(GetTargetLevel(slot), slot.residentLevel);
+        const std::size_t currentBytes = GetLevelBytes(slot, slot.residentLevel);
+        auto fits = [&](std::uint32_t candidateLevel) {
+            const std::size_t incoming = GetLevelBytes(slot, candidateLevel);
+            return incoming <= currentBytes || GetCommittedBytes() + (incoming - currentBytes) <= settings_.budgetBytes;
+        };
+        if (!fits(level)) {
+            EvictToFit(GetLevelBytes(slot, level) - currentBytes, candidate.slot, outUpdates);
+        }
+        while (!fits(level) && level < slot.placeholderLevel) {
+            ++level;
+        }
+        if (!fits(level) || (!slot.stale && level >= slot.residentLevel)) {
+            continue;
+        }
+
+        const std::size_t incoming = GetLevelBytes(slot, level);
+        ScheduleDecode(candidate.slot, static_cast<float>(std::max(GetLevelEdge(slot.fullWidth, level), GetLevelEdge(slot.fullHeight, level))),
+            incoming, incoming > currentBytes ? incoming - currentBytes : 0);
+    }
+
+    StartDecodes();
+    ++frameIndex_;
+}
+
+std::uint32_t TextureStreamer::GetResidentLevel(std::size_t slot) const noexcept {
+    return slot < slots_.size() ? slots_[slot].residentLevel : kNoLevel;
+}
+
+bool TextureStreamer::HasFailed(std::size_t slot) const noexcept {
+    return slot < slots_.size() && slots_[slot].failed;
+}
+
+TextureStreamerStatistics TextureStreamer::GetStatistics() const {
+    TextureStreamerStatistics statistics = stats_;
+    statistics.residentBytes = residentBytes_;
+    statistics.textureCount = 0;
+    statistics.placeholderCount = 0;
+    statistics.pendingDecodeCount = 0;
+    statistics.fileBytes = fileBytes_;
+    for (const Slot& slot : slots_) {
+        if (!slot.enabled) {
+            continue;
+        }
+
+        ++statistics.textureCount;
+        if (slot.residentLevel == kNoLevel || slot.residentLevel >= slot.placeholderLevel) {
+            ++statistics.placeholderCount;
+        }
+        if (slot.decodeTicket != 0) {
+            ++statistics.pendingDecodeCount;
+        }
+    }
+    return statistics;
+}
+
+void TextureStreamer::WaitForDecodes() {
+    if (decodesInFlight_.load() == 0) {
+        return;
+    }
+
+    JobSystem::Get().WaitUntil([this]() { return decodesInFlight_.load() == 0; });
+}
+
+std::size_t TextureStreamer::GetLevelBytes(const Slot& slot, std::uint32_t level) noexcept {
+    if (level == kNoLevel || slot.fullWidth == 0) {
+        return 0;
+    }
+    return static_cast<std::size_t>(GetLevelEdge(slot.fullWidth, level)) * GetLevelEdge(slot.fullHeight, level) * 4;
+}
+
+std::uint32_t TextureStreamer::GetTargetLevel(const Slot& slot) const noexcept {
+    if (slot.fullWidth == 0) {
+        return kNoLevel;
+    }
+    return IsVisible(slot) ? ChooseLevel(slot.fullWidth, slot.fullHeight, slot.requestedTexels, slot.placeholderLevel) : slot.placeholderLevel;
+}
+
+bool TextureStreamer::IsVisible(const Slot& slot) const noexcept {
+    return slot.lastRequestedFrame == frameIndex_;
+}
+
+std::size_t TextureStreamer::GetCommittedBytes() const noexcept {
+    return residentBytes_ + fileBytes_ + reservedBytes_;
+}
+
+void TextureStreamer::ReleaseSlot(Slot& slot) noexcept {
+    residentBytes_ -= std::min(residentBytes_, slot.placeholder.pixels.size() + GetLevelBytes(slot, slot.residentLevel));
+    slot.residentLevel = kNoLevel;
+    slot.placeholder = {};
+    DropFile(slot);
+    slot.fullWidth = 0;
+    slot.fullHeight = 0;
+    slot.placeholderLevel = 0;
+}
+
+void TextureStreamer::DropFile(Slot& slot) noexcept {
+    if (slot.file) {
+        fileBytes_ -= std::min(fileBytes_, slot.file->size());
+        slot.file = nullptr;
+    }
+}
+
+void TextureStreamer::RecountBytes() noexcept {
+    residentBytes_ = 0;
+    fileBytes_ = 0;
+    reservedBytes_ = 0;
+    for (const Slot& slot : slots_) {
+        residentBytes_ += slot.placeholder.pixels.size() + GetLevelBytes(slot, slot.residentLevel);
+        fileBytes_ += slot.file ? slot.file->size() : 0;
+        reservedBytes_ += slot.decodeTicket != 0 ? slot.reservedBytes : 0;
+    }
+}
+
+void TextureStreamer::EvictToFit(std::size_t incomingBytes, std::size_t keepSlot, std::vector<TextureStreamUpdate>& outUpdates) {
+    // Kept files go first, least recently seen first: dropping one costs only a read later.
+    std::vector<std::size_t>& evictable = evictable_;
+    evictable.clear();
+    for (std::size_t slotIndex = 0; slotIndex < slots_.size(); ++slotIndex) {
+        if (slotIndex != keepSlot && slots_[slotIndex].file) {
+            evictable.push_back(slotIndex);
+        }
+    }
+    std::stable_sort(evictable.begin(), evictable.end(), [&](std::size_t a, std::size_t b) {
+        return slots_[a].lastRequestedFrame < slots_[b].lastRequestedFrame;
+    });
+    for (const std::size_t slotIndex : evictable) {
+        if (GetCommittedBytes() + incomingBytes <= settings_.budgetBytes) {
+            return;
+        }
+        DropFile(slots_[slotIndex]);
+    }
+
+    // Then levels: out of view first, least recently seen first; then visible textures sharper
+    // than they need.
+    evictable.clear();
+    for (std::size_t slotIndex = 0; slotIndex < slots_.size(); ++slotIndex) {
+        const Slot& slot = slots_[slotIndex];
+        if (slotIndex != keepSlot && slot.decodeTicket == 0 && slot.residentLevel < slot.placeholderLevel &&
+            (!IsVisible(slot) || slot.residentLevel < GetTargetLevel(slot))) {
+            evictable.push_back(slotIndex);
+        }
+    }
+    std::stable_sort(evictable.begin(), evictable.end(), [&](std::size_t a, std::size_t b) {
+        const bool aVisible = IsVisible(slots_[a]);
+        const bool bVisible = IsVisible(slots_[b]);
+        return aVisible != bVisible ? !aVisible : slots_[a].lastRequestedFrame < slots_[b].lastRequestedFrame;
+    });
+
+    for (const std::size_t slotIndex : evictable) {
+        if (GetCommittedBytes() + incomingBytes <= settings_.budgetBytes) {
+            return;
+        }
+
+        Slot& slot = slots_[slotIndex];
+        residentBytes_ -= GetLevelBytes(slot, slot.residentLevel) - GetLevelBytes(slot, slot.placeholderLevel);
+        slot.residentLevel = slot.placeholderLevel;
+        DropFile(slot);
+        ++stats_.evictionCount;
+        outUpdates.push_back(TextureStreamUpdate{slotIndex, slot.placeholderLevel, slot.placeholder});
+    }
+}
+
+void TextureStreamer::ScheduleDecode(std::size_t slotIndex, float texelsPerUnit, std::size_t maxLevelBytes, std::size_t reservedBytes) {
+    Slot& slot = slots_[slotIndex];
+    slot.decodeTicket = nextTicket_++;
+    slot.reservedBytes = reservedBytes;
+    reservedBytes_ += reservedBytes;
+    decodesInFlight_.fetch_add(1);
+    scheduledDecodes_.push_back(DecodeRequest{slot.decodeTicket, slot.path, slot.file, texelsPerUnit, maxLevelBytes});
+}
+
+void TextureStreamer::StartDecodes() {
+    JobSystem& jobs = JobSystem::Get();
+    std::vector<DecodeRequest> reads;
+    for (DecodeRequest& request : scheduledDecodes_) {
+        if (request.file) {
+            jobs.ScheduleBackground([this, request = std::move(request)]() mutable { DecodeLevels(std::move(request), {}); });
+        } else {
+            reads.push_back(std::move(request));
+        }
+    }
+    scheduledDecodes_.clear();
+    if (reads.empty()) {
+        return;
+    }
+
+    // Each file decodes on its own job as soon as its read completes, overlapping the other reads.
+    jobs.ScheduleBackground([this, &jobs, reads = std::move(reads)]() mutable {
+        std::vector<std::filesystem::path> paths;
+        paths.reserve(reads.size());
+        for (const DecodeRequest& request : reads) {
+            paths.emplace_back(request.path);
+        }
+
+        std::vector<FileReadResult> files;
+        ReadFileBatch(jobs, paths, files, [&](std::size_t fileIndex) {
+            DecodeRequest& request = reads[fileIndex];
+            FileReadResult& file = files[fileIndex];
+            if (file.succeeded) {
+                request.file = std::make_shared<const std::vector<std::byte>>(std::move(file.bytes));
+            }
+            jobs.ScheduleBackground([this, request = std::move(request), error = std::move(file.error)]() mutable {
+                DecodeLevels(std::move(request), std::move(error));
+            });
+        });
+    });
+}
+
+void TextureStreamer::DecodeLevels(DecodeRequest request, std::string readError) {
+    const std::string& path = request.path;
+    DecodeResult result{request.ticket, false, std::move(readError), 0, 0, 0, kNoLevel, {}, {}, nullptr};
+    DecodedImage level;
+    if (!request.file) {
+        if (result.error.empty()) {
+            result.error = "Failed to read texture '" + path + "'.";
+        }
+    } else if (!decode_(*request.file, path, level, result.error)) {
+        if (result.error.empty()) {
+            result.error = "Failed to decode texture '" + path + "'.";
+        }
+    } else if (level.width == 0 || level.height == 0 ||
+        level.pixels.size() != static_cast<std::size_t>(level.width) * level.height * 4) {
+        result.error = "Texture '" + path + "' decoded to an empty or malformed image.";
+    } else {
+        result.succeeded = true;
+        result.file = std::move(request.file);
+        result.fullWidth = level.width;
+        result.fullHeight = level.height;
+        result.placeholderLevel = FindPlaceholderLevel(level.width, level.height, settings_.placeholderSize);
+        result.level = ChooseLevel(level.width, level.height, request.texelsPerUnit, result.placeholderLevel);
+        const auto levelBytes = [&](std::uint32_t index) {
+            return static_cast<std::size_t>(GetLevelEdge(level.width, index)) * GetLevelEdge(level.height, index) * 4;
+        };
+        while (result.level < result.placeholderLevel && levelBytes(result.level) > request.maxLevelBytes) {
+            ++result.level;
+        }
+
+        for (std::uint32_t index = 0;; ++index) {
+            if (index == result.placeholderLevel) {
+                result.placeholder = std::move(level);
+                break;
+            }
+            DecodedImage next = DownsampleImage(level);
+            if (index == result.level) {
+                result.image = std::move(level);
+            }
+            level = std::move(next);
+        }
+        if (result.level == result.placeholderLevel) {
+            result.image = result.placeholder;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(completedMutex_);
+        completed_.push_back(std::move(result));
+    }
+    decodesInFlight_.fetch_sub(1);
+}
+}
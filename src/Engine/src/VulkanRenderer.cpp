@@ -1,5 +1,7 @@
 #include "Engine/VulkanRenderer.hpp"
 
+#include <utility>
+
 #include "SdlRendererBase.hpp"
 
 namespace engine {
@@ -24,8 +26,28 @@ void VulkanRenderer::EndFrame() {
     impl_->EndFrame();
 }
 
-void VulkanRenderer::RenderModelWireframe(const ModelData& model, float yawDegrees, float pitchDegrees, float rollDegrees, float cameraDistance, bool wireOverlayEnabled) {
-    impl_->RenderModelWireframe(model, yawDegrees, pitchDegrees, rollDegrees, cameraDistance, wireOverlayEnabled);
+void VulkanRenderer::RenderModelWireframe(const ModelData& model, const CameraLatch& latchCamera, bool wireOverlayEnabled) {
+    impl_->RenderModelWireframe(model, latchCamera, wireOverlayEnabled);
+}
+
+void VulkanRenderer::InvalidateModelTextures(const std::vector<std::string>& texturePaths) {
+    impl_->InvalidateModelTextures(texturePaths);
+}
+
+void VulkanRenderer::SetRenderScale(float scale) {
+    impl_->SetRenderScale(scale);
+}
+
+void VulkanRenderer::SetOverdrawVisualization(bool enabled) {
+    impl_->SetOverdrawVisualization(enabled);
+}
+
+void VulkanRenderer::SetPointCloudPreview(std::shared_ptr<const PointCloudPreview> preview) {
+    impl_->SetPointCloudPreview(std::move(preview));
+}
+
+MaterialChannelMask VulkanRenderer::GetSampledMaterialChannels() const noexcept {
+    return impl_->GetSampledMaterialChannels();
 }
 
 SDL_Renderer* VulkanRenderer::GetNativeRenderer() const noexcept {
@@ -35,4 +57,8 @@ SDL_Renderer* VulkanRenderer::GetNativeRenderer() const noexcept {
 const char* VulkanRenderer::GetName() const noexcept {
     return impl_->GetName();
 }
+
+RendererFrameStatistics VulkanRenderer::GetFrameStatistics() const noexcept {
+    return impl_->GetFrameStatistics();
+}
 }
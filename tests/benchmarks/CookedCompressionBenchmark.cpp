@@ -0,0 +1,145 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Engine/BlockCompression.hpp"
+#include "Engine/FbxLoader.hpp"
+#include "Engine/JobSystem.hpp"
+#include "Engine/ModelData.hpp"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+// A rolling height field standing in for a photogrammetry scan.
+engine::ModelData MakeScanModel(std::uint32_t cellsPerSide) {
+    engine::ModelData model;
+    const std::uint32_t verticesPerSide = cellsPerSide + 1;
+    model.positions.reserve(static_cast<std::size_t>(verticesPerSide) * verticesPerSide);
+    model.texCoords.reserve(model.positions.capacity());
+    for (std::uint32_t row = 0; row < verticesPerSide; ++row) {
+        for (std::uint32_t column = 0; column < verticesPerSide; ++column) {
+            const float u = static_cast<float>(column) / static_cast<float>(cellsPerSide);
+            const float v = static_cast<float>(row) / static_cast<float>(cellsPerSide);
+            const float height = 0.1f * std::sin(u * 17.0f) * std::cos(v * 11.0f);
+            model.positions.push_back(glm::vec3(u * 2.0f - 1.0f, height, v * 2.0f - 1.0f));
+            model.texCoords.push_back(glm::vec2(u, v));
+        }
+    }
+
+    model.indices.reserve(static_cast<std::size_t>(cellsPerSide) * cellsPerSide * 6);
+    for (std::uint32_t row = 0; row < cellsPerSide; ++row) {
+        for (std::uint32_t column = 0; column < cellsPerSide; ++column) {
+            const std::uint32_t corner = row * verticesPerSide + column;
+            model.indices.insert(
+                model.indices.end(),
+                {corner, corner + verticesPerSide, corner + 1, corner + 1, corner + verticesPerSide, corner + verticesPerSide + 1});
+        }
+    }
+    return model;
+}
+
+double SecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Best of several runs, so the figure reflects the codec rather than scheduler noise.
+bool TimeDecode(engine::JobSystem& jobs, const std::vector<std::byte>& compressed, std::size_t rawSize, double& outSeconds) {
+    std::vector<std::byte> decoded;
+    std::string error;
+    outSeconds = 1e30;
+    for (int run = 0; run < 5; ++run) {
+        const Clock::time_point start = Clock::now();
+        if (!engine::DecompressBlocks(jobs, compressed.data(), compressed.size(), rawSize, decoded, error) ||
+            decoded.size() != rawSize) {
+            std::fprintf(stderr, "Decode failed: %s\n", error.c_str());
+            return false;
+        }
+        outSeconds = std::min(outSeconds, SecondsSince(start));
+    }
+    return true;
+}
+
+bool ReportSection(const char* name, const void* data, std::size_t size, engine::BlockFilter filter, std::size_t& totalRaw, std::size_t& totalCompressed) {
+    const auto* bytes = static_cast<const std::byte*>(data);
+    std::vector<std::byte> compressed;
+    const Clock::time_point compressStart = Clock::now();
+    engine::CompressBlocks(bytes, size, filter, compressed);
+    const double compressSeconds = SecondsSince(compressStart);
+
+    std::vector<std::byte> decoded;
+    std::string error;
+    if (!engine::DecompressBlocks(engine::JobSystem::Get(), compressed.data(), compressed.size(), size, decoded, error) ||
+        !std::equal(decoded.begin(), decoded.end(), bytes, bytes + size)) {
+        std::fprintf(stderr, "%s did not round-trip: %s\n", name, error.c_str());
+        return false;
+    }
+
+    // One worker alongside the calling thread, against the shared job system.
+    engine::JobSystem singleWorker(1);
+    engine::JobSystem& jobs = engine::JobSystem::Get();
+    double singleWorkerSeconds = 0.0;
+    double parallelSeconds = 0.0;
+    if (!TimeDecode(singleWorker, compressed, size, singleWorkerSeconds) || !TimeDecode(jobs, compressed, size, parallelSeconds)) {
+        return false;
+    }
+
+    const double megabytes = static_cast<double>(size) / (1024.0 * 1024.0);
+    const double gigabytes = static_cast<double>(size) / 1e9;
+    std::printf(
+        "%-10s %9.2f MB -> %8.2f MB  ratio %5.2fx  compress %7.1f MB/s  decode %6.2f GB/s (2 threads) %6.2f GB/s (%u threads)\n",
+        name,
+        megabytes,
+        static_cast<double>(compressed.size()) / (1024.0 * 1024.0),
+        static_cast<double>(size) / static_cast<double>(std::max<std::size_t>(compressed.size(), 1)),
+        megabytes / std::max(compressSeconds, 1e-9),
+        gigabytes / std::max(singleWorkerSeconds, 1e-9),
+        gigabytes / std::max(parallelSeconds, 1e-9),
+        jobs.GetWorkerCount() + 1);
+    totalRaw += size;
+    totalCompressed += compressed.size();
+    return true;
+}
+}
+
+// Usage: EngineCookedCompressionBenchmark [model.fbx]
+// Without a model, a 1024x1024 height field is used.
+int main(int argc, char** argv) {
+    engine::ModelData model;
+    if (argc > 1) {
+        std::string error;
+        if (!engine::FbxLoader::LoadModel(argv[1], model, error)) {
+            std::fprintf(stderr, "Could not load '%s': %s\n", argv[1], error.c_str());
+            return 1;
+        }
+    } else {
+        model = MakeScanModel(1024);
+    }
+
+    std::printf(
+        "Cooked payload compression: %zu vertices, %zu triangles, %zu KB blocks\n",
+        model.positions.size(),
+        model.indices.size() / 3,
+        engine::kCompressionBlockSize / 1024);
+
+    std::size_t totalRaw = 0;
+    std::size_t totalCompressed = 0;
+    const bool succeeded =
+        ReportSection("positions", model.positions.data(), model.positions.size() * sizeof(glm::vec3), engine::BlockFilter::Shuffle32, totalRaw, totalCompressed) &&
+        ReportSection("texcoords", model.texCoords.data(), model.texCoords.size() * sizeof(glm::vec2), engine::BlockFilter::Shuffle32, totalRaw, totalCompressed) &&
+        ReportSection("indices", model.indices.data(), model.indices.size() * sizeof(std::uint32_t), engine::BlockFilter::Delta32, totalRaw, totalCompressed) &&
+        ReportSection("indices/lz", model.indices.data(), model.indices.size() * sizeof(std::uint32_t), engine::BlockFilter::None, totalRaw, totalCompressed);
+    if (!succeeded) {
+        return 1;
+    }
+
+    std::printf(
+        "total      %9.2f MB -> %8.2f MB  ratio %5.2fx\n",
+        static_cast<double>(totalRaw) / (1024.0 * 1024.0),
+        static_cast<double>(totalCompressed) / (1024.0 * 1024.0),
+        static_cast<double>(totalRaw) / static_cast<double>(std::max<std::size_t>(totalCompressed, 1)));
+    return 0;
+}
@@ -0,0 +1,156 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <vector>
+
+#include <glm/geometric.hpp>
+
+#include "Engine/ModelBvh.hpp"
+#include "Engine/ModelCamera.hpp"
+#include "Engine/ModelData.hpp"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+// 1024x1024 cells, about two million triangles.
+constexpr std::uint32_t kCellsPerSide = 1024;
+constexpr int kQueryCount = 20000;
+// Queries checked against a linear scan over every triangle.
+constexpr int kCheckedQueryCount = 64;
+constexpr double kTargetMilliseconds = 0.1;
+const engine::ModelCamera kCamera{25.0f, -15.0f, 0.0f, 2.5f, glm::vec3(0.0f)};
+
+double SecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// A rolling height field split into four submeshes, as a stand-in for a dense scanned model.
+engine::ModelData MakeGridModel() {
+    engine::ModelData model;
+    const std::uint32_t verticesPerSide = kCellsPerSide + 1;
+    for (std::uint32_t row = 0; row < verticesPerSide; ++row) {
+        for (std::uint32_t column = 0; column < verticesPerSide; ++column) {
+            const float u = static_cast<float>(column) / static_cast<float>(kCellsPerSide);
+            const float v = static_cast<float>(row) / static_cast<float>(kCellsPerSide);
+            model.positions.push_back(glm::vec3(u * 2.0f - 1.0f, v * 2.0f - 1.0f, 0.1f * std::sin(u * 17.0f) * std::cos(v * 11.0f)));
+        }
+    }
+    for (std::uint32_t row = 0; row < kCellsPerSide; ++row) {
+        for (std::uint32_t column = 0; column < kCellsPerSide; ++column) {
+            const std::uint32_t corner = row * verticesPerSide + column;
+            model.indices.insert(
+                model.indices.end(),
+                {corner, corner + 1, corner + verticesPerSide, corner + 1, corner + verticesPerSide + 1, corner + verticesPerSide});
+        }
+    }
+
+    const std::uint32_t quarter = static_cast<std::uint32_t>(model.indices.size() / 4);
+    for (std::uint32_t part = 0; part < 4; ++part) {
+        engine::ModelSubmesh submesh{};
+        submesh.indexStart = part * quarter;
+        submesh.indexCount = quarter;
+        model.submeshes.push_back(submesh);
+    }
+    return model;
+}
+
+// Closest hit distance over every triangle, for checking the BVH.
+std::optional<float> IntersectLinear(const engine::ModelData& model, const engine::ModelRay& ray) {
+    std::optional<float> closest;
+    for (std::size_t index = 0; index + 2 < model.indices.size(); index += 3) {
+        const glm::vec3& vertex0 = model.positions[model.indices[index]];
+        const glm::vec3 edge1 = model.positions[model.indices[index + 1]] - vertex0;
+        const glm::vec3 edge2 = model.positions[model.indices[index + 2]] - vertex0;
+        const glm::vec3 p = glm::cross(ray.direction, edge2);
+        const float determinant = glm::dot(edge1, p);
+        if (std::abs(determinant) < 1.0e-12f) {
+            continue;
+        }
+
+        const float inverse = 1.0f / determinant;
+        const glm::vec3 t = ray.origin - vertex0;
+        const float u = glm::dot(t, p) * inverse;
+        const glm::vec3 q = glm::cross(t, edge1);
+        const float v = glm::dot(ray.direction, q) * inverse;
+        const float distance = glm::dot(edge2, q) * inverse;
+        if (u >= 0.0f && v >= 0.0f && u + v <= 1.0f && distance > 0.0f && (!closest || distance < *closest)) {
+            closest = distance;
+        }
+    }
+    return closest;
+}
+
+// Cursor positions scattered over the middle of the window, where the model is, from a fixed seed.
+std::vector<engine::ModelRay> BuildPickRays() {
+    std::vector<engine::ModelRay> rays;
+    rays.reserve(kQueryCount);
+    std::uint32_t state = 12345u;
+    auto next = [&state]() {
+        state = state * 1664525u + 1013904223u;
+        return static_cast<float>(state >> 8) / static_cast<float>(1u << 24);
+    };
+    for (int query = 0; query < kQueryCount; ++query) {
+        rays.push_back(engine::BuildModelSpacePickRay(kCamera, 16.0f / 9.0f, next() * 1.2f - 0.6f, next() * 1.2f - 0.6f));
+    }
+    return rays;
+}
+}
+
+int main() {
+    const engine::ModelData model = MakeGridModel();
+    Clock::time_point start = Clock::now();
+    const engine::ModelBvh bvh = engine::ModelBvh::Build(model.positions, model.indices, model.submeshes);
+    const double buildSeconds = SecondsSince(start);
+
+    const std::vector<engine::ModelRay> rays = BuildPickRays();
+    std::vector<double> queryMilliseconds;
+    queryMilliseconds.reserve(rays.size());
+    std::size_t hitCount = 0;
+    for (const engine::ModelRay& ray : rays) {
+        start = Clock::now();
+        const std::optional<engine::ModelRayHit> hit = bvh.Intersect(ray);
+        queryMilliseconds.push_back(SecondsSince(start) * 1000.0);
+        hitCount += hit ? 1 : 0;
+    }
+
+    int mismatchCount = 0;
+    for (int query = 0; query < kCheckedQueryCount; ++query) {
+        const engine::ModelRay& ray = rays[static_cast<std::size_t>(query) * (rays.size() / kCheckedQueryCount)];
+        const std::optional<engine::ModelRayHit> hit = bvh.Intersect(ray);
+        const std::optional<float> expected = IntersectLinear(model, ray);
+        if (hit.has_value() != expected.has_value() || (hit && std::abs(hit->distance - *expected) > 1.0e-4f * std::max(1.0f, *expected))) {
+            ++mismatchCount;
+        }
+    }
+
+    std::vector<double> sorted = queryMilliseconds;
+    std::sort(sorted.begin(), sorted.end());
+    double totalMilliseconds = 0.0;
+    for (const double milliseconds : sorted) {
+        totalMilliseconds += milliseconds;
+    }
+    const double p99 = sorted[sorted.size() * 99 / 100];
+
+    std::printf(
+        "Model BVH picking: %zu triangles, %zu nodes, built in %.2f s\n",
+        bvh.GetTriangleCount(),
+        bvh.GetNodeCount(),
+        buildSeconds);
+    std::printf(
+        "  %d queries (%zu hits): mean %.4f ms, median %.4f ms, p99 %.4f ms, max %.4f ms; p99 %s the %.1f ms target\n",
+        kQueryCount,
+        hitCount,
+        totalMilliseconds / static_cast<double>(sorted.size()),
+        sorted[sorted.size() / 2],
+        p99,
+        sorted.back(),
+        p99 <= kTargetMilliseconds ? "meets" : "misses",
+        kTargetMilliseconds);
+    std::printf("  %d of %d checked queries disagree with a linear scan\n", mismatchCount, kCheckedQueryCount);
+
+    return mismatchCount == 0 ? 0 : 1;
+}
@@ -0,0 +1,191 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Engine/FbxLoader.hpp"
+#include "Engine/JobSystem.hpp"
+#include "Engine/ModelBvh.hpp"
+#include "Engine/ModelCamera.hpp"
+#include "Engine/ModelData.hpp"
+#include "Engine/RayTracer.hpp"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr std::uint32_t kImageSize = 256;
+const engine::ModelCamera kCamera{25.0f, -15.0f, 0.0f, 2.5f, glm::vec3(0.0f)};
+
+double SecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// A rolling height field facing the camera, so the benchmark has a dense mesh even without the
+// bundled models.
+engine::ModelData MakeGridModel(std::uint32_t cellsPerSide) {
+    engine::ModelData model;
+    const std::uint32_t verticesPerSide = cellsPerSide + 1;
+    for (std::uint32_t row = 0; row < verticesPerSide; ++row) {
+        for (std::uint32_t column = 0; column < verticesPerSide; ++column) {
+            const float u = static_cast<float>(column) / static_cast<float>(cellsPerSide);
+            const float v = static_cast<float>(row) / static_cast<float>(cellsPerSide);
+            model.positions.push_back(glm::vec3(u * 2.0f - 1.0f, v * 2.0f - 1.0f, 0.1f * std::sin(u * 17.0f) * std::cos(v * 11.0f)));
+        }
+    }
+    for (std::uint32_t row = 0; row < cellsPerSide; ++row) {
+        for (std::uint32_t column = 0; column < cellsPerSide; ++column) {
+            const std::uint32_t corner = row * verticesPerSide + column;
+            model.indices.insert(
+                model.indices.end(),
+                {corner, corner + 1, corner + verticesPerSide, corner + 1, corner + verticesPerSide + 1, corner + verticesPerSide});
+        }
+    }
+    return model;
+}
+
+// One primary ray per pixel in the packet layout the tracer uses (4x2 pixels), so the single-ray
+// and packet queries below see exactly the same rays.
+std::vector<engine::ModelRayPacket> BuildPrimaryPackets() {
+    std::vector<engine::ModelRayPacket> packets;
+    for (std::uint32_t packetY = 0; packetY < kImageSize; packetY += 2) {
+        for (std::uint32_t packetX = 0; packetX < kImageSize; packetX += 4) {
+            engine::ModelRayPacket packet;
+            for (std::size_t lane = 0; lane < engine::kModelRayPacketWidth; ++lane) {
+                const float ndcX = (static_cast<float>(packetX + lane % 4) + 0.5f) / kImageSize * 2.0f - 1.0f;
+                const float ndcY = 1.0f - (static_cast<float>(packetY + lane / 4) + 0.5f) / kImageSize * 2.0f;
+                const engine::ModelRay ray = engine::BuildModelSpacePickRay(kCamera, 1.0f, ndcX, ndcY);
+                packet.originX[lane] = ray.origin.x;
+                packet.originY[lane] = ray.origin.y;
+                packet.originZ[lane] = ray.origin.z;
+                packet.directionX[lane] = ray.direction.x;
+                packet.directionY[lane] = ray.direction.y;
+                packet.directionZ[lane] = ray.direction.z;
+                packet.maxDistance[lane] = 100.0f;
+            }
+            packets.push_back(packet);
+        }
+    }
+    return packets;
+}
+
+bool ReportModel(const std::string& name, engine::ModelData model) {
+    const std::size_t triangleCount = model.indices.size() / 3;
+    std::vector<engine::DecodedImage> textures = engine::LoadRayTracerTextures(model);
+    const Clock::time_point buildStart = Clock::now();
+    const engine::RayTracer tracer(model, std::move(textures));
+    const double buildSeconds = SecondsSince(buildStart);
+    const engine::ModelBvh& bvh = tracer.GetBvh();
+    if (bvh.IsEmpty()) {
+        std::fprintf(stderr, "%s has no triangles to trace.\n", name.c_str());
+        return false;
+    }
+
+    // Single thread: the same primary rays one at a time and eight at a time.
+    const std::vector<engine::ModelRayPacket> packets = BuildPrimaryPackets();
+    const double rayCount = static_cast<double>(packets.size() * engine::kModelRayPacketWidth);
+    double singleSeconds = 1.0e9;
+    double packetSeconds = 1.0e9;
+    std::size_t singleHits = 0;
+    std::size_t packetHits = 0;
+    for (int repeat = 0; repeat < 3; ++repeat) {
+        singleHits = 0;
+        Clock::time_point start = Clock::now();
+        for (const engine::ModelRayPacket& packet : packets) {
+            for (std::size_t lane = 0; lane < engine::kModelRayPacketWidth; ++lane) {
+                const engine::ModelRay ray{
+                    glm::vec3(packet.originX[lane], packet.originY[lane], packet.originZ[lane]),
+                    glm::vec3(packet.directionX[lane], packet.directionY[lane], packet.directionZ[lane])};
+                singleHits += bvh.Intersect(ray, packet.maxDistance[lane]).has_value() ? 1 : 0;
+            }
+        }
+        singleSeconds = std::min(singleSeconds, SecondsSince(start));
+
+        packetHits = 0;
+        start = Clock::now();
+        for (const engine::ModelRayPacket& packet : packets) {
+            engine::ModelRayPacketHit hit;
+            bvh.IntersectPacket(packet, hit);
+            for (std::size_t lane = 0; lane < engine::kModelRayPacketWidth; ++lane) {
+                packetHits += hit.triangleIndex[lane] != engine::ModelBvh::kNoTriangle ? 1 : 0;
+            }
+        }
+        packetSeconds = std::min(packetSeconds, SecondsSince(start));
+    }
+    if (singleHits != packetHits) {
+        std::fprintf(stderr, "%s: single-ray and packet queries disagree (%zu, %zu hits).\n", name.c_str(), singleHits, packetHits);
+        return false;
+    }
+
+    // Every worker: a full thumbnail with ambient occlusion.
+    engine::RayTraceStatistics statistics{};
+    const engine::DecodedImage image = tracer.Render(kCamera, engine::kThumbnailRayTraceSettings, statistics);
+    std::size_t coveredPixels = 0;
+    for (std::size_t pixel = 0; pixel < static_cast<std::size_t>(image.width) * image.height; ++pixel) {
+        coveredPixels += image.pixels[pixel * 4 + 3] != 0 ? 1 : 0;
+    }
+
+    std::printf(
+        "%-28s %9zu tris  BVH %7.1f ms  primary rays, 1 thread: single %6.2f Mrays/s, packet %6.2f Mrays/s (%.2fx, %zu hits)\n",
+        name.c_str(),
+        triangleCount,
+        buildSeconds * 1000.0,
+        rayCount / singleSeconds / 1.0e6,
+        rayCount / packetSeconds / 1.0e6,
+        singleSeconds / packetSeconds,
+        packetHits);
+    std::printf(
+        "%-28s thumbnail %ux%u, %u spp, %u AO rays: %.1f ms, %llu primary + %llu occlusion rays, %.2f Mrays/s, %zu pixels covered\n",
+        "",
+        image.width,
+        image.height,
+        engine::kThumbnailRayTraceSettings.samplesPerPixel,
+        engine::kThumbnailRayTraceSettings.occlusionRaysPerSample,
+        statistics.seconds * 1000.0,
+        static_cast<unsigned long long>(statistics.primaryRays),
+        static_cast<unsigned long long>(statistics.occlusionRays),
+        statistics.GetMegaraysPerSecond(),
+        coveredPixels);
+    return coveredPixels > 0;
+}
+}
+
+// Usage: EngineRayTraceBenchmark [model.fbx...]
+// Without arguments, the bundled Wolf and DogKnight models and 64x64 and 512x512 height fields are used.
+int main(int argc, char** argv) {
+    std::vector<std::filesystem::path> modelPaths;
+    for (int argument = 1; argument < argc; ++argument) {
+        modelPaths.emplace_back(argv[argument]);
+    }
+#if defined(ENGINE_TEST_PROJECT_ROOT)
+    if (modelPaths.empty()) {
+        const std::filesystem::path projectRoot(ENGINE_TEST_PROJECT_ROOT);
+        modelPaths.push_back(projectRoot / "Models" / "Wolf" / "Wolf.fbx");
+        modelPaths.push_back(projectRoot / "Models" / "DogKnight" / "Mesh" / "DogPBR.fbx");
+    }
+#endif
+
+    std::printf("Ray tracing, %u job system workers\n", engine::JobSystem::Get().GetWorkerCount());
+    bool succeeded = true;
+    for (const std::filesystem::path& modelPath : modelPaths) {
+        engine::ModelData model;
+        std::string error;
+        if (!engine::FbxLoader::LoadModel(modelPath, model, error)) {
+            std::fprintf(stderr, "Could not load '%s': %s\n", modelPath.string().c_str(), error.c_str());
+            succeeded = false;
+            continue;
+        }
+        succeeded = ReportModel(modelPath.filename().string(), std::move(model)) && succeeded;
+    }
+    if (argc <= 1) {
+        succeeded = ReportModel("height field 64x64", MakeGridModel(64)) && succeeded;
+        succeeded = ReportModel("height field 512x512", MakeGridModel(512)) && succeeded;
+    }
+    return succeeded ? 0 : 1;
+}
@@ -0,0 +1,364 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <glm/vec4.hpp>
+
+#include "Engine/FbxLoader.hpp"
+#include "Engine/ModelCamera.hpp"
+#include "Engine/ModelCook.hpp"
+#include "Engine/ModelData.hpp"
+#include "Engine/TriangleAssembly.hpp"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+struct ProjectedVertex {
+    float x;
+    float y;
+    float depth;
+    bool valid;
+};
+
+constexpr int kViewportWidth = 1280;
+constexpr int kViewportHeight = 720;
+
+// Stand-ins for SDL_Vertex and the SDL renderer's per-triangle slot.
+struct BenchmarkVertex {
+    float x;
+    float y;
+    float red;
+    float green;
+    float blue;
+    float alpha;
+    float u;
+    float v;
+};
+
+struct BenchmarkTriangle {
+    BenchmarkVertex vertices[3];
+    const void* texture;
+    float depth;
+    bool isTransparent;
+};
+
+struct BenchmarkBatch {
+    std::size_t indexStart;
+    std::size_t firstTriangle;
+    std::size_t triangleCount;
+    const void* texture;
+    float opacity;
+    bool isTransparent;
+};
+
+// A rolling height field, so the benchmark has a dense mesh even without the bundled models.
+engine::ModelData MakeGridModel(std::uint32_t cellsPerSide) {
+    engine::ModelData model;
+    const std::uint32_t verticesPerSide = cellsPerSide + 1;
+    for (std::uint32_t row = 0; row < verticesPerSide; ++row) {
+        for (std::uint32_t column = 0; column < verticesPerSide; ++column) {
+            const float u = static_cast<float>(column) / static_cast<float>(cellsPerSide);
+            const float v = static_cast<float>(row) / static_cast<float>(cellsPerSide);
+            model.positions.push_back(glm::vec3(u * 2.0f - 1.0f, 0.1f * std::sin(u * 17.0f) * std::cos(v * 11.0f), v * 2.0f - 1.0f));
+            model.texCoords.push_back(glm::vec2(u, v));
+        }
+    }
+    for (std::uint32_t row = 0; row < cellsPerSide; ++row) {
+        for (std::uint32_t column = 0; column < cellsPerSide; ++column) {
+            const std::uint32_t corner = row * verticesPerSide + column;
+            model.indices.insert(
+                model.indices.end(),
+                {corner, corner + verticesPerSide, corner + 1, corner + 1, corner + verticesPerSide, corner + verticesPerSide + 1});
+        }
+    }
+    return model;
+}
+
+struct BenchmarkView {
+    const char* name;
+    engine::ModelCamera camera;
+};
+
+// The whole model in view, and a close-up that leaves about half of it outside the viewport.
+const BenchmarkView kViews[] = {
+    {"fit", engine::ModelCamera{35.0f, 20.0f, 0.0f, 1.6f, glm::vec3(0.0f)}},
+    {"close-up", engine::ModelCamera{35.0f, 20.0f, 0.0f, 1.0f, glm::vec3(0.6f, 0.0f, 0.3f)}},
+};
+
+// Projects the model fitted into a box two units across.
+std::vector<ProjectedVertex> ProjectModel(const engine::ModelData& model, const engine::ModelCamera& camera) {
+    glm::vec3 minimum(1e30f);
+    glm::vec3 maximum(-1e30f);
+    for (const glm::vec3& position : model.positions) {
+        minimum = glm::min(minimum, position);
+        maximum = glm::max(maximum, position);
+    }
+    const glm::vec3 center = (minimum + maximum) * 0.5f;
+    const float extent = std::max({maximum.x - minimum.x, maximum.y - minimum.y, maximum.z - minimum.z, 1e-6f});
+
+    const glm::mat4 mvp = engine::BuildModelViewProjection(camera, static_cast<float>(kViewportWidth) / static_cast<float>(kViewportHeight));
+    std::vector<ProjectedVertex> projected;
+    projected.reserve(model.positions.size());
+    for (const glm::vec3& position : model.positions) {
+        const glm::vec4 clip = mvp * glm::vec4((position - center) * (2.0f / extent), 1.0f);
+        if (clip.w <= 0.0001f) {
+            projected.push_back({0.0f, 0.0f, 1.0f, false});
+            continue;
+        }
+        const glm::vec3 ndc = glm::vec3(clip) / clip.w;
+        projected.push_back({
+            (ndc.x * 0.5f + 0.5f) * static_cast<float>(kViewportWidth),
+            (1.0f - (ndc.y * 0.5f + 0.5f)) * static_cast<float>(kViewportHeight),
+            ndc.z,
+            ndc.z >= -1.0f && ndc.z <= 1.0f});
+    }
+    return projected;
+}
+
+std::vector<BenchmarkBatch> BuildBatches(const engine::ModelData& model, std::size_t& outTriangleCount) {
+    static const int kTexture = 0;
+    std::vector<BenchmarkBatch> batches;
+    outTriangleCount = 0;
+    auto addBatch = [&](std::size_t indexStart, std::size_t indexCount, float opacity, bool isTransparent) {
+        const std::size_t triangleCount = std::min(indexCount, model.indices.size() - std::min(indexStart, model.indices.size())) / 3;
+        if (triangleCount > 0) {
+            batches.push_back(BenchmarkBatch{indexStart, outTriangleCount, triangleCount, &kTexture, opacity, isTransparent});
+            outTriangleCount += triangleCount;
+        }
+    };
+    for (const engine::ModelSubmesh& submesh : model.submeshes) {
+        const engine::ModelMaterial* material = model.FindMaterial(submesh);
+        const float opacity = material ? std::clamp(material->opacity, 0.0f, 1.0f) : 1.0f;
+        addBatch(submesh.indexStart, submesh.indexCount, opacity, (material && material->isTransparent) || opacity < 0.999f);
+    }
+    if (batches.empty()) {
+        addBatch(0, model.indices.size(), 1.0f, false);
+    }
+    return batches;
+}
+
+void WriteTriangle(
+    BenchmarkTriangle& triangle,
+    const BenchmarkBatch& batch,
+    const engine::ModelData& model,
+    std::span<const ProjectedVertex> projected,
+    std::uint32_t i0,
+    std::uint32_t i1,
+    std::uint32_t i2) {
+    const std::uint32_t corners[3] = {i0, i1, i2};
+    for (int corner = 0; corner < 3; ++corner) {
+        const ProjectedVertex& vertex = projected[corners[corner]];
+        const glm::vec2& uv = model.texCoords[corners[corner]];
+        triangle.vertices[corner] = BenchmarkVertex{vertex.x, vertex.y, 1.0f, 1.0f, 1.0f, batch.opacity, 1.0f - uv.x, 1.0f - uv.y};
+    }
+    triangle.depth = (projected[i0].depth + projected[i1].depth + projected[i2].depth) / 3.0f;
+}
+
+// The loop the SDL renderer ran before the kernels: a batch lookup, index checks and early-outs
+// for every triangle.
+void AssembleBranching(
+    const engine::ModelData& model,
+    const std::vector<BenchmarkBatch>& batches,
+    std::span<const ProjectedVertex> projected,
+    std::vector<BenchmarkTriangle>& output) {
+    const float viewportRight = static_cast<float>(kViewportWidth);
+    const float viewportBottom = static_cast<float>(kViewportHeight);
+    auto batch = batches.begin();
+    for (std::size_t triangleIndex = 0; triangleIndex < output.size(); ++triangleIndex) {
+        while (triangleIndex >= batch->firstTriangle + batch->triangleCount) {
+            ++batch;
+        }
+
+        const std::size_t index = batch->indexStart + (triangleIndex - batch->firstTriangle) * 3;
+        const std::uint32_t i0 = model.indices[index];
+        const std::uint32_t i1 = model.indices[index + 1];
+        const std::uint32_t i2 = model.indices[index + 2];
+        if (i0 >= projected.size() || i1 >= projected.size() || i2 >= projected.size()) {
+            continue;
+        }
+
+        const ProjectedVertex& p0 = projected[i0];
+        const ProjectedVertex& p1 = projected[i1];
+        const ProjectedVertex& p2 = projected[i2];
+        if (!p0.valid || !p1.valid || !p2.valid) {
+            continue;
+        }
+        if ((p0.x < 0.0f && p1.x < 0.0f && p2.x < 0.0f) ||
+            (p0.y < 0.0f && p1.y < 0.0f && p2.y < 0.0f) ||
+            (p0.x > viewportRight && p1.x > viewportRight && p2.x > viewportRight) ||
+            (p0.y > viewportBottom && p1.y > viewportBottom && p2.y > viewportBottom)) {
+            continue;
+        }
+
+        BenchmarkTriangle& triangle = output[triangleIndex];
+        triangle.texture = batch->texture;
+        triangle.isTransparent = batch->isTransparent;
+        WriteTriangle(triangle, *batch, model, projected, i0, i1, i2);
+    }
+}
+
+template <bool kIndicesValidated, bool kTransparent>
+void AssembleBatchKernel(
+    const engine::ModelData& model,
+    const BenchmarkBatch& batch,
+    std::span<const ProjectedVertex> projected,
+    std::span<const std::uint8_t> outcodes,
+    BenchmarkTriangle* output,
+    engine::TriangleRejectCounts& rejected) {
+    engine::AssembleTriangles<kIndicesValidated, true>(
+        std::span<const std::uint32_t>(model.indices.data() + batch.indexStart, batch.triangleCount * 3),
+        outcodes,
+        rejected,
+        [&](std::size_t triangleIndex, std::uint32_t i0, std::uint32_t i1, std::uint32_t i2, bool keep) {
+            if (!keep) {
+                return;
+            }
+
+            BenchmarkTriangle& triangle = output[triangleIndex];
+            WriteTriangle(triangle, batch, model, projected, i0, i1, i2);
+            triangle.texture = batch.texture;
+            triangle.isTransparent = kTransparent;
+        });
+}
+
+template <bool kIndicesValidated>
+void AssembleSpecialized(
+    const engine::ModelData& model,
+    const std::vector<BenchmarkBatch>& batches,
+    std::span<const ProjectedVertex> projected,
+    std::vector<std::uint8_t>& outcodes,
+    std::vector<BenchmarkTriangle>& output) {
+    // The renderer computes outcodes in its projection pass; they are timed here with assembly.
+    const engine::TriangleCullRect viewport{0.0f, 0.0f, static_cast<float>(kViewportWidth), static_cast<float>(kViewportHeight)};
+    outcodes.resize(projected.size());
+    for (std::size_t vertex = 0; vertex < projected.size(); ++vertex) {
+        outcodes[vertex] = engine::ComputeVertexOutcode(projected[vertex].x, projected[vertex].y, projected[vertex].valid, viewport);
+    }
+
+    engine::TriangleRejectCounts rejected{};
+    for (const BenchmarkBatch& batch : batches) {
+        BenchmarkTriangle* batchOutput = output.data() + batch.firstTriangle;
+        if (batch.isTransparent) {
+            AssembleBatchKernel<kIndicesValidated, true>(model, batch, projected, outcodes, batchOutput, rejected);
+        } else {
+            AssembleBatchKernel<kIndicesValidated, false>(model, batch, projected, outcodes, batchOutput, rejected);
+        }
+    }
+}
+
+std::size_t CountKept(const std::vector<BenchmarkTriangle>& triangles) {
+    return static_cast<std::size_t>(std::count_if(triangles.begin(), triangles.end(), [](const BenchmarkTriangle& triangle) {
+        return triangle.texture != nullptr;
+    }));
+}
+
+// Best of several runs. Each run starts from fresh zeroed slots, as the renderer's frame does.
+template <typename Assemble>
+double TimeBest(std::size_t triangleCount, std::size_t& outKept, Assemble&& assemble) {
+    double best = 1e30;
+    for (int run = 0; run < 15; ++run) {
+        std::vector<BenchmarkTriangle> output(triangleCount);
+        const Clock::time_point start = Clock::now();
+        assemble(output);
+        best = std::min(best, std::chrono::duration<double>(Clock::now() - start).count());
+        outKept = CountKept(output);
+    }
+    return best;
+}
+
+bool ReportView(
+    const std::string& name,
+    const engine::ModelData& model,
+    const std::vector<BenchmarkBatch>& batches,
+    std::size_t triangleCount,
+    const std::vector<ProjectedVertex>& projected) {
+    std::vector<std::uint8_t> outcodes;
+    std::size_t keptBranching = 0;
+    std::size_t keptChecked = 0;
+    std::size_t keptValidated = 0;
+    const double branchingSeconds = TimeBest(triangleCount, keptBranching, [&](std::vector<BenchmarkTriangle>& output) {
+        AssembleBranching(model, batches, projected, output);
+    });
+    const double checkedSeconds = TimeBest(triangleCount, keptChecked, [&](std::vector<BenchmarkTriangle>& output) {
+        AssembleSpecialized<false>(model, batches, projected, outcodes, output);
+    });
+    const double validatedSeconds = TimeBest(triangleCount, keptValidated, [&](std::vector<BenchmarkTriangle>& output) {
+        AssembleSpecialized<true>(model, batches, projected, outcodes, output);
+    });
+    if (keptBranching != keptChecked || keptBranching != keptValidated) {
+        std::fprintf(stderr, "%s: kernels disagree (%zu, %zu, %zu triangles kept).\n", name.c_str(), keptBranching, keptChecked, keptValidated);
+        return false;
+    }
+
+    const double megaTriangles = static_cast<double>(triangleCount) / 1e6;
+    std::printf(
+        "%-32s %9zu tris %5zu batches  branching %7.1f Mtri/s  checked %7.1f Mtri/s (%4.2fx)  validated %7.1f Mtri/s (%4.2fx)\n",
+        name.c_str(),
+        triangleCount,
+        batches.size(),
+        megaTriangles / std::max(branchingSeconds, 1e-9),
+        megaTriangles / std::max(checkedSeconds, 1e-9),
+        branchingSeconds / std::max(checkedSeconds, 1e-9),
+        megaTriangles / std::max(validatedSeconds, 1e-9),
+        branchingSeconds / std::max(validatedSeconds, 1e-9));
+    return true;
+}
+
+bool ReportModel(const std::string& name, engine::ModelData model) {
+    engine::ValidateTriangleIndices(model);
+    if (!model.IsValid() || model.texCoords.size() != model.positions.size()) {
+        std::fprintf(stderr, "%s has no textured geometry to assemble.\n", name.c_str());
+        return false;
+    }
+
+    std::size_t triangleCount = 0;
+    const std::vector<BenchmarkBatch> batches = BuildBatches(model, triangleCount);
+    for (const BenchmarkView& view : kViews) {
+        if (!ReportView(name + " (" + view.name + ")", model, batches, triangleCount, ProjectModel(model, view.camera))) {
+            return false;
+        }
+    }
+    return true;
+}
+}
+
+// Usage: EngineTriangleAssemblyBenchmark [model.fbx...]
+// Without arguments, the bundled Wolf and DogKnight models and a 512x512 height field are used.
+int main(int argc, char** argv) {
+    std::vector<std::filesystem::path> modelPaths;
+    for (int argument = 1; argument < argc; ++argument) {
+        modelPaths.emplace_back(argv[argument]);
+    }
+#if defined(ENGINE_TEST_PROJECT_ROOT)
+    if (modelPaths.empty()) {
+        const std::filesystem::path projectRoot(ENGINE_TEST_PROJECT_ROOT);
+        modelPaths.push_back(projectRoot / "Models" / "Wolf" / "Wolf.fbx");
+        modelPaths.push_back(projectRoot / "Models" / "DogKnight" / "Mesh" / "DogPBR.fbx");
+    }
+#endif
+
+    std::printf("Triangle assembly, single thread, %dx%d viewport\n", kViewportWidth, kViewportHeight);
+    bool succeeded = true;
+    for (const std::filesystem::path& modelPath : modelPaths) {
+        engine::ModelData model;
+        std::string error;
+        if (!engine::FbxLoader::LoadModel(modelPath, model, error)) {
+            std::fprintf(stderr, "Could not load '%s': %s\n", modelPath.string().c_str(), error.c_str());
+            succeeded = false;
+            continue;
+        }
+        succeeded = ReportModel(modelPath.filename().string(), std::move(model)) && succeeded;
+    }
+    if (argc <= 1) {
+        succeeded = ReportModel("height field 512x512", MakeGridModel(512)) && succeeded;
+    }
+    return succeeded ? 0 : 1;
+}
@@ -3,7 +3,9 @@
 #include <string>
 #include <vector>
 
+#include "Engine/CookedModel.hpp"
 #include "Engine/FbxLoader.hpp"
+#include "Engine/ModelCook.hpp"
 
 namespace {
 int RunFbxLoaderIntegrationTests() {
@@ -65,11 +67,57 @@ int RunFbxLoaderIntegrationTests() {
                 ++failureCount;
             }
 
-            if (submesh.textureIndex >= 0 && static_cast<std::size_t>(submesh.textureIndex) >= loadedModel.texturePaths.size()) {
-                std::cerr << "Expected submesh texture index to reference loaded texture path list for asset: " << knownAsset.string() << "\n";
+            const engine::ModelMaterial* material = loadedModel.FindMaterial(submesh);
+            if (!material) {
+                std::cerr << "Expected submesh to reference the material table for asset: " << knownAsset.string() << "\n";
                 ++failureCount;
+                continue;
             }
+
+            if (material->textureIndex >= 0 && static_cast<std::size_t>(material->textureIndex) >= loadedModel.texturePaths.size()) {
+                std::cerr << "Expected material texture index to reference loaded texture path list for asset: " << knownAsset.string() << "\n";
+                ++failureCount;
+            }
+        }
+
+        if (loadedModel.materials.size() > loadedModel.submeshes.size()) {
+            std::cerr << "Expected materials to be resolved once and shared between submeshes for asset: " << knownAsset.string() << "\n";
+            ++failureCount;
+        }
+
+        engine::ModelData mergedModel = loadedModel;
+        const engine::SubmeshMergeStats mergeStats = engine::MergeSubmeshesByMaterial(mergedModel);
+        if (mergedModel.indices.size() != loadedModel.indices.size() ||
+            mergeStats.submeshCountAfter > mergeStats.submeshCountBefore ||
+            mergedModel.submeshes.size() != mergedModel.materials.size()) {
+            std::cerr << "Expected merging by material to keep every index and leave one submesh per material for asset: " << knownAsset.string() << "\n";
+            ++failureCount;
+        }
+
+        engine::ModelData geometryModel;
+        std::string geometryError;
+        if (!engine::FbxLoader::LoadModel(knownAsset, engine::kGeometryModelLoadRequest, geometryModel, geometryError) ||
+            geometryModel.indices.size() != loadedModel.indices.size() || !geometryModel.texCoords.empty() ||
+            !geometryModel.materials.empty() || !geometryModel.animations.empty()) {
+            std::cerr << "Expected a geometry-only load to skip UVs, materials and animations for asset: " << knownAsset.string() << "\n";
+            ++failureCount;
+        }
+
+        const std::filesystem::path cacheDirectory = std::filesystem::temp_directory_path() / "EngineIntegrationModelCache";
+        std::filesystem::remove_all(cacheDirectory);
+        engine::LazyModel cookedModel;
+        std::string cacheError;
+        engine::ModelData cachedModel;
+        if (!engine::OpenCachedModel(knownAsset, cacheDirectory, cookedModel, cacheError) ||
+            cookedModel.GetSummary().triangleCount * 3 != loadedModel.indices.size() ||
+            !cookedModel.Materialize(engine::kFullModelLoadRequest, cachedModel, cacheError) ||
+            cachedModel.positions != loadedModel.positions || cachedModel.texCoords != loadedModel.texCoords ||
+            cachedModel.texturePaths != loadedModel.texturePaths || cachedModel.submeshes.size() != loadedModel.submeshes.size() ||
+            cachedModel.animations.size() != loadedModel.animations.size()) {
+            std::cerr << "Expected the cooked cache to reproduce the loaded model for asset: " << knownAsset.string() << " " << cacheError << "\n";
+            ++failureCount;
         }
+        std::filesystem::remove_all(cacheDirectory);
 
         for (const engine::AnimationClip& clip : loadedModel.animations) {
             if (clip.name.empty()) {
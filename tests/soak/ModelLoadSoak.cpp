@@ -0,0 +1,292 @@
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <SDL3/SDL.h>
+#include <glm/vec3.hpp>
+
+#include "Engine/FbxLoader.hpp"
+#include "Engine/ModelCamera.hpp"
+#include "Engine/ModelCook.hpp"
+#include "Engine/ModelData.hpp"
+#include "Engine/ProcessMemory.hpp"
+#include "Engine/SoftwareRenderer.hpp"
+
+// Loads every FBX under Models/ over and over, the way a long kiosk session opens models, and
+// fails if resident memory, the heap or load latency drift between the start and the end of the
+// run. Each load replaces the previous model and its textures in the software renderer.
+//
+// EngineModelLoadSoak [--passes N] [--frames N] [--max-rss-growth-mib N] [--max-heap-growth-mib N]
+//                     [--max-latency-growth F] [model.fbx...]
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr double kMebibyte = 1024.0 * 1024.0;
+
+struct SoakOptions {
+    int passes = 200;
+    int framesPerLoad = 2;
+    double maxResidentGrowthMebibytes = 64.0;
+    double maxHeapGrowthMebibytes = 32.0;
+    // Allowed rise of the median pass time, as a fraction of the baseline.
+    double maxLatencyGrowth = 0.5;
+    std::vector<std::filesystem::path> models;
+};
+
+// One pass loads and draws every model once.
+struct PassSample {
+    engine::ProcessMemorySample memory;
+    double seconds;
+    double slowestLoadSeconds;
+};
+
+bool ParseOptions(int argc, char** argv, SoakOptions& options) {
+    for (int argument = 1; argument < argc; ++argument) {
+        const char* flag = argv[argument];
+        const bool hasValue = argument + 1 < argc;
+        if (std::strcmp(flag, "--passes") == 0 && hasValue) {
+            options.passes = std::max(std::atoi(argv[++argument]), 3);
+        } else if (std::strcmp(flag, "--frames") == 0 && hasValue) {
+            options.framesPerLoad = std::max(std::atoi(argv[++argument]), 1);
+        } else if (std::strcmp(flag, "--max-rss-growth-mib") == 0 && hasValue) {
+            options.maxResidentGrowthMebibytes = std::atof(argv[++argument]);
+        } else if (std::strcmp(flag, "--max-heap-growth-mib") == 0 && hasValue) {
+            options.maxHeapGrowthMebibytes = std::atof(argv[++argument]);
+        } else if (std::strcmp(flag, "--max-latency-growth") == 0 && hasValue) {
+            options.maxLatencyGrowth = std::atof(argv[++argument]);
+        } else if (flag[0] == '-') {
+            std::fprintf(stderr, "Unknown or incomplete option: %s\n", flag);
+            return false;
+        } else {
+            options.models.emplace_back(flag);
+        }
+    }
+    return true;
+}
+
+std::vector<std::filesystem::path> FindModels(const std::filesystem::path& root) {
+    std::vector<std::filesystem::path> models;
+    std::error_code walkError;
+    for (std::filesystem::recursive_directory_iterator entry(root, walkError), end; !walkError && entry != end; entry.increment(walkError)) {
+        std::string extension = entry->path().extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char character) {
+            return static_cast<char>(std::tolower(character));
+        });
+        if (extension == ".fbx" && entry->is_regular_file()) {
+            models.push_back(entry->path());
+        }
+    }
+    std::sort(models.begin(), models.end());
+    return models;
+}
+
+// A headless window: the offscreen video driver where SDL has it, the dummy driver otherwise.
+// SDL_VIDEO_DRIVER in the environment still wins.
+SDL_Window* CreateHeadlessWindow() {
+    for (const char* driver : {"offscreen", "dummy"}) {
+        SDL_SetHint(SDL_HINT_VIDEO_DRIVER, driver);
+        if (!SDL_Init(SDL_INIT_VIDEO)) {
+            continue;
+        }
+        if (SDL_Window* window = SDL_CreateWindow("Engine soak", 640, 360, SDL_WINDOW_HIDDEN)) {
+            return window;
+        }
+        SDL_Quit();
+    }
+    return nullptr;
+}
+
+template <typename Value>
+double Median(std::vector<Value> values) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    const std::size_t middle = values.size() / 2;
+    std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(middle), values.end());
+    return static_cast<double>(values[middle]);
+}
+
+// Median of one measurement over passes [begin, end).
+template <typename Extract>
+double WindowMedian(const std::vector<PassSample>& samples, std::size_t begin, std::size_t end, Extract extract) {
+    std::vector<double> values;
+    for (std::size_t pass = begin; pass < end; ++pass) {
+        values.push_back(static_cast<double>(extract(samples[pass])));
+    }
+    return Median(std::move(values));
+}
+}
+
+int main(int argc, char** argv) {
+    SoakOptions options;
+    if (!ParseOptions(argc, argv, options)) {
+        return 1;
+    }
+    if (options.models.empty()) {
+        options.models = FindModels(std::filesystem::path(ENGINE_TEST_PROJECT_ROOT) / "Models");
+    }
+    if (options.models.empty()) {
+        std::fprintf(stderr, "No FBX models to soak.\n");
+        return 1;
+    }
+
+    SDL_Window* window = CreateHeadlessWindow();
+    if (!window) {
+        std::fprintf(stderr, "Could not create a headless SDL window: %s\n", SDL_GetError());
+        return 1;
+    }
+    engine::SoftwareRenderer renderer;
+    std::string rendererError;
+    if (!renderer.Initialize(window, rendererError)) {
+        std::fprintf(stderr, "Could not create the software renderer: %s\n", rendererError.c_str());
+        SDL_DestroyWindow(window);
+        SDL_Quit();
+        return 1;
+    }
+
+    const engine::ModelCamera camera{35.0f, -20.0f, 0.0f, 4.0f, glm::vec3(0.0f)};
+    std::vector<bool> loadable(options.models.size(), true);
+    std::vector<PassSample> samples;
+    samples.reserve(static_cast<std::size_t>(options.passes));
+    int loadFailures = 0;
+
+    std::printf("%zu model(s), %d pass(es), %d frame(s) per load\n", options.models.size(), options.passes, options.framesPerLoad);
+    std::printf("%6s %12s %12s %12s %10s %12s\n", "pass", "rss MiB", "heap MiB", "free MiB", "pass s", "slowest ms");
+    for (int pass = 0; pass < options.passes; ++pass) {
+        const Clock::time_point passStart = Clock::now();
+        double slowestLoadSeconds = 0.0;
+        for (std::size_t modelIndex = 0; modelIndex < options.models.size(); ++modelIndex) {
+            if (!loadable[modelIndex]) {
+                continue;
+            }
+
+            const Clock::time_point loadStart = Clock::now();
+            engine::ModelData model;
+            std::string loadError;
+            if (!engine::FbxLoader::LoadModel(options.models[modelIndex], model, loadError)) {
+                // Files the loader never accepts are dropped on the first pass; a later failure
+                // means something changed during the run.
+                if (pass > 0) {
+                    std::fprintf(stderr, "Pass %d: %s failed to load: %s\n", pass, options.models[modelIndex].string().c_str(), loadError.c_str());
+                    ++loadFailures;
+                } else {
+                    std::printf("Skipping %s: %s\n", options.models[modelIndex].string().c_str(), loadError.c_str());
+                }
+                loadable[modelIndex] = false;
+                continue;
+            }
+            (void)engine::ValidateTriangleIndices(model);
+
+            // The first frame decodes and uploads the textures, so it counts toward the load.
+            for (int frame = 0; frame < options.framesPerLoad; ++frame) {
+                renderer.BeginFrame();
+                renderer.RenderModelWireframe(model, [&camera]() { return camera; }, false);
+                renderer.EndFrame();
+                if (frame == 0) {
+                    slowestLoadSeconds = std::max(slowestLoadSeconds, std::chrono::duration<double>(Clock::now() - loadStart).count());
+                }
+            }
+        }
+
+        const PassSample sample{
+            engine::SampleProcessMemory(),
+            std::chrono::duration<double>(Clock::now() - passStart).count(),
+            slowestLoadSeconds};
+        samples.push_back(sample);
+        std::printf(
+            "%6d %12.1f %12.1f %12.1f %10.3f %12.1f\n",
+            pass,
+            static_cast<double>(sample.memory.residentBytes) / kMebibyte,
+            static_cast<double>(sample.memory.heapInUseBytes) / kMebibyte,
+            static_cast<double>(sample.memory.heapFreeBytes) / kMebibyte,
+            sample.seconds,
+            sample.slowestLoadSeconds * 1000.0);
+        std::fflush(stdout);
+    }
+
+    renderer.Shutdown();
+    SDL_DestroyWindow(window);
+    SDL_Quit();
+
+    if (std::none_of(loadable.begin(), loadable.end(), [](bool canLoad) { return canLoad; })) {
+        std::fprintf(stderr, "None of the models could be loaded.\n");
+        return 1;
+    }
+
+    // The first passes fill caches and grow the heap to its working size, so the baseline is
+    // taken after them; both windows use medians so a single slow pass does not decide the result.
+    const std::size_t passCount = samples.size();
+    const std::size_t windowPasses = std::max<std::size_t>(passCount / 10, 1);
+    const std::size_t baselineBegin = std::min(windowPasses, passCount - windowPasses);
+    const std::size_t baselineEnd = baselineBegin + windowPasses;
+    const std::size_t finalBegin = std::max(passCount - windowPasses, baselineEnd);
+    if (finalBegin >= passCount) {
+        std::fprintf(stderr, "Too few passes to compare a baseline with the end of the run.\n");
+        return 1;
+    }
+
+    auto resident = [](const PassSample& sample) { return sample.memory.residentBytes; };
+    auto heapInUse = [](const PassSample& sample) { return sample.memory.heapInUseBytes; };
+    auto heapFree = [](const PassSample& sample) { return sample.memory.heapFreeBytes; };
+    auto passSeconds = [](const PassSample& sample) { return sample.seconds; };
+    const double residentGrowth =
+        (WindowMedian(samples, finalBegin, passCount, resident) - WindowMedian(samples, baselineBegin, baselineEnd, resident)) / kMebibyte;
+    const double heapInUseGrowth =
+        (WindowMedian(samples, finalBegin, passCount, heapInUse) - WindowMedian(samples, baselineBegin, baselineEnd, heapInUse)) / kMebibyte;
+    const double heapFreeGrowth =
+        (WindowMedian(samples, finalBegin, passCount, heapFree) - WindowMedian(samples, baselineBegin, baselineEnd, heapFree)) / kMebibyte;
+    const double baselineSeconds = WindowMedian(samples, baselineBegin, baselineEnd, passSeconds);
+    const double latencyGrowth = baselineSeconds > 0.0
+        ? WindowMedian(samples, finalBegin, passCount, passSeconds) / baselineSeconds - 1.0
+        : 0.0;
+
+    std::printf(
+        "Passes %zu-%zu against %zu-%zu: resident %+.1f MiB, heap in use %+.1f MiB, heap free %+.1f MiB, pass time %+.1f%%\n",
+        finalBegin,
+        passCount - 1,
+        baselineBegin,
+        baselineEnd - 1,
+        residentGrowth,
+        heapInUseGrowth,
+        heapFreeGrowth,
+        latencyGrowth * 100.0);
+
+    int failures = loadFailures;
+    if (residentGrowth > options.maxResidentGrowthMebibytes) {
+        std::fprintf(stderr, "Resident memory grew %.1f MiB (limit %.1f).\n", residentGrowth, options.maxResidentGrowthMebibytes);
+        ++failures;
+    }
+    if (samples.back().memory.heapStatisticsAvailable) {
+        if (heapInUseGrowth > options.maxHeapGrowthMebibytes) {
+            std::fprintf(stderr, "Heap in use grew %.1f MiB (limit %.1f); something is leaking.\n", heapInUseGrowth, options.maxHeapGrowthMebibytes);
+            ++failures;
+        }
+        if (heapFreeGrowth > options.maxHeapGrowthMebibytes) {
+            std::fprintf(stderr, "Free heap grew %.1f MiB (limit %.1f); the heap is fragmenting.\n", heapFreeGrowth, options.maxHeapGrowthMebibytes);
+            ++failures;
+        }
+    } else {
+        std::printf("Allocator statistics are not available on this platform; only resident memory is checked.\n");
+    }
+    if (latencyGrowth > options.maxLatencyGrowth) {
+        std::fprintf(stderr, "Pass time grew %.1f%% (limit %.1f%%).\n", latencyGrowth * 100.0, options.maxLatencyGrowth * 100.0);
+        ++failures;
+    }
+
+    if (failures > 0) {
+        std::fprintf(stderr, "Model load soak failed with %d failure(s).\n", failures);
+        return 1;
+    }
+    std::printf("Model load soak passed.\n");
+    return 0;
+}
@@ -0,0 +1,128 @@
+#include <atomic>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Engine/BatchFileReader.hpp"
+#include "Engine/JobSystem.hpp"
+
+namespace {
+std::byte PatternByte(std::size_t fileIndex, std::size_t offset) {
+    return static_cast<std::byte>((fileIndex * 31 + offset * 7) & 0xFFu);
+}
+
+int CheckBackend(engine::JobSystem& jobs, engine::FileReadBackend backend, const std::vector<std::filesystem::path>& paths, const std::vector<std::size_t>& sizes) {
+    int failureCount = 0;
+    const char* backendName = engine::GetFileReadBackendName(backend);
+
+    std::vector<engine::FileReadResult> files;
+    std::vector<std::atomic<int>> readyCounts(paths.size());
+    engine::FileBatchStatistics statistics{};
+    engine::ReadFileBatch(
+        jobs,
+        paths,
+        files,
+        [&](std::size_t fileIndex) { readyCounts[fileIndex].fetch_add(1); },
+        backend,
+        &statistics);
+
+    std::uint64_t expectedBytes = 0;
+    bool contentsMatch = files.size() == paths.size();
+    for (std::size_t fileIndex = 0; contentsMatch && fileIndex < sizes.size(); ++fileIndex) {
+        const engine::FileReadResult& file = files[fileIndex];
+        contentsMatch = file.succeeded && file.bytes.size() == sizes[fileIndex];
+        for (std::size_t offset = 0; contentsMatch && offset < file.bytes.size(); ++offset) {
+            contentsMatch = file.bytes[offset] == PatternByte(fileIndex, offset);
+        }
+        expectedBytes += sizes[fileIndex];
+    }
+    if (!contentsMatch || statistics.bytesRead != expectedBytes || statistics.fileCount != paths.size()) {
+        std::cerr << "Expected the " << backendName << " backend to read every file intact.\n";
+        ++failureCount;
+    }
+
+    // Paths after the generated files are a missing file and a directory.
+    for (std::size_t fileIndex = sizes.size(); fileIndex < paths.size(); ++fileIndex) {
+        if (files[fileIndex].succeeded || files[fileIndex].error.empty()) {
+            std::cerr << "Expected the " << backendName << " backend to report '" << paths[fileIndex].string() << "' as unreadable.\n";
+            ++failureCount;
+        }
+    }
+
+    bool readyOnce = true;
+    for (const std::atomic<int>& readyCount : readyCounts) {
+        readyOnce = readyOnce && readyCount.load() == 1;
+    }
+    if (!readyOnce) {
+        std::cerr << "Expected the " << backendName << " backend to report every file ready exactly once.\n";
+        ++failureCount;
+    }
+
+    if (statistics.backend != backend) {
+        std::cerr << "Expected the " << backendName << " backend to be used when requested and available.\n";
+        ++failureCount;
+    }
+    return failureCount;
+}
+
+int RunBatchFileReaderTests() {
+    int failureCount = 0;
+    engine::JobSystem jobs(2);
+
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "EngineBatchFileReaderTests";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+
+    // Enough files to wrap the submission queue, including empty and multi-page ones.
+    std::vector<std::filesystem::path> paths;
+    std::vector<std::size_t> sizes;
+    for (std::size_t fileIndex = 0; fileIndex < 150; ++fileIndex) {
+        const std::size_t size = fileIndex == 0 ? 0 : (fileIndex % 7 == 0 ? 300000 : fileIndex * 61);
+        paths.push_back(directory / ("file" + std::to_string(fileIndex) + ".bin"));
+        sizes.push_back(size);
+        std::ofstream output(paths.back(), std::ios::binary);
+        for (std::size_t offset = 0; offset < size; ++offset) {
+            output.put(static_cast<char>(PatternByte(fileIndex, offset)));
+        }
+    }
+    paths.push_back(directory / "missing.bin");
+    paths.push_back(directory);
+
+    failureCount += CheckBackend(jobs, engine::FileReadBackend::ThreadPool, paths, sizes);
+    if (engine::IsIoUringAvailable()) {
+        failureCount += CheckBackend(jobs, engine::FileReadBackend::IoUring, paths, sizes);
+    } else {
+        std::vector<engine::FileReadResult> files;
+        engine::FileBatchStatistics statistics{};
+        engine::ReadFileBatch(jobs, paths, files, {}, engine::FileReadBackend::IoUring, &statistics);
+        if (statistics.backend != engine::FileReadBackend::ThreadPool || files.size() != paths.size() || !files[1].succeeded) {
+            std::cerr << "Expected io_uring requests to fall back to the thread pool when io_uring is unavailable.\n";
+            ++failureCount;
+        }
+    }
+
+    std::vector<engine::FileReadResult> noFiles{engine::FileReadResult{true, {}, {}}};
+    engine::ReadFileBatch(jobs, {}, noFiles);
+    if (!noFiles.empty()) {
+        std::cerr << "Expected an empty batch to produce no results.\n";
+        ++failureCount;
+    }
+
+    std::filesystem::remove_all(directory);
+    return failureCount;
+}
+}
+
+int main() {
+    const int failures = RunBatchFileReaderTests();
+    if (failures > 0) {
+        std::cerr << "BatchFileReader unit tests failed with " << failures << " failure(s).\n";
+        return 1;
+    }
+
+    std::cout << "BatchFileReader unit tests passed.\n";
+    return 0;
+}
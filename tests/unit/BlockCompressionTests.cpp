@@ -0,0 +1,151 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Engine/BlockCompression.hpp"
+#include "Engine/JobSystem.hpp"
+
+namespace {
+std::vector<std::byte> MakeIndexLikeData(std::size_t wordCount) {
+    std::vector<std::byte> bytes(wordCount * sizeof(std::uint32_t));
+    for (std::size_t word = 0; word < wordCount; ++word) {
+        // Triangle strips over a grid: indices climb slowly, as they do in real meshes.
+        const std::uint32_t value = static_cast<std::uint32_t>(word / 3 + (word % 3) * 17);
+        std::memcpy(bytes.data() + word * sizeof(value), &value, sizeof(value));
+    }
+    return bytes;
+}
+
+std::vector<std::byte> MakeNoise(std::size_t size) {
+    std::vector<std::byte> bytes(size);
+    std::uint32_t state = 0x12345678u;
+    for (std::byte& value : bytes) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        value = static_cast<std::byte>(state);
+    }
+    return bytes;
+}
+
+bool RoundTrips(engine::JobSystem& jobs, const std::vector<std::byte>& data, engine::BlockFilter filter) {
+    std::vector<std::byte> compressed;
+    engine::CompressBlocks(data.data(), data.size(), filter, compressed);
+
+    std::vector<std::byte> decoded;
+    std::string error;
+    if (!engine::DecompressBlocks(jobs, compressed.data(), compressed.size(), data.size(), decoded, error) || decoded != data) {
+        return false;
+    }
+
+    std::stringstream stream(std::string(reinterpret_cast<const char*>(compressed.data()), compressed.size()));
+    std::vector<std::byte> streamed;
+    return engine::ReadCompressedBlocks(jobs, stream, compressed.size(), data.size(), streamed, error) && streamed == data;
+}
+
+int RunBlockCompressionTests() {
+    int failureCount = 0;
+    engine::JobSystem singleWorker(1);
+    engine::JobSystem jobs(3);
+
+    const std::vector<std::byte> indices = MakeIndexLikeData(300000);
+    const std::vector<std::byte> noise = MakeNoise(engine::kCompressionBlockSize * 2 + 13);
+    const std::vector<std::byte> empty;
+    const std::vector<std::byte> tiny = {std::byte{1}, std::byte{2}, std::byte{3}};
+
+    for (const engine::BlockFilter filter : {engine::BlockFilter::None, engine::BlockFilter::Shuffle32, engine::BlockFilter::Delta32}) {
+        if (!RoundTrips(singleWorker, indices, filter) || !RoundTrips(jobs, indices, filter) || !RoundTrips(jobs, noise, filter) ||
+            !RoundTrips(jobs, empty, filter) || !RoundTrips(jobs, tiny, filter)) {
+            std::cerr << "Expected every filter to round-trip structured, random, empty and tiny payloads.\n";
+            ++failureCount;
+        }
+    }
+
+    std::vector<std::byte> plain;
+    std::vector<std::byte> delta;
+    engine::CompressBlocks(indices.data(), indices.size(), engine::BlockFilter::None, plain);
+    engine::CompressBlocks(indices.data(), indices.size(), engine::BlockFilter::Delta32, delta);
+    if (delta.size() >= plain.size() || delta.size() * 4 >= indices.size()) {
+        std::cerr << "Expected delta filtering to shrink index data well beyond plain LZ.\n";
+        ++failureCount;
+    }
+
+    std::vector<std::byte> incompressible;
+    engine::CompressBlocks(noise.data(), noise.size(), engine::BlockFilter::None, incompressible);
+    if (incompressible.size() > noise.size() + 64) {
+        std::cerr << "Expected incompressible blocks to be stored raw.\n";
+        ++failureCount;
+    }
+
+    std::vector<std::byte> decoded;
+    std::string error;
+    std::vector<std::byte> truncated(delta.begin(), delta.end() - 7);
+    if (engine::DecompressBlocks(jobs, truncated.data(), truncated.size(), indices.size(), decoded, error) || error.empty()) {
+        std::cerr << "Expected a truncated payload to be rejected.\n";
+        ++failureCount;
+    }
+
+    std::vector<std::byte> corrupt = delta;
+    corrupt[corrupt.size() / 2] ^= std::byte{0x5a};
+    corrupt[corrupt.size() / 2 + 1] ^= std::byte{0xa5};
+    if (engine::DecompressBlocks(jobs, corrupt.data(), corrupt.size(), indices.size(), decoded, error) && decoded == indices) {
+        std::cerr << "Expected a corrupted block not to decode to the original data.\n";
+        ++failureCount;
+    }
+
+    std::stringstream shortStream(std::string(reinterpret_cast<const char*>(delta.data()), delta.size() / 2));
+    if (engine::ReadCompressedBlocks(jobs, shortStream, delta.size(), indices.size(), decoded, error)) {
+        std::cerr << "Expected a stream that ends early to be rejected.\n";
+        ++failureCount;
+    }
+
+    if (engine::DecompressBlocks(jobs, delta.data(), delta.size(), indices.size() - 1, decoded, error)) {
+        std::cerr << "Expected a payload larger than the caller allows to be rejected.\n";
+        ++failureCount;
+    }
+
+    // A raw size near 2^64 must not wrap around to a small block count.
+    std::vector<std::byte> huge(16, std::byte{0});
+    const std::uint64_t hugeRawSize = ~std::uint64_t{0} - engine::kCompressionBlockSize + 2;
+    const std::uint32_t wrappedBlockCount = 0;
+    std::memcpy(huge.data(), &hugeRawSize, sizeof(hugeRawSize));
+    std::memcpy(huge.data() + sizeof(hugeRawSize), &wrappedBlockCount, sizeof(wrappedBlockCount));
+    std::stringstream hugeStream(std::string(reinterpret_cast<const char*>(huge.data()), huge.size()));
+    if (engine::DecompressBlocks(jobs, huge.data(), huge.size(), hugeRawSize, decoded, error) ||
+        engine::ReadCompressedBlocks(jobs, hugeStream, huge.size(), hugeRawSize, decoded, error)) {
+        std::cerr << "Expected a header whose raw size overflows the block count to be rejected.\n";
+        ++failureCount;
+    }
+
+    // A compressed block cannot expand a few stored bytes into a whole block.
+    std::vector<std::byte> inflated = delta;
+    const std::uint64_t inflatedRawSize = engine::kCompressionBlockSize;
+    const std::uint32_t oneBlock = 1;
+    const std::uint32_t tinyBlock = 4;
+    inflated.resize(16 + sizeof(tinyBlock) + tinyBlock);
+    std::memcpy(inflated.data(), &inflatedRawSize, sizeof(inflatedRawSize));
+    std::memcpy(inflated.data() + sizeof(inflatedRawSize), &oneBlock, sizeof(oneBlock));
+    std::memcpy(inflated.data() + 16, &tinyBlock, sizeof(tinyBlock));
+    if (engine::DecompressBlocks(jobs, inflated.data(), inflated.size(), inflatedRawSize, decoded, error)) {
+        std::cerr << "Expected a block claiming more than the codec can expand to be rejected.\n";
+        ++failureCount;
+    }
+
+    return failureCount;
+}
+}
+
+int main() {
+    const int failures = RunBlockCompressionTests();
+    if (failures > 0) {
+        std::cerr << "BlockCompression unit tests failed with " << failures << " failure(s).\n";
+        return 1;
+    }
+
+    std::cout << "BlockCompression unit tests passed.\n";
+    return 0;
+}
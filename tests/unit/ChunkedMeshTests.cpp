@@ -0,0 +1,163 @@
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Engine/ChunkedMesh.hpp"
+
+namespace {
+// A bumpy height field in the XY plane, facing the default camera.
+engine::ModelData MakeGridModel(std::uint32_t cellsPerSide) {
+    engine::ModelData model;
+    const std::uint32_t verticesPerSide = cellsPerSide + 1;
+    for (std::uint32_t row = 0; row < verticesPerSide; ++row) {
+        for (std::uint32_t column = 0; column < verticesPerSide; ++column) {
+            const float u = static_cast<float>(column) / static_cast<float>(cellsPerSide);
+            const float v = static_cast<float>(row) / static_cast<float>(cellsPerSide);
+            const float height = ((row + column) % 2 == 0) ? 0.002f : -0.002f;
+            model.positions.push_back(glm::vec3(u * 2.0f - 1.0f, v * 2.0f - 1.0f, height));
+            model.texCoords.push_back(glm::vec2(u, v));
+        }
+    }
+
+    for (std::uint32_t row = 0; row < cellsPerSide; ++row) {
+        for (std::uint32_t column = 0; column < cellsPerSide; ++column) {
+            const std::uint32_t corner = row * verticesPerSide + column;
+            model.indices.insert(
+                model.indices.end(),
+                {corner, corner + 1, corner + verticesPerSide, corner + 1, corner + verticesPerSide + 1, corner + verticesPerSide});
+        }
+    }
+
+    model.texturePaths = {"textures/scan.png"};
+    model.primaryTexturePath = "textures/scan.png";
+    model.materials.push_back(engine::ModelMaterial{0, -1, -1, -1, -1, 1.0f, 0.0f, false, false, false});
+    model.submeshes.push_back(engine::ModelSubmesh{0, static_cast<std::uint32_t>(model.indices.size()), 0});
+    model.sourcePath = "scan.fbx";
+    return model;
+}
+
+// Requests the same set every frame until every request draws at its exact level or time runs out.
+std::vector<std::shared_ptr<const engine::ResidentMeshChunk>> RequestUntilResident(
+    engine::ChunkedMeshStream& stream,
+    const std::vector<engine::MeshChunkRequest>& requests) {
+    std::vector<std::shared_ptr<const engine::ResidentMeshChunk>> drawable;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (std::chrono::steady_clock::now() < deadline) {
+        stream.Request(requests, drawable);
+        bool complete = drawable.size() == requests.size();
+        for (std::size_t index = 0; complete && index < drawable.size(); ++index) {
+            complete = drawable[index]->lod == requests[index].lod;
+        }
+        if (complete && stream.GetStatistics().pendingLoadCount == 0) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    return drawable;
+}
+
+int RunChunkedMeshTests() {
+    int failureCount = 0;
+
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "EngineChunkedMeshTests";
+    std::filesystem::remove_all(directory);
+    const std::filesystem::path meshPath = directory / "scan.emck";
+
+    const engine::ModelData model = MakeGridModel(64);
+    std::string error;
+    if (!engine::WriteChunkedMesh(meshPath, model, engine::ChunkedMeshBuildOptions{1024, 3}, error)) {
+        std::cerr << "Expected writing the chunked mesh to succeed: " << error << "\n";
+        return failureCount + 1;
+    }
+
+    engine::ChunkedMeshStream stream;
+    if (!stream.Open(meshPath, engine::ChunkedMeshStream::kDefaultBudgetBytes, error)) {
+        std::cerr << "Expected opening the chunked mesh to succeed: " << error << "\n";
+        return failureCount + 1;
+    }
+
+    const std::vector<engine::MeshChunkInfo>& chunks = stream.GetChunks();
+    std::uint64_t levelZeroTriangles = 0;
+    bool lodsShrink = true;
+    for (const engine::MeshChunkInfo& chunk : chunks) {
+        levelZeroTriangles += chunk.lods[0].triangleCount;
+        lodsShrink = lodsShrink && chunk.lods[0].triangleCount <= 1024 && chunk.lodCount >= 2 &&
+            chunk.lods[1].triangleCount < chunk.lods[0].triangleCount && chunk.lods[1].geometricError > 0.0f;
+    }
+    if (chunks.size() < 8 || levelZeroTriangles != model.indices.size() / 3) {
+        std::cerr << "Expected the grid to split into chunks that together hold every triangle.\n";
+        ++failureCount;
+    }
+    if (!lodsShrink) {
+        std::cerr << "Expected each chunk to carry a coarser level with fewer triangles.\n";
+        ++failureCount;
+    }
+
+    std::vector<engine::MeshChunkRequest> requests;
+    stream.SelectChunks(engine::ModelCamera{0.0f, 0.0f, 0.0f, 4.0f, glm::vec3(0.0f)}, 1.0f, 720.0f, 1.0f, requests);
+    if (requests.size() != chunks.size()) {
+        std::cerr << "Expected every chunk of a centered model to be visible.\n";
+        ++failureCount;
+    }
+
+    std::vector<engine::MeshChunkRequest> zoomedRequests;
+    stream.SelectChunks(engine::ModelCamera{0.0f, 0.0f, 0.0f, 1.0f, glm::vec3(0.9f, 0.9f, 0.0f)}, 1.0f, 720.0f, 1.0f, zoomedRequests);
+    if (zoomedRequests.empty() || zoomedRequests.size() >= chunks.size()) {
+        std::cerr << "Expected zooming into a corner to cull chunks outside the frustum.\n";
+        ++failureCount;
+    }
+
+    std::vector<engine::MeshChunkRequest> fullDetail;
+    for (std::uint32_t chunkIndex = 0; chunkIndex < chunks.size(); ++chunkIndex) {
+        fullDetail.push_back(engine::MeshChunkRequest{chunkIndex, 0});
+    }
+    const auto drawable = RequestUntilResident(stream, fullDetail);
+    engine::ModelData streamed;
+    stream.BuildModel(drawable, streamed);
+    if (streamed.indices.size() != model.indices.size() || streamed.texCoords.size() != streamed.positions.size() ||
+        streamed.submeshes.size() != chunks.size() || streamed.texturePaths != model.texturePaths ||
+        streamed.materials.size() != 1) {
+        std::cerr << "Expected the resident chunks at level 0 to rebuild the full model.\n";
+        ++failureCount;
+    }
+
+    // A budget that fits only a few chunks at full detail must never be exceeded while the view moves.
+    const std::size_t chunkBytes = drawable.empty() ? 0 : drawable[0]->GetByteSize();
+    const std::size_t smallBudget = chunkBytes * 3;
+    stream.SetBudget(smallBudget);
+    bool budgetHeld = stream.GetStatistics().residentBytes <= smallBudget;
+    for (std::uint32_t first = 0; first + 2 <= chunks.size(); first += 2) {
+        const std::vector<engine::MeshChunkRequest> window = {
+            engine::MeshChunkRequest{first, 0},
+            engine::MeshChunkRequest{first + 1, 0}};
+        RequestUntilResident(stream, window);
+        budgetHeld = budgetHeld && stream.GetStatistics().residentBytes <= smallBudget;
+    }
+
+    const engine::ChunkedMeshStreamStats stats = stream.GetStatistics();
+    if (!budgetHeld || stats.evictionCount == 0 || stats.failedLoadCount != 0) {
+        std::cerr << "Expected a small budget to evict chunks and never be exceeded.\n";
+        ++failureCount;
+    }
+
+    stream.Close();
+    std::filesystem::remove_all(directory);
+    return failureCount;
+}
+}
+
+int main() {
+    const int failures = RunChunkedMeshTests();
+    if (failures > 0) {
+        std::cerr << "ChunkedMesh unit tests failed with " << failures << " failure(s).\n";
+        return 1;
+    }
+
+    std::cout << "ChunkedMesh unit tests passed.\n";
+    return 0;
+}
@@ -0,0 +1,167 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Engine/CookedModel.hpp"
+#include "Engine/TexturePathResolver.hpp"
+
+namespace {
+engine::ModelData MakeModel() {
+    engine::ModelData model;
+    model.positions = {
+        glm::vec3(-1.0f, 0.0f, 0.0f),
+        glm::vec3(1.0f, 0.0f, 0.0f),
+        glm::vec3(0.0f, 2.0f, 0.0f),
+        glm::vec3(0.0f, 0.0f, -3.0f)};
+    model.texCoords = {glm::vec2(0.0f), glm::vec2(1.0f, 0.0f), glm::vec2(0.5f, 1.0f), glm::vec2(0.25f)};
+    model.indices = {0, 1, 2, 0, 2, 3};
+    model.texturePaths = {"textures/body.png", "textures/body_alpha.png"};
+    model.unresolvedTextureIndices = {1};
+    model.primaryTexturePath = "textures/body.png";
+    model.materials.push_back(engine::ModelMaterial{0, 1, -1, -1, -1, 0.5f, 0.35f, false, true, true});
+    model.materials.push_back(engine::ModelMaterial{-1, -1, -1, -1, -1, 1.0f, 0.0f, false, false, false});
+    model.submeshes = {engine::ModelSubmesh{0, 3, 0}, engine::ModelSubmesh{3, 3, 1}};
+    model.animations.push_back(engine::AnimationClip{"Run", 1.25f, 30.0f, {}});
+    model.animations[0].morphCurves.push_back(engine::MorphWeightCurve{0, {{0.0f, 0.0f}, {1.25f, 0.75f}}});
+    model.morphTargets.push_back(engine::MorphTarget{"Smile", {1, 3}, {100, 0, -5, 0, 32767, 0}, 0.001f, 0.25f});
+    model.sourcePath = "Models/test.fbx";
+    return model;
+}
+
+int RunCookedModelTests() {
+    int failureCount = 0;
+
+    const std::filesystem::path cacheDirectory = std::filesystem::temp_directory_path() / "EngineCookedModelTests";
+    std::filesystem::remove_all(cacheDirectory);
+
+    const engine::ModelData model = MakeModel();
+    const engine::CookedModelSourceStamp stamp{1234, 5678};
+    const std::filesystem::path cookedPath = engine::GetCookedModelPath(cacheDirectory, model.sourcePath);
+    if (cookedPath.parent_path() != cacheDirectory || cookedPath.filename().string().rfind("test_", 0) != 0 ||
+        cookedPath == engine::GetCookedModelPath(cacheDirectory, "Other/test.fbx")) {
+        std::cerr << "Expected cooked file names to combine the source stem with a path hash.\n";
+        ++failureCount;
+    }
+
+    std::string error;
+    if (!engine::WriteCookedModel(cookedPath, model, stamp, error)) {
+        std::cerr << "Expected writing the cooked model to succeed: " << error << "\n";
+        return failureCount + 1;
+    }
+
+    engine::LazyModel lazyModel;
+    if (!lazyModel.Open(cookedPath, error)) {
+        std::cerr << "Expected opening the cooked model to succeed: " << error << "\n";
+        return failureCount + 1;
+    }
+
+    const engine::CookedModelSummary& summary = lazyModel.GetSummary();
+    if (summary.vertexCount != 4 || summary.triangleCount != 2 || summary.submeshCount != 2 ||
+        summary.materialCount != 2 || summary.textureCount != 2 || summary.animationCount != 1 ||
+        summary.boundsMin != glm::vec3(-1.0f, 0.0f, -3.0f) || summary.boundsMax != glm::vec3(1.0f, 2.0f, 0.0f)) {
+        std::cerr << "Expected the header summary to describe the model.\n";
+        ++failureCount;
+    }
+
+    if (lazyModel.GetSourcePath() != model.sourcePath || lazyModel.GetSourceStamp().fileSize != stamp.fileSize ||
+        lazyModel.GetSourceStamp().lastWriteTicks != stamp.lastWriteTicks) {
+        std::cerr << "Expected the header to keep the source path and stamp.\n";
+        ++failureCount;
+    }
+
+    for (std::uint32_t section = 0; section < static_cast<std::uint32_t>(engine::ModelSection::Count); ++section) {
+        if (lazyModel.IsSectionLoaded(static_cast<engine::ModelSection>(section))) {
+            std::cerr << "Expected Open to leave every section undecoded.\n";
+            ++failureCount;
+            break;
+        }
+    }
+
+    engine::ModelData geometry;
+    if (!lazyModel.Materialize(engine::kGeometryModelLoadRequest, geometry, error) ||
+        geometry.positions != model.positions || geometry.indices != model.indices ||
+        geometry.submeshes.size() != 2 || !geometry.texCoords.empty() || !geometry.materials.empty() ||
+        !geometry.animations.empty() || !geometry.morphTargets.empty() || geometry.FindMaterial(geometry.submeshes[0]) != nullptr) {
+        std::cerr << "Expected a geometry request to produce only positions, indices and material-less submeshes.\n";
+        ++failureCount;
+    }
+
+    if (lazyModel.IsSectionLoaded(engine::ModelSection::TexCoords) ||
+        lazyModel.IsSectionLoaded(engine::ModelSection::Materials) ||
+        lazyModel.IsSectionLoaded(engine::ModelSection::Animations) ||
+        lazyModel.IsSectionLoaded(engine::ModelSection::MorphTargets)) {
+        std::cerr << "Expected heavy sections to stay undecoded after a geometry request.\n";
+        ++failureCount;
+    }
+
+    if (lazyModel.GetAnimations().size() != 1 || lazyModel.GetAnimations()[0].name != "Run" ||
+        !lazyModel.IsSectionLoaded(engine::ModelSection::Animations)) {
+        std::cerr << "Expected animations to decode on first access.\n";
+        ++failureCount;
+    }
+
+    engine::ModelData full;
+    if (!lazyModel.Materialize(engine::kFullModelLoadRequest, full, error) || full.texCoords != model.texCoords ||
+        full.texturePaths != model.texturePaths || full.primaryTexturePath != model.primaryTexturePath ||
+        full.materials.size() != 2 || full.materials[0].opacityTextureIndex != 1 || !full.materials[0].alphaCutoutEnabled ||
+        full.materials[0].opacity != 0.5f || full.submeshes[1].materialIndex != 1 || full.sourcePath != model.sourcePath ||
+        full.unresolvedTextureIndices != model.unresolvedTextureIndices) {
+        std::cerr << "Expected a full request to round-trip every section.\n";
+        ++failureCount;
+    }
+    if (full.animations.size() != 1 || full.animations[0].morphCurves.size() != 1 ||
+        full.animations[0].morphCurves[0].keys.size() != 2 || full.animations[0].morphCurves[0].keys[1].weight != 0.75f ||
+        full.morphTargets.size() != 1 || full.morphTargets[0].name != "Smile" ||
+        full.morphTargets[0].vertexIndices != model.morphTargets[0].vertexIndices ||
+        full.morphTargets[0].deltas != model.morphTargets[0].deltas || full.morphTargets[0].deltaScale != 0.001f ||
+        full.morphTargets[0].defaultWeight != 0.25f) {
+        std::cerr << "Expected morph targets and weight curves to round-trip with animations.\n";
+        ++failureCount;
+    }
+
+    // Texture paths were resolved against a folder; a new file there may change how they resolve.
+    const std::filesystem::path textureDirectory = cacheDirectory / "textures";
+    std::filesystem::create_directories(textureDirectory);
+    engine::ModelData searched = model;
+    searched.textureSearchDirectories.push_back(
+        engine::TextureSearchDirectory{textureDirectory.generic_string(), engine::ReadDirectoryWriteTicks(textureDirectory)});
+    engine::LazyModel searchedModel;
+    const bool currentAfterCook = engine::WriteCookedModel(cookedPath, searched, stamp, error) &&
+        searchedModel.Open(cookedPath, error) && searchedModel.IsTextureResolutionCurrent();
+    std::ofstream(textureDirectory / "body.png") << "texture";
+    std::filesystem::last_write_time(
+        textureDirectory,
+        std::filesystem::last_write_time(textureDirectory) + std::chrono::seconds(2));
+    if (!currentAfterCook || searchedModel.IsTextureResolutionCurrent()) {
+        std::cerr << "Expected a change to a searched texture folder to make the cooked texture paths stale.\n";
+        ++failureCount;
+    }
+
+    {
+        std::ofstream corrupt(cookedPath, std::ios::binary | std::ios::in | std::ios::out);
+        corrupt.write("XXXX", 4);
+    }
+    engine::LazyModel corruptModel;
+    if (corruptModel.Open(cookedPath, error) || error.empty()) {
+        std::cerr << "Expected a file with the wrong magic to be rejected.\n";
+        ++failureCount;
+    }
+
+    std::filesystem::remove_all(cacheDirectory);
+    return failureCount;
+}
+}
+
+int main() {
+    const int failures = RunCookedModelTests();
+    if (failures > 0) {
+        std::cerr << "CookedModel unit tests failed with " << failures << " failure(s).\n";
+        return 1;
+    }
+
+    std::cout << "CookedModel unit tests passed.\n";
+    return 0;
+}
@@ -0,0 +1,119 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Engine/FileWatcher.hpp"
+
+namespace {
+void WriteFile(const std::filesystem::path& path, const std::string& contents) {
+    std::ofstream output(path, std::ios::binary | std::ios::trunc);
+    output << contents;
+}
+
+std::vector<std::filesystem::path> WaitForChanges(engine::FileWatcher& watcher, std::chrono::milliseconds timeout) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (std::chrono::steady_clock::now() < deadline) {
+        std::vector<std::filesystem::path> changes = watcher.PollChanges();
+        if (!changes.empty()) {
+            return changes;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return {};
+}
+
+int RunFileWatcherTests() {
+    int failureCount = 0;
+
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "EngineFileWatcherTests";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+
+    const std::filesystem::path modelPath = directory / "model.fbx";
+    const std::filesystem::path texturePath = directory / "diffuse.png";
+    const std::filesystem::path unwatchedPath = directory / "other.png";
+    WriteFile(modelPath, "model");
+    WriteFile(texturePath, "texture");
+    WriteFile(unwatchedPath, "other");
+
+    engine::FileWatcher watcher;
+    watcher.Watch({modelPath, texturePath});
+    if (watcher.GetWatchedFileCount() != 2) {
+        std::cerr << "Expected both files to be watched.\n";
+        ++failureCount;
+    }
+
+    if (!WaitForChanges(watcher, std::chrono::milliseconds(400)).empty()) {
+        std::cerr << "Expected no changes before any file is written.\n";
+        ++failureCount;
+    }
+
+    WriteFile(unwatchedPath, "other, edited");
+    WriteFile(texturePath, "texture, edited once");
+    WriteFile(texturePath, "texture, edited twice");
+    std::vector<std::filesystem::path> changes = WaitForChanges(watcher, std::chrono::seconds(2));
+    if (changes.size() != 1 || changes[0].filename() != "diffuse.png") {
+        std::cerr << "Expected back-to-back writes to one watched file to be reported once.\n";
+        ++failureCount;
+    }
+
+    // Editors that save through a temporary file and rename it over the original must be caught.
+    const std::filesystem::path temporaryPath = directory / "model.fbx.tmp";
+    WriteFile(temporaryPath, "model, re-exported");
+    std::filesystem::rename(temporaryPath, modelPath);
+    changes = WaitForChanges(watcher, std::chrono::seconds(2));
+    if (changes.size() != 1 || changes[0].filename() != "model.fbx") {
+        std::cerr << "Expected a rename over a watched file to be reported.\n";
+        ++failureCount;
+    }
+
+    // A file whose directory does not exist yet cannot be watched through its directory.
+    const std::filesystem::path lateDirectory = directory / "textures";
+    const std::filesystem::path latePath = lateDirectory / "normal.png";
+    watcher.Watch({modelPath, latePath});
+    std::filesystem::create_directories(lateDirectory);
+    WriteFile(latePath, "normal");
+    changes = WaitForChanges(watcher, std::chrono::seconds(2));
+    if (changes.size() != 1 || changes[0].filename() != "normal.png") {
+        std::cerr << "Expected a file in a directory created after Watch to be reported.\n";
+        ++failureCount;
+    }
+
+    // Deleting and recreating a watched directory drops its inotify watch; the file must still be caught.
+    watcher.Watch({latePath});
+    std::filesystem::remove_all(lateDirectory);
+    static_cast<void>(watcher.PollChanges());
+    std::filesystem::create_directories(lateDirectory);
+    WriteFile(latePath, "normal, restored");
+    changes = WaitForChanges(watcher, std::chrono::seconds(2));
+    if (changes.size() != 1 || changes[0].filename() != "normal.png") {
+        std::cerr << "Expected a file in a recreated directory to be reported.\n";
+        ++failureCount;
+    }
+
+    watcher.Clear();
+    WriteFile(texturePath, "texture, edited after clear");
+    if (!WaitForChanges(watcher, std::chrono::milliseconds(400)).empty()) {
+        std::cerr << "Expected no changes to be reported after Clear.\n";
+        ++failureCount;
+    }
+
+    std::filesystem::remove_all(directory);
+    return failureCount;
+}
+}
+
+int main() {
+    const int failures = RunFileWatcherTests();
+    if (failures > 0) {
+        std::cerr << "FileWatcher unit tests failed with " << failures << " failure(s).\n";
+        return 1;
+    }
+
+    std::cout << "FileWatcher unit tests passed.\n";
+    return 0;
+}
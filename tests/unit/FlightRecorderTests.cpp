@@ -0,0 +1,165 @@
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+#include "Engine/FlightRecorder.hpp"
+
+namespace {
+std::uint64_t fakeNanoseconds = 0;
+
+std::uint64_t ReadFakeClock() {
+    return fakeNanoseconds;
+}
+
+void Advance(double milliseconds) {
+    fakeNanoseconds += static_cast<std::uint64_t>(milliseconds * 1.0e6);
+}
+
+// One frame of `PollEvents` then `ModelPass`, with `stallMilliseconds` spent in a nested
+// `CreateComposedTexture`.
+bool RunFrame(engine::FlightRecorder& recorder, std::uint64_t frameIndex, double stallMilliseconds, engine::FlightRecorderDump& outDump) {
+    recorder.BeginFrame(frameIndex);
+    {
+        engine::ScopedFramePhase events(recorder, "PollEvents");
+        Advance(1.0);
+    }
+    {
+        engine::ScopedFramePhase modelPass(recorder, "ModelPass");
+        Advance(4.0);
+        if (stallMilliseconds > 0.0) {
+            engine::ScopedFramePhase compose(recorder, "CreateComposedTexture");
+            recorder.RecordEvent("Composed texture for material 3");
+            Advance(stallMilliseconds);
+        }
+    }
+    Advance(2.0);
+    return recorder.EndFrame(outDump);
+}
+
+int RunFlightRecorderTests() {
+    int failureCount = 0;
+
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "EngineFlightRecorderTests";
+    std::filesystem::remove_all(directory);
+    engine::FlightRecorder recorder(engine::FlightRecorderSettings{4, 0.05, 1.0, directory});
+    recorder.SetClock(&ReadFakeClock);
+
+    engine::FlightRecorderDump dump;
+    bool dumped = false;
+    for (std::uint64_t frameIndex = 0; frameIndex < 6; ++frameIndex) {
+        dumped = RunFrame(recorder, frameIndex, 0.0, dump) || dumped;
+    }
+    if (dumped || recorder.GetRecordedFrameCount() != 4) {
+        std::cerr << "Expected frames under budget to fill the ring without dumping.\n";
+        ++failureCount;
+    }
+
+    // Phases outside a frame are dropped rather than attached to the next one.
+    {
+        engine::ScopedFramePhase stray(recorder, "Stray");
+        recorder.RecordEvent("Stray event");
+    }
+
+    if (!RunFrame(recorder, 6, 120.0, dump)) {
+        std::cerr << "Expected a 127 ms frame to trip the 50 ms budget.\n";
+        ++failureCount;
+    } else {
+        const engine::FlightRecorderFrame& hitch = dump.frames.back();
+        if (dump.frames.size() != 4 || dump.frames.front().frameIndex != 3 || hitch.frameIndex != 6 ||
+            hitch.durationNanoseconds != 127000000 || hitch.phaseCount != 3 || hitch.eventCount != 1) {
+            std::cerr << "Expected the dump to hold the last four frames, oldest first.\n";
+            ++failureCount;
+        }
+        if (std::string(hitch.phases[2].name) != "CreateComposedTexture" || hitch.phases[2].depth != 1 ||
+            hitch.phases[2].startNanoseconds != 5000000 || hitch.phases[2].endNanoseconds != 125000000 ||
+            std::string(hitch.events[0].text.data()) != "Composed texture for material 3") {
+            std::cerr << "Expected nested phases and events at their offsets into the frame.\n";
+            ++failureCount;
+        }
+        if (dump.triggerPhase != "CreateComposedTexture" || dump.triggerNanoseconds != 120000000) {
+            std::cerr << "Expected the nested phase, not its parent, to be blamed: " << dump.triggerPhase << "\n";
+            ++failureCount;
+        }
+
+        std::filesystem::path dumpPath;
+        std::string error;
+        if (!engine::WriteFlightRecorderDump(dump, directory, dumpPath, error)) {
+            std::cerr << "Expected the dump to be written: " << error << "\n";
+            ++failureCount;
+        } else {
+            std::ifstream file(dumpPath);
+            const std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            if (dumpPath.parent_path() != directory || !dumpPath.filename().string().starts_with("hitch-") ||
+                !dumpPath.filename().string().ends_with("-frame6.txt") ||
+                !text.starts_with("Hitch: frame 6 took 127.000 ms against a 50.000 ms budget") ||
+                text.find("Trigger: CreateComposedTexture, 120.000 ms of its own.") == std::string::npos ||
+                text.find("\nFrame 3: 7.000 ms\n") == std::string::npos ||
+                text.find("    CreateComposedTexture") == std::string::npos ||
+                text.find("Event at 5.000 ms: Composed texture for material 3") == std::string::npos) {
+                std::cerr << "Unexpected dump text:\n" << text;
+                ++failureCount;
+            }
+        }
+    }
+
+    // A second hitch inside the cooldown is already covered by the first dump.
+    if (RunFrame(recorder, 7, 120.0, dump)) {
+        std::cerr << "Expected hitches within the cooldown not to dump again.\n";
+        ++failureCount;
+    }
+    Advance(1000.0);
+
+    // Excused time (a modal dialog) does not count, and untracked time is blamed when it dominates.
+    recorder.BeginFrame(8);
+    {
+        engine::ScopedFramePhase dialog(recorder, "OpenLoadFbxDialog", true);
+        engine::ScopedFramePhase nested(recorder, "NestedExcused", true);
+        Advance(500.0);
+    }
+    if (recorder.EndFrame(dump)) {
+        std::cerr << "Expected excused phases to stay out of the budget.\n";
+        ++failureCount;
+    }
+    recorder.BeginFrame(9);
+    {
+        engine::ScopedFramePhase events(recorder, "PollEvents");
+        Advance(1.0);
+    }
+    Advance(80.0);
+    if (!recorder.EndFrame(dump) || dump.triggerPhase != "(untracked)" || dump.triggerNanoseconds != 80000000 ||
+        dump.frames[dump.frames.size() - 2].excusedNanoseconds != 500000000) {
+        std::cerr << "Expected time outside any phase to be blamed as untracked.\n";
+        ++failureCount;
+    }
+
+    // Overflowing a frame's fixed storage is counted, not fatal.
+    recorder.BeginFrame(10);
+    for (std::size_t index = 0; index < engine::FlightRecorderFrame::kMaxPhases + 3; ++index) {
+        engine::ScopedFramePhase phase(recorder, "Repeated");
+    }
+    recorder.RecordEvent(std::string(500, 'x'));
+    recorder.SetHitchBudget(0.0);
+    Advance(1000.0);
+    if (recorder.EndFrame(dump)) {
+        std::cerr << "Expected a zero budget to disable dumps.\n";
+        ++failureCount;
+    }
+
+    std::filesystem::remove_all(directory);
+    return failureCount;
+}
+}
+
+int main() {
+    const int failures = RunFlightRecorderTests();
+    if (failures > 0) {
+        std::cerr << "FlightRecorder unit tests failed with " << failures << " failure(s).\n";
+        return 1;
+    }
+
+    std::cout << "FlightRecorder unit tests passed.\n";
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include <iostream>
+
+#include "Engine/InputLatency.hpp"
+
+namespace {
+constexpr std::uint64_t kMillisecond = 1000000;
+
+int RunInputLatencyTests() {
+    int failureCount = 0;
+
+    engine::InputLatencyTracker tracker(4);
+    tracker.RecordCameraBuilt(5 * kMillisecond);
+    tracker.RecordPresent(9 * kMillisecond);
+    if (tracker.GetSize() != 0) {
+        std::cerr << "Expected frames without camera input to leave no sample.\n";
+        ++failureCount;
+    }
+
+    // The frame reflects its newest input, whichever order it was recorded in.
+    tracker.RecordInput(10 * kMillisecond);
+    tracker.RecordInput(14 * kMillisecond);
+    tracker.RecordInput(12 * kMillisecond);
+    tracker.RecordCameraBuilt(20 * kMillisecond);
+    tracker.RecordPresent(30 * kMillisecond);
+    const engine::InputLatencySample& first = tracker.GetLatest();
+    if (tracker.GetSize() != 1 || first.inputToCameraNanoseconds != 6 * kMillisecond ||
+        first.inputToPresentNanoseconds != 16 * kMillisecond) {
+        std::cerr << "Expected latency to be measured from the newest input of the frame.\n";
+        ++failureCount;
+    }
+
+    // Pending state does not leak into the next frame.
+    tracker.RecordPresent(40 * kMillisecond);
+    if (tracker.GetSize() != 1) {
+        std::cerr << "Expected Present to close the frame.\n";
+        ++failureCount;
+    }
+
+    // An event timestamped after the camera was built must not wrap around.
+    tracker.RecordInput(52 * kMillisecond);
+    tracker.RecordCameraBuilt(50 * kMillisecond);
+    tracker.RecordPresent(60 * kMillisecond);
+    if (tracker.GetLatest().inputToCameraNanoseconds != 0 || tracker.GetLatest().inputToPresentNanoseconds != 8 * kMillisecond) {
+        std::cerr << "Expected out-of-order timestamps to clamp to zero.\n";
+        ++failureCount;
+    }
+
+    for (std::uint64_t frame = 0; frame < 6; ++frame) {
+        const std::uint64_t start = (100 + frame * 20) * kMillisecond;
+        tracker.RecordInput(start);
+        tracker.RecordCameraBuilt(start + 2 * kMillisecond);
+        tracker.RecordPresent(start + (frame + 1) * kMillisecond * 4);
+    }
+    // The ring keeps the last four frames: 12, 16, 20 and 24 ms to present.
+    if (tracker.GetSize() != tracker.GetCapacity() ||
+        tracker.ComputeAverage(&engine::InputLatencySample::inputToPresentNanoseconds) != 18.0 * kMillisecond ||
+        tracker.ComputeMaximum(&engine::InputLatencySample::inputToPresentNanoseconds) != 24 * kMillisecond ||
+        tracker.ComputeMaximum(&engine::InputLatencySample::inputToCameraNanoseconds) != 2 * kMillisecond) {
+        std::cerr << "Expected statistics over the most recent frames only.\n";
+        ++failureCount;
+    }
+
+    tracker.RecordInput(500 * kMillisecond);
+    tracker.Clear();
+    tracker.RecordPresent(510 * kMillisecond);
+    if (tracker.GetSize() != 0 || tracker.ComputeAverage(&engine::InputLatencySample::inputToPresentNanoseconds) != 0.0) {
+        std::cerr << "Expected Clear to drop samples and the pending frame.\n";
+        ++failureCount;
+    }
+
+    return failureCount;
+}
+}
+
+int main() {
+    const int failures = RunInputLatencyTests();
+    if (failures > 0) {
+        std::cerr << "InputLatency unit tests failed with " << failures << " failure(s).\n";
+        return 1;
+    }
+
+    std::cout << "InputLatency unit tests passed.\n";
+    return 0;
+}
@@ -0,0 +1,136 @@
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "Engine/JobSystem.hpp"
+
+namespace {
+int RunJobSystemTests() {
+    int failureCount = 0;
+    engine::JobSystem jobs(3);
+
+    std::atomic<int> sequence{0};
+    int firstSlot = -1;
+    int secondSlot = -1;
+    int joinSlot = -1;
+    const engine::JobSystem::JobHandle first = jobs.Schedule([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        firstSlot = sequence.fetch_add(1);
+    });
+    const engine::JobSystem::JobHandle second = jobs.Schedule([&]() { secondSlot = sequence.fetch_add(1); });
+    const engine::JobSystem::JobHandle join = jobs.Schedule([&]() { joinSlot = sequence.fetch_add(1); }, {first, second});
+    jobs.Wait(join);
+    if (!engine::JobSystem::IsComplete(first) || !engine::JobSystem::IsComplete(second) || joinSlot != 2 ||
+        firstSlot < 0 || secondSlot < 0) {
+        std::cerr << "Expected a continuation to run only after every dependency finished.\n";
+        ++failureCount;
+    }
+
+    const engine::JobSystem::JobHandle late = jobs.Schedule([&]() { joinSlot = 10; }, {join});
+    jobs.Wait(late);
+    if (joinSlot != 10) {
+        std::cerr << "Expected a job depending on a finished job to start immediately.\n";
+        ++failureCount;
+    }
+
+    constexpr std::size_t kItemCount = 100000;
+    std::vector<std::atomic<int>> visits(kItemCount);
+    jobs.ParallelFor(kItemCount, 64, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t index = begin; index < end; ++index) {
+            visits[index].fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    bool visitedOnce = true;
+    for (const std::atomic<int>& visit : visits) {
+        visitedOnce = visitedOnce && visit.load() == 1;
+    }
+    if (!visitedOnce) {
+        std::cerr << "Expected ParallelFor to visit every index exactly once.\n";
+        ++failureCount;
+    }
+
+    std::atomic<std::size_t> nestedSum{0};
+    jobs.ParallelFor(16, 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t outer = begin; outer < end; ++outer) {
+            jobs.ParallelFor(1000, 10, [&](std::size_t innerBegin, std::size_t innerEnd) {
+                nestedSum.fetch_add(innerEnd - innerBegin, std::memory_order_relaxed);
+            });
+        }
+    });
+    if (nestedSum.load() != 16000) {
+        std::cerr << "Expected nested ParallelFor calls from workers to complete.\n";
+        ++failureCount;
+    }
+
+    // Jobs spawned by one worker land on its own deque, so the others can only get them by stealing.
+    const engine::JobSystemStatistics before = jobs.GetStatistics();
+    std::atomic<int> spawnedCount{0};
+    const engine::JobSystem::JobHandle spawner = jobs.Schedule([&]() {
+        std::vector<engine::JobSystem::JobHandle> children;
+        for (int child = 0; child < 32; ++child) {
+            children.push_back(jobs.Schedule([&]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                spawnedCount.fetch_add(1);
+            }));
+        }
+        for (const engine::JobSystem::JobHandle& child : children) {
+            jobs.Wait(child);
+        }
+    });
+    jobs.Wait(spawner);
+    const engine::JobSystemStatistics after = jobs.GetStatistics();
+    if (spawnedCount.load() != 32 || after.steals <= before.steals || after.jobsExecuted < before.jobsExecuted + 33 ||
+        after.workerCount != 3) {
+        std::cerr << "Expected idle workers to steal queued jobs and the statistics to count them.\n";
+        ++failureCount;
+    }
+
+    std::thread::id backgroundThread;
+    const engine::JobSystem::JobHandle backgroundJob = jobs.ScheduleBackground([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        backgroundThread = std::this_thread::get_id();
+    });
+    jobs.Wait(backgroundJob);
+    if (backgroundThread == std::thread::id() || backgroundThread == std::this_thread::get_id()) {
+        std::cerr << "Expected background jobs to run only on workers, never on a waiting thread.\n";
+        ++failureCount;
+    }
+
+    std::thread::id mainJobThread;
+    const engine::JobSystem::JobHandle background = jobs.Schedule([]() {});
+    const engine::JobSystem::JobHandle onMain = jobs.ScheduleOnMainThread(
+        [&]() { mainJobThread = std::this_thread::get_id(); },
+        {background});
+    jobs.Wait(background);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    const bool ranEarly = engine::JobSystem::IsComplete(onMain);
+    const std::size_t ranCount = jobs.RunMainThreadJobs();
+    if (ranEarly || ranCount != 1 || mainJobThread != std::this_thread::get_id() || !jobs.IsMainThread()) {
+        std::cerr << "Expected main-thread jobs to run only when the main thread pumps them.\n";
+        ++failureCount;
+    }
+
+    const engine::JobSystem::JobHandle waitedOnMain = jobs.ScheduleOnMainThread([&]() { mainJobThread = std::thread::id(); });
+    jobs.Wait(waitedOnMain);
+    if (mainJobThread != std::thread::id() || jobs.GetStatistics().mainThreadJobsExecuted != 2) {
+        std::cerr << "Expected the main thread to run its own jobs while waiting.\n";
+        ++failureCount;
+    }
+
+    return failureCount;
+}
+}
+
+int main() {
+    const int failures = RunJobSystemTests();
+    if (failures > 0) {
+        std::cerr << "JobSystem unit tests failed with " << failures << " failure(s).\n";
+        return 1;
+    }
+
+    std::cout << "JobSystem unit tests passed.\n";
+    return 0;
+}
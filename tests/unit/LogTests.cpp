@@ -0,0 +1,186 @@
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Engine/Log.hpp"
+
+namespace {
+struct CapturedRecords {
+    std::mutex mutex;
+    std::vector<engine::LogRecord> records;
+    std::vector<std::string> messages;
+
+    engine::LogSink MakeSink() {
+        return [this](const engine::LogRecord& record) {
+            const std::lock_guard<std::mutex> lock(mutex);
+            records.push_back(record);
+            messages.emplace_back(record.message);
+        };
+    }
+};
+
+int RunLogTests() {
+    int failureCount = 0;
+
+    {
+        CapturedRecords captured;
+        engine::Logger logger(64);
+        logger.SetSink(captured.MakeSink());
+        {
+            std::string temporary = "model.fbx";
+            logger.Write(
+                engine::LogCategory::Loader,
+                engine::LogLevel::Info,
+                "Loaded '%s' with %d textures, scale %.2f, flag=%s",
+                temporary,
+                3,
+                1.5f,
+                "yes");
+            temporary.assign("overwritten");
+        }
+        logger.Flush();
+
+        if (captured.messages.size() != 1 ||
+            captured.messages[0] != "Loaded 'model.fbx' with 3 textures, scale 1.50, flag=yes") {
+            std::cerr << "Expected deferred formatting to use argument values captured at the call site.\n";
+            ++failureCount;
+        } else if (captured.records[0].category != engine::LogCategory::Loader ||
+                   captured.records[0].level != engine::LogLevel::Info) {
+            std::cerr << "Expected the record to keep its category and level.\n";
+            ++failureCount;
+        }
+    }
+
+    {
+        CapturedRecords captured;
+        engine::Logger logger(64);
+        logger.SetSink(captured.MakeSink());
+        logger.SetLevel(engine::LogCategory::Renderer, engine::LogLevel::Warning);
+        logger.Write(engine::LogCategory::Renderer, engine::LogLevel::Info, "filtered");
+        logger.Write(engine::LogCategory::Renderer, engine::LogLevel::Error, "kept");
+        logger.Write(engine::LogCategory::Application, engine::LogLevel::Debug, "filtered");
+        logger.Flush();
+
+        if (captured.messages.size() != 1 || captured.messages[0] != "kept") {
+            std::cerr << "Expected per-category levels to filter records before they are queued.\n";
+            ++failureCount;
+        }
+    }
+
+    {
+        CapturedRecords captured;
+        engine::Logger logger(256);
+        logger.SetSink(captured.MakeSink());
+        logger.SetRateLimit(engine::LogCategory::Gpu, 5);
+        for (int recordIndex = 0; recordIndex < 20; ++recordIndex) {
+            logger.Write(engine::LogCategory::Gpu, engine::LogLevel::Error, "D3D12 message %d", recordIndex);
+        }
+        logger.Flush();
+
+        // Records can straddle a one-second window boundary, so allow one extra window of budget.
+        const std::uint64_t suppressed = logger.GetSuppressedCount(engine::LogCategory::Gpu);
+        if (suppressed < 10 || suppressed > 15) {
+            std::cerr << "Expected the rate limit to suppress records beyond the per-second budget.\n";
+            ++failureCount;
+        }
+    }
+
+    {
+        CapturedRecords captured;
+        engine::Logger logger(64);
+        logger.SetSink(captured.MakeSink());
+        const std::string longText(1000, 'x');
+        logger.Write(engine::LogCategory::Application, engine::LogLevel::Info, "%s", longText);
+        logger.Flush();
+
+        if (captured.messages.size() != 1 || captured.messages[0].size() >= longText.size() ||
+            captured.messages[0].size() < 100 || captured.messages[0].substr(captured.messages[0].size() - 3) != "...") {
+            std::cerr << "Expected oversized string arguments to be truncated with an ellipsis.\n";
+            ++failureCount;
+        }
+    }
+
+    {
+        std::atomic<bool> releaseSink = false;
+        CapturedRecords captured;
+        engine::Logger logger(8);
+        logger.SetSink([&](const engine::LogRecord& record) {
+            while (!releaseSink.load()) {
+                std::this_thread::yield();
+            }
+            const std::lock_guard<std::mutex> lock(captured.mutex);
+            captured.messages.emplace_back(record.message);
+        });
+        for (int recordIndex = 0; recordIndex < 100; ++recordIndex) {
+            logger.Write(engine::LogCategory::Application, engine::LogLevel::Info, "burst %d", recordIndex);
+        }
+        const std::uint64_t dropped = logger.GetDroppedCount();
+        releaseSink.store(true);
+        logger.Flush();
+
+        // At most one record is inside the blocked sink and eight more fill the ring.
+        if (dropped < 100 - 9) {
+            std::cerr << "Expected a full ring to drop records instead of blocking producers.\n";
+            ++failureCount;
+        }
+    }
+
+    {
+        CapturedRecords captured;
+        constexpr int kThreadCount = 4;
+        constexpr int kRecordsPerThread = 500;
+        engine::Logger logger(4096);
+        logger.SetSink(captured.MakeSink());
+
+        std::vector<std::thread> producers;
+        for (int threadIndex = 0; threadIndex < kThreadCount; ++threadIndex) {
+            producers.emplace_back([&logger, threadIndex] {
+                for (int recordIndex = 0; recordIndex < kRecordsPerThread; ++recordIndex) {
+                    logger.Write(
+                        engine::LogCategory::Application, engine::LogLevel::Info, "%d %d", threadIndex, recordIndex);
+                }
+            });
+        }
+        for (std::thread& producer : producers) {
+            producer.join();
+        }
+        logger.Flush();
+
+        std::vector<int> nextRecordPerThread(kThreadCount, 0);
+        bool ordered = captured.messages.size() == static_cast<std::size_t>(kThreadCount * kRecordsPerThread);
+        for (const std::string& message : captured.messages) {
+            int threadIndex = -1;
+            int recordIndex = -1;
+            if (std::sscanf(message.c_str(), "%d %d", &threadIndex, &recordIndex) != 2 || threadIndex < 0 ||
+                threadIndex >= kThreadCount || nextRecordPerThread[threadIndex] != recordIndex) {
+                ordered = false;
+                break;
+            }
+            ++nextRecordPerThread[threadIndex];
+        }
+
+        if (!ordered || logger.GetDroppedCount() != 0) {
+            std::cerr << "Expected every record from concurrent producers to arrive in per-thread order.\n";
+            ++failureCount;
+        }
+    }
+
+    return failureCount;
+}
+}
+
+int main() {
+    const int failures = RunLogTests();
+    if (failures > 0) {
+        std::cerr << "Log unit tests failed with " << failures << " failure(s).\n";
+        return 1;
+    }
+
+    std::cout << "Log unit tests passed.\n";
+    return 0;
+}
@@ -0,0 +1,192 @@
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <thread>
+
+#include "Engine/Metrics.hpp"
+
+#if defined(_WIN32)
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace {
+std::string ReadWholeFile(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+// Sends `request` to the listener on `port` and returns everything it answers.
+std::string SendHttpRequest(int port, const std::string& request) {
+#if defined(_WIN32)
+    WSADATA socketData{};
+    WSAStartup(MAKEWORD(2, 2), &socketData);
+    const SOCKET client = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+#else
+    const int client = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+#endif
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(static_cast<std::uint16_t>(port));
+    std::string response;
+    if (connect(client, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0) {
+        send(client, request.data(), static_cast<int>(request.size()), 0);
+        char buffer[4096];
+        for (auto received = recv(client, buffer, sizeof(buffer), 0); received > 0; received = recv(client, buffer, sizeof(buffer), 0)) {
+            response.append(buffer, static_cast<std::size_t>(received));
+        }
+    }
+#if defined(_WIN32)
+    closesocket(client);
+    WSACleanup();
+#else
+    close(client);
+#endif
+    return response;
+}
+
+int RunMetricsTests() {
+    int failureCount = 0;
+
+    engine::MetricsRegistry registry;
+    engine::MetricCounter& frames = registry.AddCounter("engine_frames_total", "Frames presented.");
+    engine::MetricCounter& failedLoads = registry.AddCounter("engine_model_loads_total", "Model loads.", {{"result", "failed"}});
+    engine::MetricCounter& loads = registry.AddCounter("engine_model_loads_total", "Model loads.", {{"result", "succeeded"}});
+    engine::MetricGauge& drawCalls = registry.AddGauge("engine_draw_calls", "Draw calls in the last frame.\nPer frame.");
+    engine::MetricHistogram& frameSeconds = registry.AddHistogram("engine_frame_seconds", "Frame time.", {0.05, 0.01, 0.05});
+    registry.SetInfo("engine_renderer_info", "Renderer backend.", {{"backend", "Vulkan"}});
+    registry.SetInfo("engine_renderer_info", "Renderer backend.", {{"backend", "Soft\"ware\\"}});
+    registry.AddGauge("9 bad-name", "Sanitized.");
+
+    frames.Increment();
+    frames.Increment(2);
+    loads.Increment();
+    failedLoads.Increment(4);
+    drawCalls.Set(12.5);
+    frameSeconds.Observe(0.004);
+    frameSeconds.Observe(0.02);
+    frameSeconds.Observe(0.5);
+    frameSeconds.Observe(0.01);
+
+    std::string text;
+    registry.WritePrometheusText(text);
+    const std::string expected =
+        "# HELP engine_frames_total Frames presented.\n"
+        "# TYPE engine_frames_total counter\n"
+        "engine_frames_total 3\n"
+        "# HELP engine_model_loads_total Model loads.\n"
+        "# TYPE engine_model_loads_total counter\n"
+        "engine_model_loads_total{result=\"failed\"} 4\n"
+        "engine_model_loads_total{result=\"succeeded\"} 1\n"
+        "# HELP engine_draw_calls Draw calls in the last frame.\\nPer frame.\n"
+        "# TYPE engine_draw_calls gauge\n"
+        "engine_draw_calls 12.5\n"
+        "# HELP engine_frame_seconds Frame time.\n"
+        "# TYPE engine_frame_seconds histogram\n"
+        "engine_frame_seconds_bucket{le=\"0.01\"} 2\n"
+        "engine_frame_seconds_bucket{le=\"0.05\"} 3\n"
+        "engine_frame_seconds_bucket{le=\"+Inf\"} 4\n"
+        "engine_frame_seconds_sum 0.534\n"
+        "engine_frame_seconds_count 4\n"
+        "# HELP engine_renderer_info Renderer backend.\n"
+        "# TYPE engine_renderer_info gauge\n"
+        "engine_renderer_info{backend=\"Soft\\\"ware\\\\\"} 1\n"
+        "# HELP _9_bad_name Sanitized.\n"
+        "# TYPE _9_bad_name gauge\n"
+        "_9_bad_name 0\n";
+    if (text != expected) {
+        std::cerr << "Unexpected exposition text:\n" << text;
+        ++failureCount;
+    }
+
+    // Series registered while another thread writes the text are never listed without their metric.
+    engine::MetricsRegistry growing;
+    std::atomic<bool> writing{true};
+    std::thread writer([&]() {
+        std::string snapshot;
+        while (writing.load()) {
+            growing.WritePrometheusText(snapshot);
+        }
+    });
+    for (int index = 0; index < 200; ++index) {
+        growing.AddCounter("engine_growing_total", "Registered during writes.", {{"index", std::to_string(index)}}).Increment();
+    }
+    writing = false;
+    writer.join();
+    std::string grownText;
+    growing.WritePrometheusText(grownText);
+    std::size_t valueCount = 0;
+    for (std::size_t found = grownText.find("\"} 1\n"); found != std::string::npos; found = grownText.find("\"} 1\n", found + 1)) {
+        ++valueCount;
+    }
+    if (valueCount != 200) {
+        std::cerr << "Expected every series registered during writes to be listed with its value.\n";
+        ++failureCount;
+    }
+
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "EngineMetricsTests";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    const std::filesystem::path textFile = directory / "engine.prom";
+    std::string error;
+    if (!engine::WriteMetricsTextFile(registry, textFile, error) || ReadWholeFile(textFile) != text ||
+        std::filesystem::exists(directory / "engine.prom.tmp")) {
+        std::cerr << "Expected the text file to be replaced in one rename: " << error << "\n";
+        ++failureCount;
+    }
+
+    // The exporter writes the file once more when stopped, so it ends with the final values.
+    std::atomic<int> collections{0};
+    engine::MetricsExporter exporter;
+    const engine::MetricsExportSettings settings{0, directory / "exported.prom", 60.0};
+    if (!exporter.Start(registry, settings, [&]() { drawCalls.Set(static_cast<double>(++collections)); }, error) ||
+        !exporter.IsRunning() || exporter.GetHttpPort() <= 0) {
+        std::cerr << "Expected the exporter to start on a free port: " << error << "\n";
+        ++failureCount;
+    } else {
+        const std::string scrape = SendHttpRequest(exporter.GetHttpPort(), "GET /metrics HTTP/1.1\r\nHost: localhost\r\n\r\n");
+        if (!scrape.starts_with("HTTP/1.1 200 OK\r\n") || scrape.find("version=0.0.4") == std::string::npos ||
+            scrape.find("\r\n\r\n# HELP engine_frames_total") == std::string::npos) {
+            std::cerr << "Expected a scrape to return the exposition text.\n";
+            ++failureCount;
+        }
+        if (!SendHttpRequest(exporter.GetHttpPort(), "GET /other HTTP/1.1\r\n\r\n").starts_with("HTTP/1.1 404") ||
+            !SendHttpRequest(exporter.GetHttpPort(), "POST /metrics HTTP/1.1\r\n\r\n").starts_with("HTTP/1.1 405")) {
+            std::cerr << "Expected other paths and methods to be refused.\n";
+            ++failureCount;
+        }
+
+        frames.Increment(7);
+        exporter.Stop();
+        const std::string exported = ReadWholeFile(directory / "exported.prom");
+        if (exporter.IsRunning() || exporter.GetHttpPort() != 0 || exported.find("engine_frames_total 10\n") == std::string::npos ||
+            collections.load() < 3) {
+            std::cerr << "Expected Stop to write the final values and run the collection hook per export.\n";
+            ++failureCount;
+        }
+    }
+
+    std::filesystem::remove_all(directory);
+    return failureCount;
+}
+}
+
+int main() {
+    const int failures = RunMetricsTests();
+    if (failures > 0) {
+        std::cerr << "Metrics unit tests failed with " << failures << " failure(s).\n";
+        return 1;
+    }
+
+    std::cout << "Metrics unit tests passed.\n";
+    return 0;
+}
@@ -0,0 +1,173 @@
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include <glm/geometric.hpp>
+
+#include "Engine/ModelBvh.hpp"
+#include "Engine/ModelCamera.hpp"
+
+namespace {
+engine::ModelData BuildGridModel(int cellsPerSide) {
+    engine::ModelData model;
+    const float step = 2.0f / static_cast<float>(cellsPerSide);
+
+    for (int row = 0; row <= cellsPerSide; ++row) {
+        for (int column = 0; column <= cellsPerSide; ++column) {
+            const float x = -1.0f + static_cast<float>(column) * step;
+            const float y = -1.0f + static_cast<float>(row) * step;
+            const float z = 0.25f * std::sin(x * 3.0f) * std::cos(y * 2.0f);
+            model.positions.emplace_back(x, y, z);
+        }
+    }
+
+    const std::uint32_t rowStride = static_cast<std::uint32_t>(cellsPerSide + 1);
+    for (std::uint32_t row = 0; row < static_cast<std::uint32_t>(cellsPerSide); ++row) {
+        for (std::uint32_t column = 0; column < static_cast<std::uint32_t>(cellsPerSide); ++column) {
+            const std::uint32_t topLeft = row * rowStride + column;
+            model.indices.push_back(topLeft);
+            model.indices.push_back(topLeft + 1);
+            model.indices.push_back(topLeft + rowStride);
+            model.indices.push_back(topLeft + 1);
+            model.indices.push_back(topLeft + rowStride + 1);
+            model.indices.push_back(topLeft + rowStride);
+        }
+    }
+
+    const std::uint32_t halfIndexCount = static_cast<std::uint32_t>(model.indices.size() / 2);
+    model.materials.push_back(engine::ModelMaterial{-1, -1, -1, -1, -1, 1.0f, 0.0f, false, false, false});
+    model.submeshes.push_back(engine::ModelSubmesh{0, halfIndexCount, 0});
+    model.submeshes.push_back(engine::ModelSubmesh{
+        halfIndexCount,
+        static_cast<std::uint32_t>(model.indices.size()) - halfIndexCount,
+        0});
+    return model;
+}
+
+std::optional<float> BruteForceIntersect(const engine::ModelData& model, const engine::ModelRay& ray, std::uint32_t& outTriangle) {
+    std::optional<float> closest;
+    for (std::size_t index = 0; index + 2 < model.indices.size(); index += 3) {
+        const glm::vec3& p0 = model.positions[model.indices[index]];
+        const glm::vec3 edge1 = model.positions[model.indices[index + 1]] - p0;
+        const glm::vec3 edge2 = model.positions[model.indices[index + 2]] - p0;
+        const glm::vec3 pvec = glm::cross(ray.direction, edge2);
+        const float determinant = glm::dot(edge1, pvec);
+        if (std::fabs(determinant) < 1.0e-12f) {
+            continue;
+        }
+
+        const glm::vec3 tvec = ray.origin - p0;
+        const float u = glm::dot(tvec, pvec) / determinant;
+        const glm::vec3 qvec = glm::cross(tvec, edge1);
+        const float v = glm::dot(ray.direction, qvec) / determinant;
+        const float distance = glm::dot(edge2, qvec) / determinant;
+        if (u < 0.0f || v < 0.0f || u + v > 1.0f || distance <= 1.0e-6f) {
+            continue;
+        }
+
+        if (!closest.has_value() || distance < *closest) {
+            closest = distance;
+            outTriangle = static_cast<std::uint32_t>(index / 3);
+        }
+    }
+    return closest;
+}
+
+int RunModelBvhTests() {
+    int failureCount = 0;
+
+    const engine::ModelBvh emptyBvh = engine::ModelBvh::Build({}, {}, {});
+    if (!emptyBvh.IsEmpty() || emptyBvh.Intersect({glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f)}).has_value()) {
+        std::cerr << "Expected empty BVH to report no hits.\n";
+        ++failureCount;
+    }
+
+    const engine::ModelData model = BuildGridModel(48);
+    const engine::ModelBvh bvh = engine::ModelBvh::Build(model.positions, model.indices, model.submeshes);
+    if (bvh.GetTriangleCount() != model.indices.size() / 3) {
+        std::cerr << "Expected BVH to reference every triangle exactly once.\n";
+        ++failureCount;
+    }
+
+    if (bvh.GetSubmeshBounds().size() != model.submeshes.size()) {
+        std::cerr << "Expected BVH to expose bounds for every submesh.\n";
+        ++failureCount;
+    }
+
+    std::mt19937 generator(1234u);
+    std::uniform_real_distribution<float> offsetDistribution(-1.2f, 1.2f);
+    std::uniform_real_distribution<float> tiltDistribution(-0.4f, 0.4f);
+    int mismatchCount = 0;
+    int hitCount = 0;
+    for (int rayIndex = 0; rayIndex < 2000; ++rayIndex) {
+        const engine::ModelRay ray{
+            glm::vec3(offsetDistribution(generator), offsetDistribution(generator), 3.0f),
+            glm::normalize(glm::vec3(tiltDistribution(generator), tiltDistribution(generator), -1.0f))};
+
+        std::uint32_t expectedTriangle = 0;
+        const std::optional<float> expected = BruteForceIntersect(model, ray, expectedTriangle);
+        const std::optional<engine::ModelRayHit> actual = bvh.Intersect(ray);
+        if (expected.has_value() != actual.has_value()) {
+            ++mismatchCount;
+            continue;
+        }
+
+        if (!expected.has_value()) {
+            continue;
+        }
+
+        ++hitCount;
+        if (std::fabs(*expected - actual->distance) > 1.0e-4f) {
+            ++mismatchCount;
+            continue;
+        }
+
+        const std::uint32_t expectedSubmesh = actual->triangleIndex * 3 < model.submeshes[1].indexStart ? 0u : 1u;
+        if (actual->submeshIndex != expectedSubmesh) {
+            ++mismatchCount;
+        }
+    }
+
+    if (mismatchCount > 0) {
+        std::cerr << "Expected BVH hits to match brute force intersection; mismatches: " << mismatchCount << "\n";
+        ++failureCount;
+    }
+
+    if (hitCount == 0) {
+        std::cerr << "Expected at least one random ray to hit the grid.\n";
+        ++failureCount;
+    }
+
+    const engine::ModelRay limitedRay{glm::vec3(0.0f, 0.0f, 3.0f), glm::vec3(0.0f, 0.0f, -1.0f)};
+    if (bvh.Intersect(limitedRay, 1.0f).has_value()) {
+        std::cerr << "Expected BVH query to respect the maximum distance.\n";
+        ++failureCount;
+    }
+
+    const engine::ModelCamera camera{30.0f, -20.0f, 0.0f, 4.0f, glm::vec3(0.25f, -0.1f, 0.0f)};
+    const engine::ModelRay centerRay = engine::BuildModelSpacePickRay(camera, 16.0f / 9.0f, 0.0f, 0.0f);
+    const glm::vec3 toPivot = camera.orbitPivot - centerRay.origin;
+    const float distanceFromRay = glm::length(toPivot - centerRay.direction * glm::dot(toPivot, centerRay.direction));
+    if (distanceFromRay > 1.0e-3f) {
+        std::cerr << "Expected the screen-center pick ray to pass through the orbit pivot.\n";
+        ++failureCount;
+    }
+
+    return failureCount;
+}
+}
+
+int main() {
+    const int failures = RunModelBvhTests();
+    if (failures > 0) {
+        std::cerr << "ModelBvh unit tests failed with " << failures << " failure(s).\n";
+        return 1;
+    }
+
+    std::cout << "ModelBvh unit tests passed.\n";
+    return 0;
+}
@@ -0,0 +1,174 @@
+#include <cstdint>
+#include <iostream>
+#include <set>
+#include <tuple>
+#include <vector>
+
+#include "Engine/ModelCook.hpp"
+
+namespace {
+engine::ModelMaterial MakeMaterial(std::int32_t textureIndex, float opacity) {
+    return engine::ModelMaterial{textureIndex, -1, -1, -1, -1, opacity, 0.0f, opacity < 0.999f, false, false};
+}
+
+engine::ModelData BuildInterleavedModel() {
+    engine::ModelData model;
+    for (int vertex = 0; vertex < 24; ++vertex) {
+        model.positions.emplace_back(static_cast<float>(vertex), 0.0f, 0.0f);
+        model.texCoords.emplace_back(0.0f, 0.0f);
+    }
+
+    for (std::uint32_t triangle = 0; triangle < 8; ++triangle) {
+        model.indices.push_back(triangle * 3);
+        model.indices.push_back(triangle * 3 + 1);
+        model.indices.push_back(triangle * 3 + 2);
+    }
+
+    // Materials 0 and 2 are identical and should collapse; material 3 is never referenced.
+    model.materials.push_back(MakeMaterial(0, 1.0f));
+    model.materials.push_back(MakeMaterial(1, 0.5f));
+    model.materials.push_back(MakeMaterial(0, 1.0f));
+    model.materials.push_back(MakeMaterial(2, 1.0f));
+
+    model.submeshes.push_back(engine::ModelSubmesh{0, 6, 0});
+    model.submeshes.push_back(engine::ModelSubmesh{6, 3, 1});
+    model.submeshes.push_back(engine::ModelSubmesh{9, 6, 2});
+    model.submeshes.push_back(engine::ModelSubmesh{15, 3, 1});
+    model.submeshes.push_back(engine::ModelSubmesh{18, 6, 0});
+    return model;
+}
+
+using TriangleKey = std::tuple<std::uint32_t, std::uint32_t, std::uint32_t, std::int32_t>;
+
+std::multiset<TriangleKey> CollectTriangles(const engine::ModelData& model) {
+    std::multiset<TriangleKey> triangles;
+    for (const engine::ModelSubmesh& submesh : model.submeshes) {
+        const engine::ModelMaterial* material = model.FindMaterial(submesh);
+        const std::int32_t textureIndex = material ? material->textureIndex : -2;
+        for (std::uint32_t index = submesh.indexStart; index + 2 < submesh.indexStart + submesh.indexCount; index += 3) {
+            triangles.emplace(model.indices[index], model.indices[index + 1], model.indices[index + 2], textureIndex);
+        }
+    }
+    return triangles;
+}
+
+int RunModelCookTests() {
+    int failureCount = 0;
+
+    engine::ModelData model = BuildInterleavedModel();
+    const std::multiset<TriangleKey> trianglesBefore = CollectTriangles(model);
+    const engine::SubmeshMergeStats stats = engine::MergeSubmeshesByMaterial(model);
+
+    if (stats.submeshCountBefore != 5 || stats.submeshCountAfter != 2) {
+        std::cerr << "Expected five submeshes to merge into two, got " << stats.submeshCountAfter << ".\n";
+        ++failureCount;
+    }
+
+    if (stats.materialCountBefore != 4 || stats.materialCountAfter != 2 || model.materials.size() != 2) {
+        std::cerr << "Expected duplicate and unused materials to be removed from the table.\n";
+        ++failureCount;
+    }
+
+    std::uint32_t expectedStart = 0;
+    for (std::size_t submeshIndex = 0; submeshIndex < model.submeshes.size(); ++submeshIndex) {
+        const engine::ModelSubmesh& submesh = model.submeshes[submeshIndex];
+        if (submesh.indexStart != expectedStart || submesh.materialIndex != submeshIndex) {
+            std::cerr << "Expected merged submeshes to be contiguous and ordered by material.\n";
+            ++failureCount;
+        }
+        expectedStart += submesh.indexCount;
+    }
+
+    if (expectedStart != model.indices.size()) {
+        std::cerr << "Expected merged submeshes to cover the whole index buffer.\n";
+        ++failureCount;
+    }
+
+    if (CollectTriangles(model) != trianglesBefore) {
+        std::cerr << "Expected merging to keep every triangle bound to an equivalent material.\n";
+        ++failureCount;
+    }
+
+    if (!model.submeshes.empty() && (model.submeshes[0].indexCount != 18 || model.indices[6] != 9)) {
+        std::cerr << "Expected merged ranges to keep the original triangle order within a material.\n";
+        ++failureCount;
+    }
+
+    engine::ModelData emptyModel;
+    const engine::SubmeshMergeStats emptyStats = engine::MergeSubmeshesByMaterial(emptyModel);
+    if (emptyStats.submeshCountAfter != 0 || !emptyModel.indices.empty()) {
+        std::cerr << "Expected merging an empty model to be a no-op.\n";
+        ++failureCount;
+    }
+
+    engine::ModelData invalidMaterialModel = BuildInterleavedModel();
+    invalidMaterialModel.submeshes[1].materialIndex = 42;
+    engine::MergeSubmeshesByMaterial(invalidMaterialModel);
+    if (invalidMaterialModel.indices.size() != 24 || invalidMaterialModel.FindMaterial(invalidMaterialModel.submeshes.back()) != nullptr) {
+        std::cerr << "Expected submeshes with an invalid material to be kept last without a material.\n";
+        ++failureCount;
+    }
+
+    engine::ModelData validModel = BuildInterleavedModel();
+    if (engine::ValidateTriangleIndices(validModel) != 0 || validModel.indices.size() != 24 || !validModel.indicesValidated) {
+        std::cerr << "Expected a model with valid indices to be marked validated unchanged.\n";
+        ++failureCount;
+    }
+
+    // Triangle 1 (first submesh) and triangle 5 (fourth submesh) point past the vertex array.
+    engine::ModelData brokenModel = BuildInterleavedModel();
+    brokenModel.indices[4] = 24;
+    brokenModel.indices[16] = 1000;
+    brokenModel.indices.push_back(0);
+    const std::size_t removed = engine::ValidateTriangleIndices(brokenModel);
+    const std::vector<engine::ModelSubmesh>& submeshes = brokenModel.submeshes;
+    if (removed != 2 || brokenModel.indices.size() != 18 || !brokenModel.indicesValidated || submeshes.size() != 5 ||
+        submeshes[0].indexStart != 0 || submeshes[0].indexCount != 3 ||
+        submeshes[1].indexStart != 3 || submeshes[2].indexStart != 6 || submeshes[2].indexCount != 6 ||
+        submeshes[3].indexCount != 0 || submeshes[4].indexStart != 12 || submeshes[4].indexCount != 6 ||
+        brokenModel.indices[3] != 6 || brokenModel.indices[12] != 18) {
+        std::cerr << "Expected invalid triangles to be removed and submesh ranges shifted to match.\n";
+        ++failureCount;
+    }
+
+    // A PBR-style material: color 0, opacity 1, normal 2, emissive 3, specular 4. Slot 5 belongs
+    // to a material no submesh draws with.
+    engine::ModelData pbrModel = BuildInterleavedModel();
+    pbrModel.texturePaths = {"albedo.png", "opacity.png", "normal.png", "emissive.png", "specular.png", "unused.png"};
+    pbrModel.materials = {
+        engine::ModelMaterial{0, 1, 2, 3, 4, 1.0f, 0.0f, false, false, false},
+        MakeMaterial(5, 1.0f)};
+    for (engine::ModelSubmesh& submesh : pbrModel.submeshes) {
+        submesh.materialIndex = 0;
+    }
+    const std::vector<bool> colorAndOpacity =
+        engine::FindTexturesForChannels(pbrModel, engine::kMaterialChannelColor | engine::kMaterialChannelOpacity);
+    const std::vector<bool> allChannels = engine::FindTexturesForChannels(pbrModel, engine::kAllMaterialChannels);
+    if (colorAndOpacity != std::vector<bool>{true, true, false, false, false, false} ||
+        allChannels != std::vector<bool>{true, true, true, true, true, false}) {
+        std::cerr << "Expected only textures reached through the requested channels of drawn materials.\n";
+        ++failureCount;
+    }
+
+    engine::ModelData unsubmeshedModel;
+    unsubmeshedModel.texturePaths = {"primary.png", "other.png"};
+    if (engine::FindTexturesForChannels(unsubmeshedModel, engine::kMaterialChannelColor) != std::vector<bool>{true, false} ||
+        engine::FindTexturesForChannels(unsubmeshedModel, engine::kMaterialChannelNormal) != std::vector<bool>{false, false}) {
+        std::cerr << "Expected a model without submeshes to sample slot 0 as color.\n";
+        ++failureCount;
+    }
+
+    return failureCount;
+}
+}
+
+int main() {
+    const int failures = RunModelCookTests();
+    if (failures > 0) {
+        std::cerr << "ModelCook unit tests failed with " << failures << " failure(s).\n";
+        return 1;
+    }
+
+    std::cout << "ModelCook unit tests passed.\n";
+    return 0;
+}
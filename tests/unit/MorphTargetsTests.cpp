@@ -0,0 +1,163 @@
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "Engine/MorphTargets.hpp"
+
+namespace {
+// Rest position plus every weighted delta, computed densely as the reference for the blender.
+std::vector<glm::vec3> BlendDensely(const engine::ModelData& model, const std::vector<glm::vec3>& rest, const std::vector<float>& weights) {
+    std::vector<glm::vec3> positions = rest;
+    for (std::size_t targetIndex = 0; targetIndex < model.morphTargets.size(); ++targetIndex) {
+        const engine::MorphTarget& target = model.morphTargets[targetIndex];
+        for (std::size_t entry = 0; entry < target.vertexIndices.size(); ++entry) {
+            positions[target.vertexIndices[entry]] += glm::vec3(
+                static_cast<float>(target.deltas[entry * 3]),
+                static_cast<float>(target.deltas[entry * 3 + 1]),
+                static_cast<float>(target.deltas[entry * 3 + 2])) * (weights[targetIndex] * target.deltaScale);
+        }
+    }
+    return positions;
+}
+
+float LargestDifference(const std::vector<glm::vec3>& left, const std::vector<glm::vec3>& right) {
+    float largest = 0.0f;
+    for (std::size_t vertex = 0; vertex < left.size(); ++vertex) {
+        const glm::vec3 difference = left[vertex] - right[vertex];
+        largest = std::max({largest, std::abs(difference.x), std::abs(difference.y), std::abs(difference.z)});
+    }
+    return largest;
+}
+
+int RunQuantizationTests() {
+    int failureCount = 0;
+
+    const std::vector<glm::vec3> deltas = {
+        glm::vec3(0.0f), glm::vec3(0.5f, -0.25f, 0.0f), glm::vec3(1.0e-6f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, -2.0f), glm::vec3(NAN, 0.0f, 0.0f)};
+    const engine::MorphTarget target = engine::QuantizeMorphTarget("Blink", deltas, 10, 0.5f);
+    const bool indicesMatch = target.vertexIndices == std::vector<std::uint32_t>{11, 13};
+    const float dequantizedY = indicesMatch ? static_cast<float>(target.deltas[1]) * target.deltaScale : 0.0f;
+    if (!indicesMatch || target.deltas.size() != 6 || target.deltas[5] != -32767 || std::abs(dequantizedY + 0.25f) > 2.0f / 32767.0f ||
+        target.name != "Blink" || target.defaultWeight != 0.5f) {
+        std::cerr << "Expected only vertices with a representable delta to be kept, quantized against the largest component.\n";
+        ++failureCount;
+    }
+
+    const engine::MorphTarget still = engine::QuantizeMorphTarget("Still", std::vector<glm::vec3>(4, glm::vec3(0.0f)), 0, 0.0f);
+    if (!still.vertexIndices.empty() || !still.deltas.empty()) {
+        std::cerr << "Expected a target that moves nothing to store nothing.\n";
+        ++failureCount;
+    }
+
+    std::vector<engine::MorphTarget> targets{target, still};
+    engine::AppendMorphTargetDuplicates(targets, {13, 12, 11}, 20);
+    if (targets[0].vertexIndices != std::vector<std::uint32_t>{11, 13, 20, 22} || targets[0].deltas.size() != 12 ||
+        targets[0].deltas[6] != targets[0].deltas[3] || targets[0].deltas[9] != targets[0].deltas[0] || !targets[1].vertexIndices.empty()) {
+        std::cerr << "Expected duplicated vertices to join the targets of their sources.\n";
+        ++failureCount;
+    }
+
+    return failureCount;
+}
+
+int RunWeightSamplingTests() {
+    int failureCount = 0;
+
+    engine::ModelData model;
+    model.morphTargets.push_back(engine::MorphTarget{"A", {}, {}, 0.0f, 0.0f});
+    model.morphTargets.push_back(engine::MorphTarget{"B", {}, {}, 0.0f, 0.3f});
+    engine::AnimationClip clip{"Talk", 2.0f, 30.0f, {}};
+    clip.morphCurves.push_back(engine::MorphWeightCurve{0, {{0.5f, 0.0f}, {1.0f, 1.0f}, {1.5f, 0.5f}}});
+    clip.morphCurves.push_back(engine::MorphWeightCurve{7, {{0.0f, 1.0f}}});
+
+    std::vector<float> weights;
+    engine::SampleMorphWeights(model, &clip, 0.75f, weights);
+    const bool between = weights.size() == 2 && std::abs(weights[0] - 0.5f) < 1.0e-6f && weights[1] == 0.3f;
+    engine::SampleMorphWeights(model, &clip, 0.0f, weights);
+    const bool before = weights[0] == 0.0f;
+    engine::SampleMorphWeights(model, &clip, 1.75f, weights);
+    const bool after = weights[0] == 0.5f;
+    engine::SampleMorphWeights(model, nullptr, 1.0f, weights);
+    const bool noClip = weights[0] == 0.0f && weights[1] == 0.3f;
+    if (!between || !before || !after || !noClip) {
+        std::cerr << "Expected curves to interpolate between keys, hold their ends and fall back to default weights.\n";
+        ++failureCount;
+    }
+
+    return failureCount;
+}
+
+int RunBlenderTests() {
+    int failureCount = 0;
+
+    // 5000 vertices; targets overlap, one covers a whole 1024-vertex block and one is malformed.
+    engine::ModelData model;
+    std::mt19937 random(11);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    for (int vertex = 0; vertex < 5000; ++vertex) {
+        model.positions.emplace_back(unit(random), unit(random), unit(random));
+    }
+    const std::vector<glm::vec3> rest = model.positions;
+    auto addTarget = [&](std::uint32_t first, std::uint32_t end, std::uint32_t stride) {
+        std::vector<glm::vec3> deltas(end - first, glm::vec3(0.0f));
+        for (std::uint32_t vertex = 0; vertex < deltas.size(); vertex += stride) {
+            deltas[vertex] = glm::vec3(unit(random), unit(random), unit(random)) * 0.1f;
+        }
+        model.morphTargets.push_back(engine::QuantizeMorphTarget("Target", deltas, first, 0.0f));
+    };
+    addTarget(100, 1500, 3);
+    addTarget(1000, 2600, 1);
+    addTarget(2400, 4000, 7);
+    model.morphTargets.push_back(engine::MorphTarget{"Broken", {4, 2}, {1, 1, 1, 1, 1, 1}, 1.0f, 0.0f});
+
+    engine::MorphTargetBlender blender;
+    blender.Reset(model);
+    // Every third vertex of 100..999, all of 1000..2599 and every seventh of 2603..3999.
+    const std::size_t expectedMoved = 300 + 1600 + 200;
+    if (blender.GetMovedVertexCount() != expectedMoved) {
+        std::cerr << "Expected the blender to track the union of the well-formed targets, got " << blender.GetMovedVertexCount() << ".\n";
+        ++failureCount;
+    }
+
+    const std::vector<float> weights{0.5f, -1.0f, 2.0f, 1.0f};
+    const std::size_t written = blender.Apply(weights, model);
+    const float blendError = LargestDifference(model.positions, BlendDensely(model, rest, {0.5f, -1.0f, 2.0f, 0.0f}));
+    bool untouchedKept = true;
+    for (const std::uint32_t vertex : {0u, 99u, 4000u, 4999u}) {
+        untouchedKept = untouchedKept && model.positions[vertex] == rest[vertex];
+    }
+    if (written != expectedMoved || blendError > 1.0e-5f || !untouchedKept) {
+        std::cerr << "Expected the sparse blend to match the dense reference, got an error of " << blendError << ".\n";
+        ++failureCount;
+    }
+
+    const std::size_t repeated = blender.Apply(weights, model);
+    const std::size_t restored = blender.Apply({0.0f, 0.0f, 0.0f, 0.0f}, model);
+    if (repeated != 0 || restored != expectedMoved || model.positions != rest) {
+        std::cerr << "Expected unchanged weights to skip the blend and zero weights to restore the rest pose exactly.\n";
+        ++failureCount;
+    }
+
+    engine::ModelData resized = model;
+    resized.positions.pop_back();
+    if (blender.Apply({1.0f, 1.0f, 1.0f, 1.0f}, resized) != 0 || blender.Apply({1.0f}, model) != 0 || model.positions != rest) {
+        std::cerr << "Expected a model or weight list the blender was not reset for to be left alone.\n";
+        ++failureCount;
+    }
+
+    return failureCount;
+}
+}
+
+int main() {
+    const int failures = RunQuantizationTests() + RunWeightSamplingTests() + RunBlenderTests();
+    if (failures > 0) {
+        std::cerr << "MorphTargets unit tests failed with " << failures << " failure(s).\n";
+        return 1;
+    }
+
+    std::cout << "MorphTargets unit tests passed.\n";
+    return 0;
+}
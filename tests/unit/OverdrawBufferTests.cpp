@@ -0,0 +1,125 @@
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "Engine/OverdrawBuffer.hpp"
+
+namespace {
+int RunOverdrawBufferTests() {
+    int failureCount = 0;
+
+    engine::OverdrawBuffer quad;
+    quad.Reset(8, 8);
+    quad.AddTriangle({1.0f, 1.0f}, {5.0f, 1.0f}, {5.0f, 5.0f});
+    quad.AddTriangle({1.0f, 1.0f}, {5.0f, 5.0f}, {1.0f, 5.0f});
+    const engine::OverdrawStatistics quadStatistics = quad.ComputeStatistics();
+    if (quadStatistics.coveredPixels != 16 || quadStatistics.shadedPixels != 16 || quadStatistics.maxOverdraw != 1 ||
+        quadStatistics.averageOverdraw != 1.0 || quad.GetCount(0, 0) != 0 || quad.GetCount(4, 4) != 1) {
+        std::cerr << "Expected two triangles splitting a 4x4 square to cover each pixel once.\n";
+        ++failureCount;
+    }
+
+    // The reversed winding is drawn too, stacking on the same pixels.
+    quad.AddTriangle({1.0f, 1.0f}, {1.0f, 5.0f}, {5.0f, 5.0f});
+    quad.AddTriangle({1.0f, 1.0f}, {5.0f, 5.0f}, {5.0f, 1.0f});
+    const engine::OverdrawStatistics doubled = quad.ComputeStatistics();
+    if (doubled.coveredPixels != 16 || doubled.shadedPixels != 32 || doubled.maxOverdraw != 2 || doubled.averageOverdraw != 2.0) {
+        std::cerr << "Expected a second, reversed copy of the square to double every count.\n";
+        ++failureCount;
+    }
+
+    // A fan with fractional vertices: every pixel inside is owned by exactly one triangle.
+    engine::OverdrawBuffer fan;
+    fan.Reset(64, 64);
+    constexpr int kSegments = 37;
+    const engine::OverdrawPoint center{31.3f, 32.7f};
+    for (int segment = 0; segment < kSegments; ++segment) {
+        const float angle0 = 6.2831853f * static_cast<float>(segment) / kSegments;
+        const float angle1 = 6.2831853f * static_cast<float>(segment + 1) / kSegments;
+        fan.AddTriangle(
+            center,
+            {center.x + 27.1f * std::cos(angle0), center.y + 27.1f * std::sin(angle0)},
+            {center.x + 27.1f * std::cos(angle1), center.y + 27.1f * std::sin(angle1)});
+    }
+    const engine::OverdrawStatistics fanStatistics = fan.ComputeStatistics();
+    if (fanStatistics.maxOverdraw != 1 || fanStatistics.coveredPixels < 2200 || fanStatistics.coveredPixels > 2320) {
+        std::cerr << "Expected a triangle fan to cover its disc without counting shared edges twice (max "
+                  << fanStatistics.maxOverdraw << ", covered " << fanStatistics.coveredPixels << ").\n";
+        ++failureCount;
+    }
+
+    // Filling in row bands matches filling the whole buffer at once.
+    engine::OverdrawBuffer banded;
+    banded.Reset(64, 64);
+    for (int bandStart = 0; bandStart < 64; bandStart += 5) {
+        for (int segment = 0; segment < kSegments; ++segment) {
+            const float angle0 = 6.2831853f * static_cast<float>(segment) / kSegments;
+            const float angle1 = 6.2831853f * static_cast<float>(segment + 1) / kSegments;
+            banded.AddTriangle(
+                center,
+                {center.x + 27.1f * std::cos(angle0), center.y + 27.1f * std::sin(angle0)},
+                {center.x + 27.1f * std::cos(angle1), center.y + 27.1f * std::sin(angle1)},
+                bandStart,
+                bandStart + 5);
+        }
+    }
+    bool bandsMatch = true;
+    for (int y = 0; y < 64; ++y) {
+        for (int x = 0; x < 64; ++x) {
+            bandsMatch = bandsMatch && banded.GetCount(x, y) == fan.GetCount(x, y);
+        }
+    }
+    if (!bandsMatch) {
+        std::cerr << "Expected row bands to produce the same counts as a single pass.\n";
+        ++failureCount;
+    }
+
+    // Degenerate, off-screen and non-finite triangles are clipped or ignored.
+    engine::OverdrawBuffer clipped;
+    clipped.Reset(16, 16);
+    clipped.AddTriangle({2.0f, 2.0f}, {8.0f, 8.0f}, {12.0f, 12.0f});
+    clipped.AddTriangle({-100.0f, -100.0f}, {-50.0f, -100.0f}, {-50.0f, -50.0f});
+    clipped.AddTriangle({-1.0e9f, -1.0e9f}, {1.0e9f, -1.0e9f}, {0.0f, 1.0e9f});
+    clipped.AddTriangle({NAN, 0.0f}, {4.0f, 0.0f}, {4.0f, 4.0f});
+    const engine::OverdrawStatistics clippedStatistics = clipped.ComputeStatistics();
+    if (clippedStatistics.coveredPixels != 256 || clippedStatistics.maxOverdraw > 2) {
+        std::cerr << "Expected only the screen-covering triangle to count inside the viewport.\n";
+        ++failureCount;
+    }
+
+    std::vector<std::uint8_t> heatmap;
+    engine::OverdrawBuffer stacked;
+    stacked.Reset(4, 1);
+    for (int layer = 0; layer < 12; ++layer) {
+        stacked.AddTriangle({1.0f, -1.0f}, {5.0f, -1.0f}, {5.0f, 3.0f});
+    }
+    stacked.WriteHeatmap(heatmap, 8);
+    const bool emptyIsBlack = heatmap.size() == 16 && heatmap[0] == 0 && heatmap[1] == 0 && heatmap[2] == 0 && heatmap[3] == 255;
+    const bool saturatedIsWhite = heatmap.size() == 16 && heatmap[12] == 255 && heatmap[13] == 255 && heatmap[14] == 255;
+    if (!emptyIsBlack || !saturatedIsWhite) {
+        std::cerr << "Expected the heatmap to be black where empty and white past saturation.\n";
+        ++failureCount;
+    }
+
+    engine::OverdrawBuffer empty;
+    empty.Reset(0, 0);
+    empty.AddTriangle({0.0f, 0.0f}, {4.0f, 0.0f}, {4.0f, 4.0f});
+    if (empty.ComputeStatistics().averageOverdraw != 0.0 || empty.GetCount(0, 0) != 0) {
+        std::cerr << "Expected an empty buffer to report no overdraw.\n";
+        ++failureCount;
+    }
+
+    return failureCount;
+}
+}
+
+int main() {
+    const int failures = RunOverdrawBufferTests();
+    if (failures > 0) {
+        std::cerr << "OverdrawBuffer unit tests failed with " << failures << " failure(s).\n";
+        return 1;
+    }
+
+    std::cout << "OverdrawBuffer unit tests passed.\n";
+    return 0;
+}
@@ -0,0 +1,133 @@
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <set>
+#include <tuple>
+#include <vector>
+
+#include "Engine/PointCloudPreview.hpp"
+
+namespace {
+// A flat `size` x `size` vertex grid in the z = 0 plane spanning [-1, 1], wound to face +z.
+engine::ModelData BuildGrid(int size) {
+    engine::ModelData model;
+    for (int row = 0; row < size; ++row) {
+        for (int column = 0; column < size; ++column) {
+            model.positions.emplace_back(
+                -1.0f + 2.0f * static_cast<float>(column) / static_cast<float>(size - 1),
+                -1.0f + 2.0f * static_cast<float>(row) / static_cast<float>(size - 1),
+                0.0f);
+        }
+    }
+    for (int row = 0; row + 1 < size; ++row) {
+        for (int column = 0; column + 1 < size; ++column) {
+            const std::uint32_t corner = static_cast<std::uint32_t>(row * size + column);
+            const std::uint32_t stride = static_cast<std::uint32_t>(size);
+            model.indices.insert(model.indices.end(), {corner, corner + 1, corner + stride + 1, corner, corner + stride + 1, corner + stride});
+        }
+    }
+    return model;
+}
+
+using Cell = std::tuple<int, int, int>;
+
+Cell CellOf(const glm::vec3& position, const glm::vec3& minimum, float cellSize) {
+    const auto axis = [cellSize](float offset) { return static_cast<int>(std::floor(offset / cellSize * (1.0f - 1.0e-6f))); };
+    return {axis(position.x - minimum.x), axis(position.y - minimum.y), axis(position.z - minimum.z)};
+}
+
+int RunPointCloudPreviewTests() {
+    int failureCount = 0;
+
+    const engine::ModelData grid = BuildGrid(64);
+    const engine::PointCloudPreview preview = engine::BuildPointCloudPreview(grid, 300);
+    std::set<Cell> occupiedCells;
+    for (const glm::vec3& position : grid.positions) {
+        occupiedCells.insert(CellOf(position, glm::vec3(-1.0f, -1.0f, 0.0f), preview.cellSize));
+    }
+    std::set<Cell> previewCells;
+    bool pointsAreVertices = true;
+    bool normalsFaceUp = true;
+    for (const engine::PointCloudPreviewPoint& point : preview.points) {
+        previewCells.insert(CellOf(point.position, glm::vec3(-1.0f, -1.0f, 0.0f), preview.cellSize));
+        const float column = (point.position.x + 1.0f) * 63.0f / 2.0f;
+        pointsAreVertices = pointsAreVertices && std::abs(column - std::round(column)) < 1.0e-3f;
+        normalsFaceUp = normalsFaceUp && point.packedNormal == 0x7f0000u;
+    }
+    // A 64x64 grid over a 2-unit cube fills 16x16 cells at level 4 (256 <= 300) and 32x32 at level 5.
+    if (preview.sourceVertexCount != grid.positions.size() || std::abs(preview.cellSize - 0.125f) > 1.0e-6f ||
+        preview.points.size() != 256 || previewCells.size() != preview.points.size() || previewCells != occupiedCells) {
+        std::cerr << "Expected one point in each occupied cell of the finest level within the budget, got "
+                  << preview.points.size() << " points of size " << preview.cellSize << ".\n";
+        ++failureCount;
+    }
+    if (!pointsAreVertices || !normalsFaceUp) {
+        std::cerr << "Expected points to be source vertices carrying the +z face normal.\n";
+        ++failureCount;
+    }
+
+    const engine::PointCloudPreview everything = engine::BuildPointCloudPreview(grid, grid.positions.size());
+    const engine::PointCloudPreview nothing = engine::BuildPointCloudPreview(engine::ModelData{}, 100);
+    if (everything.points.size() != grid.positions.size() || !nothing.points.empty()) {
+        std::cerr << "Expected a budget covering every vertex to keep them all.\n";
+        ++failureCount;
+    }
+
+    engine::SplatBuffer buffer;
+    buffer.Reset(8, 8);
+    buffer.AddSplat(2.5f, 2.5f, 0.5f, 1, 0xff0000ffu);
+    buffer.AddSplat(2.5f, 2.5f, 0.7f, 1, 0xff00ff00u);
+    buffer.AddSplat(5.0f, 5.0f, 0.2f, 2, 0xffff0000u);
+    buffer.AddSplat(2.5f, 2.5f, NAN, 1, 0xffffffffu);
+    buffer.AddSplat(-100.0f, 2.5f, 0.1f, 1, 0xffffffffu);
+    buffer.AddSplat(0.2f, 7.9f, 0.1f, 8, 0xff00ffffu);
+    std::vector<std::uint8_t> rgba;
+    buffer.WriteRgba(rgba);
+    if (buffer.GetColor(2, 2) != 0xff0000ffu || buffer.GetColor(4, 4) != 0xffff0000u || buffer.GetColor(5, 5) != 0xffff0000u ||
+        buffer.GetColor(6, 6) != 0 || buffer.GetColor(0, 7) != 0xff00ffffu || buffer.GetColor(3, 7) != 0xff00ffffu ||
+        buffer.GetColor(4, 7) != 0 || buffer.CountCoveredPixels() != 1 + 4 + 16 || rgba.size() != 8 * 8 * 4 ||
+        rgba[(2 * 8 + 2) * 4] != 0xff || rgba[(6 * 8 + 6) * 4 + 3] != 0) {
+        std::cerr << "Expected the nearest splat to win each pixel and clipped squares to stay in bounds.\n";
+        ++failureCount;
+    }
+
+    // Seen head-on, the grid fills the middle of the view and every splat is lit at full strength.
+    const engine::ModelCamera camera{0.0f, 0.0f, 0.0f, 4.0f, glm::vec3(0.0f)};
+    buffer.Reset(64, 64);
+    const std::size_t drawn = engine::SplatPointCloudPreview(preview, engine::BuildModelViewProjection(camera, 1.0f), buffer);
+    const std::uint32_t center = buffer.GetColor(32, 32);
+    if (drawn != preview.points.size() || (center & 0xffu) < 210 || buffer.GetColor(1, 1) != 0 ||
+        buffer.CountCoveredPixels() < 20 * 20) {
+        std::cerr << "Expected the head-on grid to cover the middle of the view, drew " << drawn << " covering "
+                  << buffer.CountCoveredPixels() << " pixels.\n";
+        ++failureCount;
+    }
+
+    engine::CameraMotionTracker tracker(0.25);
+    const engine::ModelCamera turned{10.0f, 0.0f, 0.0f, 4.0f, glm::vec3(0.0f)};
+    const bool firstFrame = tracker.Update(camera, 0.0);
+    const bool still = tracker.Update(camera, 0.5);
+    const bool moved = tracker.Update(turned, 1.0);
+    const bool settling = tracker.Update(turned, 1.2);
+    const bool settled = tracker.Update(turned, 1.3);
+    tracker.Reset();
+    const bool afterReset = tracker.Update(camera, 1.31);
+    if (firstFrame || still || !moved || !settling || settled || afterReset) {
+        std::cerr << "Expected motion to hold the preview for the settle time and no longer.\n";
+        ++failureCount;
+    }
+
+    return failureCount;
+}
+}
+
+int main() {
+    const int failures = RunPointCloudPreviewTests();
+    if (failures > 0) {
+        std::cerr << "PointCloudPreview unit tests failed with " << failures << " failure(s).\n";
+        return 1;
+    }
+
+    std::cout << "PointCloudPreview unit tests passed.\n";
+    return 0;
+}
@@ -0,0 +1,58 @@
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+
+#include "Engine/ProcessMemory.hpp"
+
+namespace {
+int RunProcessMemoryTests() {
+    int failureCount = 0;
+
+    const engine::ProcessMemorySample before = engine::SampleProcessMemory();
+#if defined(_WIN32) || defined(__linux__)
+    if (before.residentBytes == 0) {
+        std::cerr << "Expected a resident size on this platform.\n";
+        ++failureCount;
+    }
+#endif
+
+    // Touched pages must show up in the resident size, and the block in the allocator's totals.
+    constexpr std::size_t kBlockBytes = 64u * 1024u * 1024u;
+    std::unique_ptr<std::uint8_t[]> block(new std::uint8_t[kBlockBytes]);
+    for (std::size_t offset = 0; offset < kBlockBytes; offset += 4096) {
+        block[offset] = static_cast<std::uint8_t>(offset);
+    }
+    const engine::ProcessMemorySample during = engine::SampleProcessMemory();
+    if (before.residentBytes != 0 && during.residentBytes < before.residentBytes + kBlockBytes / 2) {
+        std::cerr << "Expected touching a 64 MiB block to grow the resident size.\n";
+        ++failureCount;
+    }
+    if (during.heapStatisticsAvailable && during.heapInUseBytes < before.heapInUseBytes + kBlockBytes) {
+        std::cerr << "Expected the allocator to count a live 64 MiB block as in use.\n";
+        ++failureCount;
+    }
+
+    volatile std::uint8_t keep = block[kBlockBytes - 4096];
+    (void)keep;
+    block.reset();
+    const engine::ProcessMemorySample after = engine::SampleProcessMemory();
+    if (after.heapStatisticsAvailable && after.heapInUseBytes + kBlockBytes / 2 > during.heapInUseBytes) {
+        std::cerr << "Expected freeing the block to drop the allocator's in-use bytes.\n";
+        ++failureCount;
+    }
+
+    return failureCount;
+}
+}
+
+int main() {
+    const int failures = RunProcessMemoryTests();
+    if (failures > 0) {
+        std::cerr << "ProcessMemory unit tests failed with " << failures << " failure(s).\n";
+        return 1;
+    }
+
+    std::cout << "ProcessMemory unit tests passed.\n";
+    return 0;
+}
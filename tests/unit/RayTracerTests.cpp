@@ -0,0 +1,199 @@
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include <glm/geometric.hpp>
+
+#include "Engine/ModelBvh.hpp"
+#include "Engine/RayTracer.hpp"
+
+namespace {
+constexpr engine::ModelMaterial kPlainMaterial{-1, -1, -1, -1, -1, 1.0f, 0.0f, false, false, false};
+
+// Appends a quad from `corner` along `right` and `up`, with texture coordinates running 0..1 across it.
+void AddQuad(engine::ModelData& model, const glm::vec3& corner, const glm::vec3& right, const glm::vec3& up, std::uint32_t materialIndex) {
+    const std::uint32_t first = static_cast<std::uint32_t>(model.positions.size());
+    model.positions.insert(model.positions.end(), {corner, corner + right, corner + right + up, corner + up});
+    model.texCoords.insert(model.texCoords.end(), {glm::vec2(0.0f, 0.0f), glm::vec2(1.0f, 0.0f), glm::vec2(1.0f, 1.0f), glm::vec2(0.0f, 1.0f)});
+    const std::uint32_t indexStart = static_cast<std::uint32_t>(model.indices.size());
+    model.indices.insert(model.indices.end(), {first, first + 1, first + 2, first, first + 2, first + 3});
+    model.submeshes.push_back(engine::ModelSubmesh{indexStart, 6, materialIndex});
+}
+
+engine::ModelData BuildGridModel(int cellsPerSide) {
+    engine::ModelData model;
+    const float step = 2.0f / static_cast<float>(cellsPerSide);
+    for (int row = 0; row <= cellsPerSide; ++row) {
+        for (int column = 0; column <= cellsPerSide; ++column) {
+            const float x = -1.0f + static_cast<float>(column) * step;
+            const float y = -1.0f + static_cast<float>(row) * step;
+            model.positions.emplace_back(x, y, 0.25f * std::sin(x * 3.0f) * std::cos(y * 2.0f));
+        }
+    }
+
+    const std::uint32_t rowStride = static_cast<std::uint32_t>(cellsPerSide + 1);
+    for (std::uint32_t row = 0; row < static_cast<std::uint32_t>(cellsPerSide); ++row) {
+        for (std::uint32_t column = 0; column < static_cast<std::uint32_t>(cellsPerSide); ++column) {
+            const std::uint32_t topLeft = row * rowStride + column;
+            model.indices.insert(model.indices.end(), {topLeft, topLeft + 1, topLeft + rowStride, topLeft + 1, topLeft + rowStride + 1, topLeft + rowStride});
+        }
+    }
+    return model;
+}
+
+std::uint8_t PixelChannel(const engine::DecodedImage& image, std::uint32_t x, std::uint32_t y, std::uint32_t channel) {
+    return image.pixels[(static_cast<std::size_t>(y) * image.width + x) * 4 + channel];
+}
+
+int RunPacketTraversalTests() {
+    int failureCount = 0;
+
+    const engine::ModelData grid = BuildGridModel(24);
+    const engine::ModelBvh bvh = engine::ModelBvh::Build(grid.positions, grid.indices, grid.submeshes);
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> spread(-1.2f, 1.2f);
+    int mismatches = 0;
+    int hits = 0;
+    for (int packetIndex = 0; packetIndex < 64; ++packetIndex) {
+        engine::ModelRayPacket packet;
+        std::vector<engine::ModelRay> rays;
+        for (std::size_t lane = 0; lane < engine::kModelRayPacketWidth; ++lane) {
+            const glm::vec3 origin(spread(random), spread(random), 3.0f);
+            const glm::vec3 direction = glm::normalize(glm::vec3(spread(random), spread(random), -3.0f) * 0.3f + glm::vec3(0.0f, 0.0f, -0.7f));
+            rays.push_back({origin, direction});
+            packet.originX[lane] = origin.x;
+            packet.originY[lane] = origin.y;
+            packet.originZ[lane] = origin.z;
+            packet.directionX[lane] = direction.x;
+            packet.directionY[lane] = direction.y;
+            packet.directionZ[lane] = direction.z;
+            // Lane 3 is inactive and lane 5 stops short of the surface.
+            packet.maxDistance[lane] = lane == 3 ? 0.0f : (lane == 5 ? 1.0f : 100.0f);
+        }
+
+        engine::ModelRayPacketHit packetHit;
+        bvh.IntersectPacket(packet, packetHit);
+        const std::uint32_t occluded = bvh.OccludedPacket(packet);
+        for (std::size_t lane = 0; lane < engine::kModelRayPacketWidth; ++lane) {
+            const std::optional<engine::ModelRayHit> expected =
+                lane == 3 ? std::nullopt : bvh.Intersect(rays[lane], packet.maxDistance[lane]);
+            const bool packetHitLane = packetHit.triangleIndex[lane] != engine::ModelBvh::kNoTriangle;
+            const bool occludedLane = ((occluded >> lane) & 1u) != 0;
+            hits += expected ? 1 : 0;
+            if (expected.has_value() != packetHitLane || expected.has_value() != occludedLane ||
+                (expected && (expected->triangleIndex != packetHit.triangleIndex[lane] ||
+                              std::abs(expected->distance - packetHit.distance[lane]) > 1.0e-5f ||
+                              std::abs(expected->barycentricU - packetHit.barycentricU[lane]) > 1.0e-5f))) {
+                ++mismatches;
+            }
+        }
+    }
+    if (mismatches != 0 || hits < 200) {
+        std::cerr << "Expected packet queries to agree with single-ray Intersect, got " << mismatches << " mismatches over "
+                  << hits << " hits.\n";
+        ++failureCount;
+    }
+
+    // A filter that rejects every hit lets all rays through.
+    engine::ModelRayPacket straightDown;
+    for (std::size_t lane = 0; lane < engine::kModelRayPacketWidth; ++lane) {
+        straightDown.originX[lane] = -0.5f + 0.1f * static_cast<float>(lane);
+        straightDown.originY[lane] = 0.1f;
+        straightDown.originZ[lane] = 2.0f;
+        straightDown.directionX[lane] = 0.0f;
+        straightDown.directionY[lane] = 0.0f;
+        straightDown.directionZ[lane] = -1.0f;
+        straightDown.maxDistance[lane] = 10.0f;
+    }
+    const engine::ModelHitFilter rejectAll = [](const void*, std::uint32_t, std::uint32_t, float, float) { return false; };
+    engine::ModelRayPacketHit filteredHit;
+    bvh.IntersectPacket(straightDown, filteredHit, rejectAll);
+    if (bvh.OccludedPacket(straightDown) != 0xffu || bvh.OccludedPacket(straightDown, rejectAll) != 0 ||
+        filteredHit.triangleIndex[0] != engine::ModelBvh::kNoTriangle) {
+        std::cerr << "Expected a rejecting filter to let every ray through.\n";
+        ++failureCount;
+    }
+
+    return failureCount;
+}
+
+int RunRenderTests() {
+    int failureCount = 0;
+    const engine::ModelCamera camera{0.0f, 0.0f, 0.0f, 4.0f, glm::vec3(0.0f)};
+
+    // A floor facing the camera with a wall standing on it along x = 0, seen edge-on.
+    engine::ModelData crease;
+    crease.materials.push_back(kPlainMaterial);
+    AddQuad(crease, glm::vec3(-1.0f, -1.0f, 0.0f), glm::vec3(2.0f, 0.0f, 0.0f), glm::vec3(0.0f, 2.0f, 0.0f), 0);
+    AddQuad(crease, glm::vec3(0.0f, -1.0f, 0.0f), glm::vec3(0.0f, 2.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f), 0);
+    const engine::RayTracer creaseTracer(crease, {});
+    engine::RayTraceStatistics statistics{};
+    const engine::DecodedImage image = creaseTracer.Render(camera, engine::RayTraceSettings{64, 64, 4, 8, 0.2f}, statistics);
+    const std::uint8_t open = PixelChannel(image, 44, 32, 0);
+    const std::uint8_t nearWall = PixelChannel(image, 33, 32, 0);
+    if (image.width != 64 || image.pixels.size() != 64 * 64 * 4 || PixelChannel(image, 1, 1, 3) != 0 ||
+        PixelChannel(image, 44, 32, 3) != 255 || open < 250 || nearWall > open - 40) {
+        std::cerr << "Expected an open, head-on floor to be fully lit and darkened beside the wall, got " << int(open) << " and "
+                  << int(nearWall) << ".\n";
+        ++failureCount;
+    }
+    if (statistics.primaryRays != 64 * 64 * 4 || statistics.occlusionRays == 0 || statistics.occlusionRays % 8 != 0 ||
+        statistics.GetMegaraysPerSecond() <= 0.0) {
+        std::cerr << "Expected every primary ray and occlusion rays to be counted.\n";
+        ++failureCount;
+    }
+
+    {
+        engine::RayTraceStatistics again{};
+        const engine::DecodedImage repeat = creaseTracer.Render(camera, engine::RayTraceSettings{64, 64, 4, 8, 0.2f}, again);
+        if (repeat.pixels != image.pixels) {
+            std::cerr << "Expected renders to be reproducible.\n";
+            ++failureCount;
+        }
+    }
+
+    // A cutout quad in front of a plain one. Its texture is red on the left and clear on the right,
+    // and texture coordinates are flipped as for SDL, so the clear half lands on the left of the view.
+    engine::ModelData cutout;
+    cutout.materials.push_back(kPlainMaterial);
+    cutout.materials.push_back(engine::ModelMaterial{0, -1, -1, -1, -1, 1.0f, 0.5f, false, true, false});
+    AddQuad(cutout, glm::vec3(-1.0f, -1.0f, 0.0f), glm::vec3(2.0f, 0.0f, 0.0f), glm::vec3(0.0f, 2.0f, 0.0f), 0);
+    AddQuad(cutout, glm::vec3(-1.0f, -1.0f, 0.5f), glm::vec3(2.0f, 0.0f, 0.0f), glm::vec3(0.0f, 2.0f, 0.0f), 1);
+    cutout.texturePaths.push_back("checker");
+    const engine::DecodedImage texture{2, 1, {255, 0, 0, 255, 0, 255, 0, 0}};
+    const engine::RayTracer cutoutTracer(cutout, {texture});
+    const engine::DecodedImage cutoutImage = cutoutTracer.Render(camera, engine::RayTraceSettings{32, 32, 1, 0, 0.0f}, statistics);
+    if (PixelChannel(cutoutImage, 12, 16, 0) < 240 || PixelChannel(cutoutImage, 12, 16, 1) < 240 ||
+        PixelChannel(cutoutImage, 20, 16, 0) < 240 || PixelChannel(cutoutImage, 20, 16, 1) != 0 ||
+        PixelChannel(cutoutImage, 2, 16, 3) != 0 || statistics.occlusionRays != 0) {
+        std::cerr << "Expected the clear half of the cutout to show the white quad behind it.\n";
+        ++failureCount;
+    }
+
+    engine::ModelData missing = cutout;
+    missing.texturePaths[0] = "does/not/exist.png";
+    const std::vector<engine::DecodedImage> loaded = engine::LoadRayTracerTextures(missing);
+    const engine::RayTracer empty(engine::ModelData{}, {});
+    const engine::DecodedImage emptyImage = empty.Render(camera, engine::RayTraceSettings{8, 4, 1, 1, 0.2f}, statistics);
+    if (loaded.size() != 1 || loaded[0].width != 0 || emptyImage.pixels.size() != 8 * 4 * 4 || statistics.primaryRays != 0) {
+        std::cerr << "Expected missing textures and an empty model to be handled.\n";
+        ++failureCount;
+    }
+
+    return failureCount;
+}
+}
+
+int main() {
+    const int failures = RunPacketTraversalTests() + RunRenderTests();
+    if (failures > 0) {
+        std::cerr << "RayTracer unit tests failed with " << failures << " failure(s).\n";
+        return 1;
+    }
+
+    std::cout << "RayTracer unit tests passed.\n";
+    return 0;
+}
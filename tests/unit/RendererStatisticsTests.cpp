@@ -0,0 +1,82 @@
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "Engine/RendererStatistics.hpp"
+
+namespace {
+engine::RendererFrameStatistics MakeFrame(std::uint64_t drawCalls) {
+    engine::RendererFrameStatistics frame{};
+    frame.drawCalls = drawCalls;
+    frame.trianglesSubmitted = drawCalls * 10;
+    return frame;
+}
+
+int RunRendererStatisticsTests() {
+    int failureCount = 0;
+
+    engine::RendererStatisticsHistory history(4);
+    if (history.GetSize() != 0 || history.GetLatest().drawCalls != 0 ||
+        history.ComputeAverage(&engine::RendererFrameStatistics::drawCalls) != 0.0) {
+        std::cerr << "Expected an empty history to report zeroed statistics.\n";
+        ++failureCount;
+    }
+
+    for (std::uint64_t drawCalls = 1; drawCalls <= 6; ++drawCalls) {
+        history.Push(MakeFrame(drawCalls));
+    }
+
+    if (history.GetSize() != 4 || history.GetCapacity() != 4) {
+        std::cerr << "Expected the history to be capped at its capacity.\n";
+        ++failureCount;
+    }
+
+    if (history.GetLatest().drawCalls != 6) {
+        std::cerr << "Expected the latest frame to be the last pushed frame.\n";
+        ++failureCount;
+    }
+
+    if (std::fabs(history.ComputeAverage(&engine::RendererFrameStatistics::drawCalls) - 4.5) > 1.0e-9) {
+        std::cerr << "Expected the average to cover only the frames inside the rolling window.\n";
+        ++failureCount;
+    }
+
+    if (history.ComputeMaximum(&engine::RendererFrameStatistics::trianglesSubmitted) != 60) {
+        std::cerr << "Expected the maximum to track the largest counter in the window.\n";
+        ++failureCount;
+    }
+
+    std::vector<float> series;
+    history.CopySeries(&engine::RendererFrameStatistics::drawCalls, series);
+    const std::vector<float> expectedSeries = {3.0f, 4.0f, 5.0f, 6.0f};
+    if (series != expectedSeries) {
+        std::cerr << "Expected the series to be ordered oldest to newest.\n";
+        ++failureCount;
+    }
+
+    history.Clear();
+    history.CopySeries(&engine::RendererFrameStatistics::drawCalls, series);
+    if (history.GetSize() != 0 || !series.empty()) {
+        std::cerr << "Expected Clear to empty the rolling window.\n";
+        ++failureCount;
+    }
+
+    if (engine::GetRendererStatisticsFields().size() != sizeof(engine::RendererFrameStatistics) / sizeof(std::uint64_t)) {
+        std::cerr << "Expected every statistics counter to have a display field.\n";
+        ++failureCount;
+    }
+
+    return failureCount;
+}
+}
+
+int main() {
+    const int failures = RunRendererStatisticsTests();
+    if (failures > 0) {
+        std::cerr << "RendererStatistics unit tests failed with " << failures << " failure(s).\n";
+        return 1;
+    }
+
+    std::cout << "RendererStatistics unit tests passed.\n";
+    return 0;
+}
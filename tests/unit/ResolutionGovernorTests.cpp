@@ -0,0 +1,107 @@
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+#include "Engine/ResolutionGovernor.hpp"
+
+namespace {
+// Frame time of a renderer whose cost is `fixedSeconds` plus `fullScaleSeconds` at full resolution.
+double SimulatedFrameSeconds(float scale, double fixedSeconds, double fullScaleSeconds) {
+    return fixedSeconds + fullScaleSeconds * static_cast<double>(scale) * static_cast<double>(scale);
+}
+
+int RunResolutionGovernorTests() {
+    int failureCount = 0;
+    const engine::ResolutionGovernorSettings settings = engine::GetDefaultResolutionGovernorSettings();
+    const double target = settings.targetFrameSeconds;
+
+    engine::ResolutionGovernor fast(settings);
+    for (int frame = 0; frame < 300; ++frame) {
+        fast.Update(target * 0.5);
+    }
+    if (fast.GetScale() != settings.maxScale) {
+        std::cerr << "Expected a renderer under budget to stay at full resolution.\n";
+        ++failureCount;
+    }
+
+    engine::ResolutionGovernor slow(settings);
+    for (std::uint32_t frame = 0; frame + 1 < settings.framesBeforeDrop; ++frame) {
+        slow.Update(target * 2.0);
+    }
+    const float beforeDrop = slow.GetScale();
+    slow.Update(target * 2.0);
+    if (beforeDrop != settings.maxScale || slow.GetScale() >= settings.maxScale) {
+        std::cerr << "Expected the scale to drop only after the configured run of slow frames.\n";
+        ++failureCount;
+    }
+
+    // A renderer twice over budget at full size should settle below full scale and then hold it.
+    engine::ResolutionGovernor governor(settings);
+    float scale = governor.GetScale();
+    int changesAfterSettling = 0;
+    for (int frame = 0; frame < 900; ++frame) {
+        const float nextScale = governor.Update(SimulatedFrameSeconds(scale, target * 0.2, target * 1.8));
+        if (frame >= 600 && nextScale != scale) {
+            ++changesAfterSettling;
+        }
+        scale = nextScale;
+    }
+    const double settledFrame = SimulatedFrameSeconds(scale, target * 0.2, target * 1.8);
+    if (scale >= settings.maxScale || scale < settings.minScale || settledFrame > target * settings.dropThreshold ||
+        changesAfterSettling != 0) {
+        std::cerr << "Expected the governor to settle within budget without oscillating (scale " << scale << ").\n";
+        ++failureCount;
+    }
+
+    const float quanta = scale / settings.scaleQuantum;
+    if (std::fabs(quanta - std::round(quanta)) > 1e-3f) {
+        std::cerr << "Expected scales to be multiples of the quantum.\n";
+        ++failureCount;
+    }
+
+    // Once the load goes away the scale climbs back, but more slowly than it fell.
+    const float loadedScale = scale;
+    int framesUntilRaise = 0;
+    while (framesUntilRaise < 2000 && governor.GetScale() == loadedScale) {
+        governor.Update(SimulatedFrameSeconds(governor.GetScale(), target * 0.1, target * 0.3));
+        ++framesUntilRaise;
+    }
+    for (int frame = 0; frame < 2000; ++frame) {
+        governor.Update(SimulatedFrameSeconds(governor.GetScale(), target * 0.1, target * 0.3));
+    }
+    if (framesUntilRaise < static_cast<int>(settings.framesBeforeRaise) || governor.GetScale() != settings.maxScale) {
+        std::cerr << "Expected the scale to recover to full resolution after the raise hysteresis.\n";
+        ++failureCount;
+    }
+
+    engine::ResolutionGovernor bounded(settings);
+    for (int frame = 0; frame < 500; ++frame) {
+        bounded.Update(target * 50.0);
+    }
+    bounded.Update(std::numeric_limits<double>::quiet_NaN());
+    bounded.Update(-1.0);
+    if (bounded.GetScale() != settings.minScale) {
+        std::cerr << "Expected the scale to stop at the minimum and ignore invalid frame times.\n";
+        ++failureCount;
+    }
+
+    bounded.Reset();
+    if (bounded.GetScale() != settings.maxScale || bounded.GetSmoothedFrameSeconds() != 0.0) {
+        std::cerr << "Expected Reset to return to full resolution.\n";
+        ++failureCount;
+    }
+
+    return failureCount;
+}
+}
+
+int main() {
+    const int failures = RunResolutionGovernorTests();
+    if (failures > 0) {
+        std::cerr << "ResolutionGovernor unit tests failed with " << failures << " failure(s).\n";
+        return 1;
+    }
+
+    std::cout << "ResolutionGovernor unit tests passed.\n";
+    return 0;
+}
@@ -0,0 +1,178 @@
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Engine/Task.hpp"
+
+namespace {
+engine::Task<int> Answer() {
+    co_return 42;
+}
+
+engine::Task<std::thread::id> ThreadAfterHop(engine::JobSystem& jobs) {
+    co_await engine::ResumeOnWorker{jobs};
+    co_return std::this_thread::get_id();
+}
+
+struct HopResult {
+    std::thread::id workerThread;
+    std::thread::id finalThread;
+};
+
+engine::Task<HopResult> WorkerThenMain(engine::JobSystem& jobs) {
+    HopResult result{};
+    result.workerThread = co_await ThreadAfterHop(jobs);
+    co_await engine::ResumeOnMainThread{jobs};
+    result.finalThread = std::this_thread::get_id();
+    co_return result;
+}
+
+engine::Task<std::vector<int>> SquareAll(engine::JobSystem& jobs, int count) {
+    std::vector<engine::Task<int>> squares;
+    for (int value = 0; value < count; ++value) {
+        squares.push_back(engine::RunOnWorker(jobs, [value]() {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            return value * value;
+        }));
+    }
+    co_return co_await engine::WhenAll(jobs, std::move(squares));
+}
+
+// A staged load: read, decode on the workers, then publish on the main thread. Stops between
+// stages once cancellation is requested.
+struct StagedLoad {
+    bool completed;
+    std::size_t byteCount;
+    int stagesRun;
+};
+
+engine::Task<StagedLoad> LoadInStages(
+    engine::JobSystem& jobs,
+    std::filesystem::path path,
+    std::stop_token stopToken,
+    std::stop_source* cancelAfterRead) {
+    StagedLoad load{false, 0, 0};
+    const engine::FileReadResult file = co_await engine::ReadFileAsync(jobs, path);
+    ++load.stagesRun;
+    if (cancelAfterRead) {
+        cancelAfterRead->request_stop();
+    }
+    if (!file.succeeded || stopToken.stop_requested()) {
+        co_return load;
+    }
+
+    std::vector<engine::Task<std::size_t>> decodes;
+    for (std::size_t half = 0; half < 2; ++half) {
+        decodes.push_back(engine::RunOnWorker(jobs, [&file, half]() { return file.bytes.size() / 2 + half * (file.bytes.size() % 2); }));
+    }
+    const std::vector<std::size_t> halves = co_await engine::WhenAll(jobs, std::move(decodes));
+    ++load.stagesRun;
+    if (stopToken.stop_requested()) {
+        co_return load;
+    }
+
+    co_await engine::ResumeOnMainThread{jobs};
+    ++load.stagesRun;
+    load.byteCount = halves[0] + halves[1];
+    load.completed = true;
+    co_return load;
+}
+
+int RunTaskTests() {
+    int failureCount = 0;
+    engine::JobSystem jobs(3);
+
+    if (engine::SyncWait(jobs, Answer()) != 42) {
+        std::cerr << "Expected a task that never suspends to produce its value.\n";
+        ++failureCount;
+    }
+
+    const HopResult hop = engine::SyncWait(jobs, WorkerThenMain(jobs));
+    if (hop.workerThread == std::this_thread::get_id() || hop.finalThread != std::this_thread::get_id()) {
+        std::cerr << "Expected the task to hop to a worker and then back to the main thread.\n";
+        ++failureCount;
+    }
+
+    const std::vector<int> squares = engine::SyncWait(jobs, SquareAll(jobs, 32));
+    bool squaresInOrder = squares.size() == 32;
+    for (std::size_t index = 0; squaresInOrder && index < squares.size(); ++index) {
+        squaresInOrder = squares[index] == static_cast<int>(index * index);
+    }
+    if (!squaresInOrder) {
+        std::cerr << "Expected WhenAll to gather every result in order.\n";
+        ++failureCount;
+    }
+
+    std::atomic<int> voidRuns{0};
+    std::vector<engine::Task<void>> voidTasks;
+    for (int index = 0; index < 8; ++index) {
+        voidTasks.push_back(engine::RunOnWorker(jobs, [&voidRuns]() { voidRuns.fetch_add(1); }));
+    }
+    engine::SyncWait(jobs, engine::WhenAll(jobs, std::move(voidTasks)));
+    engine::SyncWait(jobs, engine::WhenAll(jobs, std::vector<engine::Task<void>>{}));
+    if (voidRuns.load() != 8) {
+        std::cerr << "Expected WhenAll over void tasks, including none, to finish.\n";
+        ++failureCount;
+    }
+
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "EngineTaskTests";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    const std::filesystem::path filePath = directory / "payload.bin";
+    {
+        std::ofstream output(filePath, std::ios::binary);
+        output << std::string(1001, 'x');
+    }
+
+    const engine::FileReadResult file = engine::SyncWait(jobs, engine::ReadFileAsync(jobs, filePath));
+    const engine::FileReadResult missing = engine::SyncWait(jobs, engine::ReadFileAsync(jobs, directory / "missing.bin"));
+    if (!file.succeeded || file.bytes.size() != 1001 || file.bytes[500] != std::byte{'x'} || missing.succeeded ||
+        missing.error.empty()) {
+        std::cerr << "Expected ReadFileAsync to read existing files and report missing ones.\n";
+        ++failureCount;
+    }
+
+    std::stop_source uncancelled;
+    const StagedLoad full = engine::SyncWait(jobs, LoadInStages(jobs, filePath, uncancelled.get_token(), nullptr));
+    if (!full.completed || full.byteCount != 1001 || full.stagesRun != 3) {
+        std::cerr << "Expected the staged load to run every stage.\n";
+        ++failureCount;
+    }
+
+    std::stop_source cancelled;
+    const StagedLoad stopped = engine::SyncWait(jobs, LoadInStages(jobs, filePath, cancelled.get_token(), &cancelled));
+    if (stopped.completed || stopped.stagesRun != 1) {
+        std::cerr << "Expected cancellation to stop the load at the next stage boundary.\n";
+        ++failureCount;
+    }
+
+    std::atomic<bool> detachedFinished{false};
+    engine::StartDetached(engine::RunOnWorker(jobs, [&detachedFinished]() { detachedFinished.store(true); }));
+    jobs.WaitUntil([&detachedFinished]() { return detachedFinished.load(); });
+
+    // Tasks that never started are simply freed.
+    engine::Task<int> neverStarted = Answer();
+    neverStarted = Answer();
+
+    std::filesystem::remove_all(directory);
+    return failureCount;
+}
+}
+
+int main() {
+    const int failures = RunTaskTests();
+    if (failures > 0) {
+        std::cerr << "Task unit tests failed with " << failures << " failure(s).\n";
+        return 1;
+    }
+
+    std::cout << "Task unit tests passed.\n";
+    return 0;
+}
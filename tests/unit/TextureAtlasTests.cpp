@@ -0,0 +1,220 @@
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "Engine/TextureAtlas.hpp"
+
+namespace {
+struct TestImage {
+    std::uint32_t width = 0;
+    std::uint32_t height = 0;
+    std::vector<std::uint8_t> rgb;
+};
+
+TestImage MakePatternImage(std::uint32_t width, std::uint32_t height, std::uint8_t seed) {
+    TestImage image{width, height, std::vector<std::uint8_t>(static_cast<std::size_t>(width) * height * 3)};
+    for (std::uint32_t y = 0; y < height; ++y) {
+        for (std::uint32_t x = 0; x < width; ++x) {
+            const std::size_t offset = (static_cast<std::size_t>(y) * width + x) * 3;
+            image.rgb[offset] = static_cast<std::uint8_t>(seed + x * 16);
+            image.rgb[offset + 1] = static_cast<std::uint8_t>(seed + y * 16);
+            image.rgb[offset + 2] = seed;
+        }
+    }
+    return image;
+}
+
+void WriteLittleEndian(std::ofstream& output, std::uint32_t value, int byteCount) {
+    for (int byteIndex = 0; byteIndex < byteCount; ++byteIndex) {
+        output.put(static_cast<char>((value >> (8 * byteIndex)) & 0xFFu));
+    }
+}
+
+// Classic bottom-up 24-bit BMP, the most widely supported variant.
+void WriteBmp24(const std::filesystem::path& path, const TestImage& image) {
+    const std::uint32_t rowBytes = (image.width * 3 + 3) & ~3u;
+    std::ofstream output(path, std::ios::binary | std::ios::trunc);
+    output.put('B');
+    output.put('M');
+    WriteLittleEndian(output, 54 + rowBytes * image.height, 4);
+    WriteLittleEndian(output, 0, 4);
+    WriteLittleEndian(output, 54, 4);
+    WriteLittleEndian(output, 40, 4);
+    WriteLittleEndian(output, image.width, 4);
+    WriteLittleEndian(output, image.height, 4);
+    WriteLittleEndian(output, 1, 2);
+    WriteLittleEndian(output, 24, 2);
+    for (int field = 0; field < 6; ++field) {
+        WriteLittleEndian(output, 0, 4);
+    }
+
+    for (std::uint32_t row = image.height; row-- > 0;) {
+        for (std::uint32_t x = 0; x < image.width; ++x) {
+            const std::size_t offset = (static_cast<std::size_t>(row) * image.width + x) * 3;
+            output.put(static_cast<char>(image.rgb[offset + 2]));
+            output.put(static_cast<char>(image.rgb[offset + 1]));
+            output.put(static_cast<char>(image.rgb[offset]));
+        }
+        for (std::uint32_t padding = image.width * 3; padding < rowBytes; ++padding) {
+            output.put('\0');
+        }
+    }
+}
+
+// Reads the 32-bit BMPs produced by the atlas cook step (BGRA, either row order).
+bool ReadBmp32(const std::filesystem::path& path, TestImage& outImage) {
+    std::ifstream input(path, std::ios::binary);
+    std::vector<std::uint8_t> bytes((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    if (bytes.size() < 54 || bytes[0] != 'B' || bytes[1] != 'M') {
+        return false;
+    }
+
+    auto read = [&](std::size_t offset, int byteCount) {
+        std::uint32_t value = 0;
+        for (int byteIndex = 0; byteIndex < byteCount; ++byteIndex) {
+            value |= static_cast<std::uint32_t>(bytes[offset + byteIndex]) << (8 * byteIndex);
+        }
+        return value;
+    };
+
+    const std::uint32_t pixelOffset = read(10, 4);
+    const std::int32_t signedHeight = static_cast<std::int32_t>(read(22, 4));
+    outImage.width = read(18, 4);
+    outImage.height = static_cast<std::uint32_t>(signedHeight < 0 ? -signedHeight : signedHeight);
+    if (read(28, 2) != 32 || bytes.size() < pixelOffset + static_cast<std::size_t>(outImage.width) * outImage.height * 4) {
+        return false;
+    }
+
+    outImage.rgb.resize(static_cast<std::size_t>(outImage.width) * outImage.height * 3);
+    for (std::uint32_t y = 0; y < outImage.height; ++y) {
+        const std::uint32_t fileRow = signedHeight < 0 ? y : outImage.height - 1 - y;
+        for (std::uint32_t x = 0; x < outImage.width; ++x) {
+            const std::size_t source = pixelOffset + (static_cast<std::size_t>(fileRow) * outImage.width + x) * 4;
+            const std::size_t destination = (static_cast<std::size_t>(y) * outImage.width + x) * 3;
+            outImage.rgb[destination] = bytes[source + 2];
+            outImage.rgb[destination + 1] = bytes[source + 1];
+            outImage.rgb[destination + 2] = bytes[source];
+        }
+    }
+    return true;
+}
+
+// Samples the way the renderers do: texel at (1 - u, 1 - v), nearest.
+std::uint32_t Sample(const TestImage& image, const glm::vec2& uv) {
+    const auto x = static_cast<std::uint32_t>((1.0f - uv.x) * static_cast<float>(image.width));
+    const auto y = static_cast<std::uint32_t>((1.0f - uv.y) * static_cast<float>(image.height));
+    const std::size_t offset = (static_cast<std::size_t>(std::min(y, image.height - 1)) * image.width + std::min(x, image.width - 1)) * 3;
+    return (static_cast<std::uint32_t>(image.rgb[offset]) << 16) | (static_cast<std::uint32_t>(image.rgb[offset + 1]) << 8) | image.rgb[offset + 2];
+}
+
+glm::vec2 TexelCenterUv(std::uint32_t x, std::uint32_t y, const TestImage& image) {
+    return {
+        1.0f - (static_cast<float>(x) + 0.5f) / static_cast<float>(image.width),
+        1.0f - (static_cast<float>(y) + 0.5f) / static_cast<float>(image.height)};
+}
+
+int RunTextureAtlasTests() {
+    int failureCount = 0;
+
+    const std::filesystem::path workDirectory = std::filesystem::temp_directory_path() / "EngineTextureAtlasTests";
+    std::filesystem::remove_all(workDirectory);
+    std::filesystem::create_directories(workDirectory);
+
+    const TestImage imageA = MakePatternImage(8, 8, 10);
+    const TestImage imageB = MakePatternImage(16, 4, 90);
+    const TestImage imageC = MakePatternImage(4, 4, 200);
+    WriteBmp24(workDirectory / "a.bmp", imageA);
+    WriteBmp24(workDirectory / "b.bmp", imageB);
+    WriteBmp24(workDirectory / "c.bmp", imageC);
+
+    engine::ModelData model;
+    model.sourcePath = (workDirectory / "Atlas.fbx").string();
+    model.texturePaths = {(workDirectory / "a.bmp").string(), (workDirectory / "b.bmp").string(), (workDirectory / "c.bmp").string()};
+    model.primaryTexturePath = model.texturePaths[0];
+    model.materials.push_back(engine::ModelMaterial{0, -1, -1, -1, -1, 1.0f, 0.0f, false, false, false});
+    model.materials.push_back(engine::ModelMaterial{1, -1, -1, -1, -1, 1.0f, 0.0f, false, false, false});
+    model.materials.push_back(engine::ModelMaterial{2, -1, -1, -1, -1, 1.0f, 0.0f, false, false, false});
+
+    // Material 0 samples three texels of A, material 1 three texels of B, material 2 tiles C and shares vertex 0.
+    const std::vector<glm::vec2> sourceUvs = {
+        TexelCenterUv(0, 0, imageA), TexelCenterUv(7, 0, imageA), TexelCenterUv(3, 7, imageA),
+        TexelCenterUv(15, 3, imageB), TexelCenterUv(0, 3, imageB), TexelCenterUv(9, 1, imageB),
+        glm::vec2(2.5f, 0.5f), glm::vec2(0.25f, 3.0f)};
+    for (const glm::vec2& uv : sourceUvs) {
+        model.positions.emplace_back(uv.x, uv.y, 0.0f);
+        model.texCoords.push_back(uv);
+    }
+    model.indices = {0, 1, 2, 3, 4, 5, 0, 6, 7};
+    model.submeshes = {{0, 3, 0}, {3, 3, 1}, {6, 3, 2}};
+
+    engine::TextureAtlasStats stats{};
+    std::string error;
+    if (!engine::BuildTextureAtlases(model, {workDirectory / "atlases", 256, 4}, stats, error)) {
+        std::cerr << "Expected atlas packing to succeed: " << error << "\n";
+        return failureCount + 1;
+    }
+
+    if (stats.atlasCount != 1 || stats.packedTextureCount != 2 || stats.packedMaterialCount != 2 || stats.wrappingMaterialCount != 1) {
+        std::cerr << "Expected two non-tiling textures in one atlas and one wrapping fallback.\n";
+        ++failureCount;
+    }
+
+    const std::int32_t atlasIndex = model.materials[0].textureIndex;
+    if (atlasIndex < 0 || model.materials[1].textureIndex != atlasIndex || model.texturePaths.size() != 2) {
+        std::cerr << "Expected packed materials to share one atlas and unused sources to be dropped.\n";
+        return failureCount + 1;
+    }
+
+    const std::int32_t wrappingIndex = model.materials[2].textureIndex;
+    if (wrappingIndex < 0 || model.texturePaths[static_cast<std::size_t>(wrappingIndex)] != (workDirectory / "c.bmp").string()) {
+        std::cerr << "Expected the wrapping material to keep its original texture.\n";
+        ++failureCount;
+    }
+
+    TestImage atlas;
+    if (!ReadBmp32(model.texturePaths[static_cast<std::size_t>(atlasIndex)], atlas)) {
+        std::cerr << "Expected the atlas to be written as a 32-bit BMP.\n";
+        return failureCount + 1;
+    }
+
+    for (std::size_t index = 0; index < 6; ++index) {
+        const TestImage& source = index < 3 ? imageA : imageB;
+        const glm::vec2& remapped = model.texCoords[model.indices[index]];
+        if (remapped.x < 0.0f || remapped.x > 1.0f || remapped.y < 0.0f || remapped.y > 1.0f ||
+            Sample(atlas, remapped) != Sample(source, sourceUvs[index])) {
+            std::cerr << "Expected remapped UV " << index << " to sample the same texel from the atlas.\n";
+            ++failureCount;
+        }
+    }
+
+    if (model.indices[0] == 0 || model.indices[6] != 0 || model.texCoords[0] != sourceUvs[0] || model.positions.size() != 9) {
+        std::cerr << "Expected the vertex shared with the wrapping material to be duplicated with its original UV.\n";
+        ++failureCount;
+    }
+
+    engine::ModelData untouched = model;
+    if (engine::BuildTextureAtlases(untouched, {std::filesystem::path(), 256, 4}, stats, error)) {
+        std::cerr << "Expected atlas packing without an output directory to fail.\n";
+        ++failureCount;
+    }
+
+    std::filesystem::remove_all(workDirectory);
+    return failureCount;
+}
+}
+
+int main() {
+    const int failures = RunTextureAtlasTests();
+    if (failures > 0) {
+        std::cerr << "TextureAtlas unit tests failed with " << failures << " failure(s).\n";
+        return 1;
+    }
+
+    std::cout << "TextureAtlas unit tests passed.\n";
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Engine/TexturePathResolver.hpp"
+
+namespace {
+void TouchFile(const std::filesystem::path& path) {
+    std::filesystem::create_directories(path.parent_path());
+    std::ofstream output(path, std::ios::binary);
+    output << "texture";
+}
+
+bool SameFile(const std::filesystem::path& resolved, const std::filesystem::path& expected) {
+    std::error_code error;
+    return !resolved.empty() && std::filesystem::equivalent(resolved, expected, error) &&
+        resolved.filename() == expected.filename();
+}
+
+int RunTexturePathResolverTests() {
+    int failureCount = 0;
+    const std::filesystem::path root = std::filesystem::temp_directory_path() / "EngineTexturePathResolverTests";
+    std::filesystem::remove_all(root);
+
+    const std::filesystem::path modelDirectory = root / "Models" / "Wolf" / "Fbx";
+    const std::filesystem::path localTexture = modelDirectory / "Local.png";
+    const std::filesystem::path deepTexture = modelDirectory / "Sub" / "Dir" / "Deep.PNG";
+    const std::filesystem::path siblingTexture = root / "Models" / "Wolf" / "textures" / "Wolf_Body.png";
+    const std::filesystem::path sharedTexture = root / "Shared" / "Maps" / "shared.png";
+    TouchFile(localTexture);
+    TouchFile(deepTexture);
+    TouchFile(siblingTexture);
+    TouchFile(sharedTexture);
+
+    const engine::TextureSearchOptions options{{root / "Shared"}, {"textures", "maps"}};
+    engine::TexturePathResolver resolver(modelDirectory, options);
+
+    if (!SameFile(resolver.Resolve("Local.png"), localTexture) || !SameFile(resolver.Resolve("./local.PNG"), localTexture)) {
+        std::cerr << "Expected relative references to resolve in any letter case.\n";
+        ++failureCount;
+    }
+
+    if (!SameFile(resolver.Resolve("sub\\dir\\deep.png"), deepTexture)) {
+        std::cerr << "Expected Windows separators and wrong-case folders to resolve.\n";
+        ++failureCount;
+    }
+
+    if (!SameFile(resolver.Resolve(siblingTexture.string()), siblingTexture)) {
+        std::cerr << "Expected an existing absolute path to resolve as written.\n";
+        ++failureCount;
+    }
+
+    const engine::TexturePathResolverStatistics beforeFallback = resolver.GetStatistics();
+    if (beforeFallback.resolvedAsWritten != 4 || beforeFallback.resolvedByFileName != 0) {
+        std::cerr << "Expected every reference so far to resolve as written.\n";
+        ++failureCount;
+    }
+
+    if (!SameFile(resolver.Resolve("C:\\Users\\artist\\Wolf\\Textures\\wolf_body.png"), siblingTexture) ||
+        !SameFile(resolver.Resolve("../../elsewhere/SHARED.png"), sharedTexture)) {
+        std::cerr << "Expected unusable paths to fall back to the sibling and extra texture folders by file name.\n";
+        ++failureCount;
+    }
+
+    if (!resolver.Resolve("missing.png").empty() || !resolver.Resolve("").empty() || !resolver.Resolve("folder/").empty()) {
+        std::cerr << "Expected references to missing files to stay unresolved.\n";
+        ++failureCount;
+    }
+
+    // Repeated lookups are answered from the directory indexes without listing anything again.
+    const std::size_t listedBefore = resolver.GetStatistics().directoriesListed;
+    for (int repeat = 0; repeat < 200; ++repeat) {
+        (void)resolver.Resolve("Local.png");
+        (void)resolver.Resolve("Sub/Dir/Deep.png");
+        (void)resolver.Resolve("wolf_body.png");
+        (void)resolver.Resolve("missing.png");
+    }
+    const engine::TexturePathResolverStatistics statistics = resolver.GetStatistics();
+    if (statistics.directoriesListed != listedBefore || statistics.lookups != 809 || statistics.unresolved != 203) {
+        std::cerr << "Expected repeated lookups to reuse the directory listings (listed " << statistics.directoriesListed << ").\n";
+        ++failureCount;
+    }
+
+    const std::vector<engine::TextureSearchDirectory> listed = resolver.GetListedDirectories();
+    bool modelDirectoryListed = false;
+    for (const engine::TextureSearchDirectory& directory : listed) {
+        modelDirectoryListed = modelDirectoryListed ||
+            (directory.lastWriteTicks != 0 && std::filesystem::equivalent(directory.path, modelDirectory));
+    }
+    if (listed.size() != statistics.directoriesListed || !modelDirectoryListed) {
+        std::cerr << "Expected every listed directory to be reported with its modification time.\n";
+        ++failureCount;
+    }
+
+    const engine::TextureSearchOptions otherRoots{{root / "Other"}, {"textures", "maps"}};
+    if (engine::HashTextureSearchOptions(options) != engine::HashTextureSearchOptions(engine::TextureSearchOptions(options)) ||
+        engine::HashTextureSearchOptions(options) == engine::HashTextureSearchOptions(otherRoots)) {
+        std::cerr << "Expected the search options hash to follow the search roots.\n";
+        ++failureCount;
+    }
+
+    const std::vector<std::filesystem::path> split = engine::SplitSearchPathList(
+#if defined(_WIN32)
+        "C:\\a;;D:\\b;"
+#else
+        "/a::/b:"
+#endif
+    );
+    if (split.size() != 2) {
+        std::cerr << "Expected search path lists to split on the platform separator and skip empty entries.\n";
+        ++failureCount;
+    }
+
+    std::filesystem::remove_all(root);
+    return failureCount;
+}
+}
+
+int main() {
+    const int failures = RunTexturePathResolverTests();
+    if (failures > 0) {
+        std::cerr << "TexturePathResolver unit tests failed with " << failures << " failure(s).\n";
+        return 1;
+    }
+
+    std::cout << "TexturePathResolver unit tests passed.\n";
+    return 0;
+}
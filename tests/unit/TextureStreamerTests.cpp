@@ -0,0 +1,233 @@
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Engine/TextureStreamer.hpp"
+
+namespace {
+std::atomic<int> decodeCalls{0};
+
+// Files hold the image size as text, as in "256x128"; anything else fails to decode.
+bool DecodeFakeTexture(const std::vector<std::byte>& bytes, const std::string& path, engine::DecodedImage& outImage, std::string& outError) {
+    ++decodeCalls;
+    const std::string text(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    unsigned width = 0;
+    unsigned height = 0;
+    if (std::sscanf(text.c_str(), "%ux%u", &width, &height) != 2 || width == 0 || height == 0) {
+        outError = "Not a texture: " + path;
+        return false;
+    }
+
+    outImage = engine::DecodedImage{width, height, std::vector<std::uint8_t>(static_cast<std::size_t>(width) * height * 4, 200)};
+    return true;
+}
+
+// Runs one frame: `requests` are (slot, texels) pairs seen this frame, then decodes are finished
+// so the next frame sees their results.
+std::vector<engine::TextureStreamUpdate> RunFrame(
+    engine::TextureStreamer& streamer,
+    const std::vector<std::pair<std::size_t, float>>& requests) {
+    for (const auto& [slot, texels] : requests) {
+        streamer.RequestTexels(slot, texels);
+    }
+
+    std::vector<engine::TextureStreamUpdate> updates;
+    streamer.Update(updates);
+    streamer.WaitForDecodes();
+    return updates;
+}
+
+std::string WriteFakeTexture(const std::filesystem::path& directory, const std::string& name, const std::string& size) {
+    const std::filesystem::path path = directory / name;
+    std::ofstream(path, std::ios::binary) << size;
+    return path.string();
+}
+
+const engine::TextureStreamUpdate* FindUpdate(const std::vector<engine::TextureStreamUpdate>& updates, std::size_t slot) {
+    for (const engine::TextureStreamUpdate& update : updates) {
+        if (update.slot == slot) {
+            return &update;
+        }
+    }
+    return nullptr;
+}
+
+int RunTextureStreamerTests() {
+    int failureCount = 0;
+
+    if (engine::ComputeMipLevelCount(4096, 1024) != 13 || engine::ComputeMipLevelCount(1, 1) != 1 ||
+        engine::ComputeMipLevelCount(5, 3) != 3) {
+        std::cerr << "Expected mip chains to run down to 1x1.\n";
+        ++failureCount;
+    }
+
+    const engine::DecodedImage strip{4, 2, {0, 0, 0, 0, 100, 100, 100, 100, 10, 20, 30, 40, 30, 40, 50, 60,
+                                            0, 0, 0, 0, 100, 100, 100, 100, 10, 20, 30, 40, 30, 40, 50, 60}};
+    const engine::DecodedImage half = engine::DownsampleImage(strip);
+    const std::vector<std::uint8_t> expectedHalf = {50, 50, 50, 50, 20, 30, 40, 50};
+    std::vector<std::uint8_t> oddPixels(3 * 3 * 4, 0);
+    oddPixels[8 * 4] = 90;
+    const engine::DecodedImage odd = engine::DownsampleImage(engine::DecodedImage{3, 3, oddPixels});
+    if (half.width != 2 || half.height != 1 || half.pixels != expectedHalf || odd.width != 1 || odd.height != 1 ||
+        odd.pixels[0] != 10) {
+        std::cerr << "Expected a 2x2 box filter that folds odd edges into the last texel.\n";
+        ++failureCount;
+    }
+
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "EngineTextureStreamerTests";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    const std::string large256 = WriteFakeTexture(directory, "large.tex", "256x256");
+    const std::string small64 = WriteFakeTexture(directory, "small.tex", "64x32");
+    const std::string broken = WriteFakeTexture(directory, "broken.tex", "not an image");
+    const std::string missing = (directory / "missing.tex").string();
+    const std::string disabled32 = WriteFakeTexture(directory, "disabled.tex", "32x32");
+    const std::string medium128 = WriteFakeTexture(directory, "medium.tex", "128x128");
+    const std::string budgetA = WriteFakeTexture(directory, "budget-a.tex", "256x256");
+    const std::string budgetB = WriteFakeTexture(directory, "budget-b.tex", "256x256");
+
+    const engine::TextureStreamingSettings settings{64u * 1024u * 1024u, 16, 4};
+    engine::TextureStreamer streamer(settings, &DecodeFakeTexture);
+    std::vector<std::size_t> previousSlots;
+    streamer.SetTextures({large256, small64, broken, disabled32, missing}, {true, true, true, false, true}, previousSlots);
+    if (previousSlots != std::vector<std::size_t>(5, static_cast<std::size_t>(-1))) {
+        std::cerr << "Expected a first texture list to carry nothing over.\n";
+        ++failureCount;
+    }
+
+    // Nothing is visible yet, so every texture decodes straight to its placeholder level.
+    RunFrame(streamer, {});
+    std::vector<engine::TextureStreamUpdate> updates = RunFrame(streamer, {});
+    const engine::TextureStreamUpdate* large = FindUpdate(updates, 0);
+    const engine::TextureStreamUpdate* small = FindUpdate(updates, 1);
+    const engine::TextureStreamUpdate* failed = FindUpdate(updates, 2);
+    if (!large || large->level != 4 || large->image.width != 16 || large->image.height != 16 ||
+        !small || small->level != 2 || small->image.width != 16 || small->image.height != 8) {
+        std::cerr << "Expected unseen textures to arrive at their placeholder level.\n";
+        ++failureCount;
+    }
+    if (!failed || failed->level != engine::TextureStreamer::kNoLevel || !streamer.HasFailed(2) || FindUpdate(updates, 3) ||
+        streamer.GetResidentLevel(3) != engine::TextureStreamer::kNoLevel) {
+        std::cerr << "Expected failed decodes to be reported and disabled slots to stay empty.\n";
+        ++failureCount;
+    }
+    if (!FindUpdate(updates, 4) || !streamer.HasFailed(4)) {
+        std::cerr << "Expected a texture file that cannot be read to be reported as failed.\n";
+        ++failureCount;
+    }
+
+    engine::TextureStreamerStatistics statistics = streamer.GetStatistics();
+    if (statistics.textureCount != 4 || statistics.placeholderCount != 4 || statistics.failedDecodeCount != 2 ||
+        statistics.residentBytes != (16 * 16 + 16 * 8) * 4 * 2 || statistics.fileBytes != 7 + 5) {
+        std::cerr << "Expected placeholders (and their kept copies) to be the only resident bytes.\n";
+        ++failureCount;
+    }
+
+    // Sampled at 200 texels per unit, the 256-texel texture needs its full level. It decodes
+    // again from the file kept in memory, so removing the file does not matter.
+    std::filesystem::remove(large256);
+    const int callsBeforeUpgrade = decodeCalls.load();
+    RunFrame(streamer, {{0, 200.0f}});
+    updates = RunFrame(streamer, {{0, 200.0f}});
+    large = FindUpdate(updates, 0);
+    if (!large || large->level != 0 || large->image.width != 256 || large->image.pixels.size() != 256 * 256 * 4 ||
+        streamer.GetResidentLevel(0) != 0 || decodeCalls.load() != callsBeforeUpgrade + 1) {
+        std::cerr << "Expected a visible texture to stream in the level matching its projected size.\n";
+        ++failureCount;
+    }
+
+    updates = RunFrame(streamer, {{1, 20.0f}});
+    if (!updates.empty() || streamer.GetResidentLevel(1) != 2) {
+        std::cerr << "Expected decoded levels to land only in the next Update.\n";
+        ++failureCount;
+    }
+    updates = RunFrame(streamer, {{1, 20.0f}});
+    small = FindUpdate(updates, 1);
+    if (!small || small->level != 1 || small->image.width != 32 || small->image.height != 16) {
+        std::cerr << "Expected the 64x32 texture at level 1 for 20 texels per unit.\n";
+        ++failureCount;
+    }
+
+    // Invalidated textures are read and decoded again at the level they showed; failures are
+    // retried once the file changes.
+    const int callsBeforeInvalidate = decodeCalls.load();
+    streamer.InvalidateTextures({small64, broken});
+    RunFrame(streamer, {});
+    updates = RunFrame(streamer, {});
+    small = FindUpdate(updates, 1);
+    if (!small || small->level != 1 || decodeCalls.load() != callsBeforeInvalidate + 2 || !streamer.HasFailed(2)) {
+        std::cerr << "Expected invalidated textures to decode again without losing sharpness.\n";
+        ++failureCount;
+    }
+
+    streamer.SetTextures({small64, medium128, large256}, {true, true, true}, previousSlots);
+    const std::vector<std::size_t> expectedPrevious = {1, static_cast<std::size_t>(-1), 0};
+    if (previousSlots != expectedPrevious || streamer.GetResidentLevel(0) != 1 || streamer.GetResidentLevel(2) != 0 ||
+        streamer.GetResidentLevel(1) != engine::TextureStreamer::kNoLevel) {
+        std::cerr << "Expected textures still in the list to keep their levels.\n";
+        ++failureCount;
+    }
+
+    // 300 KiB holds one 256x256 level plus placeholders, so the second visible texture gets a
+    // coarser level until the first leaves the view and is evicted.
+    engine::TextureStreamer budgeted(engine::TextureStreamingSettings{300u * 1024u, 16, 4}, &DecodeFakeTexture);
+    budgeted.SetTextures({budgetA, budgetB}, {true, true}, previousSlots);
+    RunFrame(budgeted, {});
+    RunFrame(budgeted, {});
+    RunFrame(budgeted, {{0, 256.0f}, {1, 200.0f}});
+    RunFrame(budgeted, {{0, 256.0f}, {1, 200.0f}});
+    if (budgeted.GetResidentLevel(0) != 0 || budgeted.GetResidentLevel(1) != 2 ||
+        budgeted.GetStatistics().residentBytes > 300u * 1024u) {
+        std::cerr << "Expected the larger request to win the budget and the other to settle for a coarser level.\n";
+        ++failureCount;
+    }
+
+    updates = RunFrame(budgeted, {{1, 256.0f}});
+    const engine::TextureStreamUpdate* evicted = FindUpdate(updates, 0);
+    if (!evicted || evicted->level != 4 || evicted->image.width != 16 || budgeted.GetStatistics().evictionCount != 1) {
+        std::cerr << "Expected the texture out of view to drop back to its placeholder.\n";
+        ++failureCount;
+    }
+    if (budgeted.GetStatistics().fileBytes != 7) {
+        std::cerr << "Expected an evicted texture to let go of its file.\n";
+        ++failureCount;
+    }
+    RunFrame(budgeted, {{1, 256.0f}});
+    statistics = budgeted.GetStatistics();
+    if (budgeted.GetResidentLevel(1) != 0 || statistics.residentBytes > statistics.budgetBytes || statistics.pendingDecodeCount != 0) {
+        std::cerr << "Expected the visible texture to take the freed budget.\n";
+        ++failureCount;
+    }
+
+    // A file too large for what the levels leave of the budget is read again rather than kept.
+    const std::string padded = WriteFakeTexture(directory, "padded.tex", "16x16" + std::string(2000, ' '));
+    engine::TextureStreamer tight(engine::TextureStreamingSettings{2048, 16, 4}, &DecodeFakeTexture);
+    tight.SetTextures({padded}, {true}, previousSlots);
+    RunFrame(tight, {});
+    RunFrame(tight, {});
+    statistics = tight.GetStatistics();
+    if (tight.GetResidentLevel(0) != 0 || statistics.residentBytes != 16 * 16 * 4 * 2 || statistics.fileBytes != 0) {
+        std::cerr << "Expected a file that does not fit the budget not to be kept.\n";
+        ++failureCount;
+    }
+
+    std::filesystem::remove_all(directory);
+    return failureCount;
+}
+}
+
+int main() {
+    const int failures = RunTextureStreamerTests();
+    if (failures > 0) {
+        std::cerr << "TextureStreamer unit tests failed with " << failures << " failure(s).\n";
+        return 1;
+    }
+
+    std::cout << "TextureStreamer unit tests passed.\n";
+    return 0;
+}
@@ -0,0 +1,122 @@
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "Engine/TriangleAssembly.hpp"
+
+namespace {
+struct TestVertex {
+    float x;
+    float y;
+    bool valid;
+};
+
+struct Emitted {
+    std::vector<bool> keep;
+    std::vector<std::uint32_t> indices;
+};
+
+template <bool kIndicesValidated, bool kCull>
+Emitted Assemble(
+    const std::vector<std::uint32_t>& indices,
+    const std::vector<TestVertex>& vertices,
+    engine::TriangleRejectCounts& counts) {
+    const engine::TriangleCullRect viewport{0.0f, 0.0f, 100.0f, 100.0f};
+    std::vector<std::uint8_t> outcodes;
+    for (const TestVertex& vertex : vertices) {
+        outcodes.push_back(engine::ComputeVertexOutcode(vertex.x, vertex.y, vertex.valid, viewport));
+    }
+
+    Emitted emitted;
+    engine::AssembleTriangles<kIndicesValidated, kCull>(
+        std::span<const std::uint32_t>(indices),
+        std::span<const std::uint8_t>(outcodes),
+        counts,
+        [&](std::size_t triangle, std::uint32_t i0, std::uint32_t i1, std::uint32_t i2, bool keep) {
+            if (triangle != emitted.keep.size()) {
+                emitted.keep.clear();
+                return;
+            }
+            emitted.keep.push_back(keep);
+            emitted.indices.insert(emitted.indices.end(), {i0, i1, i2});
+        });
+    return emitted;
+}
+
+int RunTriangleAssemblyTests() {
+    int failureCount = 0;
+
+    const std::vector<TestVertex> vertices = {
+        {10.0f, 10.0f, true},
+        {50.0f, 10.0f, true},
+        {10.0f, 50.0f, true},
+        {0.0f, 0.0f, false},
+        {-30.0f, 10.0f, true},
+        {-20.0f, 60.0f, true},
+        {-5.0f, 90.0f, true},
+        {150.0f, 150.0f, true},
+    };
+    // Visible, behind the camera, left of the viewport, straddling the left edge, out of range.
+    const std::vector<std::uint32_t> indices = {0, 1, 2, 0, 1, 3, 4, 5, 6, 4, 1, 6, 0, 9, 2, 7, 1};
+
+    engine::TriangleRejectCounts checkedCounts{};
+    const Emitted checked = Assemble<false, true>(indices, vertices, checkedCounts);
+    if (checked.keep != std::vector<bool>{true, false, false, true, false}) {
+        std::cerr << "Expected only the visible and the straddling triangle to be kept, and the partial triangle skipped.\n";
+        ++failureCount;
+    }
+    if (checkedCounts.clipped != 1 || checkedCounts.culled != 1) {
+        std::cerr << "Expected one clipped and one culled triangle; out-of-range triangles count as neither.\n";
+        ++failureCount;
+    }
+    if (checked.indices.size() == 15 && (checked.indices[12] != 0 || checked.indices[13] != 0 || checked.indices[14] != 0)) {
+        std::cerr << "Expected out-of-range triangles to be passed on with index 0.\n";
+        ++failureCount;
+    }
+
+    // Without the out-of-range triangle both specializations must agree.
+    const std::vector<std::uint32_t> validIndices(indices.begin(), indices.begin() + 12);
+    engine::TriangleRejectCounts uncheckedCounts{};
+    engine::TriangleRejectCounts recheckedCounts{};
+    const Emitted unchecked = Assemble<true, true>(validIndices, vertices, uncheckedCounts);
+    const Emitted rechecked = Assemble<false, true>(validIndices, vertices, recheckedCounts);
+    if (unchecked.keep != rechecked.keep || unchecked.indices != rechecked.indices ||
+        uncheckedCounts.culled != recheckedCounts.culled || uncheckedCounts.clipped != recheckedCounts.clipped) {
+        std::cerr << "Expected the validated kernel to match the checked kernel on valid indices.\n";
+        ++failureCount;
+    }
+
+    if (engine::ComputeVertexOutcode(150.0f, -5.0f, true, engine::TriangleCullRect{0.0f, 0.0f, 100.0f, 100.0f}) !=
+        (engine::kOutcodeRight | engine::kOutcodeTop)) {
+        std::cerr << "Expected outcodes to mark every side a vertex lies beyond.\n";
+        ++failureCount;
+    }
+
+    engine::TriangleRejectCounts overlayCounts{};
+    const Emitted overlay = Assemble<false, false>(indices, vertices, overlayCounts);
+    if (overlay.keep != std::vector<bool>{true, false, true, true, false} || overlayCounts.culled != 0) {
+        std::cerr << "Expected the overlay kernel to keep offscreen triangles.\n";
+        ++failureCount;
+    }
+
+    engine::TriangleRejectCounts emptyCounts{};
+    const Emitted empty = Assemble<false, true>(indices, {}, emptyCounts);
+    if (!empty.keep.empty() || emptyCounts.clipped != 0) {
+        std::cerr << "Expected nothing to be emitted without vertices.\n";
+        ++failureCount;
+    }
+
+    return failureCount;
+}
+}
+
+int main() {
+    const int failures = RunTriangleAssemblyTests();
+    if (failures > 0) {
+        std::cerr << "TriangleAssembly unit tests failed with " << failures << " failure(s).\n";
+        return 1;
+    }
+
+    std::cout << "TriangleAssembly unit tests passed.\n";
+    return 0;
+}